@@ -68,11 +68,90 @@ else()
     message(FATAL_ERROR "unsupported compiler family: ${CMAKE_CXX_COMPILER_ID}")
 endif()
 
+# SIMD instruction set
+# SSE3 | AVX2 | AVX512 | NATIVE
+# SSE3 is the portable baseline. Wider levels enable SIMDType<32> / SIMDType<64>,
+# and binaries won't run on CPUs lacking them. NATIVE picks what the build
+# machine supports.
+set(TREECORE_SIMD_LEVEL "SSE3" CACHE STRING "SIMD instruction set enabled at compile time: SSE3, AVX2, AVX512 or NATIVE")
+set_property(CACHE TREECORE_SIMD_LEVEL PROPERTY STRINGS "SSE3" "AVX2" "AVX512" "NATIVE")
+
+set(_simd_level_ ${TREECORE_SIMD_LEVEL})
+
+if(_simd_level_ STREQUAL "NATIVE")
+    set(_simd_level_ "SSE3")
+    if(NOT TREECORE_CMAKE_COMPILER STREQUAL "_MSVC" AND NOT CMAKE_CROSSCOMPILING)
+        include(CheckCXXSourceRuns)
+        set(CMAKE_REQUIRED_QUIET 1)
+        check_cxx_source_runs("
+            int main() { __builtin_cpu_init(); return __builtin_cpu_supports(\"avx2\") && __builtin_cpu_supports(\"fma\") ? 0 : 1; }"
+            TREECORE_HOST_HAS_AVX2)
+        check_cxx_source_runs("
+            int main() {
+                __builtin_cpu_init();
+                return __builtin_cpu_supports(\"avx512f\") && __builtin_cpu_supports(\"avx512bw\")
+                    && __builtin_cpu_supports(\"avx512dq\") && __builtin_cpu_supports(\"avx512vl\") ? 0 : 1;
+            }"
+            TREECORE_HOST_HAS_AVX512)
+        unset(CMAKE_REQUIRED_QUIET)
+
+        if(TREECORE_HOST_HAS_AVX2 AND TREECORE_HOST_HAS_AVX512)
+            set(_simd_level_ "AVX512")
+        elseif(TREECORE_HOST_HAS_AVX2)
+            set(_simd_level_ "AVX2")
+        endif()
+    endif()
+endif()
+
+set(TREECORE_SIMD_AVX2 0)
+set(TREECORE_SIMD_AVX512 0)
+set(TREECORE_SIMD_FLAGS "")
+
+if(_simd_level_ STREQUAL "AVX2" OR _simd_level_ STREQUAL "AVX512")
+    set(TREECORE_SIMD_AVX2 1)
+    if(TREECORE_CMAKE_COMPILER STREQUAL "_MSVC")
+        set(TREECORE_SIMD_FLAGS "/arch:AVX2")
+    else()
+        set(TREECORE_SIMD_FLAGS -mavx2 -mfma -mbmi2)
+    endif()
+endif()
+
+if(_simd_level_ STREQUAL "AVX512")
+    set(TREECORE_SIMD_AVX512 1)
+    if(TREECORE_CMAKE_COMPILER STREQUAL "_MSVC")
+        set(TREECORE_SIMD_FLAGS "/arch:AVX512")
+    else()
+        list(APPEND TREECORE_SIMD_FLAGS -mavx512f -mavx512bw -mavx512dq -mavx512vl)
+    endif()
+endif()
+
+if(TREECORE_SIMD_FLAGS)
+    include(CheckCXXCompilerFlag)
+    string(REPLACE ";" " " _simd_flags_str_ "${TREECORE_SIMD_FLAGS}")
+    check_cxx_compiler_flag("${_simd_flags_str_}" TREECORE_COMPILER_SUPPORTS_${_simd_level_})
+    if(NOT TREECORE_COMPILER_SUPPORTS_${_simd_level_})
+        message(FATAL_ERROR "compiler doesn't support SIMD level ${_simd_level_}: ${_simd_flags_str_}")
+    endif()
+endif()
+
+message(STATUS "treecore SIMD level: ${_simd_level_}")
+
+# flags for kernels that are compiled for SSE4.2 or AVX2 regardless of SIMD
+# level, and are only called after checking CPU at runtime. SSE4.2 kernels
+# may also use PCLMULQDQ, which they check for separately.
+if(TREECORE_CMAKE_COMPILER STREQUAL "_MSVC")
+    set(TREECORE_SSE42_KERNEL_FLAGS "")
+    set(TREECORE_AVX2_KERNEL_FLAGS "/arch:AVX2")
+else()
+    set(TREECORE_SSE42_KERNEL_FLAGS "-mssse3 -msse4.1 -msse4.2 -mpopcnt -mpclmul")
+    set(TREECORE_AVX2_KERNEL_FLAGS "-mavx2 -mfma -mbmi2")
+endif()
+
 function(treecore_set_dep_libraries target_name)
     if(TREECORE_OS STREQUAL "LINUX")
         target_link_libraries(${target_name} pthread dl)
     elseif(TREECORE_OS STREQUAL "WINDOWS")
-        target_link_libraries(${target_name} version winmm Shlwapi Dbghelp)
+        target_link_libraries(${target_name} version winmm Shlwapi Dbghelp Synchronization)
     elseif(TREECORE_OS STREQUAL "OSX")
         find_library(FRAMELIB_ACCELERATE Accelerate)
         find_library(FRAMELIB_AUDIOTOOLBOX AudioToolbox)
@@ -125,13 +204,14 @@ endfunction()
 function(treecore_set_compiler_options target_name)
     if(TREECORE_CMAKE_COMPILER STREQUAL "_MSVC" OR (TREECORE_CMAKE_COMPILER STREQUAL "_ICC" AND TREECORE_OS STREQUAL "WINDOWS"))
         target_compile_options(${target_name} PUBLIC "/wd4819" "/wd4800")
+        target_compile_options(${target_name} PRIVATE ${TREECORE_SIMD_FLAGS})
 
     elseif(TREECORE_CMAKE_COMPILER STREQUAL "_GCC" OR (TREECORE_CMAKE_COMPILER STREQUAL "_ICC" AND (TREECORE_OS STREQUAL "LINUX" OR TREECORE_OS STREQUAL "OSX")) OR TREECORE_CMAKE_COMPILER STREQUAL "_CLANG")
         target_compile_options(${target_name} PUBLIC -fPIC)
         target_compile_options(${target_name} INTERFACE -std=c++11)
 
         if(TREECORE_CPU STREQUAL "X86")
-            target_compile_options(${target_name} PRIVATE -msse3 -mstackrealign)
+            target_compile_options(${target_name} PRIVATE -msse3 -mstackrealign ${TREECORE_SIMD_FLAGS})
         endif()
     endif()
 
@@ -0,0 +1,36 @@
+#include "treecore/AdaptiveMutex.h"
+#include "treecore/Futex.h"
+
+namespace treecore
+{
+
+void AdaptiveMutex::enterContended() const noexcept
+{
+    // spin with exponential backoff, in hope that the owner leaves soon
+    for (int num_pauses = 1; num_pauses <= MAX_SPIN_PAUSES; num_pauses *= 2)
+    {
+        for (int i = 0; i < num_pauses; i++)
+            atomic_spin_pause();
+
+        if ( atomic_load( &state ) == UNLOCKED && atomic_compare_set<int32>( &state, UNLOCKED, LOCKED ) )
+            return;
+    }
+
+    // park: mark the lock as having waiters, so that the owner will wake us
+    // on exit. As we can't tell whether other waiters still remain, a lock
+    // taken here always stays marked.
+    int32 prev = atomic_exchange<int32>( &state, LOCKED_WITH_WAITERS );
+
+    while (prev != UNLOCKED)
+    {
+        futex_wait( &state, LOCKED_WITH_WAITERS );
+        prev = atomic_exchange<int32>( &state, LOCKED_WITH_WAITERS );
+    }
+}
+
+void AdaptiveMutex::wakeWaiter() const noexcept
+{
+    futex_wake_one( &state );
+}
+
+} // namespace treecore
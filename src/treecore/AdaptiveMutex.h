@@ -0,0 +1,100 @@
+#ifndef TREECORE_ADAPTIVE_MUTEX_H
+#define TREECORE_ADAPTIVE_MUTEX_H
+
+#include "treecore/AtomicFunc.h"
+#include "treecore/ClassUtils.h"
+#include "treecore/DebugUtils.h"
+#include "treecore/IntTypes.h"
+#include "treecore/ScopedLock.h"
+
+class TestFramework;
+
+namespace treecore
+{
+
+/**
+ * @brief non-recursive mutex that spins briefly, then parks the thread in OS
+ *
+ * An uncontended enter() and exit() costs one atomic operation each, the same
+ * as SpinLock. When the lock is held by another thread, the caller spins with
+ * exponentially growing pause intervals for a bounded time, which is enough to
+ * catch short critical sections without a context switch. After that, the
+ * thread sleeps in futex_wait() until the owner releases the lock, so long
+ * waits don't burn CPU as SpinLock does.
+ *
+ * Like SpinLock, a thread must not enter the same AdaptiveMutex twice.
+ *
+ * @see SpinLock, CriticalSection, FutexEvent
+ */
+class TREECORE_SHARED_API AdaptiveMutex
+{
+    friend class ::TestFramework;
+
+public:
+    inline AdaptiveMutex() noexcept {}
+    inline ~AdaptiveMutex() noexcept
+    {
+        treecore_assert( state == UNLOCKED );
+    }
+
+    /**
+     * @brief acquire the lock, block until it succeeds
+     */
+    inline void enter() const noexcept
+    {
+        if unlikely( !atomic_compare_set<int32>( &state, UNLOCKED, LOCKED ) )
+            enterContended();
+    }
+
+    /**
+     * @brief try to acquire the lock without blocking
+     * @return true if the lock is acquired
+     */
+    inline bool tryEnter() const noexcept
+    {
+        return atomic_compare_set<int32>( &state, UNLOCKED, LOCKED );
+    }
+
+    /**
+     * @brief release the lock, and wake one waiting thread if any
+     */
+    inline void exit() const noexcept
+    {
+        const int32 prev = atomic_exchange<int32>( &state, UNLOCKED );
+        treecore_assert( prev != UNLOCKED ); // releasing a lock that isn't currently held!
+
+        if unlikely( prev == LOCKED_WITH_WAITERS )
+            wakeWaiter();
+    }
+
+    typedef GenericScopedLock<AdaptiveMutex>    ScopedLockType;
+    typedef GenericScopedUnlock<AdaptiveMutex>  ScopedUnlockType;
+    typedef GenericScopedTryLock<AdaptiveMutex> ScopedTryLockType;
+
+    /**
+     * @brief max number of pause instructions executed in one spin round
+     *
+     * Spinning starts with one pause per round and doubles every round, until
+     * this limit is reached. Then the thread will be parked.
+     */
+    static const int MAX_SPIN_PAUSES = 1024;
+
+private:
+    enum
+    {
+        UNLOCKED = 0,
+        LOCKED   = 1,
+        LOCKED_WITH_WAITERS = 2
+    };
+
+    void enterContended() const noexcept;
+    void wakeWaiter() const noexcept;
+
+    mutable int32 state = UNLOCKED;
+
+    TREECORE_DECLARE_NON_COPYABLE( AdaptiveMutex )
+};
+
+} // namespace treecore
+
+#endif // TREECORE_ADAPTIVE_MUTEX_H
@@ -158,6 +158,17 @@ bool atomic_compare_set(T* store, T expect, T value) noexcept
     return __atomic_compare_exchange_n(TO_PRIP(store), TO_PRIP(&expect), TO_PRI(value), false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
 }
 
+inline void atomic_spin_pause() noexcept
+{
+#if defined(__i386__) || defined(__x86_64__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__ ("yield");
+#else
+    __atomic_signal_fence(__ATOMIC_SEQ_CST);
+#endif
+}
+
 #undef PRI_T
 #undef TO_PRI
 #undef TO_PRIP
@@ -544,6 +544,15 @@ inline bool atomic_compare_set(T* store, T expect, T value) noexcept
     return _impl_::_msvc_atomic_impl_<T, sizeof(T)>::cas(store, expect, value);
 }
 
+inline void atomic_spin_pause() noexcept
+{
+#if defined(_M_IX86) || defined(_M_X64)
+    _mm_pause();
+#else
+    __yield();
+#endif
+}
+
 } // namespace treecore
 
 
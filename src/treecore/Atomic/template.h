@@ -55,6 +55,9 @@ bool atomic_compare_exchange(T* store, T* expect, T value) noexcept;
 template<typename T>
 bool atomic_compare_set(T* store, T expect, T value) noexcept;
 
+// hint the CPU that we are inside a spin-wait loop
+inline void atomic_spin_pause() noexcept;
+
 } // namespace treecore
 
 #endif // TREECORE_ATOMIC_TEMPLATE_H
@@ -0,0 +1,267 @@
+#include "treecore/BinaryEncoding.h"
+#include "treecore/CpuDispatch.h"
+#include "treecore/OutputStream.h"
+
+#include "treecore/internal/BinaryEncoding_impl.h"
+
+namespace treecore
+{
+
+namespace
+{
+
+// Baseline kernels are table driven. Base64 and hex codecs are mostly byte
+// shuffles and lookups of 16-entry tables, which SSE2 has no instruction for.
+
+void base64_encode_baseline( const uint8* src, size_t num_bytes, char* dest, Base64Alphabet alphabet ) noexcept
+{
+    binenc_base64_encode_scalar( src, num_bytes, dest, alphabet );
+}
+
+bool base64_decode_baseline( const char* src, size_t num_chars, uint8* dest, Base64Alphabet alphabet ) noexcept
+{
+    return binenc_base64_decode_scalar( src, num_chars, dest, alphabet );
+}
+
+void hex_encode_baseline( const uint8* src, size_t num_bytes, char* dest, bool upper_case ) noexcept
+{
+    binenc_hex_encode_scalar( src, num_bytes, dest, upper_case );
+}
+
+bool hex_decode_baseline( const char* src, size_t num_bytes, uint8* dest ) noexcept
+{
+    return binenc_hex_decode_scalar( src, num_bytes, dest );
+}
+
+const BinaryEncodingKernelTable baseline_table = {
+    &base64_encode_baseline,
+    &base64_decode_baseline,
+    &hex_encode_baseline,
+    &hex_decode_baseline,
+};
+
+// chunk sizes of stream functions, a whole number of base64 groups
+enum
+{
+    STREAM_CHUNK_BYTES = 3 * 1024,
+    STREAM_CHUNK_CHARS = 4 * 1024
+};
+
+} // anonymous namespace
+
+const BinaryEncodingKernelTable* get_binary_encoding_kernels_baseline() noexcept
+{
+    return &baseline_table;
+}
+
+static const BinaryEncodingKernelTable& kernels() noexcept
+{
+    static const CpuDispatchTable<const BinaryEncodingKernelTable*> impls = { {
+        get_binary_encoding_kernels_baseline(),
+        nullptr,
+#if TREECORE_CPU_X86
+        get_binary_encoding_kernels_avx2(),
+#else
+        nullptr,
+#endif
+        nullptr
+    } };
+
+    static const BinaryEncodingKernelTable* impl = impls.select();
+    return *impl;
+}
+
+// length of text without padding, or num_chars + 1 if padding is misplaced
+static size_t base64_unpadded_length( const char* text, size_t num_chars ) noexcept
+{
+    size_t n = num_chars;
+
+    if (n > 0 && text[n - 1] == '=')
+    {
+        if (n % 4 != 0)
+            return num_chars + 1;
+
+        --n;
+
+        if (text[n - 1] == '=')
+            --n;
+    }
+
+    return n;
+}
+
+size_t base64_encoded_length( size_t num_bytes, bool pad ) noexcept
+{
+    if (pad)
+        return (num_bytes + 2) / 3 * 4;
+
+    return num_bytes / 3 * 4 + (num_bytes % 3 == 0 ? 0 : num_bytes % 3 + 1);
+}
+
+size_t base64_encode( const void* data, size_t num_bytes, char* dest, Base64Alphabet alphabet, bool pad ) noexcept
+{
+    const uint8* const src = static_cast<const uint8*>(data);
+    const size_t num_whole = num_bytes - num_bytes % 3;
+
+    kernels().base64_encode( src, num_whole, dest, alphabet );
+
+    char* d = dest + num_whole / 3 * 4;
+
+    if (num_whole < num_bytes)
+    {
+        uint8 tail[3] = { 0, 0, 0 };
+        std::memcpy( tail, src + num_whole, num_bytes - num_whole );
+
+        char group[4];
+        binenc_base64_encode_scalar( tail, 3, group, alphabet );
+
+        const size_t num_used = num_bytes - num_whole + 1;
+        std::memcpy( d, group, num_used );
+        d += num_used;
+
+        if (pad)
+        {
+            for (size_t i = num_used; i < 4; i++)
+                *d++ = '=';
+        }
+    }
+
+    return size_t( d - dest );
+}
+
+size_t base64_decoded_length( const char* text, size_t num_chars ) noexcept
+{
+    const size_t n = base64_unpadded_length( text, num_chars );
+
+    if (n > num_chars)
+        return 0;
+
+    return n / 4 * 3 + (n % 4 > 1 ? n % 4 - 1 : 0);
+}
+
+bool base64_decode( const char* text, size_t num_chars, void* dest, Base64Alphabet alphabet ) noexcept
+{
+    const size_t n = base64_unpadded_length( text, num_chars );
+
+    if (n > num_chars || n % 4 == 1)
+        return false;
+
+    const size_t num_whole = n - n % 4;
+    uint8* const d = static_cast<uint8*>(dest);
+
+    if ( !kernels().base64_decode( text, num_whole, d, alphabet ) )
+        return false;
+
+    if (num_whole < n)
+    {
+        char group[4] = { 'A', 'A', 'A', 'A' };
+        std::memcpy( group, text + num_whole, n - num_whole );
+
+        uint8 tail[3];
+        if ( !binenc_base64_decode_scalar( group, 4, tail, alphabet ) )
+            return false;
+
+        std::memcpy( d + num_whole / 4 * 3, tail, n - num_whole - 1 );
+    }
+
+    return true;
+}
+
+bool base64_encode( const void* data, size_t num_bytes, OutputStream& out, Base64Alphabet alphabet, bool pad )
+{
+    const uint8* src = static_cast<const uint8*>(data);
+    char buffer[STREAM_CHUNK_CHARS];
+
+    while (num_bytes > STREAM_CHUNK_BYTES)
+    {
+        kernels().base64_encode( src, STREAM_CHUNK_BYTES, buffer, alphabet );
+
+        if ( !out.write( buffer, STREAM_CHUNK_CHARS ) )
+            return false;
+
+        src       += STREAM_CHUNK_BYTES;
+        num_bytes -= STREAM_CHUNK_BYTES;
+    }
+
+    const size_t num_chars = base64_encode( src, num_bytes, buffer, alphabet, pad );
+    return num_chars == 0 || out.write( buffer, num_chars );
+}
+
+bool base64_decode( const char* text, size_t num_chars, OutputStream& out, Base64Alphabet alphabet )
+{
+    uint8 buffer[STREAM_CHUNK_BYTES];
+
+    // padding is only allowed in the last chunk
+    while (num_chars > STREAM_CHUNK_CHARS)
+    {
+        if ( !kernels().base64_decode( text, STREAM_CHUNK_CHARS, buffer, alphabet )
+             || !out.write( buffer, STREAM_CHUNK_BYTES ) )
+            return false;
+
+        text      += STREAM_CHUNK_CHARS;
+        num_chars -= STREAM_CHUNK_CHARS;
+    }
+
+    if ( !base64_decode( text, num_chars, buffer, alphabet ) )
+        return false;
+
+    const size_t num_bytes = base64_decoded_length( text, num_chars );
+    return num_bytes == 0 || out.write( buffer, num_bytes );
+}
+
+void hex_encode( const void* data, size_t num_bytes, char* dest, bool upper_case ) noexcept
+{
+    kernels().hex_encode( static_cast<const uint8*>(data), num_bytes, dest, upper_case );
+}
+
+bool hex_decode( const char* text, size_t num_chars, void* dest ) noexcept
+{
+    if (num_chars % 2 != 0)
+        return false;
+
+    return kernels().hex_decode( text, num_chars / 2, static_cast<uint8*>(dest) );
+}
+
+bool hex_encode( const void* data, size_t num_bytes, OutputStream& out, bool upper_case )
+{
+    const uint8* src = static_cast<const uint8*>(data);
+    char buffer[STREAM_CHUNK_CHARS];
+
+    while (num_bytes > 0)
+    {
+        const size_t num_this_time = num_bytes < STREAM_CHUNK_CHARS / 2 ? num_bytes : size_t( STREAM_CHUNK_CHARS / 2 );
+        kernels().hex_encode( src, num_this_time, buffer, upper_case );
+
+        if ( !out.write( buffer, num_this_time * 2 ) )
+            return false;
+
+        src       += num_this_time;
+        num_bytes -= num_this_time;
+    }
+
+    return true;
+}
+
+bool hex_decode( const char* text, size_t num_chars, OutputStream& out )
+{
+    if (num_chars % 2 != 0)
+        return false;
+
+    uint8 buffer[STREAM_CHUNK_CHARS / 2];
+
+    while (num_chars > 0)
+    {
+        const size_t num_this_time = num_chars < STREAM_CHUNK_CHARS ? num_chars : size_t( STREAM_CHUNK_CHARS );
+
+        if ( !kernels().hex_decode( text, num_this_time / 2, buffer )
+             || !out.write( buffer, num_this_time / 2 ) )
+            return false;
+
+        text      += num_this_time;
+        num_chars -= num_this_time;
+    }
+
+    return true;
+}
+
+} // namespace treecore
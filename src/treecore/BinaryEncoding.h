@@ -0,0 +1,128 @@
+#ifndef TREECORE_BINARY_ENCODING_H
+#define TREECORE_BINARY_ENCODING_H
+
+#include "treecore/Common.h"
+#include "treecore/IntTypes.h"
+#include "treecore/PlatformDefs.h"
+
+#include <cstddef>
+
+namespace treecore
+{
+
+class OutputStream;
+
+//
+// Base64 and hexadecimal codecs for binary data. Whole blocks of input are
+// converted with SIMD instructions when the CPU has them, and the best
+// implementation is chosen on first use, see get_cpu_feature_level().
+//
+// Base64 here is the one of RFC 4648, unlike MemoryBlock::toBase64Encoding()
+// which has its own format.
+//
+
+enum Base64Alphabet
+{
+    BASE64_STANDARD, ///< A-Z, a-z, 0-9, '+' and '/'
+    BASE64_URL       ///< A-Z, a-z, 0-9, '-' and '_', safe in URLs and file names
+};
+
+/**
+ * @brief get the number of characters base64_encode() writes
+ */
+TREECORE_SHARED_API size_t base64_encoded_length( size_t num_bytes, bool pad = true ) noexcept;
+
+/**
+ * @brief encode bytes as base64
+ *
+ * No terminating zero is written.
+ *
+ * @param dest  must have room for base64_encoded_length() characters
+ * @param pad   whether to fill the last group with '=' to four characters
+ * @return number of characters written
+ */
+TREECORE_SHARED_API size_t base64_encode( const void* data, size_t num_bytes, char* dest,
+                                          Base64Alphabet alphabet = BASE64_STANDARD, bool pad = true ) noexcept;
+
+/**
+ * @brief get the number of bytes base64_decode() writes for some text
+ *
+ * Text is not checked, the result is only meaningful for text that decodes.
+ */
+TREECORE_SHARED_API size_t base64_decoded_length( const char* text, size_t num_chars ) noexcept;
+
+/**
+ * @brief decode base64 text
+ *
+ * Padding at the end is optional, but if there is any, the length of text
+ * must be a multiple of four. Any character that is not of the alphabet,
+ * including whitespace, makes text invalid. Unused bits of the last
+ * character are ignored.
+ *
+ * @param dest  must have room for base64_decoded_length() bytes. It may
+ *              have been partly written when text turns out to be invalid.
+ * @return false if text is not valid base64
+ */
+TREECORE_SHARED_API bool base64_decode( const char* text, size_t num_chars, void* dest,
+                                        Base64Alphabet alphabet = BASE64_STANDARD ) noexcept;
+
+/**
+ * @brief encode bytes as base64 to a stream, see base64_encode()
+ *
+ * @return false if writing to stream failed
+ */
+TREECORE_SHARED_API bool base64_encode( const void* data, size_t num_bytes, OutputStream& out,
+                                        Base64Alphabet alphabet = BASE64_STANDARD, bool pad = true );
+
+/**
+ * @brief decode base64 text to a stream, see base64_decode()
+ *
+ * Text is decoded in chunks, so the stream may already have received some of
+ * the data when the rest of text turns out to be invalid.
+ *
+ * @return false if text is not valid base64, or if writing to stream failed
+ */
+TREECORE_SHARED_API bool base64_decode( const char* text, size_t num_chars, OutputStream& out,
+                                        Base64Alphabet alphabet = BASE64_STANDARD );
+
+/**
+ * @brief encode bytes as two hexadecimal digits each
+ *
+ * No terminating zero is written.
+ *
+ * @param dest  must have room for num_bytes * 2 characters
+ */
+TREECORE_SHARED_API void hex_encode( const void* data, size_t num_bytes, char* dest, bool upper_case = false ) noexcept;
+
+/**
+ * @brief decode hexadecimal text, two digits for each byte
+ *
+ * Digits may be of either case. Text of odd length, or with anything else
+ * than digits, is invalid.
+ *
+ * @param dest  must have room for num_chars / 2 bytes. It may have been
+ *              partly written when text turns out to be invalid.
+ * @return false if text is not valid
+ */
+TREECORE_SHARED_API bool hex_decode( const char* text, size_t num_chars, void* dest ) noexcept;
+
+/**
+ * @brief encode bytes as hexadecimal digits to a stream, see hex_encode()
+ *
+ * @return false if writing to stream failed
+ */
+TREECORE_SHARED_API bool hex_encode( const void* data, size_t num_bytes, OutputStream& out, bool upper_case = false );
+
+/**
+ * @brief decode hexadecimal text to a stream, see hex_decode()
+ *
+ * The stream may already have received some of the data when the rest of
+ * text turns out to be invalid.
+ *
+ * @return false if text is not valid, or if writing to stream failed
+ */
+TREECORE_SHARED_API bool hex_decode( const char* text, size_t num_chars, OutputStream& out );
+
+} // namespace treecore
+
+#endif // TREECORE_BINARY_ENCODING_H
@@ -1,4 +1,6 @@
 #include "treecore/CharPointer_UTF8.h"
+#include "treecore/MathsFunctions.h"
+#include "treecore/UTF8Functions.h"
 
 namespace treecore
 {
@@ -40,25 +42,171 @@ treecore_wchar CharPointer_UTF8::operator * () const noexcept
 
 size_t CharPointer_UTF8::length() const noexcept
 {
-    const CharType* d = data;
-    size_t count = 0;
+    return utf8_count_chars( data, std::strlen( data ) );
+}
+
+size_t CharPointer_UTF8::lengthUpTo( const size_t maxCharsToCount ) const noexcept
+{
+    // Well-formed text is counted in chunks. A chunk never covers more bytes
+    // than characters left to count, so nothing is read that counting one
+    // character at a time wouldn't read.
+    const size_t chunkSize = 256;
 
-    for (;; )
+    CharPointer_UTF8 p( *this );
+    size_t len = 0;
+
+    while (len < maxCharsToCount)
     {
-        const uint32 n = (uint32) (uint8) * d++;
+        const size_t limit    = jmin( maxCharsToCount - len, chunkSize );
+        const size_t numBytes = strnlen( p.data, limit );
+        size_t numToCount     = numBytes;
 
-        if ( (n & 0x80) != 0 )
+        if (numBytes == limit)
         {
-            while ( (*d & 0xc0) == 0x80 )
-                ++d;
+            // leave the last sequence to the next chunk, as it may continue
+            // after this one
+            while ( numToCount > 0 && numBytes - numToCount < 3 && (p.data[numToCount - 1] & 0xc0) == 0x80 )
+                --numToCount;
+
+            if ( numToCount > 0 && (uint8) p.data[numToCount - 1] >= 0xc0 )
+                --numToCount;
+        }
+
+        if (numToCount == 0)
+        {
+            if (p.getAndAdvance() == 0)
+                break;
+
+            ++len;
+            continue;
         }
-        else if (n == 0)
+
+        if ( !utf8_validate( p.data, numToCount ) )
+            return len + CharacterFunctions::lengthUpTo( p, maxCharsToCount - len );
+
+        len    += utf8_count_chars( p.data, numToCount );
+        p.data += numToCount;
+
+        if (numBytes < limit)
             break;
+    }
+
+    return len;
+}
+
+size_t CharPointer_UTF8::lengthUpTo( const CharPointer_UTF8 end ) const noexcept
+{
+    if (end.data <= data)
+        return 0;
+
+    const size_t numBytes = strnlen( data, (size_t) (end.data - data) );
 
-        ++count;
+    if ( utf8_validate( data, numBytes ) )
+        return utf8_count_chars( data, numBytes );
+
+    // malformed, or the last character continues after end
+    return CharacterFunctions::lengthUpTo( *this, end );
+}
+
+// Gets the offset of the first byte that differs between two strings, or of
+// their terminating zero if they are equal. Strings are compared in chunks,
+// so that a difference near the start is found without reading them to the
+// end.
+static size_t firstDifference( const char* a, const char* b ) noexcept
+{
+    const size_t chunkSize = 256;
+    size_t offset = 0;
+
+    for (;;)
+    {
+        const size_t numBytes = jmin( strnlen( a + offset, chunkSize ), strnlen( b + offset, chunkSize ) );
+
+        // the terminating zero of the shorter string is compared too
+        const size_t numToCompare = numBytes < chunkSize ? numBytes + 1 : chunkSize;
+        const size_t diff = utf8_mismatch( a + offset, b + offset, numToCompare );
+
+        if (diff < numToCompare)
+            return offset + diff;
+
+        if (numBytes < chunkSize)
+            return offset + numBytes;
+
+        offset += chunkSize;
     }
+}
+
+int CharPointer_UTF8::compare( const CharPointer_UTF8 other ) const noexcept
+{
+    const size_t diff = firstDifference( data, other.data );
+
+    if (data[diff] == other.data[diff])
+        return 0;
+
+    // Decode from the character holding the first different byte. Its start
+    // is only known for sure if everything before it is well-formed.
+    size_t start = diff;
+
+    while ( start > 0 && diff - start < 3 && (data[start - 1] & 0xc0) == 0x80 )
+        --start;
+
+    if ( start > 0 && (uint8) data[start - 1] >= 0xc0 )
+        --start;
+
+    if ( utf8_validate( data, start ) )
+        return CharacterFunctions::compare( CharPointer_UTF8( data + start ), CharPointer_UTF8( other.data + start ) );
 
-    return count;
+    return CharacterFunctions::compare( *this, other );
+}
+
+int CharPointer_UTF8::indexOf( const CharPointer_UTF8 stringToFind ) const noexcept
+{
+    const size_t numNeedleBytes = std::strlen( stringToFind.data );
+
+    if (numNeedleBytes == 0)
+        return 0;
+
+    // In well-formed text, the first byte match is also the first character
+    // match. Otherwise characters are compared one by one.
+    if ( utf8_validate( stringToFind.data, numNeedleBytes ) )
+    {
+        // search in overlapping chunks, so that the text isn't read to the
+        // end if the match is near the start
+        const size_t chunkSize  = 1024;
+        const size_t windowSize = chunkSize + numNeedleBytes - 1;
+        size_t offset = 0;
+
+        for (;; )
+        {
+            const size_t numBytes = strnlen( data + offset, windowSize );
+            const size_t found    = offset + utf8_find( data + offset, numBytes, stringToFind.data, numNeedleBytes );
+
+            if ( found < offset + numBytes || numBytes < windowSize )
+            {
+                if ( !utf8_validate( data, found ) )
+                    break;
+
+                return found < offset + numBytes ? (int) utf8_count_chars( data, found ) : -1;
+            }
+
+            offset += chunkSize;
+        }
+    }
+
+    return CharacterFunctions::indexOf( *this, stringToFind );
+}
+
+int CharPointer_UTF8::indexOf( const treecore_wchar charToFind ) const noexcept
+{
+    if (charToFind > 0 && charToFind < 0x80)
+    {
+        const char* const found = std::strchr( data, (int) charToFind );
+        const size_t numBytes   = found != nullptr ? (size_t) (found - data) : std::strlen( data );
+
+        if ( utf8_validate( data, numBytes ) )
+            return found != nullptr ? (int) utf8_count_chars( data, numBytes ) : -1;
+    }
+
+    return CharacterFunctions::indexOfChar( *this, charToFind );
 }
 
 treecore_wchar CharPointer_UTF8::getAndAdvance() noexcept
@@ -143,39 +291,10 @@ void CharPointer_UTF8::write( const treecore_wchar charToWrite ) noexcept
 
 bool CharPointer_UTF8::isValidString( const CharType* dataToTest, int maxBytesToRead )
 {
-    while (--maxBytesToRead >= 0 && *dataToTest != 0)
-    {
-        const signed char byte = (signed char) *dataToTest++;
-
-        if (byte < 0)
-        {
-            uint8 bit = 0x40;
-            int numExtraValues = 0;
-
-            while ( (byte & bit) != 0 )
-            {
-                if (bit < 8)
-                    return false;
-
-                ++numExtraValues;
-                bit >>= 1;
-
-                if ( bit == 8 && (numExtraValues > maxBytesToRead
-                                  || *CharPointer_UTF8( dataToTest - 1 ) > 0x10ffff) )
-                    return false;
-            }
-
-            maxBytesToRead -= numExtraValues;
-            if (maxBytesToRead < 0)
-                return false;
-
-            while (--numExtraValues >= 0)
-                if ( (*dataToTest++ & 0xc0) != 0x80 )
-                    return false;
-        }
-    }
+    if (maxBytesToRead <= 0)
+        return true;
 
-    return true;
+    return utf8_validate( dataToTest, strnlen( dataToTest, (size_t) maxBytesToRead ) );
 }
 
 } // namespace treecore
@@ -179,16 +179,10 @@ public:
     size_t length() const noexcept;
 
     /** Returns the number of characters in this string, or the given value, whichever is lower. */
-    size_t lengthUpTo( const size_t maxCharsToCount ) const noexcept
-    {
-        return CharacterFunctions::lengthUpTo( *this, maxCharsToCount );
-    }
+    size_t lengthUpTo( const size_t maxCharsToCount ) const noexcept;
 
     /** Returns the number of characters in this string, or up to the given end pointer, whichever is lower. */
-    size_t lengthUpTo( const CharPointer_UTF8 end ) const noexcept
-    {
-        return CharacterFunctions::lengthUpTo( *this, end );
-    }
+    size_t lengthUpTo( const CharPointer_UTF8 end ) const noexcept;
 
     /** Returns the number of bytes that are used to represent this string.
         This includes the terminating null character.
@@ -281,6 +275,9 @@ public:
         return CharacterFunctions::compare( *this, other );
     }
 
+    /** Compares this string with another one. */
+    int compare( const CharPointer_UTF8 other ) const noexcept;
+
     /** Compares this string with another one, up to a specified number of characters. */
     template<typename CharPointer>
     int compareUpTo( const CharPointer other, const int maxChars ) const noexcept
@@ -319,11 +316,11 @@ public:
         return CharacterFunctions::indexOf( *this, stringToFind );
     }
 
+    /** Returns the character index of a substring, or -1 if it isn't found. */
+    int indexOf( const CharPointer_UTF8 stringToFind ) const noexcept;
+
     /** Returns the character index of a unicode character, or -1 if it isn't found. */
-    int indexOf( const treecore_wchar charToFind ) const noexcept
-    {
-        return CharacterFunctions::indexOfChar( *this, charToFind );
-    }
+    int indexOf( const treecore_wchar charToFind ) const noexcept;
 
     /** Returns the character index of a unicode character, or -1 if it isn't found. */
     int indexOf( const treecore_wchar charToFind, const bool ignoreCase ) const noexcept
@@ -30,6 +30,7 @@
 #define TREECORE_CHARACTER_FUNCTIONS_H
 
 #include "treecore/MathsFunctions.h"
+#include "treecore/NumberConversion.h"
 #include "treecore/PlatformDefs.h"
 
 #include <limits>
@@ -124,12 +125,12 @@ public:
     template<typename CharPointerType>
     static double readDoubleValue( CharPointerType& text ) noexcept
     {
-        double result[3] = { 0 }, accumulator[2] = { 0 };
-        int exponentAdjustment[2] = { 0 }, exponentAccumulator[2] = { -1, -1 };
-        int exponent    = 0, decPointIndex = 0, digit = 0;
-        int lastDigit   = 0, numSignificantDigits = 0;
-        bool isNegative = false, digitsFound = false;
-        const int maxSignificantDigits = 15 + 2;
+        // the significant digits, where the last one stands in for the rest
+        // when there are too many
+        char digits[PARSE_FLOAT_MAX_DIGITS];
+        size_t numDigits = 0;
+        int64 exponent = 0;
+        bool isNegative = false, digitsFound = false, decimalPointFound = false, nonZeroDigitsDropped = false;
 
         text = text.findEndOfWhitespace();
         treecore_wchar c = *text;
@@ -151,7 +152,7 @@ public:
         case 'i':
         case 'I':
             if ( (text[1] == 'n' || text[1] == 'N') && (text[2] == 'f' || text[2] == 'F') )
-                return std::numeric_limits<double>::infinity();
+                return isNegative ? -std::numeric_limits<double>::infinity() : std::numeric_limits<double>::infinity();
             break;
         }
 
@@ -159,61 +160,33 @@ public:
         {
             if ( text.isDigit() )
             {
-                lastDigit = digit;
-                digit = int(text.getAndAdvance() - '0');
+                const char digit = char( text.getAndAdvance() );
                 digitsFound = true;
 
-                if (decPointIndex != 0)
-                    exponentAdjustment[1]++;
-
-                if (numSignificantDigits == 0 && digit == 0)
-                    continue;
-
-                if (++numSignificantDigits > maxSignificantDigits)
+                if (numDigits == 0 && digit == '0')
                 {
-                    if (digit > 5)
-                        ++accumulator [decPointIndex];
-                    else if (digit == 5 && (lastDigit & 1) != 0)
-                        ++accumulator [decPointIndex];
-
-                    if (decPointIndex > 0)
-                        exponentAdjustment[1]--;
-                    else
-                        exponentAdjustment[0]++;
-
-                    while ( text.isDigit() )
-                    {
-                        ++text;
-                        if (decPointIndex == 0)
-                            exponentAdjustment[0]++;
-                    }
+                    if (decimalPointFound)
+                        --exponent;
+                }
+                else if (numDigits < PARSE_FLOAT_MAX_DIGITS - 1)
+                {
+                    digits[numDigits++] = digit;
+
+                    if (decimalPointFound)
+                        --exponent;
                 }
                 else
                 {
-                    const double maxAccumulatorValue = double( (std::numeric_limits<unsigned int>::max() - 9) / 10 );
-                    if (accumulator [decPointIndex] > maxAccumulatorValue)
-                    {
-                        result [decPointIndex] = mulexp10( result [decPointIndex], exponentAccumulator [decPointIndex] )
-                                                 + accumulator [decPointIndex];
-                        accumulator [decPointIndex] = 0;
-                        exponentAccumulator [decPointIndex] = 0;
-                    }
-
-                    accumulator [decPointIndex] = accumulator[decPointIndex] * 10 + digit;
-                    exponentAccumulator [decPointIndex]++;
+                    nonZeroDigitsDropped |= (digit != '0');
+
+                    if (!decimalPointFound)
+                        ++exponent;
                 }
             }
-            else if (decPointIndex == 0 && *text == '.')
+            else if (!decimalPointFound && *text == '.')
             {
                 ++text;
-                decPointIndex = 1;
-
-                if (numSignificantDigits > maxSignificantDigits)
-                {
-                    while ( text.isDigit() )
-                        ++text;
-                    break;
-                }
+                decimalPointFound = true;
             }
             else
             {
@@ -221,10 +194,11 @@ public:
             }
         }
 
-        result[0] = mulexp10( result[0], exponentAccumulator[0] ) + accumulator[0];
-
-        if (decPointIndex != 0)
-            result[1] = mulexp10( result[1], exponentAccumulator[1] ) + accumulator[1];
+        if (nonZeroDigitsDropped)
+        {
+            digits[numDigits++] = '1';
+            --exponent;
+        }
 
         c = *text;
         if ( (c == 'e' || c == 'E') && digitsFound )
@@ -237,18 +211,21 @@ public:
             case '+':   ++text;
             }
 
+            // anything beyond this is zero or infinity anyway
+            int64 explicitExponent = 0;
+
             while ( text.isDigit() )
-                exponent = (exponent * 10) + ( int( text.getAndAdvance() ) - '0' );
+            {
+                const int digit = int( text.getAndAdvance() ) - '0';
 
-            if (negativeExponent)
-                exponent = -exponent;
-        }
+                if (explicitExponent < 100000000)
+                    explicitExponent = (explicitExponent * 10) + digit;
+            }
 
-        double r = mulexp10( result[0], exponent + exponentAdjustment[0] );
-        if (decPointIndex != 0)
-            r += mulexp10( result[1], exponent - exponentAdjustment[1] );
+            exponent += negativeExponent ? -explicitExponent : explicitExponent;
+        }
 
-        return isNegative ? -r : r;
+        return decimal_to_double( digits, numDigits, exponent, isNegative );
     }
 
     /** Parses a character string, to read a floating-point value. */
@@ -623,9 +600,6 @@ public:
 
         return text;
     }
-
-private:
-    static double mulexp10( const double value, int exponent ) noexcept;
 };
 
 }
@@ -0,0 +1,120 @@
+#include "treecore/Checksum.h"
+#include "treecore/CpuDispatch.h"
+#include "treecore/DebugUtils.h"
+#include "treecore/SystemStats.h"
+
+#include "treecore/internal/Checksum_impl.h"
+
+namespace treecore
+{
+
+uint32 crc32_baseline( uint32 state, const uint8* data, size_t num ) noexcept
+{
+    return crc_update_tables( crc32_tables(), state, data, num );
+}
+
+uint32 crc32c_baseline( uint32 state, const uint8* data, size_t num ) noexcept
+{
+    return crc_update_tables( crc32c_tables(), state, data, num );
+}
+
+uint32 adler32_baseline( uint32 adler, const uint8* data, size_t num ) noexcept
+{
+    return adler32_update_scalar( adler, data, num );
+}
+
+static ChecksumKernel select_crc32() noexcept
+{
+    // PCLMULQDQ isn't part of any feature level, some CPUs with SSE4.2 lack it
+#if TREECORE_CPU_X86
+    if ( get_cpu_feature_level() >= CPU_LEVEL_SSE42 && SystemStats::hasPCLMULQDQ() )
+        return &crc32_pclmul;
+#endif
+
+    return &crc32_baseline;
+}
+
+static ChecksumKernel select_crc32c() noexcept
+{
+    static const CpuDispatchTable<ChecksumKernel> impls = { {
+        &crc32c_baseline,
+#if TREECORE_CPU_X86
+        &crc32c_sse42,
+#else
+        nullptr,
+#endif
+        nullptr,
+        nullptr
+    } };
+
+    return impls.select();
+}
+
+static ChecksumKernel select_adler32() noexcept
+{
+    static const CpuDispatchTable<ChecksumKernel> impls = { {
+        &adler32_baseline,
+#if TREECORE_CPU_X86
+        &adler32_ssse3,
+        &adler32_avx2,
+#else
+        nullptr,
+        nullptr,
+#endif
+        nullptr
+    } };
+
+    return impls.select();
+}
+
+uint32 checksum_initial_value( ChecksumType type ) noexcept
+{
+    return type == CHECKSUM_ADLER32 ? 1 : 0;
+}
+
+uint32 checksum_update( ChecksumType type, uint32 checksum, const void* data, size_t num_bytes ) noexcept
+{
+    switch (type)
+    {
+    case CHECKSUM_CRC32:   return checksum_crc32( checksum, data, num_bytes );
+    case CHECKSUM_CRC32C:  return checksum_crc32c( checksum, data, num_bytes );
+    case CHECKSUM_ADLER32: return checksum_adler32( checksum, data, num_bytes );
+    }
+
+    treecore_assert_false;
+    return checksum;
+}
+
+uint32 checksum_crc32( uint32 crc, const void* data, size_t num_bytes ) noexcept
+{
+    static const ChecksumKernel impl = select_crc32();
+    return ~impl( ~crc, static_cast<const uint8*>(data), num_bytes );
+}
+
+uint32 checksum_crc32c( uint32 crc, const void* data, size_t num_bytes ) noexcept
+{
+    static const ChecksumKernel impl = select_crc32c();
+    return ~impl( ~crc, static_cast<const uint8*>(data), num_bytes );
+}
+
+uint32 checksum_adler32( uint32 adler, const void* data, size_t num_bytes ) noexcept
+{
+    static const ChecksumKernel impl = select_adler32();
+    return impl( adler, static_cast<const uint8*>(data), num_bytes );
+}
+
+} // namespace treecore
+
+//
+// The bundled zlib computes checksums of gzip and zlib streams through
+// these, see zlib/crc32.c and zlib/adler32.c.
+//
+extern "C" unsigned long treecore_zlib_crc32( unsigned long crc, const unsigned char* buf, unsigned len )
+{
+    return treecore::checksum_crc32( treecore::uint32( crc ), buf, len );
+}
+
+extern "C" unsigned long treecore_zlib_adler32( unsigned long adler, const unsigned char* buf, unsigned len )
+{
+    return treecore::checksum_adler32( treecore::uint32( adler ), buf, len );
+}
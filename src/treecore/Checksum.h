@@ -0,0 +1,59 @@
+#ifndef TREECORE_CHECKSUM_H
+#define TREECORE_CHECKSUM_H
+
+#include "treecore/Common.h"
+#include "treecore/IntTypes.h"
+#include "treecore/PlatformDefs.h"
+
+#include <cstddef>
+
+namespace treecore
+{
+
+//
+// Checksums of byte ranges, computed with CRC32 and PCLMULQDQ instructions
+// when the CPU has them. The best implementation for current CPU is chosen
+// on first use, see get_cpu_feature_level().
+//
+// Each function continues a checksum from the value returned for previous
+// data, so that data can be checksummed piece by piece. Results are the
+// same as from zlib's crc32() and adler32().
+//
+
+enum ChecksumType
+{
+    CHECKSUM_CRC32,   ///< CRC-32 of ZIP, gzip and PNG
+    CHECKSUM_CRC32C,  ///< CRC-32C of Castagnoli, used by iSCSI, SCTP and ext4
+    CHECKSUM_ADLER32  ///< Adler-32 of zlib streams
+};
+
+/**
+ * @brief get the checksum of no data, to start with
+ *
+ * This is zero for CRCs and one for Adler-32.
+ */
+TREECORE_SHARED_API uint32 checksum_initial_value( ChecksumType type ) noexcept;
+
+/**
+ * @brief continue a checksum of any type with more data
+ */
+TREECORE_SHARED_API uint32 checksum_update( ChecksumType type, uint32 checksum, const void* data, size_t num_bytes ) noexcept;
+
+/**
+ * @brief continue a CRC-32 with more data, start with zero
+ */
+TREECORE_SHARED_API uint32 checksum_crc32( uint32 crc, const void* data, size_t num_bytes ) noexcept;
+
+/**
+ * @brief continue a CRC-32C with more data, start with zero
+ */
+TREECORE_SHARED_API uint32 checksum_crc32c( uint32 crc, const void* data, size_t num_bytes ) noexcept;
+
+/**
+ * @brief continue an Adler-32 with more data, start with one
+ */
+TREECORE_SHARED_API uint32 checksum_adler32( uint32 adler, const void* data, size_t num_bytes ) noexcept;
+
+} // namespace treecore
+
+#endif // TREECORE_CHECKSUM_H
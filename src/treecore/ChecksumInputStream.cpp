@@ -0,0 +1,60 @@
+#include "treecore/ChecksumInputStream.h"
+#include "treecore/DebugUtils.h"
+
+namespace treecore
+{
+
+ChecksumInputStream::ChecksumInputStream( InputStream* sourceStream, ChecksumType type, bool deleteSourceWhenDestroyed )
+    : source( sourceStream, deleteSourceWhenDestroyed )
+    , type( type )
+    , checksum( checksum_initial_value( type ) )
+{
+    treecore_assert( sourceStream != nullptr );
+}
+
+ChecksumInputStream::~ChecksumInputStream()
+{}
+
+void ChecksumInputStream::resetChecksum() noexcept
+{
+    checksum = checksum_initial_value( type );
+}
+
+int64 ChecksumInputStream::getTotalLength()
+{
+    return source->getTotalLength();
+}
+
+bool ChecksumInputStream::isExhausted()
+{
+    return source->isExhausted();
+}
+
+int ChecksumInputStream::read( void* destBuffer, int maxBytesToRead )
+{
+    const int num_read = source->read( destBuffer, maxBytesToRead );
+
+    if (num_read > 0)
+        checksum = checksum_update( type, checksum, destBuffer, size_t( num_read ) );
+
+    return num_read;
+}
+
+int64 ChecksumInputStream::getPosition()
+{
+    return source->getPosition();
+}
+
+bool ChecksumInputStream::setPosition( int64 newPosition )
+{
+    const int64 pos = source->getPosition();
+
+    if (newPosition < pos)
+        return false;
+
+    // InputStream::skipNextBytes() reads through read(), which updates checksum
+    skipNextBytes( newPosition - pos );
+    return source->getPosition() == newPosition;
+}
+
+} // namespace treecore
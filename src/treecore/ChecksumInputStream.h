@@ -0,0 +1,64 @@
+#ifndef TREECORE_CHECKSUM_INPUT_STREAM_H
+#define TREECORE_CHECKSUM_INPUT_STREAM_H
+
+#include "treecore/Checksum.h"
+#include "treecore/InputStream.h"
+#include "treecore/OptionalScopedPointer.h"
+
+namespace treecore
+{
+
+/**
+ * @brief input stream that computes a checksum of everything read through it
+ *
+ * Data is read from the source stream unchanged. Only forward skipping is
+ * supported, and skipped bytes are also checksummed, so that the checksum
+ * always covers the source from where reading started.
+ *
+ * @see ChecksumOutputStream, checksum_update()
+ */
+class TREECORE_SHARED_API ChecksumInputStream: public InputStream
+{
+public:
+    /**
+     * @param sourceStream              stream to read from
+     * @param type                      which checksum to compute
+     * @param deleteSourceWhenDestroyed whether sourceStream is deleted with this object
+     */
+    ChecksumInputStream( InputStream* sourceStream, ChecksumType type, bool deleteSourceWhenDestroyed = false );
+
+    ~ChecksumInputStream();
+
+    /**
+     * @brief get the checksum of all data read since created or reset
+     */
+    uint32 getChecksum() const noexcept { return checksum; }
+
+    ChecksumType getChecksumType() const noexcept { return type; }
+
+    /**
+     * @brief start a new checksum from current position
+     */
+    void resetChecksum() noexcept;
+
+    int64 getTotalLength() override;
+    bool  isExhausted() override;
+    int   read( void* destBuffer, int maxBytesToRead ) override;
+    int64 getPosition() override;
+
+    /**
+     * @brief only moving forward is supported, bytes in between are read and checksummed
+     */
+    bool setPosition( int64 newPosition ) override;
+
+private:
+    OptionalScopedPointer<InputStream> source;
+    ChecksumType type;
+    uint32 checksum;
+
+    TREECORE_DECLARE_NON_COPYABLE( ChecksumInputStream )
+};
+
+} // namespace treecore
+
+#endif // TREECORE_CHECKSUM_INPUT_STREAM_H
@@ -0,0 +1,52 @@
+#include "treecore/ChecksumOutputStream.h"
+#include "treecore/DebugUtils.h"
+
+namespace treecore
+{
+
+ChecksumOutputStream::ChecksumOutputStream( OutputStream* destStream, ChecksumType type, bool deleteDestStreamWhenDestroyed )
+    : destStream( destStream, deleteDestStreamWhenDestroyed )
+    , type( type )
+    , checksum( checksum_initial_value( type ) )
+{}
+
+ChecksumOutputStream::~ChecksumOutputStream()
+{
+    flush();
+}
+
+void ChecksumOutputStream::resetChecksum() noexcept
+{
+    checksum = checksum_initial_value( type );
+    numBytesWritten = 0;
+}
+
+void ChecksumOutputStream::flush()
+{
+    if (destStream != nullptr)
+        destStream->flush();
+}
+
+int64 ChecksumOutputStream::getPosition()
+{
+    return numBytesWritten;
+}
+
+bool ChecksumOutputStream::setPosition( int64 newPosition )
+{
+    return newPosition == numBytesWritten;
+}
+
+bool ChecksumOutputStream::write( const void* data, size_t num_bytes )
+{
+    treecore_assert( data != nullptr || num_bytes == 0 );
+
+    if (destStream != nullptr && !destStream->write( data, num_bytes ))
+        return false;
+
+    checksum = checksum_update( type, checksum, data, num_bytes );
+    numBytesWritten += int64( num_bytes );
+    return true;
+}
+
+} // namespace treecore
@@ -0,0 +1,68 @@
+#ifndef TREECORE_CHECKSUM_OUTPUT_STREAM_H
+#define TREECORE_CHECKSUM_OUTPUT_STREAM_H
+
+#include "treecore/Checksum.h"
+#include "treecore/OptionalScopedPointer.h"
+#include "treecore/OutputStream.h"
+
+namespace treecore
+{
+
+/**
+ * @brief output stream that computes a checksum of everything written to it
+ *
+ * Data is passed on to the destination stream unchanged. The destination may
+ * be nullptr, in which case data is only checksummed and then dropped.
+ *
+ * @see ChecksumInputStream, checksum_update()
+ */
+class TREECORE_SHARED_API ChecksumOutputStream: public OutputStream
+{
+public:
+    /**
+     * @param destStream                    stream to pass data on to, or nullptr
+     * @param type                          which checksum to compute
+     * @param deleteDestStreamWhenDestroyed whether destStream is deleted with this object
+     */
+    ChecksumOutputStream( OutputStream* destStream, ChecksumType type, bool deleteDestStreamWhenDestroyed = false );
+
+    ~ChecksumOutputStream();
+
+    /**
+     * @brief get the checksum of all data written since created or reset
+     */
+    uint32 getChecksum() const noexcept { return checksum; }
+
+    ChecksumType getChecksumType() const noexcept { return type; }
+
+    /**
+     * @brief start a new checksum, position is also reset to zero
+     */
+    void resetChecksum() noexcept;
+
+    void flush() override;
+
+    /**
+     * @brief get number of bytes written since created or reset
+     */
+    int64 getPosition() override;
+
+    /**
+     * @brief not supported, as checksum can't be taken back
+     */
+    bool setPosition( int64 newPosition ) override;
+
+    bool write( const void* data, size_t num_bytes ) override;
+
+private:
+    OptionalScopedPointer<OutputStream> destStream;
+    ChecksumType type;
+    uint32 checksum;
+    int64  numBytesWritten = 0;
+
+    TREECORE_DECLARE_NON_COPYABLE( ChecksumOutputStream )
+};
+
+} // namespace treecore
+
+#endif // TREECORE_CHECKSUM_OUTPUT_STREAM_H
@@ -0,0 +1,59 @@
+#include "treecore/CpuDispatch.h"
+#include "treecore/SystemStats.h"
+
+#include <cstdlib>
+#include <cstring>
+
+namespace treecore
+{
+
+static const char* _level_names_[NUM_CPU_LEVELS] = { "baseline", "sse42", "avx2", "avx512" };
+
+static CpuFeatureLevel _detect_cpu_feature_level_() noexcept
+{
+    CpuFeatureLevel level = CPU_LEVEL_BASELINE;
+
+#if TREECORE_CPU_X86
+    if ( SystemStats::hasSSSE3() && SystemStats::hasSSE41() && SystemStats::hasSSE42() )
+    {
+        level = CPU_LEVEL_SSE42;
+
+        if ( SystemStats::hasAVX() && SystemStats::hasAVX2() && SystemStats::hasFMA3() && SystemStats::hasBMI2() )
+        {
+            level = CPU_LEVEL_AVX2;
+
+            if ( SystemStats::hasAVX512F() && SystemStats::hasAVX512BW() && SystemStats::hasAVX512DQ() && SystemStats::hasAVX512VL() )
+                level = CPU_LEVEL_AVX512;
+        }
+    }
+#endif
+
+    // user can only lower the level
+    if (const char* limit = std::getenv( "TREECORE_CPU_LEVEL" ))
+    {
+        for (int i = 0; i < int(level); i++)
+        {
+            if (std::strcmp( limit, _level_names_[i] ) == 0)
+            {
+                level = CpuFeatureLevel( i );
+                break;
+            }
+        }
+    }
+
+    return level;
+}
+
+CpuFeatureLevel get_cpu_feature_level() noexcept
+{
+    static const CpuFeatureLevel level = _detect_cpu_feature_level_();
+    return level;
+}
+
+const char* get_cpu_feature_level_name( CpuFeatureLevel level ) noexcept
+{
+    treecore_assert( int(level) >= 0 && int(level) < NUM_CPU_LEVELS );
+    return _level_names_[level];
+}
+
+} // namespace treecore
@@ -0,0 +1,114 @@
+#ifndef TREECORE_CPU_DISPATCH_H
+#define TREECORE_CPU_DISPATCH_H
+
+#include "treecore/Common.h"
+#include "treecore/DebugUtils.h"
+#include "treecore/PlatformDefs.h"
+
+//
+// Attributes that allow one function to be compiled for an instruction set
+// wider than the one the whole binary is built for. The function must only
+// be called after checking get_cpu_feature_level(), usually through a
+// CpuDispatchTable. MSVC accepts any intrinsic without compiler flags, so
+// the attributes are empty there.
+//
+#if TREECORE_CPU_X86 && (TREECORE_COMPILER_GCC || TREECORE_COMPILER_CLANG)
+#    define TREECORE_TARGET_SSE42  __attribute__( ( target( "ssse3,sse4.1,sse4.2,popcnt" ) ) )
+#    define TREECORE_TARGET_AVX2   __attribute__( ( target( "ssse3,sse4.1,sse4.2,popcnt,avx,avx2,fma,bmi,bmi2" ) ) )
+#    define TREECORE_TARGET_AVX512 __attribute__( ( target( "ssse3,sse4.1,sse4.2,popcnt,avx,avx2,fma,bmi,bmi2,avx512f,avx512bw,avx512dq,avx512vl" ) ) )
+#else
+#    define TREECORE_TARGET_SSE42
+#    define TREECORE_TARGET_AVX2
+#    define TREECORE_TARGET_AVX512
+#endif
+
+namespace treecore
+{
+
+/**
+ * @brief groups of instruction sets that kernels are specialized for
+ *
+ * Each level includes all levels below it.
+ */
+enum CpuFeatureLevel
+{
+    CPU_LEVEL_BASELINE = 0, ///< what the binary is compiled for, SSE2/SSE3 on x86
+    CPU_LEVEL_SSE42,        ///< SSSE3, SSE4.1 and SSE4.2
+    CPU_LEVEL_AVX2,         ///< AVX, AVX2, FMA3 and BMI2
+    CPU_LEVEL_AVX512,       ///< AVX-512 F, BW, DQ and VL
+
+    NUM_CPU_LEVELS
+};
+
+/**
+ * @brief get the highest feature level usable on current CPU
+ *
+ * Detected once using SystemStats. The result can be lowered, but never
+ * raised, by setting environment variable TREECORE_CPU_LEVEL to one of
+ * "baseline", "sse42", "avx2" or "avx512" before the first call, which is
+ * useful for testing fallback paths on a fast machine.
+ */
+TREECORE_SHARED_API CpuFeatureLevel get_cpu_feature_level() noexcept;
+
+/**
+ * @brief get the name of a feature level, as accepted by TREECORE_CPU_LEVEL
+ */
+TREECORE_SHARED_API const char* get_cpu_feature_level_name( CpuFeatureLevel level ) noexcept;
+
+/**
+ * @brief implementations of one kernel for each feature level
+ *
+ * Implementations for levels above baseline are optional, leave them as
+ * nullptr if a kernel has nothing better to do at that level. The table is
+ * an aggregate, so a static table is constant-initialized and can be used
+ * by code running before main().
+ *
+ * The usual way is to resolve the table once into a function-local static,
+ * then all later calls cost one indirect call:
+ *
+ * @code
+ * typedef int (*SumFunc)( const int*, size_t );
+ *
+ * static const CpuDispatchTable<SumFunc> sum_impls = { {
+ *     sum_baseline, sum_sse42, sum_avx2, nullptr
+ * } };
+ *
+ * int sum( const int* data, size_t n )
+ * {
+ *     static const SumFunc impl = sum_impls.select();
+ *     return impl( data, n );
+ * }
+ * @endcode
+ */
+template<typename FuncType>
+struct CpuDispatchTable
+{
+    /**
+     * @brief get the best implementation not above the specified level
+     */
+    FuncType select( CpuFeatureLevel max_level ) const noexcept
+    {
+        for (int i = int(max_level); i > 0; i--)
+        {
+            if (impls[i] != nullptr)
+                return impls[i];
+        }
+
+        treecore_assert( impls[CPU_LEVEL_BASELINE] != nullptr );
+        return impls[CPU_LEVEL_BASELINE];
+    }
+
+    /**
+     * @brief get the best implementation usable on current CPU
+     */
+    FuncType select() const noexcept
+    {
+        return select( get_cpu_feature_level() );
+    }
+
+    FuncType impls[NUM_CPU_LEVELS];
+};
+
+} // namespace treecore
+
+#endif // TREECORE_CPU_DISPATCH_H
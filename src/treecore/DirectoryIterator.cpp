@@ -34,13 +34,18 @@ namespace treecore {
 DirectoryIterator::DirectoryIterator (const File& directory, bool recursive,
                                       const String& pattern, const int type)
   : wildCards (parseWildcards (pattern)),
+    // a single pattern of a non-recursive search is left to the OS iterator,
+    // so it isn't compiled at all
+    ownMatcher ((recursive || wildCards.size() > 1) ? new WildcardMatcher (wildCards, ! File::areFileNamesCaseSensitive())
+                                                    : nullptr),
+    matcher (ownMatcher),
     fileFinder (directory, (recursive || wildCards.size() > 1) ? "*" : pattern),
-    wildCard (pattern),
     path (File::addTrailingSeparator (directory.getFullPathName())),
     index (-1),
     totalNumFiles (-1),
     whatToLookFor (type),
     isRecursive (recursive),
+    usesMatcher (recursive || wildCards.size() > 1),
     hasBeenAdvanced (false)
 {
     // you have to specify the type of files you're looking for!
@@ -48,26 +53,30 @@ DirectoryIterator::DirectoryIterator (const File& directory, bool recursive,
     treecore_assert (type > 0 && type <= 7);
 }
 
-DirectoryIterator::~DirectoryIterator()
+DirectoryIterator::DirectoryIterator (const File& directory, bool recursive,
+                                      const WildcardMatcher& m, const int type)
+  : matcher (&m),
+    fileFinder (directory, "*"),
+    path (File::addTrailingSeparator (directory.getFullPathName())),
+    index (-1),
+    totalNumFiles (-1),
+    whatToLookFor (type),
+    isRecursive (recursive),
+    usesMatcher (true),
+    hasBeenAdvanced (false)
 {
+    // you have to specify the type of files you're looking for!
+    treecore_assert ((type & (File::findFiles | File::findDirectories)) != 0);
+    treecore_assert (type > 0 && type <= 7);
 }
 
-StringArray DirectoryIterator::parseWildcards (const String& pattern)
+DirectoryIterator::~DirectoryIterator()
 {
-    StringArray s;
-    s.addTokens (pattern, ";,", "\"'");
-    s.trim();
-    s.removeEmptyStrings();
-    return s;
 }
 
-bool DirectoryIterator::fileMatches (const StringArray& wildCards, const String& filename)
+StringArray DirectoryIterator::parseWildcards (const String& pattern)
 {
-    for (int i = 0; i < wildCards.size(); ++i)
-        if (filename.matchesWildcard (wildCards[i], ! File::areFileNamesCaseSensitive()))
-            return true;
-
-    return false;
+    return WildcardMatcher::splitPatterns (pattern);
 }
 
 bool DirectoryIterator::next()
@@ -103,9 +112,10 @@ bool DirectoryIterator::next (bool* const isDirResult, bool* const isHiddenResul
 
             if (isDirectory)
             {
+                // the sub-iterators use the patterns compiled by this one
                 if (isRecursive && ((whatToLookFor & File::ignoreHiddenFiles) == 0 || ! isHidden))
                     subIterator = new DirectoryIterator (File::createFileWithoutCheckingPath (path + filename),
-                                                         true, wildCard, whatToLookFor);
+                                                         true, *matcher, whatToLookFor);
 
                 matches = (whatToLookFor & File::findDirectories) != 0;
             }
@@ -115,8 +125,8 @@ bool DirectoryIterator::next (bool* const isDirResult, bool* const isHiddenResul
             }
 
             // if we're not relying on the OS iterator to do the wildcard match, do it now..
-            if (matches && (isRecursive || wildCards.size() > 1))
-                matches = fileMatches (wildCards, filename);
+            if (matches && usesMatcher)
+                matches = matcher->matches (filename);
 
             if (matches && (whatToLookFor & File::ignoreHiddenFiles) != 0)
                 matches = ! isHidden;
@@ -32,6 +32,7 @@
 #include "treecore/ScopedPointer.h"
 #include "treecore/StringArray.h"
 #include "treecore/File.h"
+#include "treecore/WildcardMatcher.h"
 
 //==============================================================================
 namespace treecore {
@@ -82,6 +83,17 @@ public:
                        const String& wildCard = "*",
                        int whatToLookFor = File::findFiles);
 
+    /** Creates a DirectoryIterator which finds the files whose names are matched by
+        a compiled set of patterns.
+
+        This saves compiling the same patterns again when searching several directories.
+        The matcher must stay valid while the iterator is used.
+    */
+    DirectoryIterator (const File& directory,
+                       bool isRecursive,
+                       const WildcardMatcher& matcher,
+                       int whatToLookFor = File::findFiles);
+
     /** Destructor. */
     ~DirectoryIterator();
 
@@ -148,18 +160,20 @@ private:
 
     friend struct ContainerDeletePolicy<NativeIterator::Pimpl>;
     StringArray wildCards;
+    ScopedPointer<WildcardMatcher> ownMatcher;
+    const WildcardMatcher* matcher;
     NativeIterator fileFinder;
-    String wildCard, path;
+    String path;
     int index;
     mutable int totalNumFiles;
     const int whatToLookFor;
     const bool isRecursive;
+    const bool usesMatcher;
     bool hasBeenAdvanced;
     ScopedPointer<DirectoryIterator> subIterator;
     File currentFile;
 
     static StringArray parseWildcards (const String& pattern);
-    static bool fileMatches (const StringArray& wildCards, const String& filename);
 
     TREECORE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DirectoryIterator)
 };
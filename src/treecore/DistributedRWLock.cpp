@@ -0,0 +1,133 @@
+#include "treecore/DistributedRWLock.h"
+#include "treecore/Futex.h"
+#include "treecore/Thread.h"
+
+namespace treecore
+{
+
+// every thread is bound to one reader slot on its first read lock, in
+// round-robin manner, so that concurrent readers are spread evenly
+#if TREECORE_OS_OSX || TREECORE_OS_IOS
+static __thread int _reader_slot_index_ = -1;
+#else
+static thread_local int _reader_slot_index_ = -1;
+#endif
+
+static int32 _next_reader_slot_index_ = 0;
+
+int DistributedRWLock::getCurrentSlotIndex() noexcept
+{
+    int index = _reader_slot_index_;
+
+    if unlikely(index < 0)
+    {
+        index = int( uint32( atomic_fetch_add<int32>( &_next_reader_slot_index_, 1 ) ) % NUM_SLOTS );
+        _reader_slot_index_ = index;
+    }
+
+    return index;
+}
+
+DistributedRWLock::DistributedRWLock() noexcept
+{
+    for (int i = 0; i < NUM_SLOTS; i++)
+        m_slots[i].num_readers = 0;
+}
+
+DistributedRWLock::~DistributedRWLock() noexcept
+{
+    treecore_assert( m_writer_flag == 0 );
+
+    for (int i = 0; i < NUM_SLOTS; i++)
+        treecore_assert( m_slots[i].num_readers == 0 );
+}
+
+void DistributedRWLock::enterRead() const noexcept
+{
+    int32* counter = &m_slots[getCurrentSlotIndex()].num_readers;
+
+    for (;; )
+    {
+        atomic_fetch_add<int32>( counter, 1 );
+
+        if likely( atomic_load( &m_writer_flag ) == 0 )
+            return;
+
+        // a writer is coming: step back and wait for it
+        atomic_fetch_sub<int32>( counter, 1 );
+
+        while ( atomic_load( &m_writer_flag ) != 0 )
+            futex_wait( &m_writer_flag, 1 );
+    }
+}
+
+bool DistributedRWLock::tryEnterRead() const noexcept
+{
+    int32* counter = &m_slots[getCurrentSlotIndex()].num_readers;
+
+    atomic_fetch_add<int32>( counter, 1 );
+
+    if likely( atomic_load( &m_writer_flag ) == 0 )
+        return true;
+
+    atomic_fetch_sub<int32>( counter, 1 );
+    return false;
+}
+
+void DistributedRWLock::exitRead() const noexcept
+{
+    const int32 prev = atomic_fetch_sub<int32>( &m_slots[getCurrentSlotIndex()].num_readers, 1 );
+    treecore_assert( prev > 0 ); // releasing a read lock that isn't held by current thread!
+    (void) prev;
+}
+
+void DistributedRWLock::waitReadersDrain() const noexcept
+{
+    for (int i = 0; i < NUM_SLOTS; i++)
+    {
+        for (int num_spin = 0; atomic_load( &m_slots[i].num_readers ) != 0; num_spin++)
+        {
+            if (num_spin < 64)
+                atomic_spin_pause();
+            else
+                Thread::yield();
+        }
+    }
+}
+
+void DistributedRWLock::enterWrite() const noexcept
+{
+    m_writer_mutex.enter();
+    atomic_store<int32>( &m_writer_flag, 1 );
+    waitReadersDrain();
+}
+
+bool DistributedRWLock::tryEnterWrite() const noexcept
+{
+    if ( !m_writer_mutex.tryEnter() )
+        return false;
+
+    atomic_store<int32>( &m_writer_flag, 1 );
+
+    for (int i = 0; i < NUM_SLOTS; i++)
+    {
+        if ( atomic_load( &m_slots[i].num_readers ) != 0 )
+        {
+            exitWrite();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void DistributedRWLock::exitWrite() const noexcept
+{
+    treecore_assert( m_writer_flag == 1 );
+
+    atomic_store<int32>( &m_writer_flag, 0 );
+    futex_wake_all( &m_writer_flag );
+    m_writer_mutex.exit();
+}
+
+} // namespace treecore
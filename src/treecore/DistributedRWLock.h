@@ -0,0 +1,111 @@
+#ifndef TREECORE_DISTRIBUTED_RW_LOCK_H
+#define TREECORE_DISTRIBUTED_RW_LOCK_H
+
+#include "treecore/AdaptiveMutex.h"
+#include "treecore/Align.h"
+#include "treecore/ClassUtils.h"
+#include "treecore/IntTypes.h"
+
+class TestFramework;
+
+namespace treecore
+{
+
+/**
+ * @brief read-write lock for read-mostly data, with distributed reader counters
+ *
+ * Reader count is split into many counters, each on its own cache line, and
+ * every thread is bound to one of them. Acquiring and releasing a read lock
+ * only modifies the counter of current thread, and reads the writer flag,
+ * so readers on different cores don't bounce cache lines between each other.
+ * The price is paid by writers: a writer raises the flag and then waits for
+ * all counters to drain, and readers arriving meanwhile step back and park
+ * until the writer leaves.
+ *
+ * Unlike ReadWriteLock, this lock is not recursive, and a thread holding a
+ * read lock must not try to acquire write lock.
+ *
+ * @see ReadWriteLock, SpinRWLock
+ */
+class TREECORE_SHARED_API DistributedRWLock
+{
+    friend class ::TestFramework;
+
+public:
+    enum { NUM_SLOTS = 32 };
+
+    class ScopedReadLock
+    {
+    public:
+        inline explicit ScopedReadLock( const DistributedRWLock& lock ) noexcept: m_lock( lock ) { m_lock.enterRead(); }
+        inline ~ScopedReadLock() noexcept { m_lock.exitRead(); }
+    private:
+        const DistributedRWLock& m_lock;
+        TREECORE_DECLARE_NON_COPYABLE( ScopedReadLock )
+    };
+
+    class ScopedWriteLock
+    {
+    public:
+        inline explicit ScopedWriteLock( const DistributedRWLock& lock ) noexcept: m_lock( lock ) { m_lock.enterWrite(); }
+        inline ~ScopedWriteLock() noexcept { m_lock.exitWrite(); }
+    private:
+        const DistributedRWLock& m_lock;
+        TREECORE_DECLARE_NON_COPYABLE( ScopedWriteLock )
+    };
+
+    DistributedRWLock() noexcept;
+    ~DistributedRWLock() noexcept;
+
+    /**
+     * @brief acquire read lock, block while a writer holds or waits for the lock
+     */
+    void enterRead() const noexcept;
+
+    /**
+     * @brief try to acquire read lock without blocking
+     * @return false if a writer holds or waits for the lock
+     */
+    bool tryEnterRead() const noexcept;
+
+    /**
+     * @brief release read lock acquired by current thread
+     */
+    void exitRead() const noexcept;
+
+    /**
+     * @brief acquire write lock, block until all readers and writers leave
+     */
+    void enterWrite() const noexcept;
+
+    /**
+     * @brief try to acquire write lock without blocking
+     * @return false if any reader or writer holds the lock
+     */
+    bool tryEnterWrite() const noexcept;
+
+    /**
+     * @brief release write lock, and wake readers waiting for it
+     */
+    void exitWrite() const noexcept;
+
+private:
+    struct TREECORE_ALN_BEGIN( 64 ) ReaderSlot
+    {
+        int32 num_readers;
+        int8  padding[64 - sizeof(int32)];
+    } TREECORE_ALN_END( 64 );
+
+    static int getCurrentSlotIndex() noexcept;
+    void waitReadersDrain() const noexcept;
+
+    mutable ReaderSlot m_slots[NUM_SLOTS];
+    mutable int32 m_writer_flag = 0;
+    AdaptiveMutex m_writer_mutex;
+
+    TREECORE_DECLARE_NON_COPYABLE( DistributedRWLock )
+};
+
+} // namespace treecore
+
+#endif // TREECORE_DISTRIBUTED_RW_LOCK_H
@@ -0,0 +1,311 @@
+#include "treecore/EpochManager.h"
+#include "treecore/AlignedMalloc.h"
+#include "treecore/Array.h"
+#include "treecore/Thread.h"
+
+#include <new>
+
+namespace treecore
+{
+
+struct RetiredObject
+{
+    void* object;
+    EpochManager::ReclaimFunc func;
+    void* context;
+};
+
+//
+// Each record is allocated on a cache line boundary, so that entering and
+// leaving critical section in one thread won't disturb other threads. Only
+// local_epoch and owner are touched by other threads, everything after
+// them is private to the owner thread.
+//
+struct EpochManager::ThreadRecord
+{
+    enum { NUM_BAGS = 3 };
+
+    // 0 when not in critical section, otherwise (epoch << 1) | 1
+    uint32 local_epoch = 0;
+    Thread::ThreadID owner = nullptr;
+    ThreadRecord* next = nullptr;
+
+    int   nesting = 0;
+    int   num_retired_since_collect = 0;
+    int64 num_pending = 0;
+
+    // bag i holds objects retired in bag_epoch[i], and bag_epoch[i] % 3 == i
+    uint32 bag_epoch[NUM_BAGS];
+    Array<RetiredObject> bags[NUM_BAGS];
+};
+
+// retire() tries to advance epoch after this number of objects are retired
+#define TREECORE_EPOCH_COLLECT_INTERVAL 64
+
+static inline uint32 _epoch_to_local_( uint32 epoch ) noexcept
+{
+    return (epoch << 1) | 1;
+}
+
+static void _reclaim_objects_( Array<RetiredObject>& objects )
+{
+    // reclaim functions may retire more objects, so the bag is moved away
+    // before calling them
+    Array<RetiredObject> tmp;
+    tmp.swapWith( objects );
+
+    for (int i = 0; i < tmp.size(); i++)
+        tmp[i].func( tmp[i].object, tmp[i].context );
+}
+
+// cache of last used record in current thread
+#if TREECORE_OS_OSX || TREECORE_OS_IOS
+static __thread uint32 _cached_manager_serial_ = 0;
+static __thread void*  _cached_record_ = nullptr;
+#else
+static thread_local uint32 _cached_manager_serial_ = 0;
+static thread_local void*  _cached_record_ = nullptr;
+#endif
+
+static uint32 _next_manager_serial_ = 0;
+
+EpochManager::EpochManager() noexcept
+{
+    // serial is never zero, which marks an empty cache
+    do
+        m_serial = atomic_add_fetch<uint32>( &_next_manager_serial_, 1 );
+    while (m_serial == 0);
+}
+
+EpochManager::~EpochManager() noexcept
+{
+    reclaimAll();
+
+    ThreadRecord* record = m_records;
+
+    while (record != nullptr)
+    {
+        ThreadRecord* next = record->next;
+        record->~ThreadRecord();
+        aligned_free( record );
+        record = next;
+    }
+
+    if (_cached_manager_serial_ == m_serial)
+    {
+        _cached_manager_serial_ = 0;
+        _cached_record_ = nullptr;
+    }
+}
+
+EpochManager::ThreadRecord* EpochManager::getCurrentRecord()
+{
+    if likely( _cached_manager_serial_ == m_serial )
+        return static_cast<ThreadRecord*>(_cached_record_);
+
+    ThreadRecord* record = findOrCreateRecord();
+    _cached_manager_serial_ = m_serial;
+    _cached_record_ = record;
+    return record;
+}
+
+EpochManager::ThreadRecord* EpochManager::findOrCreateRecord()
+{
+    const Thread::ThreadID self = Thread::getCurrentThreadId();
+
+    // record already owned by current thread
+    for (ThreadRecord* record = atomic_load( &m_records ); record != nullptr; record = record->next)
+    {
+        if (atomic_load( &record->owner ) == self)
+            return record;
+    }
+
+    // record released by some detached thread
+    for (ThreadRecord* record = atomic_load( &m_records ); record != nullptr; record = record->next)
+    {
+        if ( atomic_load( &record->owner ) == nullptr &&
+             atomic_compare_set<Thread::ThreadID>( &record->owner, nullptr, self ) )
+            return record;
+    }
+
+    // create new one
+    void* mem = aligned_malloc( sizeof(ThreadRecord), 64 );
+    ThreadRecord* record = new (mem) ThreadRecord();
+    record->owner = self;
+
+    for (int i = 0; i < ThreadRecord::NUM_BAGS; i++)
+        record->bag_epoch[i] = uint32( i );
+
+    ThreadRecord* head = atomic_load( &m_records );
+    do
+        record->next = head;
+    while ( !atomic_compare_exchange( &m_records, &head, record ) );
+
+    return record;
+}
+
+void EpochManager::enter() noexcept
+{
+    ThreadRecord* record = getCurrentRecord();
+
+    if (record->nesting++ == 0)
+    {
+        // If global epoch advances after we load it, we just announce an
+        // older epoch, which holds back the next advance and is still safe.
+        const uint32 epoch = atomic_load( &m_global_epoch );
+        atomic_store( &record->local_epoch, _epoch_to_local_( epoch ) );
+    }
+}
+
+void EpochManager::exit() noexcept
+{
+    ThreadRecord* record = getCurrentRecord();
+    treecore_assert( record->nesting > 0 );
+
+    if (--record->nesting == 0)
+        atomic_store<uint32>( &record->local_epoch, 0 );
+}
+
+bool EpochManager::isInCriticalSection() noexcept
+{
+    return getCurrentRecord()->nesting > 0;
+}
+
+void EpochManager::retire( void* object, ReclaimFunc func, void* context )
+{
+    treecore_assert( func != nullptr );
+    if unlikely(object == nullptr) return;
+
+    ThreadRecord* record = getCurrentRecord();
+
+    const uint32 epoch = atomic_load( &m_global_epoch );
+    const int    i     = int( epoch % ThreadRecord::NUM_BAGS );
+
+    if (record->bag_epoch[i] != epoch)
+    {
+        // The bag was filled at least three epochs ago, so everything in it
+        // is safe to reclaim.
+        const int num_reclaimed = record->bags[i].size();
+        record->bag_epoch[i] = epoch;
+        record->num_pending -= num_reclaimed;
+        atomic_fetch_sub<int64>( &m_num_pending, num_reclaimed );
+        _reclaim_objects_( record->bags[i] );
+    }
+
+    RetiredObject retired = { object, func, context };
+    record->bags[i].add( retired );
+    record->num_pending++;
+    atomic_fetch_add<int64>( &m_num_pending, 1 );
+
+    if (++record->num_retired_since_collect >= TREECORE_EPOCH_COLLECT_INTERVAL)
+        collect();
+}
+
+bool EpochManager::collect()
+{
+    ThreadRecord* self = getCurrentRecord();
+    self->num_retired_since_collect = 0;
+
+    // epoch can only be advanced when all threads in critical section have
+    // seen current epoch
+    const uint32 epoch = atomic_load( &m_global_epoch );
+    bool advanced = true;
+
+    for (ThreadRecord* record = atomic_load( &m_records ); record != nullptr; record = record->next)
+    {
+        const uint32 local = atomic_load( &record->local_epoch );
+        if ( local != 0 && local != _epoch_to_local_( epoch ) )
+        {
+            advanced = false;
+            break;
+        }
+    }
+
+    if (advanced)
+        advanced = atomic_compare_set( &m_global_epoch, epoch, epoch + 1 );
+
+    reclaimSafeBags( self );
+    return advanced;
+}
+
+void EpochManager::reclaimSafeBags( ThreadRecord* record )
+{
+    const uint32 epoch = atomic_load( &m_global_epoch );
+
+    for (int i = 0; i < ThreadRecord::NUM_BAGS; i++)
+    {
+        Array<RetiredObject>& bag = record->bags[i];
+
+        if ( bag.size() > 0 && epoch - record->bag_epoch[i] >= 2 )
+        {
+            const int num_reclaimed = bag.size();
+            record->num_pending -= num_reclaimed;
+            atomic_fetch_sub<int64>( &m_num_pending, num_reclaimed );
+            _reclaim_objects_( bag );
+        }
+    }
+}
+
+void EpochManager::synchronize()
+{
+    ThreadRecord* record = getCurrentRecord();
+    treecore_assert( record->nesting == 0 );
+
+    while (record->num_pending > 0)
+    {
+        if ( !collect() )
+            Thread::yield();
+    }
+}
+
+void EpochManager::detachCurrentThread()
+{
+    const Thread::ThreadID self = Thread::getCurrentThreadId();
+
+    for (ThreadRecord* record = atomic_load( &m_records ); record != nullptr; record = record->next)
+    {
+        if (atomic_load( &record->owner ) == self)
+        {
+            treecore_assert( record->nesting == 0 );
+
+            collect();
+            record->num_retired_since_collect = 0;
+            atomic_store<Thread::ThreadID>( &record->owner, nullptr );
+            break;
+        }
+    }
+
+    if (_cached_manager_serial_ == m_serial)
+    {
+        _cached_manager_serial_ = 0;
+        _cached_record_ = nullptr;
+    }
+}
+
+void EpochManager::reclaimAll() noexcept
+{
+    for (ThreadRecord* record = atomic_load( &m_records ); record != nullptr; record = record->next)
+    {
+        treecore_assert( atomic_load( &record->local_epoch ) == 0 );
+
+        for (int i = 0; i < ThreadRecord::NUM_BAGS; i++)
+        {
+            const int num_reclaimed = record->bags[i].size();
+            record->num_pending -= num_reclaimed;
+            atomic_fetch_sub<int64>( &m_num_pending, num_reclaimed );
+            _reclaim_objects_( record->bags[i] );
+        }
+    }
+}
+
+uint32 EpochManager::getEpoch() const noexcept
+{
+    return atomic_load( &m_global_epoch );
+}
+
+int64 EpochManager::getNumPending() const noexcept
+{
+    return atomic_load( &m_num_pending );
+}
+
+} // namespace treecore
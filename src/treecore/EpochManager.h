@@ -0,0 +1,170 @@
+#ifndef TREECORE_EPOCH_MANAGER_H
+#define TREECORE_EPOCH_MANAGER_H
+
+#include "treecore/ClassUtils.h"
+#include "treecore/IntTypes.h"
+#include "treecore/PlatformDefs.h"
+
+class TestFramework;
+
+namespace treecore
+{
+
+/**
+ * @brief epoch-based memory reclamation for lock-free data structures
+ *
+ * In a lock-free container, a node removed by one thread may still be
+ * visited by other threads that read its address before removal, so it
+ * can't be freed or recycled immediately. With an EpochManager, threads
+ * access the shared structure only inside a critical section (enter() /
+ * exit(), or a ScopedGuard), and removed nodes are handed to retire()
+ * instead of being freed. A retired node is reclaimed after the global
+ * epoch has advanced twice, which can only happen when every thread that
+ * was inside a critical section at retire time has left it.
+ *
+ * The critical section is cheap: it publishes the observed epoch into a
+ * cache line owned by current thread. Critical sections can be nested.
+ *
+ * Each thread registers itself on its first use of a manager, and keeps its
+ * own list of retired objects. A thread that is going to finish should call
+ * detachCurrentThread(), so that its slot can be reused; remaining objects
+ * retired by it are reclaimed by next owner of the slot, or by destructor of
+ * the manager.
+ *
+ * @see ObjectPool::retire
+ */
+class TREECORE_SHARED_API EpochManager
+{
+    friend class ::TestFramework;
+
+public:
+    /**
+     * @brief function to reclaim one retired object
+     * @param object  the retired object
+     * @param context user value given to retire()
+     */
+    typedef void (*ReclaimFunc)( void* object, void* context );
+
+    class ScopedGuard
+    {
+    public:
+        inline explicit ScopedGuard( EpochManager& manager ) noexcept: m_manager( manager ) { m_manager.enter(); }
+        inline ~ScopedGuard() noexcept { m_manager.exit(); }
+    private:
+        EpochManager& m_manager;
+        TREECORE_DECLARE_NON_COPYABLE( ScopedGuard )
+    };
+
+    EpochManager() noexcept;
+
+    /**
+     * @brief reclaims all objects that are still pending
+     *
+     * No thread should be inside critical section when manager is destroyed.
+     */
+    ~EpochManager() noexcept;
+
+    /**
+     * @brief enter critical section, pointers read from shared structure
+     *        stay valid until exit()
+     */
+    void enter() noexcept;
+
+    /**
+     * @brief leave critical section entered by enter()
+     */
+    void exit() noexcept;
+
+    /**
+     * @return true if current thread is inside critical section
+     */
+    bool isInCriticalSection() noexcept;
+
+    /**
+     * @brief defer reclamation of an object which is no longer reachable from
+     *        shared structure
+     *
+     * Can be called from inside or outside of critical section.
+     *
+     * @param object   the object to reclaim
+     * @param func     called with object and context when it is safe to do so
+     * @param context  user value passed to func
+     */
+    void retire( void* object, ReclaimFunc func, void* context = nullptr );
+
+    /**
+     * @brief defer deletion of an object which is no longer reachable from
+     *        shared structure
+     */
+    template<typename T>
+    void retireDelete( T* object )
+    {
+        retire( object, &delete_object<T>, nullptr );
+    }
+
+    /**
+     * @brief try to advance global epoch, and reclaim objects retired by
+     *        current thread that became safe
+     *
+     * This is called periodically by retire(), so there's normally no need to
+     * call it manually.
+     *
+     * @return true if epoch was advanced
+     */
+    bool collect();
+
+    /**
+     * @brief block until all objects retired by current thread are reclaimed
+     *
+     * Current thread must not be inside critical section.
+     */
+    void synchronize();
+
+    /**
+     * @brief unregister current thread from this manager
+     *
+     * Reclaims what is safe to reclaim now, and makes thread slot available
+     * for other threads.
+     */
+    void detachCurrentThread();
+
+    /**
+     * @brief reclaim all pending objects retired by all threads
+     *
+     * Only safe when no thread is inside critical section, and no thread is
+     * retiring objects, such as when the owner of protected structure is
+     * being destroyed.
+     */
+    void reclaimAll() noexcept;
+
+    /**
+     * @return current global epoch
+     */
+    uint32 getEpoch() const noexcept;
+
+    /**
+     * @return number of objects retired and not yet reclaimed, by all threads
+     */
+    int64 getNumPending() const noexcept;
+
+private:
+    struct ThreadRecord;
+
+    template<typename T>
+    static void delete_object( void* object, void* ) { delete static_cast<T*>(object); }
+
+    ThreadRecord* getCurrentRecord();
+    ThreadRecord* findOrCreateRecord();
+    void reclaimSafeBags( ThreadRecord* record );
+
+    uint32 m_serial;
+    mutable uint32 m_global_epoch = 0;
+    mutable int64 m_num_pending = 0;
+    ThreadRecord* m_records = nullptr;
+
+    TREECORE_DECLARE_NON_COPYABLE( EpochManager )
+};
+
+} // namespace treecore
+
+#endif // TREECORE_EPOCH_MANAGER_H
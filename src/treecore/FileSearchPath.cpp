@@ -26,9 +26,11 @@
   ==============================================================================
 */
 
+#include "treecore/DirectoryIterator.h"
 #include "treecore/File.h"
 #include "treecore/FileSearchPath.h"
 #include "treecore/StringRef.h"
+#include "treecore/WildcardMatcher.h"
 
 namespace treecore {
 
@@ -142,19 +144,49 @@ void FileSearchPath::removeNonExistentPaths()
 int FileSearchPath::findChildFiles (Array<File>& results,
                                     const int whatToLookFor,
                                     const bool searchRecursively,
-                                    const String& wildCardPattern) const
+                                    const WildcardMatcher& wildCards) const
 {
     int total = 0;
 
     for (int i = 0; i < directories.size(); ++i)
-        total += operator[] (i).findChildFiles (results,
-                                                whatToLookFor,
-                                                searchRecursively,
-                                                wildCardPattern);
+    {
+        for (DirectoryIterator di (operator[] (i), searchRecursively, wildCards, whatToLookFor); di.next();)
+        {
+            results.add (di.getFile());
+            ++total;
+        }
+    }
 
     return total;
 }
 
+int FileSearchPath::findChildFiles (Array<File>& results,
+                                    const int whatToLookFor,
+                                    const bool searchRecursively,
+                                    const String& wildCardPattern) const
+{
+    const StringArray patterns (WildcardMatcher::splitPatterns (wildCardPattern));
+
+    // a single pattern in one directory is left to the OS iterator, which
+    // ignores case, the same as DirectoryIterator does
+    if (! searchRecursively && patterns.size() <= 1)
+    {
+        int total = 0;
+
+        for (int i = 0; i < directories.size(); ++i)
+            total += operator[] (i).findChildFiles (results,
+                                                    whatToLookFor,
+                                                    searchRecursively,
+                                                    wildCardPattern);
+
+        return total;
+    }
+
+    const WildcardMatcher wildCards (patterns, ! File::areFileNamesCaseSensitive());
+
+    return findChildFiles (results, whatToLookFor, searchRecursively, wildCards);
+}
+
 bool FileSearchPath::isFileInPath (const File& fileToCheck,
                                    const bool checkRecursively) const
 {
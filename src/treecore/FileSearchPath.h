@@ -35,6 +35,7 @@
 namespace treecore {
 
 class File;
+class WildcardMatcher;
 
 //==============================================================================
 /**
@@ -131,10 +132,25 @@ public:
         @param whatToLookFor            a value from the File::TypesOfFileToFind enum, specifying whether to
                                         return files, directories, or both.
         @param searchRecursively        whether to recursively search the subdirectories too
-        @param wildCardPattern          a pattern to match against the filenames
+        @param wildCards                the compiled patterns to match against the filenames
         @returns the number of files added to the array
         @see File::findChildFiles
     */
+    int findChildFiles (Array<File>& results,
+                        int whatToLookFor,
+                        bool searchRecursively,
+                        const WildcardMatcher& wildCards) const;
+
+    /** Searches the path for a wildcard, compiling the patterns once for all the
+        directories.
+
+        As with File::findChildFiles(), a single pattern in a search which isn't
+        recursive is matched by the OS, which ignores case.
+
+        @param wildCardPattern          one or more patterns to match against the filenames,
+                                        separated by semicolons or commas, e.g. "*.jpg;*.png"
+        @see findChildFiles
+    */
     int findChildFiles (Array<File>& results,
                         int whatToLookFor,
                         bool searchRecursively,
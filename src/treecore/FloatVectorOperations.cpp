@@ -0,0 +1,114 @@
+#include "treecore/FloatVectorOperations.h"
+#include "treecore/CpuDispatch.h"
+#include "treecore/SimdFunc.h"
+
+#include "treecore/internal/FloatVectorOperations_impl.h"
+
+namespace treecore
+{
+
+namespace
+{
+
+// baseline kernels, on SSE2 registers
+struct BaselineOps
+{
+    typedef SIMDType<16> VecType;
+    enum { N_FLOAT = 4 };
+
+    static VecType zero() noexcept                { VecType r; simd_broadcast<float>( r, 0.0f ); return r; }
+    static VecType broadcast( float value ) noexcept { VecType r; simd_broadcast<float>( r, value ); return r; }
+
+    static VecType load( const float* src ) noexcept       { VecType r; simd_set_all<float>( r, src ); return r; }
+    static void    store( float* dest, const VecType& value ) noexcept { simd_get_all<float>( value, dest ); }
+
+    static VecType load_int32( const int32* src ) noexcept
+    {
+        VecType i, r;
+        simd_set_all<int32>( i, src );
+        simd_convert<float, int32>( r, i );
+        return r;
+    }
+
+    static VecType load_int16( const int16* src ) noexcept
+    {
+        // sign-extend by placing each int16 in the high half, then shift
+        const __m128i raw = _mm_loadl_epi64( (const __m128i*) src );
+        VecType r;
+        r.simd_by_float = _mm_cvtepi32_ps( _mm_srai_epi32( _mm_unpacklo_epi16( raw, raw ), 16 ) );
+        return r;
+    }
+
+    static VecType add( const VecType& a, const VecType& b ) noexcept { VecType r; simd_add<float>( r, a, b ); return r; }
+    static VecType mul( const VecType& a, const VecType& b ) noexcept { VecType r; simd_mul<float>( r, a, b ); return r; }
+    static VecType mul_add( const VecType& a, const VecType& b, const VecType& c ) noexcept { VecType r; simd_mul_add<float>( r, a, b, c ); return r; }
+
+    static VecType min( const VecType& a, const VecType& b ) noexcept { VecType r; simd_min<float>( r, a, b ); return r; }
+    static VecType max( const VecType& a, const VecType& b ) noexcept { VecType r; simd_max<float>( r, a, b ); return r; }
+    static VecType abs( const VecType& a ) noexcept { VecType r; simd_abs<float>( r, a ); return r; }
+
+    static float reduce_add( const VecType& a ) noexcept { return (a.values_by_float[0] + a.values_by_float[1]) + (a.values_by_float[2] + a.values_by_float[3]); }
+
+    static float reduce_min( const VecType& a ) noexcept { return simd_reduce_min<float>( a ); }
+    static float reduce_max( const VecType& a ) noexcept { return simd_reduce_max<float>( a ); }
+};
+
+} // anonymous namespace
+
+const FloatVectorKernelTable* get_float_vector_kernels_baseline() noexcept
+{
+    return &FloatVectorKernels<BaselineOps>::table;
+}
+
+static const FloatVectorKernelTable& kernels() noexcept
+{
+    static const CpuDispatchTable<const FloatVectorKernelTable*> impls = { {
+        get_float_vector_kernels_baseline(),
+        nullptr,
+#if TREECORE_CPU_X86
+        get_float_vector_kernels_avx2(),
+#else
+        nullptr,
+#endif
+        nullptr
+    } };
+
+    static const FloatVectorKernelTable* impl = impls.select();
+    return *impl;
+}
+
+void FloatVectorOperations::add( float* dest, const float* src, int num ) noexcept                           { kernels().add( dest, dest, src, num ); }
+void FloatVectorOperations::add( float* dest, const float* src1, const float* src2, int num ) noexcept       { kernels().add( dest, src1, src2, num ); }
+void FloatVectorOperations::add( float* dest, float amount, int num ) noexcept                               { kernels().add_scalar( dest, dest, amount, num ); }
+void FloatVectorOperations::add( float* dest, const float* src, float amount, int num ) noexcept             { kernels().add_scalar( dest, src, amount, num ); }
+
+void FloatVectorOperations::multiply( float* dest, const float* src, int num ) noexcept                      { kernels().multiply( dest, dest, src, num ); }
+void FloatVectorOperations::multiply( float* dest, const float* src1, const float* src2, int num ) noexcept  { kernels().multiply( dest, src1, src2, num ); }
+void FloatVectorOperations::multiply( float* dest, float multiplier, int num ) noexcept                      { kernels().multiply_scalar( dest, dest, multiplier, num ); }
+void FloatVectorOperations::multiply( float* dest, const float* src, float multiplier, int num ) noexcept    { kernels().multiply_scalar( dest, src, multiplier, num ); }
+
+void FloatVectorOperations::addWithMultiply( float* dest, const float* src, float multiplier, int num ) noexcept   { kernels().multiply_add_scalar( dest, src, multiplier, num ); }
+void FloatVectorOperations::addWithMultiply( float* dest, const float* src1, const float* src2, int num ) noexcept { kernels().multiply_add( dest, src1, src2, num ); }
+
+void FloatVectorOperations::min( float* dest, const float* src, float comp, int num ) noexcept           { kernels().min_scalar( dest, src, comp, num ); }
+void FloatVectorOperations::min( float* dest, const float* src1, const float* src2, int num ) noexcept   { kernels().min( dest, src1, src2, num ); }
+void FloatVectorOperations::max( float* dest, const float* src, float comp, int num ) noexcept           { kernels().max_scalar( dest, src, comp, num ); }
+void FloatVectorOperations::max( float* dest, const float* src1, const float* src2, int num ) noexcept   { kernels().max( dest, src1, src2, num ); }
+
+void FloatVectorOperations::clip( float* dest, const float* src, float low, float high, int num ) noexcept
+{
+    treecore_assert( low <= high );
+    kernels().clip( dest, src, low, high, num );
+}
+
+void FloatVectorOperations::abs( float* dest, const float* src, int num ) noexcept { kernels().abs( dest, src, num ); }
+
+void FloatVectorOperations::convertFixedToFloat( float* dest, const int32* src, float multiplier, int num ) noexcept { kernels().convert_int32( dest, src, multiplier, num ); }
+void FloatVectorOperations::convertFixedToFloat( float* dest, const int16* src, float multiplier, int num ) noexcept { kernels().convert_int16( dest, src, multiplier, num ); }
+
+float FloatVectorOperations::sum( const float* src, int num ) noexcept                       { return kernels().sum( src, num ); }
+float FloatVectorOperations::dotProduct( const float* src1, const float* src2, int num ) noexcept { return kernels().dot_product( src1, src2, num ); }
+float FloatVectorOperations::findMinimum( const float* src, int num ) noexcept               { return kernels().find_minimum( src, num ); }
+float FloatVectorOperations::findMaximum( const float* src, int num ) noexcept               { return kernels().find_maximum( src, num ); }
+
+} // namespace treecore
@@ -0,0 +1,99 @@
+#ifndef TREECORE_FLOAT_VECTOR_OPERATIONS_H
+#define TREECORE_FLOAT_VECTOR_OPERATIONS_H
+
+#include "treecore/Common.h"
+#include "treecore/IntTypes.h"
+#include "treecore/PlatformDefs.h"
+
+namespace treecore
+{
+
+/**
+ * @brief SIMD loops over float buffers
+ *
+ * Each function processes num elements. Destination buffers may be the same
+ * as a source buffer, but must not partially overlap with one. Buffers don't
+ * need to be aligned: elements before the first SIMD-aligned destination
+ * element and after the last full register are processed one by one. Buffers
+ * allocated by aligned_malloc() with 32 or 64 byte alignment skip the
+ * unaligned head entirely.
+ *
+ * The best implementation for current CPU is chosen on first use, see
+ * get_cpu_feature_level(). The AVX2 implementation uses fused multiply-add,
+ * so multiply-add and dot product results may differ from plain C++ code in
+ * the last bits, and sum and dot product also accumulate in a different
+ * order.
+ */
+class TREECORE_SHARED_API FloatVectorOperations
+{
+public:
+    /** dest[i] += src[i] */
+    static void add( float* dest, const float* src, int num ) noexcept;
+
+    /** dest[i] = src1[i] + src2[i] */
+    static void add( float* dest, const float* src1, const float* src2, int num ) noexcept;
+
+    /** dest[i] += amount */
+    static void add( float* dest, float amount, int num ) noexcept;
+
+    /** dest[i] = src[i] + amount */
+    static void add( float* dest, const float* src, float amount, int num ) noexcept;
+
+    /** dest[i] *= src[i] */
+    static void multiply( float* dest, const float* src, int num ) noexcept;
+
+    /** dest[i] = src1[i] * src2[i] */
+    static void multiply( float* dest, const float* src1, const float* src2, int num ) noexcept;
+
+    /** dest[i] *= multiplier */
+    static void multiply( float* dest, float multiplier, int num ) noexcept;
+
+    /** dest[i] = src[i] * multiplier */
+    static void multiply( float* dest, const float* src, float multiplier, int num ) noexcept;
+
+    /** dest[i] += src[i] * multiplier */
+    static void addWithMultiply( float* dest, const float* src, float multiplier, int num ) noexcept;
+
+    /** dest[i] += src1[i] * src2[i] */
+    static void addWithMultiply( float* dest, const float* src1, const float* src2, int num ) noexcept;
+
+    /** dest[i] = min( src[i], comp ) */
+    static void min( float* dest, const float* src, float comp, int num ) noexcept;
+
+    /** dest[i] = min( src1[i], src2[i] ) */
+    static void min( float* dest, const float* src1, const float* src2, int num ) noexcept;
+
+    /** dest[i] = max( src[i], comp ) */
+    static void max( float* dest, const float* src, float comp, int num ) noexcept;
+
+    /** dest[i] = max( src1[i], src2[i] ) */
+    static void max( float* dest, const float* src1, const float* src2, int num ) noexcept;
+
+    /** dest[i] = src[i] limited into [low, high] */
+    static void clip( float* dest, const float* src, float low, float high, int num ) noexcept;
+
+    /** dest[i] = |src[i]| */
+    static void abs( float* dest, const float* src, int num ) noexcept;
+
+    /** dest[i] = float( src[i] ) * multiplier */
+    static void convertFixedToFloat( float* dest, const int32* src, float multiplier, int num ) noexcept;
+
+    /** dest[i] = float( src[i] ) * multiplier */
+    static void convertFixedToFloat( float* dest, const int16* src, float multiplier, int num ) noexcept;
+
+    /** @return sum of all elements */
+    static float sum( const float* src, int num ) noexcept;
+
+    /** @return sum of src1[i] * src2[i] */
+    static float dotProduct( const float* src1, const float* src2, int num ) noexcept;
+
+    /** @return smallest element, or 0 if num is 0 */
+    static float findMinimum( const float* src, int num ) noexcept;
+
+    /** @return largest element, or 0 if num is 0 */
+    static float findMaximum( const float* src, int num ) noexcept;
+};
+
+} // namespace treecore
+
+#endif // TREECORE_FLOAT_VECTOR_OPERATIONS_H
@@ -0,0 +1,37 @@
+#ifndef TREECORE_FUTEX_H
+#define TREECORE_FUTEX_H
+
+#include "treecore/IntTypes.h"
+#include "treecore/PlatformDefs.h"
+
+namespace treecore
+{
+
+/**
+ * @brief block current thread while the value at addr equals expected
+ *
+ * This is the OS-level parking primitive used by AdaptiveMutex and FutexEvent.
+ * It maps to futex on Linux and WaitOnAddress on Windows; other systems use a
+ * hashed table of condition variables. Like all futex-style waits, it may
+ * return spuriously, so callers must re-check their condition in a loop.
+ *
+ * @param addr        address of the watched value
+ * @param expected    the thread is only parked if *addr still equals this value
+ * @param timeout_ms  maximum time to block, negative value for infinite
+ * @return false if the wait timed out, true otherwise
+ */
+TREECORE_SHARED_API bool futex_wait( int32* addr, int32 expected, int timeout_ms = -1 ) noexcept;
+
+/**
+ * @brief wake one thread blocked by futex_wait() on addr
+ */
+TREECORE_SHARED_API void futex_wake_one( int32* addr ) noexcept;
+
+/**
+ * @brief wake all threads blocked by futex_wait() on addr
+ */
+TREECORE_SHARED_API void futex_wake_all( int32* addr ) noexcept;
+
+} // namespace treecore
+
+#endif // TREECORE_FUTEX_H
@@ -0,0 +1,71 @@
+#include "treecore/FutexEvent.h"
+#include "treecore/Futex.h"
+#include "treecore/Time.h"
+
+namespace treecore
+{
+
+FutexEvent::FutexEvent( bool manual_reset ) noexcept
+    : m_manual_reset( manual_reset )
+{}
+
+FutexEvent::~FutexEvent() noexcept
+{
+    treecore_assert( atomic_load( &m_num_waiters ) == 0 );
+}
+
+bool FutexEvent::wait( int timeout_ms ) const noexcept
+{
+    const uint32 start_time = timeout_ms > 0 ? Time::getMillisecondCounter() : 0;
+
+    for (;; )
+    {
+        if (m_manual_reset)
+        {
+            if ( atomic_load( &m_signalled ) )
+                return true;
+        }
+        else
+        {
+            if ( atomic_compare_set<int32>( &m_signalled, 1, 0 ) )
+                return true;
+        }
+
+        int remain_ms = -1;
+
+        if (timeout_ms >= 0)
+        {
+            const uint32 elapsed = timeout_ms > 0 ? Time::getMillisecondCounter() - start_time : 0;
+            if ( elapsed >= uint32( timeout_ms ) )
+                return false;
+
+            remain_ms = timeout_ms - int(elapsed);
+        }
+
+        // the waiter count must be visible before we check the flag again
+        // inside futex_wait(), so that signal() won't skip the wake call
+        atomic_fetch_add<int32>( &m_num_waiters, 1 );
+        futex_wait( &m_signalled, 0, remain_ms );
+        atomic_fetch_sub<int32>( &m_num_waiters, 1 );
+    }
+}
+
+void FutexEvent::signal() const noexcept
+{
+    atomic_store<int32>( &m_signalled, 1 );
+
+    if ( atomic_load( &m_num_waiters ) > 0 )
+    {
+        if (m_manual_reset)
+            futex_wake_all( &m_signalled );
+        else
+            futex_wake_one( &m_signalled );
+    }
+}
+
+void FutexEvent::reset() const noexcept
+{
+    atomic_store<int32>( &m_signalled, 0 );
+}
+
+} // namespace treecore
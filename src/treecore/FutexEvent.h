@@ -0,0 +1,71 @@
+#ifndef TREECORE_FUTEX_EVENT_H
+#define TREECORE_FUTEX_EVENT_H
+
+#include "treecore/AtomicFunc.h"
+#include "treecore/ClassUtils.h"
+#include "treecore/IntTypes.h"
+
+class TestFramework;
+
+namespace treecore
+{
+
+/**
+ * @brief a WaitableEvent replacement that parks threads with futex_wait()
+ *
+ * The interface and semantics are the same as WaitableEvent. The difference
+ * is that no mutex is involved: signal() and a wait() on a signalled event
+ * cost a few atomic operations, and signal() only enters the OS when some
+ * thread is actually waiting.
+ *
+ * @see WaitableEvent, AdaptiveMutex
+ */
+class TREECORE_SHARED_API FutexEvent
+{
+    friend class ::TestFramework;
+
+public:
+    /**
+     * @brief create an event in unsignalled state
+     * @param manual_reset If false, a successful wait() resets the event
+     *        automatically. If true, the event stays signalled until reset()
+     *        is called.
+     */
+    explicit FutexEvent( bool manual_reset = false ) noexcept;
+
+    ~FutexEvent() noexcept;
+
+    /**
+     * @brief suspend current thread until the event is signalled
+     * @param timeout_ms max time to wait in milliseconds, negative value for
+     *        infinite wait
+     * @return true if the event has been signalled, false if timeout
+     *         expires first
+     */
+    bool wait( int timeout_ms = -1 ) const noexcept;
+
+    /**
+     * @brief set the event to signalled state
+     *
+     * For manual reset event, all waiting threads are woken. For automatic
+     * reset event, one waiting thread will be woken and reset the event; if
+     * no thread is waiting, the next call to wait() will return immediately.
+     */
+    void signal() const noexcept;
+
+    /**
+     * @brief set the event to unsignalled state
+     */
+    void reset() const noexcept;
+
+private:
+    mutable int32 m_signalled = 0;
+    mutable int32 m_num_waiters = 0;
+    const bool m_manual_reset;
+
+    TREECORE_DECLARE_NON_COPYABLE( FutexEvent )
+};
+
+} // namespace treecore
+
+#endif // TREECORE_FUTEX_EVENT_H
@@ -102,6 +102,11 @@ class HashMap: public RefCountObject
             , value( std::move( value ) )
         {}
 
+        HashMapItem( const HashMapItem& peer )
+            : key( peer.key )
+            , value( peer.value )
+        {}
+
         HashMapItem( HashMapItem&& peer )
             : key( peer.key )
             , value( std::move( peer.value ) )
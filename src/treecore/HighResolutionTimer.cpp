@@ -32,7 +32,9 @@
 #include "treecore/Config.h"
 
 // TODO: android and ios
-#if TREECORE_OS_LINUX || TREECORE_OS_OSX || TREECORE_OS_FREEBSD
+#if TREECORE_OS_LINUX
+#  include "treecore/native/linux_HighResolutionTimer.h"
+#elif TREECORE_OS_OSX || TREECORE_OS_FREEBSD
 #  include "treecore/native/posix_HighResolutionTimer.h"
 #elif TREECORE_OS_WINDOWS
 #  include "treecore/native/win32_HighResolutionTimer.h"
@@ -42,7 +44,13 @@
 
 namespace treecore {
 
-HighResolutionTimer::HighResolutionTimer()                    { pimpl = new Pimpl (*this); }
+HighResolutionTimer::HighResolutionTimer()
+    : realtimePriority (0),
+      measureJitter (false)
+{
+    pimpl = new Pimpl (*this);
+}
+
 HighResolutionTimer::~HighResolutionTimer()                   { stopTimer(); }
 
 void HighResolutionTimer::startTimer (int periodMs)           { pimpl->start (jmax (1, periodMs)); }
@@ -51,4 +59,97 @@ void HighResolutionTimer::stopTimer()                         { pimpl->stop(); }
 bool HighResolutionTimer::isTimerRunning() const noexcept     { return pimpl->periodMs != 0; }
 int HighResolutionTimer::getTimerInterval() const noexcept    { return pimpl->periodMs; }
 
+void HighResolutionTimer::setRealtimePriority (int priority) noexcept    { realtimePriority = jmax (0, priority); }
+int HighResolutionTimer::getRealtimePriority() const noexcept           { return realtimePriority; }
+
+void HighResolutionTimer::setJitterMeasurementEnabled (bool shouldMeasure) noexcept   { measureJitter = shouldMeasure; }
+bool HighResolutionTimer::isJitterMeasurementEnabled() const noexcept                 { return measureJitter; }
+
+HighResolutionTimer::JitterHistogram HighResolutionTimer::getJitterHistogram() const noexcept
+{
+    const SpinLock::ScopedLockType sl (jitterLock);
+    return jitter;
+}
+
+void HighResolutionTimer::resetJitterHistogram() noexcept
+{
+    const SpinLock::ScopedLockType sl (jitterLock);
+    jitter.clear();
+}
+
+void HighResolutionTimer::recordJitter (int64 deviationNanos, int64 numMissedTicks) noexcept
+{
+    if (! measureJitter)
+        return;
+
+    const SpinLock::ScopedLockType sl (jitterLock);
+    jitter.addSample (deviationNanos);
+
+    if (numMissedTicks > 0)
+        jitter.addMissedTicks (numMissedTicks);
+}
+
+//==============================================================================
+HighResolutionTimer::JitterHistogram::JitterHistogram() noexcept
+{
+    clear();
+}
+
+void HighResolutionTimer::JitterHistogram::clear() noexcept
+{
+    for (int i = 0; i < NUM_BUCKETS; ++i)
+        buckets[i] = 0;
+
+    numSamples = 0;
+    numMissedTicks = 0;
+    maxDeviationNanos = 0;
+    sumDeviationNanos = 0;
+}
+
+void HighResolutionTimer::JitterHistogram::addSample (int64 deviationNanos) noexcept
+{
+    if (deviationNanos < 0)
+        deviationNanos = -deviationNanos;
+
+    ++buckets[getBucketForDeviation (deviationNanos)];
+    ++numSamples;
+    sumDeviationNanos += deviationNanos;
+    maxDeviationNanos = jmax (maxDeviationNanos, deviationNanos);
+}
+
+void HighResolutionTimer::JitterHistogram::addMissedTicks (int64 numTicks) noexcept
+{
+    numMissedTicks += numTicks;
+}
+
+double HighResolutionTimer::JitterHistogram::getMeanDeviationNanos() const noexcept
+{
+    return numSamples > 0 ? sumDeviationNanos / (double) numSamples : 0.0;
+}
+
+int64 HighResolutionTimer::JitterHistogram::getNumSamplesInBucket (int bucket) const noexcept
+{
+    return isPositiveAndBelow (bucket, (int) NUM_BUCKETS) ? buckets[bucket] : 0;
+}
+
+int64 HighResolutionTimer::JitterHistogram::getBucketUpperBoundMicros (int bucket) noexcept
+{
+    treecore_assert (isPositiveAndBelow (bucket, (int) NUM_BUCKETS));
+    return ( (int64) 1 ) << bucket;
+}
+
+int HighResolutionTimer::JitterHistogram::getBucketForDeviation (int64 deviationNanos) noexcept
+{
+    uint64 micros = (uint64) (deviationNanos < 0 ? -deviationNanos : deviationNanos) / 1000;
+    int bucket = 0;
+
+    while (micros != 0 && bucket < NUM_BUCKETS - 1)
+    {
+        micros >>= 1;
+        ++bucket;
+    }
+
+    return bucket;
+}
+
 }
@@ -30,8 +30,10 @@
 #define TREECORE_HIGHRESOLUTIONTIMER_H
 
 #include "treecore/ClassUtils.h"
+#include "treecore/IntTypes.h"
 #include "treecore/LeakedObjectDetector.h"
 #include "treecore/ScopedPointer.h"
+#include "treecore/SpinLock.h"
 
 namespace treecore {
 
@@ -102,12 +104,98 @@ public:
     */
     int getTimerInterval() const noexcept;
 
+    //==============================================================================
+    /**
+        Statistics of how far each callback was fired away from its ideal time.
+
+        Deviations are collected into logarithmic buckets: bucket 0 holds
+        deviations below 1 microsecond, and bucket N (N > 0) holds deviations
+        in range [2^(N-1), 2^N) microseconds. The last bucket also collects
+        everything beyond its range.
+    */
+    class TREECORE_SHARED_API  JitterHistogram
+    {
+    public:
+        enum { NUM_BUCKETS = 24 };
+
+        JitterHistogram() noexcept;
+
+        /** Resets all counters to zero. */
+        void clear() noexcept;
+
+        /** Records one callback that fired deviationNanos away from its deadline. */
+        void addSample (int64 deviationNanos) noexcept;
+
+        /** Records ticks that elapsed without a callback, because the previous
+            callback took longer than the timer period. */
+        void addMissedTicks (int64 numTicks) noexcept;
+
+        int64 getNumSamples() const noexcept                 { return numSamples; }
+        int64 getNumMissedTicks() const noexcept             { return numMissedTicks; }
+        int64 getMaxDeviationNanos() const noexcept          { return maxDeviationNanos; }
+        double getMeanDeviationNanos() const noexcept;
+
+        /** Returns the number of samples that fell into a bucket. */
+        int64 getNumSamplesInBucket (int bucket) const noexcept;
+
+        /** Returns the exclusive upper bound of a bucket in microseconds. */
+        static int64 getBucketUpperBoundMicros (int bucket) noexcept;
+
+        /** Returns the bucket a deviation would be recorded into. */
+        static int getBucketForDeviation (int64 deviationNanos) noexcept;
+
+    private:
+        int64 buckets[NUM_BUCKETS];
+        int64 numSamples;
+        int64 numMissedTicks;
+        int64 maxDeviationNanos;
+        int64 sumDeviationNanos;
+    };
+
+    /** Sets the real-time priority of the timer thread.
+
+        On Linux, a positive value runs the timer thread under SCHED_FIFO with
+        the given priority (clamped to the range the system supports), and zero
+        leaves the thread under the default time-sharing scheduler. Raising the
+        policy usually requires CAP_SYS_NICE or a suitable RLIMIT_RTPRIO; if it
+        fails, the timer silently keeps running with default scheduling.
+
+        The value takes effect the next time the timer thread is launched, so
+        call this before startTimer(). Other platforms ignore this setting.
+    */
+    void setRealtimePriority (int priority) noexcept;
+
+    /** Returns the value given to setRealtimePriority(). */
+    int getRealtimePriority() const noexcept;
+
+    /** Enables or disables collecting callback deviations into the jitter
+        histogram. It is disabled by default. Only the Linux backend records
+        samples currently.
+    */
+    void setJitterMeasurementEnabled (bool shouldMeasure) noexcept;
+
+    /** Returns true if callback deviations are being collected. */
+    bool isJitterMeasurementEnabled() const noexcept;
+
+    /** Returns a snapshot of the jitter statistics collected so far. */
+    JitterHistogram getJitterHistogram() const noexcept;
+
+    /** Discards all collected jitter statistics. */
+    void resetJitterHistogram() noexcept;
+
 private:
     struct Pimpl;
     friend struct Pimpl;
     friend struct ContainerDeletePolicy<Pimpl>;
     ScopedPointer<Pimpl> pimpl;
 
+    int volatile realtimePriority;
+    bool volatile measureJitter;
+    SpinLock jitterLock;
+    JitterHistogram jitter;
+
+    void recordJitter (int64 deviationNanos, int64 numMissedTicks) noexcept;
+
     TREECORE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (HighResolutionTimer)
 };
 
@@ -30,6 +30,7 @@
 #define TREECORE_IDENTIFIER_H
 
 #include "treecore/String.h"
+#include "treecore/StringPool.h"
 #include "treecore/StringRef.h"
 
 class TestFramework;
@@ -44,7 +45,10 @@ namespace treecore {
     them can be slower than just using a String directly, so the optimal way to use them
     is to keep some static Identifier objects for the things you use often.
 
-    @see NamedValueSet, ValueTree
+    Each identifier also has a small integer index, which can be used to look it up in
+    a flat array instead of a hash table.
+
+    @see NamedValueSet, IdentifierMap, ValueTree
 */
 class TREECORE_SHARED_API  Identifier
 {
@@ -123,13 +127,14 @@ public:
     /** Returns this identifier's raw string pointer. */
     operator String::CharPointerType() const noexcept
     {
-        return String(m_name).getCharPointer();
+        return getCharPointer();
     }
 
     /** Returns this identifier's raw string pointer. */
     String::CharPointerType getCharPointer() const noexcept
     {
-        return String(m_name).getCharPointer();
+        // pooled text lives as long as the pool, unlike a temporary String
+        return m_name != nullptr ? String::CharPointerType( m_name ) : String::empty().getCharPointer();
     }
 
     /** Returns this identifier as a StringRef. */
@@ -138,6 +143,19 @@ public:
         return m_name;
     }
 
+    /** Returns a small integer which is unique to this identifier.
+
+        Identifiers are numbered from 1 upward in the order in which their names are
+        first used, and the null identifier is 0, so the index of every identifier
+        created so far is at most StringPool::getInstance()->size().
+
+        @see IdentifierMap
+    */
+    int getIndex() const noexcept
+    {
+        return m_name != nullptr ? StringPool::getPooledStringIndex( m_name ) : 0;
+    }
+
     /** Returns true if this Identifier is not null */
     bool isValid() const noexcept
     {
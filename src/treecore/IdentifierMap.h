@@ -0,0 +1,436 @@
+#ifndef TREECORE_IDENTIFIER_MAP_H
+#define TREECORE_IDENTIFIER_MAP_H
+
+#include "treecore/Array.h"
+#include "treecore/Identifier.h"
+
+class TestFramework;
+
+namespace treecore
+{
+
+/**
+ * @brief maps Identifiers to values, looked up by Identifier::getIndex()
+ *
+ * Entries are held in one dense array, in no particular order. Once a map
+ * holds more than a few entries, it also keeps a flat table from identifier
+ * index to entry, so that finding a key is two array loads and no hashing
+ * or string comparison. The table has a slot for every index between the
+ * smallest and the largest key, which is compact when the keys were first
+ * used around the same time, as the property names of similar objects
+ * usually are. Keys whose indices are too far apart for that are found in a
+ * small hash table instead, so that the table never has more than
+ * MAX_TABLE_SLOTS_PER_ENTRY slots for each entry. Maps with only a few
+ * entries compare the key with each of them instead.
+ *
+ * The interface follows HashMap, so the two can be swapped.
+ *
+ * @code
+ * IdentifierMap<var> map;
+ * map.set( "width", 100 );
+ *
+ * IdentifierMap<var>::Iterator i( map );
+ * while ( i.next() )
+ *     TREECORE_DBG( i.key().toString() << " -> " << i.value().toString() );
+ * @endcode
+ */
+template<typename ValueType>
+class IdentifierMap
+{
+    friend class ::TestFramework;
+
+    struct Entry
+    {
+        Entry() {}
+
+        Entry( Identifier key, const ValueType& value ): key( key ), value( value ) {}
+        Entry( Identifier key, ValueType&& value ): key( key ), value( std::move( value ) ) {}
+
+        Identifier key;
+        ValueType  value{};
+    };
+
+public:
+    /**
+     * @brief iterates over all entries
+     *
+     * Call next() before accessing the first entry. Changing the map makes
+     * the iterator invalid, except for changing the values.
+     */
+    class Iterator
+    {
+        friend class IdentifierMap;
+
+    public:
+        Iterator( IdentifierMap& target ): m_map( target ) {}
+
+        bool next() noexcept { return ++m_position < m_map.m_entries.size(); }
+
+        bool hasContent() const noexcept { return isPositiveAndBelow( m_position, m_map.m_entries.size() ); }
+
+        const Identifier& key() const noexcept { return m_map.m_entries[m_position].key; }
+
+        ValueType& value() noexcept { return m_map.m_entries[m_position].value; }
+
+    private:
+        IdentifierMap& m_map;
+        int m_position = -1;
+
+        TREECORE_DECLARE_NON_COPYABLE( Iterator )
+    };
+
+    class ConstIterator
+    {
+        friend class IdentifierMap;
+
+    public:
+        ConstIterator( const IdentifierMap& target ): m_map( target ) {}
+
+        bool next() noexcept { return ++m_position < m_map.m_entries.size(); }
+
+        bool hasContent() const noexcept { return isPositiveAndBelow( m_position, m_map.m_entries.size() ); }
+
+        const Identifier& key() const noexcept { return m_map.m_entries[m_position].key; }
+
+        const ValueType& value() const noexcept { return m_map.m_entries[m_position].value; }
+
+    private:
+        const IdentifierMap& m_map;
+        int m_position = -1;
+
+        TREECORE_DECLARE_NON_COPYABLE( ConstIterator )
+    };
+
+    /**
+     * @brief maps with at most this many entries have no index table
+     */
+    static const int MAX_ENTRIES_WITHOUT_TABLE = 4;
+
+    /**
+     * @brief keys spread over more indices than this many for each entry are
+     *        hashed instead of having a slot for each index
+     */
+    static const int MAX_TABLE_SLOTS_PER_ENTRY = 8;
+
+    IdentifierMap() noexcept {}
+
+    IdentifierMap( const IdentifierMap& other ) = default;
+    IdentifierMap( IdentifierMap&& other ) = default;
+
+    IdentifierMap& operator = ( const IdentifierMap& other ) = default;
+    IdentifierMap& operator = ( IdentifierMap&& other ) = default;
+
+    /**
+     * @brief whether both maps hold the same keys with equal values, in any
+     *        order
+     */
+    bool operator == ( const IdentifierMap& other ) const
+    {
+        if ( size() != other.size() )
+            return false;
+
+        for (const Entry& entry : m_entries)
+        {
+            const ValueType* const otherValue = other.find( entry.key );
+
+            if (otherValue == nullptr || !(*otherValue == entry.value))
+                return false;
+        }
+
+        return true;
+    }
+
+    bool operator != ( const IdentifierMap& other ) const { return !operator == ( other ); }
+
+    int size() const noexcept { return m_entries.size(); }
+
+    bool isEmpty() const noexcept { return m_entries.size() == 0; }
+
+    void clear()
+    {
+        m_entries.clear();
+        m_table.clear();
+        m_hashed = false;
+    }
+
+    /**
+     * @brief get a pointer to the value of key, or nullptr if there is none
+     */
+    ValueType* find( const Identifier& key ) noexcept
+    {
+        const int position = indexOf( key );
+        return position >= 0 ? &m_entries[position].value : nullptr;
+    }
+
+    const ValueType* find( const Identifier& key ) const noexcept
+    {
+        const int position = indexOf( key );
+        return position >= 0 ? &m_entries[position].value : nullptr;
+    }
+
+    bool contains( const Identifier& key ) const noexcept { return indexOf( key ) >= 0; }
+
+    /**
+     * @brief get the value of key, which is added with a default value if it
+     *        is not there yet
+     */
+    ValueType& operator [] ( const Identifier& key )
+    {
+        const int position = indexOf( key );
+
+        if (position >= 0)
+            return m_entries[position].value;
+
+        return m_entries[addEntry( Entry( key, ValueType() ) )].value;
+    }
+
+    const ValueType& getOrDefault( const Identifier& key, const ValueType& defaultValue ) const noexcept
+    {
+        const ValueType* const value = find( key );
+        return value != nullptr ? *value : defaultValue;
+    }
+
+    /**
+     * @brief point result to the entry of key
+     * @return false if there is no such entry, then result is not changed
+     */
+    bool select( const Identifier& key, Iterator& result ) noexcept
+    {
+        return selectPosition( indexOf( key ), result );
+    }
+
+    bool select( const Identifier& key, ConstIterator& result ) const noexcept
+    {
+        return selectPosition( indexOf( key ), result );
+    }
+
+    /**
+     * @brief add key with value if there is no entry of key yet, and point
+     *        result to the entry
+     * @return true if the entry was added, false if it was already there and
+     *         is left unchanged
+     */
+    bool insertOrSelect( const Identifier& key, const ValueType& value, Iterator& result )
+    {
+        const int position = indexOf( key );
+
+        if ( selectPosition( position, result ) )
+            return false;
+
+        result.m_position = addEntry( Entry( key, value ) );
+        return true;
+    }
+
+    bool insertOrSelect( const Identifier& key, ValueType&& value, Iterator& result )
+    {
+        const int position = indexOf( key );
+
+        if ( selectPosition( position, result ) )
+            return false;
+
+        result.m_position = addEntry( Entry( key, std::move( value ) ) );
+        return true;
+    }
+
+    void set( const Identifier& key, const ValueType& value ) { operator [] ( key ) = value; }
+
+    void set( const Identifier& key, ValueType&& value ) { operator [] ( key ) = std::move( value ); }
+
+    /**
+     * @brief remove the entry of key, if there is one
+     *
+     * The last entry is moved into the place of the removed one.
+     */
+    bool remove( const Identifier& key )
+    {
+        const int position = indexOf( key );
+
+        if (position < 0)
+            return false;
+
+        const int last = m_entries.size() - 1;
+
+        if (m_hashed)
+        {
+            removeHashSlot( findHashSlot( key.getIndex() ) );
+
+            if (position != last)
+                m_table[findHashSlot( m_entries[last].key.getIndex() )] = position + 1;
+        }
+        else if (m_table.size() > 0)
+        {
+            m_table[key.getIndex() - m_tableStart] = 0;
+
+            if (position != last)
+                m_table[m_entries[last].key.getIndex() - m_tableStart] = position + 1;
+        }
+
+        if (position != last)
+            m_entries[position] = std::move( m_entries[last] );
+
+        m_entries.removeLast();
+        return true;
+    }
+
+    Array<Identifier> getAllKeys() const
+    {
+        Array<Identifier> keys;
+        keys.ensureStorageAllocated( m_entries.size() );
+
+        for (const Entry& entry : m_entries)
+            keys.add( entry.key );
+
+        return keys;
+    }
+
+private:
+    int indexOf( const Identifier& key ) const noexcept
+    {
+        if (m_hashed)
+            return m_table.getRawDataConstPointer()[findHashSlot( key.getIndex() )] - 1;
+
+        if (m_table.size() > 0)
+        {
+            const unsigned int slot = unsigned(key.getIndex() - m_tableStart);
+            return slot < unsigned(m_table.size()) ? m_table.getRawDataConstPointer()[slot] - 1 : -1;
+        }
+
+        // no early exit, which would be mispredicted whenever the position of
+        // the key changes
+        const Entry* const entries = m_entries.getRawDataConstPointer();
+        const char* const name = key.getPtr();
+        int position = -1;
+
+        for (int i = 0; i < m_entries.size(); ++i)
+            position = entries[i].key.getPtr() == name ? i : position;
+
+        return position;
+    }
+
+    template<typename IteratorType>
+    static bool selectPosition( int position, IteratorType& result ) noexcept
+    {
+        if (position < 0)
+            return false;
+
+        result.m_position = position;
+        return true;
+    }
+
+    int addEntry( Entry&& entry )
+    {
+        const int position = m_entries.size();
+        const int index    = entry.key.getIndex();
+
+        m_entries.add( std::move( entry ) );
+
+        if (m_hashed && m_entries.size() * 2 <= m_table.size())
+            m_table[findHashSlot( index )] = position + 1;
+        else if ( !m_hashed && m_table.size() > 0 && isPositiveAndBelow( index - m_tableStart, m_table.size() ) )
+            m_table[index - m_tableStart] = position + 1;
+        else if (m_table.size() > 0 || m_entries.size() > MAX_ENTRIES_WITHOUT_TABLE)
+            rebuildTable(); // a table that exists has to hold every key, however few
+
+        return position;
+    }
+
+    // The table spans the indices from the smallest key to the largest one,
+    // and holds position + 1 of their entries, so that zero means no entry.
+    // Room is left on both sides, most at the end, for identifiers created
+    // later, which get larger indices. If that would take too many slots, the
+    // positions are hashed by index into a table at most a quarter full.
+    void rebuildTable()
+    {
+        int first = m_entries[0].key.getIndex();
+        int last  = first;
+
+        for (const Entry& entry : m_entries)
+        {
+            first = jmin( first, entry.key.getIndex() );
+            last  = jmax( last, entry.key.getIndex() );
+        }
+
+        const int64 span     = int64( last ) - first + 1;
+        const int64 start    = jmax( int64( 0 ), first - span / 4 );
+        const int64 numSlots = jmax( last + span / 2 + 1 - start, int64( 16 ) );
+        const int   maxSlots = jmax( m_entries.size() * MAX_TABLE_SLOTS_PER_ENTRY, 16 );
+
+        m_table.clearQuick();
+
+        if (numSlots <= maxSlots)
+        {
+            m_hashed     = false;
+            m_tableStart = int( start );
+            m_table.resize( int( numSlots ) );
+
+            for (int i = 0; i < m_entries.size(); ++i)
+                m_table[m_entries[i].key.getIndex() - m_tableStart] = i + 1;
+
+            return;
+        }
+
+        int numHashSlots = 16;
+        while (numHashSlots < m_entries.size() * 4)
+            numHashSlots *= 2;
+
+        m_hashed     = true;
+        m_tableStart = 0;
+        m_table.resize( numHashSlots );
+
+        for (int i = 0; i < m_entries.size(); ++i)
+            m_table[findHashSlot( m_entries[i].key.getIndex() )] = i + 1;
+    }
+
+    static unsigned int hashIndex( int index ) noexcept
+    {
+        const unsigned int h = unsigned(index) * 0x9e3779b1u;
+        return h ^ (h >> 16);
+    }
+
+    // the slot of the entry with index, or the empty slot where it would go
+    int findHashSlot( int index ) const noexcept
+    {
+        const int* const   table   = m_table.getRawDataConstPointer();
+        const Entry* const entries = m_entries.getRawDataConstPointer();
+        const unsigned int mask    = unsigned(m_table.size() - 1);
+
+        for (unsigned int slot = hashIndex( index ) & mask;; slot = (slot + 1) & mask)
+        {
+            if (table[slot] == 0 || entries[table[slot] - 1].key.getIndex() == index)
+                return int( slot );
+        }
+    }
+
+    // Empties a slot of the hash table, moving later entries of the same run
+    // back into it if they can't be found past it any more. Other entries
+    // have to be where their slots point to.
+    void removeHashSlot( int emptied ) noexcept
+    {
+        int* const         table   = m_table.getRawDataPointer();
+        const Entry* const entries = m_entries.getRawDataConstPointer();
+        const unsigned int mask    = unsigned(m_table.size() - 1);
+        unsigned int       hole    = unsigned(emptied);
+
+        for (unsigned int slot = (hole + 1) & mask; table[slot] != 0; slot = (slot + 1) & mask)
+        {
+            const unsigned int home = hashIndex( entries[table[slot] - 1].key.getIndex() ) & mask;
+
+            if ( ( (slot - home) & mask ) >= ( (slot - hole) & mask ) )
+            {
+                table[hole] = table[slot];
+                hole = slot;
+            }
+        }
+
+        table[hole] = 0;
+    }
+
+    Array<Entry> m_entries;
+    Array<int>   m_table;
+    int  m_tableStart = 0;  ///< index of the identifier in the first slot of m_table
+    bool m_hashed = false;  ///< whether m_table is hashed by index instead
+};
+
+} // namespace treecore
+
+#endif // TREECORE_IDENTIFIER_MAP_H
@@ -1,4 +1,9 @@
 #include "treecore/IdentifierWithIndex.h"
+#include "treecore/HeapBlock.h"
+
+#include "treecore/internal/String_private.h"
+
+#include <cstring>
 
 namespace treecore
 {
@@ -42,4 +47,34 @@ IdentifierWithIndex::~IdentifierWithIndex() noexcept
 {
 }
 
+Identifier IdentifierWithIndex::operator[](const unsigned int i) const
+{
+    // join name and number in place, and pool them without a temporary String
+    char digits[NumberToStringConverters::charsNeededForInt];
+    char* const digitsEnd = digits + numElementsInArray(digits);
+    const char* const firstDigit = NumberToStringConverters::numberToString(digitsEnd, i);
+    const size_t numDigits = size_t(digitsEnd - firstDigit - 1);
+
+    const char* const name = m_content.getPtr();
+    const size_t nameBytes = name != nullptr ? std::strlen(name) : 0;
+    const size_t numBytes = nameBytes + numDigits;
+
+    char stackBuffer[128];
+    HeapBlock<char> heapBuffer;
+    char* text = stackBuffer;
+
+    if (numBytes >= sizeof(stackBuffer))
+    {
+        heapBuffer.malloc(numBytes + 1);
+        text = heapBuffer.getData();
+    }
+
+    if (nameBytes > 0)
+        std::memcpy(text, name, nameBytes);
+
+    std::memcpy(text + nameBytes, firstDigit, numDigits + 1);
+
+    return Identifier(String::CharPointerType(text), String::CharPointerType(text + numBytes));
+}
+
 } // namespace treecore
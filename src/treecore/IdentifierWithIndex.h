@@ -33,7 +33,8 @@ public:
 
     bool isNull() const noexcept{ return m_content.isNull(); }
 
-    forcedinline Identifier operator[](const unsigned int i) const { return m_content.toString() + String(i); }
+    /** Returns the identifier of the name followed by i, like "name12". */
+    Identifier operator[](const unsigned int i) const;
 
 private:
     Identifier m_content;
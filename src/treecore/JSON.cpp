@@ -30,14 +30,227 @@
 #include "treecore/File.h"
 #include "treecore/InputStream.h"
 #include "treecore/JSON.h"
-#include "treecore/MemoryOutputStream.h"
 #include "treecore/NewLine.h"
 #include "treecore/Result.h"
+#include "treecore/StringBuilder.h"
 #include "treecore/StringRef.h"
+#include "treecore/UTF8Functions.h"
 #include "treecore/Variant.h"
 
+#include "treecore/internal/JSONScanner.h"
+
+#include <cstring>
+
 namespace treecore {
 
+//==============================================================================
+// Parses JSON by jumping from one structural position found by JSONScanner
+// to the next one, instead of walking through whitespace and strings one
+// character at a time. It accepts the same text as JSONParser and builds
+// the same values, but simply gives up at anything unexpected, including
+// errors and single-quoted strings, and leaves such text to JSONParser.
+class IndexedJSONParser
+{
+public:
+    IndexedJSONParser ( const String::CharPointerType t )
+        : text( t.getAddress() ), numBytes( std::strlen( t.getAddress() ) ), scanner( text, numBytes )
+    {}
+
+    bool parseObjectOrArray( var& result )
+    {
+        size_t pos = skipWhitespace( 0 );
+
+        if (pos == numBytes)
+        {
+            result = var();
+            return true;
+        }
+
+        switch (text[pos++])
+        {
+        case '{':    return parseObject( pos, result );
+        case '[':    return parseArray( pos, result );
+        }
+
+        return false;
+    }
+
+    bool parseAny( var& result )
+    {
+        size_t pos = 0;
+        return parseAny( pos, result );
+    }
+
+private:
+    const char* const text;
+    const size_t numBytes;
+    JSONScanner scanner;
+
+    // Whitespace is never structural, so the first byte after a run of it
+    // is the next structural position.
+    size_t skipWhitespace( const size_t pos ) noexcept
+    {
+        if ( pos < numBytes && JSONScanner::isWhitespace( text[pos] ) )
+            return scanner.next( pos );
+
+        return pos;
+    }
+
+    bool parseAny( size_t& pos, var& result )
+    {
+        pos = skipWhitespace( pos );
+
+        if (pos == numBytes)
+            return false;
+
+        switch (text[pos])
+        {
+        case '{':    return parseObject( ++pos, result );
+        case '[':    return parseArray( ++pos, result );
+
+        case '"':
+        {
+            String s;
+            if ( !parseString( ++pos, s ) )
+                return false;
+
+            result = s;
+            return true;
+        }
+
+        case '\'':  return false;
+        }
+
+        // numbers and literals are short
+        String::CharPointerType t( text + pos );
+
+        if ( JSONParser::parseAny( t, result ).failed() )
+            return false;
+
+        pos = (size_t) ( t.getAddress() - text );
+        return true;
+    }
+
+    // pos is after the opening quote
+    bool parseString( size_t& pos, String& result )
+    {
+        const size_t end = scanner.next( pos );
+
+        if (end == numBytes || text[end] != '"')
+            return false;
+
+        const char* const start = text + pos;
+        const size_t length = end - pos;
+
+        if ( std::memchr( start, '\\', length ) == nullptr && utf8_validate( start, length ) )
+        {
+            result = String( CharPointer_UTF8( start ), CharPointer_UTF8( text + end ) );
+        }
+        else
+        {
+            String::CharPointerType t( start );
+            var parsed;
+
+            if ( JSONParser::parseString( '"', t, parsed ).failed() || t.getAddress() != text + end + 1 )
+                return false;
+
+            result = parsed.toString();
+        }
+
+        pos = end + 1;
+        return true;
+    }
+
+    bool parseObject( size_t& pos, var& result )
+    {
+        DynamicObject* const resultObject = new DynamicObject();
+        result = resultObject;
+        NamedValueSet& resultProperties = resultObject->getProperties();
+
+        for (;; )
+        {
+            pos = skipWhitespace( pos );
+
+            if (pos == numBytes)
+                return false;
+
+            const char c = text[pos++];
+
+            if (c == '}')
+                return true;
+
+            String name;
+            if ( c != '"' || !parseString( pos, name ) )
+                return false;
+
+            const Identifier propertyName( name );
+            if ( !propertyName.isValid() )
+                return false;
+
+            pos = skipWhitespace( pos );
+
+            if (pos == numBytes || text[pos++] != ':')
+                return false;
+
+            resultProperties.set( propertyName, var() );
+
+            if ( !parseAny( pos, *resultProperties.getVarPointer( propertyName ) ) )
+                return false;
+
+            pos = skipWhitespace( pos );
+
+            if (pos == numBytes)
+                return false;
+
+            const char nextChar = text[pos++];
+
+            if (nextChar == '}')
+                return true;
+
+            if (nextChar != ',')
+                return false;
+        }
+    }
+
+    bool parseArray( size_t& pos, var& result )
+    {
+        result = var( Array<var>() );
+        Array<var>* const destArray = result.getArray();
+
+        for (;; )
+        {
+            pos = skipWhitespace( pos );
+
+            if (pos == numBytes)
+                return false;
+
+            if (text[pos] == ']')
+            {
+                ++pos;
+                return true;
+            }
+
+            destArray->add( var() );
+
+            if ( !parseAny( pos, destArray->operator [] ( destArray->size() - 1 ) ) )
+                return false;
+
+            pos = skipWhitespace( pos );
+
+            if (pos == numBytes)
+                return false;
+
+            const char nextChar = text[pos++];
+
+            if (nextChar == ']')
+                return true;
+
+            if (nextChar != ',')
+                return false;
+        }
+    }
+};
+
 //==============================================================================
 var JSON::parse( const String& text )
 {
@@ -53,6 +266,11 @@ var JSON::fromString( StringRef text )
 {
     var result;
 
+    if ( IndexedJSONParser( text.text ).parseAny( result ) )
+        return result;
+
+    result = var();
+
     if ( !JSONParser::parseAny( text.text, result ) )
         result = var();
 
@@ -71,14 +289,22 @@ var JSON::parse( const File& file )
 
 Result JSON::parse( const String& text, var& result )
 {
+    var parsed;
+
+    if ( IndexedJSONParser( text.getCharPointer() ).parseObjectOrArray( parsed ) )
+    {
+        result.swapWith( parsed );
+        return Result::ok();
+    }
+
     return JSONParser::parseObjectOrArray( text.getCharPointer(), result );
 }
 
 String JSON::toString( const var& data, const bool allOnOneLine )
 {
-    MemoryOutputStream mo( 1024 );
-    JSONFormatter::write( mo, data, 0, allOnOneLine );
-    return mo.toUTF8();
+    StringBuilder builder( 1024 );
+    JSONFormatter::write( builder, data, 0, allOnOneLine );
+    return builder.toString();
 }
 
 void JSON::writeToStream( OutputStream& output, const var& data, const bool allOnOneLine )
@@ -88,9 +314,9 @@ void JSON::writeToStream( OutputStream& output, const var& data, const bool allO
 
 String JSON::escapeString( StringRef s )
 {
-    MemoryOutputStream mo;
-    JSONFormatter::writeString( mo, s.text );
-    return mo.toString();
+    StringBuilder builder;
+    JSONFormatter::writeString( builder, s.text );
+    return builder.toString();
 }
 
 Result JSON::parseQuotedString( String::CharPointerType& t, var& result )
@@ -119,7 +345,7 @@ Result JSONParser::parseObjectOrArray( String::CharPointerType t, var& result )
 
 Result JSONParser::parseString( const treecore_wchar quoteChar, String::CharPointerType& t, var& result )
 {
-    MemoryOutputStream buffer( 256 );
+    StringBuilder buffer;
 
     for (;; )
     {
@@ -170,7 +396,7 @@ Result JSONParser::parseString( const treecore_wchar quoteChar, String::CharPoin
         buffer.appendUTF8Char( c );
     }
 
-    result = buffer.toUTF8();
+    result = buffer.toString();
     return Result::ok();
 }
 
@@ -255,13 +481,15 @@ Result JSONParser::parseNumber( String::CharPointerType& t, var& result, const b
         const treecore_wchar c = t.getAndAdvance();
         const int digit = ( (int) c ) - '0';
 
-        if ( isPositiveAndBelow( digit, 10 ) )
+        if ( isPositiveAndBelow( digit, 10 )
+             && intValue <= (std::numeric_limits<int64>::max() - digit) / 10 )
         {
             intValue = intValue * 10 + digit;
             continue;
         }
 
-        if (c == 'e' || c == 'E' || c == '.')
+        // a fraction, an exponent, or an integer too large for int64
+        if ( c == 'e' || c == 'E' || c == '.' || isPositiveAndBelow( digit, 10 ) )
         {
             t = oldT;
             const double asDouble = CharacterFunctions::readDoubleValue( t );
@@ -417,6 +645,10 @@ void JSONFormatter::write( OutputStream& out, const var& v,
     {
         out << (static_cast<bool>(v) ? "true" : "false");
     }
+    else if ( v.isDouble() )
+    {
+        out << static_cast<double>(v);
+    }
     else if ( v.isArray() )
     {
         writeArray( out, *v.getArray(), indentLevel, allOnOneLine );
@@ -439,13 +671,32 @@ void JSONFormatter::write( OutputStream& out, const var& v,
 
 void JSONFormatter::writeEscapedChar( OutputStream& out, const unsigned short value )
 {
-    out << "\\u" << String::toHexString( (int) value ).paddedLeft( '0', 4 );
+    static const char hexDigits[] = "0123456789abcdef";
+
+    const char escaped[] = { '\\', 'u',
+                             hexDigits[(value >> 12) & 15], hexDigits[(value >> 8) & 15],
+                             hexDigits[(value >> 4) & 15],  hexDigits[value & 15] };
+
+    out.write( escaped, sizeof(escaped) );
 }
 
 void JSONFormatter::writeString( OutputStream& out, String::CharPointerType t )
 {
     for (;; )
     {
+        // characters which need no escaping are written a whole run at a time
+        const char* const runStart = t.getAddress();
+        const char* runEnd = runStart;
+
+        while (*runEnd >= 32 && *runEnd < 127 && *runEnd != '\"' && *runEnd != '\\')
+            ++runEnd;
+
+        if (runEnd != runStart)
+        {
+            out.write( runStart, size_t( runEnd - runStart ) );
+            t = String::CharPointerType( runEnd );
+        }
+
         const treecore_wchar c( t.getAndAdvance() );
 
         switch (c)
@@ -26,15 +26,240 @@
    ==============================================================================
  */
 
+#include "treecore/AtomicFunc.h"
+#include "treecore/ByteOrder.h"
 #include "treecore/File.h"
+#include "treecore/HeapBlock.h"
 #include "treecore/LocalisedStrings.h"
 #include "treecore/Memory.h"
+#include "treecore/MemoryBlock.h"
+#include "treecore/MemoryMappedFile.h"
+#include "treecore/OutputStream.h"
 #include "treecore/StringRef.h"
 #include "treecore/SpinLock.h"
 #include "treecore/ScopedPointer.h"
 
+#include <algorithm>
+
 namespace treecore {
 
+//==============================================================================
+// A frozen table is one block of data, which is also the binary form:
+//
+//   header   8 words: magic, version, number of entries, number of buckets,
+//            offset and size of the language name, and of the country codes
+//   seeds    one word for each bucket
+//   entries  5 words for each entry: hash, key offset, key size, value offset,
+//            value size
+//   text     the UTF-8 bytes of the keys, values, language and countries
+//
+// Words are 32-bit little-endian, offsets are from the start of the data.
+// The hash of a key picks its bucket, and the seed of the bucket together
+// with the hash picks the entry, which is different for every key.
+namespace
+{
+enum
+{
+    frozenMagic       = 0x534c4354, // "TCLS"
+    frozenVersion     = 1,
+    frozenHeaderWords = 8,
+    frozenEntryWords  = 5,
+    frozenMaxSeed     = 1 << 24
+};
+
+// The data can be anywhere, and keys have any alignment, so words are
+// copied out instead of read through a pointer.
+inline uint32 readFrozenWord( const char* p ) noexcept
+{
+    uint32 value;
+    memcpy( &value, p, sizeof(value) );
+    return ByteOrder::swapIfBigEndian( value );
+}
+
+inline void writeFrozenWord( char* p, uint32 value ) noexcept
+{
+    value = ByteOrder::swapIfBigEndian( value );
+    memcpy( p, &value, sizeof(value) );
+}
+
+uint64 frozenHash( const char* p, size_t numBytes ) noexcept
+{
+    uint64 h = 0x9e3779b97f4a7c15ULL ^ (uint64( numBytes ) * 0xff51afd7ed558ccdULL);
+
+    for (; numBytes >= 8; p += 8, numBytes -= 8)
+    {
+        uint64 word;
+        memcpy( &word, p, sizeof(word) );
+        h  = (h ^ ByteOrder::swapIfBigEndian( word )) * 0xc4ceb9fe1a85ec53ULL;
+        h ^= h >> 29;
+    }
+
+    uint64 tail = 0;
+    for (size_t i = 0; i < numBytes; ++i)
+        tail |= uint64( uint8( p[i] ) ) << (8 * i);
+
+    h  = (h ^ tail) * 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 32;
+    h *= 0xff51afd7ed558ccdULL;
+    return h ^ (h >> 29);
+}
+
+// maps 32 random bits onto 0 ... range - 1
+inline uint32 frozenReduce( uint32 bits, uint32 range ) noexcept
+{
+    return uint32( (uint64( bits ) * range) >> 32 );
+}
+
+inline uint32 frozenBucket( uint64 hash, uint32 numBuckets ) noexcept
+{
+    return frozenReduce( uint32( hash >> 32 ), numBuckets );
+}
+
+inline uint32 frozenSlot( uint64 hash, uint32 seed, uint32 numEntries ) noexcept
+{
+    uint64 x = (hash ^ (uint64( seed ) * 0x9e3779b97f4a7c15ULL)) * 0xd6e8feb86659fd93ULL;
+    x ^= x >> 32;
+    return frozenReduce( uint32( x ), numEntries );
+}
+
+// String::getNumBytesAsUTF8() decodes every character, which is slower
+// than the whole lookup
+inline size_t frozenNumBytes( const String& s ) noexcept
+{
+    return strlen( s.toRawUTF8() );
+}
+
+inline String frozenString( const char* p, uint32 numBytes )
+{
+    return String( CharPointer_UTF8( p ), CharPointer_UTF8( p + numBytes ) );
+}
+}
+
+class LocalisedStrings::FrozenTable  : public RefCountObject
+{
+public:
+    ~FrozenTable()
+    {
+        for (uint32 i = 0; i < numEntries && values != nullptr; ++i)
+            delete values[i];
+    }
+
+    /** Checks the header, and that the seeds and entries fit in the data.
+        Keys and values are only checked when they're read.
+     */
+    bool open( const void* tableData, size_t tableSize )
+    {
+        data = static_cast<const char*>( tableData );
+        size = tableSize;
+
+        if (data == nullptr || size < frozenHeaderWords * 4
+            || readFrozenWord( data ) != frozenMagic
+            || readFrozenWord( data + 4 ) != frozenVersion)
+            return false;
+
+        numEntries = readFrozenWord( data + 8 );
+        numBuckets = readFrozenWord( data + 12 );
+
+        if (numBuckets == 0
+            || (uint64( numBuckets ) + uint64( numEntries ) * frozenEntryWords + frozenHeaderWords) * 4 > size)
+            return false;
+
+        entries = data + (frozenHeaderWords + numBuckets) * 4;
+        values.calloc( numEntries );
+
+        return isValidText( readFrozenWord( data + 16 ), readFrozenWord( data + 20 ) )
+               && isValidText( readFrozenWord( data + 24 ), readFrozenWord( data + 28 ) );
+    }
+
+    /** Returns the entry of a key, or -1. */
+    int find( const char* key, size_t keyBytes ) const noexcept
+    {
+        if (numEntries == 0)
+            return -1;
+
+        const uint64 hash = frozenHash( key, keyBytes );
+        const uint32 seed = readFrozenWord( data + (frozenHeaderWords + frozenBucket( hash, numBuckets )) * 4 );
+        const uint32 slot = frozenSlot( hash, seed, numEntries );
+        const char* const entry = entries + slot * frozenEntryWords * 4;
+        const uint32 keyOffset  = readFrozenWord( entry + 4 );
+
+        if (readFrozenWord( entry ) == uint32( hash )
+            && readFrozenWord( entry + 8 ) == keyBytes
+            && uint64( keyOffset ) + keyBytes <= size
+            && memcmp( data + keyOffset, key, keyBytes ) == 0)
+            return (int) slot;
+
+        return -1;
+    }
+
+    /** Reads the key of an entry, or returns false if it isn't valid text. */
+    bool getKey( int slot, String& result ) const   { return getEntryText( slot, 4, result ); }
+
+    /** Reads the value of an entry, or returns false if it isn't valid text. */
+    bool getValue( int slot, String& result ) const { return getEntryText( slot, 12, result ); }
+
+    /** Returns the value of an entry as a String that later lookups share, or nullptr
+        if it isn't valid text.
+
+        The value is only checked and copied out of the table the first time it's asked
+        for. Threads that race to do this keep whichever String was stored first.
+     */
+    const String* getSharedValue( int slot ) const
+    {
+        if (const String* const value = atomic_load( &values[slot] ))
+            return value;
+
+        ScopedPointer<String> newValue( new String() );
+
+        if (! getValue( slot, *newValue ))
+            return nullptr;
+
+        if (atomic_compare_set<String*>( &values[slot], nullptr, newValue.get() ))
+            return newValue.release();
+
+        return atomic_load( &values[slot] );
+    }
+
+    String getHeaderText( int index ) const
+    {
+        return frozenString( data + readFrozenWord( data + 16 + index * 8 ), readFrozenWord( data + 20 + index * 8 ) );
+    }
+
+    MemoryBlock ownData;
+    ScopedPointer<MemoryMappedFile> file;
+    const char* data = nullptr;
+    const char* entries = nullptr;
+    size_t size = 0;
+    uint32 numEntries = 0, numBuckets = 0;
+
+private:
+    HeapBlock<String*> values;   // filled in by getSharedValue()
+
+    bool isValidText( uint32 offset, uint32 numBytes ) const noexcept
+    {
+        return uint64( offset ) + numBytes <= size
+               && (numBytes == 0 || CharPointer_UTF8::isValidString( data + offset, (int) numBytes ));
+    }
+
+    bool getEntryText( int slot, int field, String& result ) const
+    {
+        const char* const entry = entries + slot * frozenEntryWords * 4;
+        const uint32 offset   = readFrozenWord( entry + field );
+        const uint32 numBytes = readFrozenWord( entry + field + 4 );
+
+        if (! isValidText( offset, numBytes ))
+            return false;
+
+        result = frozenString( data + offset, numBytes );
+        return true;
+    }
+};
+
+//==============================================================================
+LocalisedStrings::LocalisedStrings()
+{
+}
+
 LocalisedStrings::LocalisedStrings ( const String& fileContents, bool ignoreCase )
 {
     loadFromText( fileContents, ignoreCase );
@@ -48,15 +273,28 @@ LocalisedStrings::LocalisedStrings ( const File& fileToLoad, bool ignoreCase )
 LocalisedStrings::LocalisedStrings ( const LocalisedStrings& other )
     : languageName( other.languageName )
     , countryCodes( other.countryCodes )
-    , translations( other.translations )
+    , frozen( other.frozen )
     , fallback( createCopyIfNotNull( other.fallback ) )
-{}
+{
+    // the mappings of a frozen table are only filled in when asked for
+    if (frozen == nullptr)
+        translations = other.translations;
+    else
+        mappingsLoaded = false;
+}
 
 LocalisedStrings& LocalisedStrings::operator = ( const LocalisedStrings& other )
 {
     languageName = other.languageName;
     countryCodes = other.countryCodes;
-    translations = other.translations;
+    frozen = other.frozen;
+
+    if (frozen == nullptr)
+        translations = other.translations;
+    else
+        translations.clear();
+
+    mappingsLoaded = frozen == nullptr;
     fallback = createCopyIfNotNull( other.fallback );
     return *this;
 }
@@ -68,19 +306,25 @@ LocalisedStrings::~LocalisedStrings()
 
 String LocalisedStrings::translate( const String& text, const String& resultIfNotFound ) const
 {
-    MapType::ConstIterator it( translations );
-    if ( translations.select( text, it ) )
-    {
-        return it.value();
-    }
-    else if (fallback != nullptr)
+    if (frozen != nullptr)
     {
-        return fallback->translate( text );
+        const int slot = frozen->find( text.toRawUTF8(), frozenNumBytes( text ) );
+
+        if (slot >= 0)
+            if (const String* const value = frozen->getSharedValue( slot ))
+                return *value;
     }
     else
     {
-        return resultIfNotFound;
+        MapType::ConstIterator it( translations );
+        if ( translations.select( text, it ) )
+            return it.value();
     }
+
+    if (fallback != nullptr)
+        return fallback->translate( text );
+
+    return resultIfNotFound;
 }
 
 namespace
@@ -178,11 +422,16 @@ void LocalisedStrings::addStrings( const LocalisedStrings& other )
     treecore_assert( languageName == other.languageName );
     treecore_assert( countryCodes == other.countryCodes );
 
-    MapType::ConstIterator i_other( other.translations );
+    getMappings();
+
+    MapType::ConstIterator i_other( other.getMappings() );
     while ( i_other.next() )
     {
         translations[i_other.key()] = i_other.value();
     }
+
+    if (frozen != nullptr)
+        freeze();
 }
 
 void LocalisedStrings::setFallback( LocalisedStrings* f )
@@ -190,6 +439,208 @@ void LocalisedStrings::setFallback( LocalisedStrings* f )
     fallback = f;
 }
 
+const HashMap<String, String>& LocalisedStrings::getMappings() const
+{
+    const SpinLock::ScopedLockType sl( mappingsLock );
+
+    if (! mappingsLoaded)
+    {
+        for (int i = 0; i < (int) frozen->numEntries; ++i)
+        {
+            String key, value;
+
+            if (frozen->getKey( i, key ) && frozen->getValue( i, value ))
+                translations.set( key, value );
+        }
+
+        mappingsLoaded = true;
+    }
+
+    return translations;
+}
+
+//==============================================================================
+void LocalisedStrings::freeze()
+{
+    ScopedPointer<FrozenTable> table( new FrozenTable() );
+
+    if (buildFrozenTable( table->ownData )
+        && table->open( table->ownData.getData(), table->ownData.getSize() ))
+    {
+        frozen = table.release();
+
+        // getMappings() fills the map in again if it's needed
+        MapType unused;
+        translations.swapWith( unused );
+        mappingsLoaded = false;
+    }
+}
+
+bool LocalisedStrings::buildFrozenTable( MemoryBlock& result ) const
+{
+    struct Entry
+    {
+        String key, value;
+        uint64 hash;
+        uint32 bucket, slot;
+    };
+
+    const MapType& mappings = getMappings();
+    Array<Entry> entries;
+
+    for (MapType::ConstIterator it( mappings ); it.next();)
+    {
+        const String& key = it.key();
+        entries.add( { key, it.value(), frozenHash( key.toRawUTF8(), frozenNumBytes( key ) ), 0, 0 } );
+    }
+
+    const uint32 numEntries = (uint32) entries.size();
+    const uint32 numBuckets = numEntries / 2 + 1;
+
+    // place the largest buckets first, while there's still a choice of slots
+    Array<int> bucketSizes;
+    bucketSizes.insertMultiple( 0, 0, (int) numBuckets );
+
+    for (Entry& e : entries)
+    {
+        e.bucket = frozenBucket( e.hash, numBuckets );
+        ++bucketSizes[(int) e.bucket];
+    }
+
+    std::sort( entries.begin(), entries.end(), [&]( const Entry& a, const Entry& b ) {
+        return bucketSizes[(int) a.bucket] != bucketSizes[(int) b.bucket] ? bucketSizes[(int) a.bucket] > bucketSizes[(int) b.bucket]
+                                                                          : a.bucket < b.bucket;
+    } );
+
+    Array<uint32> seeds;
+    seeds.insertMultiple( 0, 0, (int) numBuckets );
+    Array<uint8> taken;
+    taken.insertMultiple( 0, 0, (int) numEntries );
+
+    for (int first = 0; first < entries.size();)
+    {
+        int end = first + 1;
+        while (end < entries.size() && entries[end].bucket == entries[first].bucket)
+            ++end;
+
+        uint32 seed = 0;
+
+        for (;; ++seed)
+        {
+            if (seed == frozenMaxSeed)
+                return false;
+
+            int placed = first;
+
+            for (; placed < end; ++placed)
+            {
+                Entry& e = entries[placed];
+                e.slot = frozenSlot( e.hash, seed, numEntries );
+
+                if (taken[(int) e.slot])
+                    break;
+
+                taken[(int) e.slot] = 1;
+            }
+
+            if (placed == end)
+                break;
+
+            for (int i = first; i < placed; ++i)
+                taken[(int) entries[i].slot] = 0;
+        }
+
+        seeds[(int) entries[first].bucket] = seed;
+        first = end;
+    }
+
+    // lay out the block
+    const String countries( countryCodes.joinIntoString( " " ) );
+    const size_t tableBytes = (frozenHeaderWords + numBuckets + numEntries * frozenEntryWords) * 4;
+    size_t textBytes = frozenNumBytes( languageName ) + frozenNumBytes( countries );
+
+    for (const Entry& e : entries)
+        textBytes += frozenNumBytes( e.key ) + frozenNumBytes( e.value );
+
+    if (tableBytes + textBytes > 0xffffffffu)
+        return false;
+
+    result.setSize( tableBytes + textBytes, true );
+    char* const block = static_cast<char*>( result.getData() );
+    uint32 textOffset = (uint32) tableBytes;
+
+    auto writeText = [&]( const String& s, char* offsetAndSize ) {
+        const uint32 numBytes = (uint32) frozenNumBytes( s );
+        memcpy( block + textOffset, s.toRawUTF8(), numBytes );
+        writeFrozenWord( offsetAndSize, textOffset );
+        writeFrozenWord( offsetAndSize + 4, numBytes );
+        textOffset += numBytes;
+    };
+
+    writeFrozenWord( block, frozenMagic );
+    writeFrozenWord( block + 4, frozenVersion );
+    writeFrozenWord( block + 8, numEntries );
+    writeFrozenWord( block + 12, numBuckets );
+    writeText( languageName, block + 16 );
+    writeText( countries, block + 24 );
+
+    for (uint32 i = 0; i < numBuckets; ++i)
+        writeFrozenWord( block + (frozenHeaderWords + i) * 4, seeds[(int) i] );
+
+    char* const entryBlock = block + (frozenHeaderWords + numBuckets) * 4;
+
+    for (const Entry& e : entries)
+    {
+        char* const entry = entryBlock + e.slot * frozenEntryWords * 4;
+        writeFrozenWord( entry, uint32( e.hash ) );
+        writeText( e.key, entry + 4 );
+        writeText( e.value, entry + 12 );
+    }
+
+    return true;
+}
+
+bool LocalisedStrings::writeBinaryToStream( OutputStream& output ) const
+{
+    if (frozen != nullptr)
+        return output.write( frozen->data, frozen->size );
+
+    MemoryBlock table;
+    return buildFrozenTable( table ) && output.write( table.getData(), table.getSize() );
+}
+
+LocalisedStrings* LocalisedStrings::loadBinaryFile( const File& binaryFile )
+{
+    ScopedPointer<FrozenTable> table( new FrozenTable() );
+    table->file = new MemoryMappedFile( binaryFile, MemoryMappedFile::readOnly );
+
+    if (! table->open( table->file->getData(), table->file->getSize() ))
+        return nullptr;
+
+    return fromFrozenTable( table.release() );
+}
+
+LocalisedStrings* LocalisedStrings::fromBinaryData( const void* data, size_t numBytes )
+{
+    ScopedPointer<FrozenTable> table( new FrozenTable() );
+
+    if (! table->open( data, numBytes ))
+        return nullptr;
+
+    return fromFrozenTable( table.release() );
+}
+
+LocalisedStrings* LocalisedStrings::fromFrozenTable( FrozenTable* table )
+{
+    LocalisedStrings* const result = new LocalisedStrings();
+    result->frozen = table;
+    result->mappingsLoaded = false;
+    result->languageName = table->getHeaderText( 0 );
+    result->countryCodes.addTokens( table->getHeaderText( 1 ), " ", "" );
+    result->countryCodes.removeEmptyStrings();
+    return result;
+}
+
 //==============================================================================
 void LocalisedStrings::setCurrentMappings( LocalisedStrings* newTranslations )
 {
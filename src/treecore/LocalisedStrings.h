@@ -30,12 +30,16 @@
 #define TREECORE_LOCALISEDSTRINGS_H
 
 #include "treecore/HashMap.h"
+#include "treecore/RefCountHolder.h"
+#include "treecore/SpinLock.h"
 #include "treecore/String.h"
 #include "treecore/StringArray.h"
 
 namespace treecore {
 
 class File;
+class MemoryBlock;
+class OutputStream;
 template<typename T> struct ContainerDeletePolicy;
 
 //==============================================================================
@@ -80,6 +84,12 @@ template<typename T> struct ContainerDeletePolicy;
     intercept and translate any internal Juce text strings that might be shown. (You can easily
     get a list of all the messages by searching for the TRANS() macro in the Juce source
     code).
+
+    For large sets of translations which are looked up often, call freeze() once they're
+    loaded. The strings are then kept in a table with a minimal perfect hash, which finds
+    a string with one hash of it and one comparison. A frozen table can be written with
+    writeBinaryToStream() and loaded again with loadBinaryFile(), which maps the file into
+    memory rather than parsing it.
  */
 class TREECORE_SHARED_API LocalisedStrings
 {
@@ -174,8 +184,64 @@ public:
      */
     const StringArray& getCountryCodes() const { return countryCodes; }
 
-    /** Provides access to the actual list of mappings. */
-    const HashMap<String, String>& getMappings() const { return translations; }
+    /** Provides access to the actual list of mappings.
+
+        Frozen objects don't keep this map, so it's filled in from the table when this
+        is first called.
+     */
+    const HashMap<String, String>& getMappings() const;
+
+    //==============================================================================
+    /** Moves the mappings into a table with a minimal perfect hash, which translate()
+        then uses.
+
+        The strings are only kept in the table afterwards, which takes less memory than
+        the map. Building the table takes about as long as loading the mappings, so this
+        pays off when many strings are translated. Adding strings with addStrings()
+        builds the table again.
+
+        Each value is checked and copied into a String the first time translate() returns
+        it, and is kept so that later calls return that String without copying it again.
+        So the values that are actually used take memory a second time, and the first
+        lookup of each is slower, but nothing is read or allocated for the ones that
+        aren't.
+     */
+    void freeze();
+
+    /** Returns true if the mappings are looked up in a frozen table.
+        @see freeze
+     */
+    bool isFrozen() const noexcept { return frozen != nullptr; }
+
+    /** Writes the mappings, the language name and the country codes as a frozen table,
+        which can be loaded with loadBinaryFile() or fromBinaryData().
+
+        The format depends on neither the platform nor the byte order.
+
+        @returns false if the table couldn't be built or written
+     */
+    bool writeBinaryToStream( OutputStream& output ) const;
+
+    /** Loads a set of translations written by writeBinaryToStream(), by mapping the file
+        into memory.
+
+        The result is frozen. Only the header is checked when loading; each string is
+        read from the file and checked the first time it's looked up (see freeze()),
+        and an entry which isn't valid UTF-8 is treated as missing.
+
+        @returns a new object, or nullptr if the file doesn't start with a valid header
+     */
+    static LocalisedStrings* loadBinaryFile( const File& binaryFile );
+
+    /** Creates a set of translations from data written by writeBinaryToStream(), without
+        copying it. The data must stay valid while the object is used, as data built into
+        the executable does.
+
+        The strings are read and checked when they're looked up, as with loadBinaryFile().
+
+        @returns a new object, or nullptr if the data doesn't start with a valid header
+     */
+    static LocalisedStrings* fromBinaryData( const void* data, size_t numBytes );
 
     //==============================================================================
     /** Adds and merges another set of translations into this set.
@@ -196,13 +262,21 @@ public:
 
 private:
     //==============================================================================
+    class FrozenTable;
+
     String languageName;
     StringArray countryCodes;
-    MapType translations;
+    mutable MapType translations;       // filled in lazily while frozen
+    mutable bool mappingsLoaded = true;
+    mutable SpinLock mappingsLock;
+    RefCountHolder<FrozenTable> frozen;
     LocalisedStrings* fallback = nullptr;
     friend struct ContainerDeletePolicy<LocalisedStrings>;
 
+    LocalisedStrings();
     void loadFromText( const String&, bool ignoreCase );
+    bool buildFrozenTable( MemoryBlock& result ) const;
+    static LocalisedStrings* fromFrozenTable( FrozenTable* table );
 
     TREECORE_LEAK_DETECTOR( LocalisedStrings )
 };
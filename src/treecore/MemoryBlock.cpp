@@ -28,6 +28,9 @@
 
 #include "treecore/MemoryBlock.h"
 #include "treecore/StringRef.h"
+#include "treecore/UTF8Functions.h"
+
+#include <cstring>
 
 namespace treecore {
 
@@ -326,6 +329,20 @@ void MemoryBlock::setBitRange (const size_t bitRangeStart, size_t numBits, int b
 //==============================================================================
 void MemoryBlock::loadFromHexString (StringRef hex)
 {
+    const size_t numChars = std::strlen (hex.text.getAddress());
+
+    // plain digits are decoded in bulk, anything else character by character
+    if (numChars % 2 == 0)
+    {
+        ensureSize (numChars >> 1);
+
+        if (hex_decode (hex.text.getAddress(), numChars, data))
+        {
+            setSize (numChars >> 1);
+            return;
+        }
+    }
+
     ensureSize ((size_t) hex.length() >> 1);
     char* dest = data;
     String::CharPointerType t (hex.text);
@@ -369,14 +386,32 @@ String MemoryBlock::toBase64Encoding() const
     const int initialLen = destString.length();
     destString.preallocateBytes (sizeof (String::CharPointerType::CharType) * (size_t) initialLen + 2 + numChars);
 
-    String::CharPointerType d (destString.getCharPointer());
-    d += initialLen;
-    d.write ('.');
+    char* d = destString.getCharPointer().getAddress() + initialLen;
+    *d++ = '.';
+
+    // bits are taken from the lowest of each byte first, so that every three
+    // bytes are a little-endian 24-bit number of four characters
+    const uint8* const src = (const uint8*) data.getData();
+    size_t i = 0;
+
+    for (; i + 3 <= size; i += 3)
+    {
+        const uint32 bits = (uint32) src[i] | ((uint32) src[i + 1] << 8) | ((uint32) src[i + 2] << 16);
+        *d++ = base64EncodingTable [bits & 63];
+        *d++ = base64EncodingTable [(bits >> 6) & 63];
+        *d++ = base64EncodingTable [(bits >> 12) & 63];
+        *d++ = base64EncodingTable [bits >> 18];
+    }
+
+    if (i < size)
+    {
+        const uint32 bits = (uint32) src[i] | (i + 1 < size ? (uint32) src[i + 1] << 8 : 0);
 
-    for (size_t i = 0; i < numChars; ++i)
-        d.write ((treecore_wchar) (uint8) base64EncodingTable [getBitRange (i * 6, 6)]);
+        for (size_t shift = 0; shift < (size - i) * 8; shift += 6)
+            *d++ = base64EncodingTable [(bits >> shift) & 63];
+    }
 
-    d.writeNull();
+    *d = 0;
     return destString;
 }
 
@@ -398,6 +433,46 @@ bool MemoryBlock::fromBase64Encoding (StringRef s)
 
     setSize ((size_t) numBytesNeeded, true);
 
+    const char* const src = (dot + 1).getAddress();
+    const size_t numChars = std::strlen (src);
+
+    // With ASCII text, the bits of characters are collected into whole bytes.
+    // Other text is decoded character by character, as some malformed UTF-8
+    // sequences decode to characters of the table.
+    if (utf8_ascii_prefix_length (src, numChars) == numChars)
+    {
+        uint32 bits = 0;
+        size_t numBits = 0;
+        size_t byte = 0;
+
+        for (size_t i = 0; i < numChars && byte < size; ++i)
+        {
+            const int c = (int) src[i] - 43;
+
+            if (isPositiveAndBelow (c, numElementsInArray (base64DecodingTable)))
+            {
+                bits |= (uint32) base64DecodingTable [c] << numBits;
+                numBits += 6;
+
+                if (numBits >= 8)
+                {
+                    data[byte++] = (char) bits;
+                    bits >>= 8;
+                    numBits -= 8;
+                }
+            }
+        }
+
+        // a last partial byte keeps its other bits, as setBitRange() does
+        if (numBits > 0 && byte < size)
+        {
+            const uint32 mask = (1u << numBits) - 1;
+            data[byte] = (char) (((uint32) (uint8) data[byte] & ~mask) | bits);
+        }
+
+        return true;
+    }
+
     String::CharPointerType srcChars (dot + 1);
     int pos = 0;
 
@@ -417,4 +492,49 @@ bool MemoryBlock::fromBase64Encoding (StringRef s)
     }
 }
 
+//==============================================================================
+String MemoryBlock::toBase64String (Base64Alphabet alphabet, bool pad) const
+{
+    if (size == 0)
+        return String();
+
+    const size_t numChars = base64_encoded_length (size, pad);
+
+    String result;
+    result.preallocateBytes (numChars + 1);
+
+    char* const dest = result.getCharPointer().getAddress();
+    base64_encode (data, size, dest, alphabet, pad);
+    dest[numChars] = 0;
+    return result;
+}
+
+bool MemoryBlock::loadFromBase64String (StringRef base64Text, Base64Alphabet alphabet)
+{
+    const char* const text = base64Text.text.getAddress();
+    const size_t numChars = std::strlen (text);
+
+    MemoryBlock decoded (base64_decoded_length (text, numChars));
+
+    if (! base64_decode (text, numChars, decoded.data, alphabet))
+        return false;
+
+    swapWith (decoded);
+    return true;
+}
+
+String MemoryBlock::toHexString (bool upperCase) const
+{
+    if (size == 0)
+        return String();
+
+    String result;
+    result.preallocateBytes (size * 2 + 1);
+
+    char* const dest = result.getCharPointer().getAddress();
+    hex_encode (data, size, dest, upperCase);
+    dest[size * 2] = 0;
+    return result;
+}
+
 }
@@ -29,6 +29,7 @@
 #ifndef TREECORE_MEMORYBLOCK_H
 #define TREECORE_MEMORYBLOCK_H
 
+#include "treecore/BinaryEncoding.h"
 #include "treecore/HeapBlock.h"
 #include "treecore/LeakedObjectDetector.h"
 #include "treecore/MathsFunctions.h"
@@ -246,6 +247,29 @@ public:
     */
     bool fromBase64Encoding  (StringRef encodedString);
 
+    //==============================================================================
+    /** Returns the contents of the block as base64 of RFC 4648.
+
+        Unlike toBase64Encoding(), the result can be read by any base64 decoder,
+        e.g. on the other end of a JSON document.
+
+        @see loadFromBase64String, base64_encode
+    */
+    String toBase64String (Base64Alphabet alphabet = BASE64_STANDARD, bool pad = true) const;
+
+    /** Replaces the contents of the block with the data of base64 text of RFC 4648.
+
+        @returns false if the text isn't valid base64, in which case the block is left unchanged
+        @see toBase64String, base64_decode
+    */
+    bool loadFromBase64String (StringRef base64Text, Base64Alphabet alphabet = BASE64_STANDARD);
+
+    /** Returns the contents of the block as two hexadecimal digits for each byte, with no spaces.
+
+        @see loadFromHexString, hex_encode
+    */
+    String toHexString (bool upperCase = false) const;
+
 
 private:
     //==============================================================================
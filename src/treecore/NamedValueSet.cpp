@@ -106,23 +106,18 @@ var NamedValueSet::getWithDefault (const Identifier& name, const var& defaultRet
 
 var* NamedValueSet::getVarPointer (const Identifier& name) const noexcept
 {
-    MapType::ConstIterator i(values);
-    if (values.select(name, i))
-    {
-        return const_cast<var*>(&i.value());
-    }
-    return nullptr;
+    return const_cast<var*> (values.find (name));
 }
 
 bool NamedValueSet::set (Identifier name, var&& newValue)
 {
     MapType::Iterator i(values);
-    if (!values.insertOrSelect(name, newValue, i))
+    if (!values.insertOrSelect(name, std::move (newValue), i))
     {
         if (i.value().equalsWithSameType(newValue))
             return false;
 
-        i.value() = newValue;
+        i.value() = std::move (newValue);
     }
 
     return true;
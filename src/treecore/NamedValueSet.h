@@ -29,12 +29,11 @@
 #ifndef TREECORE_NAMEDVALUESET_H
 #define TREECORE_NAMEDVALUESET_H
 
-#include "treecore/HashMap.h"
+#include "treecore/IdentifierMap.h"
 #include "treecore/Variant.h"
 
 namespace treecore {
 
-class Identifier;
 class XmlElement;
 class var;
 
@@ -47,7 +46,7 @@ class var;
 class TREECORE_SHARED_API  NamedValueSet
 {
 public:
-    typedef HashMap<Identifier, var> MapType;
+    typedef IdentifierMap<var> MapType;
 
     /** Creates an empty set. */
     NamedValueSet() noexcept;
@@ -125,7 +124,7 @@ public:
 
     /**
      * @brief get value storage
-     * @return a hash map stores all values
+     * @return a map that stores all values
      */
     MapType& getValues() noexcept
     {
@@ -0,0 +1,339 @@
+#include "treecore/NaturalOrder.h"
+#include "treecore/CharPointer_UTF8.h"
+#include "treecore/HeapBlock.h"
+#include "treecore/MathsFunctions.h"
+#include "treecore/SimdFunc.h"
+#include "treecore/StringTable.h"
+
+#include "treecore/internal/StringSort.h"
+
+#include <cstring>
+
+#if TREECORE_COMPILER_MSVC
+#    include <intrin.h>
+#endif
+
+namespace treecore
+{
+
+namespace
+{
+
+typedef SIMDType<16> VecType;
+
+//
+// The classification is that of the "C" locale, written out, so that it
+// doesn't change with the locale of the process.
+//
+inline bool natural_is_space( treecore_wchar c ) noexcept { return c == ' ' || (c >= '\t' && c <= '\r'); }
+
+inline bool natural_is_digit( treecore_wchar c ) noexcept { return c >= '0' && c <= '9'; }
+
+inline bool natural_is_letter( treecore_wchar c ) noexcept { return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z'); }
+
+inline treecore_wchar natural_to_upper( treecore_wchar c ) noexcept { return (c >= 'a' && c <= 'z') ? c - ('a' - 'A') : c; }
+
+// n must not be zero
+inline int natural_lowest_bit( uint64 n ) noexcept
+{
+#if TREECORE_COMPILER_MSVC
+    unsigned long index;
+    _BitScanForward64( &index, n );
+    return int(index);
+#else
+    return __builtin_ctzll( n );
+#endif
+}
+
+// Number of equal bytes at the start of a and b, not counting the zero
+// terminator. The vector loads may read past the terminator, but never into
+// another page, which is where memory could be unmapped.
+size_t natural_common_prefix( const char* a, const char* b ) noexcept
+{
+    VecType zero;
+    simd_broadcast<int32>( zero, 0 );
+
+    size_t i = 0;
+
+    for (;;)
+    {
+        const size_t pageA = size_t( reinterpret_cast<uintptr_t>( a + i ) & 4095 );
+        const size_t pageB = size_t( reinterpret_cast<uintptr_t>( b + i ) & 4095 );
+
+        if (pageA <= 4096 - 16 && pageB <= 4096 - 16)
+        {
+            VecType va, vb, equal, ended;
+            simd_set_all<int32>( va, (const int32*) (a + i) );
+            simd_set_all<int32>( vb, (const int32*) (b + i) );
+            simd_cmp<int8>( equal, va, vb );
+            simd_cmp<int8>( ended, va, zero );
+
+            const uint64 stop = ( ~uint64( simd_movemask<int8>( equal ) ) & 0xffff ) | uint64( simd_movemask<int8>( ended ) );
+
+            if (stop != 0)
+                return i + size_t( natural_lowest_bit( stop ) );
+
+            i += 16;
+        }
+        else
+        {
+            if (a[i] != b[i] || a[i] == 0)
+                return i;
+
+            i++;
+        }
+    }
+}
+
+int natural_compare_digits_right( CharPointer_UTF8 s1, CharPointer_UTF8 s2 ) noexcept
+{
+    for (int bias = 0;;)
+    {
+        const treecore_wchar c1 = s1.getAndAdvance();
+        const bool isDigit1     = natural_is_digit( c1 );
+
+        const treecore_wchar c2 = s2.getAndAdvance();
+        const bool isDigit2     = natural_is_digit( c2 );
+
+        if ( !(isDigit1 || isDigit2) ) return bias;
+        if (!isDigit1)                return -1;
+        if (!isDigit2)                return 1;
+
+        if (c1 != c2 && bias == 0)
+            bias = c1 < c2 ? -1 : 1;
+    }
+}
+
+int natural_compare_digits_left( CharPointer_UTF8 s1, CharPointer_UTF8 s2 ) noexcept
+{
+    for (;;)
+    {
+        const treecore_wchar c1 = s1.getAndAdvance();
+        const bool isDigit1     = natural_is_digit( c1 );
+
+        const treecore_wchar c2 = s2.getAndAdvance();
+        const bool isDigit2     = natural_is_digit( c2 );
+
+        if ( !(isDigit1 || isDigit2) ) return 0;
+        if (!isDigit1)                return -1;
+        if (!isDigit2)                return 1;
+        if (c1 < c2)                   return -1;
+        if (c1 > c2)                   return 1;
+    }
+}
+
+int natural_compare_from( CharPointer_UTF8 s1, CharPointer_UTF8 s2, bool firstLoop ) noexcept
+{
+    for (;;)
+    {
+        const bool hasSpace1 = natural_is_space( *s1 );
+        const bool hasSpace2 = natural_is_space( *s2 );
+
+        if ( !firstLoop && (hasSpace1 != hasSpace2) )
+            return hasSpace2 ? 1 : -1;
+
+        firstLoop = false;
+
+        while ( natural_is_space( *s1 ) ) ++s1;
+        while ( natural_is_space( *s2 ) ) ++s2;
+
+        if ( natural_is_digit( *s1 ) && natural_is_digit( *s2 ) )
+        {
+            // numbers with leading zeros compare digit by digit, like decimal
+            // fractions, the others by their value
+            const int result = (*s1 == '0' || *s2 == '0') ? natural_compare_digits_left( s1, s2 )
+                                                          : natural_compare_digits_right( s1, s2 );
+
+            if (result != 0)
+                return result;
+        }
+
+        treecore_wchar c1 = natural_to_upper( s1.getAndAdvance() );
+        treecore_wchar c2 = natural_to_upper( s2.getAndAdvance() );
+
+        if (c1 == c2)
+        {
+            if (c1 == 0)
+                return 0;
+
+            continue;
+        }
+
+        const bool isAlphaNum1 = natural_is_letter( c1 ) || natural_is_digit( c1 );
+        const bool isAlphaNum2 = natural_is_letter( c2 ) || natural_is_digit( c2 );
+
+        if (isAlphaNum2 && !isAlphaNum1) return -1;
+        if (isAlphaNum1 && !isAlphaNum2) return 1;
+
+        return c1 < c2 ? -1 : 1;
+    }
+}
+
+//
+// A sort key is a sequence of these tokens, which compare in this order when
+// the strings differ at them. The order within each kind of token is that of
+// the bytes after the kind.
+//
+enum
+{
+    KEY_SPACE  = 1, ///< a run of whitespace
+    KEY_END    = 2, ///< the end of the text
+    KEY_OTHER  = 3, ///< the UTF-8 bytes of a character which is no letter or digit
+    KEY_NUMBER = 4, ///< a run of digits, see below
+    KEY_LETTER = 5, ///< an upper-case ASCII letter
+
+    // after KEY_NUMBER
+    NUMBER_WITH_LEADING_ZERO = 1, ///< the digits, ended by a zero byte
+    NUMBER_PLAIN = 2              ///< the number of digits, then the digits
+};
+
+} // anonymous namespace
+
+int compare_natural( const char* a, const char* b ) noexcept
+{
+    size_t start = natural_common_prefix( a, b );
+
+    if (a[start] == 0 && b[start] == 0)
+        return 0;
+
+    // go back to where comparing the common prefix has left both strings in
+    // the same state: at the start of a character, and not within a run of
+    // digits or whitespace, which are compared as a whole
+    while ( start > 0 && ( (uint8( a[start] ) & 0xc0) == 0x80 || (uint8( b[start] ) & 0xc0) == 0x80 ) )
+        start--;
+
+    while ( start > 0 && ( natural_is_digit( a[start - 1] ) || natural_is_space( a[start - 1] ) ) )
+        start--;
+
+    return natural_compare_from( CharPointer_UTF8( a + start ), CharPointer_UTF8( b + start ), start == 0 );
+}
+
+size_t make_natural_sort_key( StringSlice text, uint8* key ) noexcept
+{
+    const uint8* p         = reinterpret_cast<const uint8*>( text.getData() );
+    const uint8* const end = p + text.getNumBytes();
+    uint8* out = key;
+
+    while ( p < end && natural_is_space( *p ) )
+        p++;
+
+    while (p < end)
+    {
+        const uint8 c = *p;
+
+        if ( natural_is_space( c ) )
+        {
+            while ( p < end && natural_is_space( *p ) )
+                p++;
+
+            *out++ = KEY_SPACE;
+        }
+        else if ( natural_is_digit( c ) )
+        {
+            const uint8* const digits = p;
+
+            while ( p < end && natural_is_digit( *p ) )
+                p++;
+
+            const size_t numDigits = size_t( p - digits );
+            *out++ = KEY_NUMBER;
+
+            if (c == '0')
+            {
+                *out++ = NUMBER_WITH_LEADING_ZERO;
+                std::memcpy( out, digits, numDigits );
+                out   += numDigits;
+                *out++ = 0;
+            }
+            else
+            {
+                *out++ = NUMBER_PLAIN;
+
+                if (numDigits < 0xff)
+                {
+                    *out++ = uint8( numDigits );
+                }
+                else
+                {
+                    const uint32 n = uint32( numDigits );
+                    *out++ = 0xff;
+                    *out++ = uint8( n >> 24 );
+                    *out++ = uint8( n >> 16 );
+                    *out++ = uint8( n >> 8 );
+                    *out++ = uint8( n );
+                }
+
+                std::memcpy( out, digits, numDigits );
+                out += numDigits;
+            }
+        }
+        else if ( natural_is_letter( c ) )
+        {
+            *out++ = KEY_LETTER;
+            *out++ = uint8( natural_to_upper( c ) );
+            p++;
+        }
+        else
+        {
+            // UTF-8 bytes are in the order of code points
+            size_t numBytes = c < 0xc0 ? 1 : (c < 0xe0 ? 2 : (c < 0xf0 ? 3 : 4));
+            size_t i = 1;
+
+            while ( i < numBytes && p + i < end && (p[i] & 0xc0) == 0x80 )
+                i++;
+
+            numBytes = i;
+
+            *out++ = KEY_OTHER;
+            std::memcpy( out, p, numBytes );
+            out += numBytes;
+            p   += numBytes;
+        }
+    }
+
+    *out++ = KEY_END;
+    return size_t( out - key );
+}
+
+void sort_natural_order( const StringSlice* texts, int numTexts, int* order )
+{
+    // the keys of all texts are put into a table, and sorted byte by byte
+    StringTable keys;
+    keys.ensureStorageAllocated( numTexts );
+
+    HeapBlock<uint8> buffer;
+    size_t bufferSize = 0;
+
+    for (int i = 0; i < numTexts; i++)
+    {
+        const size_t maxBytes = natural_sort_key_max_bytes( texts[i].getNumBytes() );
+
+        if (maxBytes > bufferSize)
+        {
+            bufferSize = jmax( maxBytes, bufferSize * 2 );
+            buffer.malloc( bufferSize );
+        }
+
+        const size_t numBytes = make_natural_sort_key( texts[i], buffer.getData() );
+        keys.add( reinterpret_cast<const char*>( buffer.getData() ), numBytes );
+    }
+
+    struct KeyView
+    {
+        const char* text;
+        size_t numBytes;
+        int index;
+    };
+
+    HeapBlock<KeyView> views( (size_t) numTexts );
+
+    for (int i = 0; i < numTexts; i++)
+        views[i] = { keys.getText( i ), keys.getNumBytes( i ), i };
+
+    string_sort( views.getData(), size_t( numTexts ) );
+
+    for (int i = 0; i < numTexts; i++)
+        order[i] = views[i].index;
+}
+
+} // namespace treecore
@@ -0,0 +1,60 @@
+#ifndef TREECORE_NATURAL_ORDER_H
+#define TREECORE_NATURAL_ORDER_H
+
+#include "treecore/IntTypes.h"
+#include "treecore/PlatformDefs.h"
+#include "treecore/StringSlice.h"
+
+#include <cstddef>
+
+namespace treecore
+{
+
+/**
+ * @brief compare two zero-terminated UTF-8 strings in natural order
+ *
+ * This is the order of String::compareNatural(): case is ignored, runs of
+ * digits compare as numbers, runs of whitespace count as one space, and
+ * leading whitespace is ignored. Letters and digits come after other
+ * characters.
+ *
+ * Only ASCII characters are letters, digits or whitespace, whatever the C
+ * locale is, so that the order is the same everywhere. Other characters are
+ * compared by code point.
+ *
+ * A common prefix of the strings is skipped 16 bytes at a time.
+ *
+ * @return 0 if the strings are equivalent, negative if a comes first,
+ *         positive if b comes first
+ */
+TREECORE_SHARED_API int compare_natural( const char* a, const char* b ) noexcept;
+
+/**
+ * @brief enough bytes for the natural sort key of text of numBytes bytes
+ */
+inline size_t natural_sort_key_max_bytes( size_t numBytes ) noexcept { return numBytes * 8 + 1; }
+
+/**
+ * @brief write a key of text, such that comparing the keys of two texts
+ *        byte by byte, for example with memcmp() and the shorter first if
+ *        one is a prefix of the other, gives the order of compare_natural()
+ *
+ * Sorting many strings by their keys is much faster than comparing the
+ * strings themselves again and again.
+ *
+ * @param key  receives the key, at least natural_sort_key_max_bytes( text.getNumBytes() )
+ *             bytes
+ * @return number of bytes written
+ */
+TREECORE_SHARED_API size_t make_natural_sort_key( StringSlice text, uint8* key ) noexcept;
+
+/**
+ * @brief get the positions of texts in natural order
+ *
+ * @param order  receives numTexts indices into texts
+ */
+TREECORE_SHARED_API void sort_natural_order( const StringSlice* texts, int numTexts, int* order );
+
+} // namespace treecore
+
+#endif // TREECORE_NATURAL_ORDER_H
@@ -0,0 +1,683 @@
+#include "treecore/NumberConversion.h"
+
+#include <cfloat>
+#include <cstdlib>
+#include <cstring>
+
+#if TREECORE_COMPILER_MSVC
+#    include <intrin.h>
+#endif
+
+namespace treecore
+{
+
+namespace
+{
+
+#include "treecore/internal/NumberConversion_tables.h"
+
+struct UInt128
+{
+    uint64 hi;
+    uint64 lo;
+};
+
+inline UInt128 mul_64x64( const uint64 a, const uint64 b ) noexcept
+{
+#if defined(__SIZEOF_INT128__)
+    const unsigned __int128 p = (unsigned __int128) a * b;
+    return { uint64( p >> 64 ), uint64( p ) };
+#elif TREECORE_COMPILER_MSVC && defined(_M_X64)
+    UInt128 result;
+    result.lo = _umul128( a, b, &result.hi );
+    return result;
+#else
+    const uint64 a_lo = uint32( a ), a_hi = a >> 32;
+    const uint64 b_lo = uint32( b ), b_hi = b >> 32;
+
+    const uint64 p0  = a_lo * b_lo;
+    const uint64 p1  = a_lo * b_hi;
+    const uint64 p2  = a_hi * b_lo;
+    const uint64 mid = (p0 >> 32) + uint32( p1 ) + uint32( p2 );
+
+    return { a_hi * b_hi + (p1 >> 32) + (p2 >> 32) + (mid >> 32), (mid << 32) | uint32( p0 ) };
+#endif
+}
+
+// n must not be zero
+inline int count_leading_zeros( const uint64 n ) noexcept
+{
+#if TREECORE_COMPILER_MSVC && defined(_M_X64)
+    unsigned long index;
+    _BitScanReverse64( &index, n );
+    return 63 - int(index);
+#elif TREECORE_COMPILER_MSVC
+    unsigned long index;
+    if ( _BitScanReverse( &index, uint32( n >> 32 ) ) )
+        return 31 - int(index);
+    _BitScanReverse( &index, uint32( n ) );
+    return 63 - int(index);
+#else
+    return __builtin_clzll( n );
+#endif
+}
+
+template<typename To, typename From>
+inline To bit_cast( const From& from ) noexcept
+{
+    static_assert( sizeof(To) == sizeof(From), "sizes must match" );
+    To to;
+    std::memcpy( &to, &from, sizeof(to) );
+    return to;
+}
+
+//==============================================================================
+// Shortest decimal of a binary floating-point number, by the Schubfach method
+// of Raffaello Giulietti. The value c * 2^q is mapped to decimal exponent k,
+// where the rounding interval of the value contains at most one number of
+// the form s * 10^(k+1) and at least one of the form s * 10^k. Taking those
+// with 128-bit approximations of 10^-k, rounded to odd, gives the shortest
+// one, or the nearest of the shortest ones.
+
+struct Decimal
+{
+    uint64 significand;
+    int    exponent;
+};
+
+// These are exact for all exponents that occur. Right shift of negative
+// numbers is floor division on all supported compilers.
+inline int floor_log10_pow2( int e ) noexcept                { return (e * 1262611) >> 22; }
+inline int floor_log10_three_quarters_pow2( int e ) noexcept { return (e * 1262611 - 524031) >> 22; }
+inline int floor_log2_pow10( int e ) noexcept                { return (e * 1741647) >> 19; }
+
+inline uint64 round_to_odd( const uint64* g, const uint64 cp ) noexcept
+{
+    const UInt128 x  = mul_64x64( g[1], cp );
+    const UInt128 y  = mul_64x64( g[0], cp );
+    const uint64  y0 = y.lo + x.hi;
+    const uint64  y1 = y.hi + (y0 < y.lo ? 1 : 0);
+    return y1 | (y0 > 1 ? 1 : 0);
+}
+
+inline uint32 round_to_odd( const uint64 g, const uint32 cp ) noexcept
+{
+    const uint64 b01 = uint64( uint32( g ) ) * cp;
+    const uint64 b11 = (g >> 32) * cp;
+    const uint64 hi  = b11 + (b01 >> 32);
+    return uint32( hi >> 32 ) | (uint32( hi ) > 1 ? 1 : 0);
+}
+
+struct DoubleFormat
+{
+    typedef double Type;
+    typedef uint64 Bits;
+
+    enum
+    {
+        MANTISSA_BITS = 52,
+        EXPONENT_BIAS = 1023,
+        MAX_BIASED_EXPONENT = 0x7ff,
+
+        // for parsing
+        MIN_ROUND_TO_EVEN_POW10 = -4,
+        MAX_ROUND_TO_EVEN_POW10 = 23,
+        SMALLEST_POW10 = -342,
+        LARGEST_POW10  = 308,
+        MAX_EXACT_POW10 = 22
+    };
+
+    // g for 10^-k with 128 bits
+    static const uint64* pow10( int k ) noexcept { return pow10_schubfach[k + 292]; }
+
+    static uint64 round_to_odd( const uint64* g, const uint64 cp ) noexcept { return treecore::round_to_odd( g, cp ); }
+
+    static double parse_slow( const char* text ) noexcept { return std::strtod( text, nullptr ); }
+};
+
+struct FloatFormat
+{
+    typedef float  Type;
+    typedef uint32 Bits;
+
+    enum
+    {
+        MANTISSA_BITS = 23,
+        EXPONENT_BIAS = 127,
+        MAX_BIASED_EXPONENT = 0xff,
+
+        MIN_ROUND_TO_EVEN_POW10 = -17,
+        MAX_ROUND_TO_EVEN_POW10 = 10,
+        SMALLEST_POW10 = -64,
+        LARGEST_POW10  = 38,
+        MAX_EXACT_POW10 = 10
+    };
+
+    // the leading 64 bits of the 128-bit value, which is rounded up again
+    static uint64 pow10( int k ) noexcept { return pow10_schubfach[k + 292][0] + 1; }
+
+    static uint32 round_to_odd( const uint64 g, const uint32 cp ) noexcept { return treecore::round_to_odd( g, cp ); }
+
+    static float parse_slow( const char* text ) noexcept { return std::strtof( text, nullptr ); }
+};
+
+// value must be finite and nonzero
+template<typename Format>
+Decimal to_shortest_decimal( const typename Format::Bits ieee_significand, const int ieee_exponent ) noexcept
+{
+    typedef typename Format::Bits Bits;
+
+    Bits c;
+    int  q;
+
+    if (ieee_exponent != 0)
+    {
+        c = (Bits( 1 ) << Format::MANTISSA_BITS) | ieee_significand;
+        q = ieee_exponent - Format::EXPONENT_BIAS - Format::MANTISSA_BITS;
+
+        // integers are exact, and have no shorter representation
+        if ( 0 <= -q && -q <= Format::MANTISSA_BITS && ( c & ( (Bits( 1 ) << -q) - 1 ) ) == 0 )
+            return { uint64( c >> -q ), 0 };
+    }
+    else
+    {
+        c = ieee_significand;
+        q = 1 - Format::EXPONENT_BIAS - Format::MANTISSA_BITS;
+    }
+
+    const bool is_even = (c % 2) == 0;
+    const bool lower_boundary_is_closer = (ieee_significand == 0 && ieee_exponent > 1);
+
+    const Bits cbl = 4 * c - 2 + (lower_boundary_is_closer ? 1 : 0);
+    const Bits cb  = 4 * c;
+    const Bits cbr = 4 * c + 2;
+
+    const int k = lower_boundary_is_closer ? floor_log10_three_quarters_pow2( q ) : floor_log10_pow2( q );
+    const int h = q + floor_log2_pow10( -k ) + 1;
+
+    const auto g = Format::pow10( -k );
+
+    const Bits vbl = Format::round_to_odd( g, cbl << h );
+    const Bits vb  = Format::round_to_odd( g, cb << h );
+    const Bits vbr = Format::round_to_odd( g, cbr << h );
+
+    const Bits lower = vbl + (is_even ? 0 : 1);
+    const Bits upper = vbr - (is_even ? 0 : 1);
+
+    const Bits s = vb / 4;
+
+    if (s >= 10)
+    {
+        // at most one of the numbers with one digit less is inside
+        const Bits sp = s / 10;
+        const bool up_inside = lower <= 40 * sp;
+        const bool wp_inside = 40 * sp + 40 <= upper;
+
+        if (up_inside != wp_inside)
+            return { uint64( sp + (wp_inside ? 1 : 0) ), k + 1 };
+    }
+
+    const bool u_inside = lower <= 4 * s;
+    const bool w_inside = 4 * s + 4 <= upper;
+
+    if (u_inside != w_inside)
+        return { uint64( s + (w_inside ? 1 : 0) ), k };
+
+    // both are inside, take the nearer one, or the even one on a tie
+    const Bits mid = 4 * s + 2;
+    const bool round_up = vb > mid || ( vb == mid && (s & 1) != 0 );
+
+    return { uint64( s + (round_up ? 1 : 0) ), k };
+}
+
+//==============================================================================
+const char digit_pairs[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+// write digits of v so that they end at end, and return the first one
+inline char* write_digits_backwards( char* end, uint64 v ) noexcept
+{
+    while (v >= 100)
+    {
+        const uint64 pair = v % 100;
+        v /= 100;
+        end -= 2;
+        std::memcpy( end, digit_pairs + 2 * pair, 2 );
+    }
+
+    if (v >= 10)
+    {
+        end -= 2;
+        std::memcpy( end, digit_pairs + 2 * v, 2 );
+    }
+    else
+    {
+        *--end = char( '0' + v );
+    }
+
+    return end;
+}
+
+// lay out significand * 10^exponent the same way as JavaScript does
+size_t write_decimal( char* const buffer, const bool is_negative, uint64 significand, int exponent ) noexcept
+{
+    while (significand % 10 == 0)
+    {
+        significand /= 10;
+        ++exponent;
+    }
+
+    char digits[20];
+    const char* const first_digit = write_digits_backwards( digits + sizeof(digits), significand );
+    const int num_digits = int( digits + sizeof(digits) - first_digit );
+
+    // number of digits before the decimal point
+    const int point = exponent + num_digits;
+
+    char* t = buffer;
+
+    if (is_negative)
+        *t++ = '-';
+
+    if (num_digits <= point && point <= 21)
+    {
+        std::memcpy( t, first_digit, size_t( num_digits ) );
+        t += num_digits;
+        std::memset( t, '0', size_t( point - num_digits ) );
+        t += point - num_digits;
+    }
+    else if (0 < point && point <= 21)
+    {
+        std::memcpy( t, first_digit, size_t( point ) );
+        t   += point;
+        *t++ = '.';
+        std::memcpy( t, first_digit + point, size_t( num_digits - point ) );
+        t += num_digits - point;
+    }
+    else if (-6 < point && point <= 0)
+    {
+        *t++ = '0';
+        *t++ = '.';
+        std::memset( t, '0', size_t( -point ) );
+        t += -point;
+        std::memcpy( t, first_digit, size_t( num_digits ) );
+        t += num_digits;
+    }
+    else
+    {
+        *t++ = first_digit[0];
+
+        if (num_digits > 1)
+        {
+            *t++ = '.';
+            std::memcpy( t, first_digit + 1, size_t( num_digits - 1 ) );
+            t += num_digits - 1;
+        }
+
+        const int e = point - 1;
+        *t++ = 'e';
+        *t++ = e < 0 ? '-' : '+';
+
+        char exponent_digits[4];
+        const char* const first = write_digits_backwards( exponent_digits + sizeof(exponent_digits), uint64( e < 0 ? -e : e ) );
+        const size_t len = size_t( exponent_digits + sizeof(exponent_digits) - first );
+        std::memcpy( t, first, len );
+        t += len;
+    }
+
+    return size_t( t - buffer );
+}
+
+template<typename Format>
+size_t format_shortest( char* buffer, const typename Format::Type value ) noexcept
+{
+    typedef typename Format::Bits Bits;
+
+    const Bits bits = bit_cast<Bits>( value );
+    const Bits ieee_significand = bits & ( (Bits( 1 ) << Format::MANTISSA_BITS) - 1 );
+    const int  ieee_exponent    = int( ( bits >> Format::MANTISSA_BITS ) & Format::MAX_BIASED_EXPONENT );
+    const bool is_negative      = ( bits >> (sizeof(Bits) * 8 - 1) ) != 0;
+
+    if (ieee_exponent == Format::MAX_BIASED_EXPONENT)
+    {
+        if (ieee_significand != 0)
+        {
+            std::memcpy( buffer, "nan", 3 );
+            return 3;
+        }
+
+        if (is_negative)
+        {
+            std::memcpy( buffer, "-inf", 4 );
+            return 4;
+        }
+
+        std::memcpy( buffer, "inf", 3 );
+        return 3;
+    }
+
+    if (ieee_exponent == 0 && ieee_significand == 0)
+    {
+        if (is_negative)
+        {
+            std::memcpy( buffer, "-0", 2 );
+            return 2;
+        }
+
+        buffer[0] = '0';
+        return 1;
+    }
+
+    const Decimal decimal = to_shortest_decimal<Format>( ieee_significand, ieee_exponent );
+    return write_decimal( buffer, is_negative, decimal.significand, decimal.exponent );
+}
+
+//==============================================================================
+// Decimal to binary floating-point, by the method of Daniel Lemire, based on
+// an idea of Michael Eisel. The significand w is multiplied with the leading
+// 128 bits of 5^q, which always determines the correctly rounded result when
+// w is exact, see "Fast Number Parsing Without Fallback" by N. Mushtak and
+// D. Lemire.
+
+struct BinaryFloat
+{
+    uint64 mantissa;
+    int    power2; ///< biased exponent
+
+    bool operator == ( const BinaryFloat& other ) const noexcept
+    {
+        return mantissa == other.mantissa && power2 == other.power2;
+    }
+
+    bool operator != ( const BinaryFloat& other ) const noexcept { return !operator == ( other ); }
+};
+
+// the binary exponent of 10^q, plus 63
+inline int binary_exponent_of_pow10( const int q ) noexcept
+{
+    return ( ( (152170 + 65536) * q ) >> 16 ) + 63;
+}
+
+template<int BitPrecision>
+UInt128 multiply_by_pow5( const int q, const uint64 w ) noexcept
+{
+    const uint64* const pow5 = pow5_eisel_lemire[q + 342];
+
+    UInt128 product = mul_64x64( w, pow5[0] );
+
+    // the lower part of 5^q only matters if the bits below the result are all ones
+    const uint64 precision_mask = ~uint64( 0 ) >> BitPrecision;
+
+    if ( (product.hi & precision_mask) == precision_mask )
+    {
+        const UInt128 second = mul_64x64( w, pow5[1] );
+        product.lo += second.hi;
+
+        if (second.hi > product.lo)
+            product.hi++;
+    }
+
+    return product;
+}
+
+// w * 10^q, with q in range for int
+template<typename Format>
+BinaryFloat compute_float( const int q, uint64 w ) noexcept
+{
+    BinaryFloat answer;
+
+    if (w == 0 || q < Format::SMALLEST_POW10)
+    {
+        answer.mantissa = 0;
+        answer.power2   = 0;
+        return answer;
+    }
+
+    if (q > Format::LARGEST_POW10)
+    {
+        answer.mantissa = 0;
+        answer.power2   = Format::MAX_BIASED_EXPONENT;
+        return answer;
+    }
+
+    const int lz = count_leading_zeros( w );
+    w <<= lz;
+
+    const UInt128 product = multiply_by_pow5<Format::MANTISSA_BITS + 3>( q, w );
+
+    const int upper_bit = int( product.hi >> 63 );
+    const int shift     = upper_bit + 64 - Format::MANTISSA_BITS - 3;
+
+    answer.mantissa = product.hi >> shift;
+    answer.power2   = binary_exponent_of_pow10( q ) + upper_bit - lz + Format::EXPONENT_BIAS;
+
+    if (answer.power2 <= 0)
+    {
+        // subnormal, or zero when too small
+        if (-answer.power2 + 1 >= 64)
+        {
+            answer.mantissa = 0;
+            answer.power2   = 0;
+            return answer;
+        }
+
+        answer.mantissa >>= -answer.power2 + 1;
+        answer.mantissa  += answer.mantissa & 1;
+        answer.mantissa >>= 1;
+
+        // rounding up may have made it the smallest normal number
+        answer.power2 = answer.mantissa < (uint64( 1 ) << Format::MANTISSA_BITS) ? 0 : 1;
+        return answer;
+    }
+
+    // rounding is up, except halfway between two numbers where the lower one
+    // is even, which can only happen for small q
+    if ( product.lo <= 1
+         && q >= Format::MIN_ROUND_TO_EVEN_POW10 && q <= Format::MAX_ROUND_TO_EVEN_POW10
+         && (answer.mantissa & 3) == 1
+         && (answer.mantissa << shift) == product.hi )
+    {
+        answer.mantissa &= ~uint64( 1 );
+    }
+
+    answer.mantissa  += answer.mantissa & 1;
+    answer.mantissa >>= 1;
+
+    if ( answer.mantissa >= (uint64( 2 ) << Format::MANTISSA_BITS) )
+    {
+        answer.mantissa = uint64( 1 ) << Format::MANTISSA_BITS;
+        answer.power2++;
+    }
+
+    answer.mantissa &= ~(uint64( 1 ) << Format::MANTISSA_BITS);
+
+    if (answer.power2 >= Format::MAX_BIASED_EXPONENT)
+    {
+        answer.mantissa = 0;
+        answer.power2   = Format::MAX_BIASED_EXPONENT;
+    }
+
+    return answer;
+}
+
+template<typename Format>
+typename Format::Type to_binary( const BinaryFloat f, const bool is_negative ) noexcept
+{
+    typedef typename Format::Bits Bits;
+
+    Bits bits = Bits( f.mantissa ) | ( Bits( f.power2 ) << Format::MANTISSA_BITS );
+
+    if (is_negative)
+        bits |= Bits( 1 ) << (sizeof(Bits) * 8 - 1);
+
+    return bit_cast<typename Format::Type>( bits );
+}
+
+template<typename Type>
+struct ExactPowersOfTen;
+
+template<>
+struct ExactPowersOfTen<double>
+{
+    static double get( int i ) noexcept
+    {
+        static const double values[] = { 1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                         1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+        return values[i];
+    }
+};
+
+template<>
+struct ExactPowersOfTen<float>
+{
+    static float get( int i ) noexcept
+    {
+        static const float values[] = { 1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f };
+        return values[i];
+    }
+};
+
+inline bool has_non_zero_digit( const char* digits, size_t num_digits ) noexcept
+{
+    for (size_t i = 0; i < num_digits; ++i)
+    {
+        if (digits[i] != '0')
+            return true;
+    }
+
+    return false;
+}
+
+template<typename Format>
+typename Format::Type decimal_to_binary( const char* digits, size_t num_digits, const int64 exponent, const bool is_negative ) noexcept
+{
+    typedef typename Format::Type Type;
+
+    while (num_digits > 0 && *digits == '0')
+    {
+        ++digits;
+        --num_digits;
+    }
+
+    // the leading 19 digits always fit
+    const size_t num_exact = num_digits < 19 ? num_digits : 19;
+    uint64 w = 0;
+
+    for (size_t i = 0; i < num_exact; ++i)
+        w = w * 10 + uint64( digits[i] - '0' );
+
+    if (w == 0)
+        return is_negative ? -Type( 0 ) : Type( 0 );
+
+    const bool truncated = has_non_zero_digit( digits + num_exact, num_digits - num_exact );
+
+    // clamp far beyond the range of powers where the result is zero or infinite
+    const int64 limit = 100000;
+    int64 q64 = exponent < -limit ? -limit : (exponent > limit ? limit : exponent);
+    q64 += int64( num_digits - num_exact );
+
+    const int q = int( q64 > limit ? limit : q64 );
+
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0
+    // both w and 10^|q| are exact, so one operation rounds correctly
+    if ( !truncated && -Format::MAX_EXACT_POW10 <= q && q <= Format::MAX_EXACT_POW10
+         && w <= (uint64( 1 ) << (Format::MANTISSA_BITS + 1)) )
+    {
+        Type value = Type( w );
+
+        if (q < 0)
+            value /= ExactPowersOfTen<Type>::get( -q );
+        else
+            value *= ExactPowersOfTen<Type>::get( q );
+
+        return is_negative ? -value : value;
+    }
+#endif
+
+    const BinaryFloat result = compute_float<Format>( q, w );
+
+    if (!truncated)
+        return to_binary<Format>( result, is_negative );
+
+    // the true significand is between w and w + 1, so unless both round to
+    // the same number, the result depends on the digits that were left out
+    if ( compute_float<Format>( q, w + 1 ) == result )
+        return to_binary<Format>( result, is_negative );
+
+    // Digits beyond the limit only matter by being zero or not, so they are
+    // replaced by a single one if not.
+    size_t num_text_digits = num_digits;
+    int64  text_exponent   = exponent;
+    bool   sticky_digit    = false;
+
+    if (num_text_digits > PARSE_FLOAT_MAX_DIGITS)
+    {
+        num_text_digits = PARSE_FLOAT_MAX_DIGITS - 1;
+        text_exponent  += int64( num_digits - num_text_digits );
+        sticky_digit    = has_non_zero_digit( digits + num_text_digits, num_digits - num_text_digits );
+
+        if (sticky_digit)
+            --text_exponent;
+    }
+
+    // Without a decimal point, the C library's parsing doesn't depend on the
+    // locale.
+    char text[PARSE_FLOAT_MAX_DIGITS + 32];
+    char* t = text;
+
+    if (is_negative)
+        *t++ = '-';
+
+    std::memcpy( t, digits, num_text_digits );
+    t += num_text_digits;
+
+    if (sticky_digit)
+        *t++ = '1';
+
+    *t++ = 'e';
+
+    if (text_exponent < 0)
+        *t++ = '-';
+
+    char exponent_digits[24];
+    char* const exponent_end = exponent_digits + sizeof(exponent_digits);
+    const char* const first = write_digits_backwards( exponent_end, uint64( text_exponent < 0 ? -text_exponent : text_exponent ) );
+    std::memcpy( t, first, size_t( exponent_end - first ) );
+    t += exponent_end - first;
+    *t = 0;
+
+    return Format::parse_slow( text );
+}
+
+} // anonymous namespace
+
+size_t format_double_shortest( char* buffer, double value ) noexcept
+{
+    return format_shortest<DoubleFormat>( buffer, value );
+}
+
+size_t format_float_shortest( char* buffer, float value ) noexcept
+{
+    return format_shortest<FloatFormat>( buffer, value );
+}
+
+double decimal_to_double( const char* digits, size_t numDigits, int64 exponent, bool isNegative ) noexcept
+{
+    return decimal_to_binary<DoubleFormat>( digits, numDigits, exponent, isNegative );
+}
+
+float decimal_to_float( const char* digits, size_t numDigits, int64 exponent, bool isNegative ) noexcept
+{
+    return decimal_to_binary<FloatFormat>( digits, numDigits, exponent, isNegative );
+}
+
+} // namespace treecore
@@ -0,0 +1,65 @@
+#ifndef TREECORE_NUMBER_CONVERSION_H
+#define TREECORE_NUMBER_CONVERSION_H
+
+#include "treecore/IntTypes.h"
+#include "treecore/PlatformDefs.h"
+
+#include <cstddef>
+
+namespace treecore
+{
+
+enum
+{
+    /// enough for any output of format_double_shortest() and format_float_shortest()
+    FORMAT_FLOAT_MAX_CHARS = 32,
+
+    /// digits beyond this many can't change how a decimal is rounded to
+    /// double, other than by being zero or not
+    PARSE_FLOAT_MAX_DIGITS = 780
+};
+
+/**
+ * @brief write the shortest text which reads back as exactly the same double
+ *
+ * Among all shortest decimals which round to value, the one nearest to it is
+ * chosen. The layout is the same as that of JavaScript: plain notation for
+ * decimal exponents from -6 to 20, and exponent notation like "1.5e+21" and
+ * "1e-7" otherwise. Special values are written as "nan", "inf" and "-inf",
+ * and negative zero as "-0".
+ *
+ * @param buffer  receives the text, at least FORMAT_FLOAT_MAX_CHARS bytes,
+ *                not zero-terminated
+ * @return number of bytes written
+ */
+TREECORE_SHARED_API size_t format_double_shortest( char* buffer, double value ) noexcept;
+
+/**
+ * @brief the same as format_double_shortest(), for the precision of float
+ */
+TREECORE_SHARED_API size_t format_float_shortest( char* buffer, float value ) noexcept;
+
+/**
+ * @brief get the double nearest to a decimal number, rounding ties to even
+ *
+ * The number is given as the ASCII digits of an integer significand, which
+ * is multiplied by 10 ^ exponent. Up to 19 digits are converted exactly with
+ * 128-bit arithmetic, and longer significands mostly so, only rare cases
+ * close to a rounding boundary fall back to the C library.
+ *
+ * @param digits     digits of the significand, may have leading zeros
+ * @param numDigits  number of digits, may be zero
+ * @param exponent   decimal exponent applied to the significand
+ */
+TREECORE_SHARED_API double decimal_to_double( const char* digits, size_t numDigits, int64 exponent, bool isNegative ) noexcept;
+
+/**
+ * @brief the same as decimal_to_double(), rounding to float directly
+ *
+ * This avoids the double rounding of converting the double result to float.
+ */
+TREECORE_SHARED_API float decimal_to_float( const char* digits, size_t numDigits, int64 exponent, bool isNegative ) noexcept;
+
+} // namespace treecore
+
+#endif // TREECORE_NUMBER_CONVERSION_H
@@ -2,6 +2,7 @@
 #define TREECORE_OBJECT_POOL_H
 
 #include "treecore/AlignedMalloc.h"
+#include "treecore/EpochManager.h"
 #include "treecore/IntTypes.h"
 #include "treecore/LeakedObjectDetector.h"
 #include "treecore/LFQueue.h"
@@ -20,6 +21,10 @@ namespace treecore
 /**
  * @brief hold memory cache for fast creation of many objects
  *
+ * Objects that are still visible to concurrent readers, such as nodes just
+ * unlinked from a lock-free container, can be given back with retire()
+ * instead of recycle(). They are recycled after all readers that entered
+ * critical section of getEpochManager() before leave it.
  */
 template<typename T, bool MULTI_THREAD = true, int BLOCK_SIZE = 4096>
 class ObjectPool: public RefCountObject, public RefCountSingleton<ObjectPool<T, MULTI_THREAD, BLOCK_SIZE> >
@@ -69,6 +74,9 @@ public:
      */
     ~ObjectPool()
     {
+        // retired objects live in our blocks, so they must be finished first
+        m_epoch.reclaimAll();
+
         ObjBlock* k;
         while likely(m_blocks.pop(k)) { delete k; }
     }
@@ -105,7 +113,7 @@ public:
         }
 
         treecore_assert(k != nullptr);
-        new (k) T(initValues...);
+        new (k) T(std::forward<InitType>(initValues)...);
         return k;
     }
 
@@ -120,6 +128,32 @@ public:
         m_objects.push(k);
     }
 
+    /**
+     * @brief recycle this object after no thread can access it
+     *
+     * The object should already be unreachable for threads that enter
+     * critical section of getEpochManager() from now on. It is destroyed and
+     * recycled after threads currently inside critical section leave it.
+     *
+     * @param k object to retire
+     */
+    void retire(T* k)
+    {
+        if unlikely(k == nullptr) return;
+        m_epoch.retire(k, &recycle_retired, this);
+    }
+
+    /**
+     * @brief epoch manager that guards objects given to retire()
+     *
+     * Threads should access shared objects from this pool inside its
+     * critical section, e.g. with EpochManager::ScopedGuard.
+     */
+    EpochManager& getEpochManager() noexcept
+    {
+        return m_epoch;
+    }
+
     /**
      * @brief create some additional memory blocks
      * @param numBlock number of memory blocks to create
@@ -140,8 +174,14 @@ public:
     }
 
 private:
+    static void recycle_retired(void* k, void* pool)
+    {
+        static_cast<ObjectPool*>(pool)->recycle(static_cast<T*>(k));
+    }
+
     BlockQueueType m_blocks;
     ValueQueueType m_objects;
+    EpochManager m_epoch;
     TREECORE_DECLARE_NON_COPYABLE(ObjectPool)
 };
 
@@ -32,6 +32,7 @@
 #include "treecore/InputStream.h"
 #include "treecore/MemoryBlock.h"
 #include "treecore/NewLine.h"
+#include "treecore/NumberConversion.h"
 #include "treecore/OutputStream.h"
 #include "treecore/String.h"
 #include "treecore/internal/String_private.h"
@@ -309,7 +310,9 @@ TREECORE_SHARED_API OutputStream& TREECORE_STDCALL operator<< (OutputStream& str
 
 TREECORE_SHARED_API OutputStream& TREECORE_STDCALL operator<< (OutputStream& stream, const double number)
 {
-    return stream << String (number);
+    char buffer [FORMAT_FLOAT_MAX_CHARS];
+    stream.write (buffer, format_double_shortest (buffer, number));
+    return stream;
 }
 
 TREECORE_SHARED_API OutputStream& TREECORE_STDCALL operator<< (OutputStream& stream, const char character)
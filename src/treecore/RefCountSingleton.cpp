@@ -0,0 +1,12 @@
+#include "treecore/RefCountSingleton.h"
+
+namespace treecore
+{
+
+EpochManager& get_ref_count_singleton_epoch() noexcept
+{
+    static EpochManager epoch;
+    return epoch;
+}
+
+} // namespace treecore
@@ -1,6 +1,9 @@
 #ifndef TREECORE_REF_COUNT_SINGLETON_H
 #define TREECORE_REF_COUNT_SINGLETON_H
 
+#include "treecore/AdaptiveMutex.h"
+#include "treecore/AtomicObject.h"
+#include "treecore/EpochManager.h"
 #include "treecore/ReadWriteLock.h"
 #include "treecore/IntTypes.h"
 #include "treecore/RefCountHolder.h"
@@ -12,6 +15,15 @@ class TestFramework;
 namespace treecore
 {
 
+/**
+ * @brief epoch that protects the instance pointers of all RefCountSingleton
+ *        types
+ *
+ * One manager is shared by all of them, as each thread caches its record of
+ * the last manager it used, and code often alternates between singletons.
+ */
+TREECORE_SHARED_API EpochManager& get_ref_count_singleton_epoch() noexcept;
+
 ///
 /// \brief manage a global instance by managing reference count
 ///
@@ -32,25 +44,23 @@ public:
     ///
     static RefCountHolder<T> getInstance()
     {
-        RefCountHolder<T> re;
-        ReadWriteLock& mutex = get_building_mutex();
-
         // early out
-        if ( mutex.tryEnterRead() )
+        // After the instance is built, this is one load of the instance
+        // pointer plus the reference increment. The epoch critical section
+        // only touches a record owned by current thread, and keeps
+        // releaseInstance() from dropping the instance between the load and
+        // the increment.
         {
-            re = get_raw_instance().load();
-            if (re)
-            {
-                mutex.exitRead();
-                return re;
-            }
+            EpochManager::ScopedGuard guard( get_ref_count_singleton_epoch() );
+            RefCountHolder<T> re( get_raw_instance().load() );
 
-            mutex.exitRead();
+            if likely(re)
+                return re;
         }
 
         // do build
         {
-            ScopedWriteLock lock( mutex );
+            const AdaptiveMutex::ScopedLockType lock( get_building_mutex() );
 
             T* tmp = get_raw_instance().load();
             if (tmp == nullptr)
@@ -60,8 +70,7 @@ public:
                 get_raw_instance() = tmp;
             }
 
-            re = tmp;
-            return re;
+            return RefCountHolder<T>( tmp );
         }
     }
 
@@ -71,20 +80,18 @@ public:
     ///
     static RefCountHolder<T> getInstanceWithoutCreating()
     {
-        RefCountHolder<T> re;
-        ReadWriteLock& lock = get_building_mutex();
-
-        if ( lock.tryEnterRead() )
-        {
-            re = get_raw_instance().load();
-            lock.exitRead();
-        }
-
-        return re;
+        EpochManager::ScopedGuard guard( get_ref_count_singleton_epoch() );
+        return RefCountHolder<T>( get_raw_instance().load() );
     }
 
     /**
      * @brief release global hold of the instance
+     *
+     * Waits until threads that may have loaded the instance pointer in
+     * getInstance() have taken their reference. Must not be called from
+     * inside a critical section of the epoch returned by
+     * get_ref_count_singleton_epoch().
+     *
      * @return remaining reference count after unhold, -1 if it is empty
      */
     static int32 releaseInstance()
@@ -94,28 +101,34 @@ public:
         if (tmp == nullptr)
             return -1;
 
-        // do release
+        // take the instance away, so that no more readers can find it
         {
-            ScopedWriteLock lock( get_building_mutex() );
+            const AdaptiveMutex::ScopedLockType lock( get_building_mutex() );
 
             tmp = get_raw_instance().load();
-            int cnt_before_release = -1;
+            if (tmp == nullptr)
+                return -1;
 
-            // do actual release
-            if (tmp != nullptr)
-            {
-                cnt_before_release = smart_unref( tmp );
-                get_raw_instance() = nullptr;
-            }
-            return cnt_before_release;
+            get_raw_instance() = nullptr;
         }
+
+        // do actual release, after the readers that may still see it
+        int32 cnt_before_release = -1;
+        EpochManager& epoch = get_ref_count_singleton_epoch();
+        epoch.retire( tmp, &unref_instance, &cnt_before_release );
+        epoch.synchronize();
+        return cnt_before_release;
     }
 
 private:
+    static void unref_instance( void* instance, void* result )
+    {
+        *static_cast<int32*>(result) = smart_unref( static_cast<T*>(instance) );
+    }
 
-    static ReadWriteLock& get_building_mutex()
+    static AdaptiveMutex& get_building_mutex()
     {
-        static ReadWriteLock m_building_fuck_cxx;
+        static AdaptiveMutex m_building_fuck_cxx;
         return m_building_fuck_cxx;
     }
 
@@ -5,6 +5,11 @@
 
 #if TREECORE_CPU_X86
 #  include "treecore/simd/sse2.h"
+#  if TREECORE_SIMD_AVX512
+#    include "treecore/simd/avx512.h"
+#  elif TREECORE_SIMD_AVX2
+#    include "treecore/simd/avx2.h"
+#  endif
 #elif TREECORE_CPU_ARM
 #  include "treecore/simd/neon.h"
 #else
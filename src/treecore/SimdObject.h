@@ -18,7 +18,7 @@ struct SimdObject
 
     SimdObject() noexcept
     {
-        simd_set_all<T>( data, 0, 0, 0, 0 );
+        simd_broadcast<T>( data, T( 0 ) );
     }
 
     SimdObject( const SimdObject& peer ) noexcept
@@ -303,6 +303,16 @@ struct SimdObject
 typedef SimdObject<float, 4> simd4f;
 typedef SimdObject<int32, 4> simd4i;
 
+#if TREECORE_SIMD_AVX2
+typedef SimdObject<float, 8> simd8f;
+typedef SimdObject<int32, 8> simd8i;
+#endif
+
+#if TREECORE_SIMD_AVX512
+typedef SimdObject<float, 16> simd16f;
+typedef SimdObject<int32, 16> simd16i;
+#endif
+
 } // namespace treecore
 
 #endif // TREECORE_SIMD_OBJECT_H
@@ -0,0 +1,186 @@
+#ifndef TREECORE_SNAPSHOT_PTR_H
+#define TREECORE_SNAPSHOT_PTR_H
+
+#include "treecore/AdaptiveMutex.h"
+#include "treecore/AtomicFunc.h"
+#include "treecore/ClassUtils.h"
+#include "treecore/EpochManager.h"
+
+class TestFramework;
+
+namespace treecore
+{
+
+/**
+ * @brief RCU-style holder for read-mostly data
+ *
+ * Readers take a snapshot of current version through a ReadGuard. Taking
+ * a snapshot doesn't write to any memory shared with other readers: it only
+ * enters critical section of an EpochManager, which touches a record owned
+ * by current thread, and loads the pointer. Compared with copying a
+ * RefCountHolder, whose reference count is modified by all readers, this
+ * keeps readers on different cores from bouncing cache lines.
+ *
+ * Writers never modify a published version. They build a new one and
+ * publish it, and the old version is deleted after all readers that may
+ * see it have dropped their snapshots. publish() and update() delete it
+ * at once if no reader holds a snapshot. Otherwise it is deleted by a later
+ * publish(), update(), collect() or synchronize() of the same thread.
+ *
+ * A snapshot must not be kept for long, as it holds back reclamation of
+ * everything retired meanwhile by the same EpochManager.
+ *
+ * @code
+ * SnapshotPtr<Config> config( new Config() );
+ *
+ * // reader
+ * {
+ *     SnapshotPtr<Config>::ReadGuard snapshot( config );
+ *     use( snapshot->value );
+ * }
+ *
+ * // writer
+ * config.update( []( Config& c ) { c.value = 1; } );
+ * @endcode
+ */
+template<typename T>
+class SnapshotPtr
+{
+    friend class ::TestFramework;
+
+public:
+    class ReadGuard
+    {
+    public:
+        inline explicit ReadGuard( const SnapshotPtr& holder ) noexcept
+            : m_manager( holder.m_epoch )
+        {
+            m_manager.enter();
+            m_ptr = atomic_load( &holder.m_ptr );
+        }
+
+        inline ~ReadGuard() noexcept { m_manager.exit(); }
+
+        inline const T* get() const noexcept        { return m_ptr; }
+        inline const T* operator -> () const noexcept { return m_ptr; }
+        inline const T& operator * () const noexcept  { return *m_ptr; }
+        inline explicit operator bool () const noexcept { return m_ptr != nullptr; }
+
+    private:
+        EpochManager& m_manager;
+        const T* m_ptr;
+        TREECORE_DECLARE_NON_COPYABLE( ReadGuard )
+    };
+
+    /**
+     * @brief create holder with initial version
+     * @param initial  object to take ownership of, can be nullptr
+     */
+    explicit SnapshotPtr( T* initial = nullptr ) noexcept: m_ptr( initial ) {}
+
+    /**
+     * @brief delete current version, and all old versions still pending
+     *
+     * No reader should be holding a snapshot.
+     */
+    ~SnapshotPtr()
+    {
+        m_epoch.reclaimAll();
+        delete m_ptr;
+    }
+
+    /**
+     * @brief replace current version, old version is deleted when no reader
+     *        can see it
+     * @param value  object to take ownership of, can be nullptr
+     */
+    void publish( T* value )
+    {
+        const AdaptiveMutex::ScopedLockType lock( m_write_mutex );
+        retire( atomic_exchange( &m_ptr, value ) );
+    }
+
+    /**
+     * @brief copy current version, modify the copy, and publish it
+     *
+     * Concurrent updates are serialized, so no modification is lost. The
+     * functor is called with a non-const reference to the new copy. Current
+     * version must not be nullptr.
+     */
+    template<typename Func>
+    void update( Func modifier )
+    {
+        const AdaptiveMutex::ScopedLockType lock( m_write_mutex );
+
+        // writers are serialized, so current version can't go away here
+        const T* curr = atomic_load( &m_ptr );
+        treecore_assert( curr != nullptr );
+
+        T* next = new T( *curr );
+        modifier( *next );
+        retire( atomic_exchange( &m_ptr, next ) );
+    }
+
+    /**
+     * @brief delete old versions retired by current thread that no reader
+     *        can see any more, without blocking
+     *
+     * Can be called by a writer whose last update happened while readers
+     * held snapshots, so that the replaced version doesn't wait for the next
+     * update.
+     */
+    void collect()
+    {
+        // a version retired in one epoch is safe two epochs later, and each
+        // collect() advances at most one epoch
+        for (int i = 0; i < 2; i++)
+        {
+            if ( !m_epoch.collect() )
+                break;
+        }
+    }
+
+    /**
+     * @brief block until old versions retired by current thread are deleted
+     *
+     * Must not be called while current thread holds a snapshot.
+     */
+    void synchronize()
+    {
+        m_epoch.synchronize();
+    }
+
+    /**
+     * @brief should be called by a reader thread that is going to finish
+     * @see EpochManager::detachCurrentThread
+     */
+    void detachCurrentThread() const
+    {
+        m_epoch.detachCurrentThread();
+    }
+
+    EpochManager& getEpochManager() noexcept
+    {
+        return m_epoch;
+    }
+
+private:
+    void retire( T* old )
+    {
+        if (old != nullptr)
+        {
+            m_epoch.retireDelete( old );
+            collect();
+        }
+    }
+
+    T* m_ptr;
+    mutable EpochManager m_epoch;
+    AdaptiveMutex m_write_mutex;
+
+    TREECORE_DECLARE_NON_COPYABLE( SnapshotPtr )
+};
+
+} // namespace treecore
+
+#endif // TREECORE_SNAPSHOT_PTR_H
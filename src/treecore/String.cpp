@@ -27,12 +27,16 @@
  */
 
 #include "treecore/AtomicFunc.h"
+#include "treecore/BinaryEncoding.h"
 #include "treecore/DebugUtils.h"
 #include "treecore/ByteOrder.h"
 #include "treecore/HeapBlock.h"
+#include "treecore/NaturalOrder.h"
 #include "treecore/NewLine.h"
+#include "treecore/NumberConversion.h"
 #include "treecore/OutputStream.h"
 #include "treecore/String.h"
+#include "treecore/UTF8Functions.h"
 #include "treecore/internal/String_private.h"
 
 #include <cstring>
@@ -53,15 +57,6 @@ static inline CharPointer_wchar_t castToCharPointer_wchar_t( const void* t ) noe
     return CharPointer_wchar_t( static_cast<const CharPointer_wchar_t::CharType*>(t) );
 }
 
-//==============================================================================
-// (Mirrors the structure of StringHolder, but without the atomic member, so can be statically constructed)
-
-const EmptyString& emptyString()
-{
-    static const EmptyString value = { 0x3fffffff, sizeof(String::CharPointerType::CharType), 0 };
-    return value;
-}
-
 //==============================================================================
 StringHolder::CharPointerType StringHolder::createUninitialisedBytes( size_t numBytes )
 {
@@ -72,45 +67,47 @@ StringHolder::CharPointerType StringHolder::createUninitialisedBytes( size_t num
     return CharPointerType( s->text );
 }
 
-StringHolder::CharPointerType StringHolder::createFromCharPointer( const CharPointerType start, const CharPointerType end )
+String StringHolder::createFromCharPointer( const CharPointerType text )
 {
-    if ( start.getAddress() == nullptr || start.isEmpty() )
-        return CharPointerType( &(emptyString().text) );
+    if ( text.getAddress() == nullptr || text.isEmpty() )
+        return String();
 
-    const size_t numBytes = (size_t) ( reinterpret_cast<const char*>( end.getAddress() )
-                                       - reinterpret_cast<const char*>( start.getAddress() ) );
-    const CharPointerType dest( createUninitialisedBytes( numBytes + sizeof(CharType) ) );
-    std::memcpy( dest.getAddress(), start, numBytes );
-    dest.getAddress()[numBytes / sizeof(CharType)] = 0;
-    return dest;
+    // well-formed text would be re-encoded to the same bytes
+    const size_t numBytes = std::strlen( text.getAddress() );
+
+    if ( !utf8_validate( text.getAddress(), numBytes ) )
+        return createFromCharPointer<CharPointerType>( text );
+
+    String result( String::PreallocationBytes( (size_t) numBytes ) );
+    std::memcpy( result.text().getAddress(), text.getAddress(), numBytes + sizeof(CharType) );
+    return result;
 }
 
-StringHolder::CharPointerType StringHolder::createFromFixedLength( const char* const src, const size_t numChars )
+String StringHolder::createFromCharPointer( const CharPointerType start, const CharPointerType end )
 {
-    const CharPointerType dest( createUninitialisedBytes( numChars * sizeof(CharType) + sizeof(CharType) ) );
-    CharPointerType( dest ).writeWithCharLimit( CharPointer_UTF8( src ), (int) (numChars + 1) );
-    return dest;
+    if ( start.getAddress() == nullptr || start.isEmpty() )
+        return String();
+
+    const size_t numBytes = (size_t) ( reinterpret_cast<const char*>( end.getAddress() )
+                                       - reinterpret_cast<const char*>( start.getAddress() ) );
+    String result( String::PreallocationBytes( (size_t) numBytes ) );
+    CharType* const dest = result.text().getAddress();
+    std::memcpy( dest, start, numBytes );
+    dest[numBytes / sizeof(CharType)] = 0;
+    return result;
 }
 
-void StringHolder::retain( const CharPointerType text ) noexcept
+String StringHolder::createFromFixedLength( const char* const src, const size_t numChars )
 {
-    StringHolder* const b = bufferFromText( text );
-
-    if (b != (StringHolder*) &emptyString())
-        ++(b->refCount);
+    String result( String::PreallocationBytes( numChars * sizeof(CharType) ) );
+    result.text().writeWithCharLimit( CharPointer_UTF8( src ), (int) (numChars + 1) );
+    return result;
 }
 
 StringHolder::CharPointerType StringHolder::makeUniqueWithByteSize( const CharPointerType text, size_t numBytes )
 {
     StringHolder* const b = bufferFromText( text );
 
-    if (b == (StringHolder*) &emptyString())
-    {
-        CharPointerType newText( createUninitialisedBytes( numBytes ) );
-        newText.writeNull();
-        return newText;
-    }
-
     if (b->allocatedNumBytes >= numBytes && atomic_load( &b->refCount ) <= 0)
         return text;
 
@@ -121,11 +118,6 @@ StringHolder::CharPointerType StringHolder::makeUniqueWithByteSize( const CharPo
     return newText;
 }
 
-size_t StringHolder::getAllocatedNumBytes( const CharPointerType text ) noexcept
-{
-    return bufferFromText( text )->allocatedNumBytes;
-}
-
 const String& String::empty()
 {
     static String empty_string_instance;
@@ -133,68 +125,98 @@ const String& String::empty()
 }
 
 //==============================================================================
-String::String() noexcept: text( &(emptyString().text) )
+String::String() noexcept: m_storage()
 {}
 
 String::~String() noexcept
 {
-    StringHolder::release( text );
+    if ( !isInline() )
+        StringHolder::release( CharPointerType( m_storage.heap ) );
 }
 
-String::String ( const String& other ) noexcept: text( other.text )
+String::String ( const String& other ) noexcept: m_storage( other.m_storage )
 {
-    StringHolder::retain( text );
+    if ( !isInline() )
+        StringHolder::retain( CharPointerType( m_storage.heap ) );
 }
 
 void String::swapWith( String& other ) noexcept
 {
-    std::swap( text, other.text );
+    std::swap( m_storage, other.m_storage );
 }
 
 void String::clear() noexcept
 {
-    StringHolder::release( text );
-    text = &(emptyString().text);
+    if ( !isInline() )
+        StringHolder::release( CharPointerType( m_storage.heap ) );
+
+    m_storage = Storage();
 }
 
 String& String::operator = ( const String& other ) noexcept
 {
-    StringHolder::retain( other.text );
-    StringHolder::release( text.atomicSwap( other.text ) );
+    // retain first, in case both share the same holder
+    if ( !other.isInline() )
+        StringHolder::retain( CharPointerType( other.m_storage.heap ) );
+
+    if ( !isInline() )
+        StringHolder::release( CharPointerType( m_storage.heap ) );
+
+    m_storage = other.m_storage;
     return *this;
 }
 
 String::String ( String&& other ) noexcept
-    : text( other.text )
+    : m_storage( other.m_storage )
 {
-    other.text = &(emptyString().text); // why not use swap here?
+    other.m_storage = Storage();
 }
 
 String& String::operator = ( String&& other ) noexcept
 {
-    std::swap( text, other.text );
+    std::swap( m_storage, other.m_storage );
     return *this;
 }
 
-inline String::PreallocationBytes::PreallocationBytes ( const size_t num ) noexcept: numBytes( num ) {}
+String::PreallocationBytes::PreallocationBytes ( const size_t num ) noexcept: numBytes( num ) {}
 
 String::String ( const PreallocationBytes& preallocationSize )
-    : text( StringHolder::createUninitialisedBytes( preallocationSize.numBytes + sizeof(CharPointerType::CharType) ) )
-{}
+    : m_storage()
+{
+    const size_t numBytes = preallocationSize.numBytes + sizeof(CharPointerType::CharType);
+
+    if (numBytes > SSO_BYTES)
+        setHeapText( StringHolder::createUninitialisedBytes( numBytes ) );
+}
 
 void String::preallocateBytes( const size_t numBytesNeeded )
 {
-    text = StringHolder::makeUniqueWithByteSize( text, numBytesNeeded + sizeof(CharPointerType::CharType) );
+    const size_t numBytes = numBytesNeeded + sizeof(CharPointerType::CharType);
+
+    if ( isInline() )
+    {
+        if (numBytes <= SSO_BYTES)
+            return;
+
+        // copy whole inline buffer, its last byte is zero
+        const CharPointerType newText( StringHolder::createUninitialisedBytes( numBytes ) );
+        std::memcpy( newText.getAddress(), m_storage.chars, SSO_BYTES );
+        setHeapText( newText );
+    }
+    else
+    {
+        m_storage.heap = StringHolder::makeUniqueWithByteSize( CharPointerType( m_storage.heap ), numBytes ).getAddress();
+    }
 }
 
 int String::getReferenceCount() const noexcept
 {
-    return StringHolder::getReferenceCount( text );
+    return isInline() ? 1 : StringHolder::getReferenceCount( CharPointerType( m_storage.heap ) );
 }
 
 //==============================================================================
 String::String ( const char* const t )
-    : text( StringHolder::createFromCharPointer( CharPointer_ASCII( t ) ) )
+    : String( StringHolder::createFromCharPointer( CharPointer_ASCII( t ) ) )
 {
     /*  If you get an assertion here, then you're trying to create a string from 8-bit data
         that contains values greater than 127. These can NOT be correctly converted to unicode
@@ -213,7 +235,7 @@ String::String ( const char* const t )
 }
 
 String::String ( const char* const t, const size_t maxChars )
-    : text( StringHolder::createFromCharPointer( CharPointer_ASCII( t ), maxChars ) )
+    : String( StringHolder::createFromCharPointer( CharPointer_ASCII( t ), maxChars ) )
 {
     /*  If you get an assertion here, then you're trying to create a string from 8-bit data
         that contains values greater than 127. These can NOT be correctly converted to unicode
@@ -231,27 +253,27 @@ String::String ( const char* const t, const size_t maxChars )
     treecore_assert( t == nullptr || CharPointer_ASCII::isValidString( t, (int) maxChars ) );
 }
 
-String::String ( const wchar_t* const t ): text( StringHolder::createFromCharPointer( castToCharPointer_wchar_t( t ) ) ) {}
-String::String ( const CharPointer_UTF8 t ): text( StringHolder::createFromCharPointer( t ) ) {}
-String::String ( const CharPointer_UTF16 t ): text( StringHolder::createFromCharPointer( t ) ) {}
-String::String ( const CharPointer_UTF32 t ): text( StringHolder::createFromCharPointer( t ) ) {}
-String::String ( const CharPointer_ASCII t ): text( StringHolder::createFromCharPointer( t ) ) {}
+String::String ( const wchar_t* const t ): String( StringHolder::createFromCharPointer( castToCharPointer_wchar_t( t ) ) ) {}
+String::String ( const CharPointer_UTF8 t ): String( StringHolder::createFromCharPointer( t ) ) {}
+String::String ( const CharPointer_UTF16 t ): String( StringHolder::createFromCharPointer( t ) ) {}
+String::String ( const CharPointer_UTF32 t ): String( StringHolder::createFromCharPointer( t ) ) {}
+String::String ( const CharPointer_ASCII t ): String( StringHolder::createFromCharPointer( t ) ) {}
 
-String::String ( const CharPointer_UTF8 t, const size_t maxChars ): text( StringHolder::createFromCharPointer( t, maxChars ) ) {}
-String::String ( const CharPointer_UTF16 t, const size_t maxChars ): text( StringHolder::createFromCharPointer( t, maxChars ) ) {}
-String::String ( const CharPointer_UTF32 t, const size_t maxChars ): text( StringHolder::createFromCharPointer( t, maxChars ) ) {}
-String::String ( const wchar_t* const t, size_t maxChars ): text( StringHolder::createFromCharPointer( castToCharPointer_wchar_t( t ), maxChars ) ) {}
+String::String ( const CharPointer_UTF8 t, const size_t maxChars ): String( StringHolder::createFromCharPointer( t, maxChars ) ) {}
+String::String ( const CharPointer_UTF16 t, const size_t maxChars ): String( StringHolder::createFromCharPointer( t, maxChars ) ) {}
+String::String ( const CharPointer_UTF32 t, const size_t maxChars ): String( StringHolder::createFromCharPointer( t, maxChars ) ) {}
+String::String ( const wchar_t* const t, size_t maxChars ): String( StringHolder::createFromCharPointer( castToCharPointer_wchar_t( t ), maxChars ) ) {}
 
-String::String ( const CharPointer_UTF8 start, const CharPointer_UTF8 end ): text( StringHolder::createFromCharPointer( start, end ) ) {}
-String::String ( const CharPointer_UTF16 start, const CharPointer_UTF16 end ): text( StringHolder::createFromCharPointer( start, end ) ) {}
-String::String ( const CharPointer_UTF32 start, const CharPointer_UTF32 end ): text( StringHolder::createFromCharPointer( start, end ) ) {}
+String::String ( const CharPointer_UTF8 start, const CharPointer_UTF8 end ): String( StringHolder::createFromCharPointer( start, end ) ) {}
+String::String ( const CharPointer_UTF16 start, const CharPointer_UTF16 end ): String( StringHolder::createFromCharPointer( start, end ) ) {}
+String::String ( const CharPointer_UTF32 start, const CharPointer_UTF32 end ): String( StringHolder::createFromCharPointer( start, end ) ) {}
 
-String::String ( const std::string& s ): text( StringHolder::createFromFixedLength( s.data(), s.size() ) ) {}
+String::String ( const std::string& s ): String( StringHolder::createFromFixedLength( s.data(), s.size() ) ) {}
 
 String String::charToString( const treecore_wchar character )
 {
     String result( PreallocationBytes( CharPointerType::getBytesRequiredFor( character ) ) );
-    CharPointerType t( result.text );
+    CharPointerType t( result.text() );
     t.write( character );
     t.writeNull();
     return result;
@@ -318,6 +340,14 @@ size_t StackArrayStream::writeDouble( double n, int numDecPlaces )
 
 char* doubleToString( char* buffer, const int numChars, double n, int numDecPlaces, size_t& len ) noexcept
 {
+    if (numDecPlaces <= 0)
+    {
+        treecore_assert( numChars > FORMAT_FLOAT_MAX_CHARS );
+        len = format_double_shortest( buffer, n );
+        buffer[len] = 0;
+        return buffer;
+    }
+
     if (numDecPlaces > 0 && numDecPlaces < 7 && n > -1.0e20 && n < 1.0e20)
     {
         char* const end = buffer + numChars;
@@ -349,7 +379,7 @@ char* doubleToString( char* buffer, const int numChars, double n, int numDecPlac
     return buffer;
 }
 
-String::CharPointerType createFromDouble( const double number, const int numberOfDecimalPlaces )
+String createFromDouble( const double number, const int numberOfDecimalPlaces )
 {
     char buffer [charsNeededForDouble];
     size_t len;
@@ -357,25 +387,31 @@ String::CharPointerType createFromDouble( const double number, const int numberO
     return StringHolder::createFromFixedLength( start, len );
 }
 
+String createFromFloat( const float number )
+{
+    char buffer [FORMAT_FLOAT_MAX_CHARS];
+    return StringHolder::createFromFixedLength( buffer, format_float_shortest( buffer, number ) );
+}
+
 } // namespace NumberToStringConverters
 
 //==============================================================================
-String::String ( const int number ): text( NumberToStringConverters::createFromInteger( number ) ) {}
-String::String ( const unsigned int number ): text( NumberToStringConverters::createFromInteger( number ) ) {}
-String::String ( const short number ): text( NumberToStringConverters::createFromInteger( (int)number ) ) {}
-String::String ( const unsigned short number ): text( NumberToStringConverters::createFromInteger( (unsigned int)number ) ) {}
-String::String ( const int64 number ): text( NumberToStringConverters::createFromInteger( number ) ) {}
-String::String ( const uint64 number ): text( NumberToStringConverters::createFromInteger( number ) ) {}
-
-String::String ( const float number ): text( NumberToStringConverters::createFromDouble( (double)number, 0 ) ) {}
-String::String ( const double number ): text( NumberToStringConverters::createFromDouble( number, 0 ) ) {}
-String::String ( const float number, const int numberOfDecimalPlaces ): text( NumberToStringConverters::createFromDouble( (double)number, numberOfDecimalPlaces ) ) {}
-String::String ( const double number, const int numberOfDecimalPlaces ): text( NumberToStringConverters::createFromDouble( number, numberOfDecimalPlaces ) ) {}
+String::String ( const int number ): String( NumberToStringConverters::createFromInteger( number ) ) {}
+String::String ( const unsigned int number ): String( NumberToStringConverters::createFromInteger( number ) ) {}
+String::String ( const short number ): String( NumberToStringConverters::createFromInteger( (int)number ) ) {}
+String::String ( const unsigned short number ): String( NumberToStringConverters::createFromInteger( (unsigned int)number ) ) {}
+String::String ( const int64 number ): String( NumberToStringConverters::createFromInteger( number ) ) {}
+String::String ( const uint64 number ): String( NumberToStringConverters::createFromInteger( number ) ) {}
+
+String::String ( const float number ): String( NumberToStringConverters::createFromFloat( number ) ) {}
+String::String ( const double number ): String( NumberToStringConverters::createFromDouble( number, 0 ) ) {}
+String::String ( const float number, const int numberOfDecimalPlaces ): String( NumberToStringConverters::createFromDouble( (double)number, numberOfDecimalPlaces ) ) {}
+String::String ( const double number, const int numberOfDecimalPlaces ): String( NumberToStringConverters::createFromDouble( number, numberOfDecimalPlaces ) ) {}
 
 //==============================================================================
 int String::length() const noexcept
 {
-    return (int) text.length();
+    return (int) text().length();
 }
 
 static size_t findByteOffsetOfEnd( String::CharPointerType text ) noexcept
@@ -385,13 +421,13 @@ static size_t findByteOffsetOfEnd( String::CharPointerType text ) noexcept
 
 size_t String::getByteOffsetOfEnd() const noexcept
 {
-    return findByteOffsetOfEnd( text );
+    return findByteOffsetOfEnd( text() );
 }
 
 treecore_wchar String::operator [] ( int index ) const noexcept
 {
-    treecore_assert( index == 0 || ( index > 0 && index <= (int) text.lengthUpTo( (size_t) index + 1 ) ) );
-    return text [index];
+    treecore_assert( index == 0 || ( index > 0 && index <= (int) text().lengthUpTo( (size_t) index + 1 ) ) );
+    return text() [index];
 }
 
 template<typename Type>
@@ -411,9 +447,9 @@ struct HashGenerator
     enum { multiplier = sizeof(Type) > 4 ? 101 : 31 };
 };
 
-int String::hashCode() const noexcept       { return HashGenerator<int>        ::calculate( text ); }
-int64 String::hashCode64() const noexcept   { return HashGenerator<int64>      ::calculate( text ); }
-std::size_t String::hash() const noexcept   { return HashGenerator<std::size_t>::calculate( text ); }
+int String::hashCode() const noexcept       { return HashGenerator<int>        ::calculate( text() ); }
+int64 String::hashCode64() const noexcept   { return HashGenerator<int64>      ::calculate( text() ); }
+std::size_t String::hash() const noexcept   { return HashGenerator<std::size_t>::calculate( text() ); }
 
 //==============================================================================
 TREECORE_SHARED_API bool TREECORE_STDCALL operator == ( const String& s1, const String& s2 ) noexcept            { return s1.compare( s2 ) == 0; }
@@ -437,135 +473,41 @@ TREECORE_SHARED_API bool TREECORE_STDCALL operator <= ( const String& s1, const
 
 bool String::equalsIgnoreCase( const wchar_t* const t ) const noexcept
 {
-    return t != nullptr ? text.compareIgnoreCase( castToCharPointer_wchar_t( t ) ) == 0
+    return t != nullptr ? text().compareIgnoreCase( castToCharPointer_wchar_t( t ) ) == 0
            : isEmpty();
 }
 
 bool String::equalsIgnoreCase( const char* const t ) const noexcept
 {
-    return t != nullptr ? text.compareIgnoreCase( CharPointer_UTF8( t ) ) == 0
+    return t != nullptr ? text().compareIgnoreCase( CharPointer_UTF8( t ) ) == 0
            : isEmpty();
 }
 
 bool String::equalsIgnoreCase( StringRef t ) const noexcept
 {
-    return text.compareIgnoreCase( t.text ) == 0;
+    return text().compareIgnoreCase( t.text ) == 0;
 }
 
 bool String::equalsIgnoreCase( const String& other ) const noexcept
 {
-    return text == other.text
-           || text.compareIgnoreCase( other.text ) == 0;
+    return text() == other.text()
+           || text().compareIgnoreCase( other.text() ) == 0;
 }
 
-int String::compare( const String& other ) const noexcept           { return (text == other.text) ? 0 : text.compare( other.text ); }
-int String::compare( const char* const other ) const noexcept       { return text.compare( CharPointer_UTF8( other ) ); }
-int String::compare( const wchar_t* const other ) const noexcept    { return text.compare( castToCharPointer_wchar_t( other ) ); }
-int String::compareIgnoreCase( const String& other ) const noexcept { return (text == other.text) ? 0 : text.compareIgnoreCase( other.text ); }
-
-static int stringCompareRight( String::CharPointerType s1, String::CharPointerType s2 ) noexcept
-{
-    for (int bias = 0;; )
-    {
-        const treecore_wchar c1 = s1.getAndAdvance();
-        const bool isDigit1 = CharacterFunctions::isDigit( c1 );
-
-        const treecore_wchar c2 = s2.getAndAdvance();
-        const bool isDigit2 = CharacterFunctions::isDigit( c2 );
-
-        if ( !(isDigit1 || isDigit2) )   return bias;
-        if (!isDigit1)                 return -1;
-        if (!isDigit2)                 return 1;
-
-        if (c1 != c2 && bias == 0)
-            bias = c1 < c2 ? -1 : 1;
-
-        treecore_assert( c1 != 0 && c2 != 0 );
-    }
-}
-
-static int stringCompareLeft( String::CharPointerType s1, String::CharPointerType s2 ) noexcept
-{
-    for (;; )
-    {
-        const treecore_wchar c1 = s1.getAndAdvance();
-        const bool isDigit1 = CharacterFunctions::isDigit( c1 );
-
-        const treecore_wchar c2 = s2.getAndAdvance();
-        const bool isDigit2 = CharacterFunctions::isDigit( c2 );
-
-        if ( !(isDigit1 || isDigit2) )   return 0;
-        if (!isDigit1)                 return -1;
-        if (!isDigit2)                 return 1;
-        if (c1 < c2)                    return -1;
-        if (c1 > c2)                    return 1;
-    }
-}
-
-static int naturalStringCompare( String::CharPointerType s1, String::CharPointerType s2 ) noexcept
-{
-    bool firstLoop = true;
-
-    for (;; )
-    {
-        const bool hasSpace1 = s1.isWhitespace();
-        const bool hasSpace2 = s2.isWhitespace();
-
-        if ( (!firstLoop) && (hasSpace1 ^ hasSpace2) )
-            return hasSpace2 ? 1 : -1;
-
-        firstLoop = false;
-
-        if (hasSpace1)  s1 = s1.findEndOfWhitespace();
-        if (hasSpace2)  s2 = s2.findEndOfWhitespace();
-
-        if ( s1.isDigit() && s2.isDigit() )
-        {
-            const int result = (*s1 == '0' || *s2 == '0') ? stringCompareLeft( s1, s2 )
-                               : stringCompareRight( s1, s2 );
-
-            if (result != 0)
-                return result;
-        }
-
-        treecore_wchar c1 = s1.getAndAdvance();
-        treecore_wchar c2 = s2.getAndAdvance();
-
-        if (c1 != c2)
-        {
-            c1 = CharacterFunctions::toUpperCase( c1 );
-            c2 = CharacterFunctions::toUpperCase( c2 );
-        }
-
-        if (c1 == c2)
-        {
-            if (c1 == 0)
-                return 0;
-        }
-        else
-        {
-            const bool isAlphaNum1 = CharacterFunctions::isLetterOrDigit( c1 );
-            const bool isAlphaNum2 = CharacterFunctions::isLetterOrDigit( c2 );
-
-            if (isAlphaNum2 && !isAlphaNum1) return -1;
-            if (isAlphaNum1 && !isAlphaNum2) return 1;
-
-            return c1 < c2 ? -1 : 1;
-        }
-
-        treecore_assert( c1 != 0 && c2 != 0 );
-    }
-}
+int String::compare( const String& other ) const noexcept           { return (text() == other.text()) ? 0 : text().compare( other.text() ); }
+int String::compare( const char* const other ) const noexcept       { return text().compare( CharPointer_UTF8( other ) ); }
+int String::compare( const wchar_t* const other ) const noexcept    { return text().compare( castToCharPointer_wchar_t( other ) ); }
+int String::compareIgnoreCase( const String& other ) const noexcept { return (text() == other.text()) ? 0 : text().compareIgnoreCase( other.text() ); }
 
 int String::compareNatural( StringRef other ) const noexcept
 {
-    return naturalStringCompare( getCharPointer(), other.text );
+    return compare_natural( text().getAddress(), other.text.getAddress() );
 }
 
 //==============================================================================
 void String::append( const String& textToAppend, size_t maxCharsToTake )
 {
-    appendCharPointer( textToAppend.text, maxCharsToTake );
+    appendCharPointer( textToAppend.text(), maxCharsToTake );
 }
 
 void String::appendCharPointer( const CharPointerType textToAppend )
@@ -587,7 +529,7 @@ void String::appendCharPointer( const CharPointerType startOfTextToAppend,
         const size_t byteOffsetOfNull = getByteOffsetOfEnd();
         preallocateBytes( byteOffsetOfNull + (size_t) extraBytesNeeded );
 
-        CharPointerType::CharType* const newStringStart = addBytesToPointer( text.getAddress(), (int) byteOffsetOfNull );
+        CharPointerType::CharType* const newStringStart = addBytesToPointer( text().getAddress(), (int) byteOffsetOfNull );
         memcpy( newStringStart, startOfTextToAppend.getAddress(), (size_t) extraBytesNeeded );
         CharPointerType( addBytesToPointer( newStringStart, extraBytesNeeded ) ).writeNull();
     }
@@ -610,7 +552,11 @@ String& String::operator += ( const String& other )
     if ( isEmpty() )
         return operator = ( other );
 
-    appendCharPointer( other.text );
+    // appending may move inline text of other into a holder
+    if (this == &other)
+        return operator += ( String( *this ) );
+
+    appendCharPointer( other.text() );
     return *this;
 }
 
@@ -709,12 +655,12 @@ TREECORE_SHARED_API String& TREECORE_STDCALL operator << ( String& string1, cons
 //==============================================================================
 int String::indexOfChar( const treecore_wchar character ) const noexcept
 {
-    return text.indexOf( character );
+    return text().indexOf( character );
 }
 
 int String::indexOfChar( const int startIndex, const treecore_wchar character ) const noexcept
 {
-    CharPointerType t( text );
+    CharPointerType t( text() );
 
     for (int i = 0; !t.isEmpty(); ++i)
     {
@@ -734,7 +680,7 @@ int String::indexOfChar( const int startIndex, const treecore_wchar character )
 
 int String::lastIndexOfChar( const treecore_wchar character ) const noexcept
 {
-    CharPointerType t( text );
+    CharPointerType t( text() );
     int last = -1;
 
     for (int i = 0; !t.isEmpty(); ++i)
@@ -746,7 +692,7 @@ int String::lastIndexOfChar( const treecore_wchar character ) const noexcept
 
 int String::indexOfAnyOf( StringRef charactersToLookFor, const int startIndex, const bool ignoreCase ) const noexcept
 {
-    CharPointerType t( text );
+    CharPointerType t( text() );
 
     for (int i = 0; !t.isEmpty(); ++i)
     {
@@ -766,12 +712,12 @@ int String::indexOfAnyOf( StringRef charactersToLookFor, const int startIndex, c
 
 int String::indexOf( StringRef other ) const noexcept
 {
-    return other.isEmpty() ? 0 : text.indexOf( other.text );
+    return other.isEmpty() ? 0 : text().indexOf( other.text );
 }
 
 int String::indexOfIgnoreCase( StringRef other ) const noexcept
 {
-    return other.isEmpty() ? 0 : CharacterFunctions::indexOfIgnoreCase( text, other.text );
+    return other.isEmpty() ? 0 : CharacterFunctions::indexOfIgnoreCase( text(), other.text );
 }
 
 int String::indexOf( const int startIndex, StringRef other ) const noexcept
@@ -779,7 +725,7 @@ int String::indexOf( const int startIndex, StringRef other ) const noexcept
     if ( other.isEmpty() )
         return -1;
 
-    CharPointerType t( text );
+    CharPointerType t( text() );
 
     for (int i = startIndex; --i >= 0; )
     {
@@ -800,7 +746,7 @@ int String::indexOfIgnoreCase( const int startIndex, StringRef other ) const noe
     if ( other.isEmpty() )
         return -1;
 
-    CharPointerType t( text );
+    CharPointerType t( text() );
 
     for (int i = startIndex; --i >= 0; )
     {
@@ -825,7 +771,7 @@ int String::lastIndexOf( StringRef other ) const noexcept
 
         if (i >= 0)
         {
-            for (CharPointerType n( text + i ); i >= 0; --i)
+            for (CharPointerType n( text() + i ); i >= 0; --i)
             {
                 if (n.compareUpTo( other.text, len ) == 0)
                     return i;
@@ -847,7 +793,7 @@ int String::lastIndexOfIgnoreCase( StringRef other ) const noexcept
 
         if (i >= 0)
         {
-            for (CharPointerType n( text + i ); i >= 0; --i)
+            for (CharPointerType n( text() + i ); i >= 0; --i)
             {
                 if (n.compareIgnoreCaseUpTo( other.text, len ) == 0)
                     return i;
@@ -862,7 +808,7 @@ int String::lastIndexOfIgnoreCase( StringRef other ) const noexcept
 
 int String::lastIndexOfAnyOf( StringRef charactersToLookFor, const bool ignoreCase ) const noexcept
 {
-    CharPointerType t( text );
+    CharPointerType t( text() );
     int last = -1;
 
     for (int i = 0; !t.isEmpty(); ++i)
@@ -879,7 +825,7 @@ bool String::contains( StringRef other ) const noexcept
 
 bool String::containsChar( const treecore_wchar character ) const noexcept
 {
-    return text.indexOf( character ) >= 0;
+    return text().indexOf( character ) >= 0;
 }
 
 bool String::containsIgnoreCase( StringRef t ) const noexcept
@@ -891,7 +837,7 @@ int String::indexOfWholeWord( StringRef word ) const noexcept
 {
     if ( word.isNotEmpty() )
     {
-        CharPointerType t( text );
+        CharPointerType t( text() );
         const int wordLen = word.length();
         const int end = (int) t.length() - wordLen;
 
@@ -913,7 +859,7 @@ int String::indexOfWholeWordIgnoreCase( StringRef word ) const noexcept
 {
     if ( word.isNotEmpty() )
     {
-        CharPointerType t( text );
+        CharPointerType t( text() );
         const int wordLen = word.length();
         const int end = (int) t.length() - wordLen;
 
@@ -980,7 +926,7 @@ struct WildCardMatcher
 
 bool String::matchesWildcard( StringRef wildcard, const bool ignoreCase ) const noexcept
 {
-    return WildCardMatcher<CharPointerType>::matches( wildcard.text, text, ignoreCase );
+    return WildCardMatcher<CharPointerType>::matches( wildcard.text, text(), ignoreCase );
 }
 
 //==============================================================================
@@ -990,7 +936,7 @@ String String::repeatedString( StringRef stringToRepeat, int numberOfTimesToRepe
         return String();
 
     String result( PreallocationBytes( findByteOffsetOfEnd( stringToRepeat ) * (size_t) numberOfTimesToRepeat ) );
-    CharPointerType n( result.text );
+    CharPointerType n( result.text() );
 
     while (--numberOfTimesToRepeat >= 0)
         n.writeAll( stringToRepeat.text );
@@ -1003,7 +949,7 @@ String String::paddedLeft( const treecore_wchar padCharacter, int minimumLength
     treecore_assert( padCharacter != 0 );
 
     int extraChars = minimumLength;
-    CharPointerType end( text );
+    CharPointerType end( text() );
 
     while ( !end.isEmpty() )
     {
@@ -1014,14 +960,14 @@ String String::paddedLeft( const treecore_wchar padCharacter, int minimumLength
     if (extraChars <= 0 || padCharacter == 0)
         return *this;
 
-    const size_t currentByteSize = (size_t) ( ( (char*) end.getAddress() ) - (char*) text.getAddress() );
+    const size_t currentByteSize = (size_t) ( ( (char*) end.getAddress() ) - (char*) text().getAddress() );
     String result( PreallocationBytes( currentByteSize + (size_t) extraChars * CharPointerType::getBytesRequiredFor( padCharacter ) ) );
-    CharPointerType n( result.text );
+    CharPointerType n( result.text() );
 
     while (--extraChars >= 0)
         n.write( padCharacter );
 
-    n.writeAll( text );
+    n.writeAll( text() );
     return result;
 }
 
@@ -1030,7 +976,7 @@ String String::paddedRight( const treecore_wchar padCharacter, int minimumLength
     treecore_assert( padCharacter != 0 );
 
     int extraChars = minimumLength;
-    CharPointerType end( text );
+    CharPointerType end( text() );
 
     while ( !end.isEmpty() )
     {
@@ -1041,11 +987,11 @@ String String::paddedRight( const treecore_wchar padCharacter, int minimumLength
     if (extraChars <= 0 || padCharacter == 0)
         return *this;
 
-    const size_t currentByteSize = (size_t) ( ( (char*) end.getAddress() ) - (char*) text.getAddress() );
+    const size_t currentByteSize = (size_t) ( ( (char*) end.getAddress() ) - (char*) text().getAddress() );
     String result( PreallocationBytes( currentByteSize + (size_t) extraChars * CharPointerType::getBytesRequiredFor( padCharacter ) ) );
-    CharPointerType n( result.text );
+    CharPointerType n( result.text() );
 
-    n.writeAll( text );
+    n.writeAll( text() );
 
     while (--extraChars >= 0)
         n.write( padCharacter );
@@ -1071,7 +1017,7 @@ String String::replaceSection( int index, int numCharsToReplace, StringRef strin
         treecore_assert_false;
     }
 
-    CharPointerType insertPoint( text );
+    CharPointerType insertPoint( text() );
 
     for (int i = 0; i < index; ++i)
     {
@@ -1090,10 +1036,10 @@ String String::replaceSection( int index, int numCharsToReplace, StringRef strin
     for (int i = 0; i < numCharsToReplace && !startOfRemainder.isEmpty(); ++i)
         ++startOfRemainder;
 
-    if ( insertPoint == text && startOfRemainder.isEmpty() )
+    if ( insertPoint == text() && startOfRemainder.isEmpty() )
         return stringToInsert.text;
 
-    const size_t initialBytes   = (size_t) ( ( (char*) insertPoint.getAddress() ) - (char*) text.getAddress() );
+    const size_t initialBytes   = (size_t) ( ( (char*) insertPoint.getAddress() ) - (char*) text().getAddress() );
     const size_t newStringBytes = findByteOffsetOfEnd( stringToInsert );
     const size_t remainderBytes = (size_t) ( ( (char*) startOfRemainder.findTerminatingNull().getAddress() ) - (char*) startOfRemainder.getAddress() );
 
@@ -1103,8 +1049,8 @@ String String::replaceSection( int index, int numCharsToReplace, StringRef strin
 
     String result( PreallocationBytes( (size_t) newTotalBytes ) );
 
-    char* dest = (char*) result.text.getAddress();
-    memcpy( dest,             text.getAddress(),      initialBytes );
+    char* dest = (char*) result.text().getAddress();
+    memcpy( dest,             text().getAddress(),      initialBytes );
     dest += initialBytes;
     memcpy( dest,   stringToInsert.text.getAddress(), newStringBytes );
     dest += newStringBytes;
@@ -1144,7 +1090,7 @@ public:
     }
 
     StringCreationHelper ( const String::CharPointerType s )
-        : source( s ), dest( nullptr ), allocatedBytes( StringHolder::getAllocatedNumBytes( s ) ), bytesWritten( 0 )
+        : source( s ), dest( nullptr ), allocatedBytes( findByteOffsetOfEnd( s ) + sizeof(String::CharPointerType::CharType) ), bytesWritten( 0 )
     {
         result.preallocateBytes( allocatedBytes );
         dest = result.getCharPointer();
@@ -1152,23 +1098,37 @@ public:
 
     void write( treecore_wchar c )
     {
-        bytesWritten += String::CharPointerType::getBytesRequiredFor( c );
+        reserve( String::CharPointerType::getBytesRequiredFor( c ) );
+        dest.write( c );
+    }
+
+    // copies numBytes of ASCII from source through a bulk conversion such as
+    // utf8_ascii_to_lower(), and moves source after them
+    void writeAscii( const size_t numBytes, void (*convert)( char*, const char*, size_t ) )
+    {
+        reserve( numBytes );
+        convert( dest.getAddress(), source.getAddress(), numBytes );
+        dest   = String::CharPointerType( dest.getAddress() + numBytes );
+        source = String::CharPointerType( source.getAddress() + numBytes );
+    }
+
+    String result;
+    String::CharPointerType source;
+
+private:
+    void reserve( const size_t numBytes )
+    {
+        bytesWritten += numBytes;
 
         if (bytesWritten > allocatedBytes)
         {
-            allocatedBytes += jmax( (size_t) 8, allocatedBytes / 16 );
+            allocatedBytes += jmax( (size_t) 8, allocatedBytes / 16, numBytes );
             const size_t destOffset = (size_t) ( ( (char*) dest.getAddress() ) - (char*) result.getCharPointer().getAddress() );
             result.preallocateBytes( allocatedBytes );
             dest = addBytesToPointer( result.getCharPointer().getAddress(), (int) destOffset );
         }
-
-        dest.write( c );
     }
 
-    String result;
-    String::CharPointerType source;
-
-private:
     String::CharPointerType dest;
     size_t allocatedBytes, bytesWritten;
 };
@@ -1178,7 +1138,7 @@ String String::replaceCharacter( const treecore_wchar charToReplace, const treec
     if ( !containsChar( charToReplace ) )
         return *this;
 
-    StringCreationHelper builder( text );
+    StringCreationHelper builder( text() );
 
     for (;; )
     {
@@ -1198,7 +1158,7 @@ String String::replaceCharacter( const treecore_wchar charToReplace, const treec
 
 String String::replaceCharacters( StringRef charactersToReplace, StringRef charactersToInsertInstead ) const
 {
-    StringCreationHelper builder( text );
+    StringCreationHelper builder( text() );
 
     for (;; )
     {
@@ -1220,38 +1180,38 @@ String String::replaceCharacters( StringRef charactersToReplace, StringRef chara
 //==============================================================================
 bool String::startsWith( StringRef other ) const noexcept
 {
-    return text.compareUpTo( other.text, other.length() ) == 0;
+    return text().compareUpTo( other.text, other.length() ) == 0;
 }
 
 bool String::startsWithIgnoreCase( StringRef other ) const noexcept
 {
-    return text.compareIgnoreCaseUpTo( other.text, other.length() ) == 0;
+    return text().compareIgnoreCaseUpTo( other.text, other.length() ) == 0;
 }
 
 bool String::startsWithChar( const treecore_wchar character ) const noexcept
 {
     treecore_assert( character != 0 ); // strings can't contain a null character!
 
-    return *text == character;
+    return *text() == character;
 }
 
 bool String::endsWithChar( const treecore_wchar character ) const noexcept
 {
     treecore_assert( character != 0 ); // strings can't contain a null character!
 
-    if ( text.isEmpty() )
+    if ( text().isEmpty() )
         return false;
 
-    CharPointerType t( text.findTerminatingNull() );
+    CharPointerType t( text().findTerminatingNull() );
     return *--t == character;
 }
 
 bool String::endsWith( StringRef other ) const noexcept
 {
-    CharPointerType end( text.findTerminatingNull() );
+    CharPointerType end( text().findTerminatingNull() );
     CharPointerType otherEnd( other.text.findTerminatingNull() );
 
-    while (end > text && otherEnd > other.text)
+    while (end > text() && otherEnd > other.text)
     {
         --end;
         --otherEnd;
@@ -1265,10 +1225,10 @@ bool String::endsWith( StringRef other ) const noexcept
 
 bool String::endsWithIgnoreCase( StringRef other ) const noexcept
 {
-    CharPointerType end( text.findTerminatingNull() );
+    CharPointerType end( text().findTerminatingNull() );
     CharPointerType otherEnd( other.text.findTerminatingNull() );
 
-    while (end > text && otherEnd > other.text)
+    while (end > text() && otherEnd > other.text)
     {
         --end;
         --otherEnd;
@@ -1281,13 +1241,20 @@ bool String::endsWithIgnoreCase( StringRef other ) const noexcept
 }
 
 //==============================================================================
-String String::toUpperCase() const
+// Runs of ASCII are converted in bulk, other characters one by one.
+static String changeCase( const String::CharPointerType text, const bool toUpper )
 {
     StringCreationHelper builder( text );
+    const char* const end = text.getAddress() + std::strlen( text.getAddress() );
 
     for (;; )
     {
-        const treecore_wchar c = builder.source.toUpperCase();
+        const size_t numAscii = utf8_ascii_prefix_length( builder.source.getAddress(), (size_t) ( end - builder.source.getAddress() ) );
+
+        if (numAscii > 0)
+            builder.writeAscii( numAscii, toUpper ? utf8_ascii_to_upper : utf8_ascii_to_lower );
+
+        const treecore_wchar c = toUpper ? builder.source.toUpperCase() : builder.source.toLowerCase();
         builder.write( c );
 
         if (c == 0)
@@ -1299,28 +1266,20 @@ String String::toUpperCase() const
     return builder.result;
 }
 
-String String::toLowerCase() const
+String String::toUpperCase() const
 {
-    StringCreationHelper builder( text );
-
-    for (;; )
-    {
-        const treecore_wchar c = builder.source.toLowerCase();
-        builder.write( c );
-
-        if (c == 0)
-            break;
-
-        ++(builder.source);
-    }
+    return changeCase( text(), true );
+}
 
-    return builder.result;
+String String::toLowerCase() const
+{
+    return changeCase( text(), false );
 }
 
 //==============================================================================
 treecore_wchar String::getLastCharacter() const noexcept
 {
-    return isEmpty() ? treecore_wchar() : text [length() - 1];
+    return isEmpty() ? treecore_wchar() : text() [length() - 1];
 }
 
 String String::substring( int start, const int end ) const
@@ -1332,7 +1291,7 @@ String String::substring( int start, const int end ) const
         return String();
 
     int i = 0;
-    CharPointerType t1( text );
+    CharPointerType t1( text() );
 
     while (i < start)
     {
@@ -1366,7 +1325,7 @@ String String::substring( int start ) const
     if (start <= 0)
         return *this;
 
-    CharPointerType t( text );
+    CharPointerType t( text() );
 
     while (--start >= 0)
     {
@@ -1381,12 +1340,12 @@ String String::substring( int start ) const
 
 String String::dropLastCharacters( const int numberToDrop ) const
 {
-    return String( text, (size_t) jmax( 0, length() - numberToDrop ) );
+    return String( text(), (size_t) jmax( 0, length() - numberToDrop ) );
 }
 
 String String::getLastCharacters( const int numCharacters ) const
 {
-    return String( text + jmax( 0, length() - jmax( 0, numCharacters ) ) );
+    return String( text() + jmax( 0, length() - jmax( 0, numCharacters ) ) );
 }
 
 String String::fromFirstOccurrenceOf( StringRef  sub,
@@ -1452,8 +1411,8 @@ String String::unquoted() const
     if (len == 0)
         return String();
 
-    const treecore_wchar lastChar = text [len - 1];
-    const int dropAtStart = (*text == '"' || *text == '\'') ? 1 : 0;
+    const treecore_wchar lastChar = text() [len - 1];
+    const int dropAtStart = (*text() == '"' || *text() == '\'') ? 1 : 0;
     const int dropAtEnd   = (lastChar == '"' || lastChar == '\'') ? 1 : 0;
 
     return substring( dropAtStart, len - dropAtEnd );
@@ -1495,7 +1454,7 @@ String String::trim() const
 {
     if ( isNotEmpty() )
     {
-        CharPointerType start( text.findEndOfWhitespace() );
+        CharPointerType start( text().findEndOfWhitespace() );
 
         const CharPointerType end( start.findTerminatingNull() );
         CharPointerType trimmedEnd( findTrimmedEnd( start, end ) );
@@ -1503,7 +1462,7 @@ String String::trim() const
         if (trimmedEnd <= start)
             return String();
 
-        if (text < start || trimmedEnd < end)
+        if (text() < start || trimmedEnd < end)
             return String( start, trimmedEnd );
     }
 
@@ -1514,9 +1473,9 @@ String String::trimStart() const
 {
     if ( isNotEmpty() )
     {
-        const CharPointerType t( text.findEndOfWhitespace() );
+        const CharPointerType t( text().findEndOfWhitespace() );
 
-        if (t != text)
+        if (t != text())
             return String( t );
     }
 
@@ -1527,11 +1486,11 @@ String String::trimEnd() const
 {
     if ( isNotEmpty() )
     {
-        const CharPointerType end( text.findTerminatingNull() );
-        CharPointerType trimmedEnd( findTrimmedEnd( text, end ) );
+        const CharPointerType end( text().findTerminatingNull() );
+        CharPointerType trimmedEnd( findTrimmedEnd( text(), end ) );
 
         if (trimmedEnd < end)
-            return String( text, trimmedEnd );
+            return String( text(), trimmedEnd );
     }
 
     return *this;
@@ -1539,22 +1498,22 @@ String String::trimEnd() const
 
 String String::trimCharactersAtStart( StringRef charactersToTrim ) const
 {
-    CharPointerType t( text );
+    CharPointerType t( text() );
 
     while (charactersToTrim.text.indexOf( *t ) >= 0)
         ++t;
 
-    return t == text ? *this : String( t );
+    return t == text() ? *this : String( t );
 }
 
 String String::trimCharactersAtEnd( StringRef charactersToTrim ) const
 {
     if ( isNotEmpty() )
     {
-        const CharPointerType end( text.findTerminatingNull() );
+        const CharPointerType end( text().findTerminatingNull() );
         CharPointerType trimmedEnd( end );
 
-        while (trimmedEnd > text)
+        while (trimmedEnd > text())
         {
             if (charactersToTrim.text.indexOf( *--trimmedEnd ) < 0)
             {
@@ -1564,7 +1523,7 @@ String String::trimCharactersAtEnd( StringRef charactersToTrim ) const
         }
 
         if (trimmedEnd < end)
-            return String( text, trimmedEnd );
+            return String( text(), trimmedEnd );
     }
 
     return *this;
@@ -1576,7 +1535,7 @@ String String::retainCharacters( StringRef charactersToRetain ) const
     if ( isEmpty() )
         return String();
 
-    StringCreationHelper builder( text );
+    StringCreationHelper builder( text() );
 
     for (;; )
     {
@@ -1598,7 +1557,7 @@ String String::removeCharacters( StringRef charactersToRemove ) const
     if ( isEmpty() )
         return String();
 
-    StringCreationHelper builder( text );
+    StringCreationHelper builder( text() );
 
     for (;; )
     {
@@ -1616,25 +1575,25 @@ String String::removeCharacters( StringRef charactersToRemove ) const
 
 String String::initialSectionContainingOnly( StringRef permittedCharacters ) const
 {
-    for (CharPointerType t( text ); !t.isEmpty(); ++t)
+    for (CharPointerType t( text() ); !t.isEmpty(); ++t)
         if (permittedCharacters.text.indexOf( *t ) < 0)
-            return String( text, t );
+            return String( text(), t );
 
     return *this;
 }
 
 String String::initialSectionNotContaining( StringRef charactersToStopAt ) const
 {
-    for (CharPointerType t( text ); !t.isEmpty(); ++t)
+    for (CharPointerType t( text() ); !t.isEmpty(); ++t)
         if (charactersToStopAt.text.indexOf( *t ) >= 0)
-            return String( text, t );
+            return String( text(), t );
 
     return *this;
 }
 
 bool String::containsOnly( StringRef chars ) const noexcept
 {
-    for (CharPointerType t( text ); !t.isEmpty(); )
+    for (CharPointerType t( text() ); !t.isEmpty(); )
         if (chars.text.indexOf( t.getAndAdvance() ) < 0)
             return false;
 
@@ -1643,7 +1602,7 @@ bool String::containsOnly( StringRef chars ) const noexcept
 
 bool String::containsAnyOf( StringRef chars ) const noexcept
 {
-    for (CharPointerType t( text ); !t.isEmpty(); )
+    for (CharPointerType t( text() ); !t.isEmpty(); )
         if (chars.text.indexOf( t.getAndAdvance() ) >= 0)
             return true;
 
@@ -1652,7 +1611,7 @@ bool String::containsAnyOf( StringRef chars ) const noexcept
 
 bool String::containsNonWhitespaceChars() const noexcept
 {
-    for (CharPointerType t( text ); !t.isEmpty(); ++t)
+    for (CharPointerType t( text() ); !t.isEmpty(); ++t)
         if ( !t.isWhitespace() )
             return true;
 
@@ -1695,18 +1654,18 @@ String String::formatted( const String pf, ... )
 }
 
 //==============================================================================
-int String::getIntValue() const noexcept            { return text.getIntValue32(); }
-int64 String::getLargeIntValue() const noexcept     { return text.getIntValue64(); }
+int String::getIntValue() const noexcept            { return text().getIntValue32(); }
+int64 String::getLargeIntValue() const noexcept     { return text().getIntValue64(); }
 float String::getFloatValue() const noexcept        { return (float) getDoubleValue(); }
-double String::getDoubleValue() const noexcept      { return text.getDoubleValue(); }
+double String::getDoubleValue() const noexcept      { return text().getDoubleValue(); }
 
 int String::getTrailingIntValue() const noexcept
 {
     int n    = 0;
     int mult = 1;
-    CharPointerType t( text.findTerminatingNull() );
+    CharPointerType t( text().findTerminatingNull() );
 
-    while (--t >= text)
+    while (--t >= text())
     {
         if ( !t.isDigit() )
         {
@@ -1760,24 +1719,27 @@ String String::toHexString( const void* const d, const int size, const int group
     String s( PreallocationBytes( sizeof(CharPointerType::CharType) * (size_t) numChars ) );
 
     const unsigned char* data = static_cast<const unsigned char*>(d);
-    CharPointerType dest( s.text );
+    char* dest = s.text().getAddress();
 
-    for (int i = 0; i < size; ++i)
+    // digits are ASCII, so groups are encoded straight into the buffer
+    const int bytesPerGroup = groupSize > 0 ? groupSize : size;
+
+    for (int i = 0; i < size; i += bytesPerGroup)
     {
-        const unsigned char nextByte = *data++;
-        dest.write( (treecore_wchar) hexDigits [nextByte >> 4] );
-        dest.write( (treecore_wchar) hexDigits [nextByte & 0xf] );
+        if (i > 0)
+            *dest++ = ' ';
 
-        if ( groupSize > 0 && (i % groupSize) == (groupSize - 1) && i < (size - 1) )
-            dest.write( (treecore_wchar) ' ' );
+        const int numThisTime = jmin( bytesPerGroup, size - i );
+        hex_encode( data + i, (size_t) numThisTime, dest );
+        dest += numThisTime * 2;
     }
 
-    dest.writeNull();
+    *dest = 0;
     return s;
 }
 
-int String::getHexValue32() const noexcept    { return CharacterFunctions::HexParser<int>  ::parse( text ); }
-int64 String::getHexValue64() const noexcept    { return CharacterFunctions::HexParser<int64>::parse( text ); }
+int String::getHexValue32() const noexcept    { return CharacterFunctions::HexParser<int>  ::parse( text() ); }
+int64 String::getHexValue64() const noexcept    { return CharacterFunctions::HexParser<int64>::parse( text() ); }
 
 //==============================================================================
 String String::createStringFromData( const void* const unknownData, const int size )
@@ -1876,6 +1838,48 @@ struct StringEncodingConverter<CharPointer_UTF32, CharPointer_UTF32>
     static CharPointer_UTF32 convert( const String& source ) noexcept  { return CharPointer_UTF32( (CharPointer_UTF32::CharType*) source.getCharPointer().getAddress() ); }
 };
 
+// UTF-8 text is converted in bulk by UTF8Functions, rather than one character
+// at a time
+template<class CharPointerType_Dest, typename UnitType>
+static CharPointerType_Dest convertUTF8InBulk( const String& s,
+                                               size_t (*getNumUnits)( const char*, size_t ),
+                                               size_t (*convertUnits)( const char*, size_t, UnitType* ) )
+{
+    static_assert( sizeof(typename CharPointerType_Dest::CharType) == sizeof(UnitType), "" );
+
+    String& source = const_cast<String&>(s);
+
+    typedef typename CharPointerType_Dest::CharType DestChar;
+
+    if ( source.isEmpty() )
+        return CharPointerType_Dest( reinterpret_cast<const DestChar*>(&emptyChar) );
+
+    const size_t numSourceBytes = std::strlen( source.getCharPointer().getAddress() );
+    const size_t numUnits  = getNumUnits( source.getCharPointer().getAddress(), numSourceBytes );
+    const size_t endOffset = (numSourceBytes + 1 + 3) & ~3u; // word-aligned, as in StringEncodingConverter
+
+    source.preallocateBytes( endOffset + (numUnits + 1) * sizeof(DestChar) );
+    char* const text = source.getCharPointer().getAddress();
+
+    void* const newSpace = addBytesToPointer( text, (int) endOffset );
+    DestChar* const dest = static_cast<DestChar*>(newSpace);
+    convertUnits( text, numSourceBytes, reinterpret_cast<UnitType*>(dest) );
+    dest[numUnits] = 0;
+    return CharPointerType_Dest( dest );
+}
+
+template<>
+struct StringEncodingConverter<CharPointer_UTF8, CharPointer_UTF16>
+{
+    static CharPointer_UTF16 convert( const String& source )  { return convertUTF8InBulk<CharPointer_UTF16>( source, &utf8_utf16_length, &utf8_to_utf16 ); }
+};
+
+template<>
+struct StringEncodingConverter<CharPointer_UTF8, CharPointer_UTF32>
+{
+    static CharPointer_UTF32 convert( const String& source )  { return convertUTF8InBulk<CharPointer_UTF32>( source, &utf8_utf32_length, &utf8_to_utf32 ); }
+};
+
 CharPointer_UTF8 String::toUTF8()  const { return StringEncodingConverter<CharPointerType, CharPointer_UTF8 >::convert( *this ); }
 CharPointer_UTF16 String::toUTF16() const { return StringEncodingConverter<CharPointerType, CharPointer_UTF16>::convert( *this ); }
 CharPointer_UTF32 String::toUTF32() const { return StringEncodingConverter<CharPointerType, CharPointer_UTF32>::convert( *this ); }
@@ -1913,23 +1917,23 @@ struct StringCopier
 
 size_t String::copyToUTF8( CharPointer_UTF8::CharType* const buffer, size_t maxBufferSizeBytes ) const noexcept
 {
-    return StringCopier<CharPointerType, CharPointer_UTF8>::copyToBuffer( text, buffer, maxBufferSizeBytes );
+    return StringCopier<CharPointerType, CharPointer_UTF8>::copyToBuffer( text(), buffer, maxBufferSizeBytes );
 }
 
 size_t String::copyToUTF16( CharPointer_UTF16::CharType* const buffer, size_t maxBufferSizeBytes ) const noexcept
 {
-    return StringCopier<CharPointerType, CharPointer_UTF16>::copyToBuffer( text, buffer, maxBufferSizeBytes );
+    return StringCopier<CharPointerType, CharPointer_UTF16>::copyToBuffer( text(), buffer, maxBufferSizeBytes );
 }
 
 size_t String::copyToUTF32( CharPointer_UTF32::CharType* const buffer, size_t maxBufferSizeBytes ) const noexcept
 {
-    return StringCopier<CharPointerType, CharPointer_UTF32>::copyToBuffer( text, buffer, maxBufferSizeBytes );
+    return StringCopier<CharPointerType, CharPointer_UTF32>::copyToBuffer( text(), buffer, maxBufferSizeBytes );
 }
 
 //==============================================================================
 size_t String::getNumBytesAsUTF8() const noexcept
 {
-    return CharPointer_UTF8::getBytesRequiredFor( text );
+    return CharPointer_UTF8::getBytesRequiredFor( text() );
 }
 
 String String::fromUTF8( const char* const buffer, int bufferSizeBytes )
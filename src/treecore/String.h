@@ -263,7 +263,7 @@ public:
             const size_t byteOffsetOfNull = getByteOffsetOfEnd();
 
             preallocateBytes( byteOffsetOfNull + extraBytesNeeded );
-            CharPointerType( addBytesToPointer( text.getAddress(), (int) byteOffsetOfNull ) )
+            CharPointerType( addBytesToPointer( text().getAddress(), (int) byteOffsetOfNull ) )
             .writeWithCharLimit( startOfTextToAppend, (int) numChars );
         }
     }
@@ -291,7 +291,7 @@ public:
                 const size_t byteOffsetOfNull = getByteOffsetOfEnd();
 
                 preallocateBytes( byteOffsetOfNull + extraBytesNeeded );
-                CharPointerType( addBytesToPointer( text.getAddress(), (int) byteOffsetOfNull ) )
+                CharPointerType( addBytesToPointer( text().getAddress(), (int) byteOffsetOfNull ) )
                 .writeWithCharLimit( textToAppend, (int) numChars );
             }
         }
@@ -311,13 +311,13 @@ public:
         Note that there's also an isNotEmpty() method to help write readable code.
         @see containsNonWhitespaceChars()
      */
-    inline bool isEmpty() const noexcept                    { return text[0] == 0; }
+    inline bool isEmpty() const noexcept                    { return *text().getAddress() == 0; }
 
     /** Returns true if the string contains at least one character.
         Note that there's also an isEmpty() method to help write readable code.
         @see containsNonWhitespaceChars()
      */
-    inline bool isNotEmpty() const noexcept                 { return text[0] != 0; }
+    inline bool isNotEmpty() const noexcept                 { return *text().getAddress() != 0; }
 
     /** Resets this string to be empty. */
     void clear() noexcept;
@@ -362,6 +362,10 @@ public:
 
         This comparison is case-insensitive and can detect words and embedded numbers in the
         strings, making it good for sorting human-readable lists of things like filenames.
+        Only ASCII characters count as letters, digits or spaces, so the result doesn't
+        depend on the locale.
+
+        @see compare_natural, make_natural_sort_key
 
         @returns     0 if the two strings are identical; negative if this string comes before
                      the other one alphabetically, or positive if it comes after it.
@@ -1056,9 +1060,10 @@ public:
 
         Because it returns a reference to the string's internal data, the pointer
         that is returned must not be stored anywhere, as it can be deleted whenever the
-        string changes.
+        string changes. Short strings are stored inside the String object, so the pointer
+        also becomes invalid when the object is moved or destroyed.
      */
-    inline CharPointerType getCharPointer() const noexcept      { return text; }
+    inline CharPointerType getCharPointer() const noexcept      { return text(); }
 
     /** Returns a pointer to a UTF-8 version of this string.
 
@@ -1229,13 +1234,47 @@ public:
    #endif
 
     /** Returns the number of String objects which are currently sharing the same internal
-        data as this one.
+        data as this one. Short strings are never shared, so this is always 1 for them.
      */
     int getReferenceCount() const noexcept;
 
 private:
+    friend class StringHolder;
+    friend class StringBuilder;
+
     //==============================================================================
-    CharPointerType text;
+    // Strings with less than SSO_BYTES bytes of text are stored inside the object,
+    // and longer ones in a shared StringHolder. The last inline byte is zero for an
+    // inline string, either as padding or as the terminating null when the string
+    // fills the buffer, and HEAP_TAG when the first bytes hold a holder pointer.
+    // Nothing points into the object itself, so a String can still be relocated
+    // with memcpy, as Array does.
+    enum
+    {
+        SSO_BYTES = 16,
+        HEAP_TAG  = 1
+    };
+
+    union Storage
+    {
+        CharPointerType::CharType chars[SSO_BYTES]; // first, so that value-initializing clears all bytes
+        CharPointerType::CharType* heap;
+    };
+
+    Storage m_storage;
+
+    inline bool isInline() const noexcept { return m_storage.chars[SSO_BYTES - 1] == 0; }
+
+    inline CharPointerType text() const noexcept
+    {
+        return CharPointerType( isInline() ? m_storage.chars : m_storage.heap );
+    }
+
+    inline void setHeapText( CharPointerType heapText ) noexcept
+    {
+        m_storage.heap = heapText.getAddress();
+        m_storage.chars[SSO_BYTES - 1] = HEAP_TAG;
+    }
 
     //==============================================================================
     struct PreallocationBytes
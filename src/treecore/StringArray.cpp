@@ -27,7 +27,12 @@
 */
 
 #include "treecore/StringArray.h"
+#include "treecore/StringBuilder.h"
 #include "treecore/StringRef.h"
+#include "treecore/HeapBlock.h"
+#include "treecore/NaturalOrder.h"
+
+#include "treecore/internal/StringSort.h"
 
 namespace treecore {
 
@@ -196,21 +201,11 @@ void StringArray::trim()
 }
 
 //==============================================================================
-struct InternalStringArrayComparator_CaseSensitive
-{
-    static int compareElements (String& s1, String& s2) noexcept    { return s1.compare (s2); }
-};
-
 struct InternalStringArrayComparator_CaseInsensitive
 {
     static int compareElements (String& s1, String& s2) noexcept    { return s1.compareIgnoreCase (s2); }
 };
 
-struct InternalStringArrayComparator_Natural
-{
-    static int compareElements (String& s1, String& s2) noexcept    { return s1.compareNatural (s2); }
-};
-
 void StringArray::sort (const bool ignoreCase)
 {
     if (ignoreCase)
@@ -220,15 +215,55 @@ void StringArray::sort (const bool ignoreCase)
     }
     else
     {
-        InternalStringArrayComparator_CaseSensitive comp;
-        strings.sort (comp);
+        // sort the bytes of each string with a multi-key quicksort, which
+        // is the same order as String::compare(), then move the strings
+        struct SortView
+        {
+            const char* text;
+            size_t numBytes;
+            int index;
+        };
+
+        const int num = strings.size();
+        HeapBlock<SortView> views ((size_t) num);
+
+        for (int i = 0; i < num; ++i)
+        {
+            const String& s = strings[i];
+            views[i] = { s.toRawUTF8(), s.getNumBytesAsUTF8(), i };
+        }
+
+        string_sort (views.getData(), (size_t) num);
+
+        Array<String> sorted;
+        sorted.ensureStorageAllocated (num);
+
+        for (int i = 0; i < num; ++i)
+            sorted.add (std::move (strings[views[i].index]));
+
+        strings.swapWith (sorted);
     }
 }
 
 void StringArray::sortNatural()
 {
-    InternalStringArrayComparator_Natural comp;
-    strings.sort (comp);
+    // sorts precomputed keys instead of comparing the strings themselves
+    const int num = strings.size();
+    HeapBlock<StringSlice> texts ((size_t) num);
+    HeapBlock<int> order ((size_t) num);
+
+    for (int i = 0; i < num; ++i)
+        texts[i] = StringSlice (strings[i]);
+
+    sort_natural_order (texts.getData(), num, order.getData());
+
+    Array<String> sorted;
+    sorted.ensureStorageAllocated (num);
+
+    for (int i = 0; i < num; ++i)
+        sorted.add (std::move (strings[order[i]]));
+
+    strings.swapWith (sorted);
 }
 
 //==============================================================================
@@ -252,25 +287,17 @@ String StringArray::joinIntoString (StringRef separator, int start, int numberTo
     for (int i = start; i < last; ++i)
         bytesNeeded += strings[i].getCharPointer().sizeInBytes() - sizeof (String::CharPointerType::CharType);
 
-    String result;
-    result.preallocateBytes (bytesNeeded);
-
-    String::CharPointerType dest (result.getCharPointer());
+    StringBuilder result (bytesNeeded);
 
     while (start < last)
     {
-        const String& s = strings[start];
-
-        if (! s.isEmpty())
-            dest.writeAll (s.getCharPointer());
+        result.append (strings[start]);
 
         if (++start < last && separatorBytes > 0)
-            dest.writeAll (separator.text);
+            result.append (separator.text.getAddress(), separatorBytes);
     }
 
-    dest.writeNull();
-
-    return result;
+    return result.toString();
 }
 
 int StringArray::addTokens (StringRef text, StringRef breakCharacters, StringRef quoteCharacters)
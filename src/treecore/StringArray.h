@@ -40,7 +40,10 @@ namespace treecore {
 /**
     A special array for holding a list of strings.
 
-    @see Array String
+    To hold millions of strings, such as the lines of a large file, a StringTable
+    uses much less memory.
+
+    @see Array String StringTable
 */
 class TREECORE_SHARED_API  StringArray
 {
@@ -445,7 +448,8 @@ public:
 
     /** Sorts the array using extra language-aware rules to do a better job of comparing
         words containing spaces and numbers.
-        @see String::compareNatural()
+        Each string is turned into a sort key once, so the sort itself only compares bytes.
+        @see String::compareNatural(), make_natural_sort_key()
     */
     void sortNatural();
 
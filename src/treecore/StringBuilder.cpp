@@ -0,0 +1,215 @@
+#include "treecore/StringBuilder.h"
+#include "treecore/MathsFunctions.h"
+#include "treecore/NumberConversion.h"
+
+#include "treecore/internal/String_private.h"
+
+namespace treecore
+{
+
+StringBuilder::StringBuilder( size_t initialCapacity )
+{
+    if (initialCapacity > 0)
+        grow( initialCapacity );
+}
+
+StringBuilder::~StringBuilder()
+{
+    if (m_data != nullptr)
+        StringHolder::release( String::CharPointerType( m_data ) );
+}
+
+void StringBuilder::reserve( size_t numBytes )
+{
+    if (numBytes > m_capacity)
+        grow( numBytes );
+}
+
+void StringBuilder::grow( size_t minCapacity )
+{
+    // double the capacity on each step, so that appending is amortized O(1)
+    const size_t newCapacity = jmax( minCapacity, m_capacity * 2, size_t( 64 ) );
+    char* const newData = StringHolder::createUninitialisedBytes( newCapacity + 1 ).getAddress();
+
+    if (m_data != nullptr)
+    {
+        std::memcpy( newData, m_data, m_numBytes );
+        StringHolder::release( String::CharPointerType( m_data ) );
+    }
+
+    m_data     = newData;
+    m_capacity = newCapacity;
+}
+
+String StringBuilder::toString()
+{
+    // Short text fits into the String itself. Text which leaves more than
+    // half of the buffer unused is copied too, so that the result doesn't
+    // hold on to the spare bytes for as long as it lives. The buffer is then
+    // kept for reuse.
+    if (m_numBytes < String::SSO_BYTES || m_numBytes < m_capacity / 2)
+    {
+        String result( String::PreallocationBytes( (size_t) m_numBytes ) );
+        char* const text = result.text().getAddress();
+
+        if (m_numBytes > 0)
+            std::memcpy( text, m_data, m_numBytes );
+
+        text[m_numBytes] = 0;
+        m_numBytes = 0;
+        return result;
+    }
+
+    m_data[m_numBytes] = 0;
+
+    String result;
+    result.setHeapText( String::CharPointerType( m_data ) );
+
+    m_data     = nullptr;
+    m_numBytes = 0;
+    m_capacity = 0;
+    return result;
+}
+
+//==============================================================================
+template<typename IntegerType>
+static void appendInteger( StringBuilder& builder, IntegerType number )
+{
+    char buffer[NumberToStringConverters::charsNeededForInt];
+    char* const end   = buffer + numElementsInArray( buffer );
+    char* const start = NumberToStringConverters::numberToString( end, number );
+    builder.append( start, size_t( end - start - 1 ) );
+}
+
+StringBuilder& StringBuilder::append( int number )
+{
+    appendInteger( *this, number );
+    return *this;
+}
+
+StringBuilder& StringBuilder::append( unsigned int number )
+{
+    appendInteger( *this, number );
+    return *this;
+}
+
+StringBuilder& StringBuilder::append( int64 number )
+{
+    appendInteger( *this, number );
+    return *this;
+}
+
+StringBuilder& StringBuilder::append( uint64 number )
+{
+    appendInteger( *this, number );
+    return *this;
+}
+
+StringBuilder& StringBuilder::append( double number, int numberOfDecimalPlaces )
+{
+    char buffer[NumberToStringConverters::charsNeededForDouble];
+    size_t len;
+    const char* const start = NumberToStringConverters::doubleToString( buffer, numElementsInArray( buffer ),
+                                                                        number, numberOfDecimalPlaces, len );
+    return append( start, len );
+}
+
+StringBuilder& StringBuilder::append( float number )
+{
+    char buffer[FORMAT_FLOAT_MAX_CHARS];
+    return append( buffer, format_float_shortest( buffer, number ) );
+}
+
+StringBuilder& StringBuilder::appendHex( uint64 number, int minNumDigits )
+{
+    static const char hexDigits[] = "0123456789abcdef";
+
+    char buffer[32];
+    char* const end = buffer + numElementsInArray( buffer );
+    char* t = end;
+
+    minNumDigits = jmin( minNumDigits, int( numElementsInArray( buffer ) ) );
+
+    do
+    {
+        *--t     = hexDigits[number & 15];
+        number >>= 4;
+    }
+    while (number != 0 || end - t < minNumDigits);
+
+    return append( t, size_t( end - t ) );
+}
+
+StringBuilder& StringBuilder::appendUTF8Char( treecore_wchar character )
+{
+    char buffer[8];
+    String::CharPointerType dest( buffer );
+    dest.write( character );
+    return append( buffer, size_t( dest.getAddress() - buffer ) );
+}
+
+StringBuilder& StringBuilder::appendRepeated( char c, size_t numTimes )
+{
+    if (numTimes == 0)
+        return *this;
+
+    if (m_numBytes + numTimes > m_capacity)
+        grow( m_numBytes + numTimes );
+
+    std::memset( m_data + m_numBytes, c, numTimes );
+    m_numBytes += numTimes;
+    return *this;
+}
+
+const char* StringBuilder::appendUntilPlaceholder( const char* pattern )
+{
+    for (;; )
+    {
+        const char* p = pattern;
+
+        while (*p != 0 && *p != '{' && *p != '}')
+            ++p;
+
+        append( pattern, size_t( p - pattern ) );
+
+        if (*p == 0)
+            return nullptr;
+
+        if (p[0] == '{' && p[1] == '}')
+            return p + 2;
+
+        // "{{" and "}}" give one brace, and a lone brace is kept as it is
+        append( *p );
+        pattern = (p[1] == p[0]) ? p + 2 : p + 1;
+    }
+}
+
+//==============================================================================
+bool StringBuilder::setPosition( int64 newPosition )
+{
+    if (newPosition < 0 || newPosition > int64( m_numBytes ))
+        return false;
+
+    m_numBytes = size_t( newPosition );
+    return true;
+}
+
+bool StringBuilder::write( const void* data, size_t numBytes )
+{
+    append( static_cast<const char*>(data), numBytes );
+    return true;
+}
+
+bool StringBuilder::writeByte( char byte )
+{
+    append( byte );
+    return true;
+}
+
+bool StringBuilder::writeRepeatedByte( uint8 byte, size_t numTimesToRepeat )
+{
+    appendRepeated( char( byte ), numTimesToRepeat );
+    return true;
+}
+
+} // namespace treecore
@@ -0,0 +1,220 @@
+#ifndef TREECORE_STRING_BUILDER_H
+#define TREECORE_STRING_BUILDER_H
+
+#include "treecore/DebugUtils.h"
+#include "treecore/OutputStream.h"
+#include "treecore/String.h"
+#include "treecore/StringRef.h"
+
+#include <cstring>
+
+class TestFramework;
+
+namespace treecore
+{
+
+/**
+ * @brief builds a String from many pieces in amortized linear time
+ *
+ * Text is collected in one buffer which grows geometrically, and toString()
+ * hands that buffer over to the result without copying it, unless most of
+ * it is unused. Numbers are formatted straight into the buffer, without
+ * temporary Strings.
+ *
+ * As an OutputStream, a StringBuilder can be passed to anything that writes
+ * text to a stream. Everything written must be UTF-8.
+ *
+ * @code
+ * StringBuilder builder;
+ * builder << "x = " << x << ", ";
+ * builder.format( "{} of {} done", numDone, numTotal );
+ * String result = builder.toString();
+ * @endcode
+ */
+class TREECORE_SHARED_API StringBuilder: public OutputStream
+{
+    friend class ::TestFramework;
+
+public:
+    /**
+     * @param initialCapacity number of bytes which can be appended before
+     *                        the first allocation
+     */
+    explicit StringBuilder( size_t initialCapacity = 0 );
+
+    ~StringBuilder();
+
+    /**
+     * @brief get the number of bytes appended so far
+     */
+    size_t getNumBytes() const noexcept { return m_numBytes; }
+
+    bool isEmpty() const noexcept { return m_numBytes == 0; }
+
+    /**
+     * @brief make sure that numBytes bytes in total can be held without
+     *        reallocating
+     */
+    void reserve( size_t numBytes );
+
+    /**
+     * @brief discard all text, but keep the buffer for reuse
+     */
+    void clear() noexcept { m_numBytes = 0; }
+
+    /**
+     * @brief get all text appended so far, and leave the builder empty
+     *
+     * Text filling at least half of the buffer is not copied: the result
+     * takes over the buffer, and the builder allocates a new one when more
+     * text is appended. Shorter text is copied into a result of its own
+     * size, and the buffer is kept.
+     */
+    String toString();
+
+    //==============================================================================
+    StringBuilder& append( const char* text, size_t numBytes )
+    {
+        treecore_assert( text != nullptr || numBytes == 0 );
+
+        const size_t newNumBytes = m_numBytes + numBytes;
+
+        if (newNumBytes > m_capacity)
+            grow( newNumBytes );
+
+        if (numBytes > 0)
+            std::memcpy( m_data + m_numBytes, text, numBytes );
+
+        m_numBytes = newNumBytes;
+        return *this;
+    }
+
+    StringBuilder& append( char c )
+    {
+        if (m_numBytes == m_capacity)
+            grow( m_numBytes + 1 );
+
+        m_data[m_numBytes++] = c;
+        return *this;
+    }
+
+    StringBuilder& append( const char* text )  { return append( text, std::strlen( text ) ); }
+    StringBuilder& append( StringRef text )    { return append( text.text.getAddress(), text.text.sizeInBytes() - 1 ); }
+    StringBuilder& append( const String& text ) { return append( text.getCharPointer().getAddress() ); }
+
+    StringBuilder& append( int number );
+    StringBuilder& append( unsigned int number );
+    StringBuilder& append( int64 number );
+    StringBuilder& append( uint64 number );
+
+    /**
+     * @brief append a number in the same format as String( double, int )
+     *
+     * @param numberOfDecimalPlaces  if zero, as many places as needed are used
+     */
+    StringBuilder& append( double number, int numberOfDecimalPlaces = 0 );
+
+    /**
+     * @brief append the shortest text which reads back as the same float,
+     *        the same as String( float )
+     */
+    StringBuilder& append( float number );
+
+    /**
+     * @brief append a number in lower-case hexadecimal
+     *
+     * @param minNumDigits  the number is padded with leading zeros to at
+     *                      least this many digits
+     */
+    StringBuilder& appendHex( uint64 number, int minNumDigits = 0 );
+
+    /**
+     * @brief append the UTF-8 encoding of one unicode character
+     */
+    StringBuilder& appendUTF8Char( treecore_wchar character );
+
+    StringBuilder& appendRepeated( char c, size_t numTimes );
+
+    /**
+     * @brief append pattern with each "{}" replaced by the next argument
+     *
+     * Arguments may be of any type accepted by operator<<. "{{" and "}}"
+     * give literal braces. Placeholders without an argument are dropped.
+     *
+     * @code
+     * builder.format( "{}: {} items, {} bytes", name, numItems, numBytes );
+     * @endcode
+     */
+    template<typename... Args>
+    StringBuilder& format( const char* pattern, const Args& ... args )
+    {
+        formatNext( pattern, args ... );
+        return *this;
+    }
+
+    //==============================================================================
+    StringBuilder& operator << ( const char* text )    { return append( text ); }
+    StringBuilder& operator << ( char c )              { return append( c ); }
+    StringBuilder& operator << ( StringRef text )      { return append( text ); }
+    StringBuilder& operator << ( const String& text )  { return append( text ); }
+    StringBuilder& operator << ( int number )          { return append( number ); }
+    StringBuilder& operator << ( unsigned int number ) { return append( number ); }
+    StringBuilder& operator << ( int64 number )        { return append( number ); }
+    StringBuilder& operator << ( uint64 number )       { return append( number ); }
+    StringBuilder& operator << ( float number )        { return append( number ); }
+    StringBuilder& operator << ( double number )       { return append( number ); }
+    StringBuilder& operator << ( const NewLine& )      { return append( getNewLineString() ); }
+
+    //==============================================================================
+    void flush() override {}
+
+    int64 getPosition() override { return int64( m_numBytes ); }
+
+    /**
+     * @brief only moving back is supported, which drops the text after the
+     *        new position
+     */
+    bool setPosition( int64 newPosition ) override;
+
+    bool write( const void* data, size_t numBytes ) override;
+    bool writeByte( char byte ) override;
+    bool writeRepeatedByte( uint8 byte, size_t numTimesToRepeat ) override;
+
+private:
+    void grow( size_t minCapacity );
+
+    // append pattern up to the next placeholder, and return the position
+    // after it, or nullptr if there is none
+    const char* appendUntilPlaceholder( const char* pattern );
+
+    void formatNext( const char* pattern )
+    {
+        while (pattern != nullptr)
+            pattern = appendUntilPlaceholder( pattern );
+    }
+
+    template<typename T, typename... Rest>
+    void formatNext( const char* pattern, const T& arg, const Rest& ... rest )
+    {
+        pattern = appendUntilPlaceholder( pattern );
+
+        // more arguments than placeholders
+        treecore_assert( pattern != nullptr );
+        if (pattern == nullptr)
+            return;
+
+        *this << arg;
+        formatNext( pattern, rest ... );
+    }
+
+    // the text part of a StringHolder, so that toString() can adopt it
+    char*  m_data     = nullptr;
+    size_t m_numBytes = 0;
+    size_t m_capacity = 0; ///< excluding the byte for the terminator
+
+    TREECORE_DECLARE_NON_COPYABLE( StringBuilder )
+};
+
+} // namespace treecore
+
+#endif // TREECORE_STRING_BUILDER_H
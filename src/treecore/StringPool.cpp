@@ -27,33 +27,190 @@
 */
 
 #include "treecore/StringPool.h"
-#include "treecore/Time.h"
+#include "treecore/AtomicFunc.h"
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
 
 namespace treecore {
 
-static const int minNumberOfStringsForGarbageCollection = 300;
-static const uint32 garbageCollectionInterval = 30000;
+// a pooled string, never modified after it is published
+struct StringPool::Entry
+{
+    size_t numBytes;
+    uint32 hash;
+    int32 index; // must be right before text, see getPooledStringIndex()
+    char text[1];
+};
+
+// open-addressing table of one shard, with linear probing
+struct StringPool::Table
+{
+    uint32 mask;
+    Table* previous; // kept until the pool is destroyed, as readers may still be probing it
+    Entry* slots[1];
+};
 
-static inline const char* _add_or_get_it_(HashSet<String>& pool, const String& input)
+namespace
 {
-    HashSet<String>::Iterator it(pool);
-    pool.insertOrSelect(input, it);
-    return it.content().getCharPointer().getAddress();
+    static_assert( (StringPool::NUM_SHARDS & (StringPool::NUM_SHARDS - 1)) == 0, "NUM_SHARDS must be power of two" );
+
+    const uint32 minTableSize = 16;
+
+    // FNV-1a is cheap on short names, finish with a mixer so that both low
+    // bits (for slots) and high bits (for shards) are usable
+    inline uint32 finishHash (uint32 h) noexcept
+    {
+        h ^= h >> 16;
+        h *= 0x7feb352du;
+        h ^= h >> 15;
+        h *= 0x846ca68bu;
+        h ^= h >> 16;
+        return h;
+    }
+
+    inline uint32 hashBytes (const char* text, size_t numBytes) noexcept
+    {
+        uint32 h = 2166136261u;
+        for (size_t i = 0; i < numBytes; ++i)
+            h = (h ^ (uint8) text[i]) * 16777619u;
+        return finishHash (h);
+    }
+
+    // hash a null-terminated string and count its bytes in one pass
+    inline uint32 hashNullTerminated (const char* text, size_t& numBytes) noexcept
+    {
+        uint32 h = 2166136261u;
+        const char* p = text;
+        for (; *p != 0; ++p)
+            h = (h ^ (uint8) *p) * 16777619u;
+        numBytes = (size_t) (p - text);
+        return finishHash (h);
+    }
 }
 
 StringPool::StringPool() noexcept
 {
 }
 
-StringPool::~StringPool() {}
+StringPool::~StringPool()
+{
+    for (int i = 0; i < NUM_SHARDS; ++i)
+    {
+        Table* table = m_shards[i].table;
+
+        // newest table holds all entries of the shard
+        if (table != nullptr)
+            for (uint32 j = 0; j <= table->mask; ++j)
+                std::free (table->slots[j]);
+
+        while (table != nullptr)
+        {
+            Table* previous = table->previous;
+            std::free (table);
+            table = previous;
+        }
+    }
+}
+
+int StringPool::size() const noexcept
+{
+    return atomic_load (&m_numStrings);
+}
+
+const char* StringPool::findString (const Table* table, const char* text, size_t numBytes, uint32 hash) noexcept
+{
+    for (uint32 i = hash;; ++i)
+    {
+        const Entry* entry = atomic_load (&table->slots[i & table->mask]);
+
+        if (entry == nullptr)
+            return nullptr;
+
+        if (entry->hash == hash && entry->numBytes == numBytes
+             && std::memcmp (entry->text, text, numBytes) == 0)
+            return entry->text;
+    }
+}
+
+const char* StringPool::getPooledString (const char* text, size_t numBytes, uint32 hash)
+{
+    Shard& shard = m_shards[(hash >> 24) & (NUM_SHARDS - 1)];
+
+    if (const Table* table = atomic_load (&shard.table))
+        if (const char* found = findString (table, text, numBytes, hash))
+            return found;
+
+    return addString (shard, text, numBytes, hash);
+}
+
+const char* StringPool::addString (Shard& shard, const char* text, size_t numBytes, uint32 hash)
+{
+    static_assert (offsetof (Entry, text) == offsetof (Entry, index) + sizeof (int32),
+                   "index must be stored right before the text");
+
+    const AdaptiveMutex::ScopedLockType sl (shard.mutex);
+
+    // table is only replaced under this lock, and another thread may have
+    // added the same string since it was looked up
+    Table* table = shard.table;
+
+    if (table != nullptr)
+        if (const char* found = findString (table, text, numBytes, hash))
+            return found;
+
+    // keep load factor at most one half, so that probe sequences stay short
+    if (table == nullptr || uint32 (shard.num_entries + 1) * 2 > table->mask + 1)
+    {
+        const uint32 newSize = table == nullptr ? minTableSize : (table->mask + 1) * 2;
+        Table* newTable = static_cast<Table*> (std::calloc (1, sizeof (Table) + (newSize - 1) * sizeof (Entry*)));
+        newTable->mask = newSize - 1;
+        newTable->previous = table;
+
+        if (table != nullptr)
+        {
+            for (uint32 j = 0; j <= table->mask; ++j)
+            {
+                if (Entry* entry = table->slots[j])
+                {
+                    uint32 k = entry->hash;
+                    while (newTable->slots[k & newTable->mask] != nullptr)
+                        ++k;
+                    newTable->slots[k & newTable->mask] = entry;
+                }
+            }
+        }
+
+        atomic_store (&shard.table, newTable);
+        table = newTable;
+    }
+
+    Entry* entry = static_cast<Entry*> (std::malloc (sizeof (Entry) + numBytes));
+    entry->hash = hash;
+    entry->numBytes = numBytes;
+    entry->index = atomic_add_fetch (&m_numStrings, int32 (1));
+    std::memcpy (entry->text, text, numBytes);
+    entry->text[numBytes] = 0;
+
+    uint32 i = hash;
+    while (table->slots[i & table->mask] != nullptr)
+        ++i;
+
+    atomic_store (&table->slots[i & table->mask], entry);
+    atomic_fetch_add (&shard.num_entries, int32 (1));
+
+    return entry->text;
+}
 
 const char* StringPool::getPooledString (const char* const newString)
 {
     if (newString == nullptr || *newString == 0)
         return CharPointer_UTF8(nullptr);
 
-    const ScopedLock sl(m_lock);
-    return _add_or_get_it_(m_strings, CharPointer_UTF8(newString));
+    size_t numBytes;
+    const uint32 hash = hashNullTerminated (newString, numBytes);
+    return getPooledString (newString, numBytes, hash);
 }
 
 const char* StringPool::getPooledString (String::CharPointerType start, String::CharPointerType end)
@@ -61,8 +218,9 @@ const char* StringPool::getPooledString (String::CharPointerType start, String::
     if (start.isEmpty() || start == end)
         return CharPointer_UTF8(nullptr);
 
-    const ScopedLock sl(m_lock);
-    return _add_or_get_it_(m_strings, String(start, end));
+    const char* const text = start.getAddress();
+    const size_t numBytes = (size_t) (end.getAddress() - text);
+    return getPooledString (text, numBytes, hashBytes (text, numBytes));
 }
 
 const char* StringPool::getPooledString (StringRef newString)
@@ -70,8 +228,7 @@ const char* StringPool::getPooledString (StringRef newString)
     if (newString.isEmpty())
         return CharPointer_UTF8(nullptr);
 
-    const ScopedLock sl(m_lock);
-    return _add_or_get_it_(m_strings, newString.text);
+    return getPooledString (newString.text.getAddress());
 }
 
 const char* StringPool::getPooledString (const String& newString)
@@ -79,9 +236,7 @@ const char* StringPool::getPooledString (const String& newString)
     if (newString.isEmpty())
         return CharPointer_UTF8(nullptr);
 
-    const ScopedLock sl(m_lock);
-    return _add_or_get_it_(m_strings, newString);
+    return getPooledString (newString.toRawUTF8());
 }
 
-
 } // namespace treecore
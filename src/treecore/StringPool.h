@@ -29,7 +29,10 @@
 #ifndef TREECORE_STRINGPOOL_H
 #define TREECORE_STRINGPOOL_H
 
-#include "treecore/HashSet.h"
+#include "treecore/AdaptiveMutex.h"
+#include "treecore/Align.h"
+#include "treecore/AlignedMalloc.h"
+#include "treecore/RefCountObject.h"
 #include "treecore/RefCountSingleton.h"
 #include "treecore/String.h"
 #include "treecore/StringRef.h"
@@ -48,6 +51,14 @@ namespace treecore {
     is returned every time a matching string is asked for. This means that it's trivial to
     compare two pooled strings for equality, as you can simply compare their pointers. It
     also cuts down on storage if you're using many copies of the same string.
+
+    The pool is split into shards by hash of the string. Finding a string that is already
+    in the pool takes no lock and writes no shared memory, so many threads can look up
+    strings at the same time. Only adding a new string locks the shard it belongs to.
+    Strings are never removed until the pool is destroyed.
+
+    Each pooled string is also numbered, in the order in which strings are added, so
+    that it can be used as an index into a flat array. See getPooledStringIndex().
 */
 
 class TREECORE_SHARED_API StringPool: public RefCountObject, public RefCountSingleton<StringPool>
@@ -83,10 +94,45 @@ public:
     */
     const char* getPooledString (String::CharPointerType start, String::CharPointerType end);
 
+    /** Returns the number of strings in the pool. */
+    int size() const noexcept;
+
+    /** Returns the number of a string returned by getPooledString().
+        Strings are numbered from 1 upward in the order in which they were added to the
+        pool, so the number is always smaller than or equal to size(). 0 is never used.
+    */
+    static int getPooledStringIndex (const char* pooledString) noexcept
+    {
+        treecore_assert (pooledString != nullptr);
+
+        // each string is stored right after its number
+        return reinterpret_cast<const int32*> (pooledString)[-1];
+    }
+
+    TREECORE_ALIGNED_ALLOCATOR( StringPool )
+
+    /** Number of shards, each with its own table and lock. */
+    static const int NUM_SHARDS = 64;
 
 private:
-    HashSet<String> m_strings;
-    CriticalSection m_lock;
+    struct Entry;
+    struct Table;
+
+    struct TREECORE_ALN_BEGIN( 64 ) Shard
+    {
+        Table* table = nullptr; // replaced atomically when grown
+        int32 num_entries = 0;
+        AdaptiveMutex mutex;
+    } TREECORE_ALN_END( 64 );
+
+    static const char* findString (const Table* table, const char* text, size_t numBytes, uint32 hash) noexcept;
+    const char* getPooledString (const char* text, size_t numBytes, uint32 hash);
+    const char* addString (Shard& shard, const char* text, size_t numBytes, uint32 hash);
+
+    Shard m_shards[NUM_SHARDS];
+    int32 m_numStrings = 0;
+
+    TREECORE_DECLARE_NON_COPYABLE( StringPool )
 };
 
 } // namespace treecore
@@ -0,0 +1,67 @@
+#include "treecore/StringSlice.h"
+
+namespace treecore
+{
+
+int StringSlice::compare( StringSlice other ) const noexcept
+{
+    const size_t common = m_numBytes < other.m_numBytes ? m_numBytes : other.m_numBytes;
+
+    if (common > 0)
+    {
+        const int order = std::memcmp( m_text, other.m_text, common );
+
+        if (order != 0)
+            return order < 0 ? -1 : 1;
+    }
+
+    return m_numBytes < other.m_numBytes ? -1 : (m_numBytes > other.m_numBytes ? 1 : 0);
+}
+
+static inline bool is_ascii_whitespace( char c ) noexcept
+{
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+StringSlice StringSlice::trim() const noexcept
+{
+    const char* start = begin();
+    const char* stop  = end();
+
+    while (start < stop && is_ascii_whitespace( *start ))
+        ++start;
+
+    while (stop > start && is_ascii_whitespace( stop[-1] ))
+        --stop;
+
+    return StringSlice( start, size_t( stop - start ) );
+}
+
+// Numbers are parsed by the functions for zero-terminated text, from a copy
+// on the stack, which is long enough for any number that isn't padded.
+template<typename ResultType, typename ParseFunction>
+static ResultType parse_number( const StringSlice& slice, ParseFunction parse )
+{
+    char buffer[128];
+
+    if (slice.getNumBytes() >= sizeof(buffer))
+        return parse( slice.toString().getCharPointer() );
+
+    if ( slice.isNotEmpty() )
+        std::memcpy( buffer, slice.getData(), slice.getNumBytes() );
+
+    buffer[slice.getNumBytes()] = 0;
+    return parse( String::CharPointerType( buffer ) );
+}
+
+int64 StringSlice::getLargeIntValue() const noexcept
+{
+    return parse_number<int64>( *this, [] ( String::CharPointerType text ) { return text.getIntValue64(); } );
+}
+
+double StringSlice::getDoubleValue() const noexcept
+{
+    return parse_number<double>( *this, [] ( String::CharPointerType text ) { return text.getDoubleValue(); } );
+}
+
+} // namespace treecore
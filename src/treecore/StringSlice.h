@@ -0,0 +1,160 @@
+#ifndef TREECORE_STRING_SLICE_H
+#define TREECORE_STRING_SLICE_H
+
+#include "treecore/DebugUtils.h"
+#include "treecore/String.h"
+
+#include <cstring>
+
+namespace treecore
+{
+
+/**
+ * @brief a range of UTF-8 bytes in memory owned by someone else
+ *
+ * Like StringRef, a slice never allocates or copies text, but it needs no
+ * zero terminator, so that it can refer to a part of a String or of a
+ * buffer. This is what StringTokenizer and LineIterator produce.
+ *
+ * The text must stay valid and unchanged as long as the slice is used.
+ */
+class TREECORE_SHARED_API StringSlice
+{
+public:
+    StringSlice() noexcept {}
+
+    StringSlice( const char* text, size_t numBytes ) noexcept: m_text( text ), m_numBytes( numBytes )
+    {
+        treecore_assert( text != nullptr || numBytes == 0 );
+    }
+
+    /**
+     * @brief refer to a zero-terminated string
+     */
+    StringSlice( const char* text ) noexcept: m_text( text ), m_numBytes( std::strlen( text ) ) {}
+
+    /**
+     * @brief refer to the whole text of a String
+     */
+    StringSlice( const String& text ) noexcept
+        : m_text( text.toRawUTF8() )
+        , m_numBytes( text.getCharPointer().sizeInBytes() - 1 )
+    {}
+
+    // short text is stored inside the String object, so a slice of a
+    // temporary String would always refer to memory which is gone
+    StringSlice( String&& text ) = delete;
+
+    const char* getData() const noexcept { return m_text; }
+
+    size_t getNumBytes() const noexcept { return m_numBytes; }
+
+    bool isEmpty() const noexcept { return m_numBytes == 0; }
+
+    bool isNotEmpty() const noexcept { return m_numBytes != 0; }
+
+    const char* begin() const noexcept { return m_text; }
+
+    const char* end() const noexcept { return m_text + m_numBytes; }
+
+    char operator [] ( size_t index ) const noexcept
+    {
+        treecore_assert( index < m_numBytes );
+        return m_text[index];
+    }
+
+    /**
+     * @brief create a String with a copy of the text
+     */
+    String toString() const { return String( String::CharPointerType( begin() ), String::CharPointerType( end() ) ); }
+
+    //==============================================================================
+    /**
+     * @brief compare the bytes, which for valid UTF-8 is the same order as
+     *        String::compare()
+     */
+    int compare( StringSlice other ) const noexcept;
+
+    bool operator == ( StringSlice other ) const noexcept
+    {
+        return m_numBytes == other.m_numBytes && (m_numBytes == 0 || std::memcmp( m_text, other.m_text, m_numBytes ) == 0);
+    }
+
+    bool operator != ( StringSlice other ) const noexcept { return !operator == ( other ); }
+
+    bool startsWith( StringSlice prefix ) const noexcept
+    {
+        return prefix.m_numBytes <= m_numBytes && StringSlice( m_text, prefix.m_numBytes ) == prefix;
+    }
+
+    bool endsWith( StringSlice suffix ) const noexcept
+    {
+        return suffix.m_numBytes <= m_numBytes && StringSlice( end() - suffix.m_numBytes, suffix.m_numBytes ) == suffix;
+    }
+
+    /**
+     * @brief get the byte position of the first c, or -1 if there is none
+     */
+    int64 indexOf( char c ) const noexcept
+    {
+        const void* const found = m_numBytes > 0 ? std::memchr( m_text, c, m_numBytes ) : nullptr;
+        return found != nullptr ? int64( static_cast<const char*>( found ) - m_text ) : -1;
+    }
+
+    //==============================================================================
+    /**
+     * @brief get the bytes from start to end, both clamped to the slice
+     */
+    StringSlice substring( size_t start, size_t end ) const noexcept
+    {
+        end   = end < m_numBytes ? end : m_numBytes;
+        start = start < end ? start : end;
+        return StringSlice( m_text + start, end - start );
+    }
+
+    StringSlice substring( size_t start ) const noexcept { return substring( start, m_numBytes ); }
+
+    /**
+     * @brief get the part before the first c, or all of it if there is no c
+     */
+    StringSlice upToFirstOccurrenceOf( char c ) const noexcept
+    {
+        const int64 index = indexOf( c );
+        return index >= 0 ? StringSlice( m_text, size_t( index ) ) : *this;
+    }
+
+    /**
+     * @brief get the part after the first c, or nothing if there is no c
+     */
+    StringSlice fromFirstOccurrenceOf( char c ) const noexcept
+    {
+        const int64 index = indexOf( c );
+        return index >= 0 ? substring( size_t( index ) + 1 ) : StringSlice( end(), size_t( 0 ) );
+    }
+
+    /**
+     * @brief remove ASCII whitespace from both ends
+     */
+    StringSlice trim() const noexcept;
+
+    //==============================================================================
+    /**
+     * @brief parse a decimal integer at the start, as String::getLargeIntValue()
+     */
+    int64 getLargeIntValue() const noexcept;
+
+    int getIntValue() const noexcept { return int( getLargeIntValue() ); }
+
+    /**
+     * @brief parse a number at the start, as String::getDoubleValue()
+     */
+    double getDoubleValue() const noexcept;
+
+private:
+    const char* m_text = "";
+    size_t m_numBytes  = 0;
+};
+
+} // namespace treecore
+
+#endif // TREECORE_STRING_SLICE_H
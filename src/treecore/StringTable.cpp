@@ -0,0 +1,212 @@
+#include "treecore/StringTable.h"
+#include "treecore/MathsFunctions.h"
+#include "treecore/NaturalOrder.h"
+#include "treecore/StringArray.h"
+#include "treecore/StringTokenizer.h"
+
+#include "treecore/internal/StringSort.h"
+
+#include <cstring>
+
+namespace treecore
+{
+
+// copied text is put into chunks of at least this size, so that the
+// allocation cost is shared by many elements
+static const size_t STRING_TABLE_CHUNK_BYTES = 64 * 1024;
+
+StringTable::StringTable( const StringTable& other )
+{
+    operator = ( other );
+}
+
+StringTable::StringTable( StringTable&& other ) noexcept
+{
+    operator = ( std::move( other ) );
+}
+
+StringTable::StringTable( const StringArray& strings )
+{
+    m_elements.ensureStorageAllocated( strings.size() );
+
+    for (const String& s : strings)
+        add( s.toRawUTF8(), s.getNumBytesAsUTF8() );
+}
+
+StringTable& StringTable::operator = ( const StringTable& other )
+{
+    if (this == &other)
+        return *this;
+
+    clear();
+
+    // all text into one chunk, whatever it was spread over before
+    size_t numBytes = 0;
+
+    for (const Element& element : other.m_elements)
+        numBytes += element.numBytes;
+
+    char* dest = allocate( numBytes );
+
+    m_elements.ensureStorageAllocated( other.m_elements.size() );
+
+    for (const Element& element : other.m_elements)
+    {
+        if (element.numBytes > 0)
+            std::memcpy( dest, element.text, element.numBytes );
+
+        m_elements.add( { dest, element.numBytes } );
+        dest += element.numBytes;
+    }
+
+    return *this;
+}
+
+StringTable& StringTable::operator = ( StringTable&& other ) noexcept
+{
+    m_elements.swapWith( other.m_elements );
+    m_blocks.swapWith( other.m_blocks );
+    std::swap( m_freeSpace, other.m_freeSpace );
+    std::swap( m_numFreeBytes, other.m_numFreeBytes );
+    return *this;
+}
+
+StringTable::~StringTable()
+{}
+
+String StringTable::getString( int index ) const
+{
+    const Element& element = m_elements[index];
+    return String( String::CharPointerType( element.text ), String::CharPointerType( element.text + element.numBytes ) );
+}
+
+bool StringTable::equals( int index, const char* text, size_t numBytes ) const noexcept
+{
+    const Element& element = m_elements[index];
+    return element.numBytes == numBytes && std::memcmp( element.text, text, numBytes ) == 0;
+}
+
+StringArray StringTable::toStringArray() const
+{
+    StringArray result;
+    result.ensureStorageAllocated( m_elements.size() );
+
+    for (int i = 0; i < m_elements.size(); i++)
+        result.add( getString( i ) );
+
+    return result;
+}
+
+//==============================================================================
+char* StringTable::allocate( size_t numBytes )
+{
+    if (numBytes > m_numFreeBytes)
+    {
+        // the rest of the current chunk is abandoned, a new one never moves
+        // text that elements already point to
+        const size_t chunkBytes = jmax( numBytes, STRING_TABLE_CHUNK_BYTES );
+
+        m_blocks.add( MemoryBlock( chunkBytes ) );
+        m_freeSpace    = static_cast<char*>( m_blocks.getLast().getData() );
+        m_numFreeBytes = chunkBytes;
+    }
+
+    char* const result = m_freeSpace;
+    m_freeSpace    += numBytes;
+    m_numFreeBytes -= numBytes;
+    return result;
+}
+
+const char* StringTable::adopt( MemoryBlock&& block )
+{
+    // moving the block keeps its data where it is
+    m_blocks.add( std::move( block ) );
+    return static_cast<const char*>( m_blocks.getLast().getData() );
+}
+
+void StringTable::add( const char* text, size_t numBytes )
+{
+    treecore_assert( text != nullptr || numBytes == 0 );
+
+    char* const copy = allocate( numBytes );
+
+    if (numBytes > 0)
+        std::memcpy( copy, text, numBytes );
+
+    m_elements.add( { copy, numBytes } );
+}
+
+void StringTable::addReference( const char* text, size_t numBytes )
+{
+    treecore_assert( text != nullptr || numBytes == 0 );
+    m_elements.add( { text, numBytes } );
+}
+
+int StringTable::addLines( const void* text, size_t numBytes )
+{
+    LineIterator lines( text, numBytes );
+    int numLines = 0;
+
+    for (; lines.next(); numLines++)
+        addReference( lines.getLine().getData(), lines.getLine().getNumBytes() );
+
+    return numLines;
+}
+
+int StringTable::addLines( MemoryBlock&& text )
+{
+    const size_t numBytes = text.getSize();
+    return addLines( adopt( std::move( text ) ), numBytes );
+}
+
+int StringTable::addTokens( const void* text, size_t numBytes, StringRef breakCharacters, StringRef quoteCharacters )
+{
+    StringTokenizer tokens( text, numBytes, breakCharacters, quoteCharacters );
+    int numTokens = 0;
+
+    for (; tokens.next(); numTokens++)
+        addReference( tokens.getToken().getData(), tokens.getToken().getNumBytes() );
+
+    return numTokens;
+}
+
+int StringTable::addTokens( MemoryBlock&& text, StringRef breakCharacters, StringRef quoteCharacters )
+{
+    const size_t numBytes = text.getSize();
+    return addTokens( adopt( std::move( text ) ), numBytes, breakCharacters, quoteCharacters );
+}
+
+void StringTable::clear()
+{
+    m_elements.clear();
+    m_blocks.clear();
+    m_freeSpace    = nullptr;
+    m_numFreeBytes = 0;
+}
+
+void StringTable::sort()
+{
+    string_sort( m_elements.getRawDataPointer(), size_t( m_elements.size() ) );
+}
+
+void StringTable::sortNatural()
+{
+    const int num = m_elements.size();
+    HeapBlock<StringSlice> texts( (size_t) num );
+    HeapBlock<int> order( (size_t) num );
+
+    for (int i = 0; i < num; i++)
+        texts[i] = getSlice( i );
+
+    sort_natural_order( texts.getData(), num, order.getData() );
+
+    Array<Element> sorted;
+    sorted.ensureStorageAllocated( num );
+
+    for (int i = 0; i < num; i++)
+        sorted.add( m_elements[order[i]] );
+
+    m_elements.swapWith( sorted );
+}
+
+} // namespace treecore
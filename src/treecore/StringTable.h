@@ -0,0 +1,176 @@
+#ifndef TREECORE_STRING_TABLE_H
+#define TREECORE_STRING_TABLE_H
+
+#include "treecore/Array.h"
+#include "treecore/MemoryBlock.h"
+#include "treecore/String.h"
+#include "treecore/StringRef.h"
+#include "treecore/StringSlice.h"
+
+class TestFramework;
+
+namespace treecore
+{
+
+class StringArray;
+
+/**
+ * @brief a compact list of many strings
+ *
+ * Unlike StringArray, the strings are not separate objects with storage of
+ * their own. Each element is only the address and length of its UTF-8 bytes,
+ * which either are copied into large shared chunks of memory owned by the
+ * table, or stay where they are in memory given to addLines() and
+ * addTokens(). Splitting a large text into lines or tokens therefore copies
+ * no text and allocates nothing per element.
+ *
+ * Elements are not zero-terminated, and may contain zero bytes.
+ *
+ * @code
+ * MemoryMappedFile file( path, MemoryMappedFile::readOnly );
+ * StringTable lines;
+ * lines.addLines( file.getData(), file.getSize() ); // file must outlive lines
+ * lines.sort();
+ * @endcode
+ */
+class TREECORE_SHARED_API StringTable
+{
+    friend class ::TestFramework;
+
+public:
+    StringTable() noexcept {}
+
+    /**
+     * @brief copy all strings into storage owned by the new table
+     */
+    StringTable( const StringTable& other );
+
+    StringTable( StringTable&& other ) noexcept;
+
+    explicit StringTable( const StringArray& strings );
+
+    StringTable& operator = ( const StringTable& other );
+    StringTable& operator = ( StringTable&& other ) noexcept;
+
+    ~StringTable();
+
+    int size() const noexcept { return m_elements.size(); }
+
+    bool isEmpty() const noexcept { return m_elements.size() == 0; }
+
+    const char* getText( int index ) const noexcept { return m_elements[index].text; }
+
+    size_t getNumBytes( int index ) const noexcept { return m_elements[index].numBytes; }
+
+    StringSlice getSlice( int index ) const noexcept { return StringSlice( m_elements[index].text, m_elements[index].numBytes ); }
+
+    /**
+     * @brief create a String of one element
+     */
+    String getString( int index ) const;
+
+    String operator [] ( int index ) const { return getString( index ); }
+
+    /**
+     * @brief whether element at index is exactly the given bytes
+     */
+    bool equals( int index, const char* text, size_t numBytes ) const noexcept;
+
+    StringArray toStringArray() const;
+
+    //==============================================================================
+    /**
+     * @brief append a copy of text
+     */
+    void add( const char* text, size_t numBytes );
+
+    void add( StringRef text ) { add( text.text.getAddress(), text.text.sizeInBytes() - 1 ); }
+
+    /**
+     * @brief append an element which refers to text without copying it
+     *
+     * The text must stay valid and unchanged as long as the table uses it.
+     */
+    void addReference( const char* text, size_t numBytes );
+
+    /**
+     * @brief split text into lines, which refer to it without copying
+     *
+     * Lines end at "\n", "\r\n" or "\r", which are not part of them, the
+     * same as in StringArray::addLines() and LineIterator. The text must
+     * stay valid and unchanged as long as the table uses it.
+     *
+     * @return number of lines added
+     */
+    int addLines( const void* text, size_t numBytes );
+
+    /**
+     * @brief the same as addLines( const void*, size_t ), for text held by a
+     *        block which the table takes over
+     */
+    int addLines( MemoryBlock&& text );
+
+    /**
+     * @brief split text into tokens, which refer to it without copying
+     *
+     * Tokens are separated by any one of breakCharacters, and break
+     * characters between a pair of quoteCharacters don't count, the same as
+     * in StringArray::addTokens() and StringTokenizer. Both sets may only
+     * contain ASCII characters. The text must stay valid and unchanged as
+     * long as the table uses it.
+     *
+     * @return number of tokens added
+     */
+    int addTokens( const void* text, size_t numBytes, StringRef breakCharacters, StringRef quoteCharacters );
+
+    /**
+     * @brief the same as addTokens( const void*, size_t, StringRef, StringRef ),
+     *        for text held by a block which the table takes over
+     */
+    int addTokens( MemoryBlock&& text, StringRef breakCharacters, StringRef quoteCharacters );
+
+    void ensureStorageAllocated( int numElements ) { m_elements.ensureStorageAllocated( numElements ); }
+
+    void remove( int index ) { m_elements.remove( index ); }
+
+    /**
+     * @brief remove all elements and release all storage
+     */
+    void clear();
+
+    /**
+     * @brief sort the elements by their bytes, which is the order of
+     *        String::compare() for valid UTF-8
+     *
+     * Uses a multi-key quicksort, which looks at each byte of common
+     * prefixes once per partition, instead of once for each comparison.
+     */
+    void sort();
+
+    /**
+     * @brief sort the elements in the order of String::compareNatural()
+     *
+     * Each element is turned into a key once, and the keys are sorted byte
+     * by byte, the same as in sort().
+     */
+    void sortNatural();
+
+private:
+    struct Element
+    {
+        const char* text;
+        size_t numBytes;
+    };
+
+    char* allocate( size_t numBytes );
+    const char* adopt( MemoryBlock&& block );
+
+    Array<Element>     m_elements;
+    Array<MemoryBlock> m_blocks;       ///< copied text, and blocks taken over
+    char*  m_freeSpace     = nullptr;  ///< unused end of the last block of copied text
+    size_t m_numFreeBytes  = 0;
+};
+
+} // namespace treecore
+
+#endif // TREECORE_STRING_TABLE_H
@@ -0,0 +1,220 @@
+#include "treecore/StringTokenizer.h"
+#include "treecore/MathsFunctions.h"
+#include "treecore/SimdFunc.h"
+
+#include <cstring>
+
+#if TREECORE_COMPILER_MSVC
+#    include <intrin.h>
+#endif
+
+namespace treecore
+{
+
+namespace
+{
+
+typedef SIMDType<16> VecType;
+
+enum
+{
+    KIND_BREAK = 1,
+    KIND_QUOTE = 2
+};
+
+// 16-byte registers have no int8 broadcast, repeat the byte in an int32
+inline VecType tokenizer_bytes( char value ) noexcept
+{
+    VecType r;
+    simd_broadcast<int32>( r, int32( uint8( value ) * 0x01010101u ) );
+    return r;
+}
+
+// n must not be zero
+inline int tokenizer_lowest_bit( uint64 n ) noexcept
+{
+#if TREECORE_COMPILER_MSVC
+    unsigned long index;
+    _BitScanForward64( &index, n );
+    return int(index);
+#else
+    return __builtin_ctzll( n );
+#endif
+}
+
+} // anonymous namespace
+
+StringTokenizer::StringTokenizer( const void* text, size_t numBytes, StringRef breakCharacters, StringRef quoteCharacters ) noexcept
+    : m_position( static_cast<const char*>( text ) )
+    , m_end( m_position + numBytes )
+    , m_finished( numBytes == 0 )
+{
+    treecore_assert( text != nullptr || numBytes == 0 );
+
+    const StringRef sets[] = { breakCharacters, quoteCharacters };
+
+    for (int kind = 0; kind < 2; kind++)
+    {
+        for (const char* c = sets[kind].text.getAddress(); *c != 0; c++)
+        {
+            const uint8 code = uint8( *c );
+            treecore_assert( code < 128 );
+
+            if (code >= 128)
+                continue;
+
+            if (m_kinds[code] == 0)
+            {
+                if (m_numSpecialChars < MAX_VECTOR_CHARS)
+                    m_specialChars[m_numSpecialChars] = *c;
+
+                m_numSpecialChars++;
+            }
+
+            m_kinds[code] |= kind == 0 ? KIND_BREAK : KIND_QUOTE;
+        }
+    }
+}
+
+const char* StringTokenizer::findSpecial( const char* text ) const noexcept
+{
+    if (m_numSpecialChars <= MAX_VECTOR_CHARS)
+    {
+        VecType specials[MAX_VECTOR_CHARS];
+
+        for (int i = 0; i < m_numSpecialChars; i++)
+            specials[i] = tokenizer_bytes( m_specialChars[i] );
+
+        while (m_end - text >= 16)
+        {
+            VecType v, matches, r;
+            simd_set_all<int32>( v, (const int32*) text );
+            simd_cmp<int8>( matches, v, specials[0] );
+
+            for (int i = 1; i < m_numSpecialChars; i++)
+            {
+                simd_cmp<int8>( r, v, specials[i] );
+                simd_or<int32>( matches, matches, r );
+            }
+
+            const uint64 mask = uint64( simd_movemask<int8>( matches ) );
+
+            if (mask != 0)
+                return text + tokenizer_lowest_bit( mask );
+
+            text += 16;
+        }
+    }
+
+    for (; text < m_end; text++)
+    {
+        const uint8 code = uint8( *text );
+
+        if (code < 128 && m_kinds[code] != 0)
+            return text;
+    }
+
+    return m_end;
+}
+
+bool StringTokenizer::next() noexcept
+{
+    if (m_finished)
+        return false;
+
+    const char* const start = m_position;
+    const char* tokenEnd    = start;
+    char currentQuote       = 0;
+
+    if (m_numSpecialChars == 0)
+    {
+        // without any special characters, the whole text is one token
+        tokenEnd = m_end;
+    }
+    else
+    {
+        for (;; tokenEnd++)
+        {
+            tokenEnd = findSpecial( tokenEnd );
+
+            if (tokenEnd == m_end)
+                break;
+
+            const uint8 kind = m_kinds[uint8( *tokenEnd )];
+
+            if (currentQuote == 0 && (kind & KIND_BREAK) != 0)
+                break;
+
+            if ( (kind & KIND_QUOTE) != 0 )
+            {
+                if (currentQuote == 0)
+                    currentQuote = *tokenEnd;
+                else if (currentQuote == *tokenEnd)
+                    currentQuote = 0;
+            }
+        }
+    }
+
+    m_token = StringSlice( start, size_t( tokenEnd - start ) );
+
+    if (tokenEnd == m_end)
+        m_finished = true;
+    else
+        m_position = tokenEnd + 1;
+
+    return true;
+}
+
+StringSlice StringTokenizer::getRemainder() const noexcept
+{
+    return m_finished ? StringSlice( m_end, size_t( 0 ) ) : StringSlice( m_position, size_t( m_end - m_position ) );
+}
+
+//==============================================================================
+// memchr() of the C library is vectorized, and much faster than looking at
+// each byte in turn
+static inline const char* find_next( const char* from, const char* end, char c ) noexcept
+{
+    const void* const found = from < end ? std::memchr( from, c, size_t( end - from ) ) : nullptr;
+    return found != nullptr ? static_cast<const char*>( found ) : end;
+}
+
+LineIterator::LineIterator( const void* text, size_t numBytes ) noexcept
+    : m_position( static_cast<const char*>( text ) )
+    , m_end( m_position + numBytes )
+    , m_finished( numBytes == 0 )
+{
+    treecore_assert( text != nullptr || numBytes == 0 );
+
+    m_nextLF = find_next( m_position, m_end, '\n' );
+    m_nextCR = find_next( m_position, m_end, '\r' );
+}
+
+bool LineIterator::next() noexcept
+{
+    if (m_finished)
+        return false;
+
+    // each kind of break is searched for again only after it was passed, so
+    // that text with only one kind is not searched for the other on each line
+    if (m_nextLF < m_position) m_nextLF = find_next( m_position, m_end, '\n' );
+    if (m_nextCR < m_position) m_nextCR = find_next( m_position, m_end, '\r' );
+
+    const char* const endOfLine = jmin( m_nextLF, m_nextCR );
+    m_line = StringSlice( m_position, size_t( endOfLine - m_position ) );
+
+    if (endOfLine == m_end)
+    {
+        m_finished = true;
+        return true;
+    }
+
+    m_position = endOfLine + 1;
+
+    if (*endOfLine == '\r' && m_position < m_end && *m_position == '\n')
+        m_position++;
+
+    return true;
+}
+
+} // namespace treecore
@@ -0,0 +1,132 @@
+#ifndef TREECORE_STRING_TOKENIZER_H
+#define TREECORE_STRING_TOKENIZER_H
+
+#include "treecore/MemoryBlock.h"
+#include "treecore/StringRef.h"
+#include "treecore/StringSlice.h"
+
+namespace treecore
+{
+
+/**
+ * @brief splits text into tokens one at a time, without copying it
+ *
+ * Tokens are separated by any one of the break characters, and break
+ * characters between a pair of quote characters don't count. The quotes
+ * stay part of the token. Empty tokens between two breaks are included, and
+ * empty text has no tokens, the same as in StringArray::addTokens(). Break
+ * and quote characters must be ASCII.
+ *
+ * Each token is a StringSlice of the text, which must stay valid and
+ * unchanged while the tokens are used. The text is searched for the break
+ * and quote characters 16 bytes at a time.
+ *
+ * @code
+ * StringTokenizer fields( line, ",", "\"" );
+ * while ( fields.next() )
+ *     total += fields.getToken().getDoubleValue();
+ * @endcode
+ */
+class TREECORE_SHARED_API StringTokenizer
+{
+public:
+    StringTokenizer( const void* text, size_t numBytes, StringRef breakCharacters, StringRef quoteCharacters = StringRef() ) noexcept;
+
+    StringTokenizer( StringSlice text, StringRef breakCharacters, StringRef quoteCharacters = StringRef() ) noexcept
+        : StringTokenizer( text.getData(), text.getNumBytes(), breakCharacters, quoteCharacters )
+    {}
+
+    StringTokenizer( const MemoryBlock& text, StringRef breakCharacters, StringRef quoteCharacters = StringRef() ) noexcept
+        : StringTokenizer( text.getData(), text.getSize(), breakCharacters, quoteCharacters )
+    {}
+
+    // the tokens would refer to a block or a String which is gone
+    StringTokenizer( MemoryBlock&& text, StringRef breakCharacters, StringRef quoteCharacters = StringRef() ) = delete;
+    StringTokenizer( String&& text, StringRef breakCharacters, StringRef quoteCharacters = StringRef() ) = delete;
+
+    /**
+     * @brief move on to the next token
+     * @return false if there are no more tokens
+     */
+    bool next() noexcept;
+
+    /**
+     * @brief get the token found by the last call of next()
+     */
+    StringSlice getToken() const noexcept { return m_token; }
+
+    /**
+     * @brief get the text after the current token, without the break
+     *        character
+     */
+    StringSlice getRemainder() const noexcept;
+
+private:
+    enum { MAX_VECTOR_CHARS = 8 };
+
+    const char* findSpecial( const char* text ) const noexcept;
+
+    const char* m_position;
+    const char* m_end;
+    StringSlice m_token;
+    bool m_finished;
+
+    char m_specialChars[MAX_VECTOR_CHARS]; ///< break and quote characters, searched for with SIMD
+    int  m_numSpecialChars = 0;
+    uint8 m_kinds[128] = {};               ///< whether each ASCII character breaks or quotes
+};
+
+/**
+ * @brief splits text into lines one at a time, without copying it
+ *
+ * Lines end at "\n", "\r\n" or "\r", which are not part of them. Text ending
+ * with a line break has an empty last line, and empty text has no lines, the
+ * same as in StringArray::addLines().
+ *
+ * Each line is a StringSlice of the text, which must stay valid and unchanged
+ * while the lines are used.
+ *
+ * @code
+ * MemoryMappedFile file( logFile, MemoryMappedFile::readOnly );
+ * LineIterator lines( file.getData(), file.getSize() );
+ * while ( lines.next() )
+ *     if ( lines.getLine().startsWith( "ERROR" ) )
+ *         numErrors++;
+ * @endcode
+ */
+class TREECORE_SHARED_API LineIterator
+{
+public:
+    LineIterator( const void* text, size_t numBytes ) noexcept;
+
+    LineIterator( StringSlice text ) noexcept: LineIterator( text.getData(), text.getNumBytes() ) {}
+
+    LineIterator( const MemoryBlock& text ) noexcept: LineIterator( text.getData(), text.getSize() ) {}
+
+    // the lines would refer to a block or a String which is gone
+    LineIterator( MemoryBlock&& text ) = delete;
+    LineIterator( String&& text ) = delete;
+
+    /**
+     * @brief move on to the next line
+     * @return false if there are no more lines
+     */
+    bool next() noexcept;
+
+    /**
+     * @brief get the line found by the last call of next()
+     */
+    StringSlice getLine() const noexcept { return m_line; }
+
+private:
+    const char* m_position;
+    const char* m_end;
+    const char* m_nextLF; ///< the next "\n" from m_position on, or m_end
+    const char* m_nextCR; ///< the next "\r" from m_position on, or m_end
+    StringSlice m_line;
+    bool m_finished;
+};
+
+} // namespace treecore
+
+#endif // TREECORE_STRING_TOKENIZER_H
@@ -42,6 +42,14 @@
 #    include <signal.h>
 #endif
 
+#if TREECORE_CPU_X86
+#    if TREECORE_COMPILER_MSVC
+#        include <intrin.h>
+#    else
+#        include <cpuid.h>
+#    endif
+#endif
+
 namespace treecore {
 
 //==============================================================================
@@ -58,6 +66,94 @@ bool SystemStats::hasSSE() noexcept           { return getCPUInformation().hasSS
 bool SystemStats::hasSSE2() noexcept          { return getCPUInformation().hasSSE2; }
 bool SystemStats::hasSSE3() noexcept          { return getCPUInformation().hasSSE3; }
 bool SystemStats::has3DNow() noexcept         { return getCPUInformation().has3DNow; }
+bool SystemStats::hasSSSE3() noexcept         { return getCPUInformation().hasSSSE3; }
+bool SystemStats::hasSSE41() noexcept         { return getCPUInformation().hasSSE41; }
+bool SystemStats::hasSSE42() noexcept         { return getCPUInformation().hasSSE42; }
+bool SystemStats::hasPCLMULQDQ() noexcept     { return getCPUInformation().hasPCLMULQDQ; }
+bool SystemStats::hasAVX() noexcept           { return getCPUInformation().hasAVX; }
+bool SystemStats::hasAVX2() noexcept          { return getCPUInformation().hasAVX2; }
+bool SystemStats::hasFMA3() noexcept          { return getCPUInformation().hasFMA3; }
+bool SystemStats::hasBMI2() noexcept          { return getCPUInformation().hasBMI2; }
+bool SystemStats::hasAVX512F() noexcept       { return getCPUInformation().hasAVX512F; }
+bool SystemStats::hasAVX512BW() noexcept      { return getCPUInformation().hasAVX512BW; }
+bool SystemStats::hasAVX512DQ() noexcept      { return getCPUInformation().hasAVX512DQ; }
+bool SystemStats::hasAVX512VL() noexcept      { return getCPUInformation().hasAVX512VL; }
+
+//==============================================================================
+#if TREECORE_CPU_X86
+static void callCPUIDEx( uint32 result[4], uint32 leaf, uint32 subLeaf ) noexcept
+{
+   #if TREECORE_COMPILER_MSVC
+    int info[4] = { 0 };
+    __cpuidex( info, (int) leaf, (int) subLeaf );
+    for (int i = 0; i < 4; ++i)
+        result[i] = (uint32) info[i];
+   #else
+    __cpuid_count( leaf, subLeaf, result[0], result[1], result[2], result[3] );
+   #endif
+}
+
+static uint64 readXCR0() noexcept
+{
+   #if TREECORE_COMPILER_MSVC
+    return (uint64) _xgetbv( 0 );
+   #else
+    uint32 lo = 0, hi = 0;
+    __asm__ __volatile__ ( "xgetbv" : "=a" (lo), "=d" (hi) : "c" (0) );
+    return ( uint64( hi ) << 32 ) | lo;
+   #endif
+}
+#endif
+
+void CPUInformation::detectInstructionSets() noexcept
+{
+   #if TREECORE_CPU_X86
+    uint32 info[4] = { 0 };
+    callCPUIDEx( info, 0, 0 );
+    const uint32 maxLeaf = info[0];
+
+    callCPUIDEx( info, 1, 0 );
+    const uint32 c1 = info[2], d1 = info[3];
+
+    hasMMX   = ( d1 & (1u << 23) ) != 0;
+    hasSSE   = ( d1 & (1u << 25) ) != 0;
+    hasSSE2  = ( d1 & (1u << 26) ) != 0;
+    hasSSE3  = ( c1 & (1u <<  0) ) != 0;
+    hasSSSE3 = ( c1 & (1u <<  9) ) != 0;
+    hasSSE41 = ( c1 & (1u << 19) ) != 0;
+    hasSSE42 = ( c1 & (1u << 20) ) != 0;
+    hasPCLMULQDQ = ( c1 & (1u << 1) ) != 0;
+
+    callCPUIDEx( info, 0x80000000u, 0 );
+    if (info[0] >= 0x80000001u)
+    {
+        callCPUIDEx( info, 0x80000001u, 0 );
+        has3DNow = ( info[3] & (1u << 31) ) != 0;
+    }
+
+    // AVX registers are only usable if the OS saves them on context switch
+    const bool osxsave = ( c1 & (1u << 27) ) != 0;
+    const uint64 xcr0 = osxsave ? readXCR0() : 0;
+    const bool osSavesYMM = ( xcr0 & 0x06 ) == 0x06;
+    const bool osSavesZMM = ( xcr0 & 0xe6 ) == 0xe6;
+
+    hasAVX  = osSavesYMM && ( c1 & (1u << 28) ) != 0;
+    hasFMA3 = hasAVX     && ( c1 & (1u << 12) ) != 0;
+
+    if (maxLeaf >= 7)
+    {
+        callCPUIDEx( info, 7, 0 );
+        const uint32 b7 = info[1];
+
+        hasAVX2     = hasAVX && ( b7 & (1u << 5) ) != 0;
+        hasBMI2     = ( b7 & (1u << 8) ) != 0;
+        hasAVX512F  = osSavesZMM && ( b7 & (1u << 16) ) != 0;
+        hasAVX512DQ = hasAVX512F && ( b7 & (1u << 17) ) != 0;
+        hasAVX512BW = hasAVX512F && ( b7 & (1u << 30) ) != 0;
+        hasAVX512VL = hasAVX512F && ( b7 & (1u << 31) ) != 0;
+    }
+   #endif
+}
 
 //==============================================================================
 String SystemStats::getStackBacktrace()
@@ -150,8 +150,26 @@ public:
     static bool hasMMX() noexcept;   /**< Returns true if Intel MMX instructions are available. */
     static bool hasSSE() noexcept;   /**< Returns true if Intel SSE instructions are available. */
     static bool hasSSE2() noexcept;  /**< Returns true if Intel SSE2 instructions are available. */
-    static bool hasSSE3() noexcept;  /**< Returns true if Intel SSE2 instructions are available. */
+    static bool hasSSE3() noexcept;  /**< Returns true if Intel SSE3 instructions are available. */
     static bool has3DNow() noexcept; /**< Returns true if AMD 3DNOW instructions are available. */
+    static bool hasSSSE3() noexcept; /**< Returns true if Intel SSSE3 instructions are available. */
+    static bool hasSSE41() noexcept; /**< Returns true if Intel SSE4.1 instructions are available. */
+    static bool hasSSE42() noexcept; /**< Returns true if Intel SSE4.2 instructions are available. */
+    static bool hasPCLMULQDQ() noexcept; /**< Returns true if carry-less multiplication instructions are available. */
+    static bool hasFMA3() noexcept;  /**< Returns true if FMA3 instructions are available. */
+    static bool hasBMI2() noexcept;  /**< Returns true if BMI2 instructions are available. */
+
+    /** Returns true if AVX instructions are available, and the OS saves YMM registers. */
+    static bool hasAVX() noexcept;
+    /** Returns true if AVX2 instructions are available, and the OS saves YMM registers. */
+    static bool hasAVX2() noexcept;
+
+    /** Returns true if AVX-512 Foundation instructions are available, and the
+        OS saves ZMM and mask registers. */
+    static bool hasAVX512F() noexcept;
+    static bool hasAVX512BW() noexcept; /**< Returns true if AVX-512 byte and word instructions are available. */
+    static bool hasAVX512DQ() noexcept; /**< Returns true if AVX-512 dword and qword instructions are available. */
+    static bool hasAVX512VL() noexcept; /**< Returns true if AVX-512 instructions on 128/256-bit registers are available. */
 
     //==============================================================================
     /** Finds out how much RAM is in the machine.
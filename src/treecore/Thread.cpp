@@ -29,6 +29,7 @@
 #include "treecore/RefCountHolder.h"
 #include "treecore/Logger.h"
 #include "treecore/RefCountObject.h"
+#include "treecore/RefCountSingleton.h"
 #include "treecore/Time.h"
 #include "treecore/Thread.h"
 #include "treecore/ThreadLocalValue.h"
@@ -81,6 +82,9 @@ void Thread::threadEntryPoint()
         run();
     }
 
+    // give the slot of this thread back to the epoch of singletons
+    get_ref_count_singleton_epoch().detachCurrentThread();
+
     closeThreadHandle();
 }
 
@@ -0,0 +1,261 @@
+#include "treecore/UTF8Functions.h"
+#include "treecore/CpuDispatch.h"
+#include "treecore/SimdFunc.h"
+
+#include "treecore/internal/UTF8Functions_impl.h"
+
+#include <cstring>
+
+namespace treecore
+{
+
+namespace
+{
+
+// baseline kernels, on SSE2 registers
+struct BaselineOps
+{
+    typedef SIMDType<16> VecType;
+    enum { N_BYTES = 16 };
+
+    static VecType load( const uint8* src ) noexcept { VecType r; simd_set_all<int32>( r, (const int32*) src ); return r; }
+
+    // 16-byte registers have no int8 broadcast, repeat the byte in an int32
+    static VecType bytes( uint8 value ) noexcept { VecType r; simd_broadcast<int32>( r, int32( value * 0x01010101u ) ); return r; }
+
+    // simd_get_all() needs an aligned destination, the compiler turns this
+    // copy into an unaligned store
+    static void store( uint8* dest, const VecType& v ) noexcept { std::memcpy( dest, &v, N_BYTES ); }
+
+    static uint64 mask_nonascii( const VecType& v ) noexcept { return simd_movemask<int8>( v ); }
+
+    static uint64 mask_equal( const VecType& a, const VecType& b ) noexcept
+    {
+        VecType r;
+        simd_cmp<int8>( r, a, b );
+        return simd_movemask<int8>( r );
+    }
+
+    // letters are positive as signed bytes, so signed comparison works
+    static VecType flip_case( const VecType& v, uint8 first, uint8 last ) noexcept
+    {
+        VecType above, below, r;
+        simd_gt<int8>( above, v, bytes( first - 1 ) );
+        simd_lt<int8>( below, v, bytes( last + 1 ) );
+        simd_and<int32>( r, above, below );
+        simd_and<int32>( r, r, bytes( 0x20 ) );
+        simd_xor<int32>( r, r, v );
+        return r;
+    }
+
+    static uint64 mask_zero( const VecType& v ) noexcept
+    {
+        VecType r;
+        simd_cmp<int8>( r, v, bytes( 0 ) );
+        return simd_movemask<int8>( r );
+    }
+
+    // 0x80 to 0xbf are -128 to -65 as signed bytes
+    static uint64 mask_continuation( const VecType& v ) noexcept
+    {
+        VecType r;
+        simd_lt<int8>( r, v, bytes( 0xc0 ) );
+        return simd_movemask<int8>( r );
+    }
+
+    // 0xf0 to 0xff are -16 to -1 as signed bytes
+    static uint64 mask_four_byte_lead( const VecType& v ) noexcept
+    {
+        VecType r;
+        simd_gt<int8>( r, v, bytes( 0xef ) );
+        return simd_movemask<int8>( r ) & simd_movemask<int8>( v );
+    }
+
+    template<typename DestType>
+    static void widen( const uint8* src, DestType* dest ) noexcept
+    {
+        for (int i = 0; i < N_BYTES; i++)
+            dest[i] = src[i];
+    }
+
+    static bool validate( const uint8* data, size_t num ) noexcept { return Utf8Kernels<BaselineOps>::validate_sequences( data, num ); }
+};
+
+} // anonymous namespace
+
+const Utf8KernelTable* get_utf8_kernels_baseline() noexcept
+{
+    return &Utf8Kernels<BaselineOps>::table;
+}
+
+static const Utf8KernelTable& kernels() noexcept
+{
+    static const CpuDispatchTable<const Utf8KernelTable*> impls = { {
+        get_utf8_kernels_baseline(),
+        nullptr,
+#if TREECORE_CPU_X86
+        get_utf8_kernels_avx2(),
+#else
+        nullptr,
+#endif
+        nullptr
+    } };
+
+    static const Utf8KernelTable* impl = impls.select();
+    return *impl;
+}
+
+//
+// Malformed text is converted character by character, with the same rules as
+// CharPointer_UTF8::getAndAdvance(): a leading byte takes as many of the
+// following continuation bytes as it announces, up to three, and anything
+// else is decoded as if it was a complete character.
+//
+static uint32 decode_lenient( const uint8*& p, const uint8* end ) noexcept
+{
+    uint32 n = *p++;
+
+    if (n < 0x80)
+        return n;
+
+    uint32 mask = 0x7f;
+    uint32 bit  = 0x40;
+    int num_extra = 0;
+
+    while ( (n & bit) != 0 && bit > 0x8 )
+    {
+        mask >>= 1;
+        ++num_extra;
+        bit >>= 1;
+    }
+
+    n &= mask;
+
+    while (--num_extra >= 0 && p < end && (*p & 0xc0) == 0x80)
+        n = (n << 6) | (*p++ & 0x3f);
+
+    return n;
+}
+
+template<typename DestType>
+static size_t convert_lenient( const uint8* data, size_t num, DestType* dest ) noexcept
+{
+    const uint8* const end = data + num;
+    DestType* d = dest;
+
+    while (data < end)
+    {
+        const uint32 c = decode_lenient( data, end );
+        if (c == 0)
+            break;
+
+        utf8_put_char( d, c );
+    }
+
+    return size_t( d - dest );
+}
+
+static size_t length_lenient( const uint8* data, size_t num, size_t units_per_big_char ) noexcept
+{
+    const uint8* const end = data + num;
+    size_t count = 0;
+
+    while (data < end)
+    {
+        const uint32 c = decode_lenient( data, end );
+        if (c == 0)
+            break;
+
+        count += c >= 0x10000 ? units_per_big_char : 1;
+    }
+
+    return count;
+}
+
+// well-formed text never decodes to zero, except for a zero byte
+static size_t length_before_zero( const char* data, size_t num_bytes ) noexcept
+{
+    const void* zero = std::memchr( data, 0, num_bytes );
+    return zero == nullptr ? num_bytes : size_t( static_cast<const char*>(zero) - data );
+}
+
+bool utf8_validate( const char* data, size_t num_bytes ) noexcept
+{
+    return kernels().validate( (const uint8*) data, num_bytes );
+}
+
+size_t utf8_ascii_prefix_length( const char* data, size_t num_bytes ) noexcept
+{
+    return kernels().ascii_prefix( (const uint8*) data, num_bytes );
+}
+
+size_t utf8_count_chars( const char* data, size_t num_bytes ) noexcept
+{
+    return kernels().count_chars( (const uint8*) data, num_bytes );
+}
+
+size_t utf8_utf16_length( const char* data, size_t num_bytes ) noexcept
+{
+    const Utf8KernelTable& k = kernels();
+    num_bytes = length_before_zero( data, num_bytes );
+
+    if ( k.validate( (const uint8*) data, num_bytes ) )
+        return k.valid_utf16_length( (const uint8*) data, num_bytes );
+
+    return length_lenient( (const uint8*) data, num_bytes, 2 );
+}
+
+size_t utf8_utf32_length( const char* data, size_t num_bytes ) noexcept
+{
+    const Utf8KernelTable& k = kernels();
+    num_bytes = length_before_zero( data, num_bytes );
+
+    if ( k.validate( (const uint8*) data, num_bytes ) )
+        return k.count_chars( (const uint8*) data, num_bytes );
+
+    return length_lenient( (const uint8*) data, num_bytes, 1 );
+}
+
+size_t utf8_to_utf16( const char* data, size_t num_bytes, uint16* dest ) noexcept
+{
+    const Utf8KernelTable& k = kernels();
+    num_bytes = length_before_zero( data, num_bytes );
+
+    if ( k.validate( (const uint8*) data, num_bytes ) )
+        return k.valid_to_utf16( (const uint8*) data, num_bytes, dest );
+
+    return convert_lenient( (const uint8*) data, num_bytes, dest );
+}
+
+size_t utf8_to_utf32( const char* data, size_t num_bytes, uint32* dest ) noexcept
+{
+    const Utf8KernelTable& k = kernels();
+    num_bytes = length_before_zero( data, num_bytes );
+
+    if ( k.validate( (const uint8*) data, num_bytes ) )
+        return k.valid_to_utf32( (const uint8*) data, num_bytes, dest );
+
+    return convert_lenient( (const uint8*) data, num_bytes, dest );
+}
+
+size_t utf8_find( const char* data, size_t num_bytes, const char* needle, size_t needle_bytes ) noexcept
+{
+    return kernels().find( (const uint8*) data, num_bytes, (const uint8*) needle, needle_bytes );
+}
+
+size_t utf8_mismatch( const char* a, const char* b, size_t num_bytes ) noexcept
+{
+    return kernels().mismatch( (const uint8*) a, (const uint8*) b, num_bytes );
+}
+
+void utf8_ascii_to_lower( char* dest, const char* src, size_t num_bytes ) noexcept
+{
+    kernels().ascii_to_lower( (uint8*) dest, (const uint8*) src, num_bytes );
+}
+
+void utf8_ascii_to_upper( char* dest, const char* src, size_t num_bytes ) noexcept
+{
+    kernels().ascii_to_upper( (uint8*) dest, (const uint8*) src, num_bytes );
+}
+
+} // namespace treecore
@@ -0,0 +1,111 @@
+#ifndef TREECORE_UTF8_FUNCTIONS_H
+#define TREECORE_UTF8_FUNCTIONS_H
+
+#include "treecore/Common.h"
+#include "treecore/IntTypes.h"
+#include "treecore/PlatformDefs.h"
+
+#include <cstddef>
+
+namespace treecore
+{
+
+//
+// SIMD routines on UTF-8 byte ranges. All functions read exactly num_bytes
+// bytes from data and nothing beyond, so the range doesn't need to be
+// terminated. The best implementation for current CPU is chosen on first use,
+// see get_cpu_feature_level().
+//
+
+/**
+ * @brief check whether a byte range is well-formed UTF-8, as of RFC 3629
+ *
+ * Overlong encodings, UTF-16 surrogates, code points above U+10FFFF and
+ * sequences truncated by the end of range are all rejected. Zero bytes are
+ * accepted like any other ASCII character.
+ */
+TREECORE_SHARED_API bool utf8_validate( const char* data, size_t num_bytes ) noexcept;
+
+/**
+ * @brief get the number of leading bytes that are ASCII and not zero
+ */
+TREECORE_SHARED_API size_t utf8_ascii_prefix_length( const char* data, size_t num_bytes ) noexcept;
+
+/**
+ * @brief count the characters in a byte range
+ *
+ * Each byte that is not a continuation byte following a non-ASCII byte is
+ * counted, which is the same as CharPointer_UTF8::length() on well-formed
+ * and malformed text. Zero bytes are counted as characters.
+ */
+TREECORE_SHARED_API size_t utf8_count_chars( const char* data, size_t num_bytes ) noexcept;
+
+/**
+ * @brief get the number of UTF-16 code units utf8_to_utf16() would write
+ */
+TREECORE_SHARED_API size_t utf8_utf16_length( const char* data, size_t num_bytes ) noexcept;
+
+/**
+ * @brief get the number of code points utf8_to_utf32() would write
+ */
+TREECORE_SHARED_API size_t utf8_utf32_length( const char* data, size_t num_bytes ) noexcept;
+
+/**
+ * @brief convert UTF-8 to UTF-16
+ *
+ * Characters are decoded exactly as CharPointer_UTF8::getAndAdvance() does,
+ * so malformed text gives the same result as the character-by-character
+ * conversion. Conversion stops at the end of range, or at the first
+ * character decoded as zero. Code points above U+FFFF are written as
+ * surrogate pairs. No terminating zero is written.
+ *
+ * @param dest  must have room for utf8_utf16_length() units
+ * @return number of code units written
+ */
+TREECORE_SHARED_API size_t utf8_to_utf16( const char* data, size_t num_bytes, uint16* dest ) noexcept;
+
+/**
+ * @brief convert UTF-8 to UTF-32
+ *
+ * Same decoding rules as utf8_to_utf16().
+ *
+ * @param dest  must have room for utf8_utf32_length() code points
+ * @return number of code points written
+ */
+TREECORE_SHARED_API size_t utf8_to_utf32( const char* data, size_t num_bytes, uint32* dest ) noexcept;
+
+/**
+ * @brief find the first occurrence of a byte sequence
+ *
+ * Bytes are compared as they are, so a match in well-formed text always
+ * starts at a character boundary.
+ *
+ * @return byte offset of the match, or num_bytes if there is none. An empty
+ *         needle is found at offset 0.
+ */
+TREECORE_SHARED_API size_t utf8_find( const char* data, size_t num_bytes, const char* needle, size_t needle_bytes ) noexcept;
+
+/**
+ * @brief get the offset of the first byte that differs between two ranges
+ *
+ * @return num_bytes if both ranges are equal
+ */
+TREECORE_SHARED_API size_t utf8_mismatch( const char* a, const char* b, size_t num_bytes ) noexcept;
+
+/**
+ * @brief convert ASCII letters to lower case, copying other bytes unchanged
+ *
+ * dest may be the same as src.
+ */
+TREECORE_SHARED_API void utf8_ascii_to_lower( char* dest, const char* src, size_t num_bytes ) noexcept;
+
+/**
+ * @brief convert ASCII letters to upper case, copying other bytes unchanged
+ *
+ * dest may be the same as src.
+ */
+TREECORE_SHARED_API void utf8_ascii_to_upper( char* dest, const char* src, size_t num_bytes ) noexcept;
+
+} // namespace treecore
+
+#endif // TREECORE_UTF8_FUNCTIONS_H
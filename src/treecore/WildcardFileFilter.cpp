@@ -35,10 +35,10 @@ WildcardFileFilter::WildcardFileFilter (const String& fileWildcardPatterns,
                                         const String& directoryWildcardPatterns,
                                         const String& desc)
     : FileFilter (desc.isEmpty() ? fileWildcardPatterns
-                                 : (desc + " (" + fileWildcardPatterns + ")"))
+                                 : (desc + " (" + fileWildcardPatterns + ")")),
+      fileWildcards (parse (fileWildcardPatterns), true),
+      directoryWildcards (parse (directoryWildcardPatterns), true)
 {
-    parse (fileWildcardPatterns, fileWildcards);
-    parse (directoryWildcardPatterns, directoryWildcards);
 }
 
 WildcardFileFilter::~WildcardFileFilter()
@@ -56,8 +56,9 @@ bool WildcardFileFilter::isDirectorySuitable (const File& file) const
 }
 
 //==============================================================================
-void WildcardFileFilter::parse (const String& pattern, StringArray& result)
+StringArray WildcardFileFilter::parse (const String& pattern)
 {
+    StringArray result;
     result.addTokens (pattern.toLowerCase(), ";,", "\"'");
 
     result.trim();
@@ -68,17 +69,14 @@ void WildcardFileFilter::parse (const String& pattern, StringArray& result)
     for (int i = result.size(); --i >= 0;)
         if (result[i] == "*.*")
             result[i] = "*";
+
+    return result;
 }
 
-bool WildcardFileFilter::match (const File& file, const StringArray& wildcards)
+bool WildcardFileFilter::match (const File& file, const WildcardMatcher& wildcards)
 {
-    const String filename (file.getFileName());
-
-    for (int i = wildcards.size(); --i >= 0;)
-        if (filename.matchesWildcard (wildcards[i], true))
-            return true;
-
-    return false;
+    const String name (file.getFileName());
+    return wildcards.matches (name);
 }
 
 }
@@ -33,6 +33,7 @@
 #include "treecore/FileFilter.h"
 #include "treecore/LeakedObjectDetector.h"
 #include "treecore/StringArray.h"
+#include "treecore/WildcardMatcher.h"
 
 namespace treecore {
 
@@ -79,10 +80,10 @@ public:
 
 private:
     //==============================================================================
-    StringArray fileWildcards, directoryWildcards;
+    WildcardMatcher fileWildcards, directoryWildcards;
 
-    static void parse (const String& pattern, StringArray& result);
-    static bool match (const File& file, const StringArray& wildcards);
+    static StringArray parse (const String& pattern);
+    static bool match (const File& file, const WildcardMatcher& wildcards);
 
     TREECORE_LEAK_DETECTOR (WildcardFileFilter)
 };
@@ -0,0 +1,371 @@
+#include "treecore/WildcardMatcher.h"
+#include "treecore/CharacterFunctions.h"
+#include "treecore/CharPointer_UTF8.h"
+#include "treecore/HeapBlock.h"
+#include "treecore/StringRef.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace treecore
+{
+
+namespace
+{
+
+enum { ANY_CLASS = -1 };
+
+struct PatternToken
+{
+    int charClass;   ///< the class of the character to match, or ANY_CLASS
+    bool afterStar;  ///< whether any characters may come before it
+};
+
+inline uint64 hash_state( const uint64* words, int numWords ) noexcept
+{
+    uint64 h = 0x9e3779b97f4a7c15ULL;
+
+    for (int i = 0; i < numWords; i++)
+    {
+        h ^= words[i];
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 32;
+    }
+
+    return h;
+}
+
+// the set of positions reached from state with a character of one class
+inline void step_state( uint64* next, const uint64* state, const uint64* classMask, const uint64* starMask, int numWords ) noexcept
+{
+    uint64 carry = 0;
+
+    for (int i = 0; i < numWords; i++)
+    {
+        const uint64 moving = state[i] & classMask[i];
+        next[i] = (moving << 1) | carry | (state[i] & starMask[i]);
+        carry   = moving >> 63;
+    }
+}
+
+inline bool is_empty_state( const uint64* state, int numWords ) noexcept
+{
+    for (int i = 0; i < numWords; i++)
+        if (state[i] != 0)
+            return false;
+
+    return true;
+}
+
+inline bool intersects( const uint64* a, const uint64* b, int numWords ) noexcept
+{
+    for (int i = 0; i < numWords; i++)
+        if ( (a[i] & b[i]) != 0 )
+            return true;
+
+    return false;
+}
+
+inline void set_bit( uint64* words, int bit ) noexcept
+{
+    words[bit >> 6] |= uint64( 1 ) << (bit & 63);
+}
+
+} // anonymous namespace
+
+WildcardMatcher::WildcardMatcher()
+{
+    compile( StringArray() );
+}
+
+WildcardMatcher::WildcardMatcher( const StringArray& patterns, bool ignoreCase )
+    : m_ignoreCase( ignoreCase )
+{
+    compile( patterns );
+}
+
+WildcardMatcher::WildcardMatcher( StringRef pattern, bool ignoreCase )
+    : m_ignoreCase( ignoreCase )
+{
+    StringArray patterns;
+    patterns.add( pattern.text );
+    compile( patterns );
+}
+
+StringArray WildcardMatcher::splitPatterns( StringRef patternList )
+{
+    StringArray patterns;
+    patterns.addTokens( patternList, ";,", "\"'" );
+    patterns.trim();
+    patterns.removeEmptyStrings();
+    return patterns;
+}
+
+void WildcardMatcher::compile( const StringArray& patterns )
+{
+    m_numPatterns = patterns.size();
+
+    // find the characters used in the patterns, each of which gets a class
+    Array<treecore_wchar> chars;
+
+    for (const String& pattern : patterns)
+    {
+        for (CharPointer_UTF8 p = pattern.getCharPointer(); !p.isEmpty();)
+        {
+            treecore_wchar c = p.getAndAdvance();
+
+            if (c == '*' || c == '?')
+                continue;
+
+            if (m_ignoreCase)
+                c = CharacterFunctions::toLowerCase( c );
+
+            chars.addIfNotAlreadyThere( c );
+        }
+    }
+
+    std::sort( chars.begin(), chars.end() );
+    m_numClasses = chars.size() + 1;
+
+    for (int c = 0; c < 128; c++)
+    {
+        const treecore_wchar lower = m_ignoreCase ? CharacterFunctions::toLowerCase( treecore_wchar( c ) ) : treecore_wchar( c );
+        const treecore_wchar* found = std::lower_bound( chars.begin(), chars.end(), lower );
+        m_asciiClasses[c] = uint16( (found != chars.end() && *found == lower) ? found - chars.begin() + 1 : 0 );
+    }
+
+    for (int i = 0; i < chars.size(); i++)
+        if (chars[i] >= 128)
+            m_wideClasses.add( { chars[i], uint16( i + 1 ) } );
+
+    // turn each pattern into a row of positions, with one bit each
+    Array<PatternToken> tokens;
+    Array<int> firstPositions;
+    Array<int> lastPositions;
+
+    for (const String& pattern : patterns)
+    {
+        firstPositions.add( tokens.size() );
+        bool afterStar = false;
+
+        for (CharPointer_UTF8 p = pattern.getCharPointer(); !p.isEmpty();)
+        {
+            treecore_wchar c = p.getAndAdvance();
+
+            if (c == '*')
+            {
+                afterStar = true;
+                continue;
+            }
+
+            int charClass = ANY_CLASS;
+
+            if (c != '?')
+            {
+                if (m_ignoreCase)
+                    c = CharacterFunctions::toLowerCase( c );
+
+                charClass = int( std::lower_bound( chars.begin(), chars.end(), c ) - chars.begin() ) + 1;
+            }
+
+            tokens.add( { charClass, afterStar } );
+            afterStar = false;
+        }
+
+        // the position after the last character, which loops if the pattern
+        // ends with a star
+        tokens.add( { ANY_CLASS, afterStar } );
+        lastPositions.add( tokens.size() - 1 );
+    }
+
+    // each token is a position, and a character of its class moves on to the
+    // next one
+    const int numPositions = jmax( tokens.size(), 1 );
+    m_numWords = (numPositions + 63) / 64;
+
+    m_classMasks.clearQuick();
+    m_classMasks.insertMultiple( 0, 0, m_numClasses * m_numWords );
+    m_starMasks.clearQuick();
+    m_starMasks.insertMultiple( 0, 0, m_numWords );
+    m_startMask.clearQuick();
+    m_startMask.insertMultiple( 0, 0, m_numWords );
+    m_acceptMask.clearQuick();
+    m_acceptMask.insertMultiple( 0, 0, m_numWords );
+
+    for (int k = 0; k < m_numPatterns; k++)
+    {
+        set_bit( m_startMask.getRawDataPointer(), firstPositions[k] );
+        set_bit( m_acceptMask.getRawDataPointer(), lastPositions[k] );
+
+        for (int position = firstPositions[k]; position <= lastPositions[k]; position++)
+        {
+            const PatternToken& t = tokens[position];
+
+            if (t.afterStar)
+                set_bit( m_starMasks.getRawDataPointer(), position );
+
+            if (position == lastPositions[k])
+                continue;
+
+            for (int c = 0; c < m_numClasses; c++)
+                if (t.charClass == ANY_CLASS || t.charClass == c)
+                    set_bit( m_classMasks.getRawDataPointer() + c * m_numWords, position );
+        }
+    }
+
+    // build the deterministic automaton, whose states are the sets of
+    // positions which can be reached
+    const int numSlots = MAX_STATES * 2;
+    Array<int> slots;
+    slots.insertMultiple( 0, -1, numSlots );
+
+    Array<uint64> stateSets;
+    stateSets.insertMultiple( 0, 0, m_numWords ); // the dead state
+
+    slots[int( hash_state( stateSets.getRawDataPointer(), m_numWords ) & (numSlots - 1) )] = DEAD_STATE;
+
+    int numStates = 1;
+    m_transitions.clearQuick();
+    HeapBlock<uint64> next( (size_t) m_numWords );
+
+    auto find_or_add_state = [&]( const uint64* state ) -> int
+    {
+        for (int slot = int( hash_state( state, m_numWords ) & (numSlots - 1) );; slot = (slot + 1) & (numSlots - 1))
+        {
+            const int index = slots[slot];
+
+            if (index < 0)
+            {
+                if (numStates >= MAX_STATES || (numStates + 1) * m_numClasses > MAX_TRANSITIONS)
+                    return -1;
+
+                slots[slot] = numStates;
+                stateSets.addArray( state, m_numWords );
+                return numStates++;
+            }
+
+            if (std::memcmp( stateSets.getRawDataPointer() + index * m_numWords, state, sizeof(uint64) * m_numWords ) == 0)
+                return index;
+        }
+    };
+
+    // the start state may be the dead one, if there are no patterns
+    m_startState = find_or_add_state( m_startMask.getRawDataPointer() );
+
+    for (int s = 0; s < numStates; s++)
+    {
+        for (int c = 0; c < m_numClasses; c++)
+        {
+            step_state( next.getData(), stateSets.getRawDataPointer() + s * m_numWords,
+                        m_classMasks.getRawDataPointer() + c * m_numWords, m_starMasks.getRawDataPointer(), m_numWords );
+
+            const int target = find_or_add_state( next.getData() );
+
+            if (target < 0)
+            {
+                m_numStates = 0;
+                m_transitions.clear();
+                m_accepting.clear();
+                return;
+            }
+
+            m_transitions.add( target );
+        }
+    }
+
+    m_numStates = numStates;
+    m_accepting.clearQuick();
+
+    for (int s = 0; s < numStates; s++)
+    {
+        const uint64* state = stateSets.getRawDataPointer() + s * m_numWords;
+        uint8 accepting     = intersects( state, m_acceptMask.getRawDataPointer(), m_numWords ) ? 1 : 0;
+
+        // a match which nothing can undo ends the search early
+        if (accepting)
+        {
+            bool staysHere = true;
+
+            for (int c = 0; c < m_numClasses; c++)
+                if (m_transitions[s * m_numClasses + c] != s)
+                    staysHere = false;
+
+            if (staysHere)
+                accepting = 2;
+        }
+
+        m_accepting.add( accepting );
+    }
+}
+
+int WildcardMatcher::getCharClass( const uint8*& p, const uint8* end ) const noexcept
+{
+    const uint8 lead = *p++;
+
+    if (lead < 0x80)
+        return m_asciiClasses[lead];
+
+    int numExtraBytes = lead >= 0xf0 ? 3 : (lead >= 0xe0 ? 2 : (lead >= 0xc0 ? 1 : 0));
+    treecore_wchar c  = lead & (0x3f >> numExtraBytes);
+
+    for (; numExtraBytes > 0 && p < end && (*p & 0xc0) == 0x80; numExtraBytes--)
+        c = (c << 6) | (*p++ & 0x3f);
+
+    if (m_ignoreCase)
+        c = CharacterFunctions::toLowerCase( c );
+
+    const WideChar* begin = m_wideClasses.begin();
+    const WideChar* found = std::lower_bound( begin, m_wideClasses.end(), c,
+                                              []( const WideChar& w, treecore_wchar target ) { return w.c < target; } );
+
+    return (found != m_wideClasses.end() && found->c == c) ? found->charClass : 0;
+}
+
+bool WildcardMatcher::matches( const char* text, size_t numBytes ) const noexcept
+{
+    const uint8* p   = reinterpret_cast<const uint8*>( text );
+    const uint8* end = p + numBytes;
+
+    if (m_numStates == 0)
+        return matchesBitParallel( p, end );
+
+    const int32* transitions = m_transitions.begin();
+    const uint8* accepting   = m_accepting.begin();
+    int state = m_startState;
+
+    while (p < end)
+    {
+        if (state == DEAD_STATE)
+            return false;
+
+        if (accepting[state] == 2)
+            return true;
+
+        state = transitions[state * m_numClasses + getCharClass( p, end )];
+    }
+
+    return accepting[state] != 0;
+}
+
+bool WildcardMatcher::matchesBitParallel( const uint8* p, const uint8* end ) const noexcept
+{
+    HeapBlock<uint64> buffer( size_t( m_numWords * 2 ) );
+    uint64* state = buffer.getData();
+    uint64* next  = state + m_numWords;
+
+    std::memcpy( state, m_startMask.begin(), sizeof(uint64) * m_numWords );
+
+    while (p < end)
+    {
+        const int c = getCharClass( p, end );
+        step_state( next, state, m_classMasks.begin() + c * m_numWords, m_starMasks.begin(), m_numWords );
+        std::swap( state, next );
+
+        if ( is_empty_state( state, m_numWords ) )
+            return false;
+    }
+
+    return intersects( state, m_acceptMask.begin(), m_numWords );
+}
+
+} // namespace treecore
@@ -0,0 +1,118 @@
+#ifndef TREECORE_WILDCARD_MATCHER_H
+#define TREECORE_WILDCARD_MATCHER_H
+
+#include "treecore/Array.h"
+#include "treecore/StringRef.h"
+#include "treecore/StringArray.h"
+#include "treecore/StringSlice.h"
+
+namespace treecore
+{
+
+/**
+ * @brief tests text against a set of wildcard patterns at once
+ *
+ * The patterns are those of String::matchesWildcard(): "*" matches any
+ * number of characters, "?" matches exactly one, and everything else
+ * matches itself. A text matches the set if it matches any of the patterns.
+ *
+ * The patterns are compiled once into a deterministic automaton over the
+ * characters they use, so that testing a text looks at each character once,
+ * whatever the number of patterns is. Sets whose automaton would be very
+ * large are run as one bit-parallel automaton instead, which is still a
+ * single pass.
+ *
+ * A matcher isn't changed by testing texts, so one matcher can be used by
+ * several threads.
+ *
+ * @code
+ * WildcardMatcher sources( WildcardMatcher::splitPatterns( "*.cpp;*.h" ), true );
+ * for (DirectoryIterator i( root, true, sources ); i.next();)
+ *     compile( i.getFile() );
+ * @endcode
+ */
+class TREECORE_SHARED_API WildcardMatcher
+{
+public:
+    /**
+     * @brief create a matcher with no patterns, which matches nothing
+     */
+    WildcardMatcher();
+
+    /**
+     * @brief compile a set of patterns
+     *
+     * @param patterns    the patterns, used as they are
+     * @param ignoreCase  whether upper- and lower-case letters match each other
+     */
+    WildcardMatcher( const StringArray& patterns, bool ignoreCase );
+
+    /**
+     * @brief compile a single pattern
+     */
+    WildcardMatcher( StringRef pattern, bool ignoreCase );
+
+    /**
+     * @brief split a list of patterns separated by semicolons or commas, such
+     *        as "*.jpg;*.png", the way DirectoryIterator does
+     */
+    static StringArray splitPatterns( StringRef patternList );
+
+    /**
+     * @brief test if a UTF-8 text matches any of the patterns
+     */
+    bool matches( const char* text, size_t numBytes ) const noexcept;
+
+    bool matches( StringSlice text ) const noexcept { return matches( text.getData(), text.getNumBytes() ); }
+
+    /**
+     * @brief get the number of patterns
+     */
+    int getNumPatterns() const noexcept { return m_numPatterns; }
+
+    /**
+     * @brief get the number of states of the automaton, or 0 if the patterns
+     *        are run as a bit-parallel automaton
+     */
+    int getNumStates() const noexcept { return m_numStates; }
+
+private:
+    enum
+    {
+        MAX_STATES      = 4096,    ///< larger automatons fall back to bit-parallel matching
+        MAX_TRANSITIONS = 1 << 20, ///< and so do automatons over very many characters
+        DEAD_STATE      = 0        ///< the state reached once no pattern can match any more
+    };
+
+    struct WideChar
+    {
+        treecore_wchar c;
+        uint16 charClass;
+    };
+
+    void compile( const StringArray& patterns );
+    int getCharClass( const uint8*& p, const uint8* end ) const noexcept;
+    bool matchesBitParallel( const uint8* p, const uint8* end ) const noexcept;
+
+    int   m_numPatterns = 0;
+    bool  m_ignoreCase  = false;
+    int   m_numClasses  = 1;       ///< class 0 is every character which isn't in a pattern
+    uint16 m_asciiClasses[128];
+    Array<WideChar> m_wideClasses; ///< classes of the other characters, sorted
+
+    int m_numStates  = 0;
+    int m_startState = DEAD_STATE;
+    Array<int32> m_transitions;    ///< next state for each state and class
+    Array<uint8> m_accepting;      ///< whether each state means a match
+
+    // the bit-parallel automaton, with one bit for each position in a pattern
+    int m_numWords = 0;
+    Array<uint64> m_classMasks;    ///< positions which can be left with each class
+    Array<uint64> m_starMasks;     ///< positions which loop on any character
+    Array<uint64> m_startMask;
+    Array<uint64> m_acceptMask;
+};
+
+} // namespace treecore
+
+#endif // TREECORE_WILDCARD_MATCHER_H
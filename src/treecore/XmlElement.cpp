@@ -27,10 +27,10 @@
  */
 
 #include "treecore/FileOutputStream.h"
-#include "treecore/MemoryOutputStream.h"
 #include "treecore/NewLine.h"
 #include "treecore/OutputStream.h"
 #include "treecore/String.h"
+#include "treecore/StringBuilder.h"
 #include "treecore/StringPool.h"
 #include "treecore/StringRef.h"
 #include "treecore/TemporaryFile.h"
@@ -210,6 +210,19 @@ static void escapeIllegalXmlChars( OutputStream& outputStream, const String& tex
 
     for (;; )
     {
+        // legal characters are all ASCII, and are written a whole run at a time
+        const char* const runStart = t.getAddress();
+        const char* runEnd = runStart;
+
+        while ( isLegalXmlChar( (uint8) *runEnd ) )
+            ++runEnd;
+
+        if (runEnd != runStart)
+        {
+            outputStream.write( runStart, size_t( runEnd - runStart ) );
+            t = String::CharPointerType( runEnd );
+        }
+
         const uint32 character = (uint32) t.getAndAdvance();
 
         if (character == 0)
@@ -338,10 +351,10 @@ String XmlElement::createDocument( StringRef  dtdToUse,
                                    StringRef  encodingType,
                                    const int  lineWrapLength ) const
 {
-    MemoryOutputStream mem( 2048 );
-    writeToStream( mem, dtdToUse, allOnOneLine, includeXmlHeader, encodingType, lineWrapLength );
+    StringBuilder builder( 2048 );
+    writeToStream( builder, dtdToUse, allOnOneLine, includeXmlHeader, encodingType, lineWrapLength );
 
-    return mem.toUTF8();
+    return builder.toString();
 }
 
 void XmlElement::writeToStream( OutputStream& output,
@@ -564,7 +577,7 @@ void XmlElement::setAttribute( const Identifier& attributeName, const int number
 
 void XmlElement::setAttribute( const Identifier& attributeName, const double number )
 {
-    setAttribute( attributeName, String( number, 20 ) );
+    setAttribute( attributeName, String( number ) );
 }
 
 void XmlElement::removeAttribute( const Identifier& attributeName ) noexcept
@@ -852,12 +865,12 @@ String XmlElement::getAllSubText() const
     if (getNumChildElements() == 1)
         return firstChildElement.get()->getAllSubText();
 
-    MemoryOutputStream mem( 1024 );
+    StringBuilder builder( 1024 );
 
     for (const XmlElement* child = firstChildElement; child != nullptr; child = child->nextListItem)
-        mem << child->getAllSubText();
+        builder << child->getAllSubText();
 
-    return mem.toUTF8();
+    return builder.toString();
 }
 
 String XmlElement::getChildElementAllSubText( StringRef childTagName, const String& defaultReturnValue ) const
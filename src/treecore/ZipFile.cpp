@@ -28,6 +28,7 @@
 
 #include "treecore/BufferedInputStream.h"
 #include "treecore/ByteOrder.h"
+#include "treecore/Checksum.h"
 #include "treecore/File.h"
 #include "treecore/FileInputSource.h"
 #include "treecore/FileInputStream.h"
@@ -40,10 +41,6 @@
 #include "treecore/MemoryOutputStream.h"
 #include "treecore/StringRef.h"
 #include "treecore/ZipFile.h"
-extern "C"
-{
-#include "zlib.h"
-}
 
 namespace treecore {
 
@@ -516,7 +513,7 @@ private:
     String storedPathname;
     Time fileTime;
     int compressionLevel, compressedSize, uncompressedSize, headerStart;
-    unsigned long checksum;
+    uint32 checksum;
 
     static void writeTimeAndDate( OutputStream& target, Time t )
     {
@@ -546,7 +543,7 @@ private:
             if (bytesRead < 0)
                 return false;
 
-            checksum = crc32( checksum, buffer, (unsigned int) bytesRead );
+            checksum = checksum_crc32( checksum, buffer, (size_t) bytesRead );
             target.write( buffer, (size_t) bytesRead );
             uncompressedSize += bytesRead;
         }
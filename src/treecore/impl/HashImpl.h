@@ -54,7 +54,7 @@ struct HashTableBase
             , next_entry( next )
         {}
 
-        HashEntry( ItemType& item, HashEntry* next )
+        HashEntry( ItemType&& item, HashEntry* next )
             : item( std::move( item ) )
             , next_entry( next )
         {}
@@ -295,6 +295,12 @@ struct HashTableBase
 
     void clone_slots_from( const HashTableBase& other )
     {
+        if (&other == this)
+            return;
+
+        // entries held before are given back to the pool
+        clear();
+
         int num_slots = other.buckets.size();
         buckets.clearQuick();
         buckets.ensureStorageAllocated( num_slots );
@@ -312,6 +318,8 @@ struct HashTableBase
                 buckets[hashcode] = my_entry;
             }
         }
+
+        num_entries = other.num_entries;
     }
 
     int bucket_index( const KeyType& key ) const noexcept
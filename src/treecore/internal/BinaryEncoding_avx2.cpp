@@ -0,0 +1,216 @@
+//
+// BinaryEncoding kernels for AVX2. This file is compiled with
+// TREECORE_AVX2_KERNEL_FLAGS, and is only called after CPU is checked.
+//
+// Only raw intrinsics may be used here, for the same reason as in
+// FloatVectorOperations_avx2.cpp.
+//
+#include "treecore/simd/avx2.h"
+
+#include "treecore/internal/BinaryEncoding_impl.h"
+
+namespace treecore
+{
+
+namespace
+{
+
+// set in bytes from first to last, as signed bytes
+inline __m256i in_range( const __m256i v, char first, char last ) noexcept
+{
+    return _mm256_and_si256( _mm256_cmpgt_epi8( v, _mm256_set1_epi8( char(first - 1) ) ),
+                             _mm256_cmpgt_epi8( _mm256_set1_epi8( char(last + 1) ), v ) );
+}
+
+//
+// Base64 as of Muła and Lemire, "Faster Base64 Encoding and Decoding using
+// AVX2 Instructions". For encoding, each lane gets 12 bytes, which are
+// spread so that each 32-bit word holds the three bytes of one group. The
+// four 6-bit fields of each word are moved into bytes of their own with
+// multiplications, and turned into characters by adding an offset looked up
+// by the range of value.
+//
+void base64_encode_avx2( const uint8* src, size_t num_bytes, char* dest, Base64Alphabet alphabet ) noexcept
+{
+    const char* const chars = base64_alphabets[alphabet];
+
+    // offsets for A-Z, a-z, 0-9 and the last two characters
+    const char off62 = char(chars[62] - 62);
+    const char off63 = char(chars[63] - 63);
+    const __m256i offsets = _mm256_setr_epi8( 65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, off62, off63, 0, 0,
+                                              65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, off62, off63, 0, 0 );
+    const __m256i spread = _mm256_setr_epi8( 1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+                                             1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10 );
+
+    size_t i = 0;
+
+    // two 16-byte loads of 12 used bytes each
+    for (; i + 28 <= num_bytes; i += 24, dest += 32)
+    {
+        const __m128i lo = _mm_loadu_si128( (const __m128i*) (src + i) );
+        const __m128i hi = _mm_loadu_si128( (const __m128i*) (src + i + 12) );
+        const __m256i in = _mm256_shuffle_epi8( _mm256_inserti128_si256( _mm256_castsi128_si256( lo ), hi, 1 ), spread );
+
+        const __m256i t0 = _mm256_mulhi_epu16( _mm256_and_si256( in, _mm256_set1_epi32( 0x0fc0fc00 ) ),
+                                               _mm256_set1_epi32( 0x04000040 ) );
+        const __m256i t1 = _mm256_mullo_epi16( _mm256_and_si256( in, _mm256_set1_epi32( 0x003f03f0 ) ),
+                                               _mm256_set1_epi32( 0x01000010 ) );
+        const __m256i values = _mm256_or_si256( t0, t1 );
+
+        // index 0 for 0 to 25, 1 for 26 to 51, then 2 to 13 for the rest
+        __m256i index = _mm256_subs_epu8( values, _mm256_set1_epi8( 51 ) );
+        index = _mm256_sub_epi8( index, _mm256_cmpgt_epi8( values, _mm256_set1_epi8( 25 ) ) );
+
+        const __m256i result = _mm256_add_epi8( values, _mm256_shuffle_epi8( offsets, index ) );
+        _mm256_storeu_si256( (__m256i*) dest, result );
+    }
+
+    binenc_base64_encode_scalar( src + i, num_bytes - i, dest, alphabet );
+}
+
+//
+// For decoding, characters are checked against each range of the alphabet,
+// and turned into values by adding the offset of their range. Values are
+// packed into groups of three bytes by multiply-add instructions, and the
+// groups are moved together with shuffles.
+//
+void base64_decode_avx2_block( const __m256i v, uint8* dest, char c62, char c63, __m256i& invalid ) noexcept
+{
+    const __m256i upper = in_range( v, 'A', 'Z' );
+    const __m256i lower = in_range( v, 'a', 'z' );
+    const __m256i digit = in_range( v, '0', '9' );
+    const __m256i is62  = _mm256_cmpeq_epi8( v, _mm256_set1_epi8( c62 ) );
+    const __m256i is63  = _mm256_cmpeq_epi8( v, _mm256_set1_epi8( c63 ) );
+
+    const __m256i valid = _mm256_or_si256( _mm256_or_si256( upper, lower ),
+                                           _mm256_or_si256( digit, _mm256_or_si256( is62, is63 ) ) );
+    invalid = _mm256_or_si256( invalid, _mm256_xor_si256( valid, _mm256_set1_epi8( -1 ) ) );
+
+    __m256i offset = _mm256_and_si256( upper, _mm256_set1_epi8( -65 ) );
+    offset = _mm256_or_si256( offset, _mm256_and_si256( lower, _mm256_set1_epi8( -71 ) ) );
+    offset = _mm256_or_si256( offset, _mm256_and_si256( digit, _mm256_set1_epi8( 4 ) ) );
+    offset = _mm256_or_si256( offset, _mm256_and_si256( is62, _mm256_set1_epi8( char(62 - c62) ) ) );
+    offset = _mm256_or_si256( offset, _mm256_and_si256( is63, _mm256_set1_epi8( char(63 - c63) ) ) );
+
+    const __m256i values = _mm256_add_epi8( v, offset );
+
+    // 16-bit words of two values, then 32-bit words of one whole group
+    const __m256i pairs  = _mm256_maddubs_epi16( values, _mm256_set1_epi32( 0x01400140 ) );
+    const __m256i groups = _mm256_madd_epi16( pairs, _mm256_set1_epi32( 0x00011000 ) );
+
+    // 12 bytes at the bottom of each lane, then both lanes together
+    __m256i packed = _mm256_shuffle_epi8( groups, _mm256_setr_epi8( 2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+                                                                    2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1 ) );
+    packed = _mm256_permutevar8x32_epi32( packed, _mm256_setr_epi32( 0, 1, 2, 4, 5, 6, 3, 7 ) );
+
+    _mm_storeu_si128( (__m128i*) dest, _mm256_castsi256_si128( packed ) );
+    _mm_storel_epi64( (__m128i*) (dest + 16), _mm256_extracti128_si256( packed, 1 ) );
+}
+
+bool base64_decode_avx2( const char* src, size_t num_chars, uint8* dest, Base64Alphabet alphabet ) noexcept
+{
+    const char c62 = base64_alphabets[alphabet][62];
+    const char c63 = base64_alphabets[alphabet][63];
+
+    size_t i = 0;
+
+    while (i + 32 <= num_chars)
+    {
+        // check for invalid characters once in a few blocks
+        __m256i invalid = _mm256_setzero_si256();
+
+        for (int k = 0; k < 4 && i + 32 <= num_chars; k++, i += 32, dest += 24)
+            base64_decode_avx2_block( _mm256_loadu_si256( (const __m256i*) (src + i) ), dest, c62, c63, invalid );
+
+        if ( !_mm256_testz_si256( invalid, invalid ) )
+            return false;
+    }
+
+    return binenc_base64_decode_scalar( src + i, num_chars - i, dest, alphabet );
+}
+
+//
+// Hexadecimal digits are looked up for both nibbles of 32 bytes, and
+// interleaved. Interleaving works within lanes, so halves of the results are
+// exchanged between lanes at the end.
+//
+void hex_encode_avx2( const uint8* src, size_t num_bytes, char* dest, bool upper_case ) noexcept
+{
+    const char* const d = hex_digits[upper_case ? 1 : 0];
+    const __m256i digits = _mm256_setr_epi8( d[0], d[1], d[2], d[3], d[4], d[5], d[6], d[7],
+                                             d[8], d[9], d[10], d[11], d[12], d[13], d[14], d[15],
+                                             d[0], d[1], d[2], d[3], d[4], d[5], d[6], d[7],
+                                             d[8], d[9], d[10], d[11], d[12], d[13], d[14], d[15] );
+    const __m256i low_nibble = _mm256_set1_epi8( 15 );
+
+    size_t i = 0;
+
+    for (; i + 32 <= num_bytes; i += 32)
+    {
+        const __m256i v  = _mm256_loadu_si256( (const __m256i*) (src + i) );
+        const __m256i hi = _mm256_shuffle_epi8( digits, _mm256_and_si256( _mm256_srli_epi16( v, 4 ), low_nibble ) );
+        const __m256i lo = _mm256_shuffle_epi8( digits, _mm256_and_si256( v, low_nibble ) );
+
+        const __m256i a = _mm256_unpacklo_epi8( hi, lo );
+        const __m256i b = _mm256_unpackhi_epi8( hi, lo );
+
+        _mm256_storeu_si256( (__m256i*) (dest + i * 2), _mm256_permute2x128_si256( a, b, 0x20 ) );
+        _mm256_storeu_si256( (__m256i*) (dest + i * 2 + 32), _mm256_permute2x128_si256( a, b, 0x31 ) );
+    }
+
+    binenc_hex_encode_scalar( src + i, num_bytes - i, dest + i * 2, upper_case );
+}
+
+// values of 32 digits, with bits set in invalid for anything else
+inline __m256i hex_digit_values( const __m256i v, __m256i& invalid ) noexcept
+{
+    const __m256i folded = _mm256_or_si256( v, _mm256_set1_epi8( 0x20 ) );
+    const __m256i digit  = in_range( v, '0', '9' );
+    const __m256i letter = in_range( folded, 'a', 'f' );
+
+    invalid = _mm256_or_si256( invalid, _mm256_xor_si256( _mm256_or_si256( digit, letter ), _mm256_set1_epi8( -1 ) ) );
+
+    return _mm256_or_si256( _mm256_and_si256( digit, _mm256_sub_epi8( v, _mm256_set1_epi8( '0' ) ) ),
+                            _mm256_and_si256( letter, _mm256_sub_epi8( folded, _mm256_set1_epi8( 'a' - 10 ) ) ) );
+}
+
+bool hex_decode_avx2( const char* src, size_t num_bytes, uint8* dest ) noexcept
+{
+    // each pair of digits becomes one 16-bit word of high * 16 + low
+    const __m256i weights = _mm256_set1_epi16( 0x0110 );
+
+    size_t i = 0;
+
+    for (; i + 32 <= num_bytes; i += 32)
+    {
+        __m256i invalid = _mm256_setzero_si256();
+
+        const __m256i a = hex_digit_values( _mm256_loadu_si256( (const __m256i*) (src + i * 2) ), invalid );
+        const __m256i b = hex_digit_values( _mm256_loadu_si256( (const __m256i*) (src + i * 2 + 32) ), invalid );
+
+        if ( !_mm256_testz_si256( invalid, invalid ) )
+            return false;
+
+        // packing works within lanes, which leaves quarters out of order
+        const __m256i packed = _mm256_packus_epi16( _mm256_maddubs_epi16( a, weights ), _mm256_maddubs_epi16( b, weights ) );
+        _mm256_storeu_si256( (__m256i*) (dest + i), _mm256_permute4x64_epi64( packed, 0xd8 ) );
+    }
+
+    return binenc_hex_decode_scalar( src + i * 2, num_bytes - i, dest + i );
+}
+
+const BinaryEncodingKernelTable avx2_table = {
+    &base64_encode_avx2,
+    &base64_decode_avx2,
+    &hex_encode_avx2,
+    &hex_decode_avx2,
+};
+
+} // anonymous namespace
+
+const BinaryEncodingKernelTable* get_binary_encoding_kernels_avx2() noexcept
+{
+    return &avx2_table;
+}
+
+} // namespace treecore
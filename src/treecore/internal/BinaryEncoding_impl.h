@@ -0,0 +1,149 @@
+#ifndef TREECORE_BINARY_ENCODING_IMPL_H
+#define TREECORE_BINARY_ENCODING_IMPL_H
+
+#include "treecore/BinaryEncoding.h"
+
+#include <cstring>
+
+namespace treecore
+{
+
+/**
+ * @brief kernels of BinaryEncoding compiled for one instruction set
+ *
+ * Base64 kernels only work on whole groups: num_bytes is a multiple of three
+ * for encoding, and num_chars is a multiple of four without padding for
+ * decoding.
+ */
+struct BinaryEncodingKernelTable
+{
+    void (*base64_encode)( const uint8* src, size_t num_bytes, char* dest, Base64Alphabet alphabet );
+    bool (*base64_decode)( const char* src, size_t num_chars, uint8* dest, Base64Alphabet alphabet );
+    void (*hex_encode)( const uint8* src, size_t num_bytes, char* dest, bool upper_case );
+    bool (*hex_decode)( const char* src, size_t num_bytes, uint8* dest );
+};
+
+const BinaryEncodingKernelTable* get_binary_encoding_kernels_baseline() noexcept;
+const BinaryEncodingKernelTable* get_binary_encoding_kernels_avx2() noexcept;
+
+// Everything below has internal linkage, so that code compiled with wider
+// instruction set flags is never shared with the baseline translation unit
+// by the linker.
+namespace
+{
+
+const char base64_alphabets[2][65] = {
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/",
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_",
+};
+
+const char hex_digits[2][17] = {
+    "0123456789abcdef",
+    "0123456789ABCDEF",
+};
+
+enum
+{
+    BINENC_INVALID = 0xff
+};
+
+// reverse lookup of characters, BINENC_INVALID for those not in alphabet
+struct BinencDecodeTables
+{
+    BinencDecodeTables() noexcept
+    {
+        std::memset( base64, BINENC_INVALID, sizeof(base64) );
+        std::memset( hex, BINENC_INVALID, sizeof(hex) );
+
+        for (int alphabet = 0; alphabet < 2; alphabet++)
+        {
+            for (int i = 0; i < 64; i++)
+                base64[alphabet][uint8( base64_alphabets[alphabet][i] )] = uint8( i );
+
+            for (int i = 0; i < 16; i++)
+                hex[uint8( hex_digits[alphabet][i] )] = uint8( i );
+        }
+    }
+
+    uint8 base64[2][256];
+    uint8 hex[256];
+};
+
+inline const BinencDecodeTables& binenc_decode_tables() noexcept
+{
+    static const BinencDecodeTables tables;
+    return tables;
+}
+
+inline void binenc_base64_encode_scalar( const uint8* src, size_t num_bytes, char* dest, Base64Alphabet alphabet ) noexcept
+{
+    const char* const chars = base64_alphabets[alphabet];
+
+    for (size_t i = 0; i < num_bytes; i += 3, dest += 4)
+    {
+        const uint32 v = (uint32( src[i] ) << 16) | (uint32( src[i + 1] ) << 8) | src[i + 2];
+        dest[0] = chars[v >> 18];
+        dest[1] = chars[(v >> 12) & 63];
+        dest[2] = chars[(v >> 6) & 63];
+        dest[3] = chars[v & 63];
+    }
+}
+
+inline bool binenc_base64_decode_scalar( const char* src, size_t num_chars, uint8* dest, Base64Alphabet alphabet ) noexcept
+{
+    const uint8* const values = binenc_decode_tables().base64[alphabet];
+
+    for (size_t i = 0; i < num_chars; i += 4, dest += 3)
+    {
+        const uint32 a = values[uint8( src[i] )];
+        const uint32 b = values[uint8( src[i + 1] )];
+        const uint32 c = values[uint8( src[i + 2] )];
+        const uint32 d = values[uint8( src[i + 3] )];
+
+        // only invalid characters have the high bit
+        if ( ( (a | b | c | d) & 0x80 ) != 0 )
+            return false;
+
+        const uint32 v = (a << 18) | (b << 12) | (c << 6) | d;
+        dest[0] = uint8( v >> 16 );
+        dest[1] = uint8( v >> 8 );
+        dest[2] = uint8( v );
+    }
+
+    return true;
+}
+
+inline void binenc_hex_encode_scalar( const uint8* src, size_t num_bytes, char* dest, bool upper_case ) noexcept
+{
+    const char* const digits = hex_digits[upper_case ? 1 : 0];
+
+    for (size_t i = 0; i < num_bytes; i++)
+    {
+        dest[i * 2]     = digits[src[i] >> 4];
+        dest[i * 2 + 1] = digits[src[i] & 15];
+    }
+}
+
+inline bool binenc_hex_decode_scalar( const char* src, size_t num_bytes, uint8* dest ) noexcept
+{
+    const uint8* const values = binenc_decode_tables().hex;
+
+    for (size_t i = 0; i < num_bytes; i++)
+    {
+        const uint32 hi = values[uint8( src[i * 2] )];
+        const uint32 lo = values[uint8( src[i * 2 + 1] )];
+
+        if ( ( (hi | lo) & 0x80 ) != 0 )
+            return false;
+
+        dest[i] = uint8( (hi << 4) | lo );
+    }
+
+    return true;
+}
+
+} // anonymous namespace
+
+} // namespace treecore
+
+#endif // TREECORE_BINARY_ENCODING_IMPL_H
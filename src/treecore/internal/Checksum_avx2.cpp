@@ -0,0 +1,74 @@
+//
+// Checksum kernels for AVX2. This file is compiled with
+// TREECORE_AVX2_KERNEL_FLAGS, and is only called after CPU is checked.
+//
+// Only raw intrinsics may be used here, for the same reason as in
+// FloatVectorOperations_avx2.cpp.
+//
+#include "treecore/simd/avx2.h"
+
+#include "treecore/internal/Checksum_impl.h"
+
+namespace treecore
+{
+
+namespace
+{
+
+inline uint32 adler32_hsum( const __m256i v ) noexcept
+{
+    __m128i a = _mm_add_epi32( _mm256_castsi256_si128( v ), _mm256_extracti128_si256( v, 1 ) );
+    a = _mm_add_epi32( a, _mm_shuffle_epi32( a, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+    a = _mm_add_epi32( a, _mm_shuffle_epi32( a, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+    return uint32( _mm_cvtsi128_si32( a ) );
+}
+
+} // anonymous namespace
+
+// the same as adler32_ssse3(), on one 32-byte register per block
+uint32 adler32_avx2( uint32 adler, const uint8* data, size_t num ) noexcept
+{
+    enum { BLOCK = 32 };
+
+    uint32 s1 = adler & 0xffff;
+    uint32 s2 = adler >> 16;
+
+    const __m256i tap  = _mm256_setr_epi8( 32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17,
+                                           16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1 );
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i ones = _mm256_set1_epi16( 1 );
+
+    size_t num_blocks = num / BLOCK;
+    num -= num_blocks * BLOCK;
+
+    while (num_blocks > 0)
+    {
+        // at most NMAX bytes before sums are reduced
+        size_t n = ADLER32_NMAX / BLOCK;
+        if (n > num_blocks)
+            n = num_blocks;
+        num_blocks -= n;
+
+        __m256i v_ps = _mm256_setr_epi32( int(s1 * n), 0, 0, 0, 0, 0, 0, 0 );
+        __m256i v_s2 = _mm256_setr_epi32( int(s2), 0, 0, 0, 0, 0, 0, 0 );
+        __m256i v_s1 = zero;
+
+        for (; n > 0; n--, data += BLOCK)
+        {
+            const __m256i bytes = _mm256_loadu_si256( (const __m256i*) data );
+
+            v_ps = _mm256_add_epi32( v_ps, v_s1 );
+            v_s1 = _mm256_add_epi32( v_s1, _mm256_sad_epu8( bytes, zero ) );
+            v_s2 = _mm256_add_epi32( v_s2, _mm256_madd_epi16( _mm256_maddubs_epi16( bytes, tap ), ones ) );
+        }
+
+        v_s2 = _mm256_add_epi32( v_s2, _mm256_slli_epi32( v_ps, 5 ) );
+
+        s1 = (s1 + adler32_hsum( v_s1 )) % ADLER32_BASE;
+        s2 = adler32_hsum( v_s2 ) % ADLER32_BASE;
+    }
+
+    return adler32_update_scalar( s1 | (s2 << 16), data, num );
+}
+
+} // namespace treecore
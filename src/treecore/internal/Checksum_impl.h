@@ -0,0 +1,145 @@
+#ifndef TREECORE_CHECKSUM_IMPL_H
+#define TREECORE_CHECKSUM_IMPL_H
+
+#include "treecore/IntTypes.h"
+#include "treecore/PlatformDefs.h"
+
+#include <cstddef>
+
+namespace treecore
+{
+
+//
+// Checksum kernels. CRC kernels work on the CRC register, which is the
+// complement of the CRC value, and Adler-32 kernels on the checksum itself.
+//
+typedef uint32 (*ChecksumKernel)( uint32 state, const uint8* data, size_t num );
+
+uint32 crc32_baseline( uint32 state, const uint8* data, size_t num ) noexcept;
+uint32 crc32c_baseline( uint32 state, const uint8* data, size_t num ) noexcept;
+uint32 adler32_baseline( uint32 adler, const uint8* data, size_t num ) noexcept;
+
+// needs PCLMULQDQ in addition to SSE4.2
+uint32 crc32_pclmul( uint32 state, const uint8* data, size_t num ) noexcept;
+uint32 crc32c_sse42( uint32 state, const uint8* data, size_t num ) noexcept;
+uint32 adler32_ssse3( uint32 adler, const uint8* data, size_t num ) noexcept;
+
+uint32 adler32_avx2( uint32 adler, const uint8* data, size_t num ) noexcept;
+
+// Everything below has internal linkage, so that code compiled with wider
+// instruction set flags is never shared with the baseline translation unit
+// by the linker.
+namespace
+{
+
+enum
+{
+    CRC32_POLY  = 0xedb88320u, ///< bit-reflected polynomial of CRC-32
+    CRC32C_POLY = 0x82f63b78u, ///< bit-reflected polynomial of CRC-32C
+
+    ADLER32_BASE = 65521, ///< largest prime below 65536
+    ADLER32_NMAX = 5552   ///< max bytes before sums may overflow 32 bits
+};
+
+/**
+ * @brief tables of slicing-by-8 CRC, for one polynomial
+ *
+ * Row 0 is the usual table of one byte. Row k gives the effect of a byte
+ * followed by k zero bytes.
+ */
+struct CrcTables
+{
+    explicit CrcTables( uint32 poly ) noexcept
+    {
+        for (uint32 i = 0; i < 256; i++)
+        {
+            uint32 c = i;
+            for (int bit = 0; bit < 8; bit++)
+                c = (c & 1) != 0 ? (c >> 1) ^ poly : c >> 1;
+            table[0][i] = c;
+        }
+
+        for (int k = 1; k < 8; k++)
+        {
+            for (int i = 0; i < 256; i++)
+                table[k][i] = (table[k - 1][i] >> 8) ^ table[0][table[k - 1][i] & 0xff];
+        }
+    }
+
+    uint32 table[8][256];
+};
+
+inline const CrcTables& crc32_tables() noexcept
+{
+    static const CrcTables tables( CRC32_POLY );
+    return tables;
+}
+
+inline const CrcTables& crc32c_tables() noexcept
+{
+    static const CrcTables tables( CRC32C_POLY );
+    return tables;
+}
+
+inline uint32 crc_load_le32( const uint8* p ) noexcept
+{
+    return uint32( p[0] ) | (uint32( p[1] ) << 8) | (uint32( p[2] ) << 16) | (uint32( p[3] ) << 24);
+}
+
+inline uint32 crc_update_tables( const CrcTables& tables, uint32 c, const uint8* data, size_t num ) noexcept
+{
+    const uint32 (*t)[256] = tables.table;
+
+    for (; num >= 8; data += 8, num -= 8)
+    {
+        const uint32 lo = crc_load_le32( data ) ^ c;
+        const uint32 hi = crc_load_le32( data + 4 );
+
+        c = t[7][lo & 0xff] ^ t[6][(lo >> 8) & 0xff] ^ t[5][(lo >> 16) & 0xff] ^ t[4][lo >> 24]
+            ^ t[3][hi & 0xff] ^ t[2][(hi >> 8) & 0xff] ^ t[1][(hi >> 16) & 0xff] ^ t[0][hi >> 24];
+    }
+
+    for (size_t i = 0; i < num; i++)
+        c = t[0][(c ^ data[i]) & 0xff] ^ (c >> 8);
+
+    return c;
+}
+
+inline uint32 adler32_update_scalar( uint32 adler, const uint8* data, size_t num ) noexcept
+{
+    uint32 s1 = adler & 0xffff;
+    uint32 s2 = adler >> 16;
+
+    while (num > 0)
+    {
+        const size_t num_this_time = num < ADLER32_NMAX ? num : size_t( ADLER32_NMAX );
+        size_t i = 0;
+
+        for (; i + 4 <= num_this_time; i += 4)
+        {
+            s1 += data[i];     s2 += s1;
+            s1 += data[i + 1]; s2 += s1;
+            s1 += data[i + 2]; s2 += s1;
+            s1 += data[i + 3]; s2 += s1;
+        }
+
+        for (; i < num_this_time; i++)
+        {
+            s1 += data[i];
+            s2 += s1;
+        }
+
+        s1 %= ADLER32_BASE;
+        s2 %= ADLER32_BASE;
+        data += num_this_time;
+        num  -= num_this_time;
+    }
+
+    return s1 | (s2 << 16);
+}
+
+} // anonymous namespace
+
+} // namespace treecore
+
+#endif // TREECORE_CHECKSUM_IMPL_H
@@ -0,0 +1,289 @@
+//
+// Checksum kernels for SSE4.2. This file is compiled with
+// TREECORE_SSE42_KERNEL_FLAGS, and is only called after CPU is checked.
+// crc32_pclmul() also needs PCLMULQDQ, which is checked separately.
+//
+// Only raw intrinsics may be used here, for the same reason as in
+// FloatVectorOperations_avx2.cpp.
+//
+#include "treecore/internal/Checksum_impl.h"
+
+#include <cstring>
+
+#include <nmmintrin.h>
+#include <tmmintrin.h>
+#include <wmmintrin.h>
+
+namespace treecore
+{
+
+namespace
+{
+
+//
+// CRC-32C with the crc32 instruction of SSE4.2, as in crc32c.c of Mark
+// Adler. The instruction has a latency of three cycles, so three blocks are
+// computed at once, each starting from a zero register. Results are
+// combined by shifting the register of one block over the length of the
+// next one, which is linear, so that the shift is looked up by each byte of
+// register.
+//
+enum
+{
+    CRC32C_LONG  = 8192,
+    CRC32C_SHORT = 256
+};
+
+// the crc32 instruction on 64-bit words only exists in 64-bit mode
+inline uint64 crc32c_word( uint64 crc, const uint8* p ) noexcept
+{
+#if TREECORE_SIZE_PTR == 8
+    uint64 v;
+    std::memcpy( &v, p, 8 );
+    return _mm_crc32_u64( crc, v );
+#else
+    uint32 v[2];
+    std::memcpy( v, p, 8 );
+    return _mm_crc32_u32( _mm_crc32_u32( uint32( crc ), v[0] ), v[1] );
+#endif
+}
+
+inline uint32 crc32c_shift( const uint32 table[4][256], uint32 c ) noexcept
+{
+    return table[0][c & 0xff] ^ table[1][(c >> 8) & 0xff] ^ table[2][(c >> 16) & 0xff] ^ table[3][c >> 24];
+}
+
+struct Crc32cShiftTables
+{
+    Crc32cShiftTables() noexcept
+    {
+        build( long_shift, CRC32C_LONG );
+        build( short_shift, CRC32C_SHORT );
+    }
+
+    static void build( uint32 table[4][256], size_t num_zeros ) noexcept
+    {
+        // register of each single bit, after num_zeros zero bytes
+        const uint8 zeros[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+        uint32 bits[32];
+
+        for (int i = 0; i < 32; i++)
+        {
+            uint64 c = uint32( 1 ) << i;
+            for (size_t k = 0; k < num_zeros; k += 8)
+                c = crc32c_word( c, zeros );
+            bits[i] = uint32( c );
+        }
+
+        for (int k = 0; k < 4; k++)
+        {
+            for (int value = 0; value < 256; value++)
+            {
+                uint32 c = 0;
+                for (int bit = 0; bit < 8; bit++)
+                {
+                    if ( (value >> bit) & 1 )
+                        c ^= bits[k * 8 + bit];
+                }
+                table[k][value] = c;
+            }
+        }
+    }
+
+    uint32 long_shift[4][256];
+    uint32 short_shift[4][256];
+};
+
+const Crc32cShiftTables& crc32c_shift_tables() noexcept
+{
+    static const Crc32cShiftTables tables;
+    return tables;
+}
+
+template<size_t BLOCK>
+inline uint64 crc32c_three_blocks( uint64 crc0, const uint8*& data, size_t& num, const uint32 shift[4][256] ) noexcept
+{
+    while (num >= BLOCK * 3)
+    {
+        uint64 crc1 = 0;
+        uint64 crc2 = 0;
+
+        for (size_t i = 0; i < BLOCK; i += 8)
+        {
+            crc0 = crc32c_word( crc0, data + i );
+            crc1 = crc32c_word( crc1, data + BLOCK + i );
+            crc2 = crc32c_word( crc2, data + BLOCK * 2 + i );
+        }
+
+        crc0 = crc32c_shift( shift, uint32( crc0 ) ) ^ crc1;
+        crc0 = crc32c_shift( shift, uint32( crc0 ) ) ^ crc2;
+
+        data += BLOCK * 3;
+        num  -= BLOCK * 3;
+    }
+
+    return crc0;
+}
+
+//
+// CRC-32 by folding with carry-less multiplication, as of Gopal et al.,
+// "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ
+// Instruction". Four 16-byte registers are folded over 64 bytes at a time,
+// then into one register, which is reduced to 32 bits by Barrett reduction.
+// Constants are those of the paper for the bit-reflected CRC-32 polynomial.
+//
+uint32 crc32_fold( uint32 state, const uint8* data, size_t num ) noexcept
+{
+    const __m128i k1k2 = _mm_set_epi64x( 0x01c6e41596ll, 0x0154442bd4ll );
+    const __m128i k3k4 = _mm_set_epi64x( 0x00ccaa009ell, 0x01751997d0ll );
+    const __m128i k5k0 = _mm_set_epi64x( 0, 0x0163cd6124ll );
+    const __m128i poly = _mm_set_epi64x( 0x01f7011641ll, 0x01db710641ll );
+    const __m128i low32 = _mm_setr_epi32( -1, 0, -1, 0 );
+
+    __m128i x1 = _mm_xor_si128( _mm_loadu_si128( (const __m128i*) data ), _mm_cvtsi32_si128( int(state) ) );
+    __m128i x2 = _mm_loadu_si128( (const __m128i*) (data + 16) );
+    __m128i x3 = _mm_loadu_si128( (const __m128i*) (data + 32) );
+    __m128i x4 = _mm_loadu_si128( (const __m128i*) (data + 48) );
+    data += 64;
+    num  -= 64;
+
+    for (; num >= 64; data += 64, num -= 64)
+    {
+        const __m128i x5 = _mm_clmulepi64_si128( x1, k1k2, 0x00 );
+        const __m128i x6 = _mm_clmulepi64_si128( x2, k1k2, 0x00 );
+        const __m128i x7 = _mm_clmulepi64_si128( x3, k1k2, 0x00 );
+        const __m128i x8 = _mm_clmulepi64_si128( x4, k1k2, 0x00 );
+
+        x1 = _mm_clmulepi64_si128( x1, k1k2, 0x11 );
+        x2 = _mm_clmulepi64_si128( x2, k1k2, 0x11 );
+        x3 = _mm_clmulepi64_si128( x3, k1k2, 0x11 );
+        x4 = _mm_clmulepi64_si128( x4, k1k2, 0x11 );
+
+        x1 = _mm_xor_si128( _mm_xor_si128( x1, x5 ), _mm_loadu_si128( (const __m128i*) data ) );
+        x2 = _mm_xor_si128( _mm_xor_si128( x2, x6 ), _mm_loadu_si128( (const __m128i*) (data + 16) ) );
+        x3 = _mm_xor_si128( _mm_xor_si128( x3, x7 ), _mm_loadu_si128( (const __m128i*) (data + 32) ) );
+        x4 = _mm_xor_si128( _mm_xor_si128( x4, x8 ), _mm_loadu_si128( (const __m128i*) (data + 48) ) );
+    }
+
+    // fold four registers into one, then the rest of 16-byte blocks
+    x1 = _mm_xor_si128( _mm_xor_si128( _mm_clmulepi64_si128( x1, k3k4, 0x11 ), _mm_clmulepi64_si128( x1, k3k4, 0x00 ) ), x2 );
+    x1 = _mm_xor_si128( _mm_xor_si128( _mm_clmulepi64_si128( x1, k3k4, 0x11 ), _mm_clmulepi64_si128( x1, k3k4, 0x00 ) ), x3 );
+    x1 = _mm_xor_si128( _mm_xor_si128( _mm_clmulepi64_si128( x1, k3k4, 0x11 ), _mm_clmulepi64_si128( x1, k3k4, 0x00 ) ), x4 );
+
+    for (; num >= 16; data += 16, num -= 16)
+    {
+        const __m128i next = _mm_loadu_si128( (const __m128i*) data );
+        x1 = _mm_xor_si128( _mm_xor_si128( _mm_clmulepi64_si128( x1, k3k4, 0x11 ), _mm_clmulepi64_si128( x1, k3k4, 0x00 ) ), next );
+    }
+
+    // 128 bits to 64
+    x1 = _mm_xor_si128( _mm_srli_si128( x1, 8 ), _mm_clmulepi64_si128( x1, k3k4, 0x10 ) );
+    x1 = _mm_xor_si128( _mm_srli_si128( x1, 4 ), _mm_clmulepi64_si128( _mm_and_si128( x1, low32 ), k5k0, 0x00 ) );
+
+    // Barrett reduction to 32 bits
+    __m128i x2r = _mm_clmulepi64_si128( _mm_and_si128( x1, low32 ), poly, 0x10 );
+    x2r = _mm_clmulepi64_si128( _mm_and_si128( x2r, low32 ), poly, 0x00 );
+    x1  = _mm_xor_si128( x1, x2r );
+
+    return uint32( _mm_extract_epi32( x1, 1 ) );
+}
+
+//
+// Adler-32 as in adler32_simd.c of Chromium. For each 32-byte block, the
+// sum of bytes is added to s1, and the bytes weighted by their distance from
+// the end of block to s2. Each block also adds 32 times the previous s1 to
+// s2, which is accumulated separately and multiplied at the end.
+//
+inline uint32 adler32_hsum( const __m128i v ) noexcept
+{
+    const __m128i a = _mm_add_epi32( v, _mm_shuffle_epi32( v, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+    const __m128i b = _mm_add_epi32( a, _mm_shuffle_epi32( a, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+    return uint32( _mm_cvtsi128_si32( b ) );
+}
+
+} // anonymous namespace
+
+uint32 crc32_pclmul( uint32 state, const uint8* data, size_t num ) noexcept
+{
+    if (num >= 64)
+    {
+        const size_t num_folded = num & ~size_t( 15 );
+        state = crc32_fold( state, data, num_folded );
+        data += num_folded;
+        num  -= num_folded;
+    }
+
+    return crc_update_tables( crc32_tables(), state, data, num );
+}
+
+uint32 crc32c_sse42( uint32 state, const uint8* data, size_t num ) noexcept
+{
+    uint64 crc = state;
+
+    if (num >= CRC32C_SHORT * 3)
+    {
+        const Crc32cShiftTables& tables = crc32c_shift_tables();
+        crc = crc32c_three_blocks<CRC32C_LONG>( crc, data, num, tables.long_shift );
+        crc = crc32c_three_blocks<CRC32C_SHORT>( crc, data, num, tables.short_shift );
+    }
+
+    for (; num >= 8; data += 8, num -= 8)
+        crc = crc32c_word( crc, data );
+
+    uint32 c = uint32( crc );
+    for (size_t i = 0; i < num; i++)
+        c = _mm_crc32_u8( c, data[i] );
+
+    return c;
+}
+
+uint32 adler32_ssse3( uint32 adler, const uint8* data, size_t num ) noexcept
+{
+    enum { BLOCK = 32 };
+
+    uint32 s1 = adler & 0xffff;
+    uint32 s2 = adler >> 16;
+
+    const __m128i tap1 = _mm_setr_epi8( 32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17 );
+    const __m128i tap2 = _mm_setr_epi8( 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1 );
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ones = _mm_set1_epi16( 1 );
+
+    size_t num_blocks = num / BLOCK;
+    num -= num_blocks * BLOCK;
+
+    while (num_blocks > 0)
+    {
+        // at most NMAX bytes before sums are reduced
+        size_t n = ADLER32_NMAX / BLOCK;
+        if (n > num_blocks)
+            n = num_blocks;
+        num_blocks -= n;
+
+        __m128i v_ps = _mm_setr_epi32( int(s1 * n), 0, 0, 0 );
+        __m128i v_s2 = _mm_setr_epi32( int(s2), 0, 0, 0 );
+        __m128i v_s1 = zero;
+
+        for (; n > 0; n--, data += BLOCK)
+        {
+            const __m128i bytes1 = _mm_loadu_si128( (const __m128i*) data );
+            const __m128i bytes2 = _mm_loadu_si128( (const __m128i*) (data + 16) );
+
+            v_ps = _mm_add_epi32( v_ps, v_s1 );
+
+            v_s1 = _mm_add_epi32( v_s1, _mm_sad_epu8( bytes1, zero ) );
+            v_s2 = _mm_add_epi32( v_s2, _mm_madd_epi16( _mm_maddubs_epi16( bytes1, tap1 ), ones ) );
+            v_s1 = _mm_add_epi32( v_s1, _mm_sad_epu8( bytes2, zero ) );
+            v_s2 = _mm_add_epi32( v_s2, _mm_madd_epi16( _mm_maddubs_epi16( bytes2, tap2 ), ones ) );
+        }
+
+        v_s2 = _mm_add_epi32( v_s2, _mm_slli_epi32( v_ps, 5 ) );
+
+        s1 = (s1 + adler32_hsum( v_s1 )) % ADLER32_BASE;
+        s2 = adler32_hsum( v_s2 ) % ADLER32_BASE;
+    }
+
+    return adler32_update_scalar( s1 | (s2 << 16), data, num );
+}
+
+} // namespace treecore
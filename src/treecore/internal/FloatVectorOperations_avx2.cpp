@@ -0,0 +1,73 @@
+//
+// FloatVectorOperations kernels for AVX2 + FMA. This file is compiled with
+// TREECORE_AVX2_KERNEL_FLAGS, and is only called after CPU is checked.
+//
+// Only SIMDType<32> functions may be used here: 16-byte functions are also
+// instantiated by baseline code, and the linker could keep the copy compiled
+// with AVX encoding.
+//
+#include "treecore/simd/avx2.h"
+
+#include "treecore/internal/FloatVectorOperations_impl.h"
+
+namespace treecore
+{
+
+namespace
+{
+
+struct Avx2Ops
+{
+    typedef SIMDType<32> VecType;
+    enum { N_FLOAT = 8 };
+
+    static VecType zero() noexcept                   { VecType r; simd_broadcast<float>( r, 0.0f ); return r; }
+    static VecType broadcast( float value ) noexcept { VecType r; simd_broadcast<float>( r, value ); return r; }
+
+    static VecType load( const float* src ) noexcept { VecType r; simd_set_all<float>( r, src ); return r; }
+    static void    store( float* dest, const VecType& value ) noexcept { _mm256_store_ps( dest, value.simd_by_float ); }
+
+    static VecType load_int32( const int32* src ) noexcept
+    {
+        VecType i, r;
+        simd_set_all<int32>( i, src );
+        simd_convert<float, int32>( r, i );
+        return r;
+    }
+
+    static VecType load_int16( const int16* src ) noexcept
+    {
+        VecType r;
+        r.simd_by_float = _mm256_cvtepi32_ps( _mm256_cvtepi16_epi32( _mm_loadu_si128( (const __m128i*) src ) ) );
+        return r;
+    }
+
+    static VecType add( const VecType& a, const VecType& b ) noexcept { VecType r; simd_add<float>( r, a, b ); return r; }
+    static VecType mul( const VecType& a, const VecType& b ) noexcept { VecType r; simd_mul<float>( r, a, b ); return r; }
+
+    static VecType mul_add( const VecType& a, const VecType& b, const VecType& c ) noexcept { VecType r; simd_mul_add<float>( r, a, b, c ); return r; }
+
+    static VecType min( const VecType& a, const VecType& b ) noexcept { VecType r; simd_min<float>( r, a, b ); return r; }
+    static VecType max( const VecType& a, const VecType& b ) noexcept { VecType r; simd_max<float>( r, a, b ); return r; }
+    static VecType abs( const VecType& a ) noexcept { VecType r; simd_abs<float>( r, a ); return r; }
+
+    static float reduce_add( const VecType& a ) noexcept
+    {
+        __m128 half = _mm_add_ps( _mm256_castps256_ps128( a.simd_by_float ), _mm256_extractf128_ps( a.simd_by_float, 1 ) );
+        half = _mm_add_ps( half, _mm_movehl_ps( half, half ) );
+        half = _mm_add_ss( half, _mm_shuffle_ps( half, half, 1 ) );
+        return _mm_cvtss_f32( half );
+    }
+
+    static float reduce_min( const VecType& a ) noexcept { return simd_reduce_min<float>( a ); }
+    static float reduce_max( const VecType& a ) noexcept { return simd_reduce_max<float>( a ); }
+};
+
+} // anonymous namespace
+
+const FloatVectorKernelTable* get_float_vector_kernels_avx2() noexcept
+{
+    return &FloatVectorKernels<Avx2Ops>::table;
+}
+
+} // namespace treecore
@@ -0,0 +1,370 @@
+#ifndef TREECORE_FLOAT_VECTOR_OPERATIONS_IMPL_H
+#define TREECORE_FLOAT_VECTOR_OPERATIONS_IMPL_H
+
+#include "treecore/IntTypes.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace treecore
+{
+
+/**
+ * @brief kernels of FloatVectorOperations compiled for one instruction set
+ *
+ * Each instruction set has its own translation unit, compiled with its own
+ * flags, which fills one table from FloatVectorKernels.
+ */
+struct FloatVectorKernelTable
+{
+    void (*add)( float* dest, const float* a, const float* b, int num );
+    void (*add_scalar)( float* dest, const float* src, float amount, int num );
+    void (*multiply)( float* dest, const float* a, const float* b, int num );
+    void (*multiply_scalar)( float* dest, const float* src, float multiplier, int num );
+    void (*multiply_add)( float* dest, const float* a, const float* b, int num );
+    void (*multiply_add_scalar)( float* dest, const float* src, float multiplier, int num );
+    void (*min)( float* dest, const float* a, const float* b, int num );
+    void (*min_scalar)( float* dest, const float* src, float comp, int num );
+    void (*max)( float* dest, const float* a, const float* b, int num );
+    void (*max_scalar)( float* dest, const float* src, float comp, int num );
+    void (*clip)( float* dest, const float* src, float low, float high, int num );
+    void (*abs)( float* dest, const float* src, int num );
+    void (*convert_int32)( float* dest, const int32* src, float multiplier, int num );
+    void (*convert_int16)( float* dest, const int16* src, float multiplier, int num );
+    float (*sum)( const float* src, int num );
+    float (*dot_product)( const float* a, const float* b, int num );
+    float (*find_minimum)( const float* src, int num );
+    float (*find_maximum)( const float* src, int num );
+};
+
+const FloatVectorKernelTable* get_float_vector_kernels_baseline() noexcept;
+const FloatVectorKernelTable* get_float_vector_kernels_avx2() noexcept;
+
+// Everything below has internal linkage, so that code compiled with wider
+// instruction set flags is never shared with the baseline translation unit
+// by the linker.
+namespace
+{
+
+//
+// Ops must provide VecType, N_FLOAT, and these static functions:
+// zero, broadcast, load (unaligned), store (aligned), load_int32, load_int16,
+// add, mul, mul_add (a * b + c), min, max, abs, reduce_add, reduce_min,
+// reduce_max.
+//
+template<typename Ops>
+struct FloatVectorKernels
+{
+    typedef typename Ops::VecType VecType;
+    enum { N = Ops::N_FLOAT };
+
+    // number of elements to process one by one, until dest is aligned
+    static int head_length( const float* dest, int num ) noexcept
+    {
+        const size_t misalign = size_t( reinterpret_cast<uintptr_t>(dest) % sizeof(VecType) );
+        const int head = misalign == 0 ? 0 : int( (sizeof(VecType) - misalign) / sizeof(float) );
+        return head < num ? head : num;
+    }
+
+    template<typename Func>
+    static void map( float* dest, const float* src, int num, const Func& func ) noexcept
+    {
+        int i = 0;
+        for (const int head = head_length( dest, num ); i < head; i++)
+            dest[i] = func( src[i] );
+        for (; i + N <= num; i += N)
+            Ops::store( dest + i, func( Ops::load( src + i ) ) );
+        for (; i < num; i++)
+            dest[i] = func( src[i] );
+    }
+
+    template<typename Func>
+    static void map( float* dest, const float* a, const float* b, int num, const Func& func ) noexcept
+    {
+        int i = 0;
+        for (const int head = head_length( dest, num ); i < head; i++)
+            dest[i] = func( a[i], b[i] );
+        for (; i + N <= num; i += N)
+            Ops::store( dest + i, func( Ops::load( a + i ), Ops::load( b + i ) ) );
+        for (; i < num; i++)
+            dest[i] = func( a[i], b[i] );
+    }
+
+    struct AddFunc
+    {
+        float   operator () ( float a, float b ) const noexcept { return a + b; }
+        VecType operator () ( const VecType& a, const VecType& b ) const noexcept { return Ops::add( a, b ); }
+    };
+
+    struct MulFunc
+    {
+        float   operator () ( float a, float b ) const noexcept { return a * b; }
+        VecType operator () ( const VecType& a, const VecType& b ) const noexcept { return Ops::mul( a, b ); }
+    };
+
+    struct MinFunc
+    {
+        float   operator () ( float a, float b ) const noexcept { return a < b ? a : b; }
+        VecType operator () ( const VecType& a, const VecType& b ) const noexcept { return Ops::min( a, b ); }
+    };
+
+    struct MaxFunc
+    {
+        float   operator () ( float a, float b ) const noexcept { return a > b ? a : b; }
+        VecType operator () ( const VecType& a, const VecType& b ) const noexcept { return Ops::max( a, b ); }
+    };
+
+    // applies binary Func with a constant right operand
+    template<typename Func>
+    struct BindScalar
+    {
+        explicit BindScalar( float value ) noexcept: s( value ), v( Ops::broadcast( value ) ) {}
+
+        float   operator () ( float a ) const noexcept { return func( a, s ); }
+        VecType operator () ( const VecType& a ) const noexcept { return func( a, v ); }
+
+        Func func;
+        float s;
+        VecType v;
+    };
+
+    struct ClipFunc
+    {
+        ClipFunc( float low, float high ) noexcept
+            : low_s( low ), high_s( high )
+            , low_v( Ops::broadcast( low ) ), high_v( Ops::broadcast( high ) ) {}
+
+        float operator () ( float a ) const noexcept
+        {
+            a = a > low_s ? a : low_s;
+            return a < high_s ? a : high_s;
+        }
+
+        VecType operator () ( const VecType& a ) const noexcept { return Ops::min( Ops::max( a, low_v ), high_v ); }
+
+        float low_s, high_s;
+        VecType low_v, high_v;
+    };
+
+    struct AbsFunc
+    {
+        // not std::fabs, which may be an out-of-line function shared by all
+        // translation units
+        float operator () ( float a ) const noexcept
+        {
+            union { float f; uint32 i; } bits;
+            bits.f  = a;
+            bits.i &= 0x7fffffffu;
+            return bits.f;
+        }
+
+        VecType operator () ( const VecType& a ) const noexcept { return Ops::abs( a ); }
+    };
+
+    static void add( float* dest, const float* a, const float* b, int num ) noexcept
+    {
+        map( dest, a, b, num, AddFunc() );
+    }
+
+    static void add_scalar( float* dest, const float* src, float amount, int num ) noexcept
+    {
+        map( dest, src, num, BindScalar<AddFunc>( amount ) );
+    }
+
+    static void multiply( float* dest, const float* a, const float* b, int num ) noexcept
+    {
+        map( dest, a, b, num, MulFunc() );
+    }
+
+    static void multiply_scalar( float* dest, const float* src, float multiplier, int num ) noexcept
+    {
+        map( dest, src, num, BindScalar<MulFunc>( multiplier ) );
+    }
+
+    static void multiply_add( float* dest, const float* a, const float* b, int num ) noexcept
+    {
+        int i = 0;
+        for (const int head = head_length( dest, num ); i < head; i++)
+            dest[i] += a[i] * b[i];
+        for (; i + N <= num; i += N)
+            Ops::store( dest + i, Ops::mul_add( Ops::load( a + i ), Ops::load( b + i ), Ops::load( dest + i ) ) );
+        for (; i < num; i++)
+            dest[i] += a[i] * b[i];
+    }
+
+    static void multiply_add_scalar( float* dest, const float* src, float multiplier, int num ) noexcept
+    {
+        const VecType mult = Ops::broadcast( multiplier );
+
+        int i = 0;
+        for (const int head = head_length( dest, num ); i < head; i++)
+            dest[i] += src[i] * multiplier;
+        for (; i + N <= num; i += N)
+            Ops::store( dest + i, Ops::mul_add( Ops::load( src + i ), mult, Ops::load( dest + i ) ) );
+        for (; i < num; i++)
+            dest[i] += src[i] * multiplier;
+    }
+
+    static void min( float* dest, const float* a, const float* b, int num ) noexcept
+    {
+        map( dest, a, b, num, MinFunc() );
+    }
+
+    static void min_scalar( float* dest, const float* src, float comp, int num ) noexcept
+    {
+        map( dest, src, num, BindScalar<MinFunc>( comp ) );
+    }
+
+    static void max( float* dest, const float* a, const float* b, int num ) noexcept
+    {
+        map( dest, a, b, num, MaxFunc() );
+    }
+
+    static void max_scalar( float* dest, const float* src, float comp, int num ) noexcept
+    {
+        map( dest, src, num, BindScalar<MaxFunc>( comp ) );
+    }
+
+    static void clip( float* dest, const float* src, float low, float high, int num ) noexcept
+    {
+        map( dest, src, num, ClipFunc( low, high ) );
+    }
+
+    static void abs( float* dest, const float* src, int num ) noexcept
+    {
+        map( dest, src, num, AbsFunc() );
+    }
+
+    static void convert_int32( float* dest, const int32* src, float multiplier, int num ) noexcept
+    {
+        const VecType mult = Ops::broadcast( multiplier );
+
+        int i = 0;
+        for (const int head = head_length( dest, num ); i < head; i++)
+            dest[i] = float( src[i] ) * multiplier;
+        for (; i + N <= num; i += N)
+            Ops::store( dest + i, Ops::mul( Ops::load_int32( src + i ), mult ) );
+        for (; i < num; i++)
+            dest[i] = float( src[i] ) * multiplier;
+    }
+
+    static void convert_int16( float* dest, const int16* src, float multiplier, int num ) noexcept
+    {
+        const VecType mult = Ops::broadcast( multiplier );
+
+        int i = 0;
+        for (const int head = head_length( dest, num ); i < head; i++)
+            dest[i] = float( src[i] ) * multiplier;
+        for (; i + N <= num; i += N)
+            Ops::store( dest + i, Ops::mul( Ops::load_int16( src + i ), mult ) );
+        for (; i < num; i++)
+            dest[i] = float( src[i] ) * multiplier;
+    }
+
+    // reductions use four accumulators to hide instruction latency
+    static float sum( const float* src, int num ) noexcept
+    {
+        VecType acc0 = Ops::zero(), acc1 = Ops::zero(), acc2 = Ops::zero(), acc3 = Ops::zero();
+
+        int i = 0;
+        for (; i + 4 * N <= num; i += 4 * N)
+        {
+            acc0 = Ops::add( acc0, Ops::load( src + i ) );
+            acc1 = Ops::add( acc1, Ops::load( src + i + N ) );
+            acc2 = Ops::add( acc2, Ops::load( src + i + 2 * N ) );
+            acc3 = Ops::add( acc3, Ops::load( src + i + 3 * N ) );
+        }
+        for (; i + N <= num; i += N)
+            acc0 = Ops::add( acc0, Ops::load( src + i ) );
+
+        float result = Ops::reduce_add( Ops::add( Ops::add( acc0, acc1 ), Ops::add( acc2, acc3 ) ) );
+        for (; i < num; i++)
+            result += src[i];
+        return result;
+    }
+
+    static float dot_product( const float* a, const float* b, int num ) noexcept
+    {
+        VecType acc0 = Ops::zero(), acc1 = Ops::zero(), acc2 = Ops::zero(), acc3 = Ops::zero();
+
+        int i = 0;
+        for (; i + 4 * N <= num; i += 4 * N)
+        {
+            acc0 = Ops::mul_add( Ops::load( a + i ),         Ops::load( b + i ),         acc0 );
+            acc1 = Ops::mul_add( Ops::load( a + i + N ),     Ops::load( b + i + N ),     acc1 );
+            acc2 = Ops::mul_add( Ops::load( a + i + 2 * N ), Ops::load( b + i + 2 * N ), acc2 );
+            acc3 = Ops::mul_add( Ops::load( a + i + 3 * N ), Ops::load( b + i + 3 * N ), acc3 );
+        }
+        for (; i + N <= num; i += N)
+            acc0 = Ops::mul_add( Ops::load( a + i ), Ops::load( b + i ), acc0 );
+
+        float result = Ops::reduce_add( Ops::add( Ops::add( acc0, acc1 ), Ops::add( acc2, acc3 ) ) );
+        for (; i < num; i++)
+            result += a[i] * b[i];
+        return result;
+    }
+
+    static float find_minimum( const float* src, int num ) noexcept
+    {
+        if (num <= 0)
+            return 0.0f;
+
+        VecType acc = Ops::broadcast( src[0] );
+
+        int i = 0;
+        for (; i + N <= num; i += N)
+            acc = Ops::min( acc, Ops::load( src + i ) );
+
+        float result = Ops::reduce_min( acc );
+        for (; i < num; i++)
+            result = src[i] < result ? src[i] : result;
+        return result;
+    }
+
+    static float find_maximum( const float* src, int num ) noexcept
+    {
+        if (num <= 0)
+            return 0.0f;
+
+        VecType acc = Ops::broadcast( src[0] );
+
+        int i = 0;
+        for (; i + N <= num; i += N)
+            acc = Ops::max( acc, Ops::load( src + i ) );
+
+        float result = Ops::reduce_max( acc );
+        for (; i < num; i++)
+            result = src[i] > result ? src[i] : result;
+        return result;
+    }
+
+    static const FloatVectorKernelTable table;
+};
+
+template<typename Ops>
+const FloatVectorKernelTable FloatVectorKernels<Ops>::table = {
+    &FloatVectorKernels<Ops>::add,
+    &FloatVectorKernels<Ops>::add_scalar,
+    &FloatVectorKernels<Ops>::multiply,
+    &FloatVectorKernels<Ops>::multiply_scalar,
+    &FloatVectorKernels<Ops>::multiply_add,
+    &FloatVectorKernels<Ops>::multiply_add_scalar,
+    &FloatVectorKernels<Ops>::min,
+    &FloatVectorKernels<Ops>::min_scalar,
+    &FloatVectorKernels<Ops>::max,
+    &FloatVectorKernels<Ops>::max_scalar,
+    &FloatVectorKernels<Ops>::clip,
+    &FloatVectorKernels<Ops>::abs,
+    &FloatVectorKernels<Ops>::convert_int32,
+    &FloatVectorKernels<Ops>::convert_int16,
+    &FloatVectorKernels<Ops>::sum,
+    &FloatVectorKernels<Ops>::dot_product,
+    &FloatVectorKernels<Ops>::find_minimum,
+    &FloatVectorKernels<Ops>::find_maximum,
+};
+
+} // anonymous namespace
+
+} // namespace treecore
+
+#endif // TREECORE_FLOAT_VECTOR_OPERATIONS_IMPL_H
@@ -0,0 +1,211 @@
+#include "treecore/internal/JSONScanner.h"
+#include "treecore/CpuDispatch.h"
+#include "treecore/DebugUtils.h"
+#include "treecore/MathsFunctions.h"
+#include "treecore/SimdFunc.h"
+
+#include <cstring>
+
+#if TREECORE_COMPILER_MSVC
+#    include <intrin.h>
+#endif
+
+namespace treecore
+{
+
+namespace
+{
+
+typedef SIMDType<16> VecType;
+
+// 16-byte registers have no int8 broadcast, repeat the byte in an int32
+inline VecType json_bytes( uint8 value ) noexcept
+{
+    VecType r;
+    simd_broadcast<int32>( r, int32( value * 0x01010101u ) );
+    return r;
+}
+
+inline uint64 json_mask_equal( const VecType& v, uint8 value ) noexcept
+{
+    VecType r;
+    simd_cmp<int8>( r, v, json_bytes( value ) );
+    return uint64( simd_movemask<int8>( r ) );
+}
+
+// baseline classification, on SSE2 registers
+void classify_baseline( const uint8* data, size_t num_blocks, JsonBlockMasks* masks ) noexcept
+{
+    for (size_t block = 0; block < num_blocks; block++)
+    {
+        JsonBlockMasks& m = masks[block];
+        m.quote = m.backslash = m.whitespace = m.op = 0;
+
+        for (int i = 0; i < 4; i++)
+        {
+            VecType v, a, b;
+            simd_set_all<int32>( v, (const int32*) (data + block * 64 + i * 16) );
+
+            // 9 to 13 are the only bytes between 8 and 14 as signed bytes
+            simd_gt<int8>( a, v, json_bytes( 8 ) );
+            simd_lt<int8>( b, v, json_bytes( 14 ) );
+            simd_and<int32>( a, a, b );
+            const uint64 whitespace = uint64( simd_movemask<int8>( a ) ) | json_mask_equal( v, ' ' );
+
+            // brackets and braces differ from their closing ones by 0x20
+            simd_or<int32>( a, v, json_bytes( 0x20 ) );
+            const uint64 op = json_mask_equal( a, '{' ) | json_mask_equal( a, '}' )
+                              | json_mask_equal( v, ':' ) | json_mask_equal( v, ',' );
+
+            const int shift = i * 16;
+            m.quote      |= json_mask_equal( v, '"' ) << shift;
+            m.backslash  |= json_mask_equal( v, '\\' ) << shift;
+            m.whitespace |= whitespace << shift;
+            m.op         |= op << shift;
+        }
+    }
+}
+
+const JsonKernelTable baseline_table = {
+    &classify_baseline,
+};
+
+// n must not be zero
+inline int json_lowest_bit( uint64 n ) noexcept
+{
+#if TREECORE_COMPILER_MSVC
+    unsigned long index;
+    _BitScanForward64( &index, n );
+    return int(index);
+#else
+    return __builtin_ctzll( n );
+#endif
+}
+
+// each bit becomes the XOR of itself and all lower bits
+inline uint64 json_prefix_xor( uint64 n ) noexcept
+{
+    n ^= n << 1;
+    n ^= n << 2;
+    n ^= n << 4;
+    n ^= n << 8;
+    n ^= n << 16;
+    n ^= n << 32;
+    return n;
+}
+
+} // anonymous namespace
+
+const JsonKernelTable* get_json_kernels_baseline() noexcept
+{
+    return &baseline_table;
+}
+
+static const JsonKernelTable& kernels() noexcept
+{
+    static const CpuDispatchTable<const JsonKernelTable*> impls = { {
+        get_json_kernels_baseline(),
+        nullptr,
+#if TREECORE_CPU_X86
+        get_json_kernels_avx2(),
+#else
+        nullptr,
+#endif
+        nullptr
+    } };
+
+    static const JsonKernelTable* impl = impls.select();
+    return *impl;
+}
+
+JSONScanner::JSONScanner( const char* text, size_t numBytes ) noexcept
+    : text( text )
+    , numBytes( numBytes )
+    , numBlocks( (numBytes + BLOCK_BYTES - 1) / BLOCK_BYTES )
+    , kernels( treecore::kernels() )
+    , batchStart( 0 )
+    , batchSize( 0 )
+    , prevEscaped( 0 )
+    , prevInString( 0 )
+    , prevScalar( 0 )
+{}
+
+size_t JSONScanner::next( size_t pos ) noexcept
+{
+    treecore_assert( pos >= batchStart * BLOCK_BYTES );
+
+    while (pos < numBytes)
+    {
+        const size_t block = pos / BLOCK_BYTES;
+
+        if (block >= batchStart + batchSize)
+        {
+            scanBatch();
+            continue;
+        }
+
+        const uint64 bits = structurals[block - batchStart] & ( ~uint64( 0 ) << (pos % BLOCK_BYTES) );
+
+        if (bits != 0)
+            return jmin( block * BLOCK_BYTES + json_lowest_bit( bits ), numBytes );
+
+        pos = (block + 1) * BLOCK_BYTES;
+    }
+
+    return numBytes;
+}
+
+void JSONScanner::scanBatch() noexcept
+{
+    batchStart += batchSize;
+    batchSize   = jmin( size_t( BATCH_BLOCKS ), numBlocks - batchStart );
+
+    JsonBlockMasks masks[BATCH_BLOCKS];
+    const size_t firstByte     = batchStart * BLOCK_BYTES;
+    const size_t numFullBlocks = jmin( batchSize, (numBytes - firstByte) / BLOCK_BYTES );
+
+    kernels.classify( (const uint8*) text + firstByte, numFullBlocks, masks );
+
+    if (numFullBlocks < batchSize)
+    {
+        // pad the last block with whitespace, which is never structural
+        uint8 tail[BLOCK_BYTES];
+        const size_t tailStart = firstByte + numFullBlocks * BLOCK_BYTES;
+        std::memset( tail, ' ', BLOCK_BYTES );
+        std::memcpy( tail, text + tailStart, numBytes - tailStart );
+        kernels.classify( tail, 1, masks + numFullBlocks );
+    }
+
+    const uint64 evenBits = 0x5555555555555555ull;
+
+    for (size_t i = 0; i < batchSize; i++)
+    {
+        const JsonBlockMasks& m = masks[i];
+
+        // Characters escaped by a backslash, as in simdjson. In a run of
+        // backslashes, every other one counted from the start of the run
+        // escapes the byte after it. Adding the starts of runs that begin
+        // on odd bits to the backslashes carries those runs away, which
+        // tells runs of both parities apart.
+        const uint64 backslash     = m.backslash & ~prevEscaped;
+        const uint64 followsEscape = (backslash << 1) | prevEscaped;
+        const uint64 oddStarts     = backslash & ~evenBits & ~followsEscape;
+        const uint64 evenSequences = oddStarts + backslash;
+        const uint64 escaped       = ( evenBits ^ (evenSequences << 1) ) & followsEscape;
+        prevEscaped = evenSequences < oddStarts ? 1 : 0;
+
+        // set from an opening quote up to the byte before its closing quote
+        const uint64 quote    = m.quote & ~escaped;
+        const uint64 inString = json_prefix_xor( quote ) ^ prevInString;
+        prevInString = uint64( int64( inString ) >> 63 );
+
+        // the first byte of each run of anything else
+        const uint64 scalar      = ~(m.whitespace | m.op | quote | inString);
+        const uint64 scalarStart = scalar & ~( (scalar << 1) | prevScalar );
+        prevScalar = scalar >> 63;
+
+        structurals[i] = (m.op & ~inString) | quote | scalarStart;
+    }
+}
+
+} // namespace treecore
@@ -0,0 +1,94 @@
+#ifndef TREECORE_JSON_SCANNER_H
+#define TREECORE_JSON_SCANNER_H
+
+#include "treecore/IntTypes.h"
+#include "treecore/PlatformDefs.h"
+
+#include <cstddef>
+
+namespace treecore
+{
+
+/**
+ * @brief bytes of one 64-byte block of JSON text, one bit per byte
+ */
+struct JsonBlockMasks
+{
+    uint64 quote;      ///< '"'
+    uint64 backslash;  ///< '\\'
+    uint64 whitespace; ///< space, and 9 to 13
+    uint64 op;         ///< one of {}[]:,
+};
+
+/**
+ * @brief kernels of JSONScanner compiled for one instruction set
+ */
+struct JsonKernelTable
+{
+    void (*classify)( const uint8* data, size_t num_blocks, JsonBlockMasks* masks );
+};
+
+const JsonKernelTable* get_json_kernels_baseline() noexcept;
+const JsonKernelTable* get_json_kernels_avx2() noexcept;
+
+/**
+ * @brief finds structural positions in JSON text, 64 bytes at a time
+ *
+ * This is the first stage of the approach described by Langdale and Lemire
+ * in "Parsing Gigabytes of JSON per Second". Blocks of text are classified
+ * with SIMD instructions, and backslash escapes and string contents are
+ * then resolved with bit operations on whole blocks. What remains is the
+ * position of each {}[]:, outside strings, of each unescaped double quote,
+ * and of the first byte of everything else that is neither whitespace nor
+ * inside a string, such as numbers and literals.
+ *
+ * Text is scanned on demand in batches of blocks as positions are asked
+ * for, so that memory use doesn't grow with the size of text.
+ */
+class JSONScanner
+{
+public:
+    JSONScanner( const char* text, size_t numBytes ) noexcept;
+
+    /**
+     * @brief get the first structural position at or after pos
+     *
+     * pos must not be smaller than in previous calls.
+     *
+     * @return position, or the size of text if there is none
+     */
+    size_t next( size_t pos ) noexcept;
+
+    /**
+     * @brief whether a byte is whitespace for the scanner, the same set of
+     *        characters as CharPointer_UTF8::isWhitespace()
+     */
+    static bool isWhitespace( char c ) noexcept { return c == ' ' || (c <= 13 && c >= 9); }
+
+private:
+    enum
+    {
+        BLOCK_BYTES  = 64,
+        BATCH_BLOCKS = 16
+    };
+
+    void scanBatch() noexcept;
+
+    const char* const text;
+    const size_t numBytes;
+    const size_t numBlocks;
+    const JsonKernelTable& kernels;
+
+    uint64 structurals[BATCH_BLOCKS];
+    size_t batchStart;
+    size_t batchSize;
+
+    // state carried from the previous block
+    uint64 prevEscaped;
+    uint64 prevInString;
+    uint64 prevScalar;
+};
+
+} // namespace treecore
+
+#endif // TREECORE_JSON_SCANNER_H
@@ -0,0 +1,64 @@
+//
+// JSONScanner kernels for AVX2. This file is compiled with
+// TREECORE_AVX2_KERNEL_FLAGS, and is only called after CPU is checked.
+//
+// Only raw intrinsics may be used here, for the same reason as in
+// FloatVectorOperations_avx2.cpp.
+//
+#include "treecore/simd/avx2.h"
+
+#include "treecore/internal/JSONScanner.h"
+
+namespace treecore
+{
+
+namespace
+{
+
+inline uint64 mask_equal( const __m256i v, char value ) noexcept
+{
+    return uint32( _mm256_movemask_epi8( _mm256_cmpeq_epi8( v, _mm256_set1_epi8( value ) ) ) );
+}
+
+void classify_avx2( const uint8* data, size_t num_blocks, JsonBlockMasks* masks ) noexcept
+{
+    for (size_t block = 0; block < num_blocks; block++)
+    {
+        JsonBlockMasks& m = masks[block];
+        m.quote = m.backslash = m.whitespace = m.op = 0;
+
+        for (int i = 0; i < 2; i++)
+        {
+            const __m256i v = _mm256_loadu_si256( (const __m256i*) (data + block * 64 + i * 32) );
+
+            // 9 to 13 are the only bytes between 8 and 14 as signed bytes
+            const __m256i control = _mm256_and_si256( _mm256_cmpgt_epi8( v, _mm256_set1_epi8( 8 ) ),
+                                                      _mm256_cmpgt_epi8( _mm256_set1_epi8( 14 ), v ) );
+            const uint64 whitespace = uint32( _mm256_movemask_epi8( control ) ) | mask_equal( v, ' ' );
+
+            // brackets and braces differ from their closing ones by 0x20
+            const __m256i folded = _mm256_or_si256( v, _mm256_set1_epi8( 0x20 ) );
+            const uint64 op = mask_equal( folded, '{' ) | mask_equal( folded, '}' )
+                              | mask_equal( v, ':' ) | mask_equal( v, ',' );
+
+            const int shift = i * 32;
+            m.quote      |= mask_equal( v, '"' ) << shift;
+            m.backslash  |= mask_equal( v, '\\' ) << shift;
+            m.whitespace |= whitespace << shift;
+            m.op         |= op << shift;
+        }
+    }
+}
+
+const JsonKernelTable avx2_table = {
+    &classify_avx2,
+};
+
+} // anonymous namespace
+
+const JsonKernelTable* get_json_kernels_avx2() noexcept
+{
+    return &avx2_table;
+}
+
+} // namespace treecore
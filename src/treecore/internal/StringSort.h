@@ -0,0 +1,224 @@
+#ifndef TREECORE_STRING_SORT_H
+#define TREECORE_STRING_SORT_H
+
+#include "treecore/ByteOrder.h"
+#include "treecore/HeapBlock.h"
+#include "treecore/IntTypes.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
+namespace treecore
+{
+
+//
+// Multi-key quicksort by Bentley and Sedgewick, "Fast Algorithms for Sorting
+// and Searching Strings". Each pass partitions on one position only, so
+// common prefixes are looked at once per partition instead of once per
+// comparison, and no comparison goes through a function call. Positions are
+// eight bytes wide here instead of one, which makes for far fewer passes
+// over the elements.
+//
+// Elements are anything with members "const char* text" and
+// "size_t numBytes". Bytes are compared unsigned, which for UTF-8 is the
+// order of code points.
+//
+
+/**
+ * @brief the eight bytes of an element from depth on, comparable as one
+ *        number
+ */
+struct StringSortKey
+{
+    uint64 bytes;    ///< big endian, padded with zeros after the end
+    uint32 numBytes; ///< how many of them there are, up to 8
+
+    bool operator < ( const StringSortKey& other ) const noexcept
+    {
+        return bytes != other.bytes ? bytes < other.bytes : numBytes < other.numBytes;
+    }
+};
+
+template<typename T>
+inline StringSortKey string_sort_key_at( const T& element, size_t depth ) noexcept
+{
+    StringSortKey key;
+    uint64 bytes = 0;
+
+    if (element.numBytes >= depth + 8)
+    {
+        std::memcpy( &bytes, element.text + depth, 8 );
+        key.numBytes = 8;
+    }
+    else
+    {
+        key.numBytes = uint32( element.numBytes - depth );
+
+        if (key.numBytes > 0)
+            std::memcpy( &bytes, element.text + depth, key.numBytes );
+    }
+
+    key.bytes = ByteOrder::swapIfLittleEndian( bytes );
+    return key;
+}
+
+// compare two elements known to be equal in the first depth bytes
+template<typename T>
+inline bool string_sort_less( const T& a, const T& b, size_t depth ) noexcept
+{
+    const size_t common = std::min( a.numBytes, b.numBytes ) - depth;
+
+    if (common > 0)
+    {
+        const int order = std::memcmp( a.text + depth, b.text + depth, common );
+
+        if (order != 0)
+            return order < 0;
+    }
+
+    return a.numBytes < b.numBytes;
+}
+
+template<typename T>
+void string_insertion_sort( T* elements, size_t numElements, size_t depth ) noexcept
+{
+    for (size_t i = 1; i < numElements; i++)
+    {
+        if ( !string_sort_less( elements[i], elements[i - 1], depth ) )
+            continue;
+
+        T moving = elements[i];
+        size_t j = i;
+
+        do
+        {
+            elements[j] = elements[j - 1];
+            j--;
+        }
+        while ( j > 0 && string_sort_less( moving, elements[j - 1], depth ) );
+
+        elements[j] = moving;
+    }
+}
+
+template<typename T>
+void string_sort_with_keys( T* elements, StringSortKey* keys, size_t numElements, size_t depth ) noexcept;
+
+// sort elements that are equal in the first depth + 8 bytes
+template<typename T>
+void string_sort_next_depth( T* elements, StringSortKey* keys, size_t numElements, size_t depth ) noexcept
+{
+    for (size_t i = 0; i < numElements; i++)
+        keys[i] = string_sort_key_at( elements[i], depth + 8 );
+
+    string_sort_with_keys( elements, keys, numElements, depth + 8 );
+}
+
+// keys[i] is the key of elements[i] at depth
+template<typename T>
+void string_sort_with_keys( T* elements, StringSortKey* keys, size_t numElements, size_t depth ) noexcept
+{
+    while (numElements > 16)
+    {
+        // median of three as pivot
+        StringSortKey a = keys[0];
+        StringSortKey b = keys[numElements / 2];
+        StringSortKey c = keys[numElements - 1];
+
+        if (b < a) std::swap( a, b );
+        if (c < b) std::swap( b, c );
+        if (b < a) std::swap( a, b );
+
+        const StringSortKey pivot = b;
+
+        // three-way partition into [0, lower), [lower, upper), [upper, n)
+        size_t lower = 0;
+        size_t upper = numElements;
+
+        for (size_t i = 0; i < upper;)
+        {
+            if (keys[i] < pivot)
+            {
+                std::swap( elements[lower], elements[i] );
+                std::swap( keys[lower++], keys[i++] );
+            }
+            else if (pivot < keys[i])
+            {
+                --upper;
+                std::swap( elements[i], elements[upper] );
+                std::swap( keys[i], keys[upper] );
+            }
+            else
+            {
+                i++;
+            }
+        }
+
+        // If the middle part has ended, all of its elements are equal.
+        // Otherwise it goes on at the next position.
+        const bool   middleEnded = pivot.numBytes < 8;
+        const size_t numLower    = lower;
+        const size_t numMiddle   = upper - lower;
+        const size_t numUpper    = numElements - upper;
+
+        // Recurse into the two smaller parts and go on with the largest one
+        // here, so that each call has at most half of the elements of its
+        // caller and the stack stays O(log n) deep, whatever the input.
+        if (numMiddle >= numLower && numMiddle >= numUpper)
+        {
+            string_sort_with_keys( elements, keys, numLower, depth );
+            string_sort_with_keys( elements + upper, keys + upper, numUpper, depth );
+
+            if (middleEnded)
+                return;
+
+            elements    += lower;
+            keys        += lower;
+            numElements  = numMiddle;
+            depth       += 8;
+
+            for (size_t i = 0; i < numElements; i++)
+                keys[i] = string_sort_key_at( elements[i], depth );
+        }
+        else
+        {
+            if (!middleEnded)
+                string_sort_next_depth( elements + lower, keys + lower, numMiddle, depth );
+
+            if (numLower >= numUpper)
+            {
+                string_sort_with_keys( elements + upper, keys + upper, numUpper, depth );
+                numElements = numLower;
+            }
+            else
+            {
+                string_sort_with_keys( elements, keys, numLower, depth );
+                elements    += upper;
+                keys        += upper;
+                numElements  = numUpper;
+            }
+        }
+    }
+
+    string_insertion_sort( elements, numElements, depth );
+}
+
+template<typename T>
+void string_sort( T* elements, size_t numElements )
+{
+    // The keys of all elements at the current depth are kept next to each
+    // other, so that the partitioning passes don't have to load them from
+    // the text, which is all over the memory. That is the most of the time
+    // otherwise.
+    HeapBlock<StringSortKey> keys( numElements );
+
+    for (size_t i = 0; i < numElements; i++)
+        keys[i] = string_sort_key_at( elements[i], 0 );
+
+    string_sort_with_keys( elements, keys.getData(), numElements, 0 );
+}
+
+} // namespace treecore
+
+#endif // TREECORE_STRING_SORT_H
@@ -9,15 +9,6 @@
 namespace treecore
 {
 
-struct EmptyString
-{
-    int    refCount;
-    size_t allocatedBytes;
-    String::CharPointerType::CharType text;
-};
-
-const EmptyString& emptyString();
-
 class StringHolder
 {
 public:
@@ -29,32 +20,35 @@ public:
     //==============================================================================
     static CharPointerType createUninitialisedBytes( size_t numBytes );
 
+    // The functions below create a String with enough space for the text, which
+    // is stored inline when short.
+
     template<class CharPointer>
-    static CharPointerType createFromCharPointer( const CharPointer text )
+    static String createFromCharPointer( const CharPointer text )
     {
         if ( text.getAddress() == nullptr || text.isEmpty() )
-            return CharPointerType( &(emptyString().text) );
+            return String();
 
         CharPointer t( text );
-        size_t bytesNeeded = sizeof(CharType);
+        size_t bytesNeeded = 0;
 
         while ( !t.isEmpty() )
             bytesNeeded += CharPointerType::getBytesRequiredFor( t.getAndAdvance() );
 
-        const CharPointerType dest( createUninitialisedBytes( bytesNeeded ) );
-        CharPointerType( dest ).writeAll( text );
-        return dest;
+        String result( String::PreallocationBytes( (size_t) bytesNeeded ) );
+        result.text().writeAll( text );
+        return result;
     }
 
     template<class CharPointer>
-    static CharPointerType createFromCharPointer( const CharPointer text, size_t maxChars )
+    static String createFromCharPointer( const CharPointer text, size_t maxChars )
     {
         if (text.getAddress() == nullptr || text.isEmpty() || maxChars == 0)
-            return CharPointerType( &(emptyString().text) );
+            return String();
 
         CharPointer end( text );
         size_t numChars    = 0;
-        size_t bytesNeeded = sizeof(CharType);
+        size_t bytesNeeded = 0;
 
         while ( numChars < maxChars && !end.isEmpty() )
         {
@@ -62,20 +56,20 @@ public:
             ++numChars;
         }
 
-        const CharPointerType dest( createUninitialisedBytes( bytesNeeded ) );
-        CharPointerType( dest ).writeWithCharLimit( text, (int) numChars + 1 );
-        return dest;
+        String result( String::PreallocationBytes( (size_t) bytesNeeded ) );
+        result.text().writeWithCharLimit( text, (int) numChars + 1 );
+        return result;
     }
 
     template<class CharPointer>
-    static CharPointerType createFromCharPointer( const CharPointer start, const CharPointer end )
+    static String createFromCharPointer( const CharPointer start, const CharPointer end )
     {
         if ( start.getAddress() == nullptr || start.isEmpty() )
-            return CharPointerType( &(emptyString().text) );
+            return String();
 
         CharPointer e( start );
         int numChars = 0;
-        size_t bytesNeeded = sizeof(CharType);
+        size_t bytesNeeded = 0;
 
         while ( e < end && !e.isEmpty() )
         {
@@ -83,23 +77,25 @@ public:
             ++numChars;
         }
 
-        const CharPointerType dest( createUninitialisedBytes( bytesNeeded ) );
-        CharPointerType( dest ).writeWithCharLimit( start, numChars + 1 );
-        return dest;
+        String result( String::PreallocationBytes( (size_t) bytesNeeded ) );
+        result.text().writeWithCharLimit( start, numChars + 1 );
+        return result;
     }
 
-    static CharPointerType createFromCharPointer( const CharPointerType start, const CharPointerType end );
-
-    static CharPointerType createFromFixedLength( const char* const src, const size_t numChars );
+    static String createFromCharPointer( const CharPointerType text );
+    static String createFromCharPointer( const CharPointerType start, const CharPointerType end );
+    static String createFromFixedLength( const char* const src, const size_t numChars );
 
     //==============================================================================
-    static void retain( const CharPointerType text ) noexcept;
+    static void retain( const CharPointerType text ) noexcept
+    {
+        ++(bufferFromText( text )->refCount);
+    }
 
     static inline void release( StringHolder* const b ) noexcept
     {
-        if (b != (StringHolder*) &emptyString())
-            if (--(b->refCount) == -1)
-                delete[] reinterpret_cast<char*>(b);
+        if (--(b->refCount) == -1)
+            delete[] reinterpret_cast<char*>(b);
     }
 
     static void release( const CharPointerType text ) noexcept
@@ -115,8 +111,6 @@ public:
     //==============================================================================
     static CharPointerType makeUniqueWithByteSize( const CharPointerType text, size_t numBytes );
 
-    static size_t getAllocatedNumBytes( const CharPointerType text ) noexcept;
-
     //==============================================================================
     int refCount;
     size_t allocatedNumBytes;
@@ -143,7 +137,7 @@ private:
         #    error "native wchar_t size is unknown"
        #endif
 
-        static_assert( sizeof(EmptyString) == sizeof(StringHolder), "EmptyString is same size of StringHolder" );
+        static_assert( sizeof(CharType*) < String::SSO_BYTES, "holder pointer must not overlap the inline tag byte" );
     }
 };
 
@@ -155,17 +149,41 @@ enum
     charsNeededForDouble = 48
 };
 
+// writes two digits per division, which halves the number of divisions
 template<typename Type>
 static char* printDigits( char* t, Type v ) noexcept
 {
+    static const char digitPairs[] =
+        "00010203040506070809"
+        "10111213141516171819"
+        "20212223242526272829"
+        "30313233343536373839"
+        "40414243444546474849"
+        "50515253545556575859"
+        "60616263646566676869"
+        "70717273747576777879"
+        "80818283848586878889"
+        "90919293949596979899";
+
     *--t = 0;
 
-    do
+    while (v >= 100)
     {
-        *--t = '0' + (char) (v % 10);
-        v   /= 10;
+        const char* const pair = digitPairs + 2 * (v % 100);
+        v   /= 100;
+        *--t = pair[1];
+        *--t = pair[0];
+    }
 
-    } while (v > 0);
+    if (v >= 10)
+    {
+        *--t = digitPairs[2 * v + 1];
+        *--t = digitPairs[2 * v];
+    }
+    else
+    {
+        *--t = '0' + (char) v;
+    }
 
     return t;
 }
@@ -185,10 +203,11 @@ struct StackArrayStream: public std::basic_streambuf<char, std::char_traits<char
     size_t writeDouble( double n, int numDecPlaces );
 };
 
+// with numDecPlaces <= 0, writes the shortest text which reads back as n
 char* doubleToString( char* buffer, const int numChars, double n, int numDecPlaces, size_t& len ) noexcept;
 
 template<typename IntegerType>
-String::CharPointerType createFromInteger( const IntegerType number )
+String createFromInteger( const IntegerType number )
 {
     char buffer [charsNeededForInt];
     char* const end   = buffer + numElementsInArray( buffer );
@@ -196,7 +215,10 @@ String::CharPointerType createFromInteger( const IntegerType number )
     return StringHolder::createFromFixedLength( start, size_t( end - start - 1 ) );
 }
 
-String::CharPointerType createFromDouble( const double number, const int numberOfDecimalPlaces );
+String createFromDouble( const double number, const int numberOfDecimalPlaces );
+
+// the shortest text which reads back as number when parsed as a float
+String createFromFloat( const float number );
 }
 
 } // namespace treecore
@@ -16,15 +16,26 @@ struct CPUInformation
 {
     CPUInformation() noexcept
         : numCpus (0), hasMMX (false), hasSSE (false),
-          hasSSE2 (false), hasSSE3 (false), has3DNow (false)
+          hasSSE2 (false), hasSSE3 (false), has3DNow (false),
+          hasSSSE3 (false), hasSSE41 (false), hasSSE42 (false), hasPCLMULQDQ (false),
+          hasAVX (false), hasAVX2 (false), hasFMA3 (false), hasBMI2 (false),
+          hasAVX512F (false), hasAVX512BW (false), hasAVX512DQ (false), hasAVX512VL (false)
     {
         initialise();
+        detectInstructionSets();
     }
 
+    /** platform-specific, fills CPU count */
     void initialise() noexcept;
 
+    /** fills instruction set flags using CPUID, shared by all platforms */
+    void detectInstructionSets() noexcept;
+
     int numCpus;
     bool hasMMX, hasSSE, hasSSE2, hasSSE3, has3DNow;
+    bool hasSSSE3, hasSSE41, hasSSE42, hasPCLMULQDQ;
+    bool hasAVX, hasAVX2, hasFMA3, hasBMI2;
+    bool hasAVX512F, hasAVX512BW, hasAVX512DQ, hasAVX512VL;
 };
 
 #if TREECORE_OS_WINDOWS
@@ -0,0 +1,253 @@
+//
+// UTF8Functions kernels for AVX2. This file is compiled with
+// TREECORE_AVX2_KERNEL_FLAGS, and is only called after CPU is checked.
+//
+// Only raw intrinsics and SIMDType<32> functions may be used here, for the
+// same reason as in FloatVectorOperations_avx2.cpp.
+//
+#include "treecore/simd/avx2.h"
+
+#include "treecore/internal/UTF8Functions_impl.h"
+
+#include <cstring>
+
+namespace treecore
+{
+
+namespace
+{
+
+//
+// Validation by the lookup algorithm of Keiser and Lemire, "Validating UTF-8
+// in less than one instruction per byte". Each pair of adjacent bytes is
+// classified by three 16-entry tables, indexed by the high and low nibble of
+// the first byte and the high nibble of the second one. Each bit in table
+// values is one kind of error, and a pair is malformed when the three values
+// have a bit in common. Third and fourth bytes of a sequence are checked
+// separately, by comparing bytes 2 and 3 positions back.
+//
+enum
+{
+    TOO_SHORT      = 1 << 0, // leading byte followed by ASCII or another leading byte
+    TOO_LONG       = 1 << 1, // ASCII followed by continuation
+    OVERLONG_3     = 1 << 2, // 11100000 100_____
+    TOO_LARGE      = 1 << 3, // 11110100 1001____ and above
+    SURROGATE      = 1 << 4, // 11101101 101_____
+    OVERLONG_2     = 1 << 5, // 1100000_ 10______
+    TOO_LARGE_1000 = 1 << 6, // 11110101 1000____ and above
+    OVERLONG_4     = 1 << 6, // 11110000 1000____
+    TWO_CONTS      = 1 << 7, // continuation following continuation
+    CARRY          = TOO_SHORT | TOO_LONG | TWO_CONTS
+};
+
+inline __m256i table16( char v0, char v1, char v2, char v3, char v4, char v5, char v6, char v7,
+                        char v8, char v9, char v10, char v11, char v12, char v13, char v14, char v15 ) noexcept
+{
+    return _mm256_setr_epi8( v0, v1, v2, v3, v4, v5, v6, v7, v8, v9, v10, v11, v12, v13, v14, v15,
+                             v0, v1, v2, v3, v4, v5, v6, v7, v8, v9, v10, v11, v12, v13, v14, v15 );
+}
+
+struct Utf8Validator
+{
+    __m256i error;
+    __m256i prev_input;
+    __m256i prev_incomplete;
+
+    __m256i byte_1_high;
+    __m256i byte_1_low;
+    __m256i byte_2_high;
+    __m256i low_nibble;
+    __m256i incomplete_max;
+
+    Utf8Validator() noexcept
+        : error( _mm256_setzero_si256() )
+        , prev_input( _mm256_setzero_si256() )
+        , prev_incomplete( _mm256_setzero_si256() )
+    {
+        byte_1_high = table16(
+            // 0_______ ASCII
+            TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+            // 10______ continuation
+            TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS,
+            // 1100____ and 1101____ two byte lead
+            TOO_SHORT | OVERLONG_2,
+            TOO_SHORT,
+            // 1110____ three byte lead
+            TOO_SHORT | OVERLONG_3 | SURROGATE,
+            // 1111____ four byte lead
+            char( TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4 ) );
+
+        byte_1_low = table16(
+            CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4, // ____0000
+            CARRY | OVERLONG_2,                           // ____0001
+            CARRY,                                        // ____001_
+            CARRY,
+            CARRY | TOO_LARGE,                            // ____0100
+            CARRY | TOO_LARGE | TOO_LARGE_1000,           // ____0101
+            CARRY | TOO_LARGE | TOO_LARGE_1000,           // ____011_
+            CARRY | TOO_LARGE | TOO_LARGE_1000,
+            CARRY | TOO_LARGE | TOO_LARGE_1000,           // ____1___
+            CARRY | TOO_LARGE | TOO_LARGE_1000,
+            CARRY | TOO_LARGE | TOO_LARGE_1000,
+            CARRY | TOO_LARGE | TOO_LARGE_1000,
+            CARRY | TOO_LARGE | TOO_LARGE_1000,
+            CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE, // ____1101
+            CARRY | TOO_LARGE | TOO_LARGE_1000,
+            CARRY | TOO_LARGE | TOO_LARGE_1000 );
+
+        byte_2_high = table16(
+            // 0_______ ASCII
+            TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+            // 1000____
+            char( TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4 ),
+            // 1001____
+            char( TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE ),
+            // 101_____
+            char( TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE ),
+            char( TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE ),
+            // 11______ leading byte
+            TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT );
+
+        low_nibble = _mm256_set1_epi8( 0x0f );
+
+        // a register ending with these bytes or above is followed by
+        // continuation bytes
+        incomplete_max = _mm256_setr_epi8( -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                           -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                           char( 0xf0 - 1 ), char( 0xe0 - 1 ), char( 0xc0 - 1 ) );
+    }
+
+    // input shifted by n bytes towards the end, with bytes of previous input
+    // shifted in
+    template<int n>
+    static __m256i prev( const __m256i input, const __m256i prev_input ) noexcept
+    {
+        return _mm256_alignr_epi8( input, _mm256_permute2x128_si256( prev_input, input, 0x21 ), 16 - n );
+    }
+
+    __m256i high_nibble( const __m256i v ) const noexcept
+    {
+        return _mm256_and_si256( _mm256_srli_epi16( v, 4 ), low_nibble );
+    }
+
+    void add( const __m256i input ) noexcept
+    {
+        if (_mm256_movemask_epi8( input ) == 0)
+        {
+            // an ASCII register can only be wrong if the previous one
+            // ended in the middle of a sequence
+            error = _mm256_or_si256( error, prev_incomplete );
+        }
+        else
+        {
+            const __m256i prev1 = prev<1>( input, prev_input );
+
+            const __m256i special_cases = _mm256_and_si256(
+                _mm256_and_si256( _mm256_shuffle_epi8( byte_1_high, high_nibble( prev1 ) ),
+                                  _mm256_shuffle_epi8( byte_1_low, _mm256_and_si256( prev1, low_nibble ) ) ),
+                _mm256_shuffle_epi8( byte_2_high, high_nibble( input ) ) );
+
+            // bytes 2 and 3 positions after a three or four byte lead must
+            // be continuation bytes, which is the only place TWO_CONTS is
+            // allowed
+            const __m256i is_third_byte  = _mm256_subs_epu8( prev<2>( input, prev_input ), _mm256_set1_epi8( char( 0xe0 - 0x80 ) ) );
+            const __m256i is_fourth_byte = _mm256_subs_epu8( prev<3>( input, prev_input ), _mm256_set1_epi8( char( 0xf0 - 0x80 ) ) );
+            const __m256i must_be_23_cont = _mm256_and_si256( _mm256_or_si256( is_third_byte, is_fourth_byte ), _mm256_set1_epi8( char( 0x80 ) ) );
+
+            error = _mm256_or_si256( error, _mm256_xor_si256( must_be_23_cont, special_cases ) );
+            prev_incomplete = _mm256_subs_epu8( input, incomplete_max );
+        }
+
+        prev_input = input;
+    }
+
+    bool finish() noexcept
+    {
+        error = _mm256_or_si256( error, prev_incomplete );
+        return _mm256_testz_si256( error, error ) != 0;
+    }
+};
+
+struct Avx2Ops
+{
+    typedef SIMDType<32> VecType;
+    enum { N_BYTES = 32 };
+
+    static VecType load( const uint8* src ) noexcept { VecType r; r.simd_by_int = _mm256_loadu_si256( (const __m256i*) src ); return r; }
+
+    static void    store( uint8* dest, const VecType& v ) noexcept { _mm256_storeu_si256( (__m256i*) dest, v.simd_by_int ); }
+    static VecType bytes( uint8 value ) noexcept { VecType r; r.simd_by_int = _mm256_set1_epi8( char( value ) ); return r; }
+
+    static uint64 mask_nonascii( const VecType& v ) noexcept { return uint32( _mm256_movemask_epi8( v.simd_by_int ) ); }
+
+    static uint64 mask_equal( const VecType& a, const VecType& b ) noexcept
+    {
+        return uint32( _mm256_movemask_epi8( _mm256_cmpeq_epi8( a.simd_by_int, b.simd_by_int ) ) );
+    }
+
+    // letters are positive as signed bytes, so signed comparison works
+    static VecType flip_case( const VecType& v, uint8 first, uint8 last ) noexcept
+    {
+        const __m256i in_range = _mm256_and_si256( _mm256_cmpgt_epi8( v.simd_by_int, _mm256_set1_epi8( char( first - 1 ) ) ),
+                                                   _mm256_cmpgt_epi8( _mm256_set1_epi8( char( last + 1 ) ), v.simd_by_int ) );
+        VecType r;
+        r.simd_by_int = _mm256_xor_si256( v.simd_by_int, _mm256_and_si256( in_range, _mm256_set1_epi8( 0x20 ) ) );
+        return r;
+    }
+    static uint64 mask_zero( const VecType& v ) noexcept     { return uint32( _mm256_movemask_epi8( _mm256_cmpeq_epi8( v.simd_by_int, _mm256_setzero_si256() ) ) ); }
+
+    // 0x80 to 0xbf are -128 to -65 as signed bytes
+    static uint64 mask_continuation( const VecType& v ) noexcept
+    {
+        return uint32( _mm256_movemask_epi8( _mm256_cmpgt_epi8( _mm256_set1_epi8( char( 0xc0 ) ), v.simd_by_int ) ) );
+    }
+
+    static uint64 mask_four_byte_lead( const VecType& v ) noexcept
+    {
+        const __m256i lead = _mm256_cmpeq_epi8( _mm256_max_epu8( v.simd_by_int, _mm256_set1_epi8( char( 0xf0 ) ) ), v.simd_by_int );
+        return uint32( _mm256_movemask_epi8( lead ) );
+    }
+
+    static void widen( const uint8* src, uint16* dest ) noexcept
+    {
+        const __m128i lo = _mm_loadu_si128( (const __m128i*) src );
+        const __m128i hi = _mm_loadu_si128( (const __m128i*) (src + 16) );
+        _mm256_storeu_si256( (__m256i*) dest,        _mm256_cvtepu8_epi16( lo ) );
+        _mm256_storeu_si256( (__m256i*) (dest + 16), _mm256_cvtepu8_epi16( hi ) );
+    }
+
+    static void widen( const uint8* src, uint32* dest ) noexcept
+    {
+        for (int i = 0; i < 32; i += 8)
+            _mm256_storeu_si256( (__m256i*) (dest + i), _mm256_cvtepu8_epi32( _mm_loadl_epi64( (const __m128i*) (src + i) ) ) );
+    }
+
+    static bool validate( const uint8* data, size_t num ) noexcept
+    {
+        Utf8Validator validator;
+        size_t i = 0;
+
+        for (; i + 32 <= num; i += 32)
+            validator.add( _mm256_loadu_si256( (const __m256i*) (data + i) ) );
+
+        if (i < num)
+        {
+            // zero padding is ASCII, so a sequence cut by the end is reported
+            // as too short
+            uint8 tail[32] = {};
+            std::memcpy( tail, data + i, num - i );
+            validator.add( _mm256_loadu_si256( (const __m256i*) tail ) );
+        }
+
+        return validator.finish();
+    }
+};
+
+} // anonymous namespace
+
+const Utf8KernelTable* get_utf8_kernels_avx2() noexcept
+{
+    return &Utf8Kernels<Avx2Ops>::table;
+}
+
+} // namespace treecore
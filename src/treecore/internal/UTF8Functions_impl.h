@@ -0,0 +1,422 @@
+#ifndef TREECORE_UTF8_FUNCTIONS_IMPL_H
+#define TREECORE_UTF8_FUNCTIONS_IMPL_H
+
+#include "treecore/IntTypes.h"
+#include "treecore/PlatformDefs.h"
+
+#include <cstddef>
+#include <cstring>
+
+#if TREECORE_COMPILER_MSVC
+#    include <intrin.h>
+#endif
+
+namespace treecore
+{
+
+/**
+ * @brief kernels of UTF8Functions compiled for one instruction set
+ *
+ * Functions named valid_* only accept input that passed validate() and
+ * contains no zero byte.
+ */
+struct Utf8KernelTable
+{
+    bool (*validate)( const uint8* data, size_t num );
+    size_t (*ascii_prefix)( const uint8* data, size_t num );
+    size_t (*count_chars)( const uint8* data, size_t num );
+    size_t (*valid_utf16_length)( const uint8* data, size_t num );
+    size_t (*valid_to_utf16)( const uint8* data, size_t num, uint16* dest );
+    size_t (*valid_to_utf32)( const uint8* data, size_t num, uint32* dest );
+
+    size_t (*find)( const uint8* haystack, size_t haystack_num, const uint8* needle, size_t needle_num );
+    size_t (*mismatch)( const uint8* a, const uint8* b, size_t num );
+    void (*ascii_to_lower)( uint8* dest, const uint8* src, size_t num );
+    void (*ascii_to_upper)( uint8* dest, const uint8* src, size_t num );
+};
+
+const Utf8KernelTable* get_utf8_kernels_baseline() noexcept;
+const Utf8KernelTable* get_utf8_kernels_avx2() noexcept;
+
+// Everything below has internal linkage, so that code compiled with wider
+// instruction set flags is never shared with the baseline translation unit
+// by the linker.
+namespace
+{
+
+inline int utf8_bit_count( uint64 n ) noexcept
+{
+#if TREECORE_COMPILER_MSVC
+    n = n - ( (n >> 1) & 0x5555555555555555ull );
+    n = (n & 0x3333333333333333ull) + ( (n >> 2) & 0x3333333333333333ull );
+    n = (n + (n >> 4) ) & 0x0f0f0f0f0f0f0f0full;
+    return int( (n * 0x0101010101010101ull) >> 56 );
+#else
+    return __builtin_popcountll( n );
+#endif
+}
+
+// n must not be zero
+inline int utf8_lowest_bit( uint64 n ) noexcept
+{
+#if TREECORE_COMPILER_MSVC
+    unsigned long index;
+    _BitScanForward64( &index, n );
+    return int(index);
+#else
+    return __builtin_ctzll( n );
+#endif
+}
+
+// length of the well-formed sequence at data, or 0 if it is malformed
+inline size_t utf8_sequence_length( const uint8* data, size_t num ) noexcept
+{
+    const uint8 lead = data[0];
+
+    if (lead < 0x80) return 1;
+    if (lead < 0xc2) return 0;
+
+    if (lead < 0xe0)
+        return (num >= 2 && (data[1] & 0xc0) == 0x80) ? 2 : 0;
+
+    // the second byte has a narrower range after some leading bytes, which
+    // excludes overlong forms, surrogates and values above U+10FFFF
+    uint8 low  = 0x80;
+    uint8 high = 0xbf;
+
+    if (lead < 0xf0)
+    {
+        if (lead == 0xe0) low  = 0xa0;
+        if (lead == 0xed) high = 0x9f;
+
+        return (num >= 3 && data[1] >= low && data[1] <= high
+                && (data[2] & 0xc0) == 0x80) ? 3 : 0;
+    }
+
+    if (lead < 0xf5)
+    {
+        if (lead == 0xf0) low  = 0x90;
+        if (lead == 0xf4) high = 0x8f;
+
+        return (num >= 4 && data[1] >= low && data[1] <= high
+                && (data[2] & 0xc0) == 0x80 && (data[3] & 0xc0) == 0x80) ? 4 : 0;
+    }
+
+    return 0;
+}
+
+inline uint8 utf8_ascii_lower( uint8 c ) noexcept
+{
+    return (c >= 'A' && c <= 'Z') ? uint8( c | 0x20 ) : c;
+}
+
+inline uint8 utf8_ascii_upper( uint8 c ) noexcept
+{
+    return (c >= 'a' && c <= 'z') ? uint8( c & ~0x20 ) : c;
+}
+
+inline void utf8_put_char( uint16*& dest, uint32 c ) noexcept
+{
+    if (c >= 0x10000)
+    {
+        c -= 0x10000;
+        *dest++ = uint16( 0xd800 + (c >> 10) );
+        *dest++ = uint16( 0xdc00 + (c & 0x3ff) );
+    }
+    else
+    {
+        *dest++ = uint16( c );
+    }
+}
+
+inline void utf8_put_char( uint32*& dest, uint32 c ) noexcept
+{
+    *dest++ = c;
+}
+
+//
+// Ops must provide VecType, N_BYTES, and these static functions:
+// load and store (unaligned), bytes (broadcast), widen (store N_BYTES bytes
+// zero-extended to uint16 or uint32), validate, flip_case (toggle bit 0x20 of
+// bytes in an ASCII letter range), and bit masks with one bit per byte of a
+// register: mask_nonascii (>= 0x80), mask_zero, mask_equal (of two
+// registers), mask_continuation (0x80 to 0xbf) and mask_four_byte_lead
+// (>= 0xf0).
+//
+template<typename Ops>
+struct Utf8Kernels
+{
+    typedef typename Ops::VecType VecType;
+    enum { N = Ops::N_BYTES };
+
+    // check sequence by sequence, skipping whole registers of ASCII
+    static bool validate_sequences( const uint8* data, size_t num ) noexcept
+    {
+        size_t i = 0;
+
+        while (i < num)
+        {
+            if (i + N <= num)
+            {
+                const uint64 nonascii = Ops::mask_nonascii( Ops::load( data + i ) );
+
+                if (nonascii == 0)
+                {
+                    i += N;
+                    continue;
+                }
+
+                i += utf8_lowest_bit( nonascii );
+            }
+
+            const size_t len = utf8_sequence_length( data + i, num - i );
+            if (len == 0)
+                return false;
+
+            i += len;
+        }
+
+        return true;
+    }
+
+    static size_t ascii_prefix( const uint8* data, size_t num ) noexcept
+    {
+        size_t i = 0;
+
+        for (; i + N <= num; i += N)
+        {
+            const VecType v = Ops::load( data + i );
+            const uint64 stop = Ops::mask_nonascii( v ) | Ops::mask_zero( v );
+
+            if (stop != 0)
+                return i + utf8_lowest_bit( stop );
+        }
+
+        while (i < num && data[i] != 0 && data[i] < 0x80)
+            i++;
+
+        return i;
+    }
+
+    // a continuation byte right after a non-ASCII byte belongs to the
+    // same character, any other byte starts a new one
+    static size_t count_chars( const uint8* data, size_t num ) noexcept
+    {
+        size_t count = 0;
+        uint64 prev_nonascii = 0;
+        size_t i = 0;
+
+        for (; i + N <= num; i += N)
+        {
+            const VecType v = Ops::load( data + i );
+            const uint64 nonascii = Ops::mask_nonascii( v );
+            const uint64 joined   = Ops::mask_continuation( v ) & ( (nonascii << 1) | prev_nonascii );
+
+            count += N - utf8_bit_count( joined );
+            prev_nonascii = nonascii >> (N - 1);
+        }
+
+        for (; i < num; i++)
+        {
+            if ( (data[i] & 0xc0) != 0x80 || prev_nonascii == 0 )
+                count++;
+            prev_nonascii = data[i] >> 7;
+        }
+
+        return count;
+    }
+
+    // each character takes one unit, plus one more for a surrogate pair
+    static size_t valid_utf16_length( const uint8* data, size_t num ) noexcept
+    {
+        size_t count = 0;
+        size_t i = 0;
+
+        for (; i + N <= num; i += N)
+        {
+            const VecType v = Ops::load( data + i );
+            count += N - utf8_bit_count( Ops::mask_continuation( v ) ) + utf8_bit_count( Ops::mask_four_byte_lead( v ) );
+        }
+
+        for (; i < num; i++)
+        {
+            if ( (data[i] & 0xc0) != 0x80 ) count++;
+            if (data[i] >= 0xf0) count++;
+        }
+
+        return count;
+    }
+
+    // decode one well-formed character
+    template<typename DestType>
+    static size_t valid_convert_one( const uint8* data, DestType*& dest ) noexcept
+    {
+        const uint32 lead = data[0];
+
+        if (lead < 0x80)
+        {
+            *dest++ = DestType( lead );
+            return 1;
+        }
+
+        if (lead < 0xe0)
+        {
+            utf8_put_char( dest, ( (lead & 0x1f) << 6 ) | (data[1] & 0x3f) );
+            return 2;
+        }
+
+        if (lead < 0xf0)
+        {
+            utf8_put_char( dest, ( (lead & 0x0f) << 12 ) | ( (data[1] & 0x3f) << 6 ) | (data[2] & 0x3f) );
+            return 3;
+        }
+
+        utf8_put_char( dest, ( (lead & 0x07) << 18 ) | ( (data[1] & 0x3f) << 12 )
+                       | ( (data[2] & 0x3f) << 6 ) | (data[3] & 0x3f) );
+        return 4;
+    }
+
+    template<typename DestType>
+    static size_t valid_convert( const uint8* data, size_t num, DestType* dest ) noexcept
+    {
+        DestType* d = dest;
+        size_t i = 0;
+
+        for (; i + N <= num; )
+        {
+            const uint64 nonascii = Ops::mask_nonascii( Ops::load( data + i ) );
+
+            if (nonascii == 0)
+            {
+                Ops::widen( data + i, d );
+                i += N;
+                d += N;
+                continue;
+            }
+
+            // copy ASCII before the first multi-byte character, then decode
+            // all characters starting in this register
+            for (const size_t ascii_end = i + utf8_lowest_bit( nonascii ); i < ascii_end; i++)
+                *d++ = data[i];
+
+            for (const size_t block_end = i + N; i < block_end && i < num; )
+                i += valid_convert_one( data + i, d );
+        }
+
+        while (i < num)
+            i += valid_convert_one( data + i, d );
+
+        return size_t( d - dest );
+    }
+
+    static size_t valid_to_utf16( const uint8* data, size_t num, uint16* dest ) noexcept { return valid_convert( data, num, dest ); }
+    static size_t valid_to_utf32( const uint8* data, size_t num, uint32* dest ) noexcept { return valid_convert( data, num, dest ); }
+
+    //
+    // Substring search comparing the first and the last byte of the needle at
+    // N positions at once, as in Wojciech Mula's "SIMD-friendly algorithms for
+    // substring searching". Only positions where both match are compared in
+    // full. Returns haystack_num if the needle is not found.
+    //
+    static size_t find( const uint8* haystack, size_t haystack_num, const uint8* needle, size_t needle_num ) noexcept
+    {
+        if (needle_num == 0)
+            return 0;
+
+        if (needle_num > haystack_num)
+            return haystack_num;
+
+        const size_t  last_offset = needle_num - 1;
+        const VecType first = Ops::bytes( needle[0] );
+        const VecType last  = Ops::bytes( needle[last_offset] );
+        size_t i = 0;
+
+        for (; i + last_offset + N <= haystack_num; i += N)
+        {
+            uint64 candidates = Ops::mask_equal( Ops::load( haystack + i ), first )
+                                & Ops::mask_equal( Ops::load( haystack + i + last_offset ), last );
+
+            while (candidates != 0)
+            {
+                const size_t pos = i + utf8_lowest_bit( candidates );
+
+                if ( needle_num <= 2 || std::memcmp( haystack + pos + 1, needle + 1, needle_num - 2 ) == 0 )
+                    return pos;
+
+                candidates &= candidates - 1;
+            }
+        }
+
+        for (; i + needle_num <= haystack_num; i++)
+        {
+            if ( haystack[i] == needle[0] && std::memcmp( haystack + i, needle, needle_num ) == 0 )
+                return i;
+        }
+
+        return haystack_num;
+    }
+
+    // index of the first differing byte, or num if there is none
+    static size_t mismatch( const uint8* a, const uint8* b, size_t num ) noexcept
+    {
+        const uint64 all_equal = (uint64( 1 ) << N) - 1;
+        size_t i = 0;
+
+        for (; i + N <= num; i += N)
+        {
+            const uint64 equal = Ops::mask_equal( Ops::load( a + i ), Ops::load( b + i ) );
+
+            if (equal != all_equal)
+                return i + utf8_lowest_bit( ~equal );
+        }
+
+        while (i < num && a[i] == b[i])
+            i++;
+
+        return i;
+    }
+
+    static void ascii_to_lower( uint8* dest, const uint8* src, size_t num ) noexcept
+    {
+        size_t i = 0;
+
+        for (; i + N <= num; i += N)
+            Ops::store( dest + i, Ops::flip_case( Ops::load( src + i ), 'A', 'Z' ) );
+
+        for (; i < num; i++)
+            dest[i] = utf8_ascii_lower( src[i] );
+    }
+
+    static void ascii_to_upper( uint8* dest, const uint8* src, size_t num ) noexcept
+    {
+        size_t i = 0;
+
+        for (; i + N <= num; i += N)
+            Ops::store( dest + i, Ops::flip_case( Ops::load( src + i ), 'a', 'z' ) );
+
+        for (; i < num; i++)
+            dest[i] = utf8_ascii_upper( src[i] );
+    }
+
+    static const Utf8KernelTable table;
+};
+
+template<typename Ops>
+const Utf8KernelTable Utf8Kernels<Ops>::table = {
+    &Ops::validate,
+    &Utf8Kernels<Ops>::ascii_prefix,
+    &Utf8Kernels<Ops>::count_chars,
+    &Utf8Kernels<Ops>::valid_utf16_length,
+    &Utf8Kernels<Ops>::valid_to_utf16,
+    &Utf8Kernels<Ops>::valid_to_utf32,
+    &Utf8Kernels<Ops>::find,
+    &Utf8Kernels<Ops>::mismatch,
+    &Utf8Kernels<Ops>::ascii_to_lower,
+    &Utf8Kernels<Ops>::ascii_to_upper,
+};
+
+} // anonymous namespace
+
+} // namespace treecore
+
+#endif // TREECORE_UTF8_FUNCTIONS_IMPL_H
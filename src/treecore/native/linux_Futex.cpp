@@ -0,0 +1,39 @@
+#include "treecore/Futex.h"
+
+#include <errno.h>
+#include <limits.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace treecore
+{
+
+bool futex_wait( int32* addr, int32 expected, int timeout_ms ) noexcept
+{
+    struct timespec timeout;
+    struct timespec* timeout_ptr = nullptr;
+
+    if (timeout_ms >= 0)
+    {
+        timeout.tv_sec  = timeout_ms / 1000;
+        timeout.tv_nsec = (timeout_ms % 1000) * 1000000;
+        timeout_ptr = &timeout;
+    }
+
+    const long re = syscall( SYS_futex, addr, FUTEX_WAIT_PRIVATE, expected, timeout_ptr, nullptr, 0 );
+    return !(re == -1 && errno == ETIMEDOUT);
+}
+
+void futex_wake_one( int32* addr ) noexcept
+{
+    syscall( SYS_futex, addr, FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0 );
+}
+
+void futex_wake_all( int32* addr ) noexcept
+{
+    syscall( SYS_futex, addr, FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0 );
+}
+
+} // namespace treecore
@@ -0,0 +1,246 @@
+#ifndef TREECORE_NATIVE_LINUX_HIGH_RESOLUTION_TIMER_H
+#define TREECORE_NATIVE_LINUX_HIGH_RESOLUTION_TIMER_H
+
+#include "treecore/HighResolutionTimer.h"
+#include "treecore/MathsFunctions.h"
+#include "treecore/Thread.h"
+
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/timerfd.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace treecore {
+
+//
+// Linux timer backend
+//
+// Ticks are scheduled on absolute CLOCK_MONOTONIC deadlines (start + N * period),
+// so the time spent in callbacks and wake-up latency never accumulates into drift.
+// A timerfd is used when available, as it reports how many ticks have elapsed
+// since the last read, which lets a slow callback skip ticks instead of firing
+// a burst of late callbacks. clock_nanosleep(TIMER_ABSTIME) is used as fallback.
+//
+struct HighResolutionTimer::Pimpl
+{
+    Pimpl ( HighResolutionTimer& t ): owner( t ), periodMs( 0 ), thread( 0 ), shouldStop( false )
+    {}
+
+    ~Pimpl()
+    {
+        treecore_assert( thread == 0 );
+    }
+
+    void start( int newPeriod )
+    {
+        if ( thread != 0 && thread == pthread_self() )
+        {
+            // called from inside the callback: the timer thread picks up the
+            // new period after the callback returns
+            periodMs   = newPeriod;
+            shouldStop = false;
+        }
+        else if (periodMs != newPeriod)
+        {
+            stop();
+
+            periodMs   = newPeriod;
+            shouldStop = false;
+
+            if (pthread_create( &thread, nullptr, timerThread, this ) != 0)
+            {
+                thread   = 0;
+                periodMs = 0;
+                treecore_assert_false;
+            }
+        }
+    }
+
+    void stop()
+    {
+        if (thread != 0)
+        {
+            shouldStop = true;
+
+            if ( thread != pthread_self() )
+            {
+                pthread_join( thread, nullptr );
+                thread = 0;
+            }
+        }
+    }
+
+    HighResolutionTimer& owner;
+    int volatile periodMs;
+
+private:
+    pthread_t thread;
+    bool volatile shouldStop;
+
+    static const int64 NANOS_PER_SECOND = 1000000000;
+
+    static void* timerThread( void* param )
+    {
+        int dummy;
+        pthread_setcancelstate( PTHREAD_CANCEL_ENABLE, &dummy );
+
+        reinterpret_cast<Pimpl*>(param)->timerThread();
+        return nullptr;
+    }
+
+    void timerThread()
+    {
+        setCurrentThreadToRealtime( owner.realtimePriority );
+
+        Clock clock;
+
+        while (!shouldStop)
+        {
+            const int currentPeriod = periodMs;
+            clock.start( currentPeriod );
+
+            while (!shouldStop && currentPeriod == periodMs)
+            {
+                int64 numMissed = 0;
+                const int64 lateness = clock.wait( numMissed );
+
+                if (shouldStop)
+                    break;
+
+                owner.recordJitter( lateness, numMissed );
+                owner.hiResTimerCallback();
+            }
+        }
+
+        periodMs = 0;
+    }
+
+    //
+    // Waits for absolute deadlines, and reports how late each wake-up was.
+    //
+    struct Clock
+    {
+        Clock() noexcept: fd( timerfd_create( CLOCK_MONOTONIC, TFD_CLOEXEC ) ), deadline( 0 ), delta( 0 )
+        {}
+
+        ~Clock() noexcept
+        {
+            if (fd >= 0)
+                close( fd );
+        }
+
+        void start( int millis ) noexcept
+        {
+            delta    = int64( millis ) * 1000000;
+            deadline = now() + delta;
+
+            if (fd >= 0)
+            {
+                struct itimerspec spec;
+                spec.it_value    = toTimespec( deadline );
+                spec.it_interval = toTimespec( delta );
+
+                if (timerfd_settime( fd, TFD_TIMER_ABSTIME, &spec, nullptr ) != 0)
+                {
+                    close( fd );
+                    fd = -1;
+                }
+            }
+        }
+
+        /** Blocks until the next deadline. Returns the lateness in nanoseconds,
+            and stores the number of deadlines that passed unnoticed. */
+        int64 wait( int64& numMissed ) noexcept
+        {
+            numMissed = 0;
+
+            if (fd >= 0)
+            {
+                uint64 numExpired = 0;
+
+                for (;; )
+                {
+                    const ssize_t numRead = read( fd, &numExpired, sizeof(numExpired) );
+
+                    if (numRead == sizeof(numExpired))
+                        break;
+
+                    if (numRead < 0 && errno != EINTR)
+                    {
+                        // timer fd became unusable: continue on clock_nanosleep
+                        close( fd );
+                        fd = -1;
+                        return wait( numMissed );
+                    }
+                }
+
+                if (numExpired > 1)
+                {
+                    numMissed = int64( numExpired - 1 );
+                    deadline += numMissed * delta;
+                }
+
+                const int64 lateness = now() - deadline;
+                deadline += delta;
+                return lateness;
+            }
+
+            int64 current = now();
+
+            if (current > deadline + delta)
+            {
+                numMissed = (current - deadline) / delta;
+                deadline += numMissed * delta;
+            }
+
+            const struct timespec t = toTimespec( deadline );
+
+            while (clock_nanosleep( CLOCK_MONOTONIC, TIMER_ABSTIME, &t, nullptr ) == EINTR) {}
+
+            const int64 lateness = now() - deadline;
+            deadline += delta;
+            return lateness;
+        }
+
+        static int64 now() noexcept
+        {
+            struct timespec t;
+            clock_gettime( CLOCK_MONOTONIC, &t );
+            return NANOS_PER_SECOND * (int64) t.tv_sec + t.tv_nsec;
+        }
+
+        static struct timespec toTimespec( int64 nanos ) noexcept
+        {
+            struct timespec t;
+            t.tv_sec  = (time_t) (nanos / NANOS_PER_SECOND);
+            t.tv_nsec = (long)   (nanos % NANOS_PER_SECOND);
+            return t;
+        }
+
+        int fd;
+        int64 deadline, delta;
+
+        TREECORE_DECLARE_NON_COPYABLE( Clock )
+    };
+
+    static bool setCurrentThreadToRealtime( int priority )
+    {
+        if (priority <= 0)
+            return true;
+
+        struct sched_param param;
+        param.sched_priority = jlimit( sched_get_priority_min( SCHED_FIFO ),
+                                       sched_get_priority_max( SCHED_FIFO ),
+                                       priority );
+
+        return pthread_setschedparam( pthread_self(), SCHED_FIFO, &param ) == 0;
+    }
+
+    TREECORE_DECLARE_NON_COPYABLE( Pimpl )
+};
+
+}
+
+#endif // TREECORE_NATIVE_LINUX_HIGH_RESOLUTION_TIMER_H
@@ -38,6 +38,7 @@
 #include <langinfo.h>
 #include <sys/sysinfo.h>
 #include <sys/time.h>
+#include <unistd.h>
 #include <pwd.h>
 
 namespace treecore {
@@ -160,14 +161,9 @@ String SystemStats::getDisplayLanguage() { return getUserLanguage() + "-" + getU
 //==============================================================================
 void CPUInformation::initialise() noexcept
 {
-    const String flags (LinuxStatsHelpers::getCpuInfo ("flags"));
-    hasMMX   = flags.contains ("mmx");
-    hasSSE   = flags.contains ("sse");
-    hasSSE2  = flags.contains ("sse2");
-    hasSSE3  = flags.contains ("sse3");
-    has3DNow = flags.contains ("3dnow");
-
-    numCpus = LinuxStatsHelpers::getCpuInfo ("processor").getIntValue() + 1;
+    // don't parse /proc/cpuinfo into Strings here: String functions select
+    // their SIMD kernels by CPU features, which are detected through this
+    numCpus = jmax (1, (int) sysconf (_SC_NPROCESSORS_CONF));
 }
 
 //==============================================================================
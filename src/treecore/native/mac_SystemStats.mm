@@ -92,17 +92,6 @@ static void doCPUID( uint32& a, uint32& b, uint32& c, uint32& d, uint32 type )
 //==============================================================================
 void CPUInformation::initialise() noexcept
 {
-#if TREECORE_CPU_X86 && !TREECORE_NO_INLINE_ASM
-    uint32 a = 0, b = 0, d = 0, c = 0;
-    SystemStatsHelpers::doCPUID( a, b, c, d, 1 );
-
-    hasMMX   = ( d & (1u << 23) ) != 0;
-    hasSSE   = ( d & (1u << 25) ) != 0;
-    hasSSE2  = ( d & (1u << 26) ) != 0;
-    has3DNow = ( b & (1u << 31) ) != 0;
-    hasSSE3  = ( c & (1u <<  0) ) != 0;
-#endif
-
 #if TREECORE_OS_IOS || (MAC_OS_X_VERSION_MIN_REQUIRED >= MAC_OS_X_VERSION_10_5)
     numCpus = (int) [[NSProcessInfo processInfo] activeProcessorCount];
 #else
@@ -0,0 +1,104 @@
+#include "treecore/Futex.h"
+#include "treecore/AtomicFunc.h"
+
+#include <errno.h>
+#include <pthread.h>
+#include <sys/time.h>
+
+namespace treecore
+{
+
+//
+// There is no public futex on this system, so parked threads sleep on a
+// condition variable chosen by hashing the watched address. Wakers always
+// broadcast, as unrelated addresses may share one bucket.
+//
+namespace
+{
+
+struct ParkingBucket
+{
+    pthread_mutex_t mutex;
+    pthread_cond_t  cond;
+};
+
+struct ParkingLot
+{
+    enum { NUM_BUCKETS = 64 };
+
+    ParkingLot()
+    {
+        for (int i = 0; i < NUM_BUCKETS; i++)
+        {
+            pthread_mutex_init( &buckets[i].mutex, nullptr );
+            pthread_cond_init( &buckets[i].cond, nullptr );
+        }
+    }
+
+    ParkingBucket& getBucket( const int32* addr ) noexcept
+    {
+        const size_t key = size_t( addr ) / sizeof(int32);
+        return buckets[(key ^ (key >> 6)) % NUM_BUCKETS];
+    }
+
+    ParkingBucket buckets[NUM_BUCKETS];
+};
+
+ParkingLot& get_parking_lot()
+{
+    static ParkingLot lot;
+    return lot;
+}
+
+} // anonymous namespace
+
+bool futex_wait( int32* addr, int32 expected, int timeout_ms ) noexcept
+{
+    ParkingBucket& bucket = get_parking_lot().getBucket( addr );
+    bool re = true;
+
+    pthread_mutex_lock( &bucket.mutex );
+
+    if (atomic_load( addr ) == expected)
+    {
+        if (timeout_ms < 0)
+        {
+            pthread_cond_wait( &bucket.cond, &bucket.mutex );
+        }
+        else
+        {
+            struct timeval now;
+            gettimeofday( &now, 0 );
+
+            struct timespec time;
+            time.tv_sec  = now.tv_sec  + (timeout_ms / 1000);
+            time.tv_nsec = ( now.tv_usec + ( (timeout_ms % 1000) * 1000 ) ) * 1000;
+
+            if (time.tv_nsec >= 1000000000)
+            {
+                time.tv_nsec -= 1000000000;
+                time.tv_sec++;
+            }
+
+            re = pthread_cond_timedwait( &bucket.cond, &bucket.mutex, &time ) != ETIMEDOUT;
+        }
+    }
+
+    pthread_mutex_unlock( &bucket.mutex );
+    return re;
+}
+
+void futex_wake_one( int32* addr ) noexcept
+{
+    futex_wake_all( addr );
+}
+
+void futex_wake_all( int32* addr ) noexcept
+{
+    ParkingBucket& bucket = get_parking_lot().getBucket( addr );
+    pthread_mutex_lock( &bucket.mutex );
+    pthread_cond_broadcast( &bucket.cond );
+    pthread_mutex_unlock( &bucket.mutex );
+}
+
+} // namespace treecore
@@ -0,0 +1,29 @@
+#include "treecore/Futex.h"
+
+#include <windows.h>
+
+namespace treecore
+{
+
+// WaitOnAddress family requires Windows 8, and linking with Synchronization.lib
+bool futex_wait( int32* addr, int32 expected, int timeout_ms ) noexcept
+{
+    const DWORD timeout = timeout_ms < 0 ? INFINITE : DWORD( timeout_ms );
+
+    if ( WaitOnAddress( (volatile VOID*) addr, &expected, sizeof(int32), timeout ) )
+        return true;
+
+    return GetLastError() != ERROR_TIMEOUT;
+}
+
+void futex_wake_one( int32* addr ) noexcept
+{
+    WakeByAddressSingle( addr );
+}
+
+void futex_wake_all( int32* addr ) noexcept
+{
+    WakeByAddressAll( addr );
+}
+
+} // namespace treecore
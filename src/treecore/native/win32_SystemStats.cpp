@@ -112,16 +112,6 @@ String SystemStats::getCpuVendor()
 //==============================================================================
 void CPUInformation::initialise() noexcept
 {
-    int info[4] = { 0 };
-    callCPUID( info, 1 );
-
-    // NB: IsProcessorFeaturePresent doesn't work on XP
-    hasMMX   = ( info[3] & (1 << 23) ) != 0;
-    hasSSE   = ( info[3] & (1 << 25) ) != 0;
-    hasSSE2  = ( info[3] & (1 << 26) ) != 0;
-    hasSSE3  = ( info[2] & (1 <<  0) ) != 0;
-    has3DNow = ( info[1] & (1 << 31) ) != 0;
-
     SYSTEM_INFO systemInfo;
     GetNativeSystemInfo( &systemInfo );
     numCpus = (int) systemInfo.dwNumberOfProcessors;
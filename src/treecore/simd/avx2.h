@@ -0,0 +1,433 @@
+#ifndef TREECORE_SIMD_FUNC_AVX2_H
+#define TREECORE_SIMD_FUNC_AVX2_H
+
+#include "treecore/simd/sse2.h"
+
+#if !defined(__AVX2__)
+#    error "treecore is configured with AVX2 support, but current compiler flags don't enable AVX2 (use -mavx2 -mfma or /arch:AVX2)"
+#endif
+
+#include <immintrin.h>
+
+namespace treecore
+{
+
+//
+// 32-byte AVX2 operations
+//
+// Byte shifts work on the whole 256 bits, just like the 16-byte version.
+// Shuffle reorders 32-bit elements inside each 128-bit lane.
+//
+template<>
+union SIMDType<32>
+{
+    __m256 simd_by_float;
+    __m256i simd_by_int;
+    __m256d simd_by_double;
+    int8 values_by_i8[32];
+    int16 values_by_i16[16];
+    int32 values_by_i32[8];
+    int64 values_by_i64[4];
+    float values_by_float[8];
+    double values_by_double[4];
+};
+
+static_assert( sizeof(SIMDType<32>) == 32, "SIMDType<32> is 32 byte" );
+
+// get and set one component
+#define TREECORE_SIMD_GETSET_ONE_( _sz_, _type_, _member_, _idx_ ) \
+    template<> inline _type_ simd_get_one<_idx_, _type_, _sz_>( const SIMDType<_sz_>& data ) noexcept { return data._member_[_idx_]; } \
+    template<> inline void simd_set_one<_idx_, _type_, _sz_>( SIMDType<_sz_>& target, _type_ value ) noexcept { target._member_[_idx_] = value; }
+
+#define TREECORE_SIMD_GETSET_ONE_2_( _sz_, _type_, _member_, _base_ ) \
+    TREECORE_SIMD_GETSET_ONE_( _sz_, _type_, _member_, _base_ ) \
+    TREECORE_SIMD_GETSET_ONE_( _sz_, _type_, _member_, _base_ + 1 )
+#define TREECORE_SIMD_GETSET_ONE_4_( _sz_, _type_, _member_, _base_ ) \
+    TREECORE_SIMD_GETSET_ONE_2_( _sz_, _type_, _member_, _base_ ) \
+    TREECORE_SIMD_GETSET_ONE_2_( _sz_, _type_, _member_, _base_ + 2 )
+#define TREECORE_SIMD_GETSET_ONE_8_( _sz_, _type_, _member_, _base_ ) \
+    TREECORE_SIMD_GETSET_ONE_4_( _sz_, _type_, _member_, _base_ ) \
+    TREECORE_SIMD_GETSET_ONE_4_( _sz_, _type_, _member_, _base_ + 4 )
+#define TREECORE_SIMD_GETSET_ONE_16_( _sz_, _type_, _member_, _base_ ) \
+    TREECORE_SIMD_GETSET_ONE_8_( _sz_, _type_, _member_, _base_ ) \
+    TREECORE_SIMD_GETSET_ONE_8_( _sz_, _type_, _member_, _base_ + 8 )
+#define TREECORE_SIMD_GETSET_ONE_32_( _sz_, _type_, _member_, _base_ ) \
+    TREECORE_SIMD_GETSET_ONE_16_( _sz_, _type_, _member_, _base_ ) \
+    TREECORE_SIMD_GETSET_ONE_16_( _sz_, _type_, _member_, _base_ + 16 )
+#define TREECORE_SIMD_GETSET_ONE_64_( _sz_, _type_, _member_, _base_ ) \
+    TREECORE_SIMD_GETSET_ONE_32_( _sz_, _type_, _member_, _base_ ) \
+    TREECORE_SIMD_GETSET_ONE_32_( _sz_, _type_, _member_, _base_ + 32 )
+
+TREECORE_SIMD_GETSET_ONE_32_( 32, int8,   values_by_i8,     0 )
+TREECORE_SIMD_GETSET_ONE_16_( 32, int16,  values_by_i16,    0 )
+TREECORE_SIMD_GETSET_ONE_8_(  32, int32,  values_by_i32,    0 )
+TREECORE_SIMD_GETSET_ONE_4_(  32, int64,  values_by_i64,    0 )
+TREECORE_SIMD_GETSET_ONE_8_(  32, float,  values_by_float,  0 )
+TREECORE_SIMD_GETSET_ONE_4_(  32, double, values_by_double, 0 )
+
+// get all components
+template<> inline void simd_get_all<int8,   32>( const SIMDType<32>& target, int8*   store ) noexcept { _mm256_storeu_si256( (__m256i*) store, target.simd_by_int ); }
+template<> inline void simd_get_all<int16,  32>( const SIMDType<32>& target, int16*  store ) noexcept { _mm256_storeu_si256( (__m256i*) store, target.simd_by_int ); }
+template<> inline void simd_get_all<int32,  32>( const SIMDType<32>& target, int32*  store ) noexcept { _mm256_storeu_si256( (__m256i*) store, target.simd_by_int ); }
+template<> inline void simd_get_all<int64,  32>( const SIMDType<32>& target, int64*  store ) noexcept { _mm256_storeu_si256( (__m256i*) store, target.simd_by_int ); }
+template<> inline void simd_get_all<float,  32>( const SIMDType<32>& target, float*  store ) noexcept { _mm256_storeu_ps( store, target.simd_by_float ); }
+template<> inline void simd_get_all<double, 32>( const SIMDType<32>& target, double* store ) noexcept { _mm256_storeu_pd( store, target.simd_by_double ); }
+
+// set all components by specifying all of them
+template<> inline void simd_set_all<int16, 32>( SIMDType<32>& target,
+                                                int16 v0, int16 v1, int16 v2, int16 v3, int16 v4, int16 v5, int16 v6, int16 v7,
+                                                int16 v8, int16 v9, int16 v10, int16 v11, int16 v12, int16 v13, int16 v14, int16 v15 ) noexcept
+{
+    target.simd_by_int = _mm256_set_epi16( v15, v14, v13, v12, v11, v10, v9, v8, v7, v6, v5, v4, v3, v2, v1, v0 );
+}
+
+template<> inline void simd_set_all<int32,  32>( SIMDType<32>& target, int32 a, int32 b, int32 c, int32 d, int32 e, int32 f, int32 g, int32 h ) noexcept { target.simd_by_int = _mm256_set_epi32( h, g, f, e, d, c, b, a ); }
+template<> inline void simd_set_all<int64,  32>( SIMDType<32>& target, int64 a, int64 b, int64 c, int64 d )                                         noexcept { target.simd_by_int = _mm256_set_epi64x( d, c, b, a ); }
+template<> inline void simd_set_all<float,  32>( SIMDType<32>& target, float a, float b, float c, float d, float e, float f, float g, float h ) noexcept { target.simd_by_float = _mm256_set_ps( h, g, f, e, d, c, b, a ); }
+template<> inline void simd_set_all<double, 32>( SIMDType<32>& target, double a, double b, double c, double d )                                     noexcept { target.simd_by_double = _mm256_set_pd( d, c, b, a ); }
+
+template<> inline void simd_set_all<int8,   32>( SIMDType<32>& target, const int8* values )   noexcept { target.simd_by_int = _mm256_loadu_si256( (const __m256i*) values ); }
+template<> inline void simd_set_all<int16,  32>( SIMDType<32>& target, const int16* values )  noexcept { target.simd_by_int = _mm256_loadu_si256( (const __m256i*) values ); }
+template<> inline void simd_set_all<int32,  32>( SIMDType<32>& target, const int32* values )  noexcept { target.simd_by_int = _mm256_loadu_si256( (const __m256i*) values ); }
+template<> inline void simd_set_all<int64,  32>( SIMDType<32>& target, const int64* values )  noexcept { target.simd_by_int = _mm256_loadu_si256( (const __m256i*) values ); }
+template<> inline void simd_set_all<float,  32>( SIMDType<32>& target, const float* values )  noexcept { target.simd_by_float = _mm256_loadu_ps( values );                       }
+template<> inline void simd_set_all<double, 32>( SIMDType<32>& target, const double* values ) noexcept { target.simd_by_double = _mm256_loadu_pd( values );                       }
+
+// set all components using one same value
+template<> inline void simd_broadcast<int8,   32>( SIMDType<32>& target, int8 value )   noexcept { target.simd_by_int = _mm256_set1_epi8( value );    }
+template<> inline void simd_broadcast<int16,  32>( SIMDType<32>& target, int16 value )  noexcept { target.simd_by_int = _mm256_set1_epi16( value );   }
+template<> inline void simd_broadcast<int32,  32>( SIMDType<32>& target, int32 value )  noexcept { target.simd_by_int = _mm256_set1_epi32( value );   }
+template<> inline void simd_broadcast<int64,  32>( SIMDType<32>& target, int64 value )  noexcept { target.simd_by_int = _mm256_set1_epi64x( value );  }
+template<> inline void simd_broadcast<float,  32>( SIMDType<32>& target, float value )  noexcept { target.simd_by_float = _mm256_set1_ps( value );    }
+template<> inline void simd_broadcast<double, 32>( SIMDType<32>& target, double value ) noexcept { target.simd_by_double = _mm256_set1_pd( value );   }
+
+// arithmetical and logical operations
+template<> inline void simd_add<int8,   32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_int = _mm256_add_epi8( a.simd_by_int,  b.simd_by_int ); }
+template<> inline void simd_add<int16,  32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_int = _mm256_add_epi16( a.simd_by_int, b.simd_by_int ); }
+template<> inline void simd_add<int32,  32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_int = _mm256_add_epi32( a.simd_by_int, b.simd_by_int ); }
+template<> inline void simd_add<int64,  32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_int = _mm256_add_epi64( a.simd_by_int, b.simd_by_int ); }
+template<> inline void simd_add<float,  32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_float = _mm256_add_ps( a.simd_by_float,  b.simd_by_float ); }
+template<> inline void simd_add<double, 32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_double = _mm256_add_pd( a.simd_by_double, b.simd_by_double ); }
+
+template<> inline void simd_sub<int8,   32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_int = _mm256_sub_epi8( a.simd_by_int,  b.simd_by_int ); }
+template<> inline void simd_sub<int16,  32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_int = _mm256_sub_epi16( a.simd_by_int, b.simd_by_int ); }
+template<> inline void simd_sub<int32,  32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_int = _mm256_sub_epi32( a.simd_by_int, b.simd_by_int ); }
+template<> inline void simd_sub<int64,  32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_int = _mm256_sub_epi64( a.simd_by_int, b.simd_by_int ); }
+template<> inline void simd_sub<float,  32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_float = _mm256_sub_ps( a.simd_by_float,  b.simd_by_float ); }
+template<> inline void simd_sub<double, 32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_double = _mm256_sub_pd( a.simd_by_double, b.simd_by_double ); }
+
+template<> inline void simd_mul<int16,  32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_int = _mm256_mullo_epi16( a.simd_by_int, b.simd_by_int ); }
+template<> inline void simd_mul<int32,  32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_int = _mm256_mullo_epi32( a.simd_by_int, b.simd_by_int ); }
+template<> inline void simd_mul<uint32, 32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_int = _mm256_mul_epu32( a.simd_by_int,   b.simd_by_int ); }
+template<> inline void simd_mul<float,  32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_float = _mm256_mul_ps( a.simd_by_float,  b.simd_by_float ); }
+template<> inline void simd_mul<double, 32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_double = _mm256_mul_pd( a.simd_by_double, b.simd_by_double ); }
+
+template<> inline void simd_div<float,  32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_float = _mm256_div_ps( a.simd_by_float,  b.simd_by_float ); }
+template<> inline void simd_div<double, 32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_double = _mm256_div_pd( a.simd_by_double, b.simd_by_double ); }
+
+// Conversion between 4-byte and 8-byte types uses the lower half of the
+// 4-byte side, and the upper half is zeroed, same as the 16-byte version.
+template<> inline void simd_convert<float,  int32,  32>( SIMDType<32>& target, SIMDType<32>& input ) noexcept { target.simd_by_float = _mm256_cvtepi32_ps( input.simd_by_int ); }
+template<> inline void simd_convert<int32,  float,  32>( SIMDType<32>& target, SIMDType<32>& input ) noexcept { target.simd_by_int = _mm256_cvttps_epi32( input.simd_by_float ); }
+template<> inline void simd_convert<float,  double, 32>( SIMDType<32>& target, SIMDType<32>& input ) noexcept { target.simd_by_float = _mm256_insertf128_ps( _mm256_setzero_ps(), _mm256_cvtpd_ps( input.simd_by_double ), 0 ); }
+template<> inline void simd_convert<int32,  double, 32>( SIMDType<32>& target, SIMDType<32>& input ) noexcept { target.simd_by_int = _mm256_inserti128_si256( _mm256_setzero_si256(), _mm256_cvttpd_epi32( input.simd_by_double ), 0 ); }
+template<> inline void simd_convert<double, float,  32>( SIMDType<32>& target, SIMDType<32>& input ) noexcept { target.simd_by_double = _mm256_cvtps_pd( _mm256_castps256_ps128( input.simd_by_float ) ); }
+template<> inline void simd_convert<double, int32,  32>( SIMDType<32>& target, SIMDType<32>& input ) noexcept { target.simd_by_double = _mm256_cvtepi32_pd( _mm256_castsi256_si128( input.simd_by_int ) ); }
+
+template<> inline void simd_cmpl<float,  32>( SIMDType<32>& target ) noexcept { target.simd_by_float = _mm256_xor_ps( target.simd_by_float, _mm256_castsi256_ps( _mm256_set1_epi32( -1 ) ) ); }
+template<> inline void simd_cmpl<double, 32>( SIMDType<32>& target ) noexcept { target.simd_by_double = _mm256_xor_pd( target.simd_by_double, _mm256_castsi256_pd( _mm256_set1_epi32( -1 ) ) ); }
+template<> inline void simd_cmpl<int,    32>( SIMDType<32>& target ) noexcept { target.simd_by_int = _mm256_xor_si256( target.simd_by_int, _mm256_set1_epi32( -1 ) ); }
+
+template<> inline void simd_and<int32,  32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_int = _mm256_and_si256( a.simd_by_int,    b.simd_by_int );    }
+template<> inline void simd_and<int64,  32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_int = _mm256_and_si256( a.simd_by_int,    b.simd_by_int );    }
+template<> inline void simd_and<float,  32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_float = _mm256_and_ps( a.simd_by_float,  b.simd_by_float );   }
+template<> inline void simd_and<double, 32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_double = _mm256_and_pd( a.simd_by_double, b.simd_by_double ); }
+
+template<> inline void simd_or<int32,  32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_int = _mm256_or_si256( a.simd_by_int,    b.simd_by_int );    }
+template<> inline void simd_or<int64,  32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_int = _mm256_or_si256( a.simd_by_int,    b.simd_by_int );    }
+template<> inline void simd_or<float,  32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_float = _mm256_or_ps( a.simd_by_float,  b.simd_by_float );   }
+template<> inline void simd_or<double, 32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_double = _mm256_or_pd( a.simd_by_double, b.simd_by_double ); }
+
+template<> inline void simd_xor<int32,  32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_int = _mm256_xor_si256( a.simd_by_int,    b.simd_by_int );    }
+template<> inline void simd_xor<int64,  32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_int = _mm256_xor_si256( a.simd_by_int,    b.simd_by_int );    }
+template<> inline void simd_xor<float,  32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_float = _mm256_xor_ps( a.simd_by_float,  b.simd_by_float );   }
+template<> inline void simd_xor<double, 32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_double = _mm256_xor_pd( a.simd_by_double, b.simd_by_double ); }
+
+template<> inline void simd_nand<int32,  32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_int = _mm256_andnot_si256( a.simd_by_int,    b.simd_by_int );    }
+template<> inline void simd_nand<int64,  32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_int = _mm256_andnot_si256( a.simd_by_int,    b.simd_by_int );    }
+template<> inline void simd_nand<float,  32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_float = _mm256_andnot_ps( a.simd_by_float,  b.simd_by_float );   }
+template<> inline void simd_nand<double, 32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_double = _mm256_andnot_pd( a.simd_by_double, b.simd_by_double ); }
+
+template<> inline void simd_shift_left<int16, 32>( SIMDType<32>& result, const SIMDType<32>& input, int shift_value ) noexcept { result.simd_by_int = _mm256_sll_epi16( input.simd_by_int, _mm_cvtsi32_si128( shift_value ) ); }
+template<> inline void simd_shift_left<int32, 32>( SIMDType<32>& result, const SIMDType<32>& input, int shift_value ) noexcept { result.simd_by_int = _mm256_sll_epi32( input.simd_by_int, _mm_cvtsi32_si128( shift_value ) ); }
+template<> inline void simd_shift_left<int64, 32>( SIMDType<32>& result, const SIMDType<32>& input, int shift_value ) noexcept { result.simd_by_int = _mm256_sll_epi64( input.simd_by_int, _mm_cvtsi32_si128( shift_value ) ); }
+
+template<> inline void simd_shift_right_zero<int16, 32>( SIMDType<32>& result, const SIMDType<32>& input, int shift_value ) noexcept { result.simd_by_int = _mm256_srl_epi16( input.simd_by_int, _mm_cvtsi32_si128( shift_value ) ); }
+template<> inline void simd_shift_right_zero<int32, 32>( SIMDType<32>& result, const SIMDType<32>& input, int shift_value ) noexcept { result.simd_by_int = _mm256_srl_epi32( input.simd_by_int, _mm_cvtsi32_si128( shift_value ) ); }
+template<> inline void simd_shift_right_zero<int64, 32>( SIMDType<32>& result, const SIMDType<32>& input, int shift_value ) noexcept { result.simd_by_int = _mm256_srl_epi64( input.simd_by_int, _mm_cvtsi32_si128( shift_value ) ); }
+
+template<> inline void simd_shift_right_sign<int16, 32>( SIMDType<32>& result, const SIMDType<32>& input, int shift_value ) noexcept { result.simd_by_int = _mm256_sra_epi16( input.simd_by_int, _mm_cvtsi32_si128( shift_value ) ); }
+template<> inline void simd_shift_right_sign<int32, 32>( SIMDType<32>& result, const SIMDType<32>& input, int shift_value ) noexcept { result.simd_by_int = _mm256_sra_epi32( input.simd_by_int, _mm_cvtsi32_si128( shift_value ) ); }
+
+// AVX2 byte shift instructions work inside 128-bit lanes, so bytes crossing
+// the lane boundary are taken from a lane-swapped copy
+template<int SHIFT_COUNT>
+inline __m256i _avx2_shift_byte_left_( __m256i input ) noexcept
+{
+    // low lane zero, high lane is low lane of input
+    const __m256i carry = _mm256_permute2x128_si256( input, input, 0x08 );
+
+    if (SHIFT_COUNT < 16)
+        return _mm256_alignr_epi8( input, carry, (16 - SHIFT_COUNT) & 0xff );
+    else
+        return _mm256_slli_si256( carry, (SHIFT_COUNT - 16) & 0xff );
+}
+
+template<int SHIFT_COUNT>
+inline __m256i _avx2_shift_byte_right_( __m256i input ) noexcept
+{
+    // low lane is high lane of input, high lane zero
+    const __m256i carry = _mm256_permute2x128_si256( input, input, 0x81 );
+
+    if (SHIFT_COUNT < 16)
+        return _mm256_alignr_epi8( carry, input, SHIFT_COUNT & 0xff );
+    else
+        return _mm256_srli_si256( carry, (SHIFT_COUNT - 16) & 0xff );
+}
+
+#define TREECORE_SIMD_SHIFT_BYTE_( _sz_, _impl_, _n_ ) \
+    template<> inline void simd_shift_byte_left<_n_,  _sz_>( SIMDType<_sz_>& result, const SIMDType<_sz_>& input ) noexcept { result.simd_by_int = _impl_ ## _shift_byte_left_<_n_>( input.simd_by_int ); } \
+    template<> inline void simd_shift_byte_right<_n_, _sz_>( SIMDType<_sz_>& result, const SIMDType<_sz_>& input ) noexcept { result.simd_by_int = _impl_ ## _shift_byte_right_<_n_>( input.simd_by_int ); }
+
+#define TREECORE_SIMD_SHIFT_BYTE_8_( _sz_, _impl_, _base_ ) \
+    TREECORE_SIMD_SHIFT_BYTE_( _sz_, _impl_, _base_ )     TREECORE_SIMD_SHIFT_BYTE_( _sz_, _impl_, _base_ + 1 ) \
+    TREECORE_SIMD_SHIFT_BYTE_( _sz_, _impl_, _base_ + 2 ) TREECORE_SIMD_SHIFT_BYTE_( _sz_, _impl_, _base_ + 3 ) \
+    TREECORE_SIMD_SHIFT_BYTE_( _sz_, _impl_, _base_ + 4 ) TREECORE_SIMD_SHIFT_BYTE_( _sz_, _impl_, _base_ + 5 ) \
+    TREECORE_SIMD_SHIFT_BYTE_( _sz_, _impl_, _base_ + 6 ) TREECORE_SIMD_SHIFT_BYTE_( _sz_, _impl_, _base_ + 7 )
+
+TREECORE_SIMD_SHIFT_BYTE_8_( 32, _avx2, 0 )
+TREECORE_SIMD_SHIFT_BYTE_8_( 32, _avx2, 8 )
+TREECORE_SIMD_SHIFT_BYTE_8_( 32, _avx2, 16 )
+TREECORE_SIMD_SHIFT_BYTE_8_( 32, _avx2, 24 )
+TREECORE_SIMD_SHIFT_BYTE_( 32, _avx2, 32 )
+
+// comparison
+template<> inline void simd_cmp<int8,   32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_int = _mm256_cmpeq_epi8( a.simd_by_int,  b.simd_by_int ); }
+template<> inline void simd_cmp<int16,  32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_int = _mm256_cmpeq_epi16( a.simd_by_int, b.simd_by_int ); }
+template<> inline void simd_cmp<int32,  32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_int = _mm256_cmpeq_epi32( a.simd_by_int, b.simd_by_int ); }
+template<> inline void simd_cmp<int64,  32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_int = _mm256_cmpeq_epi64( a.simd_by_int, b.simd_by_int ); }
+template<> inline void simd_cmp<float,  32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_float = _mm256_cmp_ps( a.simd_by_float,  b.simd_by_float,  _CMP_EQ_OQ ); }
+template<> inline void simd_cmp<double, 32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_double = _mm256_cmp_pd( a.simd_by_double, b.simd_by_double, _CMP_EQ_OQ ); }
+
+template<> inline void simd_ncmp<int8,   32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_int = _mm256_xor_si256( _mm256_cmpeq_epi8( a.simd_by_int, b.simd_by_int ),  _mm256_set1_epi8( -1 ) ); }
+template<> inline void simd_ncmp<int16,  32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_int = _mm256_xor_si256( _mm256_cmpeq_epi16( a.simd_by_int, b.simd_by_int ), _mm256_set1_epi8( -1 ) ); }
+template<> inline void simd_ncmp<int32,  32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_int = _mm256_xor_si256( _mm256_cmpeq_epi32( a.simd_by_int, b.simd_by_int ), _mm256_set1_epi8( -1 ) ); }
+template<> inline void simd_ncmp<int64,  32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_int = _mm256_xor_si256( _mm256_cmpeq_epi64( a.simd_by_int, b.simd_by_int ), _mm256_set1_epi8( -1 ) ); }
+template<> inline void simd_ncmp<float,  32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_float = _mm256_cmp_ps( a.simd_by_float,  b.simd_by_float,  _CMP_NEQ_UQ ); }
+template<> inline void simd_ncmp<double, 32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_double = _mm256_cmp_pd( a.simd_by_double, b.simd_by_double, _CMP_NEQ_UQ ); }
+
+template<> inline void simd_gt<int8,   32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_int = _mm256_cmpgt_epi8( a.simd_by_int,  b.simd_by_int ); }
+template<> inline void simd_gt<int16,  32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_int = _mm256_cmpgt_epi16( a.simd_by_int, b.simd_by_int ); }
+template<> inline void simd_gt<int32,  32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_int = _mm256_cmpgt_epi32( a.simd_by_int, b.simd_by_int ); }
+template<> inline void simd_gt<int64,  32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_int = _mm256_cmpgt_epi64( a.simd_by_int, b.simd_by_int ); }
+template<> inline void simd_gt<float,  32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_float = _mm256_cmp_ps( a.simd_by_float,  b.simd_by_float,  _CMP_GT_OQ ); }
+template<> inline void simd_gt<double, 32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_double = _mm256_cmp_pd( a.simd_by_double, b.simd_by_double, _CMP_GT_OQ ); }
+
+template<> inline void simd_ge<int8,   32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_int = _mm256_xor_si256( _mm256_cmpgt_epi8( b.simd_by_int, a.simd_by_int ),  _mm256_set1_epi8( -1 ) ); }
+template<> inline void simd_ge<int16,  32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_int = _mm256_xor_si256( _mm256_cmpgt_epi16( b.simd_by_int, a.simd_by_int ), _mm256_set1_epi8( -1 ) ); }
+template<> inline void simd_ge<int32,  32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_int = _mm256_xor_si256( _mm256_cmpgt_epi32( b.simd_by_int, a.simd_by_int ), _mm256_set1_epi8( -1 ) ); }
+template<> inline void simd_ge<int64,  32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_int = _mm256_xor_si256( _mm256_cmpgt_epi64( b.simd_by_int, a.simd_by_int ), _mm256_set1_epi8( -1 ) ); }
+template<> inline void simd_ge<float,  32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_float = _mm256_cmp_ps( a.simd_by_float,  b.simd_by_float,  _CMP_GE_OQ ); }
+template<> inline void simd_ge<double, 32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_double = _mm256_cmp_pd( a.simd_by_double, b.simd_by_double, _CMP_GE_OQ ); }
+
+template<> inline void simd_lt<int8,   32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_int = _mm256_cmpgt_epi8( b.simd_by_int,  a.simd_by_int ); }
+template<> inline void simd_lt<int16,  32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_int = _mm256_cmpgt_epi16( b.simd_by_int, a.simd_by_int ); }
+template<> inline void simd_lt<int32,  32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_int = _mm256_cmpgt_epi32( b.simd_by_int, a.simd_by_int ); }
+template<> inline void simd_lt<int64,  32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_int = _mm256_cmpgt_epi64( b.simd_by_int, a.simd_by_int ); }
+template<> inline void simd_lt<float,  32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_float = _mm256_cmp_ps( a.simd_by_float,  b.simd_by_float,  _CMP_LT_OQ ); }
+template<> inline void simd_lt<double, 32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_double = _mm256_cmp_pd( a.simd_by_double, b.simd_by_double, _CMP_LT_OQ ); }
+
+template<> inline void simd_le<int8,   32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_int = _mm256_xor_si256( _mm256_cmpgt_epi8( a.simd_by_int, b.simd_by_int ),  _mm256_set1_epi8( -1 ) ); }
+template<> inline void simd_le<int16,  32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_int = _mm256_xor_si256( _mm256_cmpgt_epi16( a.simd_by_int, b.simd_by_int ), _mm256_set1_epi8( -1 ) ); }
+template<> inline void simd_le<int32,  32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_int = _mm256_xor_si256( _mm256_cmpgt_epi32( a.simd_by_int, b.simd_by_int ), _mm256_set1_epi8( -1 ) ); }
+template<> inline void simd_le<int64,  32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_int = _mm256_xor_si256( _mm256_cmpgt_epi64( a.simd_by_int, b.simd_by_int ), _mm256_set1_epi8( -1 ) ); }
+template<> inline void simd_le<float,  32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_float = _mm256_cmp_ps( a.simd_by_float,  b.simd_by_float,  _CMP_LE_OQ ); }
+template<> inline void simd_le<double, 32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_double = _mm256_cmp_pd( a.simd_by_double, b.simd_by_double, _CMP_LE_OQ ); }
+
+// integer equality is bitwise equality
+template<> inline bool simd_equal<int8,  32>( const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { return _mm256_movemask_epi8( _mm256_cmpeq_epi8( a.simd_by_int, b.simd_by_int ) ) == -1; }
+template<> inline bool simd_equal<int16, 32>( const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { return _mm256_movemask_epi8( _mm256_cmpeq_epi8( a.simd_by_int, b.simd_by_int ) ) == -1; }
+template<> inline bool simd_equal<int32, 32>( const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { return _mm256_movemask_epi8( _mm256_cmpeq_epi8( a.simd_by_int, b.simd_by_int ) ) == -1; }
+template<> inline bool simd_equal<int64, 32>( const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { return _mm256_movemask_epi8( _mm256_cmpeq_epi8( a.simd_by_int, b.simd_by_int ) ) == -1; }
+
+template<> inline bool simd_equal<float,  32>( const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { return _mm256_movemask_ps( _mm256_cmp_ps( a.simd_by_float,  b.simd_by_float,  _CMP_EQ_OQ ) ) == 0xff; }
+template<> inline bool simd_equal<double, 32>( const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { return _mm256_movemask_pd( _mm256_cmp_pd( a.simd_by_double, b.simd_by_double, _CMP_EQ_OQ ) ) == 0xf; }
+
+// reorder 32-bit elements inside each 128-bit lane
+template<int IDX1, int IDX2, int IDX3, int IDX4>
+struct _simd_shuffle_impl_<IDX1, IDX2, IDX3, IDX4, 32>
+{
+    static void shuffle( SIMDType<32>& target )
+    {
+#ifdef _MSC_VER
+        const int control = IDX1 + (IDX2 << 2) + (IDX3 << 4) + (IDX4 << 6);
+#else
+        constexpr int control = IDX1 + (IDX2 << 2) + (IDX3 << 4) + (IDX4 << 6);
+#endif
+
+        target.simd_by_int = _mm256_shuffle_epi32( target.simd_by_int, control );
+    }
+};
+
+// horizontal sum
+template<>
+inline float simd_sum<float, 32>( const SIMDType<32>& value ) noexcept
+{
+    SIMDType<16> tmp;
+    tmp.simd_by_float = _mm_add_ps( _mm256_castps256_ps128( value.simd_by_float ), _mm256_extractf128_ps( value.simd_by_float, 1 ) );
+    return simd_sum<float, 16>( tmp );
+}
+
+template<>
+inline double simd_sum<double, 32>( const SIMDType<32>& value ) noexcept
+{
+    const __m128d half = _mm_add_pd( _mm256_castpd256_pd128( value.simd_by_double ), _mm256_extractf128_pd( value.simd_by_double, 1 ) );
+    return _mm_cvtsd_f64( _mm_add_sd( half, _mm_unpackhi_pd( half, half ) ) );
+}
+
+template<>
+inline int32 simd_sum<int32, 32>( const SIMDType<32>& value ) noexcept
+{
+    __m128i half = _mm_add_epi32( _mm256_castsi256_si128( value.simd_by_int ), _mm256_extracti128_si256( value.simd_by_int, 1 ) );
+    half = _mm_add_epi32( half, _mm_shuffle_epi32( half, 0x4e ) );
+    half = _mm_add_epi32( half, _mm_shuffle_epi32( half, 0xb1 ) );
+    return _mm_cvtsi128_si32( half );
+}
+
+// minimum and maximum
+template<> inline void simd_min<int8,   32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_int = _mm256_min_epi8( a.simd_by_int,  b.simd_by_int ); }
+template<> inline void simd_min<uint8,  32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_int = _mm256_min_epu8( a.simd_by_int,  b.simd_by_int ); }
+template<> inline void simd_min<int16,  32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_int = _mm256_min_epi16( a.simd_by_int, b.simd_by_int ); }
+template<> inline void simd_min<int32,  32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_int = _mm256_min_epi32( a.simd_by_int, b.simd_by_int ); }
+template<> inline void simd_min<float,  32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_float = _mm256_min_ps( a.simd_by_float,  b.simd_by_float ); }
+template<> inline void simd_min<double, 32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_double = _mm256_min_pd( a.simd_by_double, b.simd_by_double ); }
+
+template<> inline void simd_max<int8,   32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_int = _mm256_max_epi8( a.simd_by_int,  b.simd_by_int ); }
+template<> inline void simd_max<uint8,  32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_int = _mm256_max_epu8( a.simd_by_int,  b.simd_by_int ); }
+template<> inline void simd_max<int16,  32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_int = _mm256_max_epi16( a.simd_by_int, b.simd_by_int ); }
+template<> inline void simd_max<int32,  32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_int = _mm256_max_epi32( a.simd_by_int, b.simd_by_int ); }
+template<> inline void simd_max<float,  32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_float = _mm256_max_ps( a.simd_by_float,  b.simd_by_float ); }
+template<> inline void simd_max<double, 32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_double = _mm256_max_pd( a.simd_by_double, b.simd_by_double ); }
+
+// absolute value
+template<> inline void simd_abs<int8,   32>( SIMDType<32>& target, const SIMDType<32>& input ) noexcept { target.simd_by_int = _mm256_abs_epi8( input.simd_by_int ); }
+template<> inline void simd_abs<int16,  32>( SIMDType<32>& target, const SIMDType<32>& input ) noexcept { target.simd_by_int = _mm256_abs_epi16( input.simd_by_int ); }
+template<> inline void simd_abs<int32,  32>( SIMDType<32>& target, const SIMDType<32>& input ) noexcept { target.simd_by_int = _mm256_abs_epi32( input.simd_by_int ); }
+template<> inline void simd_abs<float,  32>( SIMDType<32>& target, const SIMDType<32>& input ) noexcept { target.simd_by_float = _mm256_and_ps( input.simd_by_float, _mm256_castsi256_ps( _mm256_set1_epi32( 0x7fffffff ) ) ); }
+template<> inline void simd_abs<double, 32>( SIMDType<32>& target, const SIMDType<32>& input ) noexcept { target.simd_by_double = _mm256_and_pd( input.simd_by_double, _mm256_castsi256_pd( _mm256_set1_epi64x( 0x7fffffffffffffffLL ) ) ); }
+
+// square root
+template<> inline void simd_sqrt<float,  32>( SIMDType<32>& target, const SIMDType<32>& input ) noexcept { target.simd_by_float = _mm256_sqrt_ps( input.simd_by_float ); }
+template<> inline void simd_sqrt<double, 32>( SIMDType<32>& target, const SIMDType<32>& input ) noexcept { target.simd_by_double = _mm256_sqrt_pd( input.simd_by_double ); }
+
+template<> inline void simd_rsqrt<float,  32>( SIMDType<32>& target, const SIMDType<32>& input ) noexcept { target.simd_by_float = _mm256_rsqrt_ps( input.simd_by_float ); }
+template<> inline void simd_rsqrt<double, 32>( SIMDType<32>& target, const SIMDType<32>& input ) noexcept { target.simd_by_double = _mm256_div_pd( _mm256_set1_pd( 1.0 ), _mm256_sqrt_pd( input.simd_by_double ) ); }
+
+// multiply-add
+#if TREECORE_SIMD_HAS_FMA_
+template<> inline void simd_mul_add<float,  32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b, const SIMDType<32>& c ) noexcept { target.simd_by_float = _mm256_fmadd_ps( a.simd_by_float, b.simd_by_float, c.simd_by_float ); }
+template<> inline void simd_mul_add<double, 32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b, const SIMDType<32>& c ) noexcept { target.simd_by_double = _mm256_fmadd_pd( a.simd_by_double, b.simd_by_double, c.simd_by_double ); }
+#else
+template<> inline void simd_mul_add<float,  32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b, const SIMDType<32>& c ) noexcept { target.simd_by_float = _mm256_add_ps( _mm256_mul_ps( a.simd_by_float, b.simd_by_float ), c.simd_by_float ); }
+template<> inline void simd_mul_add<double, 32>( SIMDType<32>& target, const SIMDType<32>& a, const SIMDType<32>& b, const SIMDType<32>& c ) noexcept { target.simd_by_double = _mm256_add_pd( _mm256_mul_pd( a.simd_by_double, b.simd_by_double ), c.simd_by_double ); }
+#endif
+
+// select by mask, all element types are handled bitwise
+#define TREECORE_SIMD_SELECT_32_( _type_ ) \
+    template<> inline void simd_select<_type_, 32>( SIMDType<32>& target, const SIMDType<32>& mask, const SIMDType<32>& a, const SIMDType<32>& b ) noexcept { target.simd_by_int = _mm256_blendv_epi8( b.simd_by_int, a.simd_by_int, mask.simd_by_int ); }
+
+TREECORE_SIMD_SELECT_32_( int8 )
+TREECORE_SIMD_SELECT_32_( int16 )
+TREECORE_SIMD_SELECT_32_( int32 )
+TREECORE_SIMD_SELECT_32_( int64 )
+TREECORE_SIMD_SELECT_32_( float )
+TREECORE_SIMD_SELECT_32_( double )
+
+// highest bit of each element
+template<> inline uint64 simd_movemask<int8,   32>( const SIMDType<32>& value ) noexcept { return uint64( uint32( _mm256_movemask_epi8( value.simd_by_int ) ) ); }
+template<> inline uint64 simd_movemask<int32,  32>( const SIMDType<32>& value ) noexcept { return uint64( _mm256_movemask_ps( _mm256_castsi256_ps( value.simd_by_int ) ) ); }
+template<> inline uint64 simd_movemask<int64,  32>( const SIMDType<32>& value ) noexcept { return uint64( _mm256_movemask_pd( _mm256_castsi256_pd( value.simd_by_int ) ) ); }
+template<> inline uint64 simd_movemask<float,  32>( const SIMDType<32>& value ) noexcept { return uint64( _mm256_movemask_ps( value.simd_by_float ) ); }
+template<> inline uint64 simd_movemask<double, 32>( const SIMDType<32>& value ) noexcept { return uint64( _mm256_movemask_pd( value.simd_by_double ) ); }
+
+template<> inline uint64 simd_movemask<int16, 32>( const SIMDType<32>& value ) noexcept
+{
+    // pack works inside 128-bit lanes, bring the two packed quadwords together
+    const __m256i packed = _mm256_packs_epi16( value.simd_by_int, value.simd_by_int );
+    return uint64( uint32( _mm256_movemask_epi8( _mm256_permute4x64_epi64( packed, 0x08 ) ) ) & 0xffff );
+}
+
+// partial load and store by masked move, which never faults on masked-out
+// elements
+inline __m256i _avx2_partial_mask_32_( int count ) noexcept
+{
+    return _mm256_cmpgt_epi32( _mm256_set1_epi32( count ), _mm256_setr_epi32( 0, 1, 2, 3, 4, 5, 6, 7 ) );
+}
+
+inline __m256i _avx2_partial_mask_64_( int count ) noexcept
+{
+    return _mm256_cmpgt_epi64( _mm256_set1_epi64x( count ), _mm256_setr_epi64x( 0, 1, 2, 3 ) );
+}
+
+template<> inline void simd_load_partial<int32,  32>( SIMDType<32>& target, const int32* values, int count )  noexcept { target.simd_by_int = _mm256_maskload_epi32( (const int*) values, _avx2_partial_mask_32_( count ) ); }
+template<> inline void simd_load_partial<int64,  32>( SIMDType<32>& target, const int64* values, int count )  noexcept { target.simd_by_int = _mm256_maskload_epi64( (const long long*) values, _avx2_partial_mask_64_( count ) ); }
+template<> inline void simd_load_partial<float,  32>( SIMDType<32>& target, const float* values, int count )  noexcept { target.simd_by_float = _mm256_maskload_ps( values, _avx2_partial_mask_32_( count ) ); }
+template<> inline void simd_load_partial<double, 32>( SIMDType<32>& target, const double* values, int count ) noexcept { target.simd_by_double = _mm256_maskload_pd( values, _avx2_partial_mask_64_( count ) ); }
+
+template<> inline void simd_store_partial<int32,  32>( const SIMDType<32>& value, int32* store, int count )  noexcept { _mm256_maskstore_epi32( (int*) store, _avx2_partial_mask_32_( count ), value.simd_by_int ); }
+template<> inline void simd_store_partial<int64,  32>( const SIMDType<32>& value, int64* store, int count )  noexcept { _mm256_maskstore_epi64( (long long*) store, _avx2_partial_mask_64_( count ), value.simd_by_int ); }
+template<> inline void simd_store_partial<float,  32>( const SIMDType<32>& value, float* store, int count )  noexcept { _mm256_maskstore_ps( store, _avx2_partial_mask_32_( count ), value.simd_by_float ); }
+template<> inline void simd_store_partial<double, 32>( const SIMDType<32>& value, double* store, int count ) noexcept { _mm256_maskstore_pd( store, _avx2_partial_mask_64_( count ), value.simd_by_double ); }
+
+// gather
+template<> inline void simd_gather<int32,  32>( SIMDType<32>& target, const int32* base, const SIMDType<32>& indices )  noexcept { target.simd_by_int = _mm256_i32gather_epi32( (const int*) base, indices.simd_by_int, 4 ); }
+template<> inline void simd_gather<int64,  32>( SIMDType<32>& target, const int64* base, const SIMDType<32>& indices )  noexcept { target.simd_by_int = _mm256_i32gather_epi64( (const long long*) base, _mm256_castsi256_si128( indices.simd_by_int ), 8 ); }
+template<> inline void simd_gather<float,  32>( SIMDType<32>& target, const float* base, const SIMDType<32>& indices )  noexcept { target.simd_by_float = _mm256_i32gather_ps( base, indices.simd_by_int, 4 ); }
+template<> inline void simd_gather<double, 32>( SIMDType<32>& target, const double* base, const SIMDType<32>& indices ) noexcept { target.simd_by_double = _mm256_i32gather_pd( base, _mm256_castsi256_si128( indices.simd_by_int ), 8 ); }
+
+// horizontal minimum and maximum
+template<> inline float simd_reduce_min<float, 32>( const SIMDType<32>& value ) noexcept
+{
+    __m128 tmp = _mm_min_ps( _mm256_castps256_ps128( value.simd_by_float ), _mm256_extractf128_ps( value.simd_by_float, 1 ) );
+    tmp = _mm_min_ps( tmp, _mm_movehl_ps( tmp, tmp ) );
+    tmp = _mm_min_ss( tmp, _mm_shuffle_ps( tmp, tmp, 1 ) );
+    return _mm_cvtss_f32( tmp );
+}
+
+template<> inline float simd_reduce_max<float, 32>( const SIMDType<32>& value ) noexcept
+{
+    __m128 tmp = _mm_max_ps( _mm256_castps256_ps128( value.simd_by_float ), _mm256_extractf128_ps( value.simd_by_float, 1 ) );
+    tmp = _mm_max_ps( tmp, _mm_movehl_ps( tmp, tmp ) );
+    tmp = _mm_max_ss( tmp, _mm_shuffle_ps( tmp, tmp, 1 ) );
+    return _mm_cvtss_f32( tmp );
+}
+
+template<> inline int32 simd_reduce_min<int32, 32>( const SIMDType<32>& value ) noexcept
+{
+    __m128i tmp = _mm_min_epi32( _mm256_castsi256_si128( value.simd_by_int ), _mm256_extracti128_si256( value.simd_by_int, 1 ) );
+    tmp = _mm_min_epi32( tmp, _mm_shuffle_epi32( tmp, 0x4e ) );
+    tmp = _mm_min_epi32( tmp, _mm_shuffle_epi32( tmp, 0xb1 ) );
+    return _mm_cvtsi128_si32( tmp );
+}
+
+template<> inline int32 simd_reduce_max<int32, 32>( const SIMDType<32>& value ) noexcept
+{
+    __m128i tmp = _mm_max_epi32( _mm256_castsi256_si128( value.simd_by_int ), _mm256_extracti128_si256( value.simd_by_int, 1 ) );
+    tmp = _mm_max_epi32( tmp, _mm_shuffle_epi32( tmp, 0x4e ) );
+    tmp = _mm_max_epi32( tmp, _mm_shuffle_epi32( tmp, 0xb1 ) );
+    return _mm_cvtsi128_si32( tmp );
+}
+
+} // namespace treecore
+
+#endif // TREECORE_SIMD_FUNC_AVX2_H
@@ -0,0 +1,352 @@
+#ifndef TREECORE_SIMD_FUNC_AVX512_H
+#define TREECORE_SIMD_FUNC_AVX512_H
+
+#include "treecore/simd/avx2.h"
+
+#if !defined(__AVX512F__) || !defined(__AVX512BW__) || !defined(__AVX512DQ__) || !defined(__AVX512VL__)
+#    error "treecore is configured with AVX-512 support, but current compiler flags don't enable AVX-512 F/BW/DQ/VL (use -mavx512f -mavx512bw -mavx512dq -mavx512vl or /arch:AVX512)"
+#endif
+
+namespace treecore
+{
+
+//
+// 64-byte AVX-512 operations
+//
+// Byte shifts work on the whole 512 bits. Shuffle reorders 32-bit elements
+// inside each 128-bit lane.
+//
+template<>
+union SIMDType<64>
+{
+    __m512 simd_by_float;
+    __m512i simd_by_int;
+    __m512d simd_by_double;
+    int8 values_by_i8[64];
+    int16 values_by_i16[32];
+    int32 values_by_i32[16];
+    int64 values_by_i64[8];
+    float values_by_float[16];
+    double values_by_double[8];
+};
+
+static_assert( sizeof(SIMDType<64>) == 64, "SIMDType<64> is 64 byte" );
+
+// get and set one component
+TREECORE_SIMD_GETSET_ONE_64_( 64, int8,   values_by_i8,     0 )
+TREECORE_SIMD_GETSET_ONE_32_( 64, int16,  values_by_i16,    0 )
+TREECORE_SIMD_GETSET_ONE_16_( 64, int32,  values_by_i32,    0 )
+TREECORE_SIMD_GETSET_ONE_8_(  64, int64,  values_by_i64,    0 )
+TREECORE_SIMD_GETSET_ONE_16_( 64, float,  values_by_float,  0 )
+TREECORE_SIMD_GETSET_ONE_8_(  64, double, values_by_double, 0 )
+
+// get all components
+template<> inline void simd_get_all<int8,   64>( const SIMDType<64>& target, int8*   store ) noexcept { _mm512_storeu_si512( store, target.simd_by_int ); }
+template<> inline void simd_get_all<int16,  64>( const SIMDType<64>& target, int16*  store ) noexcept { _mm512_storeu_si512( store, target.simd_by_int ); }
+template<> inline void simd_get_all<int32,  64>( const SIMDType<64>& target, int32*  store ) noexcept { _mm512_storeu_si512( store, target.simd_by_int ); }
+template<> inline void simd_get_all<int64,  64>( const SIMDType<64>& target, int64*  store ) noexcept { _mm512_storeu_si512( store, target.simd_by_int ); }
+template<> inline void simd_get_all<float,  64>( const SIMDType<64>& target, float*  store ) noexcept { _mm512_storeu_ps( store, target.simd_by_float ); }
+template<> inline void simd_get_all<double, 64>( const SIMDType<64>& target, double* store ) noexcept { _mm512_storeu_pd( store, target.simd_by_double ); }
+
+// set all components by specifying all of them
+template<> inline void simd_set_all<int32, 64>( SIMDType<64>& target,
+                                                int32 v0, int32 v1, int32 v2, int32 v3, int32 v4, int32 v5, int32 v6, int32 v7,
+                                                int32 v8, int32 v9, int32 v10, int32 v11, int32 v12, int32 v13, int32 v14, int32 v15 ) noexcept
+{
+    target.simd_by_int = _mm512_set_epi32( v15, v14, v13, v12, v11, v10, v9, v8, v7, v6, v5, v4, v3, v2, v1, v0 );
+}
+
+template<> inline void simd_set_all<float, 64>( SIMDType<64>& target,
+                                                float v0, float v1, float v2, float v3, float v4, float v5, float v6, float v7,
+                                                float v8, float v9, float v10, float v11, float v12, float v13, float v14, float v15 ) noexcept
+{
+    target.simd_by_float = _mm512_set_ps( v15, v14, v13, v12, v11, v10, v9, v8, v7, v6, v5, v4, v3, v2, v1, v0 );
+}
+
+template<> inline void simd_set_all<int64,  64>( SIMDType<64>& target, int64 a, int64 b, int64 c, int64 d, int64 e, int64 f, int64 g, int64 h )         noexcept { target.simd_by_int = _mm512_set_epi64( h, g, f, e, d, c, b, a ); }
+template<> inline void simd_set_all<double, 64>( SIMDType<64>& target, double a, double b, double c, double d, double e, double f, double g, double h ) noexcept { target.simd_by_double = _mm512_set_pd( h, g, f, e, d, c, b, a ); }
+
+template<> inline void simd_set_all<int8,   64>( SIMDType<64>& target, const int8* values )   noexcept { target.simd_by_int = _mm512_loadu_si512( values ); }
+template<> inline void simd_set_all<int16,  64>( SIMDType<64>& target, const int16* values )  noexcept { target.simd_by_int = _mm512_loadu_si512( values ); }
+template<> inline void simd_set_all<int32,  64>( SIMDType<64>& target, const int32* values )  noexcept { target.simd_by_int = _mm512_loadu_si512( values ); }
+template<> inline void simd_set_all<int64,  64>( SIMDType<64>& target, const int64* values )  noexcept { target.simd_by_int = _mm512_loadu_si512( values ); }
+template<> inline void simd_set_all<float,  64>( SIMDType<64>& target, const float* values )  noexcept { target.simd_by_float = _mm512_loadu_ps( values );   }
+template<> inline void simd_set_all<double, 64>( SIMDType<64>& target, const double* values ) noexcept { target.simd_by_double = _mm512_loadu_pd( values );   }
+
+// set all components using one same value
+template<> inline void simd_broadcast<int8,   64>( SIMDType<64>& target, int8 value )   noexcept { target.simd_by_int = _mm512_set1_epi8( value );  }
+template<> inline void simd_broadcast<int16,  64>( SIMDType<64>& target, int16 value )  noexcept { target.simd_by_int = _mm512_set1_epi16( value ); }
+template<> inline void simd_broadcast<int32,  64>( SIMDType<64>& target, int32 value )  noexcept { target.simd_by_int = _mm512_set1_epi32( value ); }
+template<> inline void simd_broadcast<int64,  64>( SIMDType<64>& target, int64 value )  noexcept { target.simd_by_int = _mm512_set1_epi64( value ); }
+template<> inline void simd_broadcast<float,  64>( SIMDType<64>& target, float value )  noexcept { target.simd_by_float = _mm512_set1_ps( value );  }
+template<> inline void simd_broadcast<double, 64>( SIMDType<64>& target, double value ) noexcept { target.simd_by_double = _mm512_set1_pd( value ); }
+
+// arithmetical and logical operations
+template<> inline void simd_add<int8,   64>( SIMDType<64>& target, const SIMDType<64>& a, const SIMDType<64>& b ) noexcept { target.simd_by_int = _mm512_add_epi8( a.simd_by_int,  b.simd_by_int ); }
+template<> inline void simd_add<int16,  64>( SIMDType<64>& target, const SIMDType<64>& a, const SIMDType<64>& b ) noexcept { target.simd_by_int = _mm512_add_epi16( a.simd_by_int, b.simd_by_int ); }
+template<> inline void simd_add<int32,  64>( SIMDType<64>& target, const SIMDType<64>& a, const SIMDType<64>& b ) noexcept { target.simd_by_int = _mm512_add_epi32( a.simd_by_int, b.simd_by_int ); }
+template<> inline void simd_add<int64,  64>( SIMDType<64>& target, const SIMDType<64>& a, const SIMDType<64>& b ) noexcept { target.simd_by_int = _mm512_add_epi64( a.simd_by_int, b.simd_by_int ); }
+template<> inline void simd_add<float,  64>( SIMDType<64>& target, const SIMDType<64>& a, const SIMDType<64>& b ) noexcept { target.simd_by_float = _mm512_add_ps( a.simd_by_float,  b.simd_by_float ); }
+template<> inline void simd_add<double, 64>( SIMDType<64>& target, const SIMDType<64>& a, const SIMDType<64>& b ) noexcept { target.simd_by_double = _mm512_add_pd( a.simd_by_double, b.simd_by_double ); }
+
+template<> inline void simd_sub<int8,   64>( SIMDType<64>& target, const SIMDType<64>& a, const SIMDType<64>& b ) noexcept { target.simd_by_int = _mm512_sub_epi8( a.simd_by_int,  b.simd_by_int ); }
+template<> inline void simd_sub<int16,  64>( SIMDType<64>& target, const SIMDType<64>& a, const SIMDType<64>& b ) noexcept { target.simd_by_int = _mm512_sub_epi16( a.simd_by_int, b.simd_by_int ); }
+template<> inline void simd_sub<int32,  64>( SIMDType<64>& target, const SIMDType<64>& a, const SIMDType<64>& b ) noexcept { target.simd_by_int = _mm512_sub_epi32( a.simd_by_int, b.simd_by_int ); }
+template<> inline void simd_sub<int64,  64>( SIMDType<64>& target, const SIMDType<64>& a, const SIMDType<64>& b ) noexcept { target.simd_by_int = _mm512_sub_epi64( a.simd_by_int, b.simd_by_int ); }
+template<> inline void simd_sub<float,  64>( SIMDType<64>& target, const SIMDType<64>& a, const SIMDType<64>& b ) noexcept { target.simd_by_float = _mm512_sub_ps( a.simd_by_float,  b.simd_by_float ); }
+template<> inline void simd_sub<double, 64>( SIMDType<64>& target, const SIMDType<64>& a, const SIMDType<64>& b ) noexcept { target.simd_by_double = _mm512_sub_pd( a.simd_by_double, b.simd_by_double ); }
+
+template<> inline void simd_mul<int16,  64>( SIMDType<64>& target, const SIMDType<64>& a, const SIMDType<64>& b ) noexcept { target.simd_by_int = _mm512_mullo_epi16( a.simd_by_int, b.simd_by_int ); }
+template<> inline void simd_mul<int32,  64>( SIMDType<64>& target, const SIMDType<64>& a, const SIMDType<64>& b ) noexcept { target.simd_by_int = _mm512_mullo_epi32( a.simd_by_int, b.simd_by_int ); }
+template<> inline void simd_mul<uint32, 64>( SIMDType<64>& target, const SIMDType<64>& a, const SIMDType<64>& b ) noexcept { target.simd_by_int = _mm512_mul_epu32( a.simd_by_int,   b.simd_by_int ); }
+template<> inline void simd_mul<float,  64>( SIMDType<64>& target, const SIMDType<64>& a, const SIMDType<64>& b ) noexcept { target.simd_by_float = _mm512_mul_ps( a.simd_by_float,  b.simd_by_float ); }
+template<> inline void simd_mul<double, 64>( SIMDType<64>& target, const SIMDType<64>& a, const SIMDType<64>& b ) noexcept { target.simd_by_double = _mm512_mul_pd( a.simd_by_double, b.simd_by_double ); }
+
+template<> inline void simd_div<float,  64>( SIMDType<64>& target, const SIMDType<64>& a, const SIMDType<64>& b ) noexcept { target.simd_by_float = _mm512_div_ps( a.simd_by_float,  b.simd_by_float ); }
+template<> inline void simd_div<double, 64>( SIMDType<64>& target, const SIMDType<64>& a, const SIMDType<64>& b ) noexcept { target.simd_by_double = _mm512_div_pd( a.simd_by_double, b.simd_by_double ); }
+
+// Conversion between 4-byte and 8-byte types uses the lower half of the
+// 4-byte side, and the upper half is zeroed, same as the 16-byte version.
+template<> inline void simd_convert<float,  int32,  64>( SIMDType<64>& target, SIMDType<64>& input ) noexcept { target.simd_by_float = _mm512_cvtepi32_ps( input.simd_by_int ); }
+template<> inline void simd_convert<int32,  float,  64>( SIMDType<64>& target, SIMDType<64>& input ) noexcept { target.simd_by_int = _mm512_cvttps_epi32( input.simd_by_float ); }
+template<> inline void simd_convert<float,  double, 64>( SIMDType<64>& target, SIMDType<64>& input ) noexcept { target.simd_by_float = _mm512_insertf32x8( _mm512_setzero_ps(), _mm512_cvtpd_ps( input.simd_by_double ), 0 ); }
+template<> inline void simd_convert<int32,  double, 64>( SIMDType<64>& target, SIMDType<64>& input ) noexcept { target.simd_by_int = _mm512_inserti64x4( _mm512_setzero_si512(), _mm512_cvttpd_epi32( input.simd_by_double ), 0 ); }
+template<> inline void simd_convert<double, float,  64>( SIMDType<64>& target, SIMDType<64>& input ) noexcept { target.simd_by_double = _mm512_cvtps_pd( _mm512_castps512_ps256( input.simd_by_float ) ); }
+template<> inline void simd_convert<double, int32,  64>( SIMDType<64>& target, SIMDType<64>& input ) noexcept { target.simd_by_double = _mm512_cvtepi32_pd( _mm512_castsi512_si256( input.simd_by_int ) ); }
+
+template<> inline void simd_cmpl<float,  64>( SIMDType<64>& target ) noexcept { target.simd_by_int = _mm512_xor_si512( target.simd_by_int, _mm512_set1_epi32( -1 ) ); }
+template<> inline void simd_cmpl<double, 64>( SIMDType<64>& target ) noexcept { target.simd_by_int = _mm512_xor_si512( target.simd_by_int, _mm512_set1_epi32( -1 ) ); }
+template<> inline void simd_cmpl<int,    64>( SIMDType<64>& target ) noexcept { target.simd_by_int = _mm512_xor_si512( target.simd_by_int, _mm512_set1_epi32( -1 ) ); }
+
+template<> inline void simd_and<int32,  64>( SIMDType<64>& target, const SIMDType<64>& a, const SIMDType<64>& b ) noexcept { target.simd_by_int = _mm512_and_si512( a.simd_by_int,    b.simd_by_int );    }
+template<> inline void simd_and<int64,  64>( SIMDType<64>& target, const SIMDType<64>& a, const SIMDType<64>& b ) noexcept { target.simd_by_int = _mm512_and_si512( a.simd_by_int,    b.simd_by_int );    }
+template<> inline void simd_and<float,  64>( SIMDType<64>& target, const SIMDType<64>& a, const SIMDType<64>& b ) noexcept { target.simd_by_float = _mm512_and_ps( a.simd_by_float,  b.simd_by_float );   }
+template<> inline void simd_and<double, 64>( SIMDType<64>& target, const SIMDType<64>& a, const SIMDType<64>& b ) noexcept { target.simd_by_double = _mm512_and_pd( a.simd_by_double, b.simd_by_double ); }
+
+template<> inline void simd_or<int32,  64>( SIMDType<64>& target, const SIMDType<64>& a, const SIMDType<64>& b ) noexcept { target.simd_by_int = _mm512_or_si512( a.simd_by_int,    b.simd_by_int );    }
+template<> inline void simd_or<int64,  64>( SIMDType<64>& target, const SIMDType<64>& a, const SIMDType<64>& b ) noexcept { target.simd_by_int = _mm512_or_si512( a.simd_by_int,    b.simd_by_int );    }
+template<> inline void simd_or<float,  64>( SIMDType<64>& target, const SIMDType<64>& a, const SIMDType<64>& b ) noexcept { target.simd_by_float = _mm512_or_ps( a.simd_by_float,  b.simd_by_float );   }
+template<> inline void simd_or<double, 64>( SIMDType<64>& target, const SIMDType<64>& a, const SIMDType<64>& b ) noexcept { target.simd_by_double = _mm512_or_pd( a.simd_by_double, b.simd_by_double ); }
+
+template<> inline void simd_xor<int32,  64>( SIMDType<64>& target, const SIMDType<64>& a, const SIMDType<64>& b ) noexcept { target.simd_by_int = _mm512_xor_si512( a.simd_by_int,    b.simd_by_int );    }
+template<> inline void simd_xor<int64,  64>( SIMDType<64>& target, const SIMDType<64>& a, const SIMDType<64>& b ) noexcept { target.simd_by_int = _mm512_xor_si512( a.simd_by_int,    b.simd_by_int );    }
+template<> inline void simd_xor<float,  64>( SIMDType<64>& target, const SIMDType<64>& a, const SIMDType<64>& b ) noexcept { target.simd_by_float = _mm512_xor_ps( a.simd_by_float,  b.simd_by_float );   }
+template<> inline void simd_xor<double, 64>( SIMDType<64>& target, const SIMDType<64>& a, const SIMDType<64>& b ) noexcept { target.simd_by_double = _mm512_xor_pd( a.simd_by_double, b.simd_by_double ); }
+
+template<> inline void simd_nand<int32,  64>( SIMDType<64>& target, const SIMDType<64>& a, const SIMDType<64>& b ) noexcept { target.simd_by_int = _mm512_andnot_si512( a.simd_by_int,    b.simd_by_int );    }
+template<> inline void simd_nand<int64,  64>( SIMDType<64>& target, const SIMDType<64>& a, const SIMDType<64>& b ) noexcept { target.simd_by_int = _mm512_andnot_si512( a.simd_by_int,    b.simd_by_int );    }
+template<> inline void simd_nand<float,  64>( SIMDType<64>& target, const SIMDType<64>& a, const SIMDType<64>& b ) noexcept { target.simd_by_float = _mm512_andnot_ps( a.simd_by_float,  b.simd_by_float );   }
+template<> inline void simd_nand<double, 64>( SIMDType<64>& target, const SIMDType<64>& a, const SIMDType<64>& b ) noexcept { target.simd_by_double = _mm512_andnot_pd( a.simd_by_double, b.simd_by_double ); }
+
+template<> inline void simd_shift_left<int16, 64>( SIMDType<64>& result, const SIMDType<64>& input, int shift_value ) noexcept { result.simd_by_int = _mm512_sll_epi16( input.simd_by_int, _mm_cvtsi32_si128( shift_value ) ); }
+template<> inline void simd_shift_left<int32, 64>( SIMDType<64>& result, const SIMDType<64>& input, int shift_value ) noexcept { result.simd_by_int = _mm512_sll_epi32( input.simd_by_int, _mm_cvtsi32_si128( shift_value ) ); }
+template<> inline void simd_shift_left<int64, 64>( SIMDType<64>& result, const SIMDType<64>& input, int shift_value ) noexcept { result.simd_by_int = _mm512_sll_epi64( input.simd_by_int, _mm_cvtsi32_si128( shift_value ) ); }
+
+template<> inline void simd_shift_right_zero<int16, 64>( SIMDType<64>& result, const SIMDType<64>& input, int shift_value ) noexcept { result.simd_by_int = _mm512_srl_epi16( input.simd_by_int, _mm_cvtsi32_si128( shift_value ) ); }
+template<> inline void simd_shift_right_zero<int32, 64>( SIMDType<64>& result, const SIMDType<64>& input, int shift_value ) noexcept { result.simd_by_int = _mm512_srl_epi32( input.simd_by_int, _mm_cvtsi32_si128( shift_value ) ); }
+template<> inline void simd_shift_right_zero<int64, 64>( SIMDType<64>& result, const SIMDType<64>& input, int shift_value ) noexcept { result.simd_by_int = _mm512_srl_epi64( input.simd_by_int, _mm_cvtsi32_si128( shift_value ) ); }
+
+template<> inline void simd_shift_right_sign<int16, 64>( SIMDType<64>& result, const SIMDType<64>& input, int shift_value ) noexcept { result.simd_by_int = _mm512_sra_epi16( input.simd_by_int, _mm_cvtsi32_si128( shift_value ) ); }
+template<> inline void simd_shift_right_sign<int32, 64>( SIMDType<64>& result, const SIMDType<64>& input, int shift_value ) noexcept { result.simd_by_int = _mm512_sra_epi32( input.simd_by_int, _mm_cvtsi32_si128( shift_value ) ); }
+template<> inline void simd_shift_right_sign<int64, 64>( SIMDType<64>& result, const SIMDType<64>& input, int shift_value ) noexcept { result.simd_by_int = _mm512_sra_epi64( input.simd_by_int, _mm_cvtsi32_si128( shift_value ) ); }
+
+// move whole 128-bit lanes, zeros are shifted in
+template<int N_LANE>
+inline __m512i _avx512_shift_lane_left_( __m512i input ) noexcept
+{
+    if (N_LANE <= 0)
+        return input;
+    else if (N_LANE >= 4)
+        return _mm512_setzero_si512();
+    else
+        return _mm512_alignr_epi32( input, _mm512_setzero_si512(), (16 - N_LANE * 4) & 15 );
+}
+
+template<int N_LANE>
+inline __m512i _avx512_shift_lane_right_( __m512i input ) noexcept
+{
+    if (N_LANE >= 4)
+        return _mm512_setzero_si512();
+    else
+        return _mm512_alignr_epi32( _mm512_setzero_si512(), input, (N_LANE * 4) & 15 );
+}
+
+// byte shift instructions work inside 128-bit lanes, so each lane is
+// assembled from two lane-shifted copies of input
+template<int SHIFT_COUNT>
+inline __m512i _avx512_shift_byte_left_( __m512i input ) noexcept
+{
+    const __m512i near_lanes = _avx512_shift_lane_left_<SHIFT_COUNT / 16>( input );
+    const __m512i far_lanes  = _avx512_shift_lane_left_<SHIFT_COUNT / 16 + 1>( input );
+    return _mm512_alignr_epi8( near_lanes, far_lanes, 16 - SHIFT_COUNT % 16 );
+}
+
+template<int SHIFT_COUNT>
+inline __m512i _avx512_shift_byte_right_( __m512i input ) noexcept
+{
+    const __m512i near_lanes = _avx512_shift_lane_right_<SHIFT_COUNT / 16>( input );
+    const __m512i far_lanes  = _avx512_shift_lane_right_<SHIFT_COUNT / 16 + 1>( input );
+    return _mm512_alignr_epi8( far_lanes, near_lanes, SHIFT_COUNT % 16 );
+}
+
+TREECORE_SIMD_SHIFT_BYTE_8_( 64, _avx512, 0 )
+TREECORE_SIMD_SHIFT_BYTE_8_( 64, _avx512, 8 )
+TREECORE_SIMD_SHIFT_BYTE_8_( 64, _avx512, 16 )
+TREECORE_SIMD_SHIFT_BYTE_8_( 64, _avx512, 24 )
+TREECORE_SIMD_SHIFT_BYTE_8_( 64, _avx512, 32 )
+TREECORE_SIMD_SHIFT_BYTE_8_( 64, _avx512, 40 )
+TREECORE_SIMD_SHIFT_BYTE_8_( 64, _avx512, 48 )
+TREECORE_SIMD_SHIFT_BYTE_8_( 64, _avx512, 56 )
+TREECORE_SIMD_SHIFT_BYTE_( 64, _avx512, 64 )
+
+// comparison
+// AVX-512 compares into mask registers, which are expanded back to
+// all-one / all-zero elements
+#define TREECORE_AVX512_CMP_INT_( _func_, _type_, _bits_, _pred_ ) \
+    template<> inline void _func_<_type_, 64>( SIMDType<64>& target, const SIMDType<64>& a, const SIMDType<64>& b ) noexcept \
+    { target.simd_by_int = _mm512_movm_epi ## _bits_( _mm512_cmp_epi ## _bits_ ## _mask( a.simd_by_int, b.simd_by_int, _pred_ ) ); }
+
+#define TREECORE_AVX512_CMP_FLOAT_( _func_, _pred_ ) \
+    template<> inline void _func_<float, 64>( SIMDType<64>& target, const SIMDType<64>& a, const SIMDType<64>& b ) noexcept \
+    { target.simd_by_int = _mm512_movm_epi32( _mm512_cmp_ps_mask( a.simd_by_float, b.simd_by_float, _pred_ ) ); } \
+    template<> inline void _func_<double, 64>( SIMDType<64>& target, const SIMDType<64>& a, const SIMDType<64>& b ) noexcept \
+    { target.simd_by_int = _mm512_movm_epi64( _mm512_cmp_pd_mask( a.simd_by_double, b.simd_by_double, _pred_ ) ); }
+
+#define TREECORE_AVX512_CMP_( _func_, _int_pred_, _float_pred_ ) \
+    TREECORE_AVX512_CMP_INT_( _func_, int8,  8,  _int_pred_ ) \
+    TREECORE_AVX512_CMP_INT_( _func_, int16, 16, _int_pred_ ) \
+    TREECORE_AVX512_CMP_INT_( _func_, int32, 32, _int_pred_ ) \
+    TREECORE_AVX512_CMP_INT_( _func_, int64, 64, _int_pred_ ) \
+    TREECORE_AVX512_CMP_FLOAT_( _func_, _float_pred_ )
+
+TREECORE_AVX512_CMP_( simd_cmp,  _MM_CMPINT_EQ,  _CMP_EQ_OQ )
+TREECORE_AVX512_CMP_( simd_ncmp, _MM_CMPINT_NE,  _CMP_NEQ_UQ )
+TREECORE_AVX512_CMP_( simd_gt,   _MM_CMPINT_NLE, _CMP_GT_OQ )
+TREECORE_AVX512_CMP_( simd_ge,   _MM_CMPINT_NLT, _CMP_GE_OQ )
+TREECORE_AVX512_CMP_( simd_lt,   _MM_CMPINT_LT,  _CMP_LT_OQ )
+TREECORE_AVX512_CMP_( simd_le,   _MM_CMPINT_LE,  _CMP_LE_OQ )
+
+#undef TREECORE_AVX512_CMP_
+#undef TREECORE_AVX512_CMP_FLOAT_
+#undef TREECORE_AVX512_CMP_INT_
+
+// integer equality is bitwise equality
+template<> inline bool simd_equal<int8,  64>( const SIMDType<64>& a, const SIMDType<64>& b ) noexcept { return _mm512_cmpneq_epi64_mask( a.simd_by_int, b.simd_by_int ) == 0; }
+template<> inline bool simd_equal<int16, 64>( const SIMDType<64>& a, const SIMDType<64>& b ) noexcept { return _mm512_cmpneq_epi64_mask( a.simd_by_int, b.simd_by_int ) == 0; }
+template<> inline bool simd_equal<int32, 64>( const SIMDType<64>& a, const SIMDType<64>& b ) noexcept { return _mm512_cmpneq_epi64_mask( a.simd_by_int, b.simd_by_int ) == 0; }
+template<> inline bool simd_equal<int64, 64>( const SIMDType<64>& a, const SIMDType<64>& b ) noexcept { return _mm512_cmpneq_epi64_mask( a.simd_by_int, b.simd_by_int ) == 0; }
+
+template<> inline bool simd_equal<float,  64>( const SIMDType<64>& a, const SIMDType<64>& b ) noexcept { return _mm512_cmp_ps_mask( a.simd_by_float,  b.simd_by_float,  _CMP_EQ_OQ ) == 0xffff; }
+template<> inline bool simd_equal<double, 64>( const SIMDType<64>& a, const SIMDType<64>& b ) noexcept { return _mm512_cmp_pd_mask( a.simd_by_double, b.simd_by_double, _CMP_EQ_OQ ) == 0xff; }
+
+// reorder 32-bit elements inside each 128-bit lane
+template<int IDX1, int IDX2, int IDX3, int IDX4>
+struct _simd_shuffle_impl_<IDX1, IDX2, IDX3, IDX4, 64>
+{
+    static void shuffle( SIMDType<64>& target )
+    {
+#ifdef _MSC_VER
+        const int control = IDX1 + (IDX2 << 2) + (IDX3 << 4) + (IDX4 << 6);
+#else
+        constexpr int control = IDX1 + (IDX2 << 2) + (IDX3 << 4) + (IDX4 << 6);
+#endif
+
+        target.simd_by_int = _mm512_shuffle_epi32( target.simd_by_int, (_MM_PERM_ENUM) control );
+    }
+};
+
+// horizontal sum
+template<> inline float  simd_sum<float,  64>( const SIMDType<64>& value ) noexcept { return _mm512_reduce_add_ps( value.simd_by_float );   }
+template<> inline double simd_sum<double, 64>( const SIMDType<64>& value ) noexcept { return _mm512_reduce_add_pd( value.simd_by_double );  }
+template<> inline int32  simd_sum<int32,  64>( const SIMDType<64>& value ) noexcept { return _mm512_reduce_add_epi32( value.simd_by_int ); }
+
+// minimum and maximum
+template<> inline void simd_min<int8,   64>( SIMDType<64>& target, const SIMDType<64>& a, const SIMDType<64>& b ) noexcept { target.simd_by_int = _mm512_min_epi8( a.simd_by_int,  b.simd_by_int ); }
+template<> inline void simd_min<uint8,  64>( SIMDType<64>& target, const SIMDType<64>& a, const SIMDType<64>& b ) noexcept { target.simd_by_int = _mm512_min_epu8( a.simd_by_int,  b.simd_by_int ); }
+template<> inline void simd_min<int16,  64>( SIMDType<64>& target, const SIMDType<64>& a, const SIMDType<64>& b ) noexcept { target.simd_by_int = _mm512_min_epi16( a.simd_by_int, b.simd_by_int ); }
+template<> inline void simd_min<int32,  64>( SIMDType<64>& target, const SIMDType<64>& a, const SIMDType<64>& b ) noexcept { target.simd_by_int = _mm512_min_epi32( a.simd_by_int, b.simd_by_int ); }
+template<> inline void simd_min<int64,  64>( SIMDType<64>& target, const SIMDType<64>& a, const SIMDType<64>& b ) noexcept { target.simd_by_int = _mm512_min_epi64( a.simd_by_int, b.simd_by_int ); }
+template<> inline void simd_min<float,  64>( SIMDType<64>& target, const SIMDType<64>& a, const SIMDType<64>& b ) noexcept { target.simd_by_float = _mm512_min_ps( a.simd_by_float,  b.simd_by_float ); }
+template<> inline void simd_min<double, 64>( SIMDType<64>& target, const SIMDType<64>& a, const SIMDType<64>& b ) noexcept { target.simd_by_double = _mm512_min_pd( a.simd_by_double, b.simd_by_double ); }
+
+template<> inline void simd_max<int8,   64>( SIMDType<64>& target, const SIMDType<64>& a, const SIMDType<64>& b ) noexcept { target.simd_by_int = _mm512_max_epi8( a.simd_by_int,  b.simd_by_int ); }
+template<> inline void simd_max<uint8,  64>( SIMDType<64>& target, const SIMDType<64>& a, const SIMDType<64>& b ) noexcept { target.simd_by_int = _mm512_max_epu8( a.simd_by_int,  b.simd_by_int ); }
+template<> inline void simd_max<int16,  64>( SIMDType<64>& target, const SIMDType<64>& a, const SIMDType<64>& b ) noexcept { target.simd_by_int = _mm512_max_epi16( a.simd_by_int, b.simd_by_int ); }
+template<> inline void simd_max<int32,  64>( SIMDType<64>& target, const SIMDType<64>& a, const SIMDType<64>& b ) noexcept { target.simd_by_int = _mm512_max_epi32( a.simd_by_int, b.simd_by_int ); }
+template<> inline void simd_max<int64,  64>( SIMDType<64>& target, const SIMDType<64>& a, const SIMDType<64>& b ) noexcept { target.simd_by_int = _mm512_max_epi64( a.simd_by_int, b.simd_by_int ); }
+template<> inline void simd_max<float,  64>( SIMDType<64>& target, const SIMDType<64>& a, const SIMDType<64>& b ) noexcept { target.simd_by_float = _mm512_max_ps( a.simd_by_float,  b.simd_by_float ); }
+template<> inline void simd_max<double, 64>( SIMDType<64>& target, const SIMDType<64>& a, const SIMDType<64>& b ) noexcept { target.simd_by_double = _mm512_max_pd( a.simd_by_double, b.simd_by_double ); }
+
+// absolute value
+template<> inline void simd_abs<int8,   64>( SIMDType<64>& target, const SIMDType<64>& input ) noexcept { target.simd_by_int = _mm512_abs_epi8( input.simd_by_int ); }
+template<> inline void simd_abs<int16,  64>( SIMDType<64>& target, const SIMDType<64>& input ) noexcept { target.simd_by_int = _mm512_abs_epi16( input.simd_by_int ); }
+template<> inline void simd_abs<int32,  64>( SIMDType<64>& target, const SIMDType<64>& input ) noexcept { target.simd_by_int = _mm512_abs_epi32( input.simd_by_int ); }
+template<> inline void simd_abs<int64,  64>( SIMDType<64>& target, const SIMDType<64>& input ) noexcept { target.simd_by_int = _mm512_abs_epi64( input.simd_by_int ); }
+template<> inline void simd_abs<float,  64>( SIMDType<64>& target, const SIMDType<64>& input ) noexcept { target.simd_by_float = _mm512_abs_ps( input.simd_by_float ); }
+template<> inline void simd_abs<double, 64>( SIMDType<64>& target, const SIMDType<64>& input ) noexcept { target.simd_by_double = _mm512_abs_pd( input.simd_by_double ); }
+
+// square root; rsqrt14 has relative error below 2^-14
+template<> inline void simd_sqrt<float,  64>( SIMDType<64>& target, const SIMDType<64>& input ) noexcept { target.simd_by_float = _mm512_sqrt_ps( input.simd_by_float ); }
+template<> inline void simd_sqrt<double, 64>( SIMDType<64>& target, const SIMDType<64>& input ) noexcept { target.simd_by_double = _mm512_sqrt_pd( input.simd_by_double ); }
+
+template<> inline void simd_rsqrt<float,  64>( SIMDType<64>& target, const SIMDType<64>& input ) noexcept { target.simd_by_float = _mm512_rsqrt14_ps( input.simd_by_float ); }
+template<> inline void simd_rsqrt<double, 64>( SIMDType<64>& target, const SIMDType<64>& input ) noexcept { target.simd_by_double = _mm512_div_pd( _mm512_set1_pd( 1.0 ), _mm512_sqrt_pd( input.simd_by_double ) ); }
+
+// multiply-add, AVX-512 always has FMA
+template<> inline void simd_mul_add<float,  64>( SIMDType<64>& target, const SIMDType<64>& a, const SIMDType<64>& b, const SIMDType<64>& c ) noexcept { target.simd_by_float = _mm512_fmadd_ps( a.simd_by_float, b.simd_by_float, c.simd_by_float ); }
+template<> inline void simd_mul_add<double, 64>( SIMDType<64>& target, const SIMDType<64>& a, const SIMDType<64>& b, const SIMDType<64>& c ) noexcept { target.simd_by_double = _mm512_fmadd_pd( a.simd_by_double, b.simd_by_double, c.simd_by_double ); }
+
+// select by mask: highest bit of each element is moved into a mask register
+template<> inline void simd_select<int8,   64>( SIMDType<64>& target, const SIMDType<64>& mask, const SIMDType<64>& a, const SIMDType<64>& b ) noexcept { target.simd_by_int = _mm512_mask_blend_epi8( _mm512_movepi8_mask( mask.simd_by_int ), b.simd_by_int, a.simd_by_int ); }
+template<> inline void simd_select<int16,  64>( SIMDType<64>& target, const SIMDType<64>& mask, const SIMDType<64>& a, const SIMDType<64>& b ) noexcept { target.simd_by_int = _mm512_mask_blend_epi16( _mm512_movepi16_mask( mask.simd_by_int ), b.simd_by_int, a.simd_by_int ); }
+template<> inline void simd_select<int32,  64>( SIMDType<64>& target, const SIMDType<64>& mask, const SIMDType<64>& a, const SIMDType<64>& b ) noexcept { target.simd_by_int = _mm512_mask_blend_epi32( _mm512_movepi32_mask( mask.simd_by_int ), b.simd_by_int, a.simd_by_int ); }
+template<> inline void simd_select<int64,  64>( SIMDType<64>& target, const SIMDType<64>& mask, const SIMDType<64>& a, const SIMDType<64>& b ) noexcept { target.simd_by_int = _mm512_mask_blend_epi64( _mm512_movepi64_mask( mask.simd_by_int ), b.simd_by_int, a.simd_by_int ); }
+template<> inline void simd_select<float,  64>( SIMDType<64>& target, const SIMDType<64>& mask, const SIMDType<64>& a, const SIMDType<64>& b ) noexcept { target.simd_by_float = _mm512_mask_blend_ps( _mm512_movepi32_mask( mask.simd_by_int ), b.simd_by_float, a.simd_by_float ); }
+template<> inline void simd_select<double, 64>( SIMDType<64>& target, const SIMDType<64>& mask, const SIMDType<64>& a, const SIMDType<64>& b ) noexcept { target.simd_by_double = _mm512_mask_blend_pd( _mm512_movepi64_mask( mask.simd_by_int ), b.simd_by_double, a.simd_by_double ); }
+
+// highest bit of each element
+template<> inline uint64 simd_movemask<int8,   64>( const SIMDType<64>& value ) noexcept { return uint64( _mm512_movepi8_mask( value.simd_by_int ) ); }
+template<> inline uint64 simd_movemask<int16,  64>( const SIMDType<64>& value ) noexcept { return uint64( _mm512_movepi16_mask( value.simd_by_int ) ); }
+template<> inline uint64 simd_movemask<int32,  64>( const SIMDType<64>& value ) noexcept { return uint64( _mm512_movepi32_mask( value.simd_by_int ) ); }
+template<> inline uint64 simd_movemask<int64,  64>( const SIMDType<64>& value ) noexcept { return uint64( _mm512_movepi64_mask( value.simd_by_int ) ); }
+template<> inline uint64 simd_movemask<float,  64>( const SIMDType<64>& value ) noexcept { return uint64( _mm512_movepi32_mask( value.simd_by_int ) ); }
+template<> inline uint64 simd_movemask<double, 64>( const SIMDType<64>& value ) noexcept { return uint64( _mm512_movepi64_mask( value.simd_by_int ) ); }
+
+// partial load and store by masked move, which never faults on masked-out
+// elements
+inline uint64 _avx512_partial_mask_( int count, int num_elements ) noexcept
+{
+    return count >= num_elements ? (~uint64( 0 ) >> (64 - num_elements)) : ((uint64( 1 ) << count) - 1);
+}
+
+template<> inline void simd_load_partial<int8,   64>( SIMDType<64>& target, const int8* values, int count )   noexcept { target.simd_by_int = _mm512_maskz_loadu_epi8( __mmask64( _avx512_partial_mask_( count, 64 ) ), values ); }
+template<> inline void simd_load_partial<int16,  64>( SIMDType<64>& target, const int16* values, int count )  noexcept { target.simd_by_int = _mm512_maskz_loadu_epi16( __mmask32( _avx512_partial_mask_( count, 32 ) ), values ); }
+template<> inline void simd_load_partial<int32,  64>( SIMDType<64>& target, const int32* values, int count )  noexcept { target.simd_by_int = _mm512_maskz_loadu_epi32( __mmask16( _avx512_partial_mask_( count, 16 ) ), values ); }
+template<> inline void simd_load_partial<int64,  64>( SIMDType<64>& target, const int64* values, int count )  noexcept { target.simd_by_int = _mm512_maskz_loadu_epi64( __mmask8( _avx512_partial_mask_( count, 8 ) ), values ); }
+template<> inline void simd_load_partial<float,  64>( SIMDType<64>& target, const float* values, int count )  noexcept { target.simd_by_float = _mm512_maskz_loadu_ps( __mmask16( _avx512_partial_mask_( count, 16 ) ), values ); }
+template<> inline void simd_load_partial<double, 64>( SIMDType<64>& target, const double* values, int count ) noexcept { target.simd_by_double = _mm512_maskz_loadu_pd( __mmask8( _avx512_partial_mask_( count, 8 ) ), values ); }
+
+template<> inline void simd_store_partial<int8,   64>( const SIMDType<64>& value, int8* store, int count )   noexcept { _mm512_mask_storeu_epi8( store, __mmask64( _avx512_partial_mask_( count, 64 ) ), value.simd_by_int ); }
+template<> inline void simd_store_partial<int16,  64>( const SIMDType<64>& value, int16* store, int count )  noexcept { _mm512_mask_storeu_epi16( store, __mmask32( _avx512_partial_mask_( count, 32 ) ), value.simd_by_int ); }
+template<> inline void simd_store_partial<int32,  64>( const SIMDType<64>& value, int32* store, int count )  noexcept { _mm512_mask_storeu_epi32( store, __mmask16( _avx512_partial_mask_( count, 16 ) ), value.simd_by_int ); }
+template<> inline void simd_store_partial<int64,  64>( const SIMDType<64>& value, int64* store, int count )  noexcept { _mm512_mask_storeu_epi64( store, __mmask8( _avx512_partial_mask_( count, 8 ) ), value.simd_by_int ); }
+template<> inline void simd_store_partial<float,  64>( const SIMDType<64>& value, float* store, int count )  noexcept { _mm512_mask_storeu_ps( store, __mmask16( _avx512_partial_mask_( count, 16 ) ), value.simd_by_float ); }
+template<> inline void simd_store_partial<double, 64>( const SIMDType<64>& value, double* store, int count ) noexcept { _mm512_mask_storeu_pd( store, __mmask8( _avx512_partial_mask_( count, 8 ) ), value.simd_by_double ); }
+
+// gather
+template<> inline void simd_gather<int32,  64>( SIMDType<64>& target, const int32* base, const SIMDType<64>& indices )  noexcept { target.simd_by_int = _mm512_i32gather_epi32( indices.simd_by_int, base, 4 ); }
+template<> inline void simd_gather<int64,  64>( SIMDType<64>& target, const int64* base, const SIMDType<64>& indices )  noexcept { target.simd_by_int = _mm512_i32gather_epi64( _mm512_castsi512_si256( indices.simd_by_int ), base, 8 ); }
+template<> inline void simd_gather<float,  64>( SIMDType<64>& target, const float* base, const SIMDType<64>& indices )  noexcept { target.simd_by_float = _mm512_i32gather_ps( indices.simd_by_int, base, 4 ); }
+template<> inline void simd_gather<double, 64>( SIMDType<64>& target, const double* base, const SIMDType<64>& indices ) noexcept { target.simd_by_double = _mm512_i32gather_pd( _mm512_castsi512_si256( indices.simd_by_int ), base, 8 ); }
+
+// horizontal minimum and maximum
+template<> inline float  simd_reduce_min<float,  64>( const SIMDType<64>& value ) noexcept { return _mm512_reduce_min_ps( value.simd_by_float );   }
+template<> inline double simd_reduce_min<double, 64>( const SIMDType<64>& value ) noexcept { return _mm512_reduce_min_pd( value.simd_by_double );  }
+template<> inline int32  simd_reduce_min<int32,  64>( const SIMDType<64>& value ) noexcept { return _mm512_reduce_min_epi32( value.simd_by_int ); }
+template<> inline float  simd_reduce_max<float,  64>( const SIMDType<64>& value ) noexcept { return _mm512_reduce_max_ps( value.simd_by_float );   }
+template<> inline double simd_reduce_max<double, 64>( const SIMDType<64>& value ) noexcept { return _mm512_reduce_max_pd( value.simd_by_double );  }
+template<> inline int32  simd_reduce_max<int32,  64>( const SIMDType<64>& value ) noexcept { return _mm512_reduce_max_epi32( value.simd_by_int ); }
+
+} // namespace treecore
+
+#endif // TREECORE_SIMD_FUNC_AVX512_H
@@ -488,6 +488,163 @@ inline float simd_sum<float, 16>( const SIMDType<16>& value ) noexcept
     return tmp.values_by_float[0];
 }
 
+// Instructions newer than SSE3 are used when compiler flags enable them,
+// otherwise they are emulated with SSE2.
+#if defined(__SSSE3__) || defined(__AVX__)
+#    define TREECORE_SIMD_HAS_SSSE3_ 1
+#else
+#    define TREECORE_SIMD_HAS_SSSE3_ 0
+#endif
+
+#if defined(__SSE4_1__) || defined(__AVX__)
+#    define TREECORE_SIMD_HAS_SSE41_ 1
+#else
+#    define TREECORE_SIMD_HAS_SSE41_ 0
+#endif
+
+#if defined(__FMA__) || defined(__AVX2__)
+#    define TREECORE_SIMD_HAS_FMA_ 1
+#else
+#    define TREECORE_SIMD_HAS_FMA_ 0
+#endif
+
+inline __m128i _sse_select_( __m128i mask, __m128i a, __m128i b ) noexcept
+{
+#if TREECORE_SIMD_HAS_SSE41_
+    return _mm_blendv_epi8( b, a, mask );
+#else
+    return _mm_or_si128( _mm_and_si128( mask, a ), _mm_andnot_si128( mask, b ) );
+#endif
+}
+
+// minimum and maximum
+template<> inline void simd_min<uint8,  16>( SIMDType<16>& target, const SIMDType<16>& a, const SIMDType<16>& b ) noexcept { target.simd_by_int = _mm_min_epu8( a.simd_by_int, b.simd_by_int ); }
+template<> inline void simd_min<int16,  16>( SIMDType<16>& target, const SIMDType<16>& a, const SIMDType<16>& b ) noexcept { target.simd_by_int = _mm_min_epi16( a.simd_by_int, b.simd_by_int ); }
+template<> inline void simd_min<float,  16>( SIMDType<16>& target, const SIMDType<16>& a, const SIMDType<16>& b ) noexcept { target.simd_by_float = _mm_min_ps( a.simd_by_float, b.simd_by_float ); }
+template<> inline void simd_min<double, 16>( SIMDType<16>& target, const SIMDType<16>& a, const SIMDType<16>& b ) noexcept { target.simd_by_double = _mm_min_pd( a.simd_by_double, b.simd_by_double ); }
+
+template<> inline void simd_max<uint8,  16>( SIMDType<16>& target, const SIMDType<16>& a, const SIMDType<16>& b ) noexcept { target.simd_by_int = _mm_max_epu8( a.simd_by_int, b.simd_by_int ); }
+template<> inline void simd_max<int16,  16>( SIMDType<16>& target, const SIMDType<16>& a, const SIMDType<16>& b ) noexcept { target.simd_by_int = _mm_max_epi16( a.simd_by_int, b.simd_by_int ); }
+template<> inline void simd_max<float,  16>( SIMDType<16>& target, const SIMDType<16>& a, const SIMDType<16>& b ) noexcept { target.simd_by_float = _mm_max_ps( a.simd_by_float, b.simd_by_float ); }
+template<> inline void simd_max<double, 16>( SIMDType<16>& target, const SIMDType<16>& a, const SIMDType<16>& b ) noexcept { target.simd_by_double = _mm_max_pd( a.simd_by_double, b.simd_by_double ); }
+
+#if TREECORE_SIMD_HAS_SSE41_
+template<> inline void simd_min<int8,  16>( SIMDType<16>& target, const SIMDType<16>& a, const SIMDType<16>& b ) noexcept { target.simd_by_int = _mm_min_epi8( a.simd_by_int, b.simd_by_int ); }
+template<> inline void simd_min<int32, 16>( SIMDType<16>& target, const SIMDType<16>& a, const SIMDType<16>& b ) noexcept { target.simd_by_int = _mm_min_epi32( a.simd_by_int, b.simd_by_int ); }
+template<> inline void simd_max<int8,  16>( SIMDType<16>& target, const SIMDType<16>& a, const SIMDType<16>& b ) noexcept { target.simd_by_int = _mm_max_epi8( a.simd_by_int, b.simd_by_int ); }
+template<> inline void simd_max<int32, 16>( SIMDType<16>& target, const SIMDType<16>& a, const SIMDType<16>& b ) noexcept { target.simd_by_int = _mm_max_epi32( a.simd_by_int, b.simd_by_int ); }
+#else
+template<> inline void simd_min<int8,  16>( SIMDType<16>& target, const SIMDType<16>& a, const SIMDType<16>& b ) noexcept { target.simd_by_int = _sse_select_( _mm_cmplt_epi8( a.simd_by_int, b.simd_by_int ), a.simd_by_int, b.simd_by_int ); }
+template<> inline void simd_min<int32, 16>( SIMDType<16>& target, const SIMDType<16>& a, const SIMDType<16>& b ) noexcept { target.simd_by_int = _sse_select_( _mm_cmplt_epi32( a.simd_by_int, b.simd_by_int ), a.simd_by_int, b.simd_by_int ); }
+template<> inline void simd_max<int8,  16>( SIMDType<16>& target, const SIMDType<16>& a, const SIMDType<16>& b ) noexcept { target.simd_by_int = _sse_select_( _mm_cmpgt_epi8( a.simd_by_int, b.simd_by_int ), a.simd_by_int, b.simd_by_int ); }
+template<> inline void simd_max<int32, 16>( SIMDType<16>& target, const SIMDType<16>& a, const SIMDType<16>& b ) noexcept { target.simd_by_int = _sse_select_( _mm_cmpgt_epi32( a.simd_by_int, b.simd_by_int ), a.simd_by_int, b.simd_by_int ); }
+#endif
+
+// absolute value
+template<> inline void simd_abs<float,  16>( SIMDType<16>& target, const SIMDType<16>& input ) noexcept { target.simd_by_float = _mm_and_ps( input.simd_by_float, _mm_castsi128_ps( _mm_set1_epi32( 0x7fffffff ) ) ); }
+template<> inline void simd_abs<double, 16>( SIMDType<16>& target, const SIMDType<16>& input ) noexcept { target.simd_by_double = _mm_and_pd( input.simd_by_double, _mm_castsi128_pd( _mm_set1_epi64x( 0x7fffffffffffffffLL ) ) ); }
+
+#if TREECORE_SIMD_HAS_SSSE3_
+template<> inline void simd_abs<int8,  16>( SIMDType<16>& target, const SIMDType<16>& input ) noexcept { target.simd_by_int = _mm_abs_epi8( input.simd_by_int ); }
+template<> inline void simd_abs<int16, 16>( SIMDType<16>& target, const SIMDType<16>& input ) noexcept { target.simd_by_int = _mm_abs_epi16( input.simd_by_int ); }
+template<> inline void simd_abs<int32, 16>( SIMDType<16>& target, const SIMDType<16>& input ) noexcept { target.simd_by_int = _mm_abs_epi32( input.simd_by_int ); }
+#else
+// (x ^ s) - s, where s is all ones for negative x
+template<> inline void simd_abs<int8,  16>( SIMDType<16>& target, const SIMDType<16>& input ) noexcept
+{
+    const __m128i sign = _mm_cmplt_epi8( input.simd_by_int, _mm_setzero_si128() );
+    target.simd_by_int = _mm_sub_epi8( _mm_xor_si128( input.simd_by_int, sign ), sign );
+}
+
+template<> inline void simd_abs<int16, 16>( SIMDType<16>& target, const SIMDType<16>& input ) noexcept
+{
+    const __m128i sign = _mm_srai_epi16( input.simd_by_int, 15 );
+    target.simd_by_int = _mm_sub_epi16( _mm_xor_si128( input.simd_by_int, sign ), sign );
+}
+
+template<> inline void simd_abs<int32, 16>( SIMDType<16>& target, const SIMDType<16>& input ) noexcept
+{
+    const __m128i sign = _mm_srai_epi32( input.simd_by_int, 31 );
+    target.simd_by_int = _mm_sub_epi32( _mm_xor_si128( input.simd_by_int, sign ), sign );
+}
+#endif
+
+// square root
+template<> inline void simd_sqrt<float,  16>( SIMDType<16>& target, const SIMDType<16>& input ) noexcept { target.simd_by_float = _mm_sqrt_ps( input.simd_by_float ); }
+template<> inline void simd_sqrt<double, 16>( SIMDType<16>& target, const SIMDType<16>& input ) noexcept { target.simd_by_double = _mm_sqrt_pd( input.simd_by_double ); }
+
+template<> inline void simd_rsqrt<float,  16>( SIMDType<16>& target, const SIMDType<16>& input ) noexcept { target.simd_by_float = _mm_rsqrt_ps( input.simd_by_float ); }
+template<> inline void simd_rsqrt<double, 16>( SIMDType<16>& target, const SIMDType<16>& input ) noexcept { target.simd_by_double = _mm_div_pd( _mm_set1_pd( 1.0 ), _mm_sqrt_pd( input.simd_by_double ) ); }
+
+// multiply-add
+#if TREECORE_SIMD_HAS_FMA_
+template<> inline void simd_mul_add<float,  16>( SIMDType<16>& target, const SIMDType<16>& a, const SIMDType<16>& b, const SIMDType<16>& c ) noexcept { target.simd_by_float = _mm_fmadd_ps( a.simd_by_float, b.simd_by_float, c.simd_by_float ); }
+template<> inline void simd_mul_add<double, 16>( SIMDType<16>& target, const SIMDType<16>& a, const SIMDType<16>& b, const SIMDType<16>& c ) noexcept { target.simd_by_double = _mm_fmadd_pd( a.simd_by_double, b.simd_by_double, c.simd_by_double ); }
+#else
+template<> inline void simd_mul_add<float,  16>( SIMDType<16>& target, const SIMDType<16>& a, const SIMDType<16>& b, const SIMDType<16>& c ) noexcept { target.simd_by_float = _mm_add_ps( _mm_mul_ps( a.simd_by_float, b.simd_by_float ), c.simd_by_float ); }
+template<> inline void simd_mul_add<double, 16>( SIMDType<16>& target, const SIMDType<16>& a, const SIMDType<16>& b, const SIMDType<16>& c ) noexcept { target.simd_by_double = _mm_add_pd( _mm_mul_pd( a.simd_by_double, b.simd_by_double ), c.simd_by_double ); }
+#endif
+
+// select by mask, all element types are handled bitwise
+#define TREECORE_SIMD_SELECT_16_( _type_ ) \
+    template<> inline void simd_select<_type_, 16>( SIMDType<16>& target, const SIMDType<16>& mask, const SIMDType<16>& a, const SIMDType<16>& b ) noexcept { target.simd_by_int = _sse_select_( mask.simd_by_int, a.simd_by_int, b.simd_by_int ); }
+
+TREECORE_SIMD_SELECT_16_( int8 )
+TREECORE_SIMD_SELECT_16_( int16 )
+TREECORE_SIMD_SELECT_16_( int32 )
+TREECORE_SIMD_SELECT_16_( int64 )
+TREECORE_SIMD_SELECT_16_( float )
+TREECORE_SIMD_SELECT_16_( double )
+
+// highest bit of each element
+template<> inline uint64 simd_movemask<int8,   16>( const SIMDType<16>& value ) noexcept { return uint64( _mm_movemask_epi8( value.simd_by_int ) ); }
+template<> inline uint64 simd_movemask<int16,  16>( const SIMDType<16>& value ) noexcept { return uint64( _mm_movemask_epi8( _mm_packs_epi16( value.simd_by_int, _mm_setzero_si128() ) ) ); }
+template<> inline uint64 simd_movemask<int32,  16>( const SIMDType<16>& value ) noexcept { return uint64( _mm_movemask_ps( _mm_castsi128_ps( value.simd_by_int ) ) ); }
+template<> inline uint64 simd_movemask<int64,  16>( const SIMDType<16>& value ) noexcept { return uint64( _mm_movemask_pd( _mm_castsi128_pd( value.simd_by_int ) ) ); }
+template<> inline uint64 simd_movemask<float,  16>( const SIMDType<16>& value ) noexcept { return uint64( _mm_movemask_ps( value.simd_by_float ) ); }
+template<> inline uint64 simd_movemask<double, 16>( const SIMDType<16>& value ) noexcept { return uint64( _mm_movemask_pd( value.simd_by_double ) ); }
+
+// gather
+#if defined(__AVX2__)
+template<> inline void simd_gather<int32, 16>( SIMDType<16>& target, const int32* base, const SIMDType<16>& indices ) noexcept { target.simd_by_int = _mm_i32gather_epi32( base, indices.simd_by_int, 4 ); }
+template<> inline void simd_gather<float, 16>( SIMDType<16>& target, const float* base, const SIMDType<16>& indices ) noexcept { target.simd_by_float = _mm_i32gather_ps( base, indices.simd_by_int, 4 ); }
+#endif
+
+// horizontal minimum and maximum
+template<> inline float simd_reduce_min<float, 16>( const SIMDType<16>& value ) noexcept
+{
+    __m128 tmp = _mm_min_ps( value.simd_by_float, _mm_movehl_ps( value.simd_by_float, value.simd_by_float ) );
+    tmp = _mm_min_ss( tmp, _mm_shuffle_ps( tmp, tmp, 1 ) );
+    return _mm_cvtss_f32( tmp );
+}
+
+template<> inline float simd_reduce_max<float, 16>( const SIMDType<16>& value ) noexcept
+{
+    __m128 tmp = _mm_max_ps( value.simd_by_float, _mm_movehl_ps( value.simd_by_float, value.simd_by_float ) );
+    tmp = _mm_max_ss( tmp, _mm_shuffle_ps( tmp, tmp, 1 ) );
+    return _mm_cvtss_f32( tmp );
+}
+
+template<> inline int32 simd_reduce_min<int32, 16>( const SIMDType<16>& value ) noexcept
+{
+    SIMDType<16> tmp, swapped;
+    swapped.simd_by_int = _mm_shuffle_epi32( value.simd_by_int, 0x4e );
+    simd_min<int32>( tmp, value, swapped );
+    swapped.simd_by_int = _mm_shuffle_epi32( tmp.simd_by_int, 0xb1 );
+    simd_min<int32>( tmp, tmp, swapped );
+    return _mm_cvtsi128_si32( tmp.simd_by_int );
+}
+
+template<> inline int32 simd_reduce_max<int32, 16>( const SIMDType<16>& value ) noexcept
+{
+    SIMDType<16> tmp, swapped;
+    swapped.simd_by_int = _mm_shuffle_epi32( value.simd_by_int, 0x4e );
+    simd_max<int32>( tmp, value, swapped );
+    swapped.simd_by_int = _mm_shuffle_epi32( tmp.simd_by_int, 0xb1 );
+    simd_max<int32>( tmp, tmp, swapped );
+    return _mm_cvtsi128_si32( tmp.simd_by_int );
+}
+
 //
 // 64 bit SIMD operations
 //
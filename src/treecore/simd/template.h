@@ -2,8 +2,12 @@
 #define TREECORE_SIMD_FUNC_TEMP_H
 
 #include "treecore/Common.h"
+#include "treecore/IntTypes.h"
 #include "treecore/PlatformDefs.h"
 
+#include <cmath>
+#include <cstring>
+
 namespace treecore
 {
 
@@ -60,6 +64,147 @@ template<int IDX1, int IDX2, int IDX3, int IDX4, int SZ> inline void simd_shuffl
 template<typename T, int SZ>
 T simd_sum( const SIMDType<SZ>& value ) noexcept;
 
+//
+// Operations below have a scalar implementation that works on any SIMDType,
+// so that a backend only needs to specialize the ones it has instructions
+// for. Element access goes through the union's byte representation, so T can
+// be any arithmetic type that divides SZ.
+//
+
+template<typename T, int SZ> inline T*       _simd_elems_( SIMDType<SZ>& value ) noexcept       { return reinterpret_cast<T*>( &value ); }
+template<typename T, int SZ> inline const T* _simd_elems_( const SIMDType<SZ>& value ) noexcept { return reinterpret_cast<const T*>( &value ); }
+
+template<typename T> inline T _simd_abs_one_( T value ) noexcept  { return value < T( 0 ) ? T( -value ) : value; }
+template<> inline float  _simd_abs_one_<float>( float value ) noexcept   { return std::fabs( value ); }
+template<> inline double _simd_abs_one_<double>( double value ) noexcept { return std::fabs( value ); }
+
+// element-wise minimum and maximum, same as "a < b ? a : b" and "a > b ? a : b"
+template<typename T, int SZ>
+inline void simd_min( SIMDType<SZ>& target, const SIMDType<SZ>& a, const SIMDType<SZ>& b ) noexcept
+{
+    for (int i = 0; i < int( SZ / sizeof(T) ); i++)
+    {
+        const T va = _simd_elems_<T>( a )[i];
+        const T vb = _simd_elems_<T>( b )[i];
+        _simd_elems_<T>( target )[i] = va < vb ? va : vb;
+    }
+}
+
+template<typename T, int SZ>
+inline void simd_max( SIMDType<SZ>& target, const SIMDType<SZ>& a, const SIMDType<SZ>& b ) noexcept
+{
+    for (int i = 0; i < int( SZ / sizeof(T) ); i++)
+    {
+        const T va = _simd_elems_<T>( a )[i];
+        const T vb = _simd_elems_<T>( b )[i];
+        _simd_elems_<T>( target )[i] = va > vb ? va : vb;
+    }
+}
+
+// absolute value; for floating point the sign bit is cleared
+template<typename T, int SZ>
+inline void simd_abs( SIMDType<SZ>& target, const SIMDType<SZ>& input ) noexcept
+{
+    for (int i = 0; i < int( SZ / sizeof(T) ); i++)
+        _simd_elems_<T>( target )[i] = _simd_abs_one_<T>( _simd_elems_<T>( input )[i] );
+}
+
+template<typename T, int SZ>
+inline void simd_sqrt( SIMDType<SZ>& target, const SIMDType<SZ>& input ) noexcept
+{
+    for (int i = 0; i < int( SZ / sizeof(T) ); i++)
+        _simd_elems_<T>( target )[i] = T( std::sqrt( _simd_elems_<T>( input )[i] ) );
+}
+
+// 1 / sqrt(x); float versions may use an approximation with relative error
+// up to 2^-11
+template<typename T, int SZ>
+inline void simd_rsqrt( SIMDType<SZ>& target, const SIMDType<SZ>& input ) noexcept
+{
+    for (int i = 0; i < int( SZ / sizeof(T) ); i++)
+        _simd_elems_<T>( target )[i] = T( 1 ) / T( std::sqrt( _simd_elems_<T>( input )[i] ) );
+}
+
+// a * b + c, with a single rounding when the target has FMA instructions
+template<typename T, int SZ>
+inline void simd_mul_add( SIMDType<SZ>& target, const SIMDType<SZ>& a, const SIMDType<SZ>& b, const SIMDType<SZ>& c ) noexcept
+{
+    for (int i = 0; i < int( SZ / sizeof(T) ); i++)
+        _simd_elems_<T>( target )[i] = _simd_elems_<T>( a )[i] * _simd_elems_<T>( b )[i] + _simd_elems_<T>( c )[i];
+}
+
+// Take element from a where mask element is all ones, and from b where it
+// is all zero. Mask is usually the result of a comparison; elements with
+// mixed bits give unspecified result.
+template<typename T, int SZ>
+inline void simd_select( SIMDType<SZ>& target, const SIMDType<SZ>& mask, const SIMDType<SZ>& a, const SIMDType<SZ>& b ) noexcept
+{
+    const uint8* m  = _simd_elems_<uint8>( mask );
+    const uint8* va = _simd_elems_<uint8>( a );
+    const uint8* vb = _simd_elems_<uint8>( b );
+    uint8* dst = _simd_elems_<uint8>( target );
+
+    for (int i = 0; i < SZ; i++)
+        dst[i] = uint8( (m[i] & va[i]) | (~m[i] & vb[i]) );
+}
+
+// bit i of result is the highest bit of element i
+template<typename T, int SZ>
+inline uint64 simd_movemask( const SIMDType<SZ>& value ) noexcept
+{
+    const uint8* bytes = _simd_elems_<uint8>( value );
+    uint64 result = 0;
+
+    for (int i = 0; i < int( SZ / sizeof(T) ); i++)
+        result |= uint64( bytes[i * sizeof(T) + sizeof(T) - 1] >> 7 ) << i;
+
+    return result;
+}
+
+// Load first count elements and set remaining ones to zero. Memory after
+// values[count - 1] is never touched, so this can read buffer tails.
+template<typename T, int SZ>
+inline void simd_load_partial( SIMDType<SZ>& target, const T* values, int count ) noexcept
+{
+    memset( &target, 0, SZ );
+    memcpy( &target, values, count * sizeof(T) );
+}
+
+// store first count elements, memory after store[count - 1] is not touched
+template<typename T, int SZ>
+inline void simd_store_partial( const SIMDType<SZ>& value, T* store, int count ) noexcept
+{
+    memcpy( store, &value, count * sizeof(T) );
+}
+
+// element i of target is base[index i], indices are taken from int32 elements
+// of indices; for 8-byte types only the lower half of indices is used
+template<typename T, int SZ>
+inline void simd_gather( SIMDType<SZ>& target, const T* base, const SIMDType<SZ>& indices ) noexcept
+{
+    for (int i = 0; i < int( SZ / sizeof(T) ); i++)
+        _simd_elems_<T>( target )[i] = base[_simd_elems_<int32>( indices )[i]];
+}
+
+// horizontal minimum and maximum of all elements
+template<typename T, int SZ>
+inline T simd_reduce_min( const SIMDType<SZ>& value ) noexcept
+{
+    T result = _simd_elems_<T>( value )[0];
+    for (int i = 1; i < int( SZ / sizeof(T) ); i++)
+        result = _simd_elems_<T>( value )[i] < result ? _simd_elems_<T>( value )[i] : result;
+    return result;
+}
+
+template<typename T, int SZ>
+inline T simd_reduce_max( const SIMDType<SZ>& value ) noexcept
+{
+    T result = _simd_elems_<T>( value )[0];
+    for (int i = 1; i < int( SZ / sizeof(T) ); i++)
+        result = _simd_elems_<T>( value )[i] > result ? _simd_elems_<T>( value )[i] : result;
+    return result;
+}
+
 } // namespace treecore
 
 #endif // TREECORE_SIMD_FUNC_TEMP_H
@@ -9,6 +9,7 @@
    ==============================================================================
  */
 
+#include "treecore/DirectoryIterator.h"
 #include "treecore/File.h"
 #include "treecore/FileOutputStream.h"
 #include "treecore/MemoryBlock.h"
@@ -19,6 +20,7 @@
 #include "treecore/StringPool.h"
 #include "treecore/StringRef.h"
 #include "treecore/Time.h"
+#include "treecore/WildcardMatcher.h"
 
 #include <iostream>
 
@@ -84,14 +86,13 @@ static bool isHiddenFile( const File& f, const File& root )
 
 void collect_input_files( const File& dir_in, Array<File>& files_in )
 {
-    Array<File> tmp_files_in;
-    if (wild_card.length() > 0)
-        dir_in.findChildFiles( tmp_files_in, File::findFiles, true, wild_card );
-    else
-        dir_in.findChildFiles( tmp_files_in, File::findFiles, true, "*" );
+    // the patterns are compiled once for the whole tree
+    const WildcardMatcher matcher( WildcardMatcher::splitPatterns( wild_card.length() > 0 ? wild_card : String( "*" ) ),
+                                   !File::areFileNamesCaseSensitive() );
 
-    for (const File& f : tmp_files_in)
+    for (DirectoryIterator it( dir_in, true, matcher ); it.next(); )
     {
+        const File& f = it.getFile();
         if ( !isHiddenFile( f, dir_in ) ) files_in.add( f );
     }
 }
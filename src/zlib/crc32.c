@@ -30,6 +30,12 @@
 
 #define local static
 
+/* treecore: crc32() is computed by treecore_zlib_crc32(), which uses
+   PCLMULQDQ when CPU has it, and slicing-by-8 tables otherwise. */
+extern unsigned long treecore_zlib_crc32 OF((unsigned long crc,
+                                             const unsigned char FAR *buf, unsigned len));
+#define NOBYFOUR
+
 /* Find a four-byte integer type for crc32_little() and crc32_big(). */
 #ifndef NOBYFOUR
 #  ifdef STDC           /* need ANSI C limits.h to determine sizes */
@@ -220,31 +226,7 @@ unsigned long ZEXPORT crc32 (unsigned long crc, const unsigned char FAR *buf, un
 {
     if (buf == Z_NULL) return 0UL;
 
-#ifdef DYNAMIC_CRC_TABLE
-    if (crc_table_empty)
-        make_crc_table();
-#endif /* DYNAMIC_CRC_TABLE */
-
-#ifdef BYFOUR
-    if (sizeof(void *) == sizeof(ptrdiff_t)) {
-        u4 endian;
-
-        endian = 1;
-        if (*((unsigned char *)(&endian)))
-            return crc32_little(crc, buf, len);
-        else
-            return crc32_big(crc, buf, len);
-    }
-#endif /* BYFOUR */
-    crc = crc ^ 0xffffffffUL;
-    while (len >= 8) {
-        DO8;
-        len -= 8;
-    }
-    if (len) do {
-        DO1;
-    } while (--len);
-    return crc ^ 0xffffffffUL;
+    return treecore_zlib_crc32(crc, buf, len);
 }
 
 #ifdef BYFOUR
@@ -0,0 +1,79 @@
+#include "treecore/TestFramework.h"
+#include "treecore/AdaptiveMutex.h"
+#include "treecore/Array.h"
+#include "treecore/Thread.h"
+
+#define NUM_ITER 200000
+#define NUM_THREAD 8
+
+using namespace treecore;
+
+struct LockThread: public Thread
+{
+    LockThread( AdaptiveMutex& mutex, int64& counter, int idx )
+        : Thread( String( idx ) )
+        , mutex( mutex )
+        , counter( counter )
+    {}
+
+    void run() override
+    {
+        for (int i = 0; i < NUM_ITER; i++)
+        {
+            const AdaptiveMutex::ScopedLockType lock( mutex );
+            // non-atomic read-modify-write: only correct under mutual exclusion
+            int64 value = counter;
+            if (i % 1000 == 0) Thread::yield();
+            counter = value + 1;
+        }
+    }
+
+    AdaptiveMutex& mutex;
+    int64& counter;
+};
+
+void TestFramework::content( int argc, char** argv )
+{
+    {
+        AdaptiveMutex mutex;
+        OK( mutex.tryEnter() );
+        OK( !mutex.tryEnter() );
+        mutex.exit();
+        OK( mutex.tryEnter() );
+        mutex.exit();
+
+        {
+            const AdaptiveMutex::ScopedLockType lock( mutex );
+            OK( !mutex.tryEnter() );
+            {
+                const AdaptiveMutex::ScopedUnlockType unlock( mutex );
+                const AdaptiveMutex::ScopedTryLockType try_lock( mutex );
+                OK( try_lock.isLocked() );
+            }
+        }
+        OK( mutex.tryEnter() );
+        mutex.exit();
+    }
+
+    {
+        AdaptiveMutex mutex;
+        int64 counter = 0;
+
+        Array<LockThread*> threads;
+        for (int i = 0; i < NUM_THREAD; i++)
+            threads.add( new LockThread( mutex, counter, i ) );
+
+        for (int i = 0; i < NUM_THREAD; i++)
+            threads[i]->startThread();
+
+        for (int i = 0; i < NUM_THREAD; i++)
+            threads[i]->waitForThreadToExit( -1 );
+
+        for (int i = 0; i < NUM_THREAD; i++)
+            delete threads[i];
+
+        IS( counter, int64( NUM_ITER ) * NUM_THREAD );
+        OK( mutex.tryEnter() );
+        mutex.exit();
+    }
+}
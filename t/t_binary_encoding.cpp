@@ -0,0 +1,363 @@
+#include "treecore/TestFramework.h"
+#include "treecore/BinaryEncoding.h"
+#include "treecore/CpuDispatch.h"
+#include "treecore/MemoryBlock.h"
+#include "treecore/MemoryOutputStream.h"
+#include "treecore/String.h"
+#include "treecore/StringRef.h"
+
+#include "treecore/internal/BinaryEncoding_impl.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace treecore;
+
+// lengths around register and chunk sizes, and longer ones
+static const size_t lengths[] = { 0, 1, 2, 3, 4, 5, 23, 24, 25, 27, 28, 29, 31, 32, 33, 47, 48, 49, 95, 96, 97, 300, 1000 };
+
+static uint32 next_random( uint32& seed )
+{
+    seed = seed * 1664525u + 1013904223u;
+    return seed >> 8;
+}
+
+static std::vector<uint8> random_bytes( size_t num, uint32 seed )
+{
+    std::vector<uint8> result( num );
+    for (size_t i = 0; i < num; i++)
+        result[i] = uint8( next_random( seed ) );
+    return result;
+}
+
+// bit by bit, straight from RFC 4648
+static std::string reference_base64( const std::vector<uint8>& data, Base64Alphabet alphabet, bool pad )
+{
+    const char* chars = alphabet == BASE64_URL
+                        ? "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_"
+                        : "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string result;
+    const size_t num_bits = data.size() * 8;
+
+    for (size_t bit = 0; bit < num_bits; bit += 6)
+    {
+        int value = 0;
+        for (size_t k = bit; k < bit + 6; k++)
+        {
+            const int b = k < num_bits ? (data[k / 8] >> (7 - k % 8)) & 1 : 0;
+            value = value * 2 + b;
+        }
+        result += chars[value];
+    }
+
+    while (pad && result.size() % 4 != 0)
+        result += '=';
+
+    return result;
+}
+
+static std::string reference_hex( const std::vector<uint8>& data, bool upper_case )
+{
+    const char* digits = upper_case ? "0123456789ABCDEF" : "0123456789abcdef";
+    std::string result;
+
+    for (uint8 b : data)
+    {
+        result += digits[b >> 4];
+        result += digits[b & 15];
+    }
+
+    return result;
+}
+
+// the format of toBase64Encoding(), as it was written with getBitRange()
+static String reference_legacy_base64( const MemoryBlock& block )
+{
+    static const char table[] = ".ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+";
+    String result = String( (int) block.getSize() ) + ".";
+    const size_t num_chars = (block.getSize() * 8 + 5) / 6;
+
+    for (size_t i = 0; i < num_chars; i++)
+        result += String::charToString( (treecore_wchar) table[block.getBitRange( i * 6, 6 )] );
+
+    return result;
+}
+
+void TestFramework::content( int argc, char** argv )
+{
+    auto test_table = [&]( const BinaryEncodingKernelTable& k ) {
+        for (size_t len : lengths)
+        {
+            const size_t num = len - len % 3;
+            const std::vector<uint8> data = random_bytes( num, uint32( len ) );
+            std::vector<char> text( num / 3 * 4 + 1, 0 );
+            std::vector<uint8> decoded( num + 1, 0 );
+
+            for (int alphabet = 0; alphabet < 2; alphabet++)
+            {
+                k.base64_encode( data.data(), num, text.data(), Base64Alphabet( alphabet ) );
+                IS( std::string( text.data() ), reference_base64( data, Base64Alphabet( alphabet ), false ) );
+
+                OK( k.base64_decode( text.data(), num / 3 * 4, decoded.data(), Base64Alphabet( alphabet ) ) );
+                OK( std::memcmp( decoded.data(), data.data(), num ) == 0 );
+                IS( int( decoded[num] ), 0 );
+            }
+
+            // one bad character anywhere in text
+            for (size_t pos = 0; pos < num / 3 * 4; pos += 7)
+            {
+                const char saved = text[pos];
+                const char bad[] = { '=', ' ', '\n', '\x80', '.', '+', '/' };
+
+                for (char c : bad)
+                {
+                    text[pos] = c;
+                    OK( !k.base64_decode( text.data(), num / 3 * 4, decoded.data(), BASE64_URL ) );
+                }
+
+                text[pos] = saved;
+            }
+        }
+
+        for (size_t len : lengths)
+        {
+            const std::vector<uint8> data = random_bytes( len, uint32( len ) + 1000 );
+            std::vector<char> text( len * 2 + 1, 0 );
+            std::vector<uint8> decoded( len + 1, 0 );
+
+            for (int upper = 0; upper < 2; upper++)
+            {
+                k.hex_encode( data.data(), len, text.data(), upper != 0 );
+                IS( std::string( text.data() ), reference_hex( data, upper != 0 ) );
+
+                OK( k.hex_decode( text.data(), len, decoded.data() ) );
+                OK( std::memcmp( decoded.data(), data.data(), len ) == 0 );
+                IS( int( decoded[len] ), 0 );
+            }
+
+            for (size_t pos = 0; pos < len * 2; pos += 5)
+            {
+                const char saved = text[pos];
+                const char bad[] = { 'g', 'G', '/', ':', '@', '`', ' ', '\xc1' };
+
+                for (char c : bad)
+                {
+                    text[pos] = c;
+                    OK( !k.hex_decode( text.data(), len, decoded.data() ) );
+                }
+
+                text[pos] = saved;
+            }
+        }
+
+        // all byte values, for digits of either case
+        {
+            uint8 all[256];
+            char hex[512];
+            uint8 back[256];
+
+            for (int i = 0; i < 256; i++)
+                all[i] = uint8( i );
+
+            k.hex_encode( all, 256, hex, false );
+            for (int i = 0; i < 512; i++)
+                hex[i] = char( i % 3 == 0 && hex[i] >= 'a' ? hex[i] - 32 : hex[i] );
+
+            OK( k.hex_decode( hex, 256, back ) );
+            OK( std::memcmp( all, back, 256 ) == 0 );
+        }
+    };
+
+    OK( "baseline kernels" );
+    test_table( *get_binary_encoding_kernels_baseline() );
+
+#if TREECORE_CPU_X86
+    if (get_cpu_feature_level() >= CPU_LEVEL_AVX2)
+    {
+        OK( "AVX2 kernels" );
+        test_table( *get_binary_encoding_kernels_avx2() );
+    }
+#endif
+
+    OK( "RFC 4648 test vectors" );
+    {
+        const char* plain[]  = { "", "f", "fo", "foo", "foob", "fooba", "foobar" };
+        const char* padded[] = { "", "Zg==", "Zm8=", "Zm9v", "Zm9vYg==", "Zm9vYmE=", "Zm9vYmFy" };
+        const char* hex[]    = { "", "66", "666f", "666f6f", "666f6f62", "666f6f6261", "666f6f626172" };
+
+        for (int i = 0; i < 7; i++)
+        {
+            const size_t num = std::strlen( plain[i] );
+            char text[16] = { 0 };
+            char data[16] = { 0 };
+
+            IS( base64_encode( plain[i], num, text ), std::strlen( padded[i] ) );
+            IS( std::string( text ), std::string( padded[i] ) );
+            IS( base64_encoded_length( num ), std::strlen( padded[i] ) );
+
+            // without padding
+            std::memset( text, 0, sizeof(text) );
+            const size_t num_unpadded = base64_encode( plain[i], num, text, BASE64_STANDARD, false );
+            IS( num_unpadded, base64_encoded_length( num, false ) );
+            IS( std::string( text ), std::string( padded[i] ).substr( 0, num_unpadded ) );
+
+            IS( base64_decoded_length( padded[i], std::strlen( padded[i] ) ), num );
+            OK( base64_decode( padded[i], std::strlen( padded[i] ), data ) );
+            IS( std::string( data ), std::string( plain[i] ) );
+
+            std::memset( data, 0, sizeof(data) );
+            IS( base64_decoded_length( text, num_unpadded ), num );
+            OK( base64_decode( text, num_unpadded, data ) );
+            IS( std::string( data ), std::string( plain[i] ) );
+
+            std::memset( text, 0, sizeof(text) );
+            hex_encode( plain[i], num, text );
+            IS( std::string( text ), std::string( hex[i] ) );
+
+            std::memset( data, 0, sizeof(data) );
+            OK( hex_decode( hex[i], std::strlen( hex[i] ), data ) );
+            IS( std::string( data ), std::string( plain[i] ) );
+        }
+    }
+
+    OK( "alphabets and invalid text" );
+    {
+        const uint8 data[] = { 0xfb, 0xff };
+        char text[8] = { 0 };
+        uint8 back[8];
+
+        base64_encode( data, 2, text );
+        IS( std::string( text ), std::string( "+/8=" ) );
+        base64_encode( data, 2, text, BASE64_URL );
+        IS( std::string( text ), std::string( "-_8=" ) );
+
+        OK( base64_decode( "-_8=", 4, back, BASE64_URL ) );
+        OK( back[0] == 0xfb && back[1] == 0xff );
+        OK( !base64_decode( "-_8=", 4, back ) );
+        OK( !base64_decode( "+/8=", 4, back, BASE64_URL ) );
+
+        // misplaced padding, impossible lengths and foreign characters
+        const char* invalid[] = { "=", "Zg=", "Zg===", "Z", "Zm9vY", "Zm9vY===", "Z===", "Zm=v", "Zm9v Yg==", "Zm9v\n", "Zm9\x80" };
+        for (const char* s : invalid)
+            OK( !base64_decode( s, std::strlen( s ), back ) );
+
+        // unused bits of the last character are ignored
+        OK( base64_decode( "Zh==", 4, back ) );
+        IS( int( back[0] ), 'f' );
+
+        OK( !hex_decode( "abc", 3, back ) );
+        OK( !hex_decode( "0x", 2, back ) );
+        OK( hex_decode( "AbCd", 4, back ) );
+        OK( back[0] == 0xab && back[1] == 0xcd );
+    }
+
+    OK( "streams" );
+    for (size_t len : { size_t( 0 ), size_t( 5 ), size_t( 3072 ), size_t( 3073 ), size_t( 10000 ) })
+    {
+        const std::vector<uint8> data = random_bytes( len, uint32( len ) + 7 );
+
+        for (int alphabet = 0; alphabet < 2; alphabet++)
+        {
+            const std::string expected = reference_base64( data, Base64Alphabet( alphabet ), true );
+
+            MemoryOutputStream text_out;
+            OK( base64_encode( data.data(), len, text_out, Base64Alphabet( alphabet ) ) );
+            IS( text_out.getDataSize(), expected.size() );
+            OK( std::memcmp( text_out.getData(), expected.data(), expected.size() ) == 0 );
+
+            MemoryOutputStream data_out;
+            OK( base64_decode( expected.data(), expected.size(), data_out, Base64Alphabet( alphabet ) ) );
+            IS( data_out.getDataSize(), len );
+            OK( len == 0 || std::memcmp( data_out.getData(), data.data(), len ) == 0 );
+        }
+
+        const std::string expected_hex = reference_hex( data, true );
+
+        MemoryOutputStream hex_out;
+        OK( hex_encode( data.data(), len, hex_out, true ) );
+        IS( hex_out.getDataSize(), expected_hex.size() );
+        OK( std::memcmp( hex_out.getData(), expected_hex.data(), expected_hex.size() ) == 0 );
+
+        MemoryOutputStream data_out;
+        OK( hex_decode( expected_hex.data(), expected_hex.size(), data_out ) );
+        IS( data_out.getDataSize(), len );
+        OK( len == 0 || std::memcmp( data_out.getData(), data.data(), len ) == 0 );
+    }
+
+    // padding inside text is caught when text is decoded in chunks
+    {
+        std::string text( 8192, 'A' );
+        text[4094] = text[4095] = '=';
+
+        MemoryOutputStream out;
+        OK( !base64_decode( text.data(), text.size(), out ) );
+        OK( !hex_decode( text.data(), text.size(), out ) );
+    }
+
+    OK( "MemoryBlock" );
+    for (size_t len : lengths)
+    {
+        const std::vector<uint8> data = random_bytes( len, uint32( len ) + 99 );
+        const MemoryBlock block( data.data(), len );
+
+        const String base64 = block.toBase64String( BASE64_URL, false );
+        IS( base64, String( reference_base64( data, BASE64_URL, false ).c_str() ) );
+
+        MemoryBlock back;
+        OK( back.loadFromBase64String( base64, BASE64_URL ) );
+        OK( back == block );
+
+        const String hex = block.toHexString();
+        IS( hex, String( reference_hex( data, false ).c_str() ) );
+        IS( String::toHexString( data.data(), int( len ), 0 ), hex );
+
+        back.reset();
+        back.loadFromHexString( hex );
+        OK( back == block );
+
+        // the legacy format is unchanged
+        const String legacy = block.toBase64Encoding();
+        IS( legacy, reference_legacy_base64( block ) );
+
+        back.reset();
+        OK( back.fromBase64Encoding( legacy ) );
+        OK( back == block );
+    }
+
+    {
+        MemoryBlock block( "abc", 3 );
+        OK( !block.loadFromBase64String( "Zm9v!" ) );
+        IS( block.toString(), String( "abc" ) );
+
+        // non-hex characters are skipped
+        block.loadFromHexString( "0a 1B:ff\n7" );
+        IS( block.toHexString( true ), String( "0A1BFF" ) );
+
+        const uint8 bytes[] = { 1, 0xab, 0x20, 0xff, 0x7e };
+        IS( String::toHexString( bytes, 5 ), String( "01 ab 20 ff 7e" ) );
+        IS( String::toHexString( bytes, 5, 2 ), String( "01ab 20ff 7e" ) );
+        IS( String::toHexString( bytes, 4, 2 ), String( "01ab 20ff" ) );
+    }
+
+    // characters outside the legacy table are skipped, and those inside
+    // without a value decode as zero, over the old contents of the block
+    {
+        MemoryBlock block( 4, true );
+        block.fillWith( 0xff );
+        OK( block.fromBase64Encoding( "4.A\n-B C" ) );
+
+        MemoryBlock expected( 4, true );
+        expected.fillWith( 0xff );
+        const int values[] = { 1, 0, 2, 3 };
+        for (int i = 0; i < 4; i++)
+            expected.setBitRange( size_t( i ) * 6, 6, values[i] );
+
+        OK( block == expected );
+
+        // non-ASCII text is still decoded character by character
+        block.fillWith( 0xff );
+        OK( block.fromBase64Encoding( "4.A\xc3\xa9-B C" ) );
+        OK( block == expected );
+    }
+}
@@ -0,0 +1,266 @@
+#include "treecore/TestFramework.h"
+#include "treecore/Checksum.h"
+#include "treecore/ChecksumInputStream.h"
+#include "treecore/ChecksumOutputStream.h"
+#include "treecore/CpuDispatch.h"
+#include "treecore/GZIPCompressorOutputStream.h"
+#include "treecore/GZIPDecompressorInputStream.h"
+#include "treecore/MemoryInputStream.h"
+#include "treecore/MemoryOutputStream.h"
+#include "treecore/SystemStats.h"
+
+#include "treecore/internal/Checksum_impl.h"
+
+#include <cstring>
+#include <vector>
+
+extern "C"
+{
+#include "zlib.h"
+}
+
+using namespace treecore;
+
+// lengths around register and block sizes, and ones long enough for the
+// three-way interleaved CRC-32C loops
+static const size_t lengths[] = { 0, 1, 2, 3, 7, 8, 9, 15, 16, 17, 31, 32, 33, 63, 64, 65, 79, 80, 127, 128, 129,
+                                  255, 256, 257, 767, 768, 769, 1000, 5551, 5552, 5553, 24575, 24576, 24577, 70000 };
+
+static uint32 next_random( uint32& seed )
+{
+    seed = seed * 1664525u + 1013904223u;
+    return seed >> 8;
+}
+
+static std::vector<uint8> random_bytes( size_t num, uint32 seed )
+{
+    std::vector<uint8> result( num );
+    for (size_t i = 0; i < num; i++)
+        result[i] = uint8( next_random( seed ) );
+    return result;
+}
+
+// bit by bit, on the CRC register
+static uint32 reference_crc( uint32 poly, uint32 c, const uint8* data, size_t num )
+{
+    for (size_t i = 0; i < num; i++)
+    {
+        c ^= data[i];
+        for (int bit = 0; bit < 8; bit++)
+            c = (c & 1) != 0 ? (c >> 1) ^ poly : c >> 1;
+    }
+    return c;
+}
+
+static uint32 reference_adler32( uint32 adler, const uint8* data, size_t num )
+{
+    uint32 s1 = adler & 0xffff;
+    uint32 s2 = adler >> 16;
+
+    for (size_t i = 0; i < num; i++)
+    {
+        s1 = (s1 + data[i]) % 65521;
+        s2 = (s2 + s1) % 65521;
+    }
+
+    return s1 | (s2 << 16);
+}
+
+void TestFramework::content( int argc, char** argv )
+{
+    const std::vector<uint8> data = random_bytes( 70000 + 64, 12345 );
+
+    // compare kernel with reference from odd start values and misaligned data
+    auto test_kernel = [&]( ChecksumKernel kernel, uint32 (*reference)( uint32, const uint8*, size_t ) ) {
+        bool all_ok = true;
+
+        for (size_t num : lengths)
+        {
+            for (size_t offset = 0; offset < 3; offset++)
+            {
+                const uint32 start = 0x12345678u + uint32( num % 1000 );
+                const uint8* p = data.data() + offset;
+
+                if ( kernel( start, p, num ) != reference( start, p, num ) )
+                {
+                    all_ok = false;
+                    printf( "  mismatch with length %d offset %d\n", int( num ), int( offset ) );
+                }
+            }
+        }
+
+        OK( all_ok );
+    };
+
+    auto ref_crc32  = []( uint32 c, const uint8* p, size_t n ) { return reference_crc( 0xedb88320u, c, p, n ); };
+    auto ref_crc32c = []( uint32 c, const uint8* p, size_t n ) { return reference_crc( 0x82f63b78u, c, p, n ); };
+
+    OK( "baseline kernels" );
+    test_kernel( &crc32_baseline, ref_crc32 );
+    test_kernel( &crc32c_baseline, ref_crc32c );
+    test_kernel( &adler32_baseline, &reference_adler32 );
+
+#if TREECORE_CPU_X86
+    if (get_cpu_feature_level() >= CPU_LEVEL_SSE42)
+    {
+        OK( "SSE4.2 kernels" );
+        test_kernel( &crc32c_sse42, ref_crc32c );
+        test_kernel( &adler32_ssse3, &reference_adler32 );
+
+        if ( SystemStats::hasPCLMULQDQ() )
+        {
+            OK( "PCLMULQDQ kernel" );
+            test_kernel( &crc32_pclmul, ref_crc32 );
+        }
+    }
+
+    if (get_cpu_feature_level() >= CPU_LEVEL_AVX2)
+    {
+        OK( "AVX2 kernels" );
+        test_kernel( &adler32_avx2, &reference_adler32 );
+    }
+#endif
+
+    OK( "check values" );
+    {
+        const char* text = "123456789";
+        IS( checksum_crc32( 0, text, 9 ), 0xcbf43926u );
+        IS( checksum_crc32c( 0, text, 9 ), 0xe3069283u );
+        IS( checksum_adler32( 1, "Wikipedia", 9 ), 0x11e60398u );
+
+        IS( checksum_initial_value( CHECKSUM_CRC32 ), 0u );
+        IS( checksum_initial_value( CHECKSUM_CRC32C ), 0u );
+        IS( checksum_initial_value( CHECKSUM_ADLER32 ), 1u );
+
+        IS( checksum_crc32( 0, nullptr, 0 ), 0u );
+        IS( checksum_adler32( 1, nullptr, 0 ), 1u );
+    }
+
+    OK( "piece by piece" );
+    {
+        const ChecksumType types[] = { CHECKSUM_CRC32, CHECKSUM_CRC32C, CHECKSUM_ADLER32 };
+
+        for (ChecksumType type : types)
+        {
+            const uint32 whole = checksum_update( type, checksum_initial_value( type ), data.data(), 70000 );
+            uint32 pieces = checksum_initial_value( type );
+            uint32 seed   = 1;
+
+            for (size_t pos = 0; pos < 70000; )
+            {
+                size_t num = next_random( seed ) % 3000;
+                if (num > 70000 - pos)
+                    num = 70000 - pos;
+
+                pieces = checksum_update( type, pieces, data.data() + pos, num );
+                pos += num;
+            }
+
+            IS( pieces, whole );
+        }
+    }
+
+    OK( "same as zlib" );
+    {
+        bool all_ok = true;
+
+        for (size_t num : lengths)
+        {
+            const uint32 crc   = reference_crc( 0xedb88320u, 0xffffffffu, data.data(), num ) ^ 0xffffffffu;
+            const uint32 adler = reference_adler32( 1, data.data(), num );
+
+            all_ok = all_ok && checksum_crc32( 0, data.data(), num ) == crc;
+            all_ok = all_ok && uint32( crc32( 0, data.data(), uInt( num ) ) ) == crc;
+            all_ok = all_ok && checksum_adler32( 1, data.data(), num ) == adler;
+            all_ok = all_ok && uint32( adler32( 1, data.data(), uInt( num ) ) ) == adler;
+        }
+
+        OK( all_ok );
+    }
+
+    OK( "zlib round trip" );
+    {
+        MemoryOutputStream compressed;
+
+        {
+            GZIPCompressorOutputStream zipper( &compressed, 6, false );
+            zipper.write( data.data(), 70000 );
+        }
+
+        MemoryInputStream compressed_input( compressed.getData(), compressed.getDataSize(), false );
+        GZIPDecompressorInputStream unzipper( compressed_input );
+        MemoryOutputStream uncompressed;
+        uncompressed << unzipper;
+
+        IS( uncompressed.getDataSize(), size_t( 70000 ) );
+        OK( uncompressed.getDataSize() == 70000 && memcmp( uncompressed.getData(), data.data(), 70000 ) == 0 );
+
+        // zlib trailer is big-endian Adler-32 of uncompressed data
+        const uint8* trailer = static_cast<const uint8*>( compressed.getData() ) + compressed.getDataSize() - 4;
+        const uint32 adler   = (uint32( trailer[0] ) << 24) | (uint32( trailer[1] ) << 16) | (uint32( trailer[2] ) << 8) | trailer[3];
+        IS( adler, checksum_adler32( 1, data.data(), 70000 ) );
+    }
+
+    OK( "gzip trailer" );
+    {
+        MemoryOutputStream compressed;
+
+        {
+            GZIPCompressorOutputStream zipper( &compressed, 6, false, GZIPCompressorOutputStream::windowBitsGZIP );
+            zipper.write( data.data(), 70000 );
+        }
+
+        // gzip trailer holds CRC-32 and length of uncompressed data
+        const uint8* trailer = static_cast<const uint8*>( compressed.getData() ) + compressed.getDataSize() - 8;
+        IS( crc_load_le32( trailer ), checksum_crc32( 0, data.data(), 70000 ) );
+        IS( crc_load_le32( trailer + 4 ), 70000u );
+    }
+
+    OK( "ChecksumOutputStream" );
+    {
+        MemoryOutputStream dest;
+        ChecksumOutputStream stream( &dest, CHECKSUM_CRC32C );
+
+        stream.write( data.data(), 1000 );
+        stream.write( data.data() + 1000, 3000 );
+
+        IS( stream.getChecksum(), checksum_crc32c( 0, data.data(), 4000 ) );
+        IS( stream.getPosition(), int64( 4000 ) );
+        IS( dest.getDataSize(), size_t( 4000 ) );
+        OK( memcmp( dest.getData(), data.data(), 4000 ) == 0 );
+        OK( !stream.setPosition( 0 ) );
+
+        stream.resetChecksum();
+        IS( stream.getChecksum(), 0u );
+        IS( stream.getPosition(), int64( 0 ) );
+
+        // without destination
+        ChecksumOutputStream counter( nullptr, CHECKSUM_ADLER32 );
+        OK( counter.write( data.data(), 5000 ) );
+        IS( counter.getChecksum(), checksum_adler32( 1, data.data(), 5000 ) );
+    }
+
+    OK( "ChecksumInputStream" );
+    {
+        MemoryInputStream source( data.data(), 10000, false );
+        ChecksumInputStream stream( &source, CHECKSUM_CRC32 );
+        IS( stream.getTotalLength(), int64( 10000 ) );
+
+        char buffer[3000];
+        IS( stream.read( buffer, 3000 ), 3000 );
+        IS( stream.getChecksum(), checksum_crc32( 0, data.data(), 3000 ) );
+
+        // skipped bytes are checksummed, going backward isn't possible
+        OK( stream.setPosition( 7000 ) );
+        OK( !stream.setPosition( 10 ) );
+        IS( stream.getPosition(), int64( 7000 ) );
+
+        while ( !stream.isExhausted() )
+            stream.read( buffer, 3000 );
+
+        IS( stream.getChecksum(), checksum_crc32( 0, data.data(), 10000 ) );
+
+        stream.resetChecksum();
+        IS( stream.getChecksum(), 0u );
+    }
+}
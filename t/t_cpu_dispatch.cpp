@@ -0,0 +1,115 @@
+#include "treecore/TestFramework.h"
+#include "treecore/CpuDispatch.h"
+#include "treecore/SystemStats.h"
+
+#include <immintrin.h>
+
+using namespace treecore;
+
+typedef int32 (*SumFunc)( const int32*, int );
+
+static int32 sum_baseline( const int32* data, int n )
+{
+    int32 result = 0;
+    for (int i = 0; i < n; i++)
+        result += data[i];
+    return result;
+}
+
+TREECORE_TARGET_SSE42 static int32 sum_sse42( const int32* data, int n )
+{
+    __m128i acc = _mm_setzero_si128();
+    int i = 0;
+    for (; i + 4 <= n; i += 4)
+        acc = _mm_add_epi32( acc, _mm_loadu_si128( (const __m128i*) (data + i) ) );
+
+    acc = _mm_hadd_epi32( acc, acc );
+    acc = _mm_hadd_epi32( acc, acc );
+    int32 result = _mm_extract_epi32( acc, 0 );
+
+    for (; i < n; i++)
+        result += data[i];
+    return result;
+}
+
+TREECORE_TARGET_AVX2 static int32 sum_avx2( const int32* data, int n )
+{
+    __m256i acc = _mm256_setzero_si256();
+    int i = 0;
+    for (; i + 8 <= n; i += 8)
+        acc = _mm256_add_epi32( acc, _mm256_loadu_si256( (const __m256i*) (data + i) ) );
+
+    __m128i half = _mm_add_epi32( _mm256_castsi256_si128( acc ), _mm256_extracti128_si256( acc, 1 ) );
+    half = _mm_hadd_epi32( half, half );
+    half = _mm_hadd_epi32( half, half );
+    int32 result = _mm_cvtsi128_si32( half );
+
+    for (; i < n; i++)
+        result += data[i];
+    return result;
+}
+
+static const CpuDispatchTable<SumFunc> sum_impls = { {
+    sum_baseline, sum_sse42, sum_avx2, nullptr
+} };
+
+void TestFramework::content( int argc, char** argv )
+{
+    const CpuFeatureLevel level = get_cpu_feature_level();
+    printf( "CPU feature level: %s\n", get_cpu_feature_level_name( level ) );
+
+    OK( "instruction set flags are consistent" );
+    if ( SystemStats::hasSSE42() ) OK( SystemStats::hasSSE2() );
+    if ( SystemStats::hasAVX2() )  OK( SystemStats::hasAVX() );
+    if ( SystemStats::hasFMA3() )  OK( SystemStats::hasAVX() );
+    if ( SystemStats::hasAVX512BW() ) OK( SystemStats::hasAVX512F() );
+    if ( SystemStats::hasAVX512DQ() ) OK( SystemStats::hasAVX512F() );
+    if ( SystemStats::hasAVX512VL() ) OK( SystemStats::hasAVX512F() );
+
+#if TREECORE_CPU_X86 && TREECORE_SIZE_PTR == 8
+    // x86-64 always has SSE2
+    OK( SystemStats::hasSSE() );
+    OK( SystemStats::hasSSE2() );
+#endif
+
+    OK( "level agrees with flags" );
+    if (level >= CPU_LEVEL_SSE42)
+    {
+        OK( SystemStats::hasSSE41() );
+        OK( SystemStats::hasSSE42() );
+    }
+    if (level >= CPU_LEVEL_AVX2)
+    {
+        OK( SystemStats::hasAVX2() );
+        OK( SystemStats::hasFMA3() );
+        OK( SystemStats::hasBMI2() );
+    }
+    if (level >= CPU_LEVEL_AVX512)
+    {
+        OK( SystemStats::hasAVX512F() );
+        OK( SystemStats::hasAVX512BW() );
+    }
+    OK( get_cpu_feature_level() == level );
+
+    OK( "select best implementation not above level" );
+    OK( sum_impls.select( CPU_LEVEL_BASELINE ) == &sum_baseline );
+    OK( sum_impls.select( CPU_LEVEL_SSE42 ) == &sum_sse42 );
+    OK( sum_impls.select( CPU_LEVEL_AVX2 ) == &sum_avx2 );
+    OK( sum_impls.select( CPU_LEVEL_AVX512 ) == &sum_avx2 );
+
+    OK( "all usable implementations give same result" );
+    int32 data[103];
+    for (int i = 0; i < 103; i++)
+        data[i] = i * 7 - 300;
+
+    const int32 expect = sum_baseline( data, 103 );
+    for (int i = 0; i <= int(level); i++)
+    {
+        SumFunc impl = sum_impls.select( CpuFeatureLevel( i ) );
+        IS( impl( data, 103 ), expect );
+        IS( impl( data, 5 ), sum_baseline( data, 5 ) );
+    }
+
+    static const SumFunc best = sum_impls.select();
+    IS( best( data, 103 ), expect );
+}
@@ -0,0 +1,96 @@
+#include "treecore/TestFramework.h"
+#include "treecore/AtomicObject.h"
+#include "treecore/DistributedRWLock.h"
+#include "treecore/Thread.h"
+
+#define NUM_ITER 50000
+#define NUM_READER 6
+#define NUM_WRITER 2
+
+using namespace treecore;
+
+struct SharedData
+{
+    DistributedRWLock lock;
+    int64 a = 0;
+    int64 b = 0;
+    AtomicObject<int32> num_broken;
+};
+
+struct ReaderThread: public Thread
+{
+    ReaderThread( SharedData& data ): Thread( "reader" ), data( data ) {}
+
+    void run() override
+    {
+        for (int i = 0; i < NUM_ITER; i++)
+        {
+            const DistributedRWLock::ScopedReadLock lock( data.lock );
+            if (data.a != data.b)
+                ++data.num_broken;
+        }
+    }
+
+    SharedData& data;
+};
+
+struct WriterThread: public Thread
+{
+    WriterThread( SharedData& data ): Thread( "writer" ), data( data ) {}
+
+    void run() override
+    {
+        for (int i = 0; i < NUM_ITER / 10; i++)
+        {
+            const DistributedRWLock::ScopedWriteLock lock( data.lock );
+            data.a++;
+            if (i % 16 == 0) Thread::yield();
+            data.b++;
+        }
+    }
+
+    SharedData& data;
+};
+
+void TestFramework::content( int argc, char** argv )
+{
+    {
+        DistributedRWLock lock;
+        OK( lock.tryEnterRead() );
+        OK( lock.tryEnterRead() );
+        OK( !lock.tryEnterWrite() );
+        lock.exitRead();
+        lock.exitRead();
+
+        OK( lock.tryEnterWrite() );
+        OK( !lock.tryEnterRead() );
+        OK( !lock.tryEnterWrite() );
+        lock.exitWrite();
+
+        OK( lock.tryEnterRead() );
+        lock.exitRead();
+    }
+
+    {
+        SharedData data;
+        Thread* threads[NUM_READER + NUM_WRITER];
+
+        for (int i = 0; i < NUM_READER; i++)
+            threads[i] = new ReaderThread( data );
+        for (int i = 0; i < NUM_WRITER; i++)
+            threads[NUM_READER + i] = new WriterThread( data );
+
+        for (Thread* thread : threads)
+            thread->startThread();
+
+        for (Thread* thread : threads)
+        {
+            thread->waitForThreadToExit( -1 );
+            delete thread;
+        }
+
+        IS( data.num_broken.load(), 0 );
+        IS( data.a, int64( NUM_ITER / 10 * NUM_WRITER ) );
+        IS( data.b, data.a );
+    }
+}
@@ -0,0 +1,237 @@
+#include "treecore/TestFramework.h"
+#include "treecore/Array.h"
+#include "treecore/AtomicFunc.h"
+#include "treecore/EpochManager.h"
+#include "treecore/ObjectPool.h"
+#include "treecore/Thread.h"
+
+#define NUM_ITER 100000
+#define NUM_THREAD 8
+#define NODE_ALIVE 0x600dF00D
+
+using namespace treecore;
+
+static void count_reclaim( void* object, void* context )
+{
+    atomic_fetch_add<int32>( (int32*) context, 1 );
+}
+
+struct PinningThread: public Thread
+{
+    PinningThread( EpochManager& manager )
+        : Thread( "pin" )
+        , manager( manager )
+    {}
+
+    void run() override
+    {
+        manager.enter();
+        entered.signal();
+        leave.wait( -1 );
+        manager.exit();
+        manager.detachCurrentThread();
+    }
+
+    EpochManager& manager;
+    WaitableEvent entered;
+    WaitableEvent leave;
+};
+
+//
+// Treiber stack whose nodes come from an ObjectPool and are retired when
+// popped. Without deferred recycling, a popped node could be reused while
+// another thread still reads its next pointer.
+//
+struct Node
+{
+    Node( int32 value ): value( value ), magic( NODE_ALIVE ), next( nullptr ) {}
+    ~Node() { magic = 0; }
+
+    int32 value;
+    volatile int32 magic;
+    Node* next;
+};
+
+typedef ObjectPool<Node, true, 1024> NodePool;
+
+struct Stack
+{
+    Stack( NodePool& pool ): pool( pool ) {}
+
+    void push( int32 value )
+    {
+        Node* node = pool.generate( value );
+        Node* head = atomic_load( &top );
+        do
+            node->next = head;
+        while ( !atomic_compare_exchange( &top, &head, node ) );
+    }
+
+    bool pop( int32& value )
+    {
+        Node* head;
+        {
+            EpochManager::ScopedGuard guard( pool.getEpochManager() );
+
+            head = atomic_load( &top );
+            for (;; )
+            {
+                if (head == nullptr)
+                    return false;
+
+                if (head->magic != NODE_ALIVE)
+                    num_bad_access++;
+
+                if ( atomic_compare_exchange( &top, &head, head->next ) )
+                    break;
+            }
+
+            value = head->value;
+        }
+
+        pool.retire( head );
+        return true;
+    }
+
+    NodePool& pool;
+    Node* top = nullptr;
+    int32 num_bad_access = 0;
+};
+
+struct StackThread: public Thread
+{
+    StackThread( Stack& stack, int idx )
+        : Thread( String( idx ) )
+        , stack( stack )
+        , idx( idx )
+    {}
+
+    void run() override
+    {
+        for (int i = 0; i < NUM_ITER; i++)
+        {
+            stack.push( idx );
+
+            int32 value = 0;
+            if ( stack.pop( value ) )
+                sum += value;
+        }
+
+        stack.pool.getEpochManager().synchronize();
+        stack.pool.getEpochManager().detachCurrentThread();
+    }
+
+    Stack& stack;
+    int idx;
+    int64 sum = 0;
+};
+
+void TestFramework::content( int argc, char** argv )
+{
+    OK( "single thread" );
+    {
+        int32 num_reclaimed = 0;
+        EpochManager manager;
+
+        manager.enter();
+        OK( manager.isInCriticalSection() );
+        manager.retire( &num_reclaimed, count_reclaim, &num_reclaimed );
+        manager.retire( &num_reclaimed, count_reclaim, &num_reclaimed );
+        IS( manager.getNumPending(), int64( 2 ) );
+
+        // epoch goes forward once, and current thread blocks the next step
+        manager.collect();
+        manager.collect();
+        manager.collect();
+        IS( num_reclaimed, 0 );
+        manager.exit();
+        OK( !manager.isInCriticalSection() );
+
+        manager.synchronize();
+        IS( num_reclaimed, 2 );
+        IS( manager.getNumPending(), int64( 0 ) );
+
+        manager.retire( &num_reclaimed, count_reclaim, &num_reclaimed );
+        IS( num_reclaimed, 2 );
+    }
+
+    OK( "destructor reclaims pending objects" );
+    {
+        int32 num_reclaimed = 0;
+        {
+            EpochManager manager;
+            manager.retire( &num_reclaimed, count_reclaim, &num_reclaimed );
+            IS( num_reclaimed, 0 );
+        }
+        IS( num_reclaimed, 1 );
+    }
+
+    OK( "reader in other thread holds back reclamation" );
+    {
+        int32 num_reclaimed = 0;
+        EpochManager manager;
+        PinningThread pinning( manager );
+        pinning.startThread();
+        pinning.entered.wait( -1 );
+
+        manager.retire( &num_reclaimed, count_reclaim, &num_reclaimed );
+        for (int i = 0; i < 10; i++)
+            manager.collect();
+        IS( num_reclaimed, 0 );
+        LE( manager.getEpoch(), uint32( 1 ) );
+
+        pinning.leave.signal();
+        pinning.waitForThreadToExit( -1 );
+
+        manager.synchronize();
+        IS( num_reclaimed, 1 );
+    }
+
+    OK( "object pool retire" );
+    {
+        NodePool pool( 1 );
+        Node* node = pool.generate( 123 );
+
+        pool.getEpochManager().enter();
+        pool.retire( node );
+        pool.getEpochManager().collect();
+        IS( node->magic, NODE_ALIVE );
+        pool.getEpochManager().exit();
+
+        pool.getEpochManager().synchronize();
+        IS( node->magic, 0 );
+    }
+
+    OK( "lock-free stack with retired nodes" );
+    {
+        NodePool pool( 4 );
+        Stack stack( pool );
+
+        Array<StackThread*> threads;
+        for (int i = 0; i < NUM_THREAD; i++)
+            threads.add( new StackThread( stack, i + 1 ) );
+
+        for (int i = 0; i < NUM_THREAD; i++)
+            threads[i]->startThread();
+
+        for (int i = 0; i < NUM_THREAD; i++)
+            threads[i]->waitForThreadToExit( -1 );
+
+        int64 sum = 0;
+        for (int i = 0; i < NUM_THREAD; i++)
+        {
+            sum += threads[i]->sum;
+            delete threads[i];
+        }
+
+        int32 value;
+        while ( stack.pop( value ) )
+            sum += value;
+
+        pool.getEpochManager().synchronize();
+
+        IS( stack.num_bad_access, 0 );
+        IS( sum, int64( NUM_ITER ) * NUM_THREAD * (NUM_THREAD + 1) / 2 );
+        IS( pool.getEpochManager().getNumPending(), int64( 0 ) );
+    }
+}
@@ -0,0 +1,205 @@
+#include "treecore/TestFramework.h"
+#include "treecore/AlignedMalloc.h"
+#include "treecore/CpuDispatch.h"
+#include "treecore/FloatVectorOperations.h"
+
+#include "treecore/internal/FloatVectorOperations_impl.h"
+
+using namespace treecore;
+
+#define BUF_SIZE 160
+
+// lengths shorter than one register, odd lengths, and long ones
+static const int lengths[] = { 0, 1, 3, 7, 8, 15, 17, 33, 63, 100, 127 };
+
+// starting offsets that leave destination unaligned by different amounts
+static const int offsets[] = { 0, 1, 3, 5 };
+
+static float value_at( int i, int seed )
+{
+    return float( (i * 37 + seed * 11) % 41 - 20 ) / 16.0f;
+}
+
+void TestFramework::content( int argc, char** argv )
+{
+    auto test_table = [&]( const FloatVectorKernelTable& k )
+    {
+        float* a    = (float*) aligned_malloc( BUF_SIZE * sizeof(float), 64 );
+        float* b    = (float*) aligned_malloc( BUF_SIZE * sizeof(float), 64 );
+        float* dest = (float*) aligned_malloc( BUF_SIZE * sizeof(float), 64 );
+        int32* i32  = (int32*) aligned_malloc( BUF_SIZE * sizeof(int32), 64 );
+        int16* i16  = (int16*) aligned_malloc( BUF_SIZE * sizeof(int16), 64 );
+
+        for (int i = 0; i < BUF_SIZE; i++)
+        {
+            a[i]   = value_at( i, 1 );
+            b[i]   = value_at( i, 2 );
+            i32[i] = (i * 7919) % 100001 - 50000;
+            i16[i] = int16( (i * 331) % 65536 - 32768 );
+        }
+
+        for (int offset : offsets)
+        {
+            for (int num : lengths)
+            {
+                const float* pa = a + offset;
+                const float* pb = b + offset;
+                float* pd = dest + offset;
+                bool all_ok;
+
+                // guard element right after range must never be touched
+                dest[offset + num] = 12345.0f;
+
+                k.add( pd, pa, pb, num );
+                all_ok = true;
+                for (int i = 0; i < num; i++) all_ok = all_ok && pd[i] == pa[i] + pb[i];
+                OK( all_ok );
+
+                k.add_scalar( pd, pa, 0.75f, num );
+                all_ok = true;
+                for (int i = 0; i < num; i++) all_ok = all_ok && pd[i] == pa[i] + 0.75f;
+                OK( all_ok );
+
+                k.multiply( pd, pa, pb, num );
+                all_ok = true;
+                for (int i = 0; i < num; i++) all_ok = all_ok && pd[i] == pa[i] * pb[i];
+                OK( all_ok );
+
+                k.multiply_scalar( pd, pa, -2.5f, num );
+                all_ok = true;
+                for (int i = 0; i < num; i++) all_ok = all_ok && pd[i] == pa[i] * -2.5f;
+                OK( all_ok );
+
+                // values are exact in few bits, so FMA and separate ops agree
+                for (int i = 0; i < num; i++) pd[i] = 1.0f;
+                k.multiply_add( pd, pa, pb, num );
+                all_ok = true;
+                for (int i = 0; i < num; i++) all_ok = all_ok && pd[i] == 1.0f + pa[i] * pb[i];
+                OK( all_ok );
+
+                for (int i = 0; i < num; i++) pd[i] = pb[i];
+                k.multiply_add_scalar( pd, pa, 0.5f, num );
+                all_ok = true;
+                for (int i = 0; i < num; i++) all_ok = all_ok && pd[i] == pb[i] + pa[i] * 0.5f;
+                OK( all_ok );
+
+                k.min( pd, pa, pb, num );
+                all_ok = true;
+                for (int i = 0; i < num; i++) all_ok = all_ok && pd[i] == (pa[i] < pb[i] ? pa[i] : pb[i]);
+                OK( all_ok );
+
+                k.max( pd, pa, pb, num );
+                all_ok = true;
+                for (int i = 0; i < num; i++) all_ok = all_ok && pd[i] == (pa[i] > pb[i] ? pa[i] : pb[i]);
+                OK( all_ok );
+
+                k.min_scalar( pd, pa, 0.25f, num );
+                all_ok = true;
+                for (int i = 0; i < num; i++) all_ok = all_ok && pd[i] == (pa[i] < 0.25f ? pa[i] : 0.25f);
+                OK( all_ok );
+
+                k.max_scalar( pd, pa, 0.25f, num );
+                all_ok = true;
+                for (int i = 0; i < num; i++) all_ok = all_ok && pd[i] == (pa[i] > 0.25f ? pa[i] : 0.25f);
+                OK( all_ok );
+
+                k.clip( pd, pa, -0.5f, 0.5f, num );
+                all_ok = true;
+                for (int i = 0; i < num; i++) all_ok = all_ok && pd[i] == (pa[i] < -0.5f ? -0.5f : (pa[i] > 0.5f ? 0.5f : pa[i]));
+                OK( all_ok );
+
+                k.abs( pd, pa, num );
+                all_ok = true;
+                for (int i = 0; i < num; i++) all_ok = all_ok && pd[i] == std::abs( pa[i] );
+                OK( all_ok );
+
+                k.convert_int32( pd, i32 + offset, 0.125f, num );
+                all_ok = true;
+                for (int i = 0; i < num; i++) all_ok = all_ok && pd[i] == float( i32[offset + i] ) * 0.125f;
+                OK( all_ok );
+
+                k.convert_int16( pd, i16 + offset, 1.0f / 32768.0f, num );
+                all_ok = true;
+                for (int i = 0; i < num; i++) all_ok = all_ok && pd[i] == float( i16[offset + i] ) * (1.0f / 32768.0f);
+                OK( all_ok );
+
+                IS( dest[offset + num], 12345.0f );
+
+                // in-place operation
+                for (int i = 0; i < num; i++) pd[i] = pa[i];
+                k.add( pd, pd, pb, num );
+                all_ok = true;
+                for (int i = 0; i < num; i++) all_ok = all_ok && pd[i] == pa[i] + pb[i];
+                OK( all_ok );
+
+                float sum = 0.0f;
+                float dot = 0.0f;
+                float lo  = num > 0 ? pa[0] : 0.0f;
+                float hi  = num > 0 ? pa[0] : 0.0f;
+                for (int i = 0; i < num; i++)
+                {
+                    sum += pa[i];
+                    dot += pa[i] * pb[i];
+                    lo   = pa[i] < lo ? pa[i] : lo;
+                    hi   = pa[i] > hi ? pa[i] : hi;
+                }
+
+                IS_EPSILON( k.sum( pa, num ), sum );
+                IS_EPSILON( k.dot_product( pa, pb, num ), dot );
+                IS( k.find_minimum( pa, num ), lo );
+                IS( k.find_maximum( pa, num ), hi );
+            }
+        }
+
+        aligned_free( a );
+        aligned_free( b );
+        aligned_free( dest );
+        aligned_free( i32 );
+        aligned_free( i16 );
+    };
+
+    OK( "baseline kernels" );
+    test_table( *get_float_vector_kernels_baseline() );
+
+#if TREECORE_CPU_X86
+    if (get_cpu_feature_level() >= CPU_LEVEL_AVX2)
+    {
+        OK( "AVX2 kernels" );
+        test_table( *get_float_vector_kernels_avx2() );
+    }
+#endif
+
+    OK( "public interface" );
+    float a[19], b[19];
+    for (int i = 0; i < 19; i++)
+    {
+        a[i] = float(i);
+        b[i] = 2.0f;
+    }
+
+    FloatVectorOperations::multiply( a, 0.5f, 19 );
+    IS( a[18], 9.0f );
+
+    FloatVectorOperations::add( a, b, 19 );
+    IS( a[0], 2.0f );
+    IS( a[18], 11.0f );
+
+    FloatVectorOperations::addWithMultiply( a, b, 3.0f, 19 );
+    IS( a[18], 17.0f );
+
+    FloatVectorOperations::multiply( a, b, 19 );
+    IS( a[1], 17.0f );
+
+    FloatVectorOperations::add( a, -10.0f, 19 );
+    IS( FloatVectorOperations::findMinimum( a, 19 ), 6.0f );
+    IS( FloatVectorOperations::findMaximum( a, 19 ), 24.0f );
+
+    IS( FloatVectorOperations::sum( b, 19 ), 38.0f );
+    IS( FloatVectorOperations::dotProduct( b, b, 19 ), 76.0f );
+
+    FloatVectorOperations::clip( a, a, 10.0f, 20.0f, 19 );
+    IS( FloatVectorOperations::findMinimum( a, 19 ), 10.0f );
+    IS( FloatVectorOperations::findMaximum( a, 19 ), 20.0f );
+
+    IS( FloatVectorOperations::findMinimum( a, 0 ), 0.0f );
+}
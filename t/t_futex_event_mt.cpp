@@ -0,0 +1,127 @@
+#include "treecore/TestFramework.h"
+#include "treecore/AtomicObject.h"
+#include "treecore/FutexEvent.h"
+#include "treecore/Thread.h"
+#include "treecore/Time.h"
+
+#define NUM_WAITER 4
+
+using namespace treecore;
+
+struct WaiterThread: public Thread
+{
+    WaiterThread( const FutexEvent& event, AtomicObject<int32>& num_woken )
+        : Thread( "waiter" )
+        , event( event )
+        , num_woken( num_woken )
+    {}
+
+    void run() override
+    {
+        if ( event.wait( 10000 ) )
+            ++num_woken;
+    }
+
+    const FutexEvent& event;
+    AtomicObject<int32>& num_woken;
+};
+
+struct PingPongThread: public Thread
+{
+    PingPongThread( const FutexEvent& ping, const FutexEvent& pong, int num_round )
+        : Thread( "pong" )
+        , ping( ping )
+        , pong( pong )
+        , num_round( num_round )
+    {}
+
+    void run() override
+    {
+        for (int i = 0; i < num_round; i++)
+        {
+            ping.wait();
+            pong.signal();
+        }
+    }
+
+    const FutexEvent& ping;
+    const FutexEvent& pong;
+    int num_round;
+};
+
+void TestFramework::content( int argc, char** argv )
+{
+    OK( "timeout" );
+    {
+        FutexEvent event;
+        OK( !event.wait( 0 ) );
+
+        const uint32 t0 = Time::getMillisecondCounter();
+        OK( !event.wait( 50 ) );
+        GE( Time::getMillisecondCounter() - t0, uint32( 45 ) );
+    }
+
+    OK( "auto reset" );
+    {
+        FutexEvent event;
+        event.signal();
+        OK( event.wait( 0 ) );
+        OK( !event.wait( 0 ) );
+
+        event.signal();
+        event.reset();
+        OK( !event.wait( 0 ) );
+    }
+
+    OK( "manual reset" );
+    {
+        FutexEvent event( true );
+        event.signal();
+        OK( event.wait( 0 ) );
+        OK( event.wait( 0 ) );
+        event.reset();
+        OK( !event.wait( 0 ) );
+    }
+
+    OK( "manual reset event wakes all waiters" );
+    {
+        FutexEvent event( true );
+        AtomicObject<int32> num_woken( 0 );
+
+        WaiterThread* threads[NUM_WAITER];
+        for (int i = 0; i < NUM_WAITER; i++)
+        {
+            threads[i] = new WaiterThread( event, num_woken );
+            threads[i]->startThread();
+        }
+
+        Thread::sleep( 20 );
+        event.signal();
+
+        for (int i = 0; i < NUM_WAITER; i++)
+        {
+            threads[i]->waitForThreadToExit( -1 );
+            delete threads[i];
+        }
+
+        IS( num_woken.load(), NUM_WAITER );
+    }
+
+    OK( "ping pong" );
+    {
+        FutexEvent ping;
+        FutexEvent pong;
+        PingPongThread thread( ping, pong, 10000 );
+        thread.startThread();
+
+        bool all_ok = true;
+        for (int i = 0; i < 10000; i++)
+        {
+            ping.signal();
+            all_ok = all_ok && pong.wait( 10000 );
+        }
+        OK( all_ok );
+
+        thread.waitForThreadToExit( -1 );
+    }
+}
@@ -210,6 +210,32 @@ void TestFramework::content( int argc, char** argv )
     IS( map["a"],   "c" );
     IS( map["c"],   "bar" );
 
+    // copies leave the source as it is
+    {
+        MapType copy( map );
+        IS( copy.size(), 4 );
+        IS( map.size(),  4 );
+        IS( copy["a"],   "c" );
+        IS( map["a"],    "c" );
+        IS( copy["c"],   "bar" );
+        IS( map["c"],    "bar" );
+        OK( copy == map );
+
+        MapType assigned;
+        assigned.set( "x", "y" );
+        assigned = map;
+        IS( assigned.size(), 4 );
+        IS( map.size(),      4 );
+        OK( !assigned.contains( "x" ) );
+        IS( assigned["ccccc"], "abcde" );
+        IS( map["ccccc"],      "abcde" );
+        OK( assigned == map );
+
+        copy.set( "a", "changed" );
+        IS( map["a"], "c" );
+        IS( map.size(), 4 );
+    }
+
     // clear
     {
         map.clear();
@@ -0,0 +1,121 @@
+#include "treecore/TestFramework.h"
+#include "treecore/AtomicObject.h"
+#include "treecore/HighResolutionTimer.h"
+#include "treecore/Thread.h"
+
+using namespace treecore;
+
+struct CountingTimer: public HighResolutionTimer
+{
+    CountingTimer(): num_calls( 0 ), stop_after( -1 ) {}
+
+    void hiResTimerCallback() override
+    {
+        int32 n = ++num_calls;
+        if (n == stop_after)
+            stopTimer();
+    }
+
+    AtomicObject<int32> num_calls;
+    int32 stop_after;
+};
+
+void TestFramework::content( int argc, char** argv )
+{
+    OK( "jitter histogram buckets" );
+    IS( HighResolutionTimer::JitterHistogram::getBucketForDeviation( 0 ),           0 );
+    IS( HighResolutionTimer::JitterHistogram::getBucketForDeviation( 999 ),         0 );
+    IS( HighResolutionTimer::JitterHistogram::getBucketForDeviation( 1000 ),        1 );
+    IS( HighResolutionTimer::JitterHistogram::getBucketForDeviation( 3999 ),        2 );
+    IS( HighResolutionTimer::JitterHistogram::getBucketForDeviation( 4000 ),        3 );
+    IS( HighResolutionTimer::JitterHistogram::getBucketForDeviation( -4000 ),       3 );
+    IS( HighResolutionTimer::JitterHistogram::getBucketForDeviation( int64( 1 ) << 50 ), HighResolutionTimer::JitterHistogram::NUM_BUCKETS - 1 );
+    IS( HighResolutionTimer::JitterHistogram::getBucketUpperBoundMicros( 3 ), int64( 8 ) );
+
+    {
+        HighResolutionTimer::JitterHistogram hist;
+        hist.addSample( 500 );
+        hist.addSample( -2500 );
+        hist.addSample( 6000 );
+        hist.addMissedTicks( 2 );
+        IS( hist.getNumSamples(),           int64( 3 ) );
+        IS( hist.getNumMissedTicks(),       int64( 2 ) );
+        IS( hist.getMaxDeviationNanos(),    int64( 6000 ) );
+        IS( hist.getNumSamplesInBucket( 0 ), int64( 1 ) );
+        IS( hist.getNumSamplesInBucket( 2 ), int64( 1 ) );
+        IS( hist.getNumSamplesInBucket( 3 ), int64( 1 ) );
+        IS_EPSILON( hist.getMeanDeviationNanos(), 3000.0 );
+
+        hist.clear();
+        IS( hist.getNumSamples(), int64( 0 ) );
+    }
+
+    OK( "periodic callbacks" );
+    {
+        CountingTimer timer;
+        timer.setJitterMeasurementEnabled( true );
+        OK( !timer.isTimerRunning() );
+
+        timer.startTimer( 1 );
+        OK( timer.isTimerRunning() );
+        IS( timer.getTimerInterval(), 1 );
+
+        Thread::sleep( 300 );
+        timer.stopTimer();
+        OK( !timer.isTimerRunning() );
+
+        const int32 num_calls = timer.num_calls.load();
+        GT( num_calls, 50 );
+        LE( num_calls, 302 );
+
+        HighResolutionTimer::JitterHistogram hist = timer.getJitterHistogram();
+#if TREECORE_OS_LINUX
+        IS( hist.getNumSamples(), int64( num_calls ) );
+
+        int64 bucket_total = 0;
+        for (int i = 0; i < HighResolutionTimer::JitterHistogram::NUM_BUCKETS; i++)
+            bucket_total += hist.getNumSamplesInBucket( i );
+        IS( bucket_total, hist.getNumSamples() );
+
+        printf( "# %d callbacks, mean deviation %.1f us, max %.1f us, %d missed ticks\n",
+                int(num_calls), hist.getMeanDeviationNanos() / 1000.0,
+                hist.getMaxDeviationNanos() / 1000.0, int(hist.getNumMissedTicks()) );
+#endif
+
+        timer.resetJitterHistogram();
+        IS( timer.getJitterHistogram().getNumSamples(), int64( 0 ) );
+
+        Thread::sleep( 20 );
+        IS( timer.num_calls.load(), num_calls );
+    }
+
+    OK( "stop from callback" );
+    {
+        CountingTimer timer;
+        timer.stop_after = 5;
+        timer.startTimer( 1 );
+
+        for (int i = 0; i < 1000 && timer.isTimerRunning(); i++)
+            Thread::sleep( 1 );
+
+        OK( !timer.isTimerRunning() );
+        IS( timer.num_calls.load(), 5 );
+    }
+
+    OK( "realtime priority setting" );
+    {
+        CountingTimer timer;
+        IS( timer.getRealtimePriority(), 0 );
+        timer.setRealtimePriority( 80 );
+        IS( timer.getRealtimePriority(), 80 );
+        timer.setRealtimePriority( -3 );
+        IS( timer.getRealtimePriority(), 0 );
+
+        // may silently fall back to default scheduling without privilege
+        timer.setRealtimePriority( 10 );
+        timer.startTimer( 2 );
+        Thread::sleep( 50 );
+        timer.stopTimer();
+        GT( timer.num_calls.load(), 0 );
+    }
+}
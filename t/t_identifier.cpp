@@ -1,4 +1,5 @@
 #include "treecore/Identifier.h"
+#include "treecore/IdentifierWithIndex.h"
 #include "treecore/StringPool.h"
 
 #include "treecore/TestFramework.h"
@@ -33,4 +34,28 @@ void TestFramework::content( int argc, char** argv )
     OK(foo1.m_name != bar1.m_name);
     OK(foo1.m_name != baz1.m_name);
     OK(bar1.m_name != baz1.m_name);
+
+    // indices are small, unique and stable
+    IS(treecore::Identifier().getIndex(), 0);
+    OK(foo1.getIndex() > 0);
+    IS(foo1.getIndex(), foo2.getIndex());
+    IS(bar1.getIndex(), bar_global.getIndex());
+    OK(foo1.getIndex() != bar1.getIndex());
+    OK(foo1.getIndex() != baz1.getIndex());
+    OK(bar1.getIndex() != baz1.getIndex());
+    OK(baz1.getIndex() <= treecore::StringPool::getInstance()->size());
+
+    treecore::Identifier new_name("a_name_not_used_before");
+    IS(new_name.getIndex(), treecore::StringPool::getInstance()->size());
+
+    // the name is followed by the index
+    const treecore::String item("item");
+    treecore::IdentifierWithIndex indexed(item.getCharPointer(), item.getCharPointer().findTerminatingNull());
+    IS(indexed[0], treecore::Identifier("item0"));
+    IS(indexed[1234567], treecore::Identifier("item1234567"));
+    IS(indexed[0].getIndex(), treecore::Identifier("item0").getIndex());
+
+    const treecore::String long_name = treecore::String::repeatedString("x", 200);
+    treecore::IdentifierWithIndex long_indexed(long_name.getCharPointer(), long_name.getCharPointer().findTerminatingNull());
+    IS(long_indexed[42], treecore::Identifier(long_name + "42"));
 }
@@ -0,0 +1,253 @@
+#include "treecore/DynamicObject.h"
+#include "treecore/IdentifierMap.h"
+#include "treecore/NamedValueSet.h"
+#include "treecore/Variant.h"
+
+#include "treecore/TestFramework.h"
+
+using namespace treecore;
+
+void TestFramework::content( int argc, char** argv )
+{
+    const Identifier foo( "foo" );
+    const Identifier bar( "bar" );
+    const Identifier baz( "baz" );
+
+    // basic operations, without index table
+    {
+        IdentifierMap<int> map;
+        OK( map.isEmpty() );
+        OK( !map.contains( foo ) );
+        OK( map.find( foo ) == nullptr );
+        IS( map.getOrDefault( foo, -1 ), -1 );
+
+        map.set( foo, 1 );
+        map[bar] = 2;
+        IS( map.size(), 2 );
+        IS( map[foo], 1 );
+        IS( *map.find( bar ), 2 );
+        OK( !map.contains( baz ) );
+        OK( !map.contains( Identifier() ) );
+
+        IdentifierMap<int>::Iterator i( map );
+        OK( map.insertOrSelect( baz, 3, i ) );
+        IS( i.key(), baz );
+        IS( i.value(), 3 );
+
+        OK( !map.insertOrSelect( foo, 10, i ) );
+        IS( i.key(), foo );
+        IS( i.value(), 1 );
+        i.value() = 11;
+        IS( map[foo], 11 );
+
+        IdentifierMap<int>::ConstIterator ci( map );
+        OK( map.select( bar, ci ) );
+        IS( ci.value(), 2 );
+
+        OK( map.remove( foo ) );
+        OK( !map.remove( foo ) );
+        IS( map.size(), 2 );
+        OK( !map.contains( foo ) );
+        IS( map[bar], 2 );
+        IS( map[baz], 3 );
+
+        int sum = 0;
+        IdentifierMap<int>::ConstIterator all( map );
+        while ( all.next() )
+            sum += all.value();
+        IS( sum, 5 );
+
+        map.clear();
+        OK( map.isEmpty() );
+    }
+
+    // many entries, with index table
+    {
+        Array<Identifier> keys;
+        for (int i = 0; i < 500; i++)
+            keys.add( Identifier( String( "map_key_" ) + String( i ) ) );
+
+        IdentifierMap<int> map;
+        for (int i = 0; i < keys.size(); i++)
+            map.set( keys[i], i );
+
+        OK( map.m_table.size() > 0 );
+        IS( map.size(), 500 );
+
+        bool all_found = true;
+        for (int i = 0; i < keys.size(); i++)
+            all_found = all_found && map.find( keys[i] ) != nullptr && *map.find( keys[i] ) == i;
+        OK( all_found );
+
+        OK( !map.contains( foo ) );
+        OK( !map.contains( Identifier() ) );
+
+        // identifiers newer than the table
+        const Identifier newer( "map_key_created_later" );
+        OK( !map.contains( newer ) );
+        map.set( newer, -1 );
+        IS( map[newer], -1 );
+
+        // remove every other one, the rest is still found
+        bool all_removed = true;
+        for (int i = 0; i < keys.size(); i += 2)
+            all_removed = all_removed && map.remove( keys[i] );
+        OK( all_removed );
+
+        IS( map.size(), 251 );
+
+        bool rest_found = true;
+        for (int i = 0; i < keys.size(); i++)
+        {
+            const int* value = map.find( keys[i] );
+            rest_found = rest_found && ( i % 2 == 0 ? value == nullptr : (value != nullptr && *value == i) );
+        }
+        OK( rest_found );
+        IS( map[newer], -1 );
+
+        IS( map.getAllKeys().size(), 251 );
+
+        // copies are independent, and compare equal in any order
+        IdentifierMap<int> copy( map );
+        OK( copy == map );
+        copy.remove( newer );
+        OK( copy != map );
+        copy.set( newer, -1 );
+        OK( copy == map );
+        copy.set( newer, -2 );
+        OK( copy != map );
+        IS( map[newer], -1 );
+
+        IdentifierMap<int> moved( std::move( copy ) );
+        IS( moved.size(), 251 );
+        IS( moved[newer], -2 );
+
+        // keys older than the ones that made the table
+        IdentifierMap<int> reversed;
+        for (int i = keys.size() - 1; i >= 0; i--)
+            reversed.set( keys[i], i );
+
+        bool all_found_reversed = reversed.size() == keys.size();
+        for (int i = 0; i < keys.size(); i++)
+            all_found_reversed = all_found_reversed && reversed.getOrDefault( keys[i], -1 ) == i;
+        OK( all_found_reversed );
+        OK( !reversed.contains( foo ) );
+        OK( !reversed.contains( newer ) );
+    }
+
+    // keys with widely spread indices are hashed, and the table stays small
+    {
+        Array<Identifier> created_later;
+        for (int i = 0; i < 20000; i++)
+            created_later.add( Identifier( String( "spread_key_" ) + String( i ) ) );
+
+        IdentifierMap<int> few;
+        few.set( foo, 0 );
+        for (int i = 1; i < 5; i++)
+            few.set( created_later[i * 4999], i );
+
+        IS( few.size(), 5 );
+        OK( few.m_hashed );
+        OK( few.m_table.size() <= 5 * IdentifierMap<int>::MAX_TABLE_SLOTS_PER_ENTRY );
+        IS( few[foo], 0 );
+        IS( few[created_later[4 * 4999]], 4 );
+        OK( !few.contains( bar ) );
+        OK( !few.contains( created_later[1] ) );
+
+        IdentifierMap<int> map;
+        map.set( foo, -1 );
+        for (int i = 0; i < created_later.size(); i += 50)
+            map.set( created_later[i], i );
+
+        IS( map.size(), 401 );
+        OK( map.m_hashed );
+        OK( map.m_table.size() <= map.size() * IdentifierMap<int>::MAX_TABLE_SLOTS_PER_ENTRY );
+
+        bool all_found = map[foo] == -1;
+        for (int i = 0; i < created_later.size(); i++)
+        {
+            const int* value = map.find( created_later[i] );
+            all_found = all_found && ( i % 50 == 0 ? (value != nullptr && *value == i) : value == nullptr );
+        }
+        OK( all_found );
+
+        bool all_removed = true;
+        for (int i = 0; i < created_later.size(); i += 100)
+            all_removed = all_removed && map.remove( created_later[i] );
+        OK( all_removed );
+        IS( map.size(), 201 );
+
+        bool rest_found = map[foo] == -1;
+        for (int i = 0; i < created_later.size(); i += 50)
+        {
+            const int* value = map.find( created_later[i] );
+            rest_found = rest_found && ( i % 100 == 0 ? value == nullptr : (value != nullptr && *value == i) );
+        }
+        OK( rest_found );
+
+        IdentifierMap<int> copy( map );
+        OK( copy == map );
+    }
+
+    // maps that shrink again keep their table, which still has to take new keys
+    {
+        Array<Identifier> keys;
+        for (int i = 0; i < 100; i++)
+            keys.add( Identifier( String( "shrinking_key_" ) + String( i ) ) );
+
+        IdentifierMap<int> map;
+        for (int i = 0; i < keys.size(); i++)
+            map.set( keys[i], i );
+
+        for (int i = 3; i < keys.size(); i++)
+            map.remove( keys[i] );
+
+        IS( map.size(), 3 );
+
+        // too far from the others for the direct table
+        for (int i = 0; i < 5000; i++)
+            Identifier( String( "shrinking_filler_" ) + String( i ) );
+
+        const Identifier late( "shrinking_key_created_later" );
+        map.set( late, -1 );
+        IS( map.size(), 4 );
+        OK( map.contains( late ) );
+        OK( map.find( late ) != nullptr && *map.find( late ) == -1 );
+
+        map.set( late, -2 );
+        IS( map.size(), 4 );
+        IS( map[late], -2 );
+        IS( map[keys[2]], 2 );
+        OK( map.m_hashed );
+    }
+
+    // as storage of properties
+    {
+        NamedValueSet set;
+        OK( set.set( foo, 1 ) );
+        OK( !set.set( foo, 1 ) );
+        OK( set.set( foo, "one" ) );
+        OK( set.set( bar, 2.5 ) );
+        IS( set[foo].toString(), String( "one" ) );
+        IS( double(set[bar]), 2.5 );
+        OK( set[baz].isVoid() );
+        OK( set.getVarPointer( baz ) == nullptr );
+        IS( set.getWithDefault( baz, 3 ), var( 3 ) );
+
+        NamedValueSet other( set );
+        OK( other == set );
+        OK( other.remove( foo ) );
+        OK( other != set );
+        IS( other.size(), 1 );
+
+        DynamicObject::Ptr object = new DynamicObject();
+        for (int i = 0; i < 100; i++)
+            object->setProperty( Identifier( String( "property_" ) + String( i ) ), i );
+
+        OK( object->hasProperty( "property_99" ) );
+        IS( int(object->getProperty( "property_42" )), 42 );
+        object->removeProperty( "property_42" );
+        OK( !object->hasProperty( "property_42" ) );
+        IS( int(object->getProperty( "property_43" )), 43 );
+    }
+}
@@ -1,11 +1,18 @@
+#include "treecore/CpuDispatch.h"
 #include "treecore/DynamicObject.h"
 #include "treecore/JSON.h"
 #include "treecore/MT19937.h"
+#include "treecore/Result.h"
 #include "treecore/StringPool.h"
 #include "treecore/Variant.h"
 
+#include "treecore/internal/JSONScanner.h"
+
 #include "treecore/TestFramework.h"
 
+#include <cstring>
+#include <vector>
+
 using namespace treecore;
 
 String createRandomWideCharString()
@@ -82,6 +89,90 @@ var createRandomVar( int depth )
     }
 }
 
+// structural positions, found one byte at a time
+std::vector<size_t> referenceStructurals( const char* text, size_t numBytes )
+{
+    std::vector<size_t> result;
+    bool inString = false;
+    bool prevScalar = false;
+    size_t numBackslashes = 0;
+
+    for (size_t i = 0; i < numBytes; ++i)
+    {
+        const char c = text[i];
+        const bool escaped = numBackslashes % 2 == 1;
+        numBackslashes = (c == '\\') ? numBackslashes + 1 : 0;
+
+        if (c == '"' && !escaped)
+        {
+            result.push_back( i );
+            inString   = !inString;
+            prevScalar = false;
+        }
+        else if ( inString || JSONScanner::isWhitespace( c ) )
+        {
+            prevScalar = false;
+        }
+        else if ( std::strchr( "{}[]:,", c ) != nullptr )
+        {
+            result.push_back( i );
+            prevScalar = false;
+        }
+        else
+        {
+            if (!prevScalar)
+                result.push_back( i );
+
+            prevScalar = true;
+        }
+    }
+
+    return result;
+}
+
+std::vector<size_t> scannerStructurals( const char* text, size_t numBytes )
+{
+    std::vector<size_t> result;
+    JSONScanner scanner( text, numBytes );
+
+    for (size_t pos = scanner.next( 0 ); pos < numBytes; pos = scanner.next( pos + 1 ))
+        result.push_back( pos );
+
+    return result;
+}
+
+// JSON-like text made of few distinct characters, so that runs of
+// backslashes and quotes cross block boundaries
+String createRandomJSONLikeText( int length )
+{
+    MT19937& r = *MT19937::getInstance();
+    static const char* const pieces[] = { "\\", "\\", "\"", "\"", "{", "}", "[", "]", ":", ",", " ", "\n", "\t",
+                                          "a", "12", "true", "\xc3\xa9", "'", "\x0b", "\x1a" };
+    String result;
+
+    while (result.getNumBytesAsUTF8() < (size_t) length)
+        result += String( CharPointer_UTF8( pieces[r.next_uint64_in_range( numElementsInArray( pieces ) )] ) );
+
+    return result;
+}
+
+// both parsers must give the same result, or the same error
+bool parsersAgree( const String& text )
+{
+    var fast;
+    var slow;
+    const Result fastResult = JSON::parse( text, fast );
+    const Result slowResult = JSONParser::parseObjectOrArray( text.getCharPointer(), slow );
+
+    if ( fastResult.getErrorMessage() != slowResult.getErrorMessage() )
+        return false;
+
+    if ( fastResult.failed() )
+        return true;
+
+    return JSON::toString( fast, true ) == JSON::toString( slow, true );
+}
+
 void TestFramework::content( int argc, char** argv )
 {
     MT19937& r = *MT19937::getInstance();
@@ -113,5 +204,133 @@ void TestFramework::content( int argc, char** argv )
         IS( parsedString, asString );
     }
 
+    OK( "JSONScanner classification kernels" );
+    {
+        std::vector<uint8> data( 64 * 8 );
+
+        for (int i = 0; i < 64 * 8; ++i)
+            data[i] = uint8( i < 256 ? i : r.next_uint64_in_range( 128 ) );
+
+        JsonBlockMasks baseline[8];
+        get_json_kernels_baseline()->classify( data.data(), 8, baseline );
+
+        bool allMatch = true;
+
+        for (int i = 0; i < 64 * 8; ++i)
+        {
+            const JsonBlockMasks& m = baseline[i / 64];
+            const uint64 bit = uint64( 1 ) << (i % 64);
+            const char c = char( data[i] );
+
+            allMatch = allMatch
+                       && ( (m.quote & bit) != 0 ) == (c == '"')
+                       && ( (m.backslash & bit) != 0 ) == (c == '\\')
+                       && ( (m.whitespace & bit) != 0 ) == JSONScanner::isWhitespace( c )
+                       && ( (m.op & bit) != 0 ) == (c != 0 && std::strchr( "{}[]:,", c ) != nullptr);
+        }
+
+        OK( allMatch );
+
+#if TREECORE_CPU_X86
+        if (get_cpu_feature_level() >= CPU_LEVEL_AVX2)
+        {
+            JsonBlockMasks avx2[8];
+            get_json_kernels_avx2()->classify( data.data(), 8, avx2 );
+            OK( std::memcmp( avx2, baseline, sizeof(baseline) ) == 0 );
+        }
+#endif
+    }
+
+    OK( "JSONScanner structural positions" );
+    {
+        for (int length : { 0, 1, 5, 63, 64, 65, 127, 128, 1000, 1024, 1025, 5000 })
+        {
+            for (int i = 0; i < 10; ++i)
+            {
+                const String text = createRandomJSONLikeText( length );
+                const size_t numBytes = text.getNumBytesAsUTF8();
+                OK( referenceStructurals( text.toRawUTF8(), numBytes ) == scannerStructurals( text.toRawUTF8(), numBytes ) );
+            }
+        }
+
+        // positions may be skipped
+        const char* const text = "[ \"a\\\"b\" , 12 ,true ]";
+        JSONScanner scanner( text, std::strlen( text ) );
+        IS( scanner.next( 0 ), size_t( 0 ) );
+        IS( scanner.next( 1 ), size_t( 2 ) );
+        IS( scanner.next( 3 ), size_t( 7 ) );
+        IS( scanner.next( 8 ), size_t( 9 ) );
+        IS( scanner.next( 12 ), size_t( 14 ) );
+        IS( scanner.next( 16 ), size_t( 20 ) );
+        IS( scanner.next( 21 ), std::strlen( text ) );
+    }
+
+    OK( "indexed parsing gives the same results as JSONParser" );
+    {
+        const char* const samples[] = {
+            "",
+            "   ",
+            "{}",
+            " [ ] ",
+            "[1, 2, 3,]",
+            "{\"a\": 1, \"b\": [true, false, null], }",
+            "{\"a\": 1, \"a\": 2}",
+            "[- 5, -7, 1.5e3, -0.25, 12345678901234]",
+            "['single', \"double\"]",
+            "[\"esc\\\"aped\\\\\", \"\\u00e9\\n\\t\\/\", \"caf\xc3\xa9\"]",
+            "[\"bad \xc3 utf8\"]",
+            "[\"\\u12\"]",
+            "{\"\": 1}",
+            "{\"a\" 1}",
+            "{\"a\": 1 \"b\": 2}",
+            "[1 2]",
+            "[tru]",
+            "[truex]",
+            "[1\"a\"]",
+            "[\"unterminated",
+            "[1, 2",
+            "{\"a\":",
+            "x",
+            "[1] trailing garbage",
+            "\t\n[\v1\f,\r2 ]",
+            "[\\\"a\"]",
+        };
+
+        for (const char* sample : samples)
+            OK( parsersAgree( CharPointer_UTF8( sample ) ) );
+
+        IS( JSON::fromString( "  \"text\"" ), var( "text" ) );
+        IS( JSON::fromString( "-12" ), var( -12 ) );
+        IS( JSON::fromString( "'single'" ), var( "single" ) );
+        OK( JSON::fromString( "[1, {\"a\": null}]" ).isArray() );
+        IS( JSON::fromString( "nope" ), var() );
+
+        // long strings with escapes across block boundaries
+        for (int i = 0; i < 50; ++i)
+        {
+            var v;
+            for (int j = int( r.next_uint64_in_range( 10 ) ); --j >= 0; )
+            {
+                String s;
+                for (int k = int( r.next_uint64_in_range( 200 ) ); --k >= 0; )
+                    s += r.next_bool() ? "\\" : (r.next_bool() ? "\"" : "x");
+
+                v.append( s );
+            }
+
+            const String text = JSON::toString( v, r.next_bool() );
+            OK( parsersAgree( text ) );
+        }
+
+        for (int i = 0; i < 100; ++i)
+        {
+            const String text = "[" + JSON::toString( createRandomVar( 0 ), r.next_bool() ) + "]";
+            OK( parsersAgree( text ) );
+        }
+
+        for (int i = 0; i < 200; ++i)
+            OK( parsersAgree( "[" + createRandomJSONLikeText( int( r.next_uint64_in_range( 300 ) ) ) ) );
+    }
+
     StringPool::releaseInstance();
 }
@@ -0,0 +1,124 @@
+#include "treecore/File.h"
+#include "treecore/LocalisedStrings.h"
+#include "treecore/MemoryOutputStream.h"
+#include "treecore/ScopedPointer.h"
+#include "treecore/StringBuilder.h"
+
+#include "treecore/TestFramework.h"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace treecore;
+
+static bool same_translations( const LocalisedStrings& a, const LocalisedStrings& b, int num_keys )
+{
+    for (int i = 0; i < num_keys; i++)
+    {
+        const String key = "key number " + String( i );
+
+        if ( a.translate( key ) != b.translate( key ) )
+            return false;
+    }
+
+    return a.translate( "missing" ) == b.translate( "missing" );
+}
+
+void TestFramework::content( int argc, char** argv )
+{
+    const int num_keys = 5000;
+    StringBuilder text;
+    text << "language: French\ncountries: fr be ch\n\n";
+
+    for (int i = 0; i < num_keys; i++)
+        text << "\"key number " << i << "\" = \"valeur " << i << " \\\"\xc3\xa9t\xc3\xa9\\\"\"\n";
+
+    const LocalisedStrings parsed( text.toString(), false );
+    IS( parsed.translate( "key number 42" ), String( CharPointer_UTF8( "valeur 42 \"\xc3\xa9t\xc3\xa9\"" ) ) );
+    IS( parsed.translate( "missing", "-" ), String( "-" ) );
+    OK( !parsed.isFrozen() );
+
+    // frozen in memory
+    LocalisedStrings frozen( parsed );
+    frozen.freeze();
+    OK( frozen.isFrozen() );
+    OK( same_translations( parsed, frozen, num_keys ) );
+    IS( frozen.translate( "key number", "-" ), String( "-" ) );
+    IS( frozen.getMappings().size(), num_keys );
+
+    // adding strings builds the table again
+    frozen.addStrings( LocalisedStrings( "language: French\ncountries: fr be ch\n\"extra\" = \"en plus\"", false ) );
+    OK( frozen.isFrozen() );
+    IS( frozen.translate( "extra" ), String( "en plus" ) );
+    IS( frozen.translate( "key number 7" ), String( CharPointer_UTF8( "valeur 7 \"\xc3\xa9t\xc3\xa9\"" ) ) );
+
+    // copies of frozen sets share the table
+    {
+        LocalisedStrings copy( frozen );
+        OK( copy.isFrozen() );
+        OK( same_translations( frozen, copy, num_keys ) );
+        IS( copy.getMappings().size(), num_keys + 1 );
+
+        // and the values read from it, which are only copied out once
+        const String value = frozen.translate( "key number 7" );
+        OK( copy.translate( "key number 7" ).getCharPointer().getAddress() == value.getCharPointer().getAddress() );
+
+        LocalisedStrings assigned( String(), false );
+        assigned = frozen;
+        OK( assigned.isFrozen() );
+        IS( assigned.translate( "extra" ), String( "en plus" ) );
+        IS( assigned.getMappings().size(), num_keys + 1 );
+    }
+
+    // the binary form, from memory and from a file
+    {
+        MemoryOutputStream binary;
+        OK( parsed.writeBinaryToStream( binary ) );
+
+        ScopedPointer<LocalisedStrings> loaded( LocalisedStrings::fromBinaryData( binary.getData(), binary.getDataSize() ) );
+        OK( loaded != nullptr );
+        OK( loaded->isFrozen() );
+        IS( loaded->getLanguageName(), String( "French" ) );
+        IS( loaded->getCountryCodes().size(), 3 );
+        OK( same_translations( parsed, *loaded, num_keys ) );
+        IS( loaded->getMappings().size(), num_keys );
+
+        const File file = File::getSpecialLocation( File::tempDirectory ).getNonexistentChildFile( "t_localised_strings", ".bin" );
+        OK( file.replaceWithData( binary.getData(), binary.getDataSize() ) );
+
+        ScopedPointer<LocalisedStrings> mapped( LocalisedStrings::loadBinaryFile( file ) );
+        OK( mapped != nullptr );
+        OK( same_translations( parsed, *mapped, num_keys ) );
+        mapped = nullptr;
+        file.deleteFile();
+
+        // damaged data is refused
+        MemoryBlock damaged( binary.getData(), binary.getDataSize() );
+        damaged[15] = 0x7f;
+        OK( LocalisedStrings::fromBinaryData( damaged.getData(), damaged.getSize() ) == nullptr );
+        OK( LocalisedStrings::fromBinaryData( binary.getData(), 20 ) == nullptr );
+
+        // strings are only checked when they're read, and a damaged one is missing
+        MemoryBlock damaged_value( binary.getData(), binary.getDataSize() );
+        const char* const block = static_cast<const char*>( damaged_value.getData() );
+        const char* const value = "valeur 4999 ";
+        const char* const found = std::search( block, block + damaged_value.getSize(), value, value + strlen( value ) );
+        OK( found != block + damaged_value.getSize() );
+        damaged_value[int( found - block )] = char( 0xff );
+
+        ScopedPointer<LocalisedStrings> partly( LocalisedStrings::fromBinaryData( damaged_value.getData(), damaged_value.getSize() ) );
+        OK( partly != nullptr );
+        IS( partly->translate( "key number 4999", "-" ), String( "-" ) );
+        IS( partly->translate( "key number 4999", "-" ), String( "-" ) );
+        IS( partly->translate( "key number 4998" ), parsed.translate( "key number 4998" ) );
+        IS( partly->getMappings().size(), num_keys - 1 );
+    }
+
+    // empty sets
+    {
+        LocalisedStrings empty( String(), false );
+        empty.freeze();
+        OK( empty.isFrozen() );
+        IS( empty.translate( "anything", "-" ), String( "-" ) );
+    }
+}
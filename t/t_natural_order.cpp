@@ -0,0 +1,257 @@
+#include "treecore/HeapBlock.h"
+#include "treecore/MT19937.h"
+#include "treecore/NaturalOrder.h"
+#include "treecore/StringArray.h"
+#include "treecore/StringTable.h"
+
+#include "treecore/TestFramework.h"
+
+#include <cstring>
+
+using namespace treecore;
+
+static int sign( int n )
+{
+    return n < 0 ? -1 : (n > 0 ? 1 : 0);
+}
+
+static int compare_keys( const char* a, const char* b )
+{
+    HeapBlock<uint8> key_a( natural_sort_key_max_bytes( std::strlen( a ) ) );
+    HeapBlock<uint8> key_b( natural_sort_key_max_bytes( std::strlen( b ) ) );
+    const size_t size_a = make_natural_sort_key( StringSlice( a ), key_a.getData() );
+    const size_t size_b = make_natural_sort_key( StringSlice( b ), key_b.getData() );
+
+    const int result = std::memcmp( key_a.getData(), key_b.getData(), jmin( size_a, size_b ) );
+
+    if (result != 0)
+        return sign( result );
+
+    return size_a < size_b ? -1 : (size_a > size_b ? 1 : 0);
+}
+
+// String::compareNatural() before it moved to NaturalOrder.cpp, to check that
+// the order is still the same
+static int old_compare_right( CharPointer_UTF8 s1, CharPointer_UTF8 s2 )
+{
+    for (int bias = 0;; )
+    {
+        const treecore_wchar c1 = s1.getAndAdvance();
+        const bool isDigit1 = CharacterFunctions::isDigit( c1 );
+
+        const treecore_wchar c2 = s2.getAndAdvance();
+        const bool isDigit2 = CharacterFunctions::isDigit( c2 );
+
+        if ( !(isDigit1 || isDigit2) )   return bias;
+        if (!isDigit1)                 return -1;
+        if (!isDigit2)                 return 1;
+
+        if (c1 != c2 && bias == 0)
+            bias = c1 < c2 ? -1 : 1;
+    }
+}
+
+static int old_compare_left( CharPointer_UTF8 s1, CharPointer_UTF8 s2 )
+{
+    for (;; )
+    {
+        const treecore_wchar c1 = s1.getAndAdvance();
+        const bool isDigit1 = CharacterFunctions::isDigit( c1 );
+
+        const treecore_wchar c2 = s2.getAndAdvance();
+        const bool isDigit2 = CharacterFunctions::isDigit( c2 );
+
+        if ( !(isDigit1 || isDigit2) )   return 0;
+        if (!isDigit1)                 return -1;
+        if (!isDigit2)                 return 1;
+        if (c1 < c2)                    return -1;
+        if (c1 > c2)                    return 1;
+    }
+}
+
+static int old_compare_natural( CharPointer_UTF8 s1, CharPointer_UTF8 s2 )
+{
+    bool firstLoop = true;
+
+    for (;; )
+    {
+        const bool hasSpace1 = s1.isWhitespace();
+        const bool hasSpace2 = s2.isWhitespace();
+
+        if ( (!firstLoop) && (hasSpace1 ^ hasSpace2) )
+            return hasSpace2 ? 1 : -1;
+
+        firstLoop = false;
+
+        if (hasSpace1)  s1 = s1.findEndOfWhitespace();
+        if (hasSpace2)  s2 = s2.findEndOfWhitespace();
+
+        if ( s1.isDigit() && s2.isDigit() )
+        {
+            const int result = (*s1 == '0' || *s2 == '0') ? old_compare_left( s1, s2 )
+                               : old_compare_right( s1, s2 );
+
+            if (result != 0)
+                return result;
+        }
+
+        treecore_wchar c1 = s1.getAndAdvance();
+        treecore_wchar c2 = s2.getAndAdvance();
+
+        if (c1 != c2)
+        {
+            c1 = CharacterFunctions::toUpperCase( c1 );
+            c2 = CharacterFunctions::toUpperCase( c2 );
+        }
+
+        if (c1 == c2)
+        {
+            if (c1 == 0)
+                return 0;
+        }
+        else
+        {
+            const bool isAlphaNum1 = CharacterFunctions::isLetterOrDigit( c1 );
+            const bool isAlphaNum2 = CharacterFunctions::isLetterOrDigit( c2 );
+
+            if (isAlphaNum2 && !isAlphaNum1) return -1;
+            if (isAlphaNum1 && !isAlphaNum2) return 1;
+
+            return c1 < c2 ? -1 : 1;
+        }
+    }
+}
+
+static String random_text( MT19937& r, const String& alphabet, int max_length )
+{
+    const int length = int( r.next_uint64_in_range( uint64( max_length ) ) );
+
+    String result;
+    for (int i = 0; i < length; i++)
+        result += alphabet[int( r.next_uint64_in_range( uint64( alphabet.length() ) ) )];
+
+    return result;
+}
+
+void TestFramework::content( int argc, char** argv )
+{
+    MT19937& r = *MT19937::getInstance();
+
+    // known orders
+    {
+        OK( compare_natural( "file2", "file10" ) < 0 );
+        OK( compare_natural( "file10", "file2" ) > 0 );
+        OK( compare_natural( "File2", "file2" ) == 0 );
+        OK( compare_natural( "abc", "ABD" ) < 0 );
+        OK( compare_natural( "a01", "a1" ) < 0 );
+        OK( compare_natural( "x 1", "x  1" ) == 0 );
+        OK( compare_natural( "  x", "x" ) == 0 );
+        OK( compare_natural( "a_b", "ab" ) < 0 );
+        OK( compare_natural( "a", "a1" ) < 0 );
+        OK( compare_natural( "", "" ) == 0 );
+        OK( compare_natural( "version 1.9", "version 1.10" ) < 0 );
+        IS( String( "image 7.png" ).compareNatural( "image 12.png" ), -1 );
+        IS( String( "image 12.png" ).compareNatural( "IMAGE 12.PNG" ), 0 );
+    }
+
+    // the keys are in the same order as the strings
+    {
+        int num_failed = 0;
+
+        for (int i = 0; i < 20000; i++)
+        {
+            const String alphabet = CharPointer_UTF8( i % 2 == 0 ? "aA0 19_\xc3\xa9" : "a0 9" );
+            const String a = random_text( r, alphabet, 12 );
+            const String b = random_text( r, alphabet, 12 );
+
+            const int result = sign( compare_natural( a.toRawUTF8(), b.toRawUTF8() ) );
+
+            if ( result != compare_keys( a.toRawUTF8(), b.toRawUTF8() ) )
+                num_failed++;
+
+            if ( result != -sign( compare_natural( b.toRawUTF8(), a.toRawUTF8() ) ) )
+                num_failed++;
+        }
+
+        IS( num_failed, 0 );
+    }
+
+    // the same order as before
+    {
+        int num_failed = 0;
+
+        for (int i = 0; i < 50000; i++)
+        {
+            const String alphabet = CharPointer_UTF8( i % 3 == 0 ? "aA0 19_.\t\xc3\xa9\xc3\x89" : (i % 3 == 1 ? "a0 09" : "bB00 1-") );
+            const String prefix = random_text( r, alphabet, i % 4 == 0 ? 20 : 2 );
+            const String a = prefix + random_text( r, alphabet, 10 );
+            const String b = prefix + random_text( r, alphabet, 10 );
+
+            if ( sign( compare_natural( a.toRawUTF8(), b.toRawUTF8() ) )
+                 != old_compare_natural( a.getCharPointer(), b.getCharPointer() ) )
+                num_failed++;
+        }
+
+        IS( num_failed, 0 );
+    }
+
+    // long common prefixes, skipped with vectors, at every position within a
+    // page
+    {
+        HeapBlock<char> page_a( 8192 );
+        HeapBlock<char> page_b( 8192 );
+        int num_failed = 0;
+
+        for (int i = 0; i < 2000; i++)
+        {
+            const String prefix = random_text( r, "ab0 1", 100 );
+            const String a      = prefix + random_text( r, "ab0 1", 5 );
+            const String b      = prefix + random_text( r, "ab0 1", 5 );
+            const size_t size_a = a.getNumBytesAsUTF8() + 1;
+            const size_t size_b = b.getNumBytesAsUTF8() + 1;
+
+            char* text_a = page_a.getData() + 4096 - size_t( r.next_uint64_in_range( 128 ) );
+            char* text_b = page_b.getData() + 4096 - size_t( r.next_uint64_in_range( 128 ) );
+            std::memcpy( text_a, a.toRawUTF8(), size_a );
+            std::memcpy( text_b, b.toRawUTF8(), size_b );
+
+            if ( sign( compare_natural( text_a, text_b ) ) != compare_keys( text_a, text_b ) )
+                num_failed++;
+        }
+
+        IS( num_failed, 0 );
+    }
+
+    // sorting
+    {
+        StringArray names;
+
+        for (int i = 0; i < 3000; i++)
+            names.add( random_text( r, CharPointer_UTF8( "aB0 19_\xc3\xa9" ), 10 ) );
+
+        StringTable table( names );
+        names.sortNatural();
+        table.sortNatural();
+
+        bool sorted = true;
+
+        for (int i = 1; i < names.size(); i++)
+        {
+            if (names[i - 1].compareNatural( names[i] ) > 0)
+                sorted = false;
+        }
+
+        OK( sorted );
+        IS( table.size(), names.size() );
+
+        bool same_order = true;
+
+        for (int i = 0; i < names.size(); i++)
+        {
+            if ( table.getString( i ).compareNatural( names[i] ) != 0 )
+                same_order = false;
+        }
+
+        OK( same_order );
+    }
+}
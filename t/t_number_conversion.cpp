@@ -0,0 +1,311 @@
+#include "treecore/TestFramework.h"
+#include "treecore/JSON.h"
+#include "treecore/MemoryOutputStream.h"
+#include "treecore/MT19937.h"
+#include "treecore/NumberConversion.h"
+#include "treecore/Result.h"
+#include "treecore/StringBuilder.h"
+#include "treecore/Variant.h"
+#include "treecore/XmlElement.h"
+
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+using namespace treecore;
+
+static std::string shortest( double value )
+{
+    char buffer[FORMAT_FLOAT_MAX_CHARS];
+    return std::string( buffer, format_double_shortest( buffer, value ) );
+}
+
+static std::string shortest( float value )
+{
+    char buffer[FORMAT_FLOAT_MAX_CHARS];
+    return std::string( buffer, format_float_shortest( buffer, value ) );
+}
+
+// the significant digits of a formatted number, without leading and trailing zeros
+static std::string significant_digits( const std::string& text )
+{
+    std::string digits;
+
+    for (char c : text)
+    {
+        if (c == 'e')
+            break;
+
+        if (c >= '0' && c <= '9' && !(digits.empty() && c == '0'))
+            digits += c;
+    }
+
+    while (!digits.empty() && digits.back() == '0')
+        digits.pop_back();
+
+    return digits;
+}
+
+// the correctly rounded digits of the fewest that read back as value
+template<typename T>
+static std::string fewest_digits_by_libc( T value )
+{
+    char buffer[64];
+
+    for (int precision = 0;; precision++)
+    {
+        snprintf( buffer, sizeof(buffer), "%.*e", precision, double(value) );
+
+        if (sizeof(T) == sizeof(float) ? T( strtof( buffer, nullptr ) ) == value : T( strtod( buffer, nullptr ) ) == value)
+            return significant_digits( buffer );
+    }
+}
+
+template<typename T>
+static bool same_bits( T a, T b )
+{
+    return std::memcmp( &a, &b, sizeof(T) ) == 0;
+}
+
+template<typename T>
+static bool check_shortest( T value )
+{
+    const std::string text = shortest( value );
+    const T read_back = sizeof(T) == sizeof(float) ? T( strtof( text.c_str(), nullptr ) ) : T( strtod( text.c_str(), nullptr ) );
+
+    if ( !same_bits( read_back, value ) )
+        return false;
+
+    // no longer than needed, and the nearest when as long
+    const std::string digits   = significant_digits( text );
+    const std::string expected = fewest_digits_by_libc( value );
+
+    return digits.size() < expected.size() || digits == expected;
+}
+
+// the exact decimal digits of 5^n
+static std::string pow5_digits( int n )
+{
+    std::string reversed = "1";
+
+    for (int i = 0; i < n; i++)
+    {
+        int carry = 0;
+
+        for (char& c : reversed)
+        {
+            const int d = (c - '0') * 5 + carry;
+            c     = char( '0' + d % 10 );
+            carry = d / 10;
+        }
+
+        if (carry > 0)
+            reversed += char( '0' + carry );
+    }
+
+    return std::string( reversed.rbegin(), reversed.rend() );
+}
+
+static double parse( const char* text )
+{
+    String::CharPointerType t( text );
+    return CharacterFunctions::readDoubleValue( t );
+}
+
+void TestFramework::content( int argc, char** argv )
+{
+    MT19937& r = *MT19937::getInstance();
+
+    // layout
+    {
+        IS( shortest( 0.0 ), std::string( "0" ) );
+        IS( shortest( -0.0 ), std::string( "-0" ) );
+        IS( shortest( 1.0 ), std::string( "1" ) );
+        IS( shortest( -1.5 ), std::string( "-1.5" ) );
+        IS( shortest( 123.456 ), std::string( "123.456" ) );
+        IS( shortest( 0.1 + 0.2 ), std::string( "0.30000000000000004" ) );
+        IS( shortest( 1.0 / 3.0 ), std::string( "0.3333333333333333" ) );
+        IS( shortest( 1.0e20 ), std::string( "100000000000000000000" ) );
+        IS( shortest( 1.0e21 ), std::string( "1e+21" ) );
+        IS( shortest( 1.5e300 ), std::string( "1.5e+300" ) );
+        IS( shortest( 0.000001 ), std::string( "0.000001" ) );
+        IS( shortest( 0.0000015 ), std::string( "0.0000015" ) );
+        IS( shortest( 1.0e-7 ), std::string( "1e-7" ) );
+        IS( shortest( 9007199254740993.0 ), std::string( "9007199254740992" ) );
+        IS( shortest( DBL_MAX ), std::string( "1.7976931348623157e+308" ) );
+        IS( shortest( DBL_MIN ), std::string( "2.2250738585072014e-308" ) );
+        IS( shortest( 4.9406564584124654e-324 ), std::string( "5e-324" ) );
+        IS( shortest( std::numeric_limits<double>::infinity() ), std::string( "inf" ) );
+        IS( shortest( -std::numeric_limits<double>::infinity() ), std::string( "-inf" ) );
+        IS( shortest( std::numeric_limits<double>::quiet_NaN() ), std::string( "nan" ) );
+
+        IS( shortest( 0.1f ), std::string( "0.1" ) );
+        IS( shortest( 1.0f / 3.0f ), std::string( "0.33333334" ) );
+        IS( shortest( 16777216.0f ), std::string( "16777216" ) );
+        IS( shortest( FLT_MAX ), std::string( "3.4028235e+38" ) );
+        IS( shortest( FLT_MIN ), std::string( "1.1754944e-38" ) );
+        IS( shortest( 1.4e-45f ), std::string( "1e-45" ) );
+        IS( shortest( -0.0f ), std::string( "-0" ) );
+    }
+
+    // shortest and nearest, compared with the C library
+    {
+        int num_failed = 0;
+
+        for (int i = 0; i < 20000; i++)
+        {
+            const uint64 bits = r.next_uint64();
+            double value;
+            std::memcpy( &value, &bits, sizeof(value) );
+
+            if ( std::isfinite( value ) && !check_shortest( value ) )
+                num_failed++;
+        }
+
+        for (int e = -1074; e <= 1023; e++)
+        {
+            if ( !check_shortest( std::ldexp( 1.0, e ) ) )
+                num_failed++;
+        }
+
+        for (int i = 0; i < 20000; i++)
+        {
+            const uint32 bits = uint32( r.next_uint64() );
+            float value;
+            std::memcpy( &value, &bits, sizeof(value) );
+
+            if ( std::isfinite( value ) && !check_shortest( value ) )
+                num_failed++;
+        }
+
+        for (int e = -149; e <= 127; e++)
+        {
+            if ( !check_shortest( std::ldexp( 1.0f, e ) ) )
+                num_failed++;
+        }
+
+        IS( num_failed, 0 );
+    }
+
+    // parsing, compared with the C library
+    {
+        int num_failed = 0;
+
+        for (int i = 0; i < 20000; i++)
+        {
+            const int num_digits = 1 + int( r.next_uint64_in_range( i % 2 == 0 ? 19 : 40 ) );
+            const int exponent   = int( r.next_uint64_in_range( 700 ) ) - 360;
+
+            char digits[64];
+            for (int j = 0; j < num_digits; j++)
+                digits[j] = char( '0' + r.next_uint64_in_range( 10 ) );
+
+            char text[96];
+            snprintf( text, sizeof(text), "%.*se%d", num_digits, digits, exponent );
+
+            if ( !same_bits( decimal_to_double( digits, size_t( num_digits ), exponent, false ), strtod( text, nullptr ) ) )
+                num_failed++;
+
+            if ( !same_bits( decimal_to_float( digits, size_t( num_digits ), exponent / 8, false ), strtof( ( std::string( text, size_t( num_digits ) ) + "e" + std::to_string( exponent / 8 ) ).c_str(), nullptr ) ) )
+                num_failed++;
+
+            if ( !same_bits( parse( text ), strtod( text, nullptr ) ) )
+                num_failed++;
+        }
+
+        IS( num_failed, 0 );
+    }
+
+    // halfway cases, which are decided by digits far beyond the 19th
+    {
+        // the smallest subnormal halved, ties to even zero
+        const std::string half_min = pow5_digits( 1075 );
+        IS( decimal_to_double( half_min.data(), half_min.size(), -1075, false ), 0.0 );
+        IS( parse( ( "0." + std::string( 323, '0' ) + half_min ).c_str() ), 0.0 );
+
+        const std::string above = half_min + std::string( 100, '0' ) + "1";
+        IS( decimal_to_double( above.data(), above.size(), -1075 - 101, false ), 4.9406564584124654e-324 );
+        IS( parse( ( "0." + std::string( 323, '0' ) + above ).c_str() ), 4.9406564584124654e-324 );
+
+        // halfway between 1 and the next double
+        IS( parse( "1.00000000000000011102230246251565404236316680908203125" ), 1.0 );
+        IS( parse( "1.000000000000000111022302462515654042363166809082031250000001" ), 1.0000000000000002 );
+        IS( parse( "9007199254740993" ), 9007199254740992.0 );
+        IS( parse( "9007199254740995" ), 9007199254740996.0 );
+        IS( decimal_to_float( "16777217", 8, 0, false ), 16777216.0f );
+        IS( decimal_to_float( "167772170000000000000000001", 27, -19, false ), 16777218.0f );
+    }
+
+    // readDoubleValue
+    {
+        String::CharPointerType t( "  -1.5e3xyz" );
+        IS( CharacterFunctions::readDoubleValue( t ), -1500.0 );
+        IS( *t, treecore_wchar( 'x' ) );
+
+        IS( parse( ".5" ), 0.5 );
+        IS( parse( "5." ), 5.0 );
+        IS( parse( "+0.000125" ), 0.000125 );
+        IS( parse( "-0" ), 0.0 );
+        OK( std::signbit( parse( "-0" ) ) );
+        IS( parse( "1e400" ), std::numeric_limits<double>::infinity() );
+        IS( parse( "1e-400" ), 0.0 );
+        IS( parse( "1e99999999999999999999" ), std::numeric_limits<double>::infinity() );
+        IS( parse( "0.0000000000000000000000000000000000001e37" ), 1.0 );
+        IS( parse( "-inf" ), -std::numeric_limits<double>::infinity() );
+        OK( std::isnan( parse( "nan" ) ) );
+        IS( parse( "abc" ), 0.0 );
+        IS( String( "2.2250738585072011e-308" ).getDoubleValue(), 2.2250738585072009e-308 );
+    }
+
+    // users
+    {
+        IS( String( 0.1 ), String( "0.1" ) );
+        IS( String( 0.1f ), String( "0.1" ) );
+        IS( String( 1.0e-7 ), String( "1e-7" ) );
+        IS( String( 2.5, 3 ), String( "2.500" ) );
+
+        int num_failed = 0;
+
+        for (int i = 0; i < 1000; i++)
+        {
+            const double value = (r.next_double_yy() - 0.5) * std::pow( 10.0, double(int( r.next_uint64_in_range( 40 ) ) - 20) );
+
+            if ( String( value ).getDoubleValue() != value )
+                num_failed++;
+
+            if ( String( float(value) ).getFloatValue() != float(value) )
+                num_failed++;
+        }
+
+        IS( num_failed, 0 );
+
+        IS( String( std::numeric_limits<int64>::min() ), String( "-9223372036854775808" ) );
+        IS( String( std::numeric_limits<uint64>::max() ), String( "18446744073709551615" ) );
+        IS( String( 9 ), String( "9" ) );
+        IS( String( 10 ), String( "10" ) );
+        IS( String( -100 ), String( "-100" ) );
+        IS( String( 1234567 ), String( "1234567" ) );
+
+        StringBuilder builder;
+        builder << 0.25 << ' ' << 0.1f;
+        IS( builder.toString(), String( "0.25 0.1" ) );
+
+        MemoryOutputStream out;
+        out << 1.0e100;
+        IS( out.toString(), String( "1e+100" ) );
+
+        var parsed;
+        OK( JSON::parse( "[0.1, 12345678901234567890, 1e-5]", parsed ).wasOk() );
+        OK( parsed[1].isDouble() );
+        IS( double(parsed[1]), 12345678901234567890.0 );
+        IS( JSON::toString( parsed, true ), String( "[0.1, 12345678901234567000, 0.00001]" ) );
+
+        XmlElement element( "e" );
+        element.setAttribute( "x", 0.1 );
+        IS( element.getStringAttribute( "x" ), String( "0.1" ) );
+        IS( element.getDoubleAttribute( "x" ), 0.1 );
+    }
+}
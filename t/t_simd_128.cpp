@@ -741,4 +741,270 @@ void TestFramework::content( int argc, char** argv )
         simd_set_all<double>( b, 1.3, 123.4567 );
         OK( !simd_equal<double>( a, b ) );
     }
+
+    OK( "min and max" );
+    {
+        SIMDType<16> a, b, c;
+        simd_set_all<float>( a, 1.0f, -2.0f, 3.0f, -4.0f );
+        simd_set_all<float>( b, 0.5f, -1.0f, 4.0f, -8.0f );
+        simd_min<float>( c, a, b );
+        IS( c.values_by_float[0], 0.5f );
+        IS( c.values_by_float[1], -2.0f );
+        IS( c.values_by_float[2], 3.0f );
+        IS( c.values_by_float[3], -8.0f );
+        simd_max<float>( c, a, b );
+        IS( c.values_by_float[0], 1.0f );
+        IS( c.values_by_float[1], -1.0f );
+        IS( c.values_by_float[2], 4.0f );
+        IS( c.values_by_float[3], -4.0f );
+
+        simd_set_all<double>( a, 1.5, -2.5 );
+        simd_set_all<double>( b, 2.5, -3.5 );
+        simd_min<double>( c, a, b );
+        IS( c.values_by_double[0], 1.5 );
+        IS( c.values_by_double[1], -3.5 );
+        simd_max<double>( c, a, b );
+        IS( c.values_by_double[0], 2.5 );
+        IS( c.values_by_double[1], -2.5 );
+
+        simd_set_all<int32>( a, 1, -2, std::numeric_limits<int32>::max(), std::numeric_limits<int32>::min() );
+        simd_set_all<int32>( b, -1, 2, 0, 0 );
+        simd_min<int32>( c, a, b );
+        IS( c.values_by_i32[0], -1 );
+        IS( c.values_by_i32[1], -2 );
+        IS( c.values_by_i32[2], 0 );
+        IS( c.values_by_i32[3], std::numeric_limits<int32>::min() );
+        simd_max<int32>( c, a, b );
+        IS( c.values_by_i32[0], 1 );
+        IS( c.values_by_i32[1], 2 );
+        IS( c.values_by_i32[2], std::numeric_limits<int32>::max() );
+        IS( c.values_by_i32[3], 0 );
+
+        simd_set_all<int16>( a, 1, -2, 3, -4, 5, -6, 7, -8 );
+        simd_broadcast<int32>( b, 0 );
+        simd_min<int16>( c, a, b );
+        IS( c.values_by_i16[0], int16( 0 ) );
+        IS( c.values_by_i16[7], int16( -8 ) );
+        simd_max<int16>( c, a, b );
+        IS( c.values_by_i16[1], int16( 0 ) );
+        IS( c.values_by_i16[6], int16( 7 ) );
+
+        simd_set_all<int8>( a, 1, -2, 3, -4, 5, -6, 7, -8, 9, -10, 11, -12, 13, -14, 127, -128 );
+        simd_min<int8>( c, a, b );
+        IS( c.values_by_i8[0], int8( 0 ) );
+        IS( c.values_by_i8[15], int8( -128 ) );
+        simd_max<int8>( c, a, b );
+        IS( c.values_by_i8[14], int8( 127 ) );
+        IS( c.values_by_i8[15], int8( 0 ) );
+
+        // as unsigned bytes, -128 is 128 and larger than 127
+        simd_min<uint8>( c, a, b );
+        IS( c.values_by_i8[1], int8( 0 ) );
+        simd_max<uint8>( c, a, b );
+        IS( c.values_by_i8[1], int8( -2 ) );
+        IS( c.values_by_i8[15], int8( -128 ) );
+
+        // no instruction for this one, use scalar implementation
+        simd_set_all<int64>( a, 5, -5 );
+        simd_set_all<int64>( b, -7, 7 );
+        simd_min<int64>( c, a, b );
+        IS( c.values_by_i64[0], int64( -7 ) );
+        IS( c.values_by_i64[1], int64( -5 ) );
+        simd_max<int64>( c, a, b );
+        IS( c.values_by_i64[0], int64( 5 ) );
+        IS( c.values_by_i64[1], int64( 7 ) );
+    }
+
+    OK( "abs" );
+    {
+        SIMDType<16> a, c;
+        simd_set_all<float>( a, -1.5f, 2.5f, -0.0f, -std::numeric_limits<float>::infinity() );
+        simd_abs<float>( c, a );
+        IS( c.values_by_float[0], 1.5f );
+        IS( c.values_by_float[1], 2.5f );
+        IS( c.values_by_i32[2], 0 );
+        IS( c.values_by_float[3], std::numeric_limits<float>::infinity() );
+
+        simd_set_all<double>( a, -1.5, 2.5 );
+        simd_abs<double>( c, a );
+        IS( c.values_by_double[0], 1.5 );
+        IS( c.values_by_double[1], 2.5 );
+
+        simd_set_all<int32>( a, -1, 2, -2147483647, 0 );
+        simd_abs<int32>( c, a );
+        IS( c.values_by_i32[0], 1 );
+        IS( c.values_by_i32[1], 2 );
+        IS( c.values_by_i32[2], 2147483647 );
+        IS( c.values_by_i32[3], 0 );
+
+        simd_set_all<int16>( a, -1, 2, -3, 4, -5, 6, -32767, 0 );
+        simd_abs<int16>( c, a );
+        IS( c.values_by_i16[0], int16( 1 ) );
+        IS( c.values_by_i16[4], int16( 5 ) );
+        IS( c.values_by_i16[6], int16( 32767 ) );
+
+        simd_set_all<int8>( a, -1, 2, -3, 4, -5, 6, -7, 8, -9, 10, -11, 12, -13, 14, -127, 0 );
+        simd_abs<int8>( c, a );
+        IS( c.values_by_i8[0], int8( 1 ) );
+        IS( c.values_by_i8[8], int8( 9 ) );
+        IS( c.values_by_i8[14], int8( 127 ) );
+    }
+
+    OK( "sqrt and rsqrt" );
+    {
+        SIMDType<16> a, c;
+        simd_set_all<float>( a, 4.0f, 9.0f, 0.25f, 100.0f );
+        simd_sqrt<float>( c, a );
+        IS( c.values_by_float[0], 2.0f );
+        IS( c.values_by_float[1], 3.0f );
+        IS( c.values_by_float[2], 0.5f );
+        IS( c.values_by_float[3], 10.0f );
+
+        simd_rsqrt<float>( c, a );
+        OK( std::abs( c.values_by_float[0] - 0.5f ) < 0.5f / 1024 );
+        OK( std::abs( c.values_by_float[1] - 1.0f / 3.0f ) < (1.0f / 3.0f) / 1024 );
+        OK( std::abs( c.values_by_float[2] - 2.0f ) < 2.0f / 1024 );
+        OK( std::abs( c.values_by_float[3] - 0.1f ) < 0.1f / 1024 );
+
+        simd_set_all<double>( a, 16.0, 0.0625 );
+        simd_sqrt<double>( c, a );
+        IS( c.values_by_double[0], 4.0 );
+        IS( c.values_by_double[1], 0.25 );
+        simd_rsqrt<double>( c, a );
+        IS( c.values_by_double[0], 0.25 );
+        IS( c.values_by_double[1], 4.0 );
+    }
+
+    OK( "mul_add" );
+    {
+        SIMDType<16> a, b, c, d;
+        simd_set_all<float>( a, 1.0f, 2.0f, 3.0f, 4.0f );
+        simd_set_all<float>( b, 0.5f, -1.0f, 2.0f, 0.0f );
+        simd_set_all<float>( c, 10.0f, 20.0f, 30.0f, 40.0f );
+        simd_mul_add<float>( d, a, b, c );
+        IS( d.values_by_float[0], 10.5f );
+        IS( d.values_by_float[1], 18.0f );
+        IS( d.values_by_float[2], 36.0f );
+        IS( d.values_by_float[3], 40.0f );
+
+        simd_set_all<double>( a, 1.5, -2.0 );
+        simd_set_all<double>( b, 2.0, 3.0 );
+        simd_set_all<double>( c, 0.25, 1.0 );
+        simd_mul_add<double>( d, a, b, c );
+        IS( d.values_by_double[0], 3.25 );
+        IS( d.values_by_double[1], -5.0 );
+    }
+
+    OK( "select by mask" );
+    {
+        SIMDType<16> a, b, mask, c;
+        simd_set_all<float>( a, 1.0f, 2.0f, 3.0f, 4.0f );
+        simd_set_all<float>( b, -1.0f, -2.0f, -3.0f, -4.0f );
+        simd_set_all<int32>( mask, -1, 0, 0, -1 );
+        simd_select<float>( c, mask, a, b );
+        IS( c.values_by_float[0], 1.0f );
+        IS( c.values_by_float[1], -2.0f );
+        IS( c.values_by_float[2], -3.0f );
+        IS( c.values_by_float[3], 4.0f );
+
+        // typical use: clamp negative values to zero
+        SIMDType<16> zero;
+        simd_broadcast<int32>( zero, 0 );
+        simd_set_all<int32>( a, 5, -6, 7, -8 );
+        simd_lt<int32>( mask, a, zero );
+        simd_select<int32>( c, mask, zero, a );
+        IS( c.values_by_i32[0], 5 );
+        IS( c.values_by_i32[1], 0 );
+        IS( c.values_by_i32[2], 7 );
+        IS( c.values_by_i32[3], 0 );
+
+        simd_set_all<int16>( a, 1, 2, 3, 4, 5, 6, 7, 8 );
+        simd_set_all<int16>( mask, -1, 0, -1, 0, -1, 0, -1, 0 );
+        simd_select<int16>( c, mask, a, zero );
+        IS( c.values_by_i16[0], int16( 1 ) );
+        IS( c.values_by_i16[1], int16( 0 ) );
+        IS( c.values_by_i16[6], int16( 7 ) );
+        IS( c.values_by_i16[7], int16( 0 ) );
+    }
+
+    OK( "movemask" );
+    {
+        SIMDType<16> a, b, mask;
+        simd_set_all<float>( a, 1.0f, 5.0f, 3.0f, 7.0f );
+        simd_broadcast<float>( b, 4.0f );
+        simd_gt<float>( mask, a, b );
+        IS( simd_movemask<float>( mask ), uint64( 0xa ) );
+        IS( simd_movemask<int32>( mask ), uint64( 0xa ) );
+        IS( simd_movemask<int64>( mask ), uint64( 0x3 ) );
+
+        simd_set_all<int8>( a, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 );
+        simd_set_all<int8>( b, 0, 0, 2, 0, 4, 0, 6, 0, 8, 0, 10, 0, 12, 0, 14, 0 );
+        simd_cmp<int8>( mask, a, b );
+        IS( simd_movemask<int8>( mask ), uint64( 0x5555 ) );
+
+        simd_set_all<int16>( a, -1, 1, -1, 1, 1, 1, 1, -1 );
+        IS( simd_movemask<int16>( a ), uint64( 0x85 ) );
+
+        simd_set_all<double>( a, -1.0, 1.0 );
+        IS( simd_movemask<double>( a ), uint64( 0x1 ) );
+    }
+
+    OK( "partial load and store" );
+    {
+        const float src[4] = { 1.0f, 2.0f, 3.0f, 4.0f };
+        for (int count = 0; count <= 4; count++)
+        {
+            SIMDType<16> a;
+            simd_broadcast<float>( a, -1.0f );
+            simd_load_partial<float>( a, src, count );
+            for (int i = 0; i < 4; i++)
+                IS( a.values_by_float[i], i < count ? src[i] : 0.0f );
+
+            float dst[5] = { 9.0f, 9.0f, 9.0f, 9.0f, 9.0f };
+            simd_store_partial<float>( a, dst, count );
+            for (int i = 0; i < 5; i++)
+                IS( dst[i], i < count ? src[i] : 9.0f );
+        }
+
+        const int16 src16[3] = { 7, 8, 9 };
+        SIMDType<16> a;
+        simd_load_partial<int16>( a, src16, 3 );
+        IS( a.values_by_i16[2], int16( 9 ) );
+        IS( a.values_by_i16[3], int16( 0 ) );
+        IS( a.values_by_i64[1], int64( 0 ) );
+    }
+
+    OK( "gather" );
+    {
+        const float table[10] = { 0.0f, 10.0f, 20.0f, 30.0f, 40.0f, 50.0f, 60.0f, 70.0f, 80.0f, 90.0f };
+        SIMDType<16> idx, c;
+        simd_set_all<int32>( idx, 9, 0, 4, 4 );
+        simd_gather<float>( c, table, idx );
+        IS( c.values_by_float[0], 90.0f );
+        IS( c.values_by_float[1], 0.0f );
+        IS( c.values_by_float[2], 40.0f );
+        IS( c.values_by_float[3], 40.0f );
+
+        const double table_d[4] = { 0.5, 1.5, 2.5, 3.5 };
+        simd_set_all<int32>( idx, 3, 1, 0, 0 );
+        simd_gather<double>( c, table_d, idx );
+        IS( c.values_by_double[0], 3.5 );
+        IS( c.values_by_double[1], 1.5 );
+    }
+
+    OK( "horizontal min and max" );
+    {
+        SIMDType<16> a;
+        simd_set_all<float>( a, 3.0f, -1.0f, 8.0f, 2.0f );
+        IS( simd_reduce_min<float>( a ), -1.0f );
+        IS( simd_reduce_max<float>( a ), 8.0f );
+
+        simd_set_all<int32>( a, 3, -100, 8, 200 );
+        IS( simd_reduce_min<int32>( a ), -100 );
+        IS( simd_reduce_max<int32>( a ), 200 );
+
+        simd_set_all<int16>( a, 3, -100, 8, 200, 5, 6, -300, 7 );
+        IS( simd_reduce_min<int16>( a ), int16( -300 ) );
+        IS( simd_reduce_max<int16>( a ), int16( 200 ) );
+    }
 }
@@ -0,0 +1,447 @@
+#include "treecore/TestFramework.h"
+#include "treecore/SimdObject.h"
+
+#include <limits>
+
+using namespace treecore;
+
+void TestFramework::content( int argc, char** argv )
+{
+    {
+        OK( "set by values" );
+        SIMDType<32> a;
+        simd_set_all<float, 32>( a, 1, 2, 3, 4, 5, 6, 7, 8 );
+        for (int i = 0; i < 8; i++)
+            IS( a.values_by_float[i], float( i + 1 ) );
+
+        simd_set_all<int64, 32>( a, 1234567898765432, -2, 3, -4567891234567654 );
+        IS( a.values_by_i64[0], int64( 1234567898765432 ) );
+        IS( a.values_by_i64[1], int64( -2 ) );
+        IS( a.values_by_i64[2], int64( 3 ) );
+        IS( a.values_by_i64[3], int64( -4567891234567654 ) );
+
+        simd_set_all<double, 32>( a, 1.5, 2.5, 3.5, 4.5 );
+        IS( (simd_get_one<0, double>( a )), 1.5 );
+        IS( (simd_get_one<3, double>( a )), 4.5 );
+
+        simd_set_one<5, int32>( a, 42 );
+        IS( a.values_by_i32[5], 42 );
+    }
+
+    {
+        OK( "set all to same value" );
+        SIMDType<32> value;
+
+        simd_broadcast<int8>( value, int8( 7 ) );
+        for (int i = 0; i < 32; i++)
+            IS( value.values_by_i8[i], int8( 7 ) );
+
+        simd_broadcast<int32>( value, 42 );
+        for (int i = 0; i < 8; i++)
+            IS( value.values_by_i32[i], 42 );
+
+        simd_broadcast<double>( value, 56.78 );
+        for (int i = 0; i < 4; i++)
+            IS( value.values_by_double[i], 56.78 );
+    }
+
+    {
+        OK( "set and get using pointer" );
+        SIMDType<32> value;
+
+        int32 data_i[8] = {100, 120, 246, 451, -1, -2, -3, -4};
+        simd_set_all<int32>( value, data_i );
+        for (int i = 0; i < 8; i++)
+            IS( value.values_by_i32[i], data_i[i] );
+
+        float data_f[8];
+        simd_set_all<float, 32>( value, 1, 2, 3, 4, 5, 6, 7, 8 );
+        simd_get_all<float>( value, data_f );
+        for (int i = 0; i < 8; i++)
+            IS( data_f[i], float( i + 1 ) );
+    }
+
+    {
+        OK( "integer arithmetic" );
+        SIMDType<32> a, b, c;
+        simd_set_all<int32, 32>( a, 1, 2, 3, 4, 5, 6, 7, 8 );
+        simd_set_all<int32, 32>( b, 10, 20, 30, 40, 50, 60, 70, 80 );
+
+        simd_add<int32>( c, a, b );
+        for (int i = 0; i < 8; i++)
+            IS( c.values_by_i32[i], (i + 1) * 11 );
+
+        simd_sub<int32>( c, a, b );
+        for (int i = 0; i < 8; i++)
+            IS( c.values_by_i32[i], -(i + 1) * 9 );
+
+        simd_mul<int32>( c, a, b );
+        for (int i = 0; i < 8; i++)
+            IS( c.values_by_i32[i], (i + 1) * (i + 1) * 10 );
+
+        simd_broadcast<int16>( a, int16( 300 ) );
+        simd_broadcast<int16>( b, int16( -3 ) );
+        simd_mul<int16>( c, a, b );
+        for (int i = 0; i < 16; i++)
+            IS( c.values_by_i16[i], int16( -900 ) );
+    }
+
+    {
+        OK( "double arithmetic" );
+        SIMDType<32> a, b, c;
+        simd_set_all<double, 32>( a, 1.0, 2.0, 3.0, 4.0 );
+        simd_broadcast<double>( b, 0.5 );
+
+        simd_add<double>( c, a, b );
+        IS( c.values_by_double[3], 4.5 );
+        simd_mul<double>( c, a, b );
+        IS( c.values_by_double[2], 1.5 );
+        simd_div<double>( c, a, b );
+        IS( c.values_by_double[1], 4.0 );
+        IS( simd_sum<double>( a ), 10.0 );
+    }
+
+    {
+        OK( "convert" );
+        SIMDType<32> a, b;
+        simd_set_all<float, 32>( a, 1.5f, -2.5f, 3.9f, 4.0f, 5.1f, 6.0f, 7.0f, -8.7f );
+        simd_convert<int32, float>( b, a );
+        IS( b.values_by_i32[0], 1 );
+        IS( b.values_by_i32[1], -2 );
+        IS( b.values_by_i32[2], 3 );
+        IS( b.values_by_i32[7], -8 );
+
+        simd_convert<double, float>( b, a );
+        IS( b.values_by_double[0], 1.5 );
+        IS( b.values_by_double[3], 4.0 );
+
+        simd_convert<float, double>( a, b );
+        IS( a.values_by_float[0], 1.5f );
+        IS( a.values_by_float[1], -2.5f );
+        IS( a.values_by_float[4], 0.0f );
+        IS( a.values_by_float[7], 0.0f );
+    }
+
+    {
+        OK( "shift" );
+        SIMDType<32> a, b;
+        simd_broadcast<int32>( a, -256 );
+        simd_shift_left<int32>( b, a, 4 );
+        IS( b.values_by_i32[7], -4096 );
+        simd_shift_right_sign<int32>( b, a, 4 );
+        IS( b.values_by_i32[0], -16 );
+        simd_shift_right_zero<int32>( b, a, 28 );
+        IS( b.values_by_i32[3], 15 );
+    }
+
+    {
+        OK( "shift bytes across 128-bit lanes" );
+        SIMDType<32> a, b;
+        for (int i = 0; i < 32; i++)
+            a.values_by_i8[i] = int8( i + 1 );
+
+        simd_shift_byte_left<5>( b, a );
+        for (int i = 0; i < 32; i++)
+            IS( b.values_by_i8[i], int8( i < 5 ? 0 : i - 4 ) );
+
+        simd_shift_byte_left<20>( b, a );
+        for (int i = 0; i < 32; i++)
+            IS( b.values_by_i8[i], int8( i < 20 ? 0 : i - 19 ) );
+
+        simd_shift_byte_right<3>( b, a );
+        for (int i = 0; i < 32; i++)
+            IS( b.values_by_i8[i], int8( i + 3 < 32 ? i + 4 : 0 ) );
+
+        simd_shift_byte_right<16>( b, a );
+        for (int i = 0; i < 32; i++)
+            IS( b.values_by_i8[i], int8( i < 16 ? i + 17 : 0 ) );
+
+        simd_shift_byte_right<32>( b, a );
+        for (int i = 0; i < 32; i++)
+            IS( b.values_by_i8[i], int8( 0 ) );
+    }
+
+    {
+        OK( "integer comparison" );
+        SIMDType<32> a, b, c;
+        simd_set_all<int64, 32>( a, 1, 5, -3, 7 );
+        simd_set_all<int64, 32>( b, 1, 4, -2, 8 );
+
+        simd_gt<int64>( c, a, b );
+        IS( c.values_by_i64[0], int64( 0 ) );
+        IS( c.values_by_i64[1], int64( -1 ) );
+        IS( c.values_by_i64[2], int64( 0 ) );
+        IS( c.values_by_i64[3], int64( 0 ) );
+
+        simd_le<int64>( c, a, b );
+        IS( c.values_by_i64[0], int64( -1 ) );
+        IS( c.values_by_i64[1], int64( 0 ) );
+        IS( c.values_by_i64[2], int64( -1 ) );
+        IS( c.values_by_i64[3], int64( -1 ) );
+
+        OK( simd_equal<int64>( a, a ) );
+        OK( !simd_equal<int64>( a, b ) );
+    }
+
+    {
+        OK( "shuffle works inside each 128-bit lane" );
+        SIMDType<32> c;
+        simd_set_all<int32, 32>( c, 0, 1, 2, 3, 4, 5, 6, 7 );
+        simd_shuffle<3, 2, 1, 0>( c );
+        IS( c.values_by_i32[0], 3 );
+        IS( c.values_by_i32[3], 0 );
+        IS( c.values_by_i32[4], 7 );
+        IS( c.values_by_i32[7], 4 );
+    }
+
+    {
+        OK( "SimdObject" );
+        simd8f zero;
+        for (int i = 0; i < 8; i++)
+            IS( zero.data.values_by_float[i], 0.0f );
+
+        simd8f a( 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f );
+        simd8f b( 0.5f );
+        simd8f c = a * b + a;
+        IS( c.get<0>(), 1.5f );
+        IS( c.get<7>(), 12.0f );
+        IS( c.sum(), 54.0f );
+
+        simd8i mask = (a > simd8f( 4.0f ));
+        IS( mask.get<3>(), int32( 0 ) );
+        IS( mask.get<4>(), int32( -1 ) );
+
+        simd8f masked = a & mask;
+        IS( masked.get<0>(), 0.0f );
+        IS( masked.get<5>(), 6.0f );
+
+        simd8i ints = a.convert_to<int32>();
+        IS( ints.sum(), 36 );
+    }
+
+    {
+        OK( "min and max" );
+        SIMDType<32> a, b, c;
+        for (int i = 0; i < 8; i++)
+        {
+            a.values_by_float[i] = float( i ) - 4.0f;
+            b.values_by_float[i] = 4.0f - float( i );
+        }
+        simd_min<float>( c, a, b );
+        for (int i = 0; i < 8; i++)
+            IS( c.values_by_float[i], -std::abs( float( i ) - 4.0f ) );
+        simd_max<float>( c, a, b );
+        for (int i = 0; i < 8; i++)
+            IS( c.values_by_float[i], std::abs( float( i ) - 4.0f ) );
+
+        for (int i = 0; i < 8; i++)
+        {
+            a.values_by_i32[i] = i * 1000 - 5000;
+            b.values_by_i32[i] = 0;
+        }
+        simd_min<int32>( c, a, b );
+        for (int i = 0; i < 8; i++)
+            IS( c.values_by_i32[i], i * 1000 - 5000 < 0 ? i * 1000 - 5000 : 0 );
+        simd_max<int32>( c, a, b );
+        for (int i = 0; i < 8; i++)
+            IS( c.values_by_i32[i], i * 1000 - 5000 > 0 ? i * 1000 - 5000 : 0 );
+
+        for (int i = 0; i < 32; i++)
+            a.values_by_i8[i] = int8( i * 7 );
+        simd_broadcast<int32>( b, 0 );
+        simd_min<int8>( c, a, b );
+        for (int i = 0; i < 32; i++)
+            IS( c.values_by_i8[i], int8( i * 7 ) < 0 ? int8( i * 7 ) : int8( 0 ) );
+        simd_max<uint8>( c, a, b );
+        for (int i = 0; i < 32; i++)
+            IS( c.values_by_i8[i], int8( i * 7 ) );
+
+        for (int i = 0; i < 16; i++)
+            a.values_by_i16[i] = int16( i * 3001 );
+        simd_max<int16>( c, a, b );
+        for (int i = 0; i < 16; i++)
+            IS( c.values_by_i16[i], int16( i * 3001 ) > 0 ? int16( i * 3001 ) : int16( 0 ) );
+
+        for (int i = 0; i < 4; i++)
+        {
+            a.values_by_double[i] = double( i ) * 1.5;
+            b.values_by_double[i] = 2.0;
+        }
+        simd_min<double>( c, a, b );
+        for (int i = 0; i < 4; i++)
+            IS( c.values_by_double[i], double( i ) * 1.5 < 2.0 ? double( i ) * 1.5 : 2.0 );
+    }
+
+    {
+        OK( "abs" );
+        SIMDType<32> a, c;
+        for (int i = 0; i < 8; i++)
+            a.values_by_float[i] = (i % 2) ? -float( i ) : float( i );
+        simd_abs<float>( c, a );
+        for (int i = 0; i < 8; i++)
+            IS( c.values_by_float[i], float( i ) );
+
+        for (int i = 0; i < 8; i++)
+            a.values_by_i32[i] = (i % 2) ? -i * 100 : i * 100;
+        simd_abs<int32>( c, a );
+        for (int i = 0; i < 8; i++)
+            IS( c.values_by_i32[i], i * 100 );
+
+        for (int i = 0; i < 16; i++)
+            a.values_by_i16[i] = int16( -i );
+        simd_abs<int16>( c, a );
+        for (int i = 0; i < 16; i++)
+            IS( c.values_by_i16[i], int16( i ) );
+
+        for (int i = 0; i < 4; i++)
+            a.values_by_double[i] = -0.5 * i;
+        simd_abs<double>( c, a );
+        for (int i = 0; i < 4; i++)
+            IS( c.values_by_double[i], 0.5 * i );
+    }
+
+    {
+        OK( "sqrt, rsqrt and mul_add" );
+        SIMDType<32> a, b, c, d;
+        for (int i = 0; i < 8; i++)
+            a.values_by_float[i] = float( (i + 1) * (i + 1) );
+        simd_sqrt<float>( c, a );
+        for (int i = 0; i < 8; i++)
+            IS( c.values_by_float[i], float( i + 1 ) );
+        simd_rsqrt<float>( c, a );
+        for (int i = 0; i < 8; i++)
+            OK( std::abs( c.values_by_float[i] * float( i + 1 ) - 1.0f ) < 1.0f / 1024 );
+
+        for (int i = 0; i < 4; i++)
+            a.values_by_double[i] = double( (i + 1) * (i + 1) );
+        simd_sqrt<double>( c, a );
+        for (int i = 0; i < 4; i++)
+            IS( c.values_by_double[i], double( i + 1 ) );
+
+        for (int i = 0; i < 8; i++)
+        {
+            a.values_by_float[i] = float( i );
+            b.values_by_float[i] = 0.5f;
+            c.values_by_float[i] = 100.0f;
+        }
+        simd_mul_add<float>( d, a, b, c );
+        for (int i = 0; i < 8; i++)
+            IS( d.values_by_float[i], 100.0f + float( i ) * 0.5f );
+    }
+
+    {
+        OK( "select and movemask" );
+        SIMDType<32> a, b, mask, c;
+        for (int i = 0; i < 8; i++)
+        {
+            a.values_by_float[i] = float( i );
+            b.values_by_float[i] = -1.0f;
+        }
+        SIMDType<32> threshold;
+        simd_broadcast<float>( threshold, 2.5f );
+        simd_gt<float>( mask, a, threshold );
+        simd_select<float>( c, mask, a, b );
+        for (int i = 0; i < 8; i++)
+            IS( c.values_by_float[i], i > 2 ? float( i ) : -1.0f );
+        IS( simd_movemask<float>( mask ), uint64( 0xf8 ) );
+        IS( simd_movemask<int32>( mask ), uint64( 0xf8 ) );
+
+        for (int i = 0; i < 16; i++)
+            a.values_by_i16[i] = int16( (i % 3) == 0 ? -1 : 1 );
+        uint64 expect = 0;
+        for (int i = 0; i < 16; i++)
+            if ((i % 3) == 0) expect |= uint64( 1 ) << i;
+        IS( simd_movemask<int16>( a ), expect );
+
+        for (int i = 0; i < 32; i++)
+            a.values_by_i8[i] = int8( (i % 5) == 0 ? -1 : 1 );
+        expect = 0;
+        for (int i = 0; i < 32; i++)
+            if ((i % 5) == 0) expect |= uint64( 1 ) << i;
+        IS( simd_movemask<int8>( a ), expect );
+
+        for (int i = 0; i < 16; i++)
+            mask.values_by_i16[i] = int16( (i % 2) ? -1 : 0 );
+        simd_select<int16>( c, mask, a, b );
+        OK( c.values_by_i16[1] == a.values_by_i16[1] && c.values_by_i16[0] == b.values_by_i16[0] );
+    }
+
+    {
+        OK( "partial load and store" );
+        float src[8];
+        for (int i = 0; i < 8; i++)
+            src[i] = float( i + 1 );
+
+        for (int count = 0; count <= 8; count++)
+        {
+            SIMDType<32> a;
+            simd_broadcast<float>( a, -1.0f );
+            simd_load_partial<float>( a, src, count );
+            bool all_ok = true;
+            for (int i = 0; i < 8; i++)
+                all_ok = all_ok && a.values_by_float[i] == (i < count ? src[i] : 0.0f);
+            OK( all_ok );
+
+            float dst[8 + 1];
+            for (int i = 0; i <= 8; i++)
+                dst[i] = 99.0f;
+            simd_store_partial<float>( a, dst, count );
+            all_ok = true;
+            for (int i = 0; i <= 8; i++)
+                all_ok = all_ok && dst[i] == (i < count ? src[i] : 99.0f);
+            OK( all_ok );
+        }
+
+        double src_d[4];
+        for (int i = 0; i < 4; i++)
+            src_d[i] = 0.5 * i;
+        SIMDType<32> a;
+        simd_load_partial<double>( a, src_d, 3 );
+        IS( a.values_by_double[2], 1.0 );
+        IS( a.values_by_double[3], 0.0 );
+
+        int8 src8[32];
+        for (int i = 0; i < 32; i++)
+            src8[i] = int8( i + 1 );
+        simd_load_partial<int8>( a, src8, 29 );
+        IS( a.values_by_i8[28], int8( 29 ) );
+        IS( a.values_by_i8[29], int8( 0 ) );
+    }
+
+    {
+        OK( "gather" );
+        float table[64];
+        for (int i = 0; i < 64; i++)
+            table[i] = float( i ) * 10.0f;
+
+        SIMDType<32> idx, c;
+        for (int i = 0; i < 8; i++)
+            idx.values_by_i32[i] = (i * 13) % 64;
+        simd_gather<float>( c, table, idx );
+        for (int i = 0; i < 8; i++)
+            IS( c.values_by_float[i], float( (i * 13) % 64 ) * 10.0f );
+
+        double table_d[64];
+        for (int i = 0; i < 64; i++)
+            table_d[i] = double( i ) * 0.5;
+        simd_gather<double>( c, table_d, idx );
+        for (int i = 0; i < 4; i++)
+            IS( c.values_by_double[i], double( (i * 13) % 64 ) * 0.5 );
+    }
+
+    {
+        OK( "horizontal min and max" );
+        SIMDType<32> a;
+        for (int i = 0; i < 8; i++)
+        {
+            a.values_by_float[i] = float( (i * 5) % 8 ) - 3.0f;
+        }
+        IS( simd_reduce_min<float>( a ), -3.0f );
+        IS( simd_reduce_max<float>( a ), float( 8 - 1 ) - 3.0f );
+
+        for (int i = 0; i < 8; i++)
+            a.values_by_i32[i] = (i * 5) % 8 - 3;
+        IS( simd_reduce_min<int32>( a ), -3 );
+        IS( simd_reduce_max<int32>( a ), 8 - 4 );
+    }
+}
@@ -0,0 +1,429 @@
+#include "treecore/TestFramework.h"
+#include "treecore/SimdObject.h"
+
+#include <limits>
+
+using namespace treecore;
+
+void TestFramework::content( int argc, char** argv )
+{
+    {
+        OK( "set by values" );
+        SIMDType<64> a;
+        simd_set_all<float, 64>( a, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16 );
+        for (int i = 0; i < 16; i++)
+            IS( a.values_by_float[i], float( i + 1 ) );
+
+        simd_set_all<int64, 64>( a, 1, -2, 3, -4, 5, -6, 7, -8 );
+        for (int i = 0; i < 8; i++)
+            IS( a.values_by_i64[i], int64( i % 2 ? -(i + 1) : i + 1 ) );
+
+        simd_set_one<13, int32>( a, 42 );
+        IS( (simd_get_one<13, int32>( a )), 42 );
+    }
+
+    {
+        OK( "set all to same value" );
+        SIMDType<64> value;
+
+        simd_broadcast<int16>( value, int16( -7 ) );
+        for (int i = 0; i < 32; i++)
+            IS( value.values_by_i16[i], int16( -7 ) );
+
+        simd_broadcast<float>( value, 12.34f );
+        for (int i = 0; i < 16; i++)
+            IS( value.values_by_float[i], 12.34f );
+    }
+
+    {
+        OK( "set and get using pointer" );
+        SIMDType<64> value;
+
+        double data_d[8] = {1.5, 2.5, 3.5, 4.5, 5.5, 6.5, 7.5, 8.5};
+        simd_set_all<double>( value, data_d );
+        for (int i = 0; i < 8; i++)
+            IS( value.values_by_double[i], data_d[i] );
+
+        int8 data_i8[64];
+        simd_broadcast<int8>( value, int8( 3 ) );
+        simd_get_all<int8>( value, data_i8 );
+        for (int i = 0; i < 64; i++)
+            IS( data_i8[i], int8( 3 ) );
+    }
+
+    {
+        OK( "integer arithmetic" );
+        SIMDType<64> a, b, c;
+        for (int i = 0; i < 16; i++)
+        {
+            a.values_by_i32[i] = i + 1;
+            b.values_by_i32[i] = (i + 1) * 10;
+        }
+
+        simd_add<int32>( c, a, b );
+        for (int i = 0; i < 16; i++)
+            IS( c.values_by_i32[i], (i + 1) * 11 );
+
+        simd_sub<int32>( c, a, b );
+        for (int i = 0; i < 16; i++)
+            IS( c.values_by_i32[i], -(i + 1) * 9 );
+
+        simd_mul<int32>( c, a, b );
+        for (int i = 0; i < 16; i++)
+            IS( c.values_by_i32[i], (i + 1) * (i + 1) * 10 );
+
+        IS( simd_sum<int32>( a ), 136 );
+
+        simd_broadcast<int8>( a, int8( 100 ) );
+        simd_broadcast<int8>( b, int8( 27 ) );
+        simd_add<int8>( c, a, b );
+        for (int i = 0; i < 64; i++)
+            IS( c.values_by_i8[i], int8( 127 ) );
+    }
+
+    {
+        OK( "convert" );
+        SIMDType<64> a, b;
+        for (int i = 0; i < 16; i++)
+            a.values_by_i32[i] = i - 8;
+
+        simd_convert<float, int32>( b, a );
+        for (int i = 0; i < 16; i++)
+            IS( b.values_by_float[i], float( i - 8 ) );
+
+        simd_convert<double, int32>( b, a );
+        for (int i = 0; i < 8; i++)
+            IS( b.values_by_double[i], double( i - 8 ) );
+
+        simd_convert<int32, double>( a, b );
+        for (int i = 0; i < 8; i++)
+            IS( a.values_by_i32[i], i - 8 );
+        for (int i = 8; i < 16; i++)
+            IS( a.values_by_i32[i], 0 );
+    }
+
+    {
+        OK( "shift" );
+        SIMDType<64> a, b;
+        simd_broadcast<int64>( a, int64( -256 ) );
+        simd_shift_right_sign<int64>( b, a, 4 );
+        for (int i = 0; i < 8; i++)
+            IS( b.values_by_i64[i], int64( -16 ) );
+
+        simd_shift_right_zero<int64>( b, a, 60 );
+        IS( b.values_by_i64[7], int64( 15 ) );
+    }
+
+    {
+        OK( "shift bytes across 128-bit lanes" );
+        SIMDType<64> a, b;
+        for (int i = 0; i < 64; i++)
+            a.values_by_i8[i] = int8( i + 1 );
+
+        simd_shift_byte_left<0>( b, a );
+        OK( simd_equal<int8>( a, b ) );
+
+        simd_shift_byte_left<7>( b, a );
+        for (int i = 0; i < 64; i++)
+            IS( b.values_by_i8[i], int8( i < 7 ? 0 : i - 6 ) );
+
+        simd_shift_byte_left<37>( b, a );
+        for (int i = 0; i < 64; i++)
+            IS( b.values_by_i8[i], int8( i < 37 ? 0 : i - 36 ) );
+
+        simd_shift_byte_right<9>( b, a );
+        for (int i = 0; i < 64; i++)
+            IS( b.values_by_i8[i], int8( i + 9 < 64 ? i + 10 : 0 ) );
+
+        simd_shift_byte_right<48>( b, a );
+        for (int i = 0; i < 64; i++)
+            IS( b.values_by_i8[i], int8( i + 48 < 64 ? i + 49 : 0 ) );
+
+        simd_shift_byte_left<64>( b, a );
+        for (int i = 0; i < 64; i++)
+            IS( b.values_by_i8[i], int8( 0 ) );
+    }
+
+    {
+        OK( "comparison" );
+        SIMDType<64> a, b, c;
+        for (int i = 0; i < 32; i++)
+        {
+            a.values_by_i16[i] = int16( i );
+            b.values_by_i16[i] = int16( 31 - i );
+        }
+
+        simd_lt<int16>( c, a, b );
+        for (int i = 0; i < 32; i++)
+            IS( c.values_by_i16[i], int16( i < 16 ? -1 : 0 ) );
+
+        simd_ncmp<int16>( c, a, a );
+        for (int i = 0; i < 32; i++)
+            IS( c.values_by_i16[i], int16( 0 ) );
+
+        simd_broadcast<float>( a, 1.0f );
+        simd_set_one<3, float>( a, std::numeric_limits<float>::quiet_NaN() );
+        simd_cmp<float>( c, a, a );
+        IS( c.values_by_i32[0], -1 );
+        IS( c.values_by_i32[3], 0 );
+        OK( !simd_equal<float>( a, a ) );
+    }
+
+    {
+        OK( "shuffle works inside each 128-bit lane" );
+        SIMDType<64> c;
+        for (int i = 0; i < 16; i++)
+            c.values_by_i32[i] = i;
+
+        simd_shuffle<1, 0, 3, 2>( c );
+        for (int i = 0; i < 16; i++)
+            IS( c.values_by_i32[i], i ^ 1 );
+    }
+
+    {
+        OK( "SimdObject" );
+        simd16f zero;
+        for (int i = 0; i < 16; i++)
+            IS( zero.data.values_by_float[i], 0.0f );
+
+        float values[16];
+        for (int i = 0; i < 16; i++)
+            values[i] = float( i );
+
+        simd16f a( values );
+        simd16f c = a * simd16f( 2.0f ) - simd16f( 1.0f );
+        IS( c.get<0>(), -1.0f );
+        IS( c.get<15>(), 29.0f );
+        IS( c.sum(), 224.0f );
+
+        simd16i mask = (a >= simd16f( 8.0f ));
+        IS( mask.get<7>(), int32( 0 ) );
+        IS( mask.get<8>(), int32( -1 ) );
+    }
+
+    {
+        OK( "min and max" );
+        SIMDType<64> a, b, c;
+        for (int i = 0; i < 16; i++)
+        {
+            a.values_by_float[i] = float( i ) - 4.0f;
+            b.values_by_float[i] = 4.0f - float( i );
+        }
+        simd_min<float>( c, a, b );
+        for (int i = 0; i < 16; i++)
+            IS( c.values_by_float[i], -std::abs( float( i ) - 4.0f ) );
+        simd_max<float>( c, a, b );
+        for (int i = 0; i < 16; i++)
+            IS( c.values_by_float[i], std::abs( float( i ) - 4.0f ) );
+
+        for (int i = 0; i < 16; i++)
+        {
+            a.values_by_i32[i] = i * 1000 - 5000;
+            b.values_by_i32[i] = 0;
+        }
+        simd_min<int32>( c, a, b );
+        for (int i = 0; i < 16; i++)
+            IS( c.values_by_i32[i], i * 1000 - 5000 < 0 ? i * 1000 - 5000 : 0 );
+        simd_max<int32>( c, a, b );
+        for (int i = 0; i < 16; i++)
+            IS( c.values_by_i32[i], i * 1000 - 5000 > 0 ? i * 1000 - 5000 : 0 );
+
+        for (int i = 0; i < 64; i++)
+            a.values_by_i8[i] = int8( i * 7 );
+        simd_broadcast<int32>( b, 0 );
+        simd_min<int8>( c, a, b );
+        for (int i = 0; i < 64; i++)
+            IS( c.values_by_i8[i], int8( i * 7 ) < 0 ? int8( i * 7 ) : int8( 0 ) );
+        simd_max<uint8>( c, a, b );
+        for (int i = 0; i < 64; i++)
+            IS( c.values_by_i8[i], int8( i * 7 ) );
+
+        for (int i = 0; i < 32; i++)
+            a.values_by_i16[i] = int16( i * 3001 );
+        simd_max<int16>( c, a, b );
+        for (int i = 0; i < 32; i++)
+            IS( c.values_by_i16[i], int16( i * 3001 ) > 0 ? int16( i * 3001 ) : int16( 0 ) );
+
+        for (int i = 0; i < 8; i++)
+        {
+            a.values_by_double[i] = double( i ) * 1.5;
+            b.values_by_double[i] = 2.0;
+        }
+        simd_min<double>( c, a, b );
+        for (int i = 0; i < 8; i++)
+            IS( c.values_by_double[i], double( i ) * 1.5 < 2.0 ? double( i ) * 1.5 : 2.0 );
+    }
+
+    {
+        OK( "abs" );
+        SIMDType<64> a, c;
+        for (int i = 0; i < 16; i++)
+            a.values_by_float[i] = (i % 2) ? -float( i ) : float( i );
+        simd_abs<float>( c, a );
+        for (int i = 0; i < 16; i++)
+            IS( c.values_by_float[i], float( i ) );
+
+        for (int i = 0; i < 16; i++)
+            a.values_by_i32[i] = (i % 2) ? -i * 100 : i * 100;
+        simd_abs<int32>( c, a );
+        for (int i = 0; i < 16; i++)
+            IS( c.values_by_i32[i], i * 100 );
+
+        for (int i = 0; i < 32; i++)
+            a.values_by_i16[i] = int16( -i );
+        simd_abs<int16>( c, a );
+        for (int i = 0; i < 32; i++)
+            IS( c.values_by_i16[i], int16( i ) );
+
+        for (int i = 0; i < 8; i++)
+            a.values_by_double[i] = -0.5 * i;
+        simd_abs<double>( c, a );
+        for (int i = 0; i < 8; i++)
+            IS( c.values_by_double[i], 0.5 * i );
+    }
+
+    {
+        OK( "sqrt, rsqrt and mul_add" );
+        SIMDType<64> a, b, c, d;
+        for (int i = 0; i < 16; i++)
+            a.values_by_float[i] = float( (i + 1) * (i + 1) );
+        simd_sqrt<float>( c, a );
+        for (int i = 0; i < 16; i++)
+            IS( c.values_by_float[i], float( i + 1 ) );
+        simd_rsqrt<float>( c, a );
+        for (int i = 0; i < 16; i++)
+            OK( std::abs( c.values_by_float[i] * float( i + 1 ) - 1.0f ) < 1.0f / 1024 );
+
+        for (int i = 0; i < 8; i++)
+            a.values_by_double[i] = double( (i + 1) * (i + 1) );
+        simd_sqrt<double>( c, a );
+        for (int i = 0; i < 8; i++)
+            IS( c.values_by_double[i], double( i + 1 ) );
+
+        for (int i = 0; i < 16; i++)
+        {
+            a.values_by_float[i] = float( i );
+            b.values_by_float[i] = 0.5f;
+            c.values_by_float[i] = 100.0f;
+        }
+        simd_mul_add<float>( d, a, b, c );
+        for (int i = 0; i < 16; i++)
+            IS( d.values_by_float[i], 100.0f + float( i ) * 0.5f );
+    }
+
+    {
+        OK( "select and movemask" );
+        SIMDType<64> a, b, mask, c;
+        for (int i = 0; i < 16; i++)
+        {
+            a.values_by_float[i] = float( i );
+            b.values_by_float[i] = -1.0f;
+        }
+        SIMDType<64> threshold;
+        simd_broadcast<float>( threshold, 2.5f );
+        simd_gt<float>( mask, a, threshold );
+        simd_select<float>( c, mask, a, b );
+        for (int i = 0; i < 16; i++)
+            IS( c.values_by_float[i], i > 2 ? float( i ) : -1.0f );
+        IS( simd_movemask<float>( mask ), uint64( 0xfff8 ) );
+        IS( simd_movemask<int32>( mask ), uint64( 0xfff8 ) );
+
+        for (int i = 0; i < 32; i++)
+            a.values_by_i16[i] = int16( (i % 3) == 0 ? -1 : 1 );
+        uint64 expect = 0;
+        for (int i = 0; i < 32; i++)
+            if ((i % 3) == 0) expect |= uint64( 1 ) << i;
+        IS( simd_movemask<int16>( a ), expect );
+
+        for (int i = 0; i < 64; i++)
+            a.values_by_i8[i] = int8( (i % 5) == 0 ? -1 : 1 );
+        expect = 0;
+        for (int i = 0; i < 64; i++)
+            if ((i % 5) == 0) expect |= uint64( 1 ) << i;
+        IS( simd_movemask<int8>( a ), expect );
+
+        for (int i = 0; i < 32; i++)
+            mask.values_by_i16[i] = int16( (i % 2) ? -1 : 0 );
+        simd_select<int16>( c, mask, a, b );
+        OK( c.values_by_i16[1] == a.values_by_i16[1] && c.values_by_i16[0] == b.values_by_i16[0] );
+    }
+
+    {
+        OK( "partial load and store" );
+        float src[16];
+        for (int i = 0; i < 16; i++)
+            src[i] = float( i + 1 );
+
+        for (int count = 0; count <= 16; count++)
+        {
+            SIMDType<64> a;
+            simd_broadcast<float>( a, -1.0f );
+            simd_load_partial<float>( a, src, count );
+            bool all_ok = true;
+            for (int i = 0; i < 16; i++)
+                all_ok = all_ok && a.values_by_float[i] == (i < count ? src[i] : 0.0f);
+            OK( all_ok );
+
+            float dst[16 + 1];
+            for (int i = 0; i <= 16; i++)
+                dst[i] = 99.0f;
+            simd_store_partial<float>( a, dst, count );
+            all_ok = true;
+            for (int i = 0; i <= 16; i++)
+                all_ok = all_ok && dst[i] == (i < count ? src[i] : 99.0f);
+            OK( all_ok );
+        }
+
+        double src_d[8];
+        for (int i = 0; i < 8; i++)
+            src_d[i] = 0.5 * i;
+        SIMDType<64> a;
+        simd_load_partial<double>( a, src_d, 3 );
+        IS( a.values_by_double[2], 1.0 );
+        IS( a.values_by_double[3], 0.0 );
+
+        int8 src8[64];
+        for (int i = 0; i < 64; i++)
+            src8[i] = int8( i + 1 );
+        simd_load_partial<int8>( a, src8, 61 );
+        IS( a.values_by_i8[60], int8( 61 ) );
+        IS( a.values_by_i8[61], int8( 0 ) );
+    }
+
+    {
+        OK( "gather" );
+        float table[64];
+        for (int i = 0; i < 64; i++)
+            table[i] = float( i ) * 10.0f;
+
+        SIMDType<64> idx, c;
+        for (int i = 0; i < 16; i++)
+            idx.values_by_i32[i] = (i * 13) % 64;
+        simd_gather<float>( c, table, idx );
+        for (int i = 0; i < 16; i++)
+            IS( c.values_by_float[i], float( (i * 13) % 64 ) * 10.0f );
+
+        double table_d[64];
+        for (int i = 0; i < 64; i++)
+            table_d[i] = double( i ) * 0.5;
+        simd_gather<double>( c, table_d, idx );
+        for (int i = 0; i < 8; i++)
+            IS( c.values_by_double[i], double( (i * 13) % 64 ) * 0.5 );
+    }
+
+    {
+        OK( "horizontal min and max" );
+        SIMDType<64> a;
+        for (int i = 0; i < 16; i++)
+        {
+            a.values_by_float[i] = float( (i * 5) % 16 ) - 3.0f;
+        }
+        IS( simd_reduce_min<float>( a ), -3.0f );
+        IS( simd_reduce_max<float>( a ), float( 16 - 1 ) - 3.0f );
+
+        for (int i = 0; i < 16; i++)
+            a.values_by_i32[i] = (i * 5) % 16 - 3;
+        IS( simd_reduce_min<int32>( a ), -3 );
+        IS( simd_reduce_max<int32>( a ), 16 - 4 );
+    }
+}
@@ -0,0 +1,200 @@
+#include "treecore/TestFramework.h"
+#include "treecore/Array.h"
+#include "treecore/AtomicObject.h"
+#include "treecore/SnapshotPtr.h"
+#include "treecore/Thread.h"
+
+#define NUM_READER 6
+#define NUM_WRITER 2
+#define NUM_UPDATE 20000
+
+using namespace treecore;
+
+static AtomicObject<int32> num_alive( 0 );
+
+struct Config
+{
+    Config(): a( 0 ), b( 0 ) { ++num_alive; }
+    Config( const Config& other ): a( other.a ), b( other.b ) { ++num_alive; }
+    ~Config() { a = -1; b = -1; --num_alive; }
+
+    int64 a;
+    int64 b;
+};
+
+struct ReaderThread: public Thread
+{
+    ReaderThread( const SnapshotPtr<Config>& config, AtomicObject<int32>& stop )
+        : Thread( "reader" )
+        , config( config )
+        , stop( stop )
+    {}
+
+    void run() override
+    {
+        int64 last = 0;
+        while ( stop.load() == 0 )
+        {
+            SnapshotPtr<Config>::ReadGuard snapshot( config );
+
+            // a published version is never modified
+            if (snapshot->b != snapshot->a * 2) num_torn++;
+            if (snapshot->a < last) num_backward++;
+            last = snapshot->a;
+            num_read++;
+        }
+
+        config.detachCurrentThread();
+    }
+
+    const SnapshotPtr<Config>& config;
+    AtomicObject<int32>& stop;
+    int64 num_read = 0;
+    int64 num_torn = 0;
+    int64 num_backward = 0;
+};
+
+struct WriterThread: public Thread
+{
+    WriterThread( SnapshotPtr<Config>& config )
+        : Thread( "writer" )
+        , config( config )
+    {}
+
+    void run() override
+    {
+        for (int i = 0; i < NUM_UPDATE; i++)
+        {
+            config.update( []( Config& c ) {
+                c.a += 1;
+                c.b = c.a * 2;
+            } );
+        }
+
+        config.synchronize();
+        config.detachCurrentThread();
+    }
+
+    SnapshotPtr<Config>& config;
+};
+
+void TestFramework::content( int argc, char** argv )
+{
+    {
+        SnapshotPtr<Config> config;
+        {
+            SnapshotPtr<Config>::ReadGuard snapshot( config );
+            OK( snapshot.get() == nullptr );
+        }
+
+        config.publish( new Config() );
+        IS( num_alive.load(), 1 );
+
+        {
+            SnapshotPtr<Config>::ReadGuard snapshot( config );
+            OK( snapshot.get() != nullptr );
+            IS( snapshot->a, int64( 0 ) );
+
+            // old version stays valid while snapshot is held
+            const Config* old = snapshot.get();
+            config.update( []( Config& c ) { c.a = 5; c.b = 10; } );
+            IS( old->a, int64( 0 ) );
+            IS( num_alive.load(), 2 );
+
+            SnapshotPtr<Config>::ReadGuard snapshot2( config );
+            IS( snapshot2->a, int64( 5 ) );
+        }
+
+        config.synchronize();
+        IS( num_alive.load(), 1 );
+
+        config.publish( nullptr );
+        config.synchronize();
+        IS( num_alive.load(), 0 );
+    }
+
+    // replaced versions are deleted once readers leave, without waiting for
+    // more versions to be retired
+    {
+        SnapshotPtr<Config> config( new Config() );
+
+        config.update( []( Config& c ) { c.a = 1; c.b = 2; } );
+        IS( num_alive.load(), 1 );
+
+        {
+            SnapshotPtr<Config>::ReadGuard snapshot( config );
+            config.update( []( Config& c ) { c.a = 2; c.b = 4; } );
+            IS( num_alive.load(), 2 );
+            config.collect();
+            IS( num_alive.load(), 2 );
+            IS( snapshot->a, int64( 1 ) );
+        }
+
+        config.collect();
+        IS( num_alive.load(), 1 );
+
+        // a reader in another thread
+        AtomicObject<int32> stop( 0 );
+        ReaderThread reader( config, stop );
+        reader.startThread();
+        Thread::sleep( 10 );
+
+        config.update( []( Config& c ) { c.a = 3; c.b = 6; } );
+
+        stop = 1;
+        reader.waitForThreadToExit( -1 );
+        config.collect();
+        IS( num_alive.load(), 1 );
+        IS( reader.num_torn, int64( 0 ) );
+    }
+
+    {
+        SnapshotPtr<Config> config( new Config() );
+        AtomicObject<int32> stop( 0 );
+
+        Array<ReaderThread*> readers;
+        Array<WriterThread*> writers;
+
+        for (int i = 0; i < NUM_READER; i++)
+            readers.add( new ReaderThread( config, stop ) );
+        for (int i = 0; i < NUM_WRITER; i++)
+            writers.add( new WriterThread( config ) );
+
+        for (int i = 0; i < NUM_READER; i++)
+            readers[i]->startThread();
+        for (int i = 0; i < NUM_WRITER; i++)
+            writers[i]->startThread();
+
+        for (int i = 0; i < NUM_WRITER; i++)
+            writers[i]->waitForThreadToExit( -1 );
+
+        stop = 1;
+        for (int i = 0; i < NUM_READER; i++)
+            readers[i]->waitForThreadToExit( -1 );
+
+        int64 num_read = 0, num_torn = 0, num_backward = 0;
+        for (int i = 0; i < NUM_READER; i++)
+        {
+            num_read     += readers[i]->num_read;
+            num_torn     += readers[i]->num_torn;
+            num_backward += readers[i]->num_backward;
+            delete readers[i];
+        }
+        for (int i = 0; i < NUM_WRITER; i++)
+            delete writers[i];
+
+        GT( num_read, int64( 0 ) );
+        IS( num_torn, int64( 0 ) );
+        IS( num_backward, int64( 0 ) );
+
+        {
+            SnapshotPtr<Config>::ReadGuard snapshot( config );
+            IS( snapshot->a, int64( NUM_UPDATE ) * NUM_WRITER );
+        }
+
+        config.synchronize();
+        IS( num_alive.load(), 1 );
+    }
+
+    IS( num_alive.load(), 0 );
+}
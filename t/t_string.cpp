@@ -377,5 +377,75 @@ void TestFramework::content( int argc, char** argv )
         OK( !v4.equals( v2 ) );
     }
 
+    {
+        OK( "Short strings" );
+
+        // 15 bytes is the longest inline text, 16 goes to a holder
+        const String s15( "abcdefghijklmno" );
+        const String s16( "abcdefghijklmnop" );
+        IS( s15.length(), 15 );
+        IS( s16.length(), 16 );
+
+        String c15( s15 );
+        String c16( s16 );
+        IS( c15, s15 );
+        IS( c16, s16 );
+        IS( s15.getReferenceCount(), 1 );
+        IS( s16.getReferenceCount(), 2 );
+        OK( c15.getCharPointer().getAddress() != s15.getCharPointer().getAddress() );
+        OK( c16.getCharPointer().getAddress() == s16.getCharPointer().getAddress() );
+
+        // growing from inline text into a holder, then appending to self
+        String grow( "ab" );
+        for (int i = 0; i < 10; ++i)
+            grow += "cd";
+        IS( grow, String( "abcdcdcdcdcdcdcdcdcdcd" ) );
+
+        String self( "xyz" );
+        self += self;
+        IS( self, String( "xyzxyz" ) );
+        self += self;
+        self += self;
+        IS( self, String( "xyzxyzxyzxyzxyzxyzxyzxyz" ) );
+
+        // swap and move between both kinds of storage
+        String a( "short" );
+        String b( "a string that is longer than inline text" );
+        a.swapWith( b );
+        IS( b, String( "short" ) );
+        IS( a, String( "a string that is longer than inline text" ) );
+
+        String moved( static_cast<String&&>(b) );
+        IS( moved, String( "short" ) );
+        OK( b.isEmpty() );
+        b = moved;
+        moved.clear();
+        OK( moved.isEmpty() );
+        IS( b, String( "short" ) );
+
+        // Array relocates elements with memcpy
+        StringArray array;
+        for (int i = 0; i < 1000; ++i)
+            array.add( String( i ) );
+        array.insert( 0, "first" );
+        array.remove( 500 );
+        IS( array[0], String( "first" ) );
+        IS( array[1], String( "0" ) );
+        IS( array[999], String( "999" ) );
+        IS( array.joinIntoString( "" ).length(), 2890 + 5 - 3 );
+
+        // extra bytes written past the inline text
+        IS( String( "short" ).toUTF32().length(), size_t( 5 ) );
+        IS( String( CharPointer_UTF8( "\xc3\xa9t\xc3\xa9" ) ).toUTF16().length(), size_t( 3 ) );
+        IS( String( "abc" ).toUpperCase(), String( "ABC" ) );
+        IS( String( "abc" ).replaceCharacter( 'b', 'x' ), String( "axc" ) );
+        IS( String( 123456789 ), String( "123456789" ) );
+        IS( String( 1.5 ), String( "1.5" ) );
+
+        var v( "short" );
+        var w( v );
+        IS( w.toString(), String( "short" ) );
+    }
+
     MT19937::releaseInstance();
 }
@@ -0,0 +1,171 @@
+#include "treecore/TestFramework.h"
+#include "treecore/JSON.h"
+#include "treecore/NewLine.h"
+#include "treecore/Result.h"
+#include "treecore/StringArray.h"
+#include "treecore/StringBuilder.h"
+#include "treecore/Variant.h"
+#include "treecore/XmlElement.h"
+
+#include <climits>
+
+using namespace treecore;
+
+void TestFramework::content( int argc, char** argv )
+{
+    // empty
+    {
+        StringBuilder builder;
+        OK( builder.isEmpty() );
+        IS( builder.toString(), String() );
+        IS( builder.getNumBytes(), size_t( 0 ) );
+    }
+
+    // mixed pieces
+    {
+        StringBuilder builder;
+        builder << "abc" << ' ' << String( "def" ) << StringRef( "ghi" ) << 42 << -7 << int64( -1234567890123ll );
+        IS( builder.getNumBytes(), size_t( 28 ) );
+        IS( builder.toString(), String( "abc defghi42-7-1234567890123" ) );
+        OK( builder.isEmpty() );
+    }
+
+    // numbers
+    {
+        StringBuilder builder;
+        builder << INT_MIN << ' ' << uint64( 18446744073709551615ull ) << ' ' << 0u;
+        IS( builder.toString(), String( "-2147483648 18446744073709551615 0" ) );
+
+        const double values[] = { 0.0, 1.5, -0.25, 3.14159265358979, 1.0e100, -123456.789 };
+        for (double value : values)
+        {
+            builder.append( value );
+            IS( builder.toString(), String( value ) );
+
+            builder.append( value, 3 );
+            IS( builder.toString(), String( value, 3 ) );
+        }
+
+        builder.appendHex( 0 ).append( ' ' ).appendHex( 0xbeef ).append( ' ' ).appendHex( 0xa, 4 ).append( ' ' ).appendHex( 0xffffffffffffffffull );
+        IS( builder.toString(), String( "0 beef 000a ffffffffffffffff" ) );
+
+        builder.appendUTF8Char( 'x' ).appendUTF8Char( 0xe9 ).appendUTF8Char( 0x20ac ).appendUTF8Char( 0x1f600 );
+        IS( builder.toString(), String( CharPointer_UTF8( "x\xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80" ) ) );
+
+        builder.appendRepeated( '-', 20 );
+        IS( builder.toString(), String::repeatedString( "-", 20 ) );
+    }
+
+    // format
+    {
+        StringBuilder builder;
+        builder.format( "{} of {} done, {}", 3, int64( 10 ), "ok" );
+        IS( builder.toString(), String( "3 of 10 done, ok" ) );
+
+        builder.format( "{{}} {} {", String( "x" ) );
+        IS( builder.toString(), String( "{} x {" ) );
+
+        builder.format( "no placeholder" );
+        IS( builder.toString(), String( "no placeholder" ) );
+
+        builder.format( "{}{}", 1 );
+        IS( builder.toString(), String( "1" ) );
+    }
+
+    // long text is the same as appending to a String, and is adopted by the result
+    {
+        StringBuilder builder;
+        String expected;
+
+        for (int i = 0; i < 1000; i++)
+        {
+            builder << i << ',';
+            expected << i << ',';
+        }
+
+        IS( builder.getNumBytes(), size_t( expected.getNumBytesAsUTF8() ) );
+
+        const String result = builder.toString();
+        IS( result, expected );
+        IS( result.getReferenceCount(), 1 );
+        OK( builder.isEmpty() );
+
+        // still usable after handing over its buffer
+        builder << "again";
+        IS( builder.toString(), String( "again" ) );
+
+        builder.reserve( 100 );
+        builder << result;
+        IS( builder.toString(), expected );
+    }
+
+    // text leaving most of the buffer unused is copied, and the buffer kept
+    {
+        StringBuilder builder( 4096 );
+        const String text = String::repeatedString( "0123456789", 100 );
+
+        builder << text;
+        const String copied = builder.toString();
+        IS( copied, text );
+        IS( builder.m_capacity, size_t( 4096 ) );
+
+        builder << text << text << text;
+        const String adopted = builder.toString();
+        IS( adopted, text + text + text );
+        IS( builder.m_capacity, size_t( 0 ) );
+    }
+
+    // as an OutputStream
+    {
+        StringBuilder builder;
+        OutputStream& out = builder;
+
+        out << "line" << newLine;
+        out.writeByte( 'x' );
+        out.writeRepeatedByte( 'y', 3 );
+        out.write( "zzz", 3 );
+        IS( out.getPosition(), int64( 13 ) );
+
+        OK( out.setPosition( 10 ) );
+        OK( !out.setPosition( 11 ) );
+        out << "end";
+
+        IS( builder.toString(), String( "line" ) + NewLine::getDefault() + "xyyyend" );
+    }
+
+    // users
+    {
+        StringArray array;
+        IS( array.joinIntoString( ", " ), String() );
+
+        array.add( "one" );
+        IS( array.joinIntoString( ", " ), String( "one" ) );
+
+        array.add( String() );
+        array.add( "three" );
+        IS( array.joinIntoString( ", " ), String( "one, , three" ) );
+        IS( array.joinIntoString( "" ), String( "onethree" ) );
+        IS( array.joinIntoString( "--", 1 ), String( "--three" ) );
+
+        IS( JSON::escapeString( CharPointer_UTF8( "plain \"quoted\" back\\slash\ttab\x01 \xc3\xa9 \xf0\x9f\x98\x80" ) ),
+            String( "plain \\\"quoted\\\" back\\\\slash\\ttab\\u0001 \\u00e9 \\ud83d\\ude00" ) );
+
+        var parsed;
+        const String json( "{\"name\": \"a \\\"b\\\" \\u00e9\", \"list\": [1, 2.5, \"x\"]}" );
+        OK( JSON::parse( json, parsed ).wasOk() );
+        IS( JSON::toString( parsed, true ), String( "{\"list\": [1, 2.5, \"x\"], \"name\": \"a \\\"b\\\" \\u00e9\"}" ) );
+
+        var reparsed;
+        OK( JSON::parse( JSON::toString( parsed, false ), reparsed ).wasOk() );
+        IS( reparsed["name"].toString(), String( CharPointer_UTF8( "a \"b\" \xc3\xa9" ) ) );
+
+        XmlElement root( "root" );
+        root.setAttribute( "attr", "a<b & \"c\"" );
+        XmlElement* const child = root.createNewChildElement( "child" );
+        child->addTextElement( "text > more text" );
+        child->addTextElement( ", and more" );
+        IS( root.createDocument( String(), true, false ),
+            String( "<root attr=\"a&lt;b &amp; &quot;c&quot;\"><child>text &gt; more text, and more</child></root>" ) );
+        IS( root.getAllSubText(), String( "text > more text, and more" ) );
+    }
+}
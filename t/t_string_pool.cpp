@@ -4,32 +4,54 @@
 void TestFramework::content( int argc, char** argv )
 {
     treecore::StringPool pool;
-    IS(pool.m_strings.size(), 0);
+    IS(pool.size(), 0);
 
     const char* foo = pool.getPooledString("foo");
     OK(foo);
-    IS(pool.m_strings.size(), 1);
+    IS(pool.size(), 1);
 
     const char* foo2 = pool.getPooledString("foo");
     OK(foo2);
-    IS(pool.m_strings.size(), 1);
+    IS(pool.size(), 1);
     IS(foo, foo2);
 
     const char* bar = pool.getPooledString("bar");
     OK(bar);
-    IS(pool.m_strings.size(), 2);
+    IS(pool.size(), 2);
     OK(foo != bar);
 
     const char* baz = pool.getPooledString("baz");
     OK(baz);
-    IS(pool.m_strings.size(), 3);
+    IS(pool.size(), 3);
     OK(foo != baz);
     OK(bar != baz);
     foo2 = pool.getPooledString("foo");
     IS(foo, foo2);
 
-    // ensure string reliability after rehash
-    pool.m_strings.remapTable(256);
+    // numbered in the order of adding
+    IS(treecore::StringPool::getPooledStringIndex(foo), 1);
+    IS(treecore::StringPool::getPooledStringIndex(bar), 2);
+    IS(treecore::StringPool::getPooledStringIndex(baz), 3);
+
+    // all overloads find the same string
+    treecore::String foo_str("foo");
+    IS(pool.getPooledString(foo_str), foo);
+    IS(pool.getPooledString(treecore::StringRef(foo_str)), foo);
+    treecore::String foobar("foobar");
+    IS(pool.getPooledString(foobar.getCharPointer(), foobar.getCharPointer() + 3), foo);
+    IS(pool.getPooledString(foobar.getCharPointer() + 3, foobar.getCharPointer() + 6), bar);
+    IS(pool.size(), 3);
+
+    // empty strings are not pooled
+    OK(pool.getPooledString("") == nullptr);
+    OK(pool.getPooledString(treecore::String()) == nullptr);
+    IS(pool.size(), 3);
+
+    // ensure string reliability after tables are grown
+    for (int i = 0; i < 10000; i++)
+        pool.getPooledString(treecore::String("name_") + treecore::String(i));
+    IS(pool.size(), 10003);
+
     const char* foo_again = pool.getPooledString("foo");
     const char* bar_again = pool.getPooledString("bar");
     const char* baz_again = pool.getPooledString("baz");
@@ -37,4 +59,16 @@ void TestFramework::content( int argc, char** argv )
     IS(foo, foo_again);
     IS(bar, bar_again);
     IS(baz, baz_again);
+    IS(treecore::String(foo_again), treecore::String("foo"));
+
+    bool all_found = true;
+    for (int i = 0; i < 10000; i++)
+    {
+        const treecore::String name = treecore::String("name_") + treecore::String(i);
+        const char* pooled = pool.getPooledString(name);
+        all_found = all_found && name == pooled && pooled != name.toRawUTF8()
+                    && treecore::StringPool::getPooledStringIndex(pooled) == i + 4;
+    }
+    OK(all_found);
+    IS(pool.size(), 10003);
 }
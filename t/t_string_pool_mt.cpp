@@ -0,0 +1,96 @@
+#include "treecore/TestFramework.h"
+#include "treecore/Array.h"
+#include "treecore/StringPool.h"
+#include "treecore/Thread.h"
+
+#define NUM_NAMES  5000
+#define NUM_THREAD 8
+
+using namespace treecore;
+
+//
+// threads add the same names in different orders, and must all get the
+// same pooled pointer for each name
+//
+struct PoolThread: public Thread
+{
+    PoolThread( StringPool& pool, const Array<String>& names, int idx )
+        : Thread( String( idx ) )
+        , pool( pool )
+        , names( names )
+        , idx( idx )
+    {}
+
+    void run() override
+    {
+        for (int i = 0; i < NUM_NAMES; i++)
+            results[i] = nullptr;
+
+        // visit names with a stride coprime to NUM_NAMES
+        static const int strides[NUM_THREAD] = { 7, 11, 13, 17, 19, 23, 29, 31 };
+        const int stride = strides[idx];
+        for (int i = 0; i < NUM_NAMES; i++)
+        {
+            const int k = int( (int64( i ) * stride + idx * 131) % NUM_NAMES );
+            results[k] = pool.getPooledString( names[k] );
+        }
+    }
+
+    StringPool& pool;
+    const Array<String>& names;
+    int idx;
+    const char* results[NUM_NAMES];
+};
+
+void TestFramework::content( int argc, char** argv )
+{
+    StringPool pool;
+
+    Array<String> names;
+    for (int i = 0; i < NUM_NAMES; i++)
+        names.add( String( "identifier_" ) + String( i * 31 ) );
+
+    Array<PoolThread*> threads;
+    for (int i = 0; i < NUM_THREAD; i++)
+        threads.add( new PoolThread( pool, names, i ) );
+
+    for (int i = 0; i < NUM_THREAD; i++)
+        threads[i]->startThread();
+
+    for (int i = 0; i < NUM_THREAD; i++)
+        threads[i]->waitForThreadToExit( -1 );
+
+    IS( pool.size(), NUM_NAMES );
+
+    bool all_same = true;
+    bool all_match = true;
+    for (int k = 0; k < NUM_NAMES; k++)
+    {
+        const char* first = threads[0]->results[k];
+        all_match = all_match && first != nullptr && names[k] == first;
+
+        for (int i = 1; i < NUM_THREAD; i++)
+            all_same = all_same && threads[i]->results[k] == first;
+
+        all_same = all_same && pool.getPooledString( names[k] ) == first;
+    }
+    OK( all_same );
+    OK( all_match );
+
+    // every string got its own index, without gaps
+    Array<bool> index_used;
+    index_used.resize( NUM_NAMES + 1 );
+    bool all_unique = true;
+    for (int k = 0; k < NUM_NAMES; k++)
+    {
+        const int index = StringPool::getPooledStringIndex( threads[0]->results[k] );
+        all_unique = all_unique && index >= 1 && index <= NUM_NAMES && !index_used[index];
+
+        if (index >= 1 && index <= NUM_NAMES)
+            index_used[index] = true;
+    }
+    OK( all_unique );
+
+    for (int i = 0; i < NUM_THREAD; i++)
+        delete threads[i];
+}
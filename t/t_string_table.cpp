@@ -0,0 +1,189 @@
+#include "treecore/MT19937.h"
+#include "treecore/MemoryBlock.h"
+#include "treecore/StringArray.h"
+#include "treecore/StringTable.h"
+
+#include "treecore/TestFramework.h"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace treecore;
+
+static bool same_elements( const StringTable& table, const StringArray& array )
+{
+    if (table.size() != array.size())
+        return false;
+
+    for (int i = 0; i < table.size(); i++)
+    {
+        if (table.getString( i ) != array[i])
+            return false;
+    }
+
+    return true;
+}
+
+static String random_string( MT19937& r )
+{
+    // few different characters, so that there are long common prefixes
+    static const char* const pieces[] = { "a", "b", "ab", "\xc3\xa9", "\xe2\x82\xac", "\xf0\x9f\x98\x80", "0", " " };
+
+    String result;
+    const int num_pieces = int( r.next_uint64_in_range( 12 ) );
+
+    for (int i = 0; i < num_pieces; i++)
+        result += String( CharPointer_UTF8( pieces[r.next_uint64_in_range( numElementsInArray( pieces ) )] ) );
+
+    return result;
+}
+
+void TestFramework::content( int argc, char** argv )
+{
+    MT19937& r = *MT19937::getInstance();
+
+    // adding and copying
+    {
+        StringTable table;
+        OK( table.isEmpty() );
+
+        table.add( "hello" );
+        table.add( "with\0zero", 9 );
+        table.add( "" );
+        IS( table.size(), 3 );
+        IS( table.getString( 0 ), String( "hello" ) );
+        IS( table.getNumBytes( 1 ), size_t( 9 ) );
+        OK( table.equals( 1, "with\0zero", 9 ) );
+        OK( !table.equals( 0, "hell", 4 ) );
+        IS( table.getNumBytes( 2 ), size_t( 0 ) );
+
+        const char referenced[] = "referenced";
+        table.addReference( referenced, 3 );
+        OK( table.getText( 3 ) == referenced );
+        IS( table[3], String( "ref" ) );
+
+        // longer than a chunk
+        const String long_text = String::repeatedString( "x", 100000 );
+        table.add( long_text );
+        IS( table.getString( 4 ), long_text );
+        IS( table.getString( 0 ), String( "hello" ) );
+
+        StringTable copy( table );
+        IS( copy.size(), 5 );
+        OK( copy.getText( 3 ) != referenced );
+        OK( copy.equals( 1, "with\0zero", 9 ) );
+        IS( copy[4], long_text );
+
+        StringTable moved( std::move( copy ) );
+        IS( moved.size(), 5 );
+        IS( moved[3], String( "ref" ) );
+
+        moved.remove( 0 );
+        IS( moved[0].length(), 4 );
+
+        moved.clear();
+        OK( moved.isEmpty() );
+    }
+
+    // lines, the same as StringArray::addLines()
+    {
+        const char* const texts[] = { "", "a", "a\n", "a\nb", "a\r\nb\rc\n\nd", "\n", "\r\n", "\r\r\n\n", "a\r" };
+        bool all_same = true;
+
+        for (const char* text : texts)
+        {
+            StringArray expected;
+            expected.addLines( text );
+
+            StringTable lines;
+            const int num = lines.addLines( text, std::strlen( text ) );
+            all_same = all_same && num == expected.size() && same_elements( lines, expected );
+        }
+
+        OK( all_same );
+
+        // refer to the given text
+        const char text[] = "one\ntwo";
+        StringTable lines;
+        IS( lines.addLines( text, 7 ), 2 );
+        OK( lines.getText( 1 ) == text + 4 );
+
+        // from a block which is taken over
+        MemoryBlock block( "x\ny\r\nz", 6 );
+        const void* const data = block.getData();
+        IS( lines.addLines( std::move( block ) ), 3 );
+        IS( lines.size(), 5 );
+        OK( lines.getText( 2 ) == data );
+        IS( lines[4], String( "z" ) );
+    }
+
+    // tokens, the same as StringArray::addTokens()
+    {
+        const char* const texts[] = { "", "a", "a b", " a  b ", "a,\"b c\",d", "'x y' \"z 'w\" v", "\"unclosed q", "\xc3\xa9 \xe2\x82\xac" };
+        bool all_same = true;
+
+        for (const char* text : texts)
+        {
+            StringArray expected;
+            expected.addTokens( CharPointer_UTF8( text ), " ,", "\"'" );
+
+            StringTable tokens;
+            const int num = tokens.addTokens( text, std::strlen( text ), " ,", "\"'" );
+            all_same = all_same && num == expected.size() && same_elements( tokens, expected );
+        }
+
+        OK( all_same );
+
+        StringTable tokens;
+        IS( tokens.addTokens( MemoryBlock( "k=v;k2=v2", 9 ), ";=", "" ), 4 );
+        IS( tokens[3], String( "v2" ) );
+    }
+
+    // sorting, in the same order as String::compare()
+    {
+        StringArray strings;
+        for (int i = 0; i < 5000; i++)
+            strings.add( random_string( r ) );
+
+        StringTable table( strings );
+        table.sort();
+
+        StringArray expected( strings );
+        std::sort( expected.begin(), expected.end(), [] ( const String& a, const String& b ) { return a.compare( b ) < 0; } );
+
+        OK( same_elements( table, expected ) );
+
+        strings.sort( false );
+        OK( strings == expected );
+
+        // inputs in order, reversed, up and down again, and with few
+        // different strings
+        StringArray patterned;
+        for (int i = 0; i < 20000; i++)
+            patterned.add( String( 100000 + i ) );
+        for (int i = 20000; i > 0; i--)
+            patterned.add( String( 100000 + i ) + "x" );
+        for (int i = 0; i < 20000; i++)
+            patterned.add( String( 100000 + jmin( i, 20000 - i ) ) + "y" );
+        for (int i = 0; i < 20000; i++)
+            patterned.add( String( i % 3 ) );
+
+        StringTable patterned_table( patterned );
+        patterned_table.sort();
+
+        StringArray patterned_expected( patterned );
+        std::sort( patterned_expected.begin(), patterned_expected.end(), [] ( const String& a, const String& b ) { return a.compare( b ) < 0; } );
+
+        OK( same_elements( patterned_table, patterned_expected ) );
+
+        // bytes above 127 come after ASCII, and a prefix before longer strings
+        StringTable few;
+        few.add( "b" );
+        few.add( "\xc3\xa9", 2 );
+        few.add( "ab" );
+        few.add( "a" );
+        few.add( "" );
+        few.sort();
+        IS( few.toStringArray().joinIntoString( "|" ), String( CharPointer_UTF8( "|a|ab|b|\xc3\xa9" ) ) );
+    }
+}
@@ -0,0 +1,167 @@
+#include "treecore/MT19937.h"
+#include "treecore/MemoryBlock.h"
+#include "treecore/StringArray.h"
+#include "treecore/StringTokenizer.h"
+
+#include "treecore/TestFramework.h"
+
+#include <type_traits>
+
+using namespace treecore;
+
+// slices of a temporary String would refer to text which is gone
+static_assert( !std::is_constructible<StringSlice, String&&>::value, "StringSlice of a temporary String" );
+static_assert( !std::is_constructible<StringTokenizer, String&&, StringRef>::value, "StringTokenizer of a temporary String" );
+static_assert( !std::is_constructible<LineIterator, String&&>::value, "LineIterator of a temporary String" );
+static_assert( std::is_constructible<StringTokenizer, const String&, StringRef>::value, "StringTokenizer of a String" );
+
+static bool same_tokens( const String& text, StringRef breaks, StringRef quotes )
+{
+    StringArray expected;
+    expected.addTokens( text, breaks, quotes );
+
+    StringTokenizer tokens( text, breaks, quotes );
+    int i = 0;
+
+    for (; tokens.next(); i++)
+    {
+        if (i >= expected.size() || tokens.getToken().toString() != expected[i])
+            return false;
+    }
+
+    return i == expected.size() && !tokens.next();
+}
+
+static bool same_lines( const String& text )
+{
+    StringArray expected;
+    expected.addLines( text );
+
+    LineIterator lines( text );
+    int i = 0;
+
+    for (; lines.next(); i++)
+    {
+        if (i >= expected.size() || lines.getLine().toString() != expected[i])
+            return false;
+    }
+
+    return i == expected.size() && !lines.next();
+}
+
+static String random_text( MT19937& r, const char* alphabet, int max_length )
+{
+    const int alphabet_size = int( std::strlen( alphabet ) );
+    const int length        = int( r.next_uint64_in_range( uint64( max_length ) ) );
+
+    String result;
+    for (int i = 0; i < length; i++)
+        result += alphabet[r.next_uint64_in_range( uint64( alphabet_size ) )];
+
+    return result;
+}
+
+void TestFramework::content( int argc, char** argv )
+{
+    MT19937& r = *MT19937::getInstance();
+
+    // slices
+    {
+        const String text( "  key = value  " );
+        const StringSlice all( text );
+        IS( all.getNumBytes(), size_t( 15 ) );
+        OK( all.getData() == text.toRawUTF8() );
+
+        const StringSlice trimmed = all.trim();
+        OK( trimmed == "key = value" );
+        OK( trimmed.startsWith( "key" ) );
+        OK( trimmed.endsWith( "value" ) );
+        OK( !trimmed.startsWith( "value" ) );
+        IS( trimmed.indexOf( '=' ), int64( 4 ) );
+        IS( trimmed.indexOf( '#' ), int64( -1 ) );
+        OK( trimmed.upToFirstOccurrenceOf( '=' ).trim() == "key" );
+        OK( trimmed.fromFirstOccurrenceOf( '=' ).trim() == "value" );
+        OK( trimmed.fromFirstOccurrenceOf( '#' ).isEmpty() );
+        OK( trimmed.upToFirstOccurrenceOf( '#' ) == trimmed );
+        OK( trimmed.substring( 6, 100 ) == "value" );
+        OK( trimmed.substring( 20 ).isEmpty() );
+        IS( trimmed.toString(), String( "key = value" ) );
+        OK( StringSlice( "   " ).trim().isEmpty() );
+
+        OK( StringSlice( "abc" ).compare( "abd" ) < 0 );
+        OK( StringSlice( "ab" ).compare( "abc" ) < 0 );
+        OK( StringSlice( "b" ).compare( "abc" ) > 0 );
+        IS( StringSlice( "abc" ).compare( "abc" ), 0 );
+        OK( StringSlice() == "" );
+
+        // numbers end at the slice, not at the text after it
+        const char numbers[] = "-42,1.5e3";
+        IS( StringSlice( numbers, 3 ).getIntValue(), -42 );
+        IS( StringSlice( numbers + 4, 3 ).getDoubleValue(), 1.5 );
+        IS( StringSlice( numbers + 4, 5 ).getDoubleValue(), 1500.0 );
+        IS( StringSlice( numbers, 1 ).getLargeIntValue(), int64( 0 ) );
+        IS( StringSlice( "9000000000" ).getLargeIntValue(), int64( 9000000000LL ) );
+    }
+
+    // tokens, the same as StringArray::addTokens()
+    {
+        OK( same_tokens( "", " ", "" ) );
+        OK( same_tokens( "a", " ", "" ) );
+        OK( same_tokens( " a  b ", " ", "" ) );
+        OK( same_tokens( "one,\"two, three\",'four,five',six", ",", "\"'" ) );
+        OK( same_tokens( "no breaks at all", "", "" ) );
+
+        // with and without vectors, short and long
+        int num_failed = 0;
+
+        for (int i = 0; i < 2000; i++)
+        {
+            const String text = random_text( r, "abcdefgh ,;\"'", i % 2 == 0 ? 20 : 200 );
+
+            if ( !same_tokens( text, " ,", "\"" ) )
+                num_failed++;
+
+            if ( !same_tokens( text, " ,;abcdefg", "\"'" ) )
+                num_failed++;
+        }
+
+        IS( num_failed, 0 );
+
+        const MemoryBlock block( "x=1;y=22", 8 );
+        StringTokenizer csv( block, ";" );
+        OK( csv.next() );
+        OK( csv.getToken() == "x=1" );
+        OK( csv.getRemainder() == "y=22" );
+        OK( csv.next() );
+        IS( csv.getToken().fromFirstOccurrenceOf( '=' ).getIntValue(), 22 );
+        OK( csv.getRemainder().isEmpty() );
+        OK( !csv.next() );
+    }
+
+    // lines, the same as StringArray::addLines()
+    {
+        OK( same_lines( "" ) );
+        OK( same_lines( "a" ) );
+        OK( same_lines( "a\n" ) );
+        OK( same_lines( "a\r\nb\rc\n\nd" ) );
+        OK( same_lines( "\r\r\n\n\r" ) );
+
+        int num_failed = 0;
+
+        for (int i = 0; i < 2000; i++)
+        {
+            if ( !same_lines( random_text( r, "ab\r\n", i % 2 == 0 ? 10 : 100 ) ) )
+                num_failed++;
+        }
+
+        IS( num_failed, 0 );
+
+        // the lines refer to the text
+        const char text[] = "first\nsecond";
+        LineIterator lines( text, 12 );
+        OK( lines.next() );
+        OK( lines.next() );
+        OK( lines.getLine().getData() == text + 6 );
+        OK( !lines.next() );
+    }
+}
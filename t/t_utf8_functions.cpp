@@ -0,0 +1,484 @@
+#include "treecore/TestFramework.h"
+#include "treecore/CharPointer_UTF8.h"
+#include "treecore/CharPointer_UTF16.h"
+#include "treecore/CharPointer_UTF32.h"
+#include "treecore/CpuDispatch.h"
+#include "treecore/String.h"
+#include "treecore/StringRef.h"
+#include "treecore/UTF8Functions.h"
+
+#include "treecore/internal/UTF8Functions_impl.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+using namespace treecore;
+
+#define BUF_SIZE 600
+
+// lengths around register sizes, and longer ones
+static const size_t lengths[] = { 0, 1, 2, 3, 5, 15, 16, 17, 31, 32, 33, 63, 64, 65, 100, 250 };
+
+// ASCII, two, three and four byte characters
+static const uint32 sample_chars[] = { 'a', 'Z', ' ', 0xe9, 0x3b1, 0x7ff, 0x800, 0x4e2d, 0xfffd, 0xffff, 0x10000, 0x1f600, 0x10ffff };
+
+static uint32 next_random( uint32& seed )
+{
+    seed = seed * 1664525u + 1013904223u;
+    return seed >> 8;
+}
+
+// straightforward check of RFC 3629 rules
+static bool reference_validate( const uint8* data, size_t num )
+{
+    size_t i = 0;
+
+    while (i < num)
+    {
+        const uint8 lead = data[i];
+        size_t len;
+        uint32 c;
+        uint32 min_value;
+
+        if (lead < 0x80)                { i++; continue; }
+        else if ( (lead & 0xe0) == 0xc0 ) { len = 2; c = lead & 0x1f; min_value = 0x80; }
+        else if ( (lead & 0xf0) == 0xe0 ) { len = 3; c = lead & 0x0f; min_value = 0x800; }
+        else if ( (lead & 0xf8) == 0xf0 ) { len = 4; c = lead & 0x07; min_value = 0x10000; }
+        else return false;
+
+        if (i + len > num)
+            return false;
+
+        for (size_t k = 1; k < len; k++)
+        {
+            if ( (data[i + k] & 0xc0) != 0x80 )
+                return false;
+            c = (c << 6) | (data[i + k] & 0x3f);
+        }
+
+        if ( c < min_value || c > 0x10ffff || (c >= 0xd800 && c <= 0xdfff) )
+            return false;
+
+        i += len;
+    }
+
+    return true;
+}
+
+// character counting, as CharPointer_UTF8::length() did it before
+static size_t reference_count( const char* d )
+{
+    size_t count = 0;
+
+    for (;; )
+    {
+        const uint32 n = (uint32) (uint8) *d++;
+
+        if ( (n & 0x80) != 0 )
+        {
+            while ( (*d & 0xc0) == 0x80 )
+                ++d;
+        }
+        else if (n == 0)
+            break;
+
+        ++count;
+    }
+
+    return count;
+}
+
+void TestFramework::content( int argc, char** argv )
+{
+    //
+    // test data: zero-terminated text with some prefix bytes before it, so
+    // that the same text is tested at different alignments
+    //
+    std::vector<char> buffer( BUF_SIZE );
+
+    auto make_text = [&]( size_t offset, size_t num_chars, uint32 seed, bool ascii_only ) -> size_t
+    {
+        CharPointer_UTF8 p( buffer.data() + offset );
+        size_t num_bytes = 0;
+
+        for (size_t i = 0; i < num_chars; i++)
+        {
+            const uint32 r = next_random( seed );
+            const uint32 c = ascii_only || r % 3 != 0 ? uint32( 'A' + r % 26 ) : sample_chars[(r >> 4) % numElementsInArray( sample_chars )];
+
+            if ( num_bytes + CharPointer_UTF8::getBytesRequiredFor( (treecore_wchar) c ) + offset + 1 >= BUF_SIZE )
+                break;
+
+            p.write( (treecore_wchar) c );
+            num_bytes += CharPointer_UTF8::getBytesRequiredFor( (treecore_wchar) c );
+        }
+
+        p.writeNull();
+        return num_bytes;
+    };
+
+    auto test_table = [&]( const Utf8KernelTable& k )
+    {
+        OK( "fixed validation cases" );
+        {
+            struct Case
+            {
+                const char* bytes;
+                bool valid;
+            };
+
+            const Case cases[] = {
+                { "", true },
+                { "plain ascii", true },
+                { "\xc3\xa9", true },
+                { "\xe4\xb8\xad\xe6\x96\x87", true },
+                { "\xf0\x9f\x98\x80", true },
+                { "\xf4\x8f\xbf\xbf", true },          // U+10FFFF
+                { "\xed\x9f\xbf", true },              // U+D7FF
+                { "\xee\x80\x80", true },              // U+E000
+                { "\x80", false },                     // stray continuation
+                { "a\xbf", false },
+                { "\xc3", false },                     // truncated
+                { "\xe4\xb8", false },
+                { "\xf0\x9f\x98", false },
+                { "\xc3\x28", false },                 // continuation missing
+                { "\xc0\xaf", false },                 // overlong
+                { "\xc1\xbf", false },
+                { "\xe0\x9f\xbf", false },
+                { "\xf0\x8f\xbf\xbf", false },
+                { "\xed\xa0\x80", false },             // surrogates
+                { "\xed\xbf\xbf", false },
+                { "\xf4\x90\x80\x80", false },         // above U+10FFFF
+                { "\xf5\x80\x80\x80", false },
+                { "\xf8\x88\x80\x80\x80", false },     // five byte form
+                { "\xff", false },
+                { "\xc3\xa9\xa9", false },             // too many continuations
+            };
+
+            for (const Case& c : cases)
+            {
+                // alone, and after a full register of ASCII
+                std::memset( buffer.data(), 'x', 64 );
+                std::strcpy( buffer.data() + 64, c.bytes );
+                const size_t len = std::strlen( c.bytes );
+
+                IS( k.validate( (const uint8*) c.bytes, len ), c.valid );
+                IS( k.validate( (const uint8*) buffer.data() + 61, len + 3 ), c.valid );
+                IS( k.validate( (const uint8*) buffer.data(), len + 64 ), c.valid );
+            }
+        }
+
+        OK( "generated text" );
+        for (size_t offset = 0; offset < 4; offset++)
+        {
+            for (size_t num_chars : lengths)
+            {
+                for (int ascii_only = 0; ascii_only < 2; ascii_only++)
+                {
+                    const size_t num_bytes = make_text( offset, num_chars, uint32( num_chars * 7 + offset ), ascii_only != 0 );
+                    const char*  text      = buffer.data() + offset;
+                    const uint8* bytes     = (const uint8*) text;
+
+                    OK( k.validate( bytes, num_bytes ) );
+                    IS( k.count_chars( bytes, num_bytes ), reference_count( text ) );
+
+                    size_t ascii = 0;
+                    while (ascii < num_bytes && bytes[ascii] < 0x80) ascii++;
+                    IS( k.ascii_prefix( bytes, num_bytes ), ascii );
+
+                    std::vector<uint16> utf16( num_bytes + 1 );
+                    std::vector<uint16> expect16( num_bytes * 2 + 2 );
+                    const size_t num16 = k.valid_to_utf16( bytes, num_bytes, utf16.data() );
+                    CharPointer_UTF16( (CharPointer_UTF16::CharType*) expect16.data() ).writeAll( CharPointer_UTF8( text ) );
+
+                    IS( k.valid_utf16_length( bytes, num_bytes ), num16 );
+                    IS( num16, CharPointer_UTF16::getBytesRequiredFor( CharPointer_UTF8( text ) ) / 2 );
+                    OK( std::memcmp( utf16.data(), expect16.data(), num16 * 2 ) == 0 );
+
+                    std::vector<uint32> utf32( num_bytes + 1 );
+                    std::vector<uint32> expect32( num_bytes + 1 );
+                    const size_t num32 = k.valid_to_utf32( bytes, num_bytes, utf32.data() );
+                    CharPointer_UTF32( (CharPointer_UTF32::CharType*) expect32.data() ).writeAll( CharPointer_UTF8( text ) );
+
+                    IS( num32, reference_count( text ) );
+                    OK( std::memcmp( utf32.data(), expect32.data(), num32 * 4 ) == 0 );
+
+                    // damage one byte at a few positions
+                    for (size_t pos = 0; pos < num_bytes; pos += 1 + num_bytes / 7)
+                    {
+                        const char saved = buffer[offset + pos];
+
+                        for (uint8 bad : { uint8( 0x80 ), uint8( 0xbf ), uint8( 0xc0 ), uint8( 0xe0 ), uint8( 0xed ), uint8( 0xf4 ), uint8( 0xff ), uint8( 'q' ) })
+                        {
+                            buffer[offset + pos] = char( bad );
+                            IS( k.validate( bytes, num_bytes ), reference_validate( bytes, num_bytes ) );
+                            IS( k.count_chars( bytes, num_bytes ), reference_count( text ) );
+                        }
+
+                        buffer[offset + pos] = saved;
+                    }
+                }
+            }
+        }
+
+        OK( "search, comparison and ASCII case" );
+        {
+            uint32 seed = 1;
+
+            for (size_t num : lengths)
+            {
+                // few distinct bytes, so that partial matches are frequent
+                std::vector<uint8> a( num + 1 );
+                for (size_t i = 0; i < num; i++)
+                    a[i] = uint8( "abAB\xc3\xa9"[next_random( seed ) % 6] );
+
+                for (size_t needle_num : { 1, 2, 3, 5, 17 })
+                {
+                    for (size_t start = 0; start + needle_num <= num; start += 1 + num / 5)
+                    {
+                        const uint8* needle = a.data() + start;
+                        const size_t expect = size_t( std::search( a.data(), a.data() + num, needle, needle + needle_num ) - a.data() );
+                        IS( k.find( a.data(), num, needle, needle_num ), expect );
+                    }
+                }
+
+                IS( k.find( a.data(), num, (const uint8*) "abx", 3 ), num );
+                IS( k.find( a.data(), num, (const uint8*) "", 0 ), size_t( 0 ) );
+
+                std::vector<uint8> b( a );
+                std::vector<uint8> folded( num + 1 );
+                IS( k.mismatch( a.data(), b.data(), num ), num );
+
+                k.ascii_to_upper( folded.data(), a.data(), num );
+                IS( k.mismatch( a.data(), folded.data(), num ), size_t( std::mismatch( a.data(), a.data() + num, folded.data() ).first - a.data() ) );
+
+                for (size_t pos = 0; pos < num; pos += 1 + num / 9)
+                {
+                    b[pos] ^= 0x01;
+                    IS( k.mismatch( a.data(), b.data(), num ), pos );
+                    b[pos] = a[pos];
+                }
+            }
+
+            // every byte value
+            uint8 all[256];
+            uint8 lower[256];
+            uint8 upper[256];
+
+            for (int i = 0; i < 256; i++)
+                all[i] = uint8( i );
+
+            k.ascii_to_lower( lower, all, 256 );
+            k.ascii_to_upper( upper, all, 256 );
+
+            for (int i = 0; i < 256; i++)
+            {
+                IS( int( lower[i] ), (i >= 'A' && i <= 'Z') ? i + 32 : i );
+                IS( int( upper[i] ), (i >= 'a' && i <= 'z') ? i - 32 : i );
+            }
+        }
+    };
+
+    OK( "baseline kernels" );
+    test_table( *get_utf8_kernels_baseline() );
+
+#if TREECORE_CPU_X86
+    if (get_cpu_feature_level() >= CPU_LEVEL_AVX2)
+    {
+        OK( "AVX2 kernels" );
+        test_table( *get_utf8_kernels_avx2() );
+    }
+#endif
+
+    OK( "malformed text is converted like getAndAdvance" );
+    {
+        const char* samples[] = {
+            "ab\x80" "cd",                // stray continuation decodes to zero
+            "\x85xyz",
+            "\xc3" "abc",                 // truncated sequence
+            "x\xe4\xb8" "abc",
+            "\xc0\xaf\xed\xa0\x80 ok",    // overlong and surrogate are decoded anyway
+            "\xf4\x90\x80\x80\xf0\x9f\x98\x80",
+            "\xf8\x88\x80\x80\x80 five",
+            "\xff\xfe ab",
+            "\xc3\xa9\xa9\xa9 tail",
+        };
+
+        for (const char* s : samples)
+        {
+            const size_t num_bytes = std::strlen( s );
+
+            uint16 utf16[64];
+            uint16 expect16[64];
+            const size_t num16 = utf8_to_utf16( s, num_bytes, utf16 );
+            CharPointer_UTF16( (CharPointer_UTF16::CharType*) expect16 ).writeAll( CharPointer_UTF8( s ) );
+
+            IS( num16, CharPointer_UTF16::getBytesRequiredFor( CharPointer_UTF8( s ) ) / 2 );
+            IS( utf8_utf16_length( s, num_bytes ), num16 );
+            OK( std::memcmp( utf16, expect16, num16 * 2 ) == 0 );
+
+            uint32 utf32[64];
+            uint32 expect32[64];
+            const size_t num32 = utf8_to_utf32( s, num_bytes, utf32 );
+            CharPointer_UTF32( (CharPointer_UTF32::CharType*) expect32 ).writeAll( CharPointer_UTF8( s ) );
+
+            IS( num32, CharPointer_UTF32( (CharPointer_UTF32::CharType*) expect32 ).length() );
+            IS( utf8_utf32_length( s, num_bytes ), num32 );
+            OK( std::memcmp( utf32, expect32, num32 * 4 ) == 0 );
+
+            // and counting up to a limit as well
+            IS( CharPointer_UTF8( s ).lengthUpTo( size_t( 3 ) ), CharacterFunctions::lengthUpTo( CharPointer_UTF8( s ), size_t( 3 ) ) );
+            IS( CharPointer_UTF8( s ).lengthUpTo( size_t( 100 ) ), CharacterFunctions::lengthUpTo( CharPointer_UTF8( s ), size_t( 100 ) ) );
+            IS( CharPointer_UTF8( s ).lengthUpTo( CharPointer_UTF8( s + num_bytes - 1 ) ),
+                CharacterFunctions::lengthUpTo( CharPointer_UTF8( s ), CharPointer_UTF8( s + num_bytes - 1 ) ) );
+
+            IS( String( CharPointer_UTF8( s ) ), String( CharPointer_UTF32( (CharPointer_UTF32::CharType*) expect32 ) ) );
+        }
+    }
+
+    OK( "String search, comparison and case, like character by character loops" );
+    {
+        const char* samples[] = {
+            "",
+            "a",
+            "abc",
+            "ABC",
+            "abd",
+            "ab",
+            "the quick brown fox jumps over the lazy dog, THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG",
+            "the quick brown fox jumps over the lazy dog, THE QUICK BROWN FOX JUMPS OVER THE LAZY CAT",
+            "caf\xc3\xa9 CAF\xc3\x89 caf\xc3\xa9s",
+            "caf\xc3\xa8",
+            "\xe4\xb8\xad\xe6\x96\x87 text \xe4\xb8\xad",
+            "\xe4\xb8\xad\xe6\x96\x88",
+            "\xf0\x9f\x98\x80 x",
+            "ab\x80" "cd",
+            "\xc3" "abc",
+            "\xc1\x81 A overlong",
+            "x\xe4\xb8" "abc",
+            "\xc3\xa9\xa9\xa9 tail",
+        };
+
+        auto reference_case = [&]( const char* s, bool to_upper ) -> String
+        {
+            String result;
+
+            for (CharPointer_UTF8 p( s );; ++p)
+            {
+                const treecore_wchar c = to_upper ? p.toUpperCase() : p.toLowerCase();
+                if (c == 0)
+                    break;
+
+                result += c;
+            }
+
+            return result;
+        };
+
+        for (const char* s1 : samples)
+        {
+            const CharPointer_UTF8 p1( s1 );
+
+            for (const char* s2 : samples)
+            {
+                const CharPointer_UTF8 p2( s2 );
+                const int expect = CharacterFunctions::compare( p1, p2 );
+                const int got    = p1.compare( p2 );
+                OK( (expect < 0) == (got < 0) && (expect > 0) == (got > 0) );
+
+                IS( p1.indexOf( p2 ), CharacterFunctions::indexOf( p1, p2 ) );
+
+                // substrings of the other sample, starting at every byte
+                for (size_t start = 0; s2[start] != 0; start++)
+                {
+                    for (size_t len = 1; len <= 4 && s2[start + len - 1] != 0; len++)
+                    {
+                        char needle[8] = {};
+                        std::memcpy( needle, s2 + start, len );
+                        IS( p1.indexOf( CharPointer_UTF8( needle ) ), CharacterFunctions::indexOf( p1, CharPointer_UTF8( needle ) ) );
+                    }
+                }
+            }
+
+            for (treecore_wchar c : { treecore_wchar( 'a' ), treecore_wchar( 'A' ), treecore_wchar( 'x' ), treecore_wchar( 0x41 ), treecore_wchar( 0xe9 ), treecore_wchar( 0 ) })
+                IS( p1.indexOf( c ), CharacterFunctions::indexOfChar( p1, c ) );
+
+            const String s( p1 );
+            IS( s.toLowerCase(), reference_case( s.toRawUTF8(), false ) );
+            IS( s.toUpperCase(), reference_case( s.toRawUTF8(), true ) );
+            OK( s.contains( "e" ) == (CharacterFunctions::indexOf( p1, CharPointer_UTF8( "e" ) ) >= 0) );
+        }
+
+        // long text, so that chunks and registers are crossed
+        String long_text;
+        for (int i = 0; i < 3000; i++)
+            long_text += (i % 7 == 0) ? String( CharPointer_UTF8( "\xc3\xa9" ) ) : String::charToString( treecore_wchar( 'a' + i % 26 ) );
+
+        IS( long_text.toUpperCase(), reference_case( long_text.toRawUTF8(), true ) );
+        IS( long_text.toUpperCase().toLowerCase(), long_text );
+        IS( long_text.indexOf( "xyz" ), CharacterFunctions::indexOf( long_text.getCharPointer(), CharPointer_UTF8( "xyz" ) ) );
+        IS( long_text.indexOf( "zab" ), CharacterFunctions::indexOf( long_text.getCharPointer(), CharPointer_UTF8( "zab" ) ) );
+
+        const String other = long_text.replaceSection( 2800, 1, "!" );
+        OK( long_text.compare( other ) > 0 );
+        OK( other.compare( long_text ) < 0 );
+        IS( long_text.compare( long_text + "" ), 0 );
+
+        // matches at and across the boundaries of search chunks
+        for (int prefix_len : { 1000, 1020, 1023, 1024, 1025, 2046, 2050 })
+        {
+            String haystack;
+            for (int i = 0; i < prefix_len; i++)
+                haystack += (i % 2 == 0) ? "a" : "b";
+
+            haystack += "needle tail";
+            IS( haystack.indexOf( "needle" ), prefix_len );
+            IS( haystack.indexOf( "needles" ), -1 );
+            IS( haystack.indexOf( "abneedle" ), CharacterFunctions::indexOf( haystack.getCharPointer(), CharPointer_UTF8( "abneedle" ) ) );
+        }
+    }
+
+    OK( "CharPointer_UTF8 and String" );
+    {
+        for (size_t num_chars : lengths)
+        {
+            const size_t num_bytes = make_text( 1, num_chars * 3, uint32( num_chars ), false );
+            const char* text = buffer.data() + 1;
+            const CharPointer_UTF8 p( text );
+
+            IS( p.length(), reference_count( text ) );
+            OK( CharPointer_UTF8::isValidString( text, int(num_bytes) ) );
+
+            for (size_t max_chars : { size_t( 0 ), size_t( 1 ), num_chars, num_chars * 3 + 1, size_t( 1000 ) })
+                IS( p.lengthUpTo( max_chars ), CharacterFunctions::lengthUpTo( p, max_chars ) );
+
+            for (size_t end = 0; end <= num_bytes; end += 1 + num_bytes / 5)
+                IS( p.lengthUpTo( CharPointer_UTF8( text + end ) ), CharacterFunctions::lengthUpTo( p, CharPointer_UTF8( text + end ) ) );
+
+            const String s( p );
+            IS( s.length(), int( reference_count( text ) ) );
+            OK( std::strcmp( s.toRawUTF8(), text ) == 0 );
+
+            std::vector<uint16> expect16( num_bytes * 2 + 2 );
+            CharPointer_UTF16( (CharPointer_UTF16::CharType*) expect16.data() ).writeAll( p );
+            const CharPointer_UTF16 utf16 = s.toUTF16();
+            OK( std::memcmp( utf16.getAddress(), expect16.data(), CharPointer_UTF16::getBytesRequiredFor( p ) + 2 ) == 0 );
+
+            std::vector<uint32> expect32( num_bytes + 1 );
+            CharPointer_UTF32( (CharPointer_UTF32::CharType*) expect32.data() ).writeAll( p );
+            const CharPointer_UTF32 utf32 = s.toUTF32();
+            OK( std::memcmp( utf32.getAddress(), expect32.data(), (reference_count( text ) + 1) * 4 ) == 0 );
+            IS( String( utf32 ), s );
+            IS( String( utf16 ), s );
+        }
+
+        // limit falls inside a multi-byte character
+        const char* euro = "\xe2\x82\xac\xe2\x82\xac";
+        IS( CharPointer_UTF8( euro ).lengthUpTo( size_t( 1 ) ), size_t( 1 ) );
+        IS( CharPointer_UTF8( euro ).lengthUpTo( CharPointer_UTF8( euro + 4 ) ), size_t( 2 ) );
+        OK( !CharPointer_UTF8::isValidString( euro, 4 ) );
+        OK( CharPointer_UTF8::isValidString( euro, 6 ) );
+        OK( !CharPointer_UTF8::isValidString( "\xed\xa0\x80", 3 ) );
+    }
+}
@@ -0,0 +1,163 @@
+#include "treecore/File.h"
+#include "treecore/FileSearchPath.h"
+#include "treecore/MT19937.h"
+#include "treecore/WildcardFileFilter.h"
+#include "treecore/WildcardMatcher.h"
+
+#include "treecore/TestFramework.h"
+
+using namespace treecore;
+
+static String random_text( MT19937& r, const String& alphabet, int max_length )
+{
+    const int length = int( r.next_uint64_in_range( uint64( max_length ) ) );
+
+    String result;
+    for (int i = 0; i < length; i++)
+        result += alphabet[int( r.next_uint64_in_range( uint64( alphabet.length() ) ) )];
+
+    return result;
+}
+
+// String::matchesWildcard() doesn't let "**" match nothing at the end of the
+// text, so the patterns have no stars next to each other
+static String without_double_stars( String pattern )
+{
+    while ( pattern.contains( "**" ) )
+        pattern = pattern.replace( "**", "*" );
+
+    return pattern;
+}
+
+static String random_pattern( MT19937& r, const String& alphabet, int max_length )
+{
+    return without_double_stars( random_text( r, alphabet + "**??", max_length ) );
+}
+
+static bool matches_any( const StringArray& patterns, const String& text, bool ignore_case )
+{
+    for (const String& pattern : patterns)
+        if ( text.matchesWildcard( pattern, ignore_case ) )
+            return true;
+
+    return false;
+}
+
+void TestFramework::content( int argc, char** argv )
+{
+    MT19937& r = *MT19937::getInstance();
+
+    // single patterns
+    {
+        const WildcardMatcher cpp( "*.cpp", true );
+        OK( cpp.matches( "main.cpp" ) );
+        OK( cpp.matches( "MAIN.CPP" ) );
+        OK( cpp.matches( ".cpp" ) );
+        OK( !cpp.matches( "main.cpp.bak" ) );
+        OK( !cpp.matches( "main.c" ) );
+
+        const WildcardMatcher question( "a?c", false );
+        OK( question.matches( "abc" ) );
+        OK( question.matches( "a?c" ) );
+        OK( !question.matches( "ac" ) );
+        OK( !question.matches( "abbc" ) );
+        OK( !question.matches( "ABC" ) );
+
+        const WildcardMatcher empty( "", false );
+        OK( empty.matches( "" ) );
+        OK( !empty.matches( "a" ) );
+
+        const WildcardMatcher nothing;
+        OK( !nothing.matches( "" ) );
+        OK( !nothing.matches( "a" ) );
+
+        const WildcardMatcher wide( CharPointer_UTF8( "caf\xc3\xa9 ?" ), false );
+        OK( wide.matches( "caf\xc3\xa9 \xe2\x82\xac" ) );
+        OK( !wide.matches( "cafe \xe2\x82\xac" ) );
+    }
+
+    // sets of patterns, the same as trying each with String::matchesWildcard()
+    {
+        const String alphabet = CharPointer_UTF8( "abAB.\xc3\xa9" );
+        int num_failed = 0;
+
+        for (int i = 0; i < 500; i++)
+        {
+            const bool ignore_case = i % 2 == 0;
+            StringArray patterns;
+
+            for (int k = int( r.next_uint64_in_range( 5 ) ); k >= 0; k--)
+                patterns.add( random_pattern( r, alphabet, 8 ) );
+
+            const WildcardMatcher matcher( patterns, ignore_case );
+
+            for (int j = 0; j < 50; j++)
+            {
+                const String text = random_text( r, alphabet, 10 );
+
+                if ( matcher.matches( text ) != matches_any( patterns, text, ignore_case ) )
+                    num_failed++;
+            }
+        }
+
+        IS( num_failed, 0 );
+    }
+
+    // sets too large for an automaton
+    {
+        StringArray patterns;
+        patterns.add( "*a?????????????" );
+        for (int i = 0; i < 40; i++)
+            patterns.add( without_double_stars( random_pattern( r, "ab", 6 ) + "*" + random_pattern( r, "ab", 6 ) ) );
+
+        const WildcardMatcher matcher( patterns, false );
+        IS( matcher.getNumStates(), 0 );
+
+        int num_failed = 0;
+
+        for (int j = 0; j < 2000; j++)
+        {
+            const String text = random_text( r, "abc", 40 );
+
+            if ( matcher.matches( text ) != matches_any( patterns, text, false ) )
+                num_failed++;
+        }
+
+        IS( num_failed, 0 );
+    }
+
+    // file filters
+    {
+        const WildcardFileFilter filter( "*.wav;*.AIFF, *.*", "", "audio" );
+        OK( filter.isFileSuitable( File( "/tmp/sound.wav" ) ) );
+        OK( filter.isFileSuitable( File( "/tmp/noextension" ) ) );
+
+        const WildcardFileFilter audio( "*.wav;*.aiff", "", "audio" );
+        OK( audio.isFileSuitable( File( "/tmp/Sound.AIFF" ) ) );
+        OK( !audio.isFileSuitable( File( "/tmp/sound.mp3" ) ) );
+        OK( !audio.isDirectorySuitable( File( "/tmp/sounds" ) ) );
+
+        const StringArray split = WildcardMatcher::splitPatterns( " *.jpg ; *.png,,\"a;b\"" );
+        IS( split.size(), 3 );
+        IS( split[2], String( "\"a;b\"" ) );
+    }
+
+    // searching a path matches case the same way as DirectoryIterator
+    {
+        const File dir = File::getSpecialLocation( File::tempDirectory ).getNonexistentChildFile( "t_wildcard_matcher", "" );
+        OK( dir.createDirectory() );
+        OK( dir.getChildFile( "Notes.TXT" ).create() );
+        OK( dir.getChildFile( "sub" ).getChildFile( "more.txt" ).create() );
+
+        const FileSearchPath path( dir.getFullPathName() );
+        const int num_if_case_ignored = File::areFileNamesCaseSensitive() ? 0 : 1;
+        Array<File> found;
+
+        IS( path.findChildFiles( found, File::findFiles, false, "*.txt" ), 1 );
+        IS( path.findChildFiles( found, File::findFiles, false, "*.txt;*.md" ), num_if_case_ignored );
+        IS( path.findChildFiles( found, File::findFiles, true, "*.txt" ), 1 + num_if_case_ignored );
+        IS( path.findChildFiles( found, File::findFiles, true, WildcardMatcher( "*.txt", true ) ), 2 );
+
+        OK( dir.deleteRecursively() );
+    }
+}
@@ -0,0 +1,94 @@
+#include "treecore/BinaryEncoding.h"
+#include "treecore/CpuDispatch.h"
+#include "treecore/MemoryBlock.h"
+#include "treecore/String.h"
+#include "treecore/StringRef.h"
+#include "treecore/Time.h"
+
+#include "treecore/internal/BinaryEncoding_impl.h"
+
+#include <cstdio>
+#include <vector>
+
+using namespace treecore;
+
+#define DATA_BYTES (1 << 20)
+#define NUM_ITER   50
+
+//
+// throughput of base64 and hex codecs on 1 MB of random data, for the
+// baseline kernels and the ones chosen for current CPU
+//
+static std::vector<uint8> data;
+static std::vector<char>  text;
+static std::vector<uint8> decoded;
+static volatile size_t sink;
+
+// return MB per second
+template<typename Func>
+static double measure( Func func )
+{
+    const int64 t0 = Time::getHighResolutionTicks();
+    for (int i = 0; i < NUM_ITER; i++)
+        func();
+    const int64 t1 = Time::getHighResolutionTicks();
+
+    return NUM_ITER * double(DATA_BYTES) / (1 << 20) / Time::highResolutionTicksToSeconds( t1 - t0 );
+}
+
+static void print_row( const char* name, double baseline, double best )
+{
+    printf( "%-24s %12.0f %12.0f %8.2fx\n", name, baseline, best, best / baseline );
+}
+
+int main( int argc, char** argv )
+{
+    data.resize( DATA_BYTES );
+    text.resize( DATA_BYTES * 2 );
+    decoded.resize( DATA_BYTES );
+
+    uint32 seed = 1;
+    for (size_t i = 0; i < DATA_BYTES; i++)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        data[i] = uint8( seed >> 24 );
+    }
+
+    const BinaryEncodingKernelTable& baseline = *get_binary_encoding_kernels_baseline();
+
+    printf( "CPU feature level: %s\n", get_cpu_feature_level_name( get_cpu_feature_level() ) );
+    printf( "MB of binary data per second\n" );
+    printf( "%-24s %12s %12s %9s\n", "operation", "baseline", "dispatched", "speedup" );
+
+    // DATA_BYTES is not a multiple of three, leave out the last group
+    const size_t num_groups = DATA_BYTES / 3;
+
+    print_row( "base64 encode",
+               measure( [&] { baseline.base64_encode( data.data(), num_groups * 3, text.data(), BASE64_STANDARD ); } ),
+               measure( [] { sink = base64_encode( data.data(), DATA_BYTES, text.data() ); } ) );
+
+    const size_t num_chars = base64_encode( data.data(), DATA_BYTES, text.data() );
+
+    print_row( "base64 decode",
+               measure( [&] { sink = baseline.base64_decode( text.data(), num_groups * 4, decoded.data(), BASE64_STANDARD ); } ),
+               measure( [num_chars] { sink = base64_decode( text.data(), num_chars, decoded.data() ); } ) );
+
+    print_row( "hex encode",
+               measure( [&] { baseline.hex_encode( data.data(), DATA_BYTES, text.data(), false ); } ),
+               measure( [] { hex_encode( data.data(), DATA_BYTES, text.data() ); } ) );
+
+    print_row( "hex decode",
+               measure( [&] { sink = baseline.hex_decode( text.data(), DATA_BYTES, decoded.data() ); } ),
+               measure( [] { sink = hex_decode( text.data(), DATA_BYTES * 2, decoded.data() ); } ) );
+
+    // MemoryBlock functions, including allocation of results
+    const MemoryBlock block( data.data(), DATA_BYTES );
+    const String base64 = block.toBase64String();
+    MemoryBlock back;
+
+    printf( "\n%-24s %12s\n", "MemoryBlock", "MB/s" );
+    printf( "%-24s %12.0f\n", "toBase64Encoding",     measure( [&] { sink = block.toBase64Encoding().length(); } ) );
+    printf( "%-24s %12.0f\n", "toBase64String",       measure( [&] { sink = block.toBase64String().length(); } ) );
+    printf( "%-24s %12.0f\n", "loadFromBase64String", measure( [&] { sink = back.loadFromBase64String( base64 ); } ) );
+    printf( "%-24s %12.0f\n", "toHexString",          measure( [&] { sink = block.toHexString().length(); } ) );
+}
@@ -0,0 +1,75 @@
+#include "treecore/Checksum.h"
+#include "treecore/CpuDispatch.h"
+#include "treecore/GZIPCompressorOutputStream.h"
+#include "treecore/MemoryOutputStream.h"
+#include "treecore/Time.h"
+
+#include "treecore/internal/Checksum_impl.h"
+
+#include <cstdio>
+#include <vector>
+
+using namespace treecore;
+
+#define DATA_BYTES (1 << 20)
+#define NUM_ITER   200
+
+//
+// throughput of checksums on 1 MB of random data, for the baseline kernels
+// and the ones chosen for current CPU
+//
+static std::vector<uint8> data;
+static volatile uint32 sink;
+
+// return MB per second
+template<typename Func>
+static double measure( Func func, int num_iter = NUM_ITER )
+{
+    const int64 t0 = Time::getHighResolutionTicks();
+    for (int i = 0; i < num_iter; i++)
+        func();
+    const int64 t1 = Time::getHighResolutionTicks();
+
+    return num_iter * double(DATA_BYTES) / (1 << 20) / Time::highResolutionTicksToSeconds( t1 - t0 );
+}
+
+static void print_row( const char* name, double baseline, double best )
+{
+    printf( "%-24s %12.0f %12.0f %8.2fx\n", name, baseline, best, best / baseline );
+}
+
+int main( int argc, char** argv )
+{
+    data.resize( DATA_BYTES );
+
+    uint32 seed = 1;
+    for (size_t i = 0; i < DATA_BYTES; i++)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        data[i] = uint8( seed >> 24 );
+    }
+
+    printf( "CPU feature level: %s\n", get_cpu_feature_level_name( get_cpu_feature_level() ) );
+    printf( "MB of data per second\n" );
+    printf( "%-24s %12s %12s %9s\n", "checksum", "baseline", "dispatched", "speedup" );
+
+    print_row( "CRC-32",
+               measure( [] { sink = crc32_baseline( 0, data.data(), DATA_BYTES ); } ),
+               measure( [] { sink = checksum_crc32( 0, data.data(), DATA_BYTES ); } ) );
+
+    print_row( "CRC-32C",
+               measure( [] { sink = crc32c_baseline( 0, data.data(), DATA_BYTES ); } ),
+               measure( [] { sink = checksum_crc32c( 0, data.data(), DATA_BYTES ); } ) );
+
+    print_row( "Adler-32",
+               measure( [] { sink = adler32_baseline( 1, data.data(), DATA_BYTES ); } ),
+               measure( [] { sink = checksum_adler32( 1, data.data(), DATA_BYTES ); } ) );
+
+    // whole gzip stream at fastest level, where checksum is a larger share of time
+    printf( "\n%-24s %12s\n", "gzip level 1", "MB/s" );
+    printf( "%-24s %12.0f\n", "GZIPCompressorOutputStream", measure( [] {
+        MemoryOutputStream out;
+        GZIPCompressorOutputStream zipper( &out, 1, false, GZIPCompressorOutputStream::windowBitsGZIP );
+        zipper.write( data.data(), DATA_BYTES );
+    }, 10 ) );
+}
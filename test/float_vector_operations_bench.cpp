@@ -0,0 +1,121 @@
+#include "treecore/AlignedMalloc.h"
+#include "treecore/CpuDispatch.h"
+#include "treecore/FloatVectorOperations.h"
+#include "treecore/Time.h"
+
+#include <cstdio>
+
+using namespace treecore;
+
+#define NUM_ITER 20000
+
+//
+// compares plain loops with FloatVectorOperations on buffer sizes that fit in
+// L1, L2 and last level cache
+//
+static const int buffer_sizes[] = { 256, 4096, 65536 };
+
+static float* a;
+static float* b;
+static float* dest;
+static int16* src16;
+static volatile float sink;
+
+// plain loops, as they would be written without FloatVectorOperations
+static void scalar_add( float* d, const float* s1, const float* s2, int num )
+{
+    for (int i = 0; i < num; i++) d[i] = s1[i] + s2[i];
+}
+
+static void scalar_add_with_multiply( float* d, const float* s, float m, int num )
+{
+    for (int i = 0; i < num; i++) d[i] += s[i] * m;
+}
+
+static float scalar_dot( const float* s1, const float* s2, int num )
+{
+    float result = 0.0f;
+    for (int i = 0; i < num; i++) result += s1[i] * s2[i];
+    return result;
+}
+
+static float scalar_sum( const float* s, int num )
+{
+    float result = 0.0f;
+    for (int i = 0; i < num; i++) result += s[i];
+    return result;
+}
+
+static void scalar_convert16( float* d, const int16* s, float m, int num )
+{
+    for (int i = 0; i < num; i++) d[i] = float( s[i] ) * m;
+}
+
+// run one operation enough times to move ~NUM_ITER * 4096 floats, return
+// nanoseconds per element
+template<typename Func>
+static double measure( int num, Func func )
+{
+    const int rounds = int( int64( NUM_ITER ) * 4096 / num );
+
+    const int64 t0 = Time::getHighResolutionTicks();
+    for (int i = 0; i < rounds; i++)
+        func();
+    const int64 t1 = Time::getHighResolutionTicks();
+
+    return Time::highResolutionTicksToSeconds( t1 - t0 ) * 1.0e9 / (double( rounds ) * num);
+}
+
+static void print_row( const char* name, int num, double t_scalar, double t_vector )
+{
+    printf( "%-20s %8d %12.3f %12.3f %8.2fx\n", name, num, t_scalar, t_vector, t_scalar / t_vector );
+}
+
+int main( int argc, char** argv )
+{
+    const int max_size = 65536;
+    a     = (float*) aligned_malloc( max_size * sizeof(float), 64 );
+    b     = (float*) aligned_malloc( max_size * sizeof(float), 64 );
+    dest  = (float*) aligned_malloc( max_size * sizeof(float), 64 );
+    src16 = (int16*) aligned_malloc( max_size * sizeof(int16), 64 );
+
+    for (int i = 0; i < max_size; i++)
+    {
+        a[i]     = float( i % 97 ) * 0.01f;
+        b[i]     = float( i % 89 ) * 0.02f;
+        dest[i]  = 0.0f;
+        src16[i] = int16( i * 13 );
+    }
+
+    printf( "CPU feature level: %s\n", get_cpu_feature_level_name( get_cpu_feature_level() ) );
+    printf( "ns per element\n" );
+    printf( "%-20s %8s %12s %12s %9s\n", "operation", "size", "scalar", "vector", "speedup" );
+
+    for (int num : buffer_sizes)
+    {
+        print_row( "add", num,
+                   measure( num, [num] { scalar_add( dest, a, b, num ); } ),
+                   measure( num, [num] { FloatVectorOperations::add( dest, a, b, num ); } ) );
+
+        print_row( "addWithMultiply", num,
+                   measure( num, [num] { scalar_add_with_multiply( dest, a, 0.001f, num ); } ),
+                   measure( num, [num] { FloatVectorOperations::addWithMultiply( dest, a, 0.001f, num ); } ) );
+
+        print_row( "dotProduct", num,
+                   measure( num, [num] { sink = scalar_dot( a, b, num ); } ),
+                   measure( num, [num] { sink = FloatVectorOperations::dotProduct( a, b, num ); } ) );
+
+        print_row( "sum", num,
+                   measure( num, [num] { sink = scalar_sum( a, num ); } ),
+                   measure( num, [num] { sink = FloatVectorOperations::sum( a, num ); } ) );
+
+        print_row( "convert int16", num,
+                   measure( num, [num] { scalar_convert16( dest, src16, 1.0f / 32768.0f, num ); } ),
+                   measure( num, [num] { FloatVectorOperations::convertFixedToFloat( dest, src16, 1.0f / 32768.0f, num ); } ) );
+    }
+
+    aligned_free( a );
+    aligned_free( b );
+    aligned_free( dest );
+    aligned_free( src16 );
+}
@@ -0,0 +1,111 @@
+#include "treecore/AtomicObject.h"
+#include "treecore/Identifier.h"
+#include "treecore/String.h"
+#include "treecore/StringPool.h"
+#include "treecore/Thread.h"
+#include "treecore/Time.h"
+
+#include <cstdio>
+#include <vector>
+
+using namespace treecore;
+
+#define NUM_NAMES 4096
+#define NUM_ITER  1000000
+
+//
+// Identifier construction from many threads at once, as done by parsers
+// running on worker threads. Most names already exist in the pool, and
+// every thread also adds a few names of its own.
+//
+static std::vector<String> names;
+
+struct ConstructThread: public Thread
+{
+    ConstructThread( int index, AtomicObject<int32>& go )
+        : Thread( "construct" )
+        , index( index )
+        , go( go )
+    {}
+
+    void run() override
+    {
+        while ( go.load() == 0 )
+            Thread::yield();
+
+        uint32 seed = uint32( index ) + 1;
+
+        for (int i = 0; i < NUM_ITER; i++)
+        {
+            seed = seed * 1664525u + 1013904223u;
+
+            if (i % 1024 == 0)
+            {
+                // new name, which takes the insert path
+                const Identifier id( String( "thread_" ) + String( index ) + "_" + String( i ) );
+                num_valid += id.isValid() ? 1 : 0;
+            }
+            else
+            {
+                const Identifier id( names[(seed >> 8) % NUM_NAMES].toRawUTF8() );
+                num_valid += id.isValid() ? 1 : 0;
+            }
+        }
+    }
+
+    int index;
+    AtomicObject<int32>& go;
+    int64 num_valid = 0;
+};
+
+// return nanoseconds per construction, as seen by one thread
+static double run_one( int num_threads )
+{
+    AtomicObject<int32> go( 0 );
+    std::vector<ConstructThread*> threads;
+
+    for (int i = 0; i < num_threads; i++)
+    {
+        threads.push_back( new ConstructThread( i, go ) );
+        threads.back()->startThread();
+    }
+
+    const int64 t0 = Time::getHighResolutionTicks();
+    go = 1;
+
+    for (ConstructThread* thread : threads)
+        thread->waitForThreadToExit( -1 );
+
+    const int64 t1 = Time::getHighResolutionTicks();
+
+    for (ConstructThread* thread : threads)
+    {
+        if (thread->num_valid != NUM_ITER)
+            fprintf( stderr, "invalid identifier created\n" );
+        delete thread;
+    }
+
+    return Time::highResolutionTicksToSeconds( t1 - t0 ) * 1.0e9 / double(NUM_ITER);
+}
+
+int main( int argc, char** argv )
+{
+    for (int i = 0; i < NUM_NAMES; i++)
+    {
+        names.push_back( String( "property_name_" ) + String( i * 7919 ) );
+        Identifier id( names.back() );
+    }
+
+    const int thread_counts[] = { 1, 2, 4, 8, 16 };
+
+    printf( "ns per Identifier construction, %d constructions per thread\n", NUM_ITER );
+    printf( "%8s %16s %20s\n", "threads", "ns", "million per second" );
+
+    for (int num_threads : thread_counts)
+    {
+        const double ns = run_one( num_threads );
+        printf( "%8d %16.1f %20.1f\n", num_threads, ns, num_threads * 1.0e3 / ns );
+    }
+
+    StringPool::releaseInstance();
+}
@@ -0,0 +1,73 @@
+#include "treecore/DynamicObject.h"
+#include "treecore/HashMap.h"
+#include "treecore/Identifier.h"
+#include "treecore/IdentifierMap.h"
+#include "treecore/Time.h"
+#include "treecore/Variant.h"
+
+#include <cstdio>
+
+using namespace treecore;
+
+//
+// looking up properties by Identifier, in a HashMap, in an IdentifierMap and
+// in a DynamicObject
+//
+static volatile int sink;
+
+// return nanoseconds per call
+template<typename Func>
+static double measure( int num_iter, Func func )
+{
+    const int64 t0 = Time::getHighResolutionTicks();
+    for (int i = 0; i < num_iter; i++)
+        func( i );
+    const int64 t1 = Time::getHighResolutionTicks();
+
+    return Time::highResolutionTicksToSeconds( t1 - t0 ) * 1.0e9 / double(num_iter);
+}
+
+int main( int argc, char** argv )
+{
+    printf( "ns per lookup\n" );
+    printf( "%-12s %10s %14s %14s\n", "properties", "HashMap", "IdentifierMap", "DynamicObject" );
+
+    const int nums_properties[] = { 4, 8, 16, 64, 1024 };
+
+    for (int num_properties : nums_properties)
+    {
+        Array<Identifier> keys;
+        for (int i = 0; i < num_properties; i++)
+            keys.add( Identifier( String( "property_" ) + String( i ) ) );
+
+        HashMap<Identifier, var> hash_map;
+        IdentifierMap<var> identifier_map;
+        DynamicObject::Ptr object = new DynamicObject();
+
+        for (int i = 0; i < num_properties; i++)
+        {
+            hash_map.set( keys[i], i );
+            identifier_map.set( keys[i], i );
+            object->setProperty( keys[i], i );
+        }
+
+        const int num_iter = 4000000;
+        const int mask     = num_properties - 1;
+
+        const double t_hash = measure( num_iter, [&] ( int i ) {
+            sink = int(hash_map[keys[(i * 7) & mask]]);
+        } );
+
+        const double t_identifier = measure( num_iter, [&] ( int i ) {
+            sink = int(*identifier_map.find( keys[(i * 7) & mask] ));
+        } );
+
+        const double t_object = measure( num_iter, [&] ( int i ) {
+            sink = int(object->getProperty( keys[(i * 7) & mask] ));
+        } );
+
+        printf( "%-12d %10.1f %14.1f %14.1f\n", num_properties, t_hash, t_identifier, t_object );
+    }
+
+    return 0;
+}
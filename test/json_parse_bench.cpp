@@ -0,0 +1,82 @@
+#include "treecore/CpuDispatch.h"
+#include "treecore/JSON.h"
+#include "treecore/Result.h"
+#include "treecore/StringPool.h"
+#include "treecore/Time.h"
+#include "treecore/Variant.h"
+
+#include <cstdio>
+
+using namespace treecore;
+
+#define NUM_ITER 10
+
+//
+// compares JSONParser, which walks text one character at a time, with
+// JSON::parse, which jumps between positions found by JSONScanner
+//
+static String make_records( int num_records, int text_length, bool indented )
+{
+    String text_value;
+    for (int i = 0; i < text_length; i++)
+        text_value += treecore_wchar( 'a' + i % 26 );
+
+    String result( "[" );
+
+    for (int i = 0; i < num_records; i++)
+    {
+        if (i > 0)
+            result += ",";
+
+        if (indented)
+            result += "\n    ";
+
+        result += "{\"id\": " + String( i ) + ", \"name\": \"record " + String( i ) + "\", \"score\": " + String( i * 0.25 )
+                  + ", \"active\": true, \"tags\": [\"x\", \"y\", \"z\"], \"text\": \"" + text_value + "\"}";
+    }
+
+    return result + "\n]";
+}
+
+// return milliseconds per parse
+template<typename Func>
+static double measure( Func func )
+{
+    const int64 t0 = Time::getHighResolutionTicks();
+    for (int i = 0; i < NUM_ITER; i++)
+        func();
+    const int64 t1 = Time::getHighResolutionTicks();
+
+    return Time::highResolutionTicksToSeconds( t1 - t0 ) * 1.0e3 / NUM_ITER;
+}
+
+int main( int argc, char** argv )
+{
+    printf( "CPU feature level: %s\n", get_cpu_feature_level_name( get_cpu_feature_level() ) );
+    printf( "%-28s %10s %12s %12s %9s\n", "document", "MB", "JSONParser", "JSON::parse", "speedup" );
+
+    struct Document
+    {
+        const char* name;
+        int text_length;
+        bool indented;
+    };
+
+    const Document documents[] = {
+        { "short strings",          8, false },
+        { "short strings, indented", 8, true },
+        { "long strings",           400, false },
+    };
+
+    for (const Document& doc : documents)
+    {
+        const String text = make_records( 20000, doc.text_length, doc.indented );
+
+        const double t_old = measure( [&] { var v; JSONParser::parseObjectOrArray( text.getCharPointer(), v ); } );
+        const double t_new = measure( [&] { var v; JSON::parse( text, v ); } );
+
+        printf( "%-28s %10.2f %12.2f %12.2f %8.2fx\n", doc.name, text.getNumBytesAsUTF8() / 1048576.0, t_old, t_new, t_old / t_new );
+    }
+
+    StringPool::releaseInstance();
+}
@@ -0,0 +1,87 @@
+#include "treecore/File.h"
+#include "treecore/LocalisedStrings.h"
+#include "treecore/MemoryOutputStream.h"
+#include "treecore/ScopedPointer.h"
+#include "treecore/StringBuilder.h"
+#include "treecore/Time.h"
+
+#include <cstdio>
+
+using namespace treecore;
+
+//
+// loading a translation file with 20000 strings, as text and in binary form,
+// and translating every string
+//
+
+static double seconds_since( int64 t0 )
+{
+    return Time::highResolutionTicksToSeconds( Time::getHighResolutionTicks() - t0 );
+}
+
+static int translate_all( const LocalisedStrings& strings, const StringArray& keys )
+{
+    int total = 0;
+
+    for (int round = 0; round < 20; round++)
+        for (const String& key : keys)
+            total += strings.translate( key ).isNotEmpty() ? 1 : 0;
+
+    return total;
+}
+
+int main( int argc, char** argv )
+{
+    const int num_keys = 20000;
+    StringArray keys;
+    StringBuilder text;
+    text << "language: German\ncountries: de at ch\n\n";
+
+    for (int i = 0; i < num_keys; i++)
+    {
+        keys.add( "Settings/Audio/Device " + String( i ) + ": buffer size in samples" );
+        text << "\"" << keys[i] << "\" = \"Einstellungen/Audio/Ger\xc3\xa4t " << i << ": Puffergr\xc3\xb6\xc3\x9f" "e in Samples\"\n";
+    }
+
+    const String contents = text.toString();
+    const File file = File::getSpecialLocation( File::tempDirectory ).getNonexistentChildFile( "localised_strings_bench", ".bin" );
+
+    for (int round = 0; round < 3; round++)
+    {
+        int64 t0 = Time::getHighResolutionTicks();
+        LocalisedStrings parsed( contents, false );
+        const double t_parse = seconds_since( t0 );
+
+        t0 = Time::getHighResolutionTicks();
+        LocalisedStrings frozen( parsed );
+        frozen.freeze();
+        const double t_freeze = seconds_since( t0 );
+
+        if (round == 0)
+        {
+            MemoryOutputStream binary;
+            frozen.writeBinaryToStream( binary );
+            file.replaceWithData( binary.getData(), binary.getDataSize() );
+        }
+
+        t0 = Time::getHighResolutionTicks();
+        ScopedPointer<LocalisedStrings> mapped( LocalisedStrings::loadBinaryFile( file ) );
+        const double t_map = seconds_since( t0 );
+
+        t0 = Time::getHighResolutionTicks();
+        const int total_map = translate_all( parsed, keys );
+        const double t_translate_map = seconds_since( t0 );
+
+        t0 = Time::getHighResolutionTicks();
+        const int total_frozen = translate_all( frozen, keys );
+        const double t_translate_frozen = seconds_since( t0 );
+
+        printf( "load: text %7.1fms  freeze %6.1fms  binary file %6.1fms   400k translations: HashMap %7.1fms  frozen %7.1fms   %s\n",
+                t_parse * 1000.0, t_freeze * 1000.0, t_map * 1000.0,
+                t_translate_map * 1000.0, t_translate_frozen * 1000.0,
+                total_map == total_frozen && mapped != nullptr ? "same results" : "DIFFERENT RESULTS" );
+    }
+
+    file.deleteFile();
+    return 0;
+}
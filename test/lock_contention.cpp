@@ -0,0 +1,88 @@
+#include "treecore/AdaptiveMutex.h"
+#include "treecore/AtomicObject.h"
+#include "treecore/CriticalSection.h"
+#include "treecore/SpinLock.h"
+#include "treecore/Thread.h"
+#include "treecore/Time.h"
+
+#include <cstdio>
+
+using namespace treecore;
+
+#define NUM_ITER 200000
+
+template<typename LockType>
+struct ContentionThread: public Thread
+{
+    ContentionThread( const LockType& lock, int64& counter, AtomicObject<int32>& go )
+        : Thread( "contention" )
+        , lock( lock )
+        , counter( counter )
+        , go( go )
+    {}
+
+    void run() override
+    {
+        while ( go.load() == 0 )
+            Thread::yield();
+
+        for (int i = 0; i < NUM_ITER; i++)
+        {
+            const GenericScopedLock<LockType> scope( lock );
+            counter++;
+        }
+    }
+
+    const LockType& lock;
+    int64& counter;
+    AtomicObject<int32>& go;
+};
+
+template<typename LockType>
+double run_one( int num_threads )
+{
+    LockType lock;
+    int64 counter = 0;
+    AtomicObject<int32> go( 0 );
+
+    ContentionThread<LockType>** threads = new ContentionThread<LockType>*[num_threads];
+    for (int i = 0; i < num_threads; i++)
+    {
+        threads[i] = new ContentionThread<LockType>( lock, counter, go );
+        threads[i]->startThread();
+    }
+
+    const int64 t0 = Time::getHighResolutionTicks();
+    go = 1;
+
+    for (int i = 0; i < num_threads; i++)
+        threads[i]->waitForThreadToExit( -1 );
+
+    const int64 t1 = Time::getHighResolutionTicks();
+
+    for (int i = 0; i < num_threads; i++)
+        delete threads[i];
+    delete[] threads;
+
+    if ( counter != int64( NUM_ITER ) * num_threads )
+        fprintf( stderr, "counter mismatch: %lld\n", (long long) counter );
+
+    // nanoseconds per lock acquisition
+    return Time::highResolutionTicksToSeconds( t1 - t0 ) * 1.0e9 / ( double(NUM_ITER) * num_threads );
+}
+
+int main( int argc, char** argv )
+{
+    const int thread_counts[] = { 1, 2, 4, 8, 16 };
+
+    printf( "ns per lock/unlock, %d iterations per thread\n", NUM_ITER );
+    printf( "%8s %16s %16s %16s\n", "threads", "CriticalSection", "SpinLock", "AdaptiveMutex" );
+
+    for (int num_threads : thread_counts)
+    {
+        const double t_cs   = run_one<CriticalSection>( num_threads );
+        const double t_spin = run_one<SpinLock>( num_threads );
+        const double t_adpt = run_one<AdaptiveMutex>( num_threads );
+        printf( "%8d %16.1f %16.1f %16.1f\n", num_threads, t_cs, t_spin, t_adpt );
+    }
+}
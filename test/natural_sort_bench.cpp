@@ -0,0 +1,61 @@
+#include "treecore/MT19937.h"
+#include "treecore/StringArray.h"
+#include "treecore/Time.h"
+
+#include <cstdio>
+
+using namespace treecore;
+
+//
+// sorting file names in natural order, and comparing pairs of long names
+// which only differ near the end, with a fixed seed so that the sums can be
+// compared between builds
+//
+
+static double seconds_since( int64 t0 )
+{
+    return Time::highResolutionTicksToSeconds( Time::getHighResolutionTicks() - t0 );
+}
+
+int main( int argc, char** argv )
+{
+    MT19937 r( 12345 );
+
+    const int num_names = 500000;
+    StringArray names;
+    names.ensureStorageAllocated( num_names );
+
+    for (int i = 0; i < num_names; i++)
+    {
+        names.add( "Project " + String( int( r.next_uint64_in_range( 50 ) ) ) + "/Take "
+                   + String( int( r.next_uint64_in_range( 2000 ) ) ) + " - Mix v"
+                   + String( int( r.next_uint64_in_range( 30 ) ) ) + ".wav" );
+    }
+
+    StringArray paths;
+    for (int i = 0; i < 1000; i++)
+        paths.add( "/home/user/music/library/artists/some artist/some album/disc 1/track "
+                   + String( int( r.next_uint64_in_range( 100 ) ) ) + ".flac" );
+
+    for (int round = 0; round < 3; round++)
+    {
+        StringArray sorted = names;
+        int64 t0 = Time::getHighResolutionTicks();
+        sorted.sortNatural();
+        const double t_sort = seconds_since( t0 );
+
+        t0 = Time::getHighResolutionTicks();
+        int sum = 0;
+
+        for (int k = 0; k < 1000; k++)
+            for (int i = 1; i < paths.size(); i++)
+                sum += paths[i - 1].compareNatural( paths[i] );
+
+        const double t_compare = seconds_since( t0 );
+
+        printf( "sortNatural %8.1fms   compareNatural x1M %8.1fms   (%d)\n",
+                t_sort * 1000.0, t_compare * 1000.0, sum );
+    }
+
+    return 0;
+}
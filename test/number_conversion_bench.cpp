@@ -0,0 +1,96 @@
+#include "treecore/JSON.h"
+#include "treecore/MT19937.h"
+#include "treecore/Result.h"
+#include "treecore/String.h"
+#include "treecore/StringArray.h"
+#include "treecore/Time.h"
+#include "treecore/Variant.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+using namespace treecore;
+
+//
+// numbers to text and back, through String and JSON
+//
+static volatile int sink;
+
+// return nanoseconds per call
+template<typename Func>
+static double measure( int num_iter, Func func )
+{
+    const int64 t0 = Time::getHighResolutionTicks();
+    for (int i = 0; i < num_iter; i++)
+        func( i );
+    const int64 t1 = Time::getHighResolutionTicks();
+
+    return Time::highResolutionTicksToSeconds( t1 - t0 ) * 1.0e9 / double(num_iter);
+}
+
+int main( int argc, char** argv )
+{
+    MT19937& r = *MT19937::getInstance();
+
+    enum { NUM_VALUES = 4096, MASK = NUM_VALUES - 1 };
+
+    // doubles with all bits random, as from computations, and with few
+    // digits, as typed by people
+    static double any_doubles[NUM_VALUES];
+    static double short_doubles[NUM_VALUES];
+    static float  floats[NUM_VALUES];
+    static int64  ints[NUM_VALUES];
+
+    for (int i = 0; i < NUM_VALUES; i++)
+    {
+        do
+        {
+            const uint64 bits = r.next_uint64();
+            std::memcpy( &any_doubles[i], &bits, sizeof(double) );
+        } while ( !std::isfinite( any_doubles[i] ) );
+
+        short_doubles[i] = double(r.next_uint64_in_range( 1000000 )) / 1000.0;
+        floats[i] = float(r.next_double_yy() * 1000.0);
+        ints[i]   = int64(r.next_uint64() >> int(r.next_uint64_in_range( 64 )));
+    }
+
+    StringArray any_texts, short_texts;
+    for (int i = 0; i < NUM_VALUES; i++)
+    {
+        char buffer[64];
+        snprintf( buffer, sizeof(buffer), "%.17g", any_doubles[i] );
+        any_texts.add( buffer );
+        short_texts.add( String( short_doubles[i], 3 ) );
+    }
+
+    const int num_iter = 1000000;
+
+    printf( "ns per call\n" );
+    printf( "String( double ), random bits     %8.1f\n", measure( num_iter, [] ( int i ) { sink = String( any_doubles[i & MASK] ).length(); } ) );
+    printf( "String( double ), 3 decimals      %8.1f\n", measure( num_iter, [] ( int i ) { sink = String( short_doubles[i & MASK] ).length(); } ) );
+    printf( "String( float )                   %8.1f\n", measure( num_iter, [] ( int i ) { sink = String( floats[i & MASK] ).length(); } ) );
+    printf( "String( int64 )                   %8.1f\n", measure( num_iter, [] ( int i ) { sink = String( ints[i & MASK] ).length(); } ) );
+    printf( "getDoubleValue(), 17 digits       %8.1f\n", measure( num_iter, [&any_texts] ( int i ) { sink = int(any_texts[i & MASK].getDoubleValue() != 0.0); } ) );
+    printf( "getDoubleValue(), 3 decimals      %8.1f\n", measure( num_iter, [&short_texts] ( int i ) { sink = int(short_texts[i & MASK].getDoubleValue() != 0.0); } ) );
+
+    // a JSON array of 4096 numbers
+    Array<var> items;
+    for (int i = 0; i < NUM_VALUES; i++)
+        items.add( any_doubles[i] );
+
+    const var json( items );
+    const String json_text = JSON::toString( json, true );
+
+    const double t_write = measure( 200, [&json] ( int ) { sink = JSON::toString( json, true ).length(); } );
+    const double t_read  = measure( 200, [&json_text] ( int ) {
+        var parsed;
+        sink = int(JSON::parse( json_text, parsed ).wasOk());
+    } );
+
+    printf( "\nus per call, 4096 doubles\n" );
+    printf( "JSON::toString()                  %8.1f\n", t_write / 1000.0 );
+    printf( "JSON::parse()                     %8.1f\n", t_read / 1000.0 );
+
+    return 0;
+}
@@ -0,0 +1,61 @@
+#include "treecore/String.h"
+#include "treecore/StringArray.h"
+#include "treecore/Time.h"
+
+#include <cstdio>
+
+using namespace treecore;
+
+#define NUM_ITER 2000000
+
+//
+// cost of creating and copying strings of typical key and identifier
+// lengths, which are stored inline when short enough
+//
+static volatile int sink;
+
+// return nanoseconds per iteration
+template<typename Func>
+static double measure( Func func )
+{
+    const int64 t0 = Time::getHighResolutionTicks();
+    for (int i = 0; i < NUM_ITER; i++)
+        func();
+    const int64 t1 = Time::getHighResolutionTicks();
+
+    return Time::highResolutionTicksToSeconds( t1 - t0 ) * 1.0e9 / double(NUM_ITER);
+}
+
+int main( int argc, char** argv )
+{
+    const char* texts[] = { "id", "position", "max_connections", "a key that is somewhat longer than that" };
+
+    printf( "ns per operation\n" );
+    printf( "%-8s %12s %12s %12s %12s\n", "chars", "construct", "copy", "append char", "to int" );
+
+    for (const char* text : texts)
+    {
+        const String source( text );
+
+        const double t_construct = measure( [text] { String s( text ); sink = s.length(); } );
+        const double t_copy      = measure( [&source] { String s( source ); sink = s.length(); } );
+        const double t_append    = measure( [&source] { String s( source ); s += 'x'; sink = s.length(); } );
+        const double t_number    = measure( [] { String s( 12345 ); sink = s.length(); } );
+
+        printf( "%-8d %12.1f %12.1f %12.1f %12.1f\n", source.length(), t_construct, t_copy, t_append, t_number );
+    }
+
+    // split into many short tokens, then copy the whole array
+    String line;
+    for (int i = 0; i < 64; i++)
+        line << "key" << i << " ";
+
+    const double t_split = measure( [&line] {
+        StringArray tokens;
+        tokens.addTokens( line, " ", "" );
+        StringArray copy( tokens );
+        sink = copy.size();
+    } ) / 64.0;
+
+    printf( "\nns per token for StringArray::addTokens() and copy: %.1f\n", t_split );
+}
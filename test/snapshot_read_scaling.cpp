@@ -0,0 +1,132 @@
+#include "treecore/AtomicObject.h"
+#include "treecore/RefCountHolder.h"
+#include "treecore/RefCountObject.h"
+#include "treecore/SnapshotPtr.h"
+#include "treecore/SpinLock.h"
+#include "treecore/Thread.h"
+#include "treecore/Time.h"
+
+#include <cstdio>
+
+using namespace treecore;
+
+#define NUM_ITER 2000000
+
+struct Table: public RefCountObject
+{
+    Table(): value( 1 ) {}
+    Table( const Table& other ): RefCountObject(), value( other.value ) {}
+    int64 value;
+};
+
+//
+// readers copy a RefCountHolder guarded by a lock, which is the usual way
+// of sharing a swappable table
+//
+struct HolderSource
+{
+    HolderSource(): table( new Table() ) {}
+
+    int64 read() const
+    {
+        RefCountHolder<Table> snapshot;
+        {
+            const SpinLock::ScopedLockType scope( lock );
+            snapshot = table;
+        }
+        return snapshot->value;
+    }
+
+    void detach() {}
+
+    SpinLock lock;
+    RefCountHolder<Table> table;
+};
+
+struct SnapshotSource
+{
+    SnapshotSource(): table( new Table() ) {}
+
+    int64 read() const
+    {
+        SnapshotPtr<Table>::ReadGuard snapshot( table );
+        return snapshot->value;
+    }
+
+    void detach() { table.detachCurrentThread(); }
+
+    SnapshotPtr<Table> table;
+};
+
+template<typename SourceType>
+struct ReaderThread: public Thread
+{
+    ReaderThread( SourceType& source, AtomicObject<int32>& go )
+        : Thread( "reader" )
+        , source( source )
+        , go( go )
+    {}
+
+    void run() override
+    {
+        while ( go.load() == 0 )
+            Thread::yield();
+
+        for (int i = 0; i < NUM_ITER; i++)
+            sum += source.read();
+
+        source.detach();
+    }
+
+    SourceType& source;
+    AtomicObject<int32>& go;
+    int64 sum = 0;
+};
+
+template<typename SourceType>
+double run_one( int num_threads )
+{
+    SourceType source;
+    AtomicObject<int32> go( 0 );
+
+    ReaderThread<SourceType>** threads = new ReaderThread<SourceType>*[num_threads];
+    for (int i = 0; i < num_threads; i++)
+    {
+        threads[i] = new ReaderThread<SourceType>( source, go );
+        threads[i]->startThread();
+    }
+
+    const int64 t0 = Time::getHighResolutionTicks();
+    go = 1;
+
+    for (int i = 0; i < num_threads; i++)
+        threads[i]->waitForThreadToExit( -1 );
+
+    const int64 t1 = Time::getHighResolutionTicks();
+
+    for (int i = 0; i < num_threads; i++)
+    {
+        if (threads[i]->sum != NUM_ITER)
+            fprintf( stderr, "sum mismatch: %lld\n", (long long) threads[i]->sum );
+        delete threads[i];
+    }
+    delete[] threads;
+
+    // nanoseconds per read, as seen by one thread
+    return Time::highResolutionTicksToSeconds( t1 - t0 ) * 1.0e9 / double(NUM_ITER);
+}
+
+int main( int argc, char** argv )
+{
+    const int thread_counts[] = { 1, 2, 4, 8, 16 };
+
+    printf( "ns per snapshot read, %d iterations per thread\n", NUM_ITER );
+    printf( "%8s %24s %16s\n", "threads", "locked RefCountHolder", "SnapshotPtr" );
+
+    for (int num_threads : thread_counts)
+    {
+        const double t_holder   = run_one<HolderSource>( num_threads );
+        const double t_snapshot = run_one<SnapshotSource>( num_threads );
+        printf( "%8d %24.1f %16.1f\n", num_threads, t_holder, t_snapshot );
+    }
+}
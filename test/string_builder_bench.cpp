@@ -0,0 +1,93 @@
+#include "treecore/DynamicObject.h"
+#include "treecore/JSON.h"
+#include "treecore/String.h"
+#include "treecore/StringArray.h"
+#include "treecore/StringBuilder.h"
+#include "treecore/Time.h"
+#include "treecore/Variant.h"
+#include "treecore/XmlElement.h"
+
+#include <cstdio>
+
+using namespace treecore;
+
+//
+// building long text from many small pieces, by appending to a String and
+// with StringBuilder, and the writers that use StringBuilder
+//
+static volatile int sink;
+
+// return nanoseconds per call
+template<typename Func>
+static double measure( int num_iter, Func func )
+{
+    const int64 t0 = Time::getHighResolutionTicks();
+    for (int i = 0; i < num_iter; i++)
+        func();
+    const int64 t1 = Time::getHighResolutionTicks();
+
+    return Time::highResolutionTicksToSeconds( t1 - t0 ) * 1.0e9 / double(num_iter);
+}
+
+int main( int argc, char** argv )
+{
+    printf( "ns per piece appended\n" );
+    printf( "%-10s %12s %14s\n", "pieces", "String", "StringBuilder" );
+
+    const int nums_pieces[] = { 100, 1000, 10000 };
+
+    for (int num_pieces : nums_pieces)
+    {
+        const int num_iter = 1000000 / num_pieces;
+
+        const double t_string = measure( num_iter, [num_pieces] {
+            String s;
+            for (int i = 0; i < num_pieces; i++)
+                s << "item" << i << ", ";
+            sink = s.length();
+        } ) / double(num_pieces);
+
+        const double t_builder = measure( num_iter, [num_pieces] {
+            StringBuilder builder;
+            for (int i = 0; i < num_pieces; i++)
+                builder << "item" << i << ", ";
+            sink = builder.toString().length();
+        } ) / double(num_pieces);
+
+        printf( "%-10d %12.1f %14.1f\n", num_pieces, t_string, t_builder );
+    }
+
+    // 10000 small objects
+    Array<var> items;
+    XmlElement root( "root" );
+    StringArray names;
+
+    for (int i = 0; i < 10000; i++)
+    {
+        DynamicObject* object = new DynamicObject();
+        object->setProperty( "id", i );
+        object->setProperty( "name", String( "name \"" ) + String( i ) + "\"" );
+        object->setProperty( "weight", i * 0.25 );
+        items.add( var( object ) );
+
+        XmlElement* child = root.createNewChildElement( "item" );
+        child->setAttribute( "id", i );
+        child->setAttribute( "name", String( "name <" ) + String( i ) + ">" );
+        child->addTextElement( "some text & more" );
+
+        names.add( String( "name" ) + String( i ) );
+    }
+
+    const var json( items );
+
+    const double t_json = measure( 50, [&json] { sink = JSON::toString( json, false ).length(); } );
+    const double t_xml  = measure( 50, [&root] { sink = root.createDocument( String() ).length(); } );
+    const double t_join = measure( 500, [&names] { sink = names.joinIntoString( ", " ).length(); } );
+
+    printf( "\nus per call, 10000 elements\n" );
+    printf( "JSON::toString()               %10.1f\n", t_json / 1000.0 );
+    printf( "XmlElement::createDocument()   %10.1f\n", t_xml / 1000.0 );
+    printf( "StringArray::joinIntoString()  %10.1f\n", t_join / 1000.0 );
+
+    return 0;
+}
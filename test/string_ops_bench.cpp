@@ -0,0 +1,122 @@
+#include "treecore/CharPointer_UTF8.h"
+#include "treecore/CpuDispatch.h"
+#include "treecore/String.h"
+#include "treecore/StringRef.h"
+#include "treecore/Time.h"
+
+#include <cstdio>
+#include <cstring>
+
+using namespace treecore;
+
+#define NUM_BYTES_PER_RUN (1 << 24)
+
+//
+// compares character-by-character CharacterFunctions loops with the String
+// fast paths, on short and long strings of ASCII and mostly ASCII text
+//
+static volatile int sink;
+
+static String make_text( int num_chars, int non_ascii_every )
+{
+    String result;
+
+    for (int i = 0; i < num_chars; i++)
+    {
+        if (non_ascii_every > 0 && i % non_ascii_every == non_ascii_every - 1)
+            result += treecore_wchar( 0xe9 );
+        else
+            result += treecore_wchar( (i % 3 == 0 ? 'A' : 'a') + i % 26 );
+    }
+
+    return result;
+}
+
+// the case conversion loop String used before
+static String reference_lower( const String& s )
+{
+    String result;
+    result.preallocateBytes( s.getNumBytesAsUTF8() + 1 );
+
+    for (CharPointer_UTF8 p( s.getCharPointer() );; ++p)
+    {
+        const treecore_wchar c = p.toLowerCase();
+        if (c == 0)
+            break;
+
+        result += c;
+    }
+
+    return result;
+}
+
+// return microseconds per MB
+template<typename Func>
+static double measure( size_t num_bytes, Func func )
+{
+    const size_t num_iter = NUM_BYTES_PER_RUN / num_bytes;
+
+    const int64 t0 = Time::getHighResolutionTicks();
+    for (size_t i = 0; i < num_iter; i++)
+        func();
+    const int64 t1 = Time::getHighResolutionTicks();
+
+    return Time::highResolutionTicksToSeconds( t1 - t0 ) * 1.0e6 * (1 << 20) / double(num_iter * num_bytes);
+}
+
+static void print_row( const char* name, const char* text_kind, int num_chars, double t_old, double t_new )
+{
+    printf( "%-20s %-8s %8d %12.1f %12.1f %8.2fx\n", name, text_kind, num_chars, t_old, t_new, t_old / t_new );
+}
+
+int main( int argc, char** argv )
+{
+    printf( "CPU feature level: %s\n", get_cpu_feature_level_name( get_cpu_feature_level() ) );
+    printf( "microseconds per MB\n" );
+    printf( "%-20s %-8s %8s %12s %12s %9s\n", "operation", "text", "chars", "old", "new", "speedup" );
+
+    struct TextKind
+    {
+        const char* name;
+        int non_ascii_every;
+    };
+
+    const TextKind kinds[] = {
+        { "ascii", 0 },
+        { "latin", 8 },
+    };
+
+    for (const TextKind& kind : kinds)
+    {
+        for (int num_chars : { 16, 64, 1024, 65536 })
+        {
+            const String text    = make_text( num_chars, kind.non_ascii_every );
+            const String same    = text + "";
+            const String needle  = "0123";
+            const String almost  = text.substring( num_chars / 2, num_chars / 2 + 3 );
+            const CharPointer_UTF8 p      = text.getCharPointer();
+            const CharPointer_UTF8 p_same = same.getCharPointer();
+            const size_t num_bytes = text.getNumBytesAsUTF8();
+
+            print_row( "compare equal", kind.name, num_chars,
+                       measure( num_bytes, [&] { sink = CharacterFunctions::compare( p, p_same ); } ),
+                       measure( num_bytes, [&] { sink = p.compare( p_same ); } ) );
+
+            print_row( "indexOf absent", kind.name, num_chars,
+                       measure( num_bytes, [&] { sink = CharacterFunctions::indexOf( p, needle.getCharPointer() ); } ),
+                       measure( num_bytes, [&] { sink = text.indexOf( needle ); } ) );
+
+            print_row( "indexOf middle", kind.name, num_chars,
+                       measure( num_bytes, [&] { sink = CharacterFunctions::indexOf( p, almost.getCharPointer() ); } ),
+                       measure( num_bytes, [&] { sink = text.indexOf( almost ); } ) );
+
+            print_row( "indexOf char", kind.name, num_chars,
+                       measure( num_bytes, [&] { sink = CharacterFunctions::indexOfChar( p, treecore_wchar( '!' ) ); } ),
+                       measure( num_bytes, [&] { sink = text.indexOfChar( '!' ); } ) );
+
+            print_row( "toLowerCase", kind.name, num_chars,
+                       measure( num_bytes, [&] { sink = reference_lower( text ).length(); } ),
+                       measure( num_bytes, [&] { sink = text.toLowerCase().length(); } ) );
+        }
+    }
+}
@@ -0,0 +1,78 @@
+#include "treecore/MT19937.h"
+#include "treecore/StringArray.h"
+#include "treecore/StringBuilder.h"
+#include "treecore/StringTable.h"
+#include "treecore/Time.h"
+
+#include <cstdio>
+
+using namespace treecore;
+
+//
+// splitting a large text into lines, and sorting them, with StringArray and
+// with StringTable
+//
+
+static double seconds_since( int64 t0 )
+{
+    return Time::highResolutionTicksToSeconds( Time::getHighResolutionTicks() - t0 );
+}
+
+int main( int argc, char** argv )
+{
+    MT19937& r = *MT19937::getInstance();
+
+    // lines that look like log entries, with common prefixes
+    const int num_lines = 1000000;
+    StringBuilder builder;
+
+    for (int i = 0; i < num_lines; i++)
+    {
+        builder << "2016-03-" << int( 10 + r.next_uint64_in_range( 20 ) ) << " host"
+                << int( r.next_uint64_in_range( 50 ) ) << " request /path/";
+
+        const int num_chars = 5 + int( r.next_uint64_in_range( 30 ) );
+        for (int j = 0; j < num_chars; j++)
+            builder << char( 'a' + r.next_uint64_in_range( 26 ) );
+
+        builder << '\n';
+    }
+
+    const String text = builder.toString();
+    const char* const data = text.toRawUTF8();
+    const size_t num_bytes = text.getNumBytesAsUTF8();
+
+    printf( "%d lines, %.1f MB\n", num_lines, double(num_bytes) / 1.0e6 );
+    printf( "%-12s %10s %10s\n", "", "addLines", "sort" );
+
+    for (int round = 0; round < 3; round++)
+    {
+        {
+            int64 t0 = Time::getHighResolutionTicks();
+            StringArray lines;
+            lines.addLines( text );
+            const double t_split = seconds_since( t0 );
+
+            t0 = Time::getHighResolutionTicks();
+            lines.sort( false );
+            const double t_sort = seconds_since( t0 );
+
+            printf( "%-12s %8.1fms %8.1fms\n", "StringArray", t_split * 1000.0, t_sort * 1000.0 );
+        }
+
+        {
+            int64 t0 = Time::getHighResolutionTicks();
+            StringTable lines;
+            lines.addLines( data, num_bytes );
+            const double t_split = seconds_since( t0 );
+
+            t0 = Time::getHighResolutionTicks();
+            lines.sort();
+            const double t_sort = seconds_since( t0 );
+
+            printf( "%-12s %8.1fms %8.1fms\n", "StringTable", t_split * 1000.0, t_sort * 1000.0 );
+        }
+    }
+
+    return 0;
+}
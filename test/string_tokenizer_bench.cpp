@@ -0,0 +1,78 @@
+#include "treecore/MT19937.h"
+#include "treecore/StringArray.h"
+#include "treecore/StringBuilder.h"
+#include "treecore/StringTokenizer.h"
+#include "treecore/Time.h"
+
+#include <cstdio>
+
+using namespace treecore;
+
+//
+// summing one column of a CSV text, by splitting it into StringArrays and
+// with LineIterator and StringTokenizer
+//
+
+static double seconds_since( int64 t0 )
+{
+    return Time::highResolutionTicksToSeconds( Time::getHighResolutionTicks() - t0 );
+}
+
+int main( int argc, char** argv )
+{
+    MT19937& r = *MT19937::getInstance();
+
+    const int num_rows = 500000;
+    StringBuilder builder;
+
+    for (int i = 0; i < num_rows; i++)
+    {
+        builder << i << ",\"customer " << int( r.next_uint64_in_range( 10000 ) ) << ", Inc.\","
+                << int( r.next_uint64_in_range( 1000 ) ) << ",2016-03-14T12:00:00,"
+                << "some longer free text in the last column of the row\n";
+    }
+
+    const String text = builder.toString();
+    printf( "%d rows, %.1f MB\n", num_rows, double(text.getNumBytesAsUTF8()) / 1.0e6 );
+
+    for (int round = 0; round < 3; round++)
+    {
+        int64 t0  = Time::getHighResolutionTicks();
+        int64 sum = 0;
+
+        StringArray lines;
+        lines.addLines( text );
+
+        for (const String& line : lines)
+        {
+            StringArray fields;
+            fields.addTokens( line, ",", "\"" );
+
+            if (fields.size() > 2)
+                sum += fields[2].getLargeIntValue();
+        }
+
+        const double t_array = seconds_since( t0 );
+        const int64 sum_array = sum;
+
+        t0  = Time::getHighResolutionTicks();
+        sum = 0;
+
+        LineIterator line_iterator( text );
+
+        while ( line_iterator.next() )
+        {
+            StringTokenizer fields( line_iterator.getLine(), ",", "\"" );
+
+            if ( fields.next() && fields.next() && fields.next() )
+                sum += fields.getToken().getLargeIntValue();
+        }
+
+        const double t_tokenizer = seconds_since( t0 );
+
+        printf( "StringArray %8.1fms   StringTokenizer %8.1fms   %s\n",
+                t_array * 1000.0, t_tokenizer * 1000.0, sum == sum_array ? "same sum" : "DIFFERENT SUM" );
+    }
+
+    return 0;
+}
@@ -0,0 +1,95 @@
+#include "treecore/CharPointer_UTF8.h"
+#include "treecore/CharPointer_UTF16.h"
+#include "treecore/CpuDispatch.h"
+#include "treecore/Time.h"
+#include "treecore/UTF8Functions.h"
+
+#include <cstdio>
+#include <vector>
+
+using namespace treecore;
+
+#define TEXT_BYTES (1 << 20)
+#define NUM_ITER   50
+
+//
+// compares character-by-character CharPointer_UTF8 loops with UTF8Functions,
+// on 1 MB of ASCII, of mostly ASCII, and of CJK text
+//
+static std::vector<char>   text;
+static std::vector<uint16> utf16;
+static volatile size_t sink;
+
+static void fill_text( int non_ascii_every, treecore_wchar c )
+{
+    text.assign( TEXT_BYTES + 1, 0 );
+    CharPointer_UTF8 p( text.data() );
+    size_t num_bytes = 0;
+
+    for (int i = 0; num_bytes + 4 < TEXT_BYTES; i++)
+    {
+        const treecore_wchar next = (non_ascii_every > 0 && i % non_ascii_every == 0) ? c : treecore_wchar( 'a' + i % 26 );
+        p.write( next );
+        num_bytes += CharPointer_UTF8::getBytesRequiredFor( next );
+    }
+
+    p.writeNull();
+}
+
+// return microseconds per MB
+template<typename Func>
+static double measure( Func func )
+{
+    const int64 t0 = Time::getHighResolutionTicks();
+    for (int i = 0; i < NUM_ITER; i++)
+        func();
+    const int64 t1 = Time::getHighResolutionTicks();
+
+    return Time::highResolutionTicksToSeconds( t1 - t0 ) * 1.0e6 / NUM_ITER;
+}
+
+static void print_row( const char* name, const char* text_kind, double t_scalar, double t_vector )
+{
+    printf( "%-20s %-12s %12.1f %12.1f %8.2fx\n", name, text_kind, t_scalar, t_vector, t_scalar / t_vector );
+}
+
+int main( int argc, char** argv )
+{
+    utf16.resize( TEXT_BYTES * 2 + 2 );
+
+    printf( "CPU feature level: %s\n", get_cpu_feature_level_name( get_cpu_feature_level() ) );
+    printf( "microseconds per MB\n" );
+    printf( "%-20s %-12s %12s %12s %9s\n", "operation", "text", "scalar", "vector", "speedup" );
+
+    struct TextKind
+    {
+        const char* name;
+        int non_ascii_every;
+        treecore_wchar c;
+    };
+
+    const TextKind kinds[] = {
+        { "ascii",  0,  0 },
+        { "latin",  8,  0xe9 },
+        { "cjk",    1,  0x4e2d },
+    };
+
+    for (const TextKind& kind : kinds)
+    {
+        fill_text( kind.non_ascii_every, kind.c );
+        const size_t num_bytes = CharPointer_UTF8( text.data() ).sizeInBytes() - 1;
+
+        print_row( "count characters", kind.name,
+                   measure( [] { sink = CharacterFunctions::lengthUpTo( CharPointer_UTF8( text.data() ), size_t( TEXT_BYTES ) ); } ),
+                   measure( [num_bytes] { sink = utf8_count_chars( text.data(), num_bytes ); } ) );
+
+        // decoding every character is the scalar cost of looking at all text
+        print_row( "validate", kind.name,
+                   measure( [] { sink = CharPointer_UTF16::getBytesRequiredFor( CharPointer_UTF8( text.data() ) ); } ),
+                   measure( [num_bytes] { sink = utf8_validate( text.data(), num_bytes ); } ) );
+
+        print_row( "to UTF-16", kind.name,
+                   measure( [] { CharPointer_UTF16( (CharPointer_UTF16::CharType*) utf16.data() ).writeAll( CharPointer_UTF8( text.data() ) ); } ),
+                   measure( [num_bytes] { sink = utf8_to_utf16( text.data(), num_bytes, utf16.data() ); } ) );
+    }
+}
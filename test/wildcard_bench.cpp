@@ -0,0 +1,75 @@
+#include "treecore/MT19937.h"
+#include "treecore/StringArray.h"
+#include "treecore/Time.h"
+#include "treecore/WildcardMatcher.h"
+
+#include <cstdio>
+
+using namespace treecore;
+
+//
+// testing file names against a set of patterns, one pattern at a time with
+// String::matchesWildcard() and all at once with WildcardMatcher
+//
+
+static double seconds_since( int64 t0 )
+{
+    return Time::highResolutionTicksToSeconds( Time::getHighResolutionTicks() - t0 );
+}
+
+int main( int argc, char** argv )
+{
+    MT19937 r( 12345 );
+
+    static const char* const extensions[] = { "cpp", "h", "txt", "png", "jpg", "wav", "o", "json", "md", "xml" };
+    const int num_names = 200000;
+    StringArray names;
+
+    for (int i = 0; i < num_names; i++)
+    {
+        names.add( "some_source_file_" + String( int( r.next_uint64_in_range( 100000 ) ) ) + "."
+                   + extensions[r.next_uint64_in_range( 10 )] );
+    }
+
+    const StringArray patterns = WildcardMatcher::splitPatterns(
+        "*.c;*.cc;*.cpp;*.cxx;*.h;*.hh;*.hpp;*.hxx;*.inl;*.ipp;"
+        "*.py;*.js;*.ts;*.java;*.cs;*.go;*.rs;*.swift;*.m;*.mm;"
+        "CMakeLists.txt;Makefile;*_test.*;test_*;*.cmake" );
+
+    for (int round = 0; round < 3; round++)
+    {
+        int64 t0 = Time::getHighResolutionTicks();
+        int num_one_by_one = 0;
+
+        for (const String& name : names)
+        {
+            for (const String& pattern : patterns)
+            {
+                if ( name.matchesWildcard( pattern, true ) )
+                {
+                    num_one_by_one++;
+                    break;
+                }
+            }
+        }
+
+        const double t_one_by_one = seconds_since( t0 );
+
+        t0 = Time::getHighResolutionTicks();
+        const WildcardMatcher matcher( patterns, true );
+        const double t_compile = seconds_since( t0 );
+        int num_matcher = 0;
+
+        for (const String& name : names)
+            if ( matcher.matches( name ) )
+                num_matcher++;
+
+        const double t_matcher = seconds_since( t0 );
+
+        printf( "%d patterns: matchesWildcard %8.1fms   WildcardMatcher %8.1fms (compiling %.2fms, %d states)   %s\n",
+                patterns.size(), t_one_by_one * 1000.0, t_matcher * 1000.0, t_compile * 1000.0,
+                matcher.getNumStates(), num_one_by_one == num_matcher ? "same matches" : "DIFFERENT MATCHES" );
+    }
+
+    return 0;
+}